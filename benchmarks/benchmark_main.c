@@ -1,35 +1,120 @@
 /**
  * benchmark_main.c - Main program to run the benchmarks
+ *
+ * Usage: vedicmath_benchmark [min_iterations] [--reps N] [--target-ms MS]
+ *                            [--cpu N|auto|none] [--json FILE] [--alloc]
+ *
+ * --alloc counts library allocations per operation (in an extra untimed
+ * repetition) and prints the per-API / per-call-site report at the end.
  */
 
  #include "vedicmath_benchmark.h"
+ #include "vedicmath_alloc.h"
  #include <stdio.h>
  #include <stdlib.h>
  #include <string.h>
- 
+
+ #ifdef VEDICMATH_NOVEL_BENCHMARKS
+ // From src/benchmarks/novel_benchmarking.c
+ void run_novel_benchmark_suite(void);
+ #endif
+
+ static void print_usage(const char* program) {
+     printf("Usage: %s [min_iterations] [--reps N] [--target-ms MS] [--cpu N|auto|none] [--json FILE] [--alloc]\n", program);
+ }
+
  int main(int argc, char* argv[]) {
-     // Default number of iterations
-     size_t iterations = 1000000;
-     
-     // Check for command line arguments
-     if (argc > 1) {
-         // Try to parse the first argument as iteration count
+     // Default calibration seed
+     size_t iterations = 1000;
+
+     const char* json_path = NULL;
+ 
+     BenchHarnessConfig config;
+     bench_harness_default_config(&config);
+
+     // Parse command line arguments
+     for (int i = 1; i < argc; i++) {
+         const char* arg = argv[i];
+         const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
          char* endptr;
-         long count = strtol(argv[1], &endptr, 10);
-         
-         if (*endptr == '\0' && count > 0) {
-             iterations = (size_t)count;
+
+         if (strcmp(arg, "--reps") == 0 && value) {
+             long reps = strtol(value, &endptr, 10);
+             if (*endptr == '\0' && reps > 0) {
+                 config.repetitions = (size_t)reps;
+             }
+             i++;
+         } else if (strcmp(arg, "--target-ms") == 0 && value) {
+             double target_ms = strtod(value, &endptr);
+             if (*endptr == '\0' && target_ms > 0.0) {
+                 config.target_time_sec = target_ms / 1000.0;
+             }
+             i++;
+         } else if (strcmp(arg, "--cpu") == 0 && value) {
+             if (strcmp(value, "none") == 0) {
+                 config.cpu = BENCH_CPU_NONE;
+             } else if (strcmp(value, "auto") == 0) {
+                 config.cpu = BENCH_CPU_AUTO;
+             } else {
+                 long cpu = strtol(value, &endptr, 10);
+                 if (*endptr == '\0' && cpu >= 0) {
+                     config.cpu = (int)cpu;
+                 }
+             }
+             i++;
+         } else if (strcmp(arg, "--json") == 0 && value) {
+             json_path = value;
+             i++;
+         } else if (strcmp(arg, "--alloc") == 0) {
+             config.track_allocations = 1;
+         } else if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+             print_usage(argv[0]);
+             return 0;
          } else {
-             printf("Invalid iteration count. Using default: %zu\n", iterations);
+             // Try to parse the argument as the minimum iteration count
+             long count = strtol(arg, &endptr, 10);
+
+             if (*endptr == '\0' && count > 0) {
+                 iterations = (size_t)count;
+             } else {
+                 printf("Invalid argument '%s'. Using default iteration count: %zu\n", arg, iterations);
+             }
          }
      }
-     
+
+     bench_harness_set_config(&config);
+     if (config.cpu != BENCH_CPU_NONE && bench_harness_pin() < 0) {
+         printf("Warning: could not pin to a CPU, results may be noisier\n");
+     }
+
+     if (json_path && bench_json_begin(json_path, argv[0]) != 0) {
+         printf("Error: cannot write JSON results to '%s'\n", json_path);
+         return 1;
+     }
+ 
      printf("Vedic Mathematics Library Benchmark\n");
      printf("==================================\n\n");
-     printf("Running benchmarks with %zu iterations...\n", iterations);
-     
+     printf("Running benchmarks with at least %zu iterations per repetition...\n", iterations);
+
      // Run all benchmarks
      run_all_benchmarks(iterations);
-     
+
+ #ifdef VEDICMATH_NOVEL_BENCHMARKS
+     run_novel_benchmark_suite();
+ #endif
+
+     if (config.track_allocations) {
+         printf("\n");
+         vedic_alloc_print_report();
+     }
+ 
+     if (json_path) {
+         if (bench_json_end() != 0) {
+             printf("Error: failed to write JSON results to '%s'\n", json_path);
+             return 1;
+         }
+         printf("JSON results written to %s\n", json_path);
+     }
+
      return 0;
- }
\ No newline at end of file
+ }
@@ -0,0 +1,498 @@
+/**
+ * vedicmath_bench_harness.c - Implementation of the shared benchmark harness
+ */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // sched_setaffinity / CPU_SET
+#endif
+
+#include "vedicmath_bench_harness.h"
+#include "../include/vedicmath.h"
+#include "../include/vedicmath_dynamic.h"
+#include "../include/vedicmath_optimized.h"
+#include "../include/unified_adaptive_dispatcher.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#include <sys/time.h>
+#include <unistd.h>
+#elif defined(__APPLE__) || defined(__unix__)
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#define BENCH_OPERAND_SEED 20240501u
+
+// Defaults: 5 repetitions of ~20 ms each keeps the full suite within the
+// ctest timeout while still giving a usable median
+#define BENCH_HARNESS_DEFAULTS          \
+    {                                   \
+        .target_time_sec = 0.02,        \
+        .repetitions = 5,               \
+        .min_iterations = 1000,         \
+        .max_iterations = 1000000000,   \
+        .cpu = BENCH_CPU_AUTO,          \
+        .track_allocations = 0          \
+    }
+
+// Process-wide configuration
+static BenchHarnessConfig harness_config = BENCH_HARNESS_DEFAULTS;
+
+// CPU chosen by bench_harness_pin (-1 if not pinned)
+static int pinned_cpu = -1;
+
+// Sink for bench_escape so the store cannot be proven dead
+static const void *volatile escape_sink;
+
+void bench_harness_default_config(BenchHarnessConfig *config)
+{
+    static const BenchHarnessConfig defaults = BENCH_HARNESS_DEFAULTS;
+    *config = defaults;
+}
+
+void bench_harness_set_config(const BenchHarnessConfig *config)
+{
+    harness_config = *config;
+
+    if (harness_config.repetitions == 0)
+        harness_config.repetitions = 1;
+    if (harness_config.repetitions > BENCH_MAX_REPETITIONS)
+        harness_config.repetitions = BENCH_MAX_REPETITIONS;
+    if (harness_config.min_iterations == 0)
+        harness_config.min_iterations = 1;
+    if (harness_config.max_iterations < harness_config.min_iterations)
+        harness_config.max_iterations = harness_config.min_iterations;
+    if (harness_config.target_time_sec <= 0.0)
+        harness_config.target_time_sec = 0.001;
+}
+
+const BenchHarnessConfig *bench_harness_get_config(void)
+{
+    return &harness_config;
+}
+
+uint64_t bench_now_ns(void)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#elif defined(__APPLE__) || defined(__unix__)
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000000ULL + (uint64_t)tv.tv_usec * 1000ULL;
+#else
+    return (uint64_t)((double)clock() * 1e9 / CLOCKS_PER_SEC);
+#endif
+}
+
+int bench_pin_to_cpu(int cpu)
+{
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return -1;
+
+    if (cpu == BENCH_CPU_AUTO)
+    {
+        // Pick the first CPU we are allowed to run on (containers often
+        // restrict the set, so CPU 0 is not guaranteed to be available)
+        for (int i = 0; i < CPU_SETSIZE; i++)
+        {
+            if (CPU_ISSET(i, &allowed))
+            {
+                cpu = i;
+                break;
+            }
+        }
+        if (cpu < 0)
+            return -1;
+    }
+
+    if (cpu < 0 || cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed))
+        return -1;
+
+    cpu_set_t target;
+    CPU_ZERO(&target);
+    CPU_SET(cpu, &target);
+    return sched_setaffinity(0, sizeof(target), &target) == 0 ? cpu : -1;
+#elif defined(_WIN32) || defined(_WIN64)
+    if (cpu == BENCH_CPU_AUTO)
+        cpu = 0;
+    if (cpu < 0 || cpu >= (int)(sizeof(DWORD_PTR) * 8))
+        return -1;
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) != 0 ? cpu : -1;
+#else
+    // macOS and others have no hard affinity API
+    (void)cpu;
+    return -1;
+#endif
+}
+
+int bench_allowed_cpus(int *cpus, int max_cpus)
+{
+    int count = 0;
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return 0;
+    for (int i = 0; i < CPU_SETSIZE && count < max_cpus; i++)
+    {
+        if (CPU_ISSET(i, &allowed))
+            cpus[count++] = i;
+    }
+#elif defined(_WIN32) || defined(_WIN64)
+    DWORD_PTR process_mask, system_mask;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+        return 0;
+    for (int i = 0; i < (int)(sizeof(DWORD_PTR) * 8) && count < max_cpus; i++)
+    {
+        if (process_mask & ((DWORD_PTR)1 << i))
+            cpus[count++] = i;
+    }
+#else
+    (void)cpus;
+    (void)max_cpus;
+#endif
+    return count;
+}
+
+long bench_online_cpu_count(void)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (long)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? count : 1;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Body and argument of a thread being started; the entry point frees it
+ */
+typedef struct
+{
+    void (*body)(void *arg);
+    void *arg;
+} BenchThreadStart;
+
+#if defined(_WIN32) || defined(_WIN64)
+static DWORD WINAPI bench_thread_entry(LPVOID param)
+{
+    BenchThreadStart start = *(BenchThreadStart *)param;
+    free(param);
+    start.body(start.arg);
+    return 0;
+}
+#else
+static void *bench_thread_entry(void *param)
+{
+    BenchThreadStart start = *(BenchThreadStart *)param;
+    free(param);
+    start.body(start.arg);
+    return NULL;
+}
+#endif
+
+int bench_thread_start(bench_thread_t *thread, void (*body)(void *arg), void *arg)
+{
+    BenchThreadStart *start = malloc(sizeof(*start));
+    if (!start)
+        return -1;
+    start->body = body;
+    start->arg = arg;
+#if defined(_WIN32) || defined(_WIN64)
+    *thread = CreateThread(NULL, 0, bench_thread_entry, start, 0, NULL);
+    if (*thread)
+        return 0;
+#else
+    if (pthread_create(thread, NULL, bench_thread_entry, start) == 0)
+        return 0;
+#endif
+    free(start);
+    return -1;
+}
+
+void bench_thread_join(bench_thread_t thread)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+int bench_harness_pin(void)
+{
+    pinned_cpu = harness_config.cpu == BENCH_CPU_NONE ? -1 : bench_pin_to_cpu(harness_config.cpu);
+    return pinned_cpu;
+}
+
+int bench_harness_pinned_cpu(void)
+{
+    return pinned_cpu;
+}
+
+unsigned bench_next_random(unsigned *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 8) & 0xFFFFFFu;
+}
+
+void bench_operands_fill(BenchOperands *operands, unsigned thread_index)
+{
+    unsigned state = BENCH_OPERAND_SEED + 7919u * thread_index;
+    for (size_t i = 0; i < BENCH_POOL_SIZE; i++)
+    {
+        operands->a[i] = (int)(bench_next_random(&state) % 1000) + 1;
+        operands->b[i] = (int)(bench_next_random(&state) % 1000) + 1;
+        operands->va[i] = vedic_from_int32(operands->a[i]);
+        operands->vb[i] = vedic_from_int32(operands->b[i]);
+    }
+    operands->cursor = 0;
+}
+
+// Shared multiply workloads
+
+static void run_standard_multiply(BenchOperands *operands)
+{
+    size_t j = operands->cursor++ & BENCH_POOL_MASK;
+    long result = (long)operands->a[j] * (long)operands->b[j];
+    BENCH_DO_NOT_OPTIMIZE(result);
+}
+
+static void run_vedic_multiply(BenchOperands *operands)
+{
+    size_t j = operands->cursor++ & BENCH_POOL_MASK;
+    long result = vedic_multiply(operands->a[j], operands->b[j]);
+    BENCH_DO_NOT_OPTIMIZE(result);
+}
+
+static void run_dynamic_multiply(BenchOperands *operands)
+{
+    size_t j = operands->cursor++ & BENCH_POOL_MASK;
+    VedicValue result = vedic_dynamic_multiply(operands->va[j], operands->vb[j]);
+    BENCH_DO_NOT_OPTIMIZE(result);
+}
+
+static void run_optimized_multiply(BenchOperands *operands)
+{
+    size_t j = operands->cursor++ & BENCH_POOL_MASK;
+    VedicValue result = vedic_optimized_multiply(operands->va[j], operands->vb[j]);
+    BENCH_DO_NOT_OPTIMIZE(result);
+}
+
+static void run_unified_multiply(BenchOperands *operands)
+{
+    size_t j = operands->cursor++ & BENCH_POOL_MASK;
+    UnifiedDispatchResult result = unified_multiply(operands->va[j], operands->vb[j]);
+    BENCH_DO_NOT_OPTIMIZE(result);
+}
+
+/**
+ * Configure the unified dispatcher without learning, dataset logging or
+ * system monitoring, so its rows time dispatch rather than file output and
+ * statistics upkeep. Each call still takes the dispatcher lock twice, briefly,
+ * to read the configuration and to count the operation; the arithmetic runs
+ * outside it.
+ */
+static void configure_unified(bool validate)
+{
+    UnifiedDispatchConfig config = unified_dispatch_get_preset_config("embedded");
+    config.enable_learning = false;
+    config.enable_dataset_logging = false;
+    config.enable_system_monitoring = false;
+    config.validate_all_operations = validate;
+    unified_dispatch_update_config(&config);
+}
+
+static void prepare_unified_pattern(void)
+{
+    configure_unified(false);
+}
+
+static void prepare_unified_validated(void)
+{
+    configure_unified(true);
+}
+
+const BenchWorkload bench_multiply_workloads[BENCH_MULTIPLY_WORKLOAD_COUNT] = {
+    {"Standard multiply", "none (reference)", 1, NULL, run_standard_multiply},
+    {"Vedic dispatcher", "allocator (urdhva_mult buffers)", 1, NULL, run_vedic_multiply},
+    {"Dynamic dispatcher", "allocator (urdhva_mult buffers)", 1, NULL, run_dynamic_multiply},
+    {"Optimized dispatcher", "operation table (read-only)", 1, NULL, run_optimized_multiply},
+    {"Unified pattern-aware", "dispatcher lock (config, counter)", 1,
+     prepare_unified_pattern, run_unified_multiply},
+    {"Unified validated", "dispatcher lock (config, counter)", 1,
+     prepare_unified_validated, run_unified_multiply},
+};
+
+size_t bench_calibrate(int (*func)(size_t iterations, void *data),
+                       void *data,
+                       const BenchHarnessConfig *config)
+{
+    size_t iterations = config->min_iterations;
+    const double target_ns = config->target_time_sec * 1e9;
+
+    for (;;)
+    {
+        uint64_t start = bench_now_ns();
+        if (!func(iterations, data))
+            return 0;
+        double elapsed_ns = (double)(bench_now_ns() - start);
+
+        if (elapsed_ns >= target_ns || iterations >= config->max_iterations)
+            break;
+
+        // Scale towards the target with some headroom, growing at least 2x
+        // and at most 10x per round so one lucky fast run cannot overshoot
+        double factor = elapsed_ns > 0.0 ? (target_ns * 1.2) / elapsed_ns : 10.0;
+        if (factor < 2.0)
+            factor = 2.0;
+        if (factor > 10.0)
+            factor = 10.0;
+
+        double next = (double)iterations * factor;
+        iterations = next >= (double)config->max_iterations
+                         ? config->max_iterations
+                         : (size_t)next;
+    }
+
+    return iterations;
+}
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+static double sorted_median(const double *sorted, size_t count)
+{
+    if (count % 2 == 0)
+        return (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+    return sorted[count / 2];
+}
+
+BenchSummary bench_summarize(const double *samples, size_t count)
+{
+    BenchSummary summary = {0};
+    if (count == 0)
+        return summary;
+
+    double sorted[BENCH_MAX_REPETITIONS];
+    double *work = count <= BENCH_MAX_REPETITIONS ? sorted : (double *)malloc(count * sizeof(double));
+    if (!work)
+        return summary;
+
+    memcpy(work, samples, count * sizeof(double));
+    qsort(work, count, sizeof(double), compare_doubles);
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++)
+        sum += work[i];
+
+    summary.min = work[0];
+    summary.median = sorted_median(work, count);
+    summary.mean = sum / (double)count;
+
+    // Reuse the buffer for absolute deviations
+    for (size_t i = 0; i < count; i++)
+    {
+        double deviation = work[i] - summary.median;
+        work[i] = deviation < 0.0 ? -deviation : deviation;
+    }
+    qsort(work, count, sizeof(double), compare_doubles);
+    summary.mad = sorted_median(work, count);
+
+    if (work != sorted)
+        free(work);
+
+    return summary;
+}
+
+void bench_escape(const void *ptr)
+{
+    escape_sink = ptr;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+// Keep the value in a register and opaque, so the adds cannot be combined
+// Register operand rather than an immediate: some cores fold chains of
+// add-immediate in the renamer, which would overstate the clock
+#define BENCH_CHAIN_STEP(x, step) \
+    do \
+    { \
+        x += step; \
+        __asm__ __volatile__("" : "+r"(x)); \
+    } while (0)
+
+static int run_add_chain(size_t iterations, void *data)
+{
+    uint64_t x = *(uint64_t *)data;
+    uint64_t step = 1;
+    __asm__ __volatile__("" : "+r"(step));
+    for (size_t i = 0; i < iterations; i++)
+    {
+        BENCH_CHAIN_STEP(x, step);
+        BENCH_CHAIN_STEP(x, step);
+        BENCH_CHAIN_STEP(x, step);
+        BENCH_CHAIN_STEP(x, step);
+        BENCH_CHAIN_STEP(x, step);
+        BENCH_CHAIN_STEP(x, step);
+        BENCH_CHAIN_STEP(x, step);
+        BENCH_CHAIN_STEP(x, step);
+    }
+    *(uint64_t *)data = x;
+    return 1;
+}
+
+double bench_cycles_per_ns(void)
+{
+    static double cycles_per_ns = -1.0;
+    if (cycles_per_ns >= 0.0)
+        return cycles_per_ns;
+
+    BenchHarnessConfig config = harness_config;
+    config.min_iterations = 1000;
+    uint64_t x = 0;
+    size_t iterations = bench_calibrate(run_add_chain, &x, &config);
+
+    // Fastest of the repetitions: interrupts only ever add time
+    double best_ns = 0.0;
+    for (size_t rep = 0; rep < config.repetitions && iterations > 0; rep++)
+    {
+        uint64_t start = bench_now_ns();
+        run_add_chain(iterations, &x);
+        double elapsed = (double)(bench_now_ns() - start);
+        if (best_ns == 0.0 || elapsed < best_ns)
+            best_ns = elapsed;
+    }
+
+    cycles_per_ns = best_ns > 0.0 ? 8.0 * (double)iterations / best_ns : 0.0;
+    return cycles_per_ns;
+}
+#else
+double bench_cycles_per_ns(void)
+{
+    return 0.0;
+}
+#endif
@@ -0,0 +1,263 @@
+/**
+ * vedicmath_bench_harness.h - Measurement harness shared by all benchmarks
+ *
+ * The harness keeps everything except the operation under test out of the
+ * timed region: operands are generated up front into fixed-size pools, the
+ * iteration count is calibrated to a target wall time, and each benchmark is
+ * repeated several times so that min/median/MAD can be reported instead of a
+ * single noisy sample.
+ */
+
+ #ifndef VEDICMATH_BENCH_HARNESS_H
+ #define VEDICMATH_BENCH_HARNESS_H
+
+ #include <stddef.h>
+ #include <stdint.h>
+
+ #include "../include/vedicmath_types.h"
+
+ /**
+  * Threads, and the yield and atomics of a start barrier shared by the
+  * multithreaded benchmarks
+  */
+ #if defined(_WIN32) || defined(_WIN64)
+ #include <windows.h>
+ typedef HANDLE bench_thread_t;
+ #define BENCH_YIELD() SwitchToThread()
+ #define BENCH_ATOMIC_INC(ptr) InterlockedIncrement(ptr)
+ #define BENCH_ATOMIC_LOAD(ptr) InterlockedCompareExchange(ptr, 0, 0)
+ #define BENCH_ATOMIC_STORE(ptr, value) InterlockedExchange(ptr, value)
+ #else
+ #include <pthread.h>
+ #include <sched.h>
+ typedef pthread_t bench_thread_t;
+ #define BENCH_YIELD() sched_yield()
+ #define BENCH_ATOMIC_INC(ptr) __atomic_add_fetch(ptr, 1, __ATOMIC_SEQ_CST)
+ #define BENCH_ATOMIC_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+ #define BENCH_ATOMIC_STORE(ptr, value) __atomic_store_n(ptr, value, __ATOMIC_RELEASE)
+ #endif
+
+ /**
+  * Size of the pre-generated operand pools. Must be a power of two so the
+  * timed loops can wrap with a mask instead of a division.
+  */
+ #define BENCH_POOL_SIZE 4096
+ #define BENCH_POOL_MASK (BENCH_POOL_SIZE - 1)
+
+ /**
+  * Upper bound on the number of timed repetitions per benchmark
+  */
+ #define BENCH_MAX_REPETITIONS 64
+ 
+ /**
+  * Special values for BenchHarnessConfig.cpu
+  */
+ #define BENCH_CPU_AUTO -1   // Pin to the first CPU the process may run on
+ #define BENCH_CPU_NONE -2   // Leave the scheduler affinity alone
+
+ /**
+  * Keep a computed value alive without the cost of a volatile store.
+  *
+  * The argument must be an lvalue. On GCC/Clang an empty asm statement that
+  * takes its address and clobbers memory forces the value to be materialized;
+  * elsewhere the address escapes through an out-of-line function.
+  */
+ #if defined(__GNUC__) || defined(__clang__)
+     #define BENCH_DO_NOT_OPTIMIZE(value) \
+         __asm__ __volatile__("" : : "g"(&(value)) : "memory")
+     #define BENCH_CLOBBER_MEMORY() __asm__ __volatile__("" : : : "memory")
+ #else
+     #define BENCH_DO_NOT_OPTIMIZE(value) bench_escape((const void*)&(value))
+     #define BENCH_CLOBBER_MEMORY() bench_escape(NULL)
+ #endif
+
+ /**
+  * Number of multiply workloads in bench_multiply_workloads
+  */
+ #define BENCH_MULTIPLY_WORKLOAD_COUNT 6
+
+ /**
+  * Harness configuration
+  */
+ typedef struct {
+     double target_time_sec;   // Wall time each timed repetition should take
+     size_t repetitions;       // Number of timed repetitions (<= BENCH_MAX_REPETITIONS)
+     size_t min_iterations;    // Starting point for calibration
+     size_t max_iterations;    // Upper bound for calibration
+     int cpu;                  // CPU to pin to, BENCH_CPU_AUTO or BENCH_CPU_NONE
+     int track_allocations;    // Count library allocations in an extra untimed pass
+ } BenchHarnessConfig;
+
+ /**
+  * Summary statistics over a set of per-repetition samples
+  */
+ typedef struct {
+     double min;
+     double median;
+     double mad;               // Median absolute deviation from the median
+     double mean;
+ } BenchSummary;
+
+ /**
+  * Operands owned by one worker thread of a multithreaded benchmark (never
+  * shared). Benchmarks that need more per-thread data embed this as the
+  * first member of their own struct.
+  */
+ typedef struct {
+     int a[BENCH_POOL_SIZE];
+     int b[BENCH_POOL_SIZE];
+     VedicValue va[BENCH_POOL_SIZE];
+     VedicValue vb[BENCH_POOL_SIZE];
+     size_t cursor;
+ } BenchOperands;
+
+ /**
+  * One benchmarked entry point, run on one thread's operands
+  */
+ typedef struct {
+     const char* name;
+     const char* shared_state;       // Library state shared between threads
+     size_t ops_per_call;            // Operations performed by one run() call
+     void (*prepare)(void);          // Called on the main thread before each run (optional)
+     void (*run)(BenchOperands* operands);
+ } BenchWorkload;
+
+ /**
+  * The multiply entry points shared by the scaling and latency benchmarks:
+  * inline multiplication (the machine reference), then the vedic, dynamic,
+  * optimized and unified dispatchers
+  */
+ extern const BenchWorkload bench_multiply_workloads[BENCH_MULTIPLY_WORKLOAD_COUNT];
+
+ /**
+  * Fill a configuration with the harness defaults
+  *
+  * @param config Configuration to fill
+  */
+ void bench_harness_default_config(BenchHarnessConfig* config);
+
+ /**
+  * Replace the process-wide harness configuration
+  *
+  * @param config New configuration (values are clamped to sane limits)
+  */
+ void bench_harness_set_config(const BenchHarnessConfig* config);
+
+ /**
+  * Get the process-wide harness configuration
+  *
+  * @return Current configuration
+  */
+ const BenchHarnessConfig* bench_harness_get_config(void);
+
+ /**
+  * Monotonic timestamp in nanoseconds
+  */
+ uint64_t bench_now_ns(void);
+
+ /**
+  * Pin the calling thread to a CPU
+  *
+  * @param cpu CPU index, or BENCH_CPU_AUTO to pick the first allowed CPU
+  * @return The CPU pinned to, or -1 if pinning is unsupported or failed
+  */
+ int bench_pin_to_cpu(int cpu);
+ 
+ /**
+  * List the CPUs the process may run on
+  *
+  * @param cpus Output array of CPU indices
+  * @param max_cpus Capacity of cpus
+  * @return Number of CPUs written (0 if affinity is not supported)
+  */
+ int bench_allowed_cpus(int* cpus, int max_cpus);
+ 
+ /**
+  * Pin the calling thread according to the harness configuration and
+  * remember the result for bench_harness_pinned_cpu()
+  *
+  * @return The CPU pinned to, or -1 if not pinned
+  */
+ int bench_harness_pin(void);
+ 
+ /**
+  * CPU the harness pinned to in the last bench_harness_pin() call
+  *
+  * @return CPU index, or -1 if not pinned
+  */
+ int bench_harness_pinned_cpu(void);
+
+ /**
+  * Number of online CPUs (at least 1)
+  */
+ long bench_online_cpu_count(void);
+ 
+ /**
+  * Start a thread running body(arg)
+  *
+  * @param thread Output handle, for bench_thread_join
+  * @param body Thread body
+  * @param arg Argument passed to body
+  * @return 0 on success, -1 if the thread could not be created
+  */
+ int bench_thread_start(bench_thread_t* thread, void (*body)(void* arg), void* arg);
+ 
+ /**
+  * Wait for a thread started with bench_thread_start and release it
+  */
+ void bench_thread_join(bench_thread_t thread);
+
+ /**
+  * Linear congruential generator for operand pools (24 random bits)
+  */
+ unsigned bench_next_random(unsigned* state);
+ 
+ /**
+  * Fill one thread's operands with values in 1..1000; every thread gets
+  * different operands from the same distribution
+  *
+  * @param operands Operands to fill; the cursor is reset
+  * @param thread_index Index of the owning thread
+  */
+ void bench_operands_fill(BenchOperands* operands, unsigned thread_index);
+
+ /**
+  * Find an iteration count for which one call of func takes at least the
+  * configured target time. The calibration runs also serve as warm-up.
+  *
+  * @param func Benchmark function (returns 1 on success)
+  * @param data User data passed to func
+  * @param config Harness configuration
+  * @return Calibrated iteration count (0 if func reported failure)
+  */
+ size_t bench_calibrate(int (*func)(size_t iterations, void* data),
+                        void* data,
+                        const BenchHarnessConfig* config);
+
+ /**
+  * Compute min/median/MAD/mean over a sample set
+  *
+  * @param samples Sample values (not modified)
+  * @param count Number of samples
+  * @return Summary statistics (all zero if count is 0)
+  */
+ BenchSummary bench_summarize(const double* samples, size_t count);
+
+ /**
+  * Make a pointer escape to the optimizer (portable fallback for
+  * BENCH_DO_NOT_OPTIMIZE)
+  */
+ void bench_escape(const void* ptr);
+
+ /**
+  * Estimate the core clock in cycles per nanosecond from a chain of
+  * dependent integer adds (one cycle each on current cores). Used to report
+  * cycles when hardware counters are unavailable. The result is measured
+  * once and cached.
+  *
+  * @return Cycles per nanosecond, or 0 if the estimate is not supported
+  *         by the compiler
+  */
+ double bench_cycles_per_ns(void);
+
+ #endif /* VEDICMATH_BENCH_HARNESS_H */
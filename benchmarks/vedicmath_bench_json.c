@@ -0,0 +1,267 @@
+/**
+ * vedicmath_bench_json.c - JSON result files for the benchmark binaries
+ */
+#include "vedicmath_bench_json.h"
+#include "vedicmath_bench_harness.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/utsname.h>
+#include <unistd.h>
+#endif
+
+static FILE *json_file = NULL;
+static size_t json_result_count = 0;
+
+/**
+ * Write a JSON string literal, escaping quotes, backslashes and control
+ * characters
+ */
+static void write_string(const char *text)
+{
+    fputc('"', json_file);
+    for (const unsigned char *p = (const unsigned char *)(text ? text : ""); *p; p++)
+    {
+        switch (*p)
+        {
+        case '"':
+            fputs("\\\"", json_file);
+            break;
+        case '\\':
+            fputs("\\\\", json_file);
+            break;
+        case '\n':
+            fputs("\\n", json_file);
+            break;
+        case '\t':
+            fputs("\\t", json_file);
+            break;
+        default:
+            if (*p < 0x20)
+                fprintf(json_file, "\\u%04x", *p);
+            else
+                fputc(*p, json_file);
+            break;
+        }
+    }
+    fputc('"', json_file);
+}
+
+/**
+ * Write a number; JSON has no NaN/Inf, so those become null
+ */
+static void write_number(double value)
+{
+    if (isfinite(value))
+        fprintf(json_file, "%.17g", value);
+    else
+        fputs("null", json_file);
+}
+
+/**
+ * Read the CPU model name (Linux only, empty string elsewhere)
+ */
+static void read_cpu_model(char *buffer, size_t size)
+{
+    buffer[0] = '\0';
+#ifdef __linux__
+    FILE *cpuinfo = fopen("/proc/cpuinfo", "r");
+    if (!cpuinfo)
+        return;
+
+    char line[512];
+    while (fgets(line, sizeof(line), cpuinfo))
+    {
+        if (strncmp(line, "model name", 10) == 0)
+        {
+            const char *value = strchr(line, ':');
+            if (value)
+            {
+                value++;
+                while (*value == ' ' || *value == '\t')
+                    value++;
+                snprintf(buffer, size, "%s", value);
+                buffer[strcspn(buffer, "\n")] = '\0';
+            }
+            break;
+        }
+    }
+    fclose(cpuinfo);
+#else
+    (void)size;
+#endif
+}
+
+/**
+ * Write the "environment" object
+ */
+static void write_environment(void)
+{
+    char timestamp[32] = "";
+    time_t now = time(NULL);
+    struct tm *utc = gmtime(&now);
+    if (utc)
+        strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", utc);
+
+    char hostname[256] = "";
+    char os[256] = "";
+    long online_cpus = 0;
+#ifdef _WIN32
+    DWORD host_size = sizeof(hostname);
+    GetComputerNameA(hostname, &host_size);
+    snprintf(os, sizeof(os), "Windows");
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    online_cpus = (long)system_info.dwNumberOfProcessors;
+#else
+    gethostname(hostname, sizeof(hostname) - 1);
+    struct utsname uts;
+    if (uname(&uts) == 0)
+        snprintf(os, sizeof(os), "%s %s %s", uts.sysname, uts.release, uts.machine);
+    online_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+    char cpu_model[256];
+    read_cpu_model(cpu_model, sizeof(cpu_model));
+
+#if defined(__clang__)
+    const char *compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    const char *compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    const char *compiler = "msvc";
+#else
+    const char *compiler = "unknown";
+#endif
+
+    const BenchHarnessConfig *config = bench_harness_get_config();
+
+    fputs("  \"environment\": {\n    \"timestamp\": ", json_file);
+    write_string(timestamp);
+    fputs(",\n    \"hostname\": ", json_file);
+    write_string(hostname);
+    fputs(",\n    \"os\": ", json_file);
+    write_string(os);
+    fputs(",\n    \"cpu_model\": ", json_file);
+    write_string(cpu_model);
+    fprintf(json_file, ",\n    \"online_cpus\": %ld", online_cpus);
+    fprintf(json_file, ",\n    \"pinned_cpu\": %d", bench_harness_pinned_cpu());
+    fputs(",\n    \"compiler\": ", json_file);
+    write_string(compiler);
+#ifdef NDEBUG
+    fputs(",\n    \"assertions\": false", json_file);
+#else
+    fputs(",\n    \"assertions\": true", json_file);
+#endif
+    fprintf(json_file, ",\n    \"repetitions\": %zu", config->repetitions);
+    fputs(",\n    \"target_time_sec\": ", json_file);
+    write_number(config->target_time_sec);
+    fprintf(json_file, ",\n    \"min_iterations\": %zu", config->min_iterations);
+    fputs("\n  },\n", json_file);
+}
+
+int bench_json_begin(const char *path, const char *tool)
+{
+    if (json_file)
+        bench_json_end();
+
+    json_file = fopen(path, "w");
+    if (!json_file)
+        return -1;
+    json_result_count = 0;
+
+    fputs("{\n  \"schema\": ", json_file);
+    write_string(BENCH_JSON_SCHEMA);
+    fputs(",\n  \"tool\": ", json_file);
+    write_string(tool);
+    fputs(",\n", json_file);
+    write_environment();
+    fputs("  \"results\": [", json_file);
+    return 0;
+}
+
+int bench_json_active(void)
+{
+    return json_file != NULL;
+}
+
+void bench_json_record(const char *name,
+                       const char *implementation,
+                       const double *samples_ns,
+                       size_t count,
+                       size_t iterations,
+                       const BenchPerfSummary *perf)
+{
+    if (!json_file)
+        return;
+
+    BenchSummary summary = bench_summarize(samples_ns, count);
+
+    fputs(json_result_count > 0 ? ",\n    {" : "\n    {", json_file);
+    fputs("\"name\": ", json_file);
+    write_string(name);
+    fputs(", \"implementation\": ", json_file);
+    write_string(implementation);
+    fprintf(json_file, ", \"unit\": \"ns/op\", \"iterations\": %zu,\n     \"samples\": [", iterations);
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i > 0)
+            fputs(", ", json_file);
+        write_number(samples_ns[i]);
+    }
+    fputs("],\n     \"min\": ", json_file);
+    write_number(summary.min);
+    fputs(", \"median\": ", json_file);
+    write_number(summary.median);
+    fputs(", \"mad\": ", json_file);
+    write_number(summary.mad);
+    fputs(", \"mean\": ", json_file);
+    write_number(summary.mean);
+
+    fputs(",\n     \"perf\": ", json_file);
+    if (perf && perf->available)
+    {
+        fputs("{\"ipc\": ", json_file);
+        write_number(perf->ipc);
+        fputs(", \"cycles_per_op\": ", json_file);
+        write_number(perf->cycles_per_op);
+        fputs(", \"instructions_per_op\": ", json_file);
+        write_number(perf->instructions_per_op);
+        fputs(", \"branches_per_op\": ", json_file);
+        write_number(perf->branches_per_op);
+        fputs(", \"branch_misses_per_op\": ", json_file);
+        write_number(perf->branch_misses_per_op);
+        fputs(", \"branch_miss_rate\": ", json_file);
+        write_number(perf->branch_miss_rate);
+        fputs(", \"l1d_misses_per_op\": ", json_file);
+        write_number(perf->l1d_misses_per_op);
+        fputs(", \"llc_misses_per_op\": ", json_file);
+        write_number(perf->llc_misses_per_op);
+        fputs("}", json_file);
+    }
+    else
+    {
+        fputs("null", json_file);
+    }
+    fputs("}", json_file);
+
+    json_result_count++;
+}
+
+int bench_json_end(void)
+{
+    if (!json_file)
+        return -1;
+
+    fputs(json_result_count > 0 ? "\n  ]\n}\n" : "]\n}\n", json_file);
+    int status = ferror(json_file) ? -1 : 0;
+    if (fclose(json_file) != 0)
+        status = -1;
+    json_file = NULL;
+    return status;
+}
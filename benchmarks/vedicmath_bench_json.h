@@ -0,0 +1,75 @@
+/**
+ * vedicmath_bench_json.h - Machine-readable benchmark results
+ *
+ * Process-wide JSON sink shared by the benchmark binaries. Every recorded
+ * benchmark carries its full per-repetition samples (ns/op) so that two
+ * runs can be compared statistically with tools/bench_compare.c. The file
+ * starts with environment metadata (host, OS, CPU, compiler, harness
+ * settings) describing where the numbers came from.
+ *
+ * Layout:
+ *   {
+ *     "schema": "vedicmath-bench/1",
+ *     "tool": "...",
+ *     "environment": { ... },
+ *     "results": [
+ *       { "name": "...", "implementation": "...", "unit": "ns/op",
+ *         "iterations": N, "samples": [ ... ], "median": x, ...,
+ *         "perf": { ... } | null }
+ *     ]
+ *   }
+ */
+
+ #ifndef VEDICMATH_BENCH_JSON_H
+ #define VEDICMATH_BENCH_JSON_H
+
+ #include <stddef.h>
+ #include "vedicmath_perf_counters.h"
+
+ /**
+  * Schema identifier written to (and checked by) result files
+  */
+ #define BENCH_JSON_SCHEMA "vedicmath-bench/1"
+
+ /**
+  * Start writing results to a file
+  *
+  * Environment metadata is taken from the current harness configuration, so
+  * call this after bench_harness_set_config()/bench_harness_pin().
+  *
+  * @param path Output file
+  * @param tool Name of the benchmark binary
+  * @return 0 on success, -1 if the file could not be opened
+  */
+ int bench_json_begin(const char* path, const char* tool);
+
+ /**
+  * Whether a JSON sink is open
+  */
+ int bench_json_active(void);
+
+ /**
+  * Append one benchmark to the open sink (no-op when none is open)
+  *
+  * @param name Benchmark name
+  * @param implementation Implementation being measured
+  * @param samples_ns Per-repetition cost in nanoseconds per operation
+  * @param count Number of samples
+  * @param iterations Operations timed per sample
+  * @param perf Hardware counter summary (NULL or unavailable = no counters)
+  */
+ void bench_json_record(const char* name,
+                        const char* implementation,
+                        const double* samples_ns,
+                        size_t count,
+                        size_t iterations,
+                        const BenchPerfSummary* perf);
+
+ /**
+  * Finish the document and close the file
+  *
+  * @return 0 on success, -1 on a write error or if no sink was open
+  */
+ int bench_json_end(void);
+
+ #endif /* VEDICMATH_BENCH_JSON_H */
@@ -6,49 +6,42 @@
 #include "../include/vedicmath_types.h"
 #include "../include/vedicmath_dynamic.h"
 #include "../include/vedicmath_optimized.h"
+#include "../include/vedicmath_alloc.h"
+#include "../include/vedicmath_energy.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <time.h>
 
-#if defined(_WIN32) || defined(_WIN64)
-#include <windows.h>
-#elif defined(__APPLE__) || defined(__unix__) || defined(__linux__)
-#include <sys/time.h>
-#endif
+// Fixed seed so that repeated runs (and different library versions) are
+// measured on identical operand pools
+#define BENCH_SEED 20240501u
 
-// Helper function to get current time in seconds with high precision
-static double get_time()
-{
-#if defined(_WIN32) || defined(_WIN64)
-    // Windows timing
-    LARGE_INTEGER frequency, counter;
-    QueryPerformanceFrequency(&frequency);
-    QueryPerformanceCounter(&counter);
-    return (double)counter.QuadPart / (double)frequency.QuadPart;
-#elif defined(__APPLE__) || defined(__unix__) || defined(__linux__)
-    // Unix/Linux/macOS timing
-    struct timespec ts;
-#if defined(CLOCK_MONOTONIC)
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-#else
-    // Fallback for older systems
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    ts.tv_sec = tv.tv_sec;
-    ts.tv_nsec = tv.tv_usec * 1000;
-#endif
-    return ts.tv_sec + ts.tv_nsec / 1000000000.0;
-#else
-    // Generic fallback using C standard library
-    return (double)clock() / CLOCKS_PER_SEC;
-#endif
-}
+// Elements per call for the batch benchmarks (must divide BENCH_POOL_SIZE)
+#define BENCH_BATCH_SIZE 1024
 
 /**
  * Run a benchmark function and measure its performance
  */
+/**
+ * Discover the RAPL counters on first use and say once whether they work
+ */
+int benchmark_energy_available(void)
+{
+    static int reported = 0;
+    int zones = vedic_energy_init();
+    if (!reported)
+    {
+        reported = 1;
+        if (zones > 0)
+            printf("Energy counters: %s\n", vedic_energy_status());
+        else
+            printf("Energy counters unavailable (%s); reporting no joules/op\n", vedic_energy_status());
+    }
+    return zones > 0;
+}
+
 BenchmarkResult run_benchmark(
     const char *name,
     const char *implementation,
@@ -57,21 +50,92 @@ BenchmarkResult run_benchmark(
     void *data)
 {
     BenchmarkResult result;
+    memset(&result, 0, sizeof(result));
     result.name = name;
     result.implementation = implementation;
-    result.iterations = iterations;
+    result.cpu = bench_harness_pinned_cpu();
 
-    // Warm up the cache
-    func(iterations / 10, data);
+    BenchHarnessConfig config = *bench_harness_get_config();
+    if (iterations > config.min_iterations)
+        config.min_iterations = iterations;
+    if (config.max_iterations < config.min_iterations)
+        config.max_iterations = config.min_iterations;
 
-    // Measure execution time
-    double start_time = get_time();
-    result.success = func(iterations, data);
-    double end_time = get_time();
+    // Calibration doubles as the warm-up phase
+    result.iterations = bench_calibrate(func, data, &config);
+    if (result.iterations == 0)
+    {
+        result.success = 0;
+        return result;
+    }
+
+    result.success = 1;
+    result.repetitions = config.repetitions;
+
+    // Counters cover all timed repetitions; the clock reads in between are
+    // negligible next to a calibrated repetition
+    BenchPerfCounters *counters = bench_perf_shared();
+    BenchPerfSample perf_sample;
+    VedicEnergySample energy_start, energy_end;
+    int energy = benchmark_energy_available() && vedic_energy_read(&energy_start) == 0;
+    bench_perf_start(counters);
+
+    for (size_t rep = 0; rep < result.repetitions; rep++)
+    {
+        uint64_t start = bench_now_ns();
+        int ok = func(result.iterations, data);
+        uint64_t elapsed = bench_now_ns() - start;
+
+        if (!ok)
+            result.success = 0;
+        result.samples_ns[rep] = (double)elapsed / (double)result.iterations;
+    }
 
-    // Calculate performance metrics
-    result.elapsed_time = end_time - start_time;
-    result.operations_per_sec = iterations / result.elapsed_time;
+    bench_perf_stop(counters, &perf_sample);
+    result.perf = bench_perf_summarize(&perf_sample,
+                                       (double)result.iterations * (double)result.repetitions);
+
+    if (energy && vedic_energy_read(&energy_end) == 0)
+    {
+        double operations = (double)result.iterations * (double)result.repetitions;
+        double package = vedic_energy_joules(&energy_start, &energy_end, VEDIC_ENERGY_PACKAGE);
+        double seconds = (double)(energy_end.timestamp_ns - energy_start.timestamp_ns) / 1e9;
+
+        result.energy_measured = 1;
+        result.package_joules_per_op = package / operations;
+        result.core_joules_per_op = vedic_energy_joules(&energy_start, &energy_end, VEDIC_ENERGY_CORE) / operations;
+        result.package_watts = seconds > 0.0 ? package / seconds : 0.0;
+    }
+
+    BenchSummary summary = bench_summarize(result.samples_ns, result.repetitions);
+    result.min_ns = summary.min;
+    result.median_ns = summary.median;
+    result.mad_ns = summary.mad;
+    result.mean_ns = summary.mean;
+
+    bench_json_record(name, implementation, result.samples_ns, result.repetitions,
+                      result.iterations, &result.perf);
+
+    // Legacy fields are derived from the median repetition
+    result.elapsed_time = summary.median * (double)result.iterations / 1e9;
+    result.operations_per_sec = summary.median > 0.0 ? 1e9 / summary.median : 0.0;
+
+    if (config.track_allocations)
+    {
+        bool was_enabled = vedic_alloc_tracking_enabled();
+        VedicAllocCounts before = vedic_alloc_get_totals();
+
+        vedic_alloc_tracking_enable(true);
+        func(result.iterations, data);
+        vedic_alloc_tracking_enable(was_enabled);
+
+        VedicAllocCounts after = vedic_alloc_get_totals();
+        uint64_t calls = (after.allocations - before.allocations) +
+                         (after.reallocations - before.reallocations);
+        result.alloc_tracked = 1;
+        result.allocs_per_op = (double)calls / (double)result.iterations;
+        result.alloc_bytes_per_op = (double)(after.bytes - before.bytes) / (double)result.iterations;
+    }
 
     return result;
 }
@@ -81,12 +145,27 @@ BenchmarkResult run_benchmark(
  */
 void print_benchmark_result(const BenchmarkResult *result)
 {
-    printf("%-25s %-15s: %10.6f sec (%10.2f ops/sec) [%s]\n",
+    printf("%-25s %-15s: %9.2f ns/op (MAD %6.2f, min %9.2f) %14.2f ops/sec [%zux%zu] [%s]\n",
            result->name,
            result->implementation,
-           result->elapsed_time,
+           result->median_ns,
+           result->mad_ns,
+           result->min_ns,
            result->operations_per_sec,
+           result->repetitions,
+           result->iterations,
            result->success ? "SUCCESS" : "FAILED");
+    bench_perf_print_summary(&result->perf, "    perf: ");
+    if (result->energy_measured)
+    {
+        printf("    energy: %.3f nJ/op package, %.3f nJ/op core (%.1f W package)\n",
+               result->package_joules_per_op * 1e9, result->core_joules_per_op * 1e9, result->package_watts);
+    }
+    if (result->alloc_tracked)
+    {
+        printf("    alloc: %.3f allocs/op, %.1f bytes/op\n",
+               result->allocs_per_op, result->alloc_bytes_per_op);
+    }
 }
 
 /**
@@ -94,25 +173,38 @@ void print_benchmark_result(const BenchmarkResult *result)
  */
 void print_benchmark_comparison(const BenchmarkResult *baseline, const BenchmarkResult *optimized)
 {
-    double speedup = optimized->operations_per_sec / baseline->operations_per_sec;
+    double speedup = optimized->median_ns > 0.0 ? baseline->median_ns / optimized->median_ns : 0.0;
 
     printf("Comparison: %s vs %s for %s\n",
            baseline->implementation,
            optimized->implementation,
            baseline->name);
-    printf("  - %s: %10.6f sec (%10.2f ops/sec)\n",
+    printf("  - %s: %9.2f ns/op (MAD %.2f) (%14.2f ops/sec)\n",
            baseline->implementation,
-           baseline->elapsed_time,
+           baseline->median_ns,
+           baseline->mad_ns,
            baseline->operations_per_sec);
-    printf("  - %s: %10.6f sec (%10.2f ops/sec)\n",
+    printf("  - %s: %9.2f ns/op (MAD %.2f) (%14.2f ops/sec)\n",
            optimized->implementation,
-           optimized->elapsed_time,
+           optimized->median_ns,
+           optimized->mad_ns,
            optimized->operations_per_sec);
+    if (baseline->perf.available && optimized->perf.available)
+    {
+        printf("  Cycles/op: %.2f vs %.2f, branch misses/op: %.4f vs %.4f, L1D misses/op: %.4f vs %.4f\n",
+               baseline->perf.cycles_per_op, optimized->perf.cycles_per_op,
+               baseline->perf.branch_misses_per_op, optimized->perf.branch_misses_per_op,
+               baseline->perf.l1d_misses_per_op, optimized->perf.l1d_misses_per_op);
+    }
     printf("  Speedup: %.2fx\n\n", speedup);
 }
 
 /**
  * Structure for benchmark data
+ *
+ * All operands are generated into fixed-size pools before timing starts;
+ * benchmark loops walk the pools with BENCH_POOL_MASK so that nothing but
+ * the operation under test lands in the timed region.
  */
 typedef struct
 {
@@ -126,21 +218,18 @@ typedef struct
         CASE_EXPRESSIONS     // Mathematical expressions
     } case_type;
 
-    // Test data
-    union
-    {
-        struct
-        {
-            int range_min; // Minimum value for random numbers
-            int range_max; // Maximum value for random numbers
-        } random;
+    // Operand pools (BENCH_POOL_SIZE entries each)
+    int *a;
+    int *b;
+    VedicValue *va; // a[] pre-converted for the dynamic/optimized APIs
+    VedicValue *vb; // b[] pre-converted for the dynamic/optimized APIs
 
-        struct
-        {
-            char **expressions; // Array of expressions to evaluate
-            size_t count;       // Number of expressions
-        } expressions;
-    } data;
+    // Output buffers for the batch benchmarks
+    int *results;
+    VedicValue *vresults;
+
+    // Expression pool (BENCH_POOL_SIZE pointers into caller-owned strings)
+    const char **expressions;
 } BenchmarkData;
 
 /**
@@ -156,16 +245,12 @@ static int random_int(int min, int max)
  */
 static int random_ending_in_5(int min, int max)
 {
-    // Ensure the minimum is properly aligned
+    // Align both ends of the range to numbers ending in 5
     min = (min / 10) * 10 + 5;
-
-    // Ensure the maximum is properly aligned
     if (max % 10 != 5)
-    {
-        max = (max / 10) * 10 + 5;
-        if (max > max)
-            max -= 10; // Adjust if we went over
-    }
+        max = (max / 10) * 10 - 5;
+    if (max < min)
+        max = min;
 
     // Generate a random number that ends in 5
     int range = (max - min) / 10 + 1;
@@ -222,23 +307,108 @@ static void random_antyayordasake_pair(int min, int max, int *a, int *b)
     }
 }
 
+/**
+ * Release the pools of a BenchmarkData
+ */
+static void benchmark_data_free(BenchmarkData *data)
+{
+    free(data->a);
+    free(data->b);
+    free(data->va);
+    free(data->vb);
+    free(data->results);
+    free(data->vresults);
+    free((void *)data->expressions);
+    memset(data, 0, sizeof(*data));
+}
+
+/**
+ * Allocate and fill the operand pools for a numeric case type
+ *
+ * @return 1 on success, 0 if allocation failed
+ */
+static int benchmark_data_init(BenchmarkData *data, int case_type, int min, int max)
+{
+    memset(data, 0, sizeof(*data));
+    data->case_type = case_type;
+    data->a = (int *)malloc(BENCH_POOL_SIZE * sizeof(int));
+    data->b = (int *)malloc(BENCH_POOL_SIZE * sizeof(int));
+    data->va = (VedicValue *)malloc(BENCH_POOL_SIZE * sizeof(VedicValue));
+    data->vb = (VedicValue *)malloc(BENCH_POOL_SIZE * sizeof(VedicValue));
+    data->results = (int *)malloc(BENCH_POOL_SIZE * sizeof(int));
+    data->vresults = (VedicValue *)malloc(BENCH_POOL_SIZE * sizeof(VedicValue));
+
+    if (!data->a || !data->b || !data->va || !data->vb || !data->results || !data->vresults)
+    {
+        benchmark_data_free(data);
+        return 0;
+    }
+
+    for (size_t i = 0; i < BENCH_POOL_SIZE; i++)
+    {
+        switch (data->case_type)
+        {
+        case CASE_EKADHIKENA:
+            data->a[i] = random_ending_in_5(min, max);
+            data->b[i] = data->a[i];
+            break;
+        case CASE_NIKHILAM:
+            data->a[i] = random_near_base(min, max);
+            data->b[i] = random_near_base(min, max);
+            break;
+        case CASE_ANTYAYORDASAKE:
+            random_antyayordasake_pair(min, max, &data->a[i], &data->b[i]);
+            break;
+        default:
+            data->a[i] = random_int(min, max);
+            data->b[i] = random_int(min, max);
+            break;
+        }
+        data->va[i] = vedic_from_int32(data->a[i]);
+        data->vb[i] = vedic_from_int32(data->b[i]);
+    }
+
+    return 1;
+}
+
+/**
+ * Fill the expression pool by cycling over a list of expressions
+ *
+ * @return 1 on success, 0 if allocation failed
+ */
+static int benchmark_data_init_expressions(BenchmarkData *data, char **expressions, size_t count)
+{
+    memset(data, 0, sizeof(*data));
+    data->case_type = CASE_EXPRESSIONS;
+    data->expressions = (const char **)malloc(BENCH_POOL_SIZE * sizeof(const char *));
+    if (!data->expressions || count == 0)
+    {
+        benchmark_data_free(data);
+        return 0;
+    }
+
+    for (size_t i = 0; i < BENCH_POOL_SIZE; i++)
+    {
+        data->expressions[i] = expressions[i % count];
+    }
+
+    return 1;
+}
+
 /**
  * Standard multiplication benchmark
  */
 int benchmark_standard_multiply(size_t iterations, void *data)
 {
-    BenchmarkData *benchmark_data = (BenchmarkData *)data;
-    int min = benchmark_data->data.random.range_min;
-    int max = benchmark_data->data.random.range_max;
-
-    // Use volatile to prevent compiler optimizations
-    volatile int result = 0;
+    const BenchmarkData *benchmark_data = (const BenchmarkData *)data;
+    const int *a = benchmark_data->a;
+    const int *b = benchmark_data->b;
 
     for (size_t i = 0; i < iterations; i++)
     {
-        int a = random_int(min, max);
-        int b = random_int(min, max);
-        result = a * b;
+        size_t j = i & BENCH_POOL_MASK;
+        int result = a[j] * b[j];
+        BENCH_DO_NOT_OPTIMIZE(result);
     }
 
     return 1; // Success
@@ -249,18 +419,15 @@ int benchmark_standard_multiply(size_t iterations, void *data)
  */
 int benchmark_vedic_multiply(size_t iterations, void *data)
 {
-    BenchmarkData *benchmark_data = (BenchmarkData *)data;
-    int min = benchmark_data->data.random.range_min;
-    int max = benchmark_data->data.random.range_max;
-
-    // Use volatile to prevent compiler optimizations
-    volatile long result = 0;
+    const BenchmarkData *benchmark_data = (const BenchmarkData *)data;
+    const int *a = benchmark_data->a;
+    const int *b = benchmark_data->b;
 
     for (size_t i = 0; i < iterations; i++)
     {
-        long a = random_int(min, max);
-        long b = random_int(min, max);
-        result = vedic_multiply(a, b);
+        size_t j = i & BENCH_POOL_MASK;
+        long result = vedic_multiply(a[j], b[j]);
+        BENCH_DO_NOT_OPTIMIZE(result);
     }
 
     return 1; // Success
@@ -271,18 +438,15 @@ int benchmark_vedic_multiply(size_t iterations, void *data)
  */
 int benchmark_dynamic_multiply(size_t iterations, void *data)
 {
-    BenchmarkData *benchmark_data = (BenchmarkData *)data;
-    int min = benchmark_data->data.random.range_min;
-    int max = benchmark_data->data.random.range_max;
-
-    // Use volatile to prevent compiler optimizations
-    volatile VedicValue result;
+    const BenchmarkData *benchmark_data = (const BenchmarkData *)data;
+    const VedicValue *a = benchmark_data->va;
+    const VedicValue *b = benchmark_data->vb;
 
     for (size_t i = 0; i < iterations; i++)
     {
-        VedicValue a = vedic_from_int32(random_int(min, max));
-        VedicValue b = vedic_from_int32(random_int(min, max));
-        result = vedic_dynamic_multiply(a, b);
+        size_t j = i & BENCH_POOL_MASK;
+        VedicValue result = vedic_dynamic_multiply(a[j], b[j]);
+        BENCH_DO_NOT_OPTIMIZE(result);
     }
 
     return 1; // Success
@@ -290,29 +454,22 @@ int benchmark_dynamic_multiply(size_t iterations, void *data)
 
 /**
  * Optimized multiplication benchmark
+ *
+ * vedic_optimized_init() must have been called before timing starts.
  */
 int benchmark_optimized_multiply(size_t iterations, void *data)
 {
-    BenchmarkData *benchmark_data = (BenchmarkData *)data;
-    int min = benchmark_data->data.random.range_min;
-    int max = benchmark_data->data.random.range_max;
-
-    // Initialize the optimization tables
-    vedic_optimized_init();
-
-    // Use volatile to prevent compiler optimizations
-    volatile VedicValue result;
+    const BenchmarkData *benchmark_data = (const BenchmarkData *)data;
+    const VedicValue *a = benchmark_data->va;
+    const VedicValue *b = benchmark_data->vb;
 
     for (size_t i = 0; i < iterations; i++)
     {
-        VedicValue a = vedic_from_int32(random_int(min, max));
-        VedicValue b = vedic_from_int32(random_int(min, max));
-        result = vedic_optimized_multiply(a, b);
+        size_t j = i & BENCH_POOL_MASK;
+        VedicValue result = vedic_optimized_multiply(a[j], b[j]);
+        BENCH_DO_NOT_OPTIMIZE(result);
     }
 
-    // Clean up
-    vedic_optimized_cleanup();
-
     return 1; // Success
 }
 
@@ -321,21 +478,17 @@ int benchmark_optimized_multiply(size_t iterations, void *data)
  */
 int benchmark_standard_evaluate(size_t iterations, void *data)
 {
-    BenchmarkData *benchmark_data = (BenchmarkData *)data;
-    char **expressions = benchmark_data->data.expressions.expressions;
-    size_t count = benchmark_data->data.expressions.count;
-
-    // Use volatile to prevent compiler optimizations
-    volatile int result = 0;
+    const BenchmarkData *benchmark_data = (const BenchmarkData *)data;
+    const char **expressions = benchmark_data->expressions;
 
     for (size_t i = 0; i < iterations; i++)
     {
-        // Pick a random expression
-        const char *expr = expressions[i % count];
+        const char *expr = expressions[i & BENCH_POOL_MASK];
 
         // Parse the expression manually (simplified for benchmark)
         char op = 0;
         int a = 0, b = 0;
+        int result;
         sscanf(expr, "%d %c %d", &a, &op, &b);
 
         // Evaluate
@@ -360,6 +513,7 @@ int benchmark_standard_evaluate(size_t iterations, void *data)
             result = 0;
             break;
         }
+        BENCH_DO_NOT_OPTIMIZE(result);
     }
 
     return 1; // Success
@@ -370,20 +524,13 @@ int benchmark_standard_evaluate(size_t iterations, void *data)
  */
 int benchmark_dynamic_evaluate(size_t iterations, void *data)
 {
-    BenchmarkData *benchmark_data = (BenchmarkData *)data;
-    char **expressions = benchmark_data->data.expressions.expressions;
-    size_t count = benchmark_data->data.expressions.count;
-
-    // Use volatile to prevent compiler optimizations
-    volatile VedicValue result;
+    const BenchmarkData *benchmark_data = (const BenchmarkData *)data;
+    const char **expressions = benchmark_data->expressions;
 
     for (size_t i = 0; i < iterations; i++)
     {
-        // Pick a random expression
-        const char *expr = expressions[i % count];
-
-        // Evaluate
-        result = vedic_dynamic_evaluate(expr);
+        VedicValue result = vedic_dynamic_evaluate(expressions[i & BENCH_POOL_MASK]);
+        BENCH_DO_NOT_OPTIMIZE(result);
     }
 
     return 1; // Success
@@ -391,506 +538,284 @@ int benchmark_dynamic_evaluate(size_t iterations, void *data)
 
 /**
  * Optimized expression evaluation benchmark
+ *
+ * vedic_optimized_init() must have been called before timing starts.
  */
 int benchmark_optimized_evaluate(size_t iterations, void *data)
 {
-    BenchmarkData *benchmark_data = (BenchmarkData *)data;
-    char **expressions = benchmark_data->data.expressions.expressions;
-    size_t count = benchmark_data->data.expressions.count;
-
-    // Initialize the optimization tables
-    vedic_optimized_init();
-
-    // Use volatile to prevent compiler optimizations
-    volatile VedicValue result;
+    const BenchmarkData *benchmark_data = (const BenchmarkData *)data;
+    const char **expressions = benchmark_data->expressions;
 
     for (size_t i = 0; i < iterations; i++)
     {
-        // Pick a random expression
-        const char *expr = expressions[i % count];
-
-        // Evaluate
-        result = vedic_optimized_evaluate(expr);
+        VedicValue result = vedic_optimized_evaluate(expressions[i & BENCH_POOL_MASK]);
+        BENCH_DO_NOT_OPTIMIZE(result);
     }
 
-    // Clean up
-    vedic_optimized_cleanup();
-
     return 1; // Success
 }
 
 /**
  * Benchmark batch multiplication with standard approach
+ *
+ * Processes the pool in BENCH_BATCH_SIZE chunks; iterations counts elements.
  */
 int benchmark_batch_multiply_standard(size_t iterations, void *data)
 {
     BenchmarkData *benchmark_data = (BenchmarkData *)data;
-    int min = benchmark_data->data.random.range_min;
-    int max = benchmark_data->data.random.range_max;
-
-    // Batch size for multiplication
-    const size_t batch_size = 1000;
+    const int *a = benchmark_data->a;
+    const int *b = benchmark_data->b;
+    int *results = benchmark_data->results;
 
-    // Allocate arrays for batch operations
-    int *a = (int *)malloc(batch_size * sizeof(int));
-    int *b = (int *)malloc(batch_size * sizeof(int));
-    int *results = (int *)malloc(batch_size * sizeof(int));
-
-    if (!a || !b || !results)
-    {
-        // Memory allocation failed
-        free(a);
-        free(b);
-        free(results);
-        return 0;
-    }
-
-    // Number of batches to run
-    size_t batches = iterations / batch_size;
-    if (batches == 0)
-        batches = 1;
-
-    for (size_t batch = 0; batch < batches; batch++)
+    for (size_t done = 0; done < iterations; done += BENCH_BATCH_SIZE)
     {
-        // Generate random inputs
-        for (size_t i = 0; i < batch_size; i++)
-        {
-            a[i] = random_int(min, max);
-            b[i] = random_int(min, max);
-        }
+        size_t offset = done & BENCH_POOL_MASK;
+        size_t count = iterations - done < BENCH_BATCH_SIZE ? iterations - done : BENCH_BATCH_SIZE;
 
-        // Perform batch multiplication
-        for (size_t i = 0; i < batch_size; i++)
+        for (size_t i = 0; i < count; i++)
         {
-            results[i] = a[i] * b[i];
+            results[offset + i] = a[offset + i] * b[offset + i];
         }
+        BENCH_CLOBBER_MEMORY();
     }
 
-    // Clean up
-    free(a);
-    free(b);
-    free(results);
-
     return 1; // Success
 }
 
 /**
  * Benchmark batch multiplication with optimized approach
+ *
+ * Processes the pool in BENCH_BATCH_SIZE chunks; iterations counts elements.
  */
 int benchmark_batch_multiply_optimized(size_t iterations, void *data)
 {
     BenchmarkData *benchmark_data = (BenchmarkData *)data;
-    int min = benchmark_data->data.random.range_min;
-    int max = benchmark_data->data.random.range_max;
-
-    // Batch size for multiplication
-    const size_t batch_size = 1000;
-
-    // Allocate arrays for batch operations
-    VedicValue *a = (VedicValue *)malloc(batch_size * sizeof(VedicValue));
-    VedicValue *b = (VedicValue *)malloc(batch_size * sizeof(VedicValue));
-    VedicValue *results = (VedicValue *)malloc(batch_size * sizeof(VedicValue));
-
-    if (!a || !b || !results)
-    {
-        // Memory allocation failed
-        free(a);
-        free(b);
-        free(results);
-        return 0;
-    }
-
-    // Initialize the optimization tables
-    vedic_optimized_init();
-
-    // Number of batches to run
-    size_t batches = iterations / batch_size;
-    if (batches == 0)
-        batches = 1;
 
-    for (size_t batch = 0; batch < batches; batch++)
+    for (size_t done = 0; done < iterations; done += BENCH_BATCH_SIZE)
     {
-        // Generate random inputs
-        for (size_t i = 0; i < batch_size; i++)
-        {
-            a[i] = vedic_from_int32(random_int(min, max));
-            b[i] = vedic_from_int32(random_int(min, max));
-        }
+        size_t offset = done & BENCH_POOL_MASK;
+        size_t count = iterations - done < BENCH_BATCH_SIZE ? iterations - done : BENCH_BATCH_SIZE;
 
-        // Perform batch multiplication
-        vedic_optimized_multiply_batch(results, a, b, batch_size);
+        vedic_optimized_multiply_batch(benchmark_data->vresults + offset,
+                                       benchmark_data->va + offset,
+                                       benchmark_data->vb + offset,
+                                       count);
+        BENCH_CLOBBER_MEMORY();
     }
 
-    // Clean up
-    vedic_optimized_cleanup();
-    free(a);
-    free(b);
-    free(results);
-
     return 1; // Success
 }
 
 /**
- * Benchmark Ekadhikena Purvena (squaring numbers ending in 5)
+ * Benchmark Ekadhikena Purvena (direct sutra call on numbers ending in 5)
  */
 int benchmark_ekadhikena_purvena(size_t iterations, void *data)
 {
-    BenchmarkData *benchmark_data = (BenchmarkData *)data;
-    int min = benchmark_data->data.random.range_min;
-    int max = benchmark_data->data.random.range_max;
+    const BenchmarkData *benchmark_data = (const BenchmarkData *)data;
+    const int *numbers = benchmark_data->a;
 
-    // Generate array of numbers ending in 5
-    int *numbers = (int *)malloc(iterations * sizeof(int));
-    if (!numbers)
-    {
-        return 0; // Memory allocation failed
-    }
-
-    // Generate random numbers ending in 5
     for (size_t i = 0; i < iterations; i++)
     {
-        numbers[i] = random_ending_in_5(min, max);
+        long result = ekadhikena_purvena(numbers[i & BENCH_POOL_MASK]);
+        BENCH_DO_NOT_OPTIMIZE(result);
     }
 
-    // Run benchmarks on the different implementations
-    // Standard multiplication
-    volatile int std_result = 0;
-    for (size_t i = 0; i < iterations; i++)
-    {
-        std_result = numbers[i] * numbers[i];
-    }
-
-    // Vedic squaring
-    volatile long vedic_result = 0;
-    for (size_t i = 0; i < iterations; i++)
-    {
-        vedic_result = vedic_square(numbers[i]);
-    }
-
-    // Dynamic squaring
-    volatile VedicValue dynamic_result;
-    for (size_t i = 0; i < iterations; i++)
-    {
-        VedicValue a = vedic_from_int32(numbers[i]);
-        dynamic_result = vedic_dynamic_multiply(a, a);
-    }
-
-    // Optimized squaring
-    vedic_optimized_init();
-    volatile VedicValue optimized_result;
-    for (size_t i = 0; i < iterations; i++)
-    {
-        VedicValue a = vedic_from_int32(numbers[i]);
-        optimized_result = vedic_optimized_multiply(a, a);
-    }
-    vedic_optimized_cleanup();
-
-    // Clean up
-    free(numbers);
-
     return 1; // Success
 }
 
 /**
- * Benchmark Nikhilam (multiplication of numbers near a base)
+ * Benchmark Nikhilam (direct sutra call on numbers near a base)
  */
 int benchmark_nikhilam_mul(size_t iterations, void *data)
 {
-    BenchmarkData *benchmark_data = (BenchmarkData *)data;
-    int min = benchmark_data->data.random.range_min;
-    int max = benchmark_data->data.random.range_max;
-
-    // Generate arrays of numbers near a base
-    int *a = (int *)malloc(iterations * sizeof(int));
-    int *b = (int *)malloc(iterations * sizeof(int));
-    if (!a || !b)
-    {
-        free(a);
-        free(b);
-        return 0; // Memory allocation failed
-    }
-
-    // Generate random numbers near a base
-    for (size_t i = 0; i < iterations; i++)
-    {
-        a[i] = random_near_base(min, max);
-        b[i] = random_near_base(min, max);
-    }
+    const BenchmarkData *benchmark_data = (const BenchmarkData *)data;
+    const int *a = benchmark_data->a;
+    const int *b = benchmark_data->b;
 
-    // Run benchmarks on the different implementations
-    // Standard multiplication
-    volatile int std_result = 0;
     for (size_t i = 0; i < iterations; i++)
     {
-        std_result = a[i] * b[i];
+        size_t j = i & BENCH_POOL_MASK;
+        long result = nikhilam_mul(a[j], b[j]);
+        BENCH_DO_NOT_OPTIMIZE(result);
     }
 
-    // Vedic multiplication
-    volatile long vedic_result = 0;
-    for (size_t i = 0; i < iterations; i++)
-    {
-        vedic_result = vedic_multiply(a[i], b[i]);
-    }
+    return 1; // Success
+}
 
-    // Dynamic multiplication
-    volatile VedicValue dynamic_result;
-    for (size_t i = 0; i < iterations; i++)
-    {
-        VedicValue va = vedic_from_int32(a[i]);
-        VedicValue vb = vedic_from_int32(b[i]);
-        dynamic_result = vedic_dynamic_multiply(va, vb);
-    }
+/**
+ * Benchmark Antyayordasake (direct sutra call on last digits summing to 10)
+ */
+int benchmark_antyayordasake(size_t iterations, void *data)
+{
+    const BenchmarkData *benchmark_data = (const BenchmarkData *)data;
+    const int *a = benchmark_data->a;
+    const int *b = benchmark_data->b;
 
-    // Optimized multiplication
-    vedic_optimized_init();
-    volatile VedicValue optimized_result;
     for (size_t i = 0; i < iterations; i++)
     {
-        VedicValue va = vedic_from_int32(a[i]);
-        VedicValue vb = vedic_from_int32(b[i]);
-        optimized_result = vedic_optimized_multiply(va, vb);
+        size_t j = i & BENCH_POOL_MASK;
+        int result = antya_dasake_mul(a[j], b[j]);
+        BENCH_DO_NOT_OPTIMIZE(result);
     }
-    vedic_optimized_cleanup();
-
-    // Clean up
-    free(a);
-    free(b);
 
     return 1; // Success
 }
 
 /**
- * Benchmark Antyayordasake (numbers with last digits summing to 10)
+ * Benchmark the Vedic squaring dispatcher
  */
-int benchmark_antyayordasake(size_t iterations, void *data)
+int benchmark_vedic_square(size_t iterations, void *data)
 {
-    BenchmarkData *benchmark_data = (BenchmarkData *)data;
-    int min = benchmark_data->data.random.range_min;
-    int max = benchmark_data->data.random.range_max;
-
-    // Generate arrays of number pairs
-    int *a = (int *)malloc(iterations * sizeof(int));
-    int *b = (int *)malloc(iterations * sizeof(int));
-    if (!a || !b)
-    {
-        free(a);
-        free(b);
-        return 0; // Memory allocation failed
-    }
-
-    // Generate random number pairs
-    for (size_t i = 0; i < iterations; i++)
-    {
-        random_antyayordasake_pair(min, max, &a[i], &b[i]);
-    }
+    const BenchmarkData *benchmark_data = (const BenchmarkData *)data;
+    const int *numbers = benchmark_data->a;
 
-    // Run benchmarks on the different implementations
-    // Standard multiplication
-    volatile int std_result = 0;
     for (size_t i = 0; i < iterations; i++)
     {
-        std_result = a[i] * b[i];
+        long result = vedic_square(numbers[i & BENCH_POOL_MASK]);
+        BENCH_DO_NOT_OPTIMIZE(result);
     }
 
-    // Vedic multiplication
-    volatile long vedic_result = 0;
-    for (size_t i = 0; i < iterations; i++)
-    {
-        vedic_result = vedic_multiply(a[i], b[i]);
-    }
+    return 1; // Success
+}
 
-    // Dynamic multiplication
-    volatile VedicValue dynamic_result;
-    for (size_t i = 0; i < iterations; i++)
+/**
+ * Time Standard and Vedic multiplication on one pattern pool and print the
+ * comparison. Shared by the *_specific benchmarks below.
+ */
+static int run_pattern_comparison(const char *title, int case_type, int min, int max, size_t iterations)
+{
+    BenchmarkData pattern_data;
+    if (!benchmark_data_init(&pattern_data, case_type, min, max))
     {
-        VedicValue va = vedic_from_int32(a[i]);
-        VedicValue vb = vedic_from_int32(b[i]);
-        dynamic_result = vedic_dynamic_multiply(va, vb);
+        return 0; // Memory allocation failed
     }
 
-    // Optimized multiplication
-    vedic_optimized_init();
-    volatile VedicValue optimized_result;
-    for (size_t i = 0; i < iterations; i++)
-    {
-        VedicValue va = vedic_from_int32(a[i]);
-        VedicValue vb = vedic_from_int32(b[i]);
-        optimized_result = vedic_optimized_multiply(va, vb);
-    }
-    vedic_optimized_cleanup();
+    BenchmarkResult standard = run_benchmark(title, "Standard", benchmark_standard_multiply,
+                                             iterations, &pattern_data);
+    BenchmarkResult vedic = run_benchmark(title, "Vedic", benchmark_vedic_multiply,
+                                          iterations, &pattern_data);
 
-    // Clean up
-    free(a);
-    free(b);
+    print_benchmark_result(&standard);
+    print_benchmark_result(&vedic);
+    print_benchmark_comparison(&standard, &vedic);
 
-    return 1; // Success
+    benchmark_data_free(&pattern_data);
+    return standard.success && vedic.success;
 }
 
 /**
  * Benchmark Ekadhikena Purvena specifically (numbers ending in 5)
  */
-int benchmark_ekadhikena_specific(size_t iterations, void* data) {
+int benchmark_ekadhikena_specific(size_t iterations, void *data)
+{
+    (void)data;
     printf("=== EKADHIKENA PURVENA SPECIFIC TEST ===\n");
-    
-    // Generate ONLY numbers ending in 5
-    int* numbers_ending_5 = malloc(iterations * sizeof(int));
-    for (size_t i = 0; i < iterations; i++) {
-        int base = (rand() % 99 + 1); // 1-99
-        numbers_ending_5[i] = base * 10 + 5; // Always ends in 5
-    }
-    
-    // Test Standard vs Vedic on PERFECT Ekadhikena cases
-    clock_t start, end;
-    
-    // Standard squaring
-    start = clock();
-    for (size_t i = 0; i < iterations; i++) {
-        volatile int result = numbers_ending_5[i] * numbers_ending_5[i];
-        (void)result;
-    }
-    end = clock();
-    double standard_time = ((double)(end - start)) / CLOCKS_PER_SEC;
-    
-    // Vedic squaring (should use Ekadhikena Purvena)
-    start = clock();
-    for (size_t i = 0; i < iterations; i++) {
-        volatile long result = vedic_multiply(numbers_ending_5[i], numbers_ending_5[i]);
-        (void)result;
-    }
-    end = clock();
-    double vedic_time = ((double)(end - start)) / CLOCKS_PER_SEC;
-    
-    printf("Ekadhikena Pattern Results:\n");
-    printf("  Standard: %.6f sec (%.0f ops/sec)\n", standard_time, iterations/standard_time);
-    printf("  Vedic:    %.6f sec (%.0f ops/sec)\n", vedic_time, iterations/vedic_time);
-    printf("  Speedup:  %.2fx\n", standard_time/vedic_time);
-    
-    free(numbers_ending_5);
-    return 1;
+
+    // Only numbers ending in 5 (15..995)
+    return run_pattern_comparison("Ekadhikena Pattern", CASE_EKADHIKENA, 15, 995, iterations);
 }
 
 /**
  * Benchmark Nikhilam specifically (numbers near powers of 10)
  */
-int benchmark_nikhilam_specific(size_t iterations, void* data) {
+int benchmark_nikhilam_specific(size_t iterations, void *data)
+{
+    (void)data;
     printf("=== NIKHILAM SPECIFIC TEST ===\n");
-    
-    // Generate numbers near 100
-    int* near_100_a = malloc(iterations * sizeof(int));
-    int* near_100_b = malloc(iterations * sizeof(int));
-    
-    for (size_t i = 0; i < iterations; i++) {
-        // Numbers between 85-115 (within 15% of 100)
-        near_100_a[i] = 85 + (rand() % 31); // 85-115
-        near_100_b[i] = 85 + (rand() % 31); // 85-115
-    }
-    
-    clock_t start, end;
-    
-    // Standard multiplication
-    start = clock();
-    for (size_t i = 0; i < iterations; i++) {
-        volatile int result = near_100_a[i] * near_100_b[i];
-        (void)result;
-    }
-    end = clock();
-    double standard_time = ((double)(end - start)) / CLOCKS_PER_SEC;
-    
-    // Vedic multiplication (should use Nikhilam)
-    start = clock();
-    for (size_t i = 0; i < iterations; i++) {
-        volatile long result = vedic_multiply(near_100_a[i], near_100_b[i]);
-        (void)result;
-    }
-    end = clock();
-    double vedic_time = ((double)(end - start)) / CLOCKS_PER_SEC;
-    
-    printf("Nikhilam Pattern Results:\n");
-    printf("  Standard: %.6f sec (%.0f ops/sec)\n", standard_time, iterations/standard_time);
-    printf("  Vedic:    %.6f sec (%.0f ops/sec)\n", vedic_time, iterations/vedic_time);
-    printf("  Speedup:  %.2fx\n", standard_time/vedic_time);
-    
-    free(near_100_a);
-    free(near_100_b);
-    return 1;
+
+    // Numbers between 90-110 (within 10% of 100)
+    return run_pattern_comparison("Nikhilam Pattern", CASE_NIKHILAM, 90, 110, iterations);
 }
 
 /**
  * Benchmark Antyayordasake specifically
  */
-int benchmark_antyayordasake_specific(size_t iterations, void* data) {
+int benchmark_antyayordasake_specific(size_t iterations, void *data)
+{
+    (void)data;
     printf("=== ANTYAYORDASAKE SPECIFIC TEST ===\n");
-    
-    int* numbers_a = malloc(iterations * sizeof(int));
-    int* numbers_b = malloc(iterations * sizeof(int));
-    
-    for (size_t i = 0; i < iterations; i++) {
-        int prefix = rand() % 9 + 1; // 1-9
-        int last_a = rand() % 9 + 1; // 1-9
-        int last_b = 10 - last_a;    // Ensure sum = 10
-        
-        numbers_a[i] = prefix * 10 + last_a;
-        numbers_b[i] = prefix * 10 + last_b;
-    }
-    
-    clock_t start, end;
-    
-    // Standard multiplication
-    start = clock();
-    for (size_t i = 0; i < iterations; i++) {
-        volatile int result = numbers_a[i] * numbers_b[i];
-        (void)result;
-    }
-    end = clock();
-    double standard_time = ((double)(end - start)) / CLOCKS_PER_SEC;
-    
-    // Vedic multiplication (should use Antyayordasake)
-    start = clock();
-    for (size_t i = 0; i < iterations; i++) {
-        volatile long result = vedic_multiply(numbers_a[i], numbers_b[i]);
-        (void)result;
-    }
-    end = clock();
-    double vedic_time = ((double)(end - start)) / CLOCKS_PER_SEC;
-    
-    printf("Antyayordasake Pattern Results:\n");
-    printf("  Standard: %.6f sec (%.0f ops/sec)\n", standard_time, iterations/standard_time);
-    printf("  Vedic:    %.6f sec (%.0f ops/sec)\n", vedic_time, iterations/vedic_time);
-    printf("  Speedup:  %.2fx\n", standard_time/vedic_time);
-    
-    free(numbers_a);
-    free(numbers_b);
-    return 1;
+
+    // Two-digit pairs with equal prefix and last digits summing to 10
+    return run_pattern_comparison("Antyayordasake Pattern", CASE_ANTYAYORDASAKE, 10, 99, iterations);
 }
 
-void run_pattern_specific_benchmarks(size_t iterations) {
+void run_pattern_specific_benchmarks(size_t iterations)
+{
     printf("\n=== PATTERN-SPECIFIC VEDIC BENCHMARKS ===\n");
-    
+
     benchmark_ekadhikena_specific(iterations, NULL);
     benchmark_nikhilam_specific(iterations, NULL);
     benchmark_antyayordasake_specific(iterations, NULL);
-    
+
     printf("\n=== ANALYSIS ===\n");
     printf("These tests use ONLY the patterns that should trigger Vedic optimizations.\n");
     printf("Random number tests will show poor Vedic performance because they\n");
     printf("rarely match the specific patterns Vedic sutras are optimized for.\n");
 }
 
+/**
+ * Run one sutra's pattern pool through Standard, the direct sutra call and
+ * the dispatcher-based implementations
+ */
+static void run_sutra_benchmarks(const char *name,
+                                 int case_type, int min, int max,
+                                 int (*sutra_func)(size_t iterations, void *data),
+                                 int (*vedic_func)(size_t iterations, void *data),
+                                 size_t count)
+{
+    BenchmarkData sutra_data;
+    if (!benchmark_data_init(&sutra_data, case_type, min, max))
+    {
+        printf("%s: memory allocation failed\n", name);
+        return;
+    }
+
+    BenchmarkResult standard = run_benchmark(name, "Standard", benchmark_standard_multiply, count, &sutra_data);
+    print_benchmark_result(&standard);
+
+    BenchmarkResult sutra = run_benchmark(name, "Sutra", sutra_func, count, &sutra_data);
+    print_benchmark_result(&sutra);
+
+    BenchmarkResult vedic = run_benchmark(name, "Vedic", vedic_func, count, &sutra_data);
+    print_benchmark_result(&vedic);
+
+    BenchmarkResult dynamic = run_benchmark(name, "Dynamic", benchmark_dynamic_multiply, count, &sutra_data);
+    print_benchmark_result(&dynamic);
+
+    BenchmarkResult optimized = run_benchmark(name, "Optimized", benchmark_optimized_multiply, count, &sutra_data);
+    print_benchmark_result(&optimized);
+
+    printf("\n");
+    print_benchmark_comparison(&standard, &sutra);
+    print_benchmark_comparison(&standard, &vedic);
+
+    benchmark_data_free(&sutra_data);
+}
+
 /**
  * Run a standard set of benchmarks on all implementations
  */
 void run_all_benchmarks(size_t count)
 {
-    // Seed the random number generator
-    srand(time(NULL));
+    // Fixed seed: identical operand pools on every run
+    srand(BENCH_SEED);
+
+    // Build the optimization tables once, outside any timed region
+    vedic_optimized_init();
 
-    printf("\n=== Vedic Mathematics Library Benchmarks ===\n\n");
+    const BenchHarnessConfig *config = bench_harness_get_config();
+    printf("\n=== Vedic Mathematics Library Benchmarks ===\n");
+    printf("Harness: %zu repetitions, %.1f ms target per repetition, pinned to CPU %d\n\n",
+           config->repetitions, config->target_time_sec * 1000.0, bench_harness_pinned_cpu());
 
     // Benchmark data for random integers
     BenchmarkData random_data;
-    random_data.case_type = CASE_RANDOM;
-    random_data.data.random.range_min = 1;
-    random_data.data.random.range_max = 1000;
+    if (!benchmark_data_init(&random_data, CASE_RANDOM, 1, 1000))
+    {
+        printf("Memory allocation failed\n");
+        vedic_optimized_cleanup();
+        return;
+    }
 
     // General Multiplication Benchmarks
     printf("=== General Multiplication Benchmarks ===\n");
@@ -957,82 +882,50 @@ void run_all_benchmarks(size_t count)
     printf("\n");
     print_benchmark_comparison(&std_batch, &opt_batch);
 
+    benchmark_data_free(&random_data);
+
     // Specific Sutra Benchmarks
     printf("=== Specific Sutra Benchmarks ===\n");
 
-    // Data for Ekadhikena Purvena (numbers ending in 5)
-    BenchmarkData ekadhikena_data;
-    ekadhikena_data.case_type = CASE_EKADHIKENA;
-    ekadhikena_data.data.random.range_min = 5;
-    ekadhikena_data.data.random.range_max = 1000;
-
-    BenchmarkResult ekadhikena = run_benchmark(
-        "Ekadhikena Purvena",
-        "All Implementations",
-        benchmark_ekadhikena_purvena,
-        count / 4, // Reduce count since we're testing all implementations at once
-        &ekadhikena_data);
-    print_benchmark_result(&ekadhikena);
-
-    // Data for Nikhilam (numbers near a base)
-    BenchmarkData nikhilam_data;
-    nikhilam_data.case_type = CASE_NIKHILAM;
-    nikhilam_data.data.random.range_min = 90;
-    nikhilam_data.data.random.range_max = 110;
-
-    BenchmarkResult nikhilam = run_benchmark(
-        "Nikhilam",
-        "All Implementations",
-        benchmark_nikhilam_mul,
-        count / 4, // Reduce count since we're testing all implementations at once
-        &nikhilam_data);
-    print_benchmark_result(&nikhilam);
-
-    // Data for Antyayordasake (numbers with last digits summing to 10)
-    BenchmarkData antyayordasake_data;
-    antyayordasake_data.case_type = CASE_ANTYAYORDASAKE;
-    antyayordasake_data.data.random.range_min = 10;
-    antyayordasake_data.data.random.range_max = 99;
-
-    BenchmarkResult antyayordasake = run_benchmark(
-        "Antyayordasake",
-        "All Implementations",
-        benchmark_antyayordasake,
-        count / 4, // Reduce count since we're testing all implementations at once
-        &antyayordasake_data);
-    print_benchmark_result(&antyayordasake);
+    // Ekadhikena Purvena (numbers ending in 5), squared
+    run_sutra_benchmarks("Ekadhikena Purvena", CASE_EKADHIKENA, 5, 1000,
+                         benchmark_ekadhikena_purvena, benchmark_vedic_square, count);
+
+    // Nikhilam (numbers near a base)
+    run_sutra_benchmarks("Nikhilam", CASE_NIKHILAM, 90, 110,
+                         benchmark_nikhilam_mul, benchmark_vedic_multiply, count);
+
+    // Antyayordasake (numbers with last digits summing to 10)
+    run_sutra_benchmarks("Antyayordasake", CASE_ANTYAYORDASAKE, 10, 99,
+                         benchmark_antyayordasake, benchmark_vedic_multiply, count);
 
     // Expression Evaluation Benchmarks
     printf("=== Expression Evaluation Benchmarks ===\n");
 
-    // Create test data for expressions
-    BenchmarkData expression_data;
-    expression_data.case_type = CASE_EXPRESSIONS;
-    expression_data.data.expressions.count = 10;
-    expression_data.data.expressions.expressions = (char **)malloc(
-        expression_data.data.expressions.count * sizeof(char *));
+    // Initialize with some sample expressions
+    const char *sample_expressions[] = {
+        "42 + 17",
+        "100 - 25",
+        "12 * 34",
+        "100 / 4",
+        "25 * 25", // Ekadhikena Purvena case
+        "98 * 97", // Nikhilam case
+        "46 * 44", // Antyayordasake case
+        "10 % 3",
+        "2 ^ 10",
+        "102 * 32" // Our special test case
+    };
+    const size_t expression_count = sizeof(sample_expressions) / sizeof(sample_expressions[0]);
+    char *expressions[sizeof(sample_expressions) / sizeof(sample_expressions[0])];
 
-    if (expression_data.data.expressions.expressions)
+    for (size_t i = 0; i < expression_count; i++)
     {
-        // Initialize with some sample expressions
-        const char *sample_expressions[] = {
-            "42 + 17",
-            "100 - 25",
-            "12 * 34",
-            "100 / 4",
-            "25 * 25", // Ekadhikena Purvena case
-            "98 * 97", // Nikhilam case
-            "46 * 44", // Antyayordasake case
-            "10 % 3",
-            "2 ^ 10",
-            "102 * 32" // Our special test case
-        };
-
-        for (size_t i = 0; i < expression_data.data.expressions.count; i++)
-        {
-            expression_data.data.expressions.expressions[i] = vedicmath_strdup(sample_expressions[i]);
-        }
+        expressions[i] = vedicmath_strdup(sample_expressions[i]);
+    }
 
+    BenchmarkData expression_data;
+    if (benchmark_data_init_expressions(&expression_data, expressions, expression_count))
+    {
         BenchmarkResult std_eval = run_benchmark(
             "Expression Evaluation",
             "Standard",
@@ -1063,12 +956,13 @@ void run_all_benchmarks(size_t count)
         print_benchmark_comparison(&dynamic_eval, &optimized_eval);
         print_benchmark_comparison(&std_eval, &optimized_eval);
 
-        // Clean up expression data
-        for (size_t i = 0; i < expression_data.data.expressions.count; i++)
-        {
-            free(expression_data.data.expressions.expressions[i]);
-        }
-        free(expression_data.data.expressions.expressions);
+        benchmark_data_free(&expression_data);
+    }
+
+    // Clean up expression data
+    for (size_t i = 0; i < expression_count; i++)
+    {
+        free(expressions[i]);
     }
 
     printf("\n=== Benchmark Summary ===\n");
@@ -1076,6 +970,8 @@ void run_all_benchmarks(size_t count)
     printf("Optimized implementation generally shows significant speedup over standard methods,\n");
     printf("especially for specific Vedic patterns (numbers ending in 5, near a base, etc.)\n");
 
-    run_pattern_specific_benchmarks(count); // Run specific pattern benchmarks with reduced count
+    run_pattern_specific_benchmarks(count);
     printf("These benchmarks demonstrate the power of Vedic mathematics for specific patterns.\n");
-}
\ No newline at end of file
+
+    vedic_optimized_cleanup();
+}
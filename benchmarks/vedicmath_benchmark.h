@@ -10,6 +10,9 @@
  
  #include <stddef.h>
  #include <time.h>
+ #include "vedicmath_bench_harness.h"
+ #include "vedicmath_perf_counters.h"
+ #include "vedicmath_bench_json.h"
  
  /**
   * Benchmark result structure
@@ -17,19 +20,56 @@
  typedef struct {
      const char* name;            // Name of the benchmark
      const char* implementation;  // Implementation being benchmarked
-     double elapsed_time;         // Time in seconds
-     double operations_per_sec;   // Operations per second
-     size_t iterations;           // Number of iterations performed
+     double elapsed_time;         // Median time of one repetition in seconds
+     double operations_per_sec;   // Operations per second (from the median)
+     size_t iterations;           // Calibrated iterations per repetition
      int success;                 // 1 if benchmark succeeded, 0 if failed
+ 
+     // Per-repetition statistics (nanoseconds per operation)
+     size_t repetitions;                          // Number of timed repetitions
+     double samples_ns[BENCH_MAX_REPETITIONS];    // ns/op of each repetition
+     double min_ns;                               // Fastest repetition
+     double median_ns;                            // Median repetition
+     double mad_ns;                               // Median absolute deviation
+     double mean_ns;                              // Mean repetition
+     int cpu;                                     // CPU the run was pinned to (-1 if none)
+ 
+     // Hardware counters over all timed repetitions (perf.available == false
+     // when perf_event_open is not usable)
+     BenchPerfSummary perf;
+ 
+     // Library allocations per operation, from one extra untimed repetition
+     // (only when BenchHarnessConfig.track_allocations is set)
+     int alloc_tracked;
+     double allocs_per_op;                        // malloc/calloc/strdup/realloc calls
+     double alloc_bytes_per_op;                   // Bytes requested
+
+     // RAPL energy over all timed repetitions (energy_measured == 0 when the
+     // counters are missing or not readable). Package energy includes
+     // everything else the socket was doing, idle power among it.
+     int energy_measured;
+     double package_joules_per_op;
+     double core_joules_per_op;                   // 0 if there is no core domain
+     double package_watts;                        // Average package power
  } BenchmarkResult;
  
  /**
   * Run a benchmark function and measure its performance
   * 
+  * The iteration count is calibrated so that one call of func takes about
+  * the harness target time, then func is timed for the configured number of
+  * repetitions. func must only perform the operation under test; operands
+  * have to be generated beforehand and stored in data. The samples are
+  * also appended to the JSON sink when one is open (see bench_json_begin).
+  * With allocation tracking configured, func runs once more afterwards with
+  * vedic_alloc tracking enabled, so the counting never lands in the timed
+  * repetitions. Energy is read from the RAPL counters around the timed
+  * repetitions when they are readable.
+  * 
   * @param name Benchmark name
   * @param implementation Implementation name
   * @param func Function to benchmark
-  * @param iterations Number of iterations to run
+  * @param iterations Minimum iterations per repetition (calibration seed)
   * @param data User data to pass to the function
   * @return Benchmark result
   */
@@ -41,6 +81,17 @@
      void* data
  );
  
+ /**
+  * Whether run_benchmark can measure energy
+  *
+  * Discovers the RAPL counters on the first call and prints once whether
+  * they are usable; call it before printing tables to keep that line out
+  * of them.
+  *
+  * @return 1 if energy per operation will be reported, 0 otherwise
+  */
+ int benchmark_energy_available(void);
+
  /**
   * Print a benchmark result
   * 
@@ -59,10 +110,17 @@
  /**
   * Run a standard set of benchmarks on all implementations
   * 
-  * @param count Number of iterations for each benchmark
+  * @param count Minimum iterations per repetition for each benchmark
   */
  void run_all_benchmarks(size_t count);
  
+ /**
+  * Run the pattern-specific Standard vs Vedic comparisons
+  * 
+  * @param count Minimum iterations per repetition for each benchmark
+  */
+ void run_pattern_specific_benchmarks(size_t count);
+ 
  /**
   * Benchmark specific operations
   */
@@ -92,9 +150,17 @@
  int benchmark_batch_multiply_standard(size_t iterations, void* data);
  int benchmark_batch_multiply_optimized(size_t iterations, void* data);
  
- // Benchmark special cases
+ // Benchmark special cases (direct sutra calls on pattern-matched pools)
  int benchmark_ekadhikena_purvena(size_t iterations, void* data);
  int benchmark_nikhilam_mul(size_t iterations, void* data);
  int benchmark_antyayordasake(size_t iterations, void* data);
  
+ // Benchmark Vedic squaring dispatcher
+ int benchmark_vedic_square(size_t iterations, void* data);
+ 
+ // Pattern-specific Standard vs Vedic comparisons (data is unused)
+ int benchmark_ekadhikena_specific(size_t iterations, void* data);
+ int benchmark_nikhilam_specific(size_t iterations, void* data);
+ int benchmark_antyayordasake_specific(size_t iterations, void* data);
+ 
  #endif /* VEDICMATH_BENCHMARK_H */
\ No newline at end of file
@@ -0,0 +1,891 @@
+/**
+ * vedicmath_dispatch_benchmark.c - Branch-predictability benchmark for the dispatchers
+ *
+ * The pattern pools of the other benchmarks hold one pattern each, so the
+ * dispatcher takes the same branches on every call and the branch
+ * predictor hides the cost of pattern detection. This benchmark builds one
+ * operand set with a configurable mix of multiplication methods and feeds
+ * it to the dispatchers in several orders of increasing entropy:
+ *
+ *   sorted      all pairs of one method, then the next method
+ *   round-robin methods interleaved in a fixed cycle
+ *   bursty      runs of one method with random (geometric) lengths
+ *   shuffled    uniformly random order
+ *   dataset     file order of a dataset exported by dataset_generator
+ *               (--dataset FILE)
+ *
+ * The synthetic orders are permutations of the same pairs, so the work of
+ * the sutra kernels is identical and any difference between them is caused
+ * by the order alone. For every order it measures
+ *
+ *   Kernel only  the sutra kernels, called directly on pairs grouped by
+ *                method (the method is known, nothing is detected)
+ *   Per-element  vedic_multiply on every pair
+ *   Batch        vedic_multiply_batch, which classifies a chunk first and
+ *                then runs one loop per method
+ *
+ * and reports ns/op, dispatch overhead (ns/op above the kernel-only time),
+ * branch misses per operation and miss rate (with perf counters), and the
+ * effective speedup of the batch path over per-element dispatch.
+ *
+ * Usage: vedicmath_dispatch_benchmark [min_iterations] [--mix D,E,A,N,U]
+ *                                     [--burst N] [--dataset FILE]
+ *                                     [--reps N] [--target-ms MS]
+ *                                     [--cpu N|auto|none] [--json FILE]
+ *                                     [--alloc]
+ */
+#include "vedicmath_benchmark.h"
+#include "../include/vedicmath.h"
+#include "../include/vedicmath_types.h"
+#include "../include/vedicmath_alloc.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DISPATCH_SEED 20240501u
+
+// Pairs per operand set. Much larger than BENCH_POOL_SIZE: a shuffled
+// sequence that repeats every few thousand calls can partly be learned by
+// modern history-based predictors, which would make shuffled look better
+// than it is.
+#define DISPATCH_POOL_SIZE 65536
+#define DISPATCH_POOL_MASK (DISPATCH_POOL_SIZE - 1)
+
+// Pairs per vedic_multiply_batch call (must divide DISPATCH_POOL_SIZE)
+#define DISPATCH_BATCH_SIZE 1024
+
+#define DISPATCH_DEFAULT_BURST 16
+#define DISPATCH_MAX_ATTEMPTS 1000
+#define DISPATCH_LINE_MAX 1024
+
+typedef enum
+{
+    ORDER_SORTED,
+    ORDER_ROUND_ROBIN,
+    ORDER_BURSTY,
+    ORDER_SHUFFLED,
+    ORDER_DATASET,
+    ORDER_COUNT
+} DispatchOrder;
+
+static const char *order_names[ORDER_COUNT] = {"sorted", "round-robin", "bursty", "shuffled", "dataset"};
+
+/**
+ * One operand set in one order
+ */
+typedef struct
+{
+    long a[DISPATCH_POOL_SIZE];
+    long b[DISPATCH_POOL_SIZE];
+    long results[DISPATCH_BATCH_SIZE];
+
+    // Magnitudes regrouped by method for the kernel-only reference
+    long kernel_a[DISPATCH_POOL_SIZE];
+    long kernel_b[DISPATCH_POOL_SIZE];
+    size_t group_start[VEDIC_MUL_METHOD_COUNT];
+    size_t group_size[VEDIC_MUL_METHOD_COUNT];
+} DispatchPool;
+
+/**
+ * Entropy of the method sequence, in bits per pair
+ */
+typedef struct
+{
+    double mix;            // H(method): how varied the mix is
+    double transition;     // H(method | previous method): how unpredictable the order is
+    double switch_rate;    // Fraction of pairs whose method differs from the previous one
+} DispatchEntropy;
+
+// ============================================================================
+// OPERAND GENERATION
+// ============================================================================
+
+static unsigned next_random(unsigned *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 8) & 0xFFFFFFu;
+}
+
+/**
+ * Candidate pair for a method; the caller checks it with
+ * vedic_multiply_method and retries, so the generators only need to hit the
+ * method most of the time
+ */
+static void propose_pair(VedicMultiplyMethod method, unsigned *state, long *a, long *b)
+{
+    switch (method)
+    {
+    case VEDIC_MUL_EKADHIKENA:
+        *a = *b = (long)(next_random(state) % 20 + 1) * 10 + 5;
+        break;
+    case VEDIC_MUL_ANTYAYORDASAKE:
+    {
+        long prefix = (long)(next_random(state) % 9) + 1;
+        long last = (long)(next_random(state) % 9) + 1;
+        *a = prefix * 10 + last;
+        *b = prefix * 10 + (10 - last);
+        break;
+    }
+    case VEDIC_MUL_NIKHILAM:
+    {
+        long base = next_random(state) % 2 ? 100 : 1000;
+        *a = base - 1 - (long)(next_random(state) % (base / 20));
+        *b = base - 1 - (long)(next_random(state) % (base / 20));
+        break;
+    }
+    case VEDIC_MUL_URDHVA:
+        *a = (long)(next_random(state) % 9000) + 1000;
+        *b = (long)(next_random(state) % 900) + 100;
+        break;
+    default:
+        *a = (long)(next_random(state) % 98) + 2;
+        *b = (long)(next_random(state) % 98) + 2;
+        break;
+    }
+}
+
+static int generate_pair(VedicMultiplyMethod method, unsigned *state, long *a, long *b)
+{
+    for (int attempt = 0; attempt < DISPATCH_MAX_ATTEMPTS; attempt++)
+    {
+        propose_pair(method, state, a, b);
+        if (vedic_multiply_method(*a, *b) == method)
+            return 1;
+    }
+    return 0;
+}
+
+/**
+ * Generate the operand set in sorted order and record the size of each
+ * method's group
+ *
+ * @return 0 on success, -1 if a method could not be generated
+ */
+static int generate_sorted(DispatchPool *pool, const double *weights, size_t *counts)
+{
+    unsigned state = DISPATCH_SEED;
+    double total = 0.0;
+    for (int m = 0; m < VEDIC_MUL_METHOD_COUNT; m++)
+        total += weights[m];
+
+    // Split the pool by weight, then hand out the rounding remainder one pair
+    // at a time
+    size_t assigned = 0;
+    for (int m = 0; m < VEDIC_MUL_METHOD_COUNT; m++)
+    {
+        counts[m] = (size_t)((double)DISPATCH_POOL_SIZE * weights[m] / total);
+        assigned += counts[m];
+    }
+    for (int m = 0; assigned < DISPATCH_POOL_SIZE; m = (m + 1) % VEDIC_MUL_METHOD_COUNT)
+    {
+        if (weights[m] > 0.0)
+        {
+            counts[m]++;
+            assigned++;
+        }
+    }
+
+    size_t i = 0;
+    for (int m = 0; m < VEDIC_MUL_METHOD_COUNT; m++)
+    {
+        for (size_t k = 0; k < counts[m]; k++, i++)
+        {
+            if (!generate_pair((VedicMultiplyMethod)m, &state, &pool->a[i], &pool->b[i]))
+            {
+                printf("Error: could not generate operands for %s\n",
+                       vedic_multiply_method_name((VedicMultiplyMethod)m));
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Reorder the sorted operand set
+ *
+ * @param sorted Operand set in sorted order
+ * @param counts Pairs per method in sorted
+ * @param order ORDER_SORTED, ORDER_ROUND_ROBIN, ORDER_BURSTY or ORDER_SHUFFLED
+ * @param burst Mean run length for ORDER_BURSTY
+ * @param pool Output operand set
+ */
+static void reorder(const DispatchPool *sorted, const size_t *counts, DispatchOrder order,
+                    size_t burst, DispatchPool *pool)
+{
+    size_t start[VEDIC_MUL_METHOD_COUNT];
+    size_t taken[VEDIC_MUL_METHOD_COUNT];
+    size_t offset = 0;
+    unsigned state = DISPATCH_SEED + (unsigned)order;
+
+    for (int m = 0; m < VEDIC_MUL_METHOD_COUNT; m++)
+    {
+        start[m] = offset;
+        taken[m] = 0;
+        offset += counts[m];
+    }
+
+    switch (order)
+    {
+    case ORDER_ROUND_ROBIN:
+    case ORDER_BURSTY:
+    {
+        // Deal from the method groups in turn; bursty takes a random run
+        // from each group instead of a single pair
+        int m = 0;
+        for (size_t i = 0; i < DISPATCH_POOL_SIZE;)
+        {
+            size_t left = counts[m] - taken[m];
+            size_t run = 1;
+            if (order == ORDER_BURSTY)
+            {
+                // Geometric run length with the requested mean
+                double u = ((double)next_random(&state) + 1.0) / 16777217.0;
+                run = (size_t)(-log(u) * (double)burst) + 1;
+            }
+            if (run > left)
+                run = left;
+            for (size_t k = 0; k < run; k++, i++)
+            {
+                size_t src = start[m] + taken[m]++;
+                pool->a[i] = sorted->a[src];
+                pool->b[i] = sorted->b[src];
+            }
+
+            // Bursty picks the next group at random so runs do not cycle
+            int next = order == ORDER_BURSTY ? (int)(next_random(&state) % VEDIC_MUL_METHOD_COUNT) : m + 1;
+            for (int step = 0; step < VEDIC_MUL_METHOD_COUNT; step++)
+            {
+                m = (next + step) % VEDIC_MUL_METHOD_COUNT;
+                if (taken[m] < counts[m])
+                    break;
+            }
+        }
+        break;
+    }
+
+    case ORDER_SHUFFLED:
+        memcpy(pool->a, sorted->a, sizeof(pool->a));
+        memcpy(pool->b, sorted->b, sizeof(pool->b));
+        for (size_t i = DISPATCH_POOL_SIZE - 1; i > 0; i--)
+        {
+            size_t j = (((size_t)next_random(&state) << 8) | (next_random(&state) & 0xFF)) % (i + 1);
+            long ta = pool->a[i], tb = pool->b[i];
+            pool->a[i] = pool->a[j];
+            pool->b[i] = pool->b[j];
+            pool->a[j] = ta;
+            pool->b[j] = tb;
+        }
+        break;
+
+    default:
+        memcpy(pool->a, sorted->a, sizeof(pool->a));
+        memcpy(pool->b, sorted->b, sizeof(pool->b));
+        break;
+    }
+}
+
+/**
+ * Load multiplications from a dataset CSV in file order
+ *
+ * Accepts the format written by vedic_core_export_dataset (dataset_generator),
+ * where only multiplication rows are used, or plain "a,b" rows. Shorter
+ * datasets are repeated to fill the pool.
+ *
+ * @return Number of rows read (0 if the file is missing or has no usable rows)
+ */
+static size_t load_dataset(const char *path, DispatchPool *pool)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        printf("Warning: cannot open dataset '%s'\n", path);
+        return 0;
+    }
+
+    char line[DISPATCH_LINE_MAX];
+    int core_format = 0;
+    size_t rows = 0;
+
+    while (rows < DISPATCH_POOL_SIZE && fgets(line, sizeof(line), file))
+    {
+        if (strncmp(line, "timestamp,", 10) == 0)
+        {
+            core_format = 1;
+            continue;
+        }
+
+        double fields[6];
+        int field_count = 0;
+        char *cursor = line;
+        while (field_count < 6)
+        {
+            char *end;
+            fields[field_count] = strtod(cursor, &end);
+            if (end == cursor)
+                break;
+            field_count++;
+            if (*end != ',')
+                break;
+            cursor = end + 1;
+        }
+
+        if (core_format)
+        {
+            // timestamp,operation_type,a_type,a_value,b_type,b_value,...
+            if (field_count < 6 || (int)fields[1] != VEDIC_OP_MULTIPLY)
+                continue;
+            pool->a[rows] = (long)fields[3];
+            pool->b[rows] = (long)fields[5];
+        }
+        else
+        {
+            if (field_count < 2)
+                continue;
+            pool->a[rows] = (long)fields[0];
+            pool->b[rows] = (long)fields[1];
+        }
+        rows++;
+    }
+    fclose(file);
+
+    for (size_t i = rows; rows > 0 && i < DISPATCH_POOL_SIZE; i++)
+    {
+        pool->a[i] = pool->a[i % rows];
+        pool->b[i] = pool->b[i % rows];
+    }
+    return rows;
+}
+
+/**
+ * Group the pool's magnitudes by method for the kernel-only reference and
+ * count the methods it contains
+ */
+static void build_kernel_groups(DispatchPool *pool, size_t *counts)
+{
+    VedicMultiplyMethod *methods = malloc(DISPATCH_POOL_SIZE * sizeof(VedicMultiplyMethod));
+    size_t fill[VEDIC_MUL_METHOD_COUNT];
+    size_t offset = 0;
+
+    for (int m = 0; m < VEDIC_MUL_METHOD_COUNT; m++)
+        counts[m] = 0;
+    for (size_t i = 0; i < DISPATCH_POOL_SIZE; i++)
+    {
+        VedicMultiplyMethod m = vedic_multiply_method(pool->a[i], pool->b[i]);
+        if (methods)
+            methods[i] = m;
+        counts[m]++;
+    }
+    for (int m = 0; m < VEDIC_MUL_METHOD_COUNT; m++)
+    {
+        pool->group_start[m] = offset;
+        pool->group_size[m] = counts[m];
+        fill[m] = offset;
+        offset += counts[m];
+    }
+    for (size_t i = 0; i < DISPATCH_POOL_SIZE; i++)
+    {
+        VedicMultiplyMethod m = methods ? methods[i] : vedic_multiply_method(pool->a[i], pool->b[i]);
+        size_t dst = fill[m]++;
+        pool->kernel_a[dst] = pool->a[i] < 0 ? -pool->a[i] : pool->a[i];
+        pool->kernel_b[dst] = pool->b[i] < 0 ? -pool->b[i] : pool->b[i];
+    }
+    free(methods);
+}
+
+static DispatchEntropy measure_entropy(const DispatchPool *pool)
+{
+    static size_t transitions[VEDIC_MUL_METHOD_COUNT][VEDIC_MUL_METHOD_COUNT];
+    size_t counts[VEDIC_MUL_METHOD_COUNT] = {0};
+    size_t switches = 0;
+    DispatchEntropy entropy = {0.0, 0.0, 0.0};
+
+    memset(transitions, 0, sizeof(transitions));
+
+    // The timed loops wrap around, so the last pair precedes the first
+    VedicMultiplyMethod previous = vedic_multiply_method(pool->a[DISPATCH_POOL_SIZE - 1],
+                                                         pool->b[DISPATCH_POOL_SIZE - 1]);
+    for (size_t i = 0; i < DISPATCH_POOL_SIZE; i++)
+    {
+        VedicMultiplyMethod m = vedic_multiply_method(pool->a[i], pool->b[i]);
+        transitions[previous][m]++;
+        counts[m]++;
+        switches += m != previous;
+        previous = m;
+    }
+
+    for (int from = 0; from < VEDIC_MUL_METHOD_COUNT; from++)
+    {
+        size_t row_total = 0;
+        for (int to = 0; to < VEDIC_MUL_METHOD_COUNT; to++)
+            row_total += transitions[from][to];
+        for (int to = 0; to < VEDIC_MUL_METHOD_COUNT; to++)
+        {
+            if (transitions[from][to] == 0)
+                continue;
+            double joint = (double)transitions[from][to] / DISPATCH_POOL_SIZE;
+            double conditional = (double)transitions[from][to] / (double)row_total;
+            entropy.transition -= joint * log2(conditional);
+        }
+    }
+    for (int m = 0; m < VEDIC_MUL_METHOD_COUNT; m++)
+    {
+        if (counts[m] > 0)
+        {
+            double p = (double)counts[m] / DISPATCH_POOL_SIZE;
+            entropy.mix -= p * log2(p);
+        }
+    }
+    entropy.switch_rate = (double)switches / DISPATCH_POOL_SIZE;
+    return entropy;
+}
+
+// ============================================================================
+// TIMED LOOPS
+// ============================================================================
+
+static int run_standard(size_t iterations, void *data)
+{
+    const DispatchPool *pool = (const DispatchPool *)data;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        size_t j = i & DISPATCH_POOL_MASK;
+        long result = pool->a[j] * pool->b[j];
+        BENCH_DO_NOT_OPTIMIZE(result);
+    }
+    return 1;
+}
+
+static int run_kernel_only(size_t iterations, void *data)
+{
+    const DispatchPool *pool = (const DispatchPool *)data;
+    size_t done = 0;
+
+    // One straight loop per method, cycling through the groups
+    while (done < iterations)
+    {
+        for (int m = 0; m < VEDIC_MUL_METHOD_COUNT && done < iterations; m++)
+        {
+            const long *ka = pool->kernel_a + pool->group_start[m];
+            const long *kb = pool->kernel_b + pool->group_start[m];
+            size_t n = pool->group_size[m];
+            if (n > iterations - done)
+                n = iterations - done;
+
+            switch (m)
+            {
+            case VEDIC_MUL_EKADHIKENA:
+                for (size_t i = 0; i < n; i++)
+                {
+                    long result = ekadhikena_purvena(ka[i]);
+                    BENCH_DO_NOT_OPTIMIZE(result);
+                }
+                break;
+            case VEDIC_MUL_ANTYAYORDASAKE:
+                for (size_t i = 0; i < n; i++)
+                {
+                    long result = antya_dasake_mul((int)ka[i], (int)kb[i]);
+                    BENCH_DO_NOT_OPTIMIZE(result);
+                }
+                break;
+            case VEDIC_MUL_NIKHILAM:
+                for (size_t i = 0; i < n; i++)
+                {
+                    long result = nikhilam_mul(ka[i], kb[i]);
+                    BENCH_DO_NOT_OPTIMIZE(result);
+                }
+                break;
+            case VEDIC_MUL_URDHVA:
+                for (size_t i = 0; i < n; i++)
+                {
+                    long result = urdhva_mult(ka[i], kb[i]);
+                    BENCH_DO_NOT_OPTIMIZE(result);
+                }
+                break;
+            default:
+                for (size_t i = 0; i < n; i++)
+                {
+                    long result = ka[i] * kb[i];
+                    BENCH_DO_NOT_OPTIMIZE(result);
+                }
+                break;
+            }
+            done += n;
+        }
+    }
+    return 1;
+}
+
+static int run_per_element(size_t iterations, void *data)
+{
+    const DispatchPool *pool = (const DispatchPool *)data;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        size_t j = i & DISPATCH_POOL_MASK;
+        long result = vedic_multiply(pool->a[j], pool->b[j]);
+        BENCH_DO_NOT_OPTIMIZE(result);
+    }
+    return 1;
+}
+
+static int run_batch(size_t iterations, void *data)
+{
+    DispatchPool *pool = (DispatchPool *)data;
+    for (size_t done = 0; done < iterations; done += DISPATCH_BATCH_SIZE)
+    {
+        size_t j = done & DISPATCH_POOL_MASK;
+        size_t n = iterations - done < DISPATCH_BATCH_SIZE ? iterations - done : DISPATCH_BATCH_SIZE;
+        vedic_multiply_batch(pool->results, &pool->a[j], &pool->b[j], n);
+        BENCH_CLOBBER_MEMORY();
+    }
+    return 1;
+}
+
+/**
+ * Check that both dispatch paths produce a * b for every pair of the pool
+ */
+static int verify_pool(DispatchPool *pool)
+{
+    for (size_t base = 0; base < DISPATCH_POOL_SIZE; base += DISPATCH_BATCH_SIZE)
+    {
+        vedic_multiply_batch(pool->results, &pool->a[base], &pool->b[base], DISPATCH_BATCH_SIZE);
+        for (size_t i = 0; i < DISPATCH_BATCH_SIZE; i++)
+        {
+            long expected = pool->a[base + i] * pool->b[base + i];
+            if (pool->results[i] != expected || vedic_multiply(pool->a[base + i], pool->b[base + i]) != expected)
+            {
+                printf("Error: %ld x %ld gave %ld (batch), expected %ld\n",
+                       pool->a[base + i], pool->b[base + i], pool->results[i], expected);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// ============================================================================
+// REPORTING
+// ============================================================================
+
+/**
+ * Figures of one order, kept for the summary table
+ */
+typedef struct
+{
+    int measured;
+    DispatchEntropy entropy;
+    BenchmarkResult standard;
+    BenchmarkResult kernel;
+    BenchmarkResult per_element;
+    BenchmarkResult batch;
+} DispatchRow;
+
+static void print_row_details(const DispatchRow *row)
+{
+    double per_element_overhead = row->per_element.median_ns - row->kernel.median_ns;
+    double batch_overhead = row->batch.median_ns - row->kernel.median_ns;
+    double speedup = row->batch.median_ns > 0.0 ? row->per_element.median_ns / row->batch.median_ns : 0.0;
+
+    printf("  Dispatch overhead: per-element %+.2f ns/op, batch %+.2f ns/op\n",
+           per_element_overhead, batch_overhead);
+    if (row->per_element.perf.available && row->batch.perf.available)
+    {
+        printf("  Branch misses: per-element %.4f/op (%.2f%%), batch %.4f/op (%.2f%%), kernel only %.4f/op\n",
+               row->per_element.perf.branch_misses_per_op, row->per_element.perf.branch_miss_rate * 100.0,
+               row->batch.perf.branch_misses_per_op, row->batch.perf.branch_miss_rate * 100.0,
+               row->kernel.perf.branch_misses_per_op);
+    }
+    printf("  Effective speedup of batch over per-element: %.2fx\n\n", speedup);
+}
+
+static void print_summary(const DispatchRow *rows)
+{
+    const DispatchRow *sorted = &rows[ORDER_SORTED];
+
+    printf("\n=== Summary ===\n");
+    printf("%-12s %8s %8s %10s %10s %10s %10s %12s %13s %9s\n",
+           "Order", "H(mix)", "H(next)", "Kernel", "Per-elem", "Batch", "Elem ovh", "Elem br-miss",
+           "Batch br-miss", "Speedup");
+    for (int o = 0; o < ORDER_COUNT; o++)
+    {
+        const DispatchRow *row = &rows[o];
+        if (!row->measured)
+            continue;
+
+        char element_misses[16] = "n/a";
+        char batch_misses[16] = "n/a";
+        if (row->per_element.perf.available)
+            snprintf(element_misses, sizeof(element_misses), "%.4f", row->per_element.perf.branch_misses_per_op);
+        if (row->batch.perf.available)
+            snprintf(batch_misses, sizeof(batch_misses), "%.4f", row->batch.perf.branch_misses_per_op);
+
+        printf("%-12s %8.2f %8.2f %10.2f %10.2f %10.2f %+10.2f %12s %13s %8.2fx\n",
+               order_names[o], row->entropy.mix, row->entropy.transition,
+               row->kernel.median_ns, row->per_element.median_ns, row->batch.median_ns,
+               row->per_element.median_ns - row->kernel.median_ns,
+               element_misses, batch_misses,
+               row->batch.median_ns > 0.0 ? row->per_element.median_ns / row->batch.median_ns : 0.0);
+    }
+    printf("\nTimes in ns/op. H(mix) = entropy of the method mix, H(next) = entropy of a\n");
+    printf("method given the previous one (bits/pair); Elem ovh = per-element - kernel.\n");
+
+    if (!sorted->measured || sorted->per_element.median_ns <= 0.0)
+        return;
+    printf("\nCost of unpredictability relative to sorted input:\n");
+    for (int o = ORDER_SORTED + 1; o < ORDER_COUNT; o++)
+    {
+        const DispatchRow *row = &rows[o];
+        if (!row->measured || o == ORDER_DATASET)
+            continue;
+        printf("  %-12s per-element %+.2f ns/op (%.2fx), batch %+.2f ns/op (%.2fx)\n",
+               order_names[o],
+               row->per_element.median_ns - sorted->per_element.median_ns,
+               row->per_element.median_ns / sorted->per_element.median_ns,
+               row->batch.median_ns - sorted->batch.median_ns,
+               sorted->batch.median_ns > 0.0 ? row->batch.median_ns / sorted->batch.median_ns : 0.0);
+    }
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void print_usage(const char *program)
+{
+    printf("Usage: %s [min_iterations] [--mix D,E,A,N,U] [--burst N] [--dataset FILE]\n"
+           "          [--reps N] [--target-ms MS] [--cpu N|auto|none] [--json FILE] [--alloc]\n",
+           program);
+    printf("  --mix  relative weights of Direct, Ekadhikena, Antyayordasake, Nikhilam and\n"
+           "         Urdhva pairs (default 1,1,1,1,1)\n");
+}
+
+static int parse_mix(const char *value, double *weights)
+{
+    const char *cursor = value;
+    double total = 0.0;
+    for (int m = 0; m < VEDIC_MUL_METHOD_COUNT; m++)
+    {
+        char *end;
+        weights[m] = strtod(cursor, &end);
+        if (end == cursor || weights[m] < 0.0)
+            return -1;
+        total += weights[m];
+        if (m < VEDIC_MUL_METHOD_COUNT - 1)
+        {
+            if (*end != ',')
+                return -1;
+            cursor = end + 1;
+        }
+        else if (*end != '\0')
+        {
+            return -1;
+        }
+    }
+    return total > 0.0 ? 0 : -1;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t iterations = 1000;
+    size_t burst = DISPATCH_DEFAULT_BURST;
+    const char *json_path = NULL;
+    const char *dataset_path = NULL;
+    double weights[VEDIC_MUL_METHOD_COUNT];
+
+    for (int m = 0; m < VEDIC_MUL_METHOD_COUNT; m++)
+        weights[m] = 1.0;
+
+    BenchHarnessConfig config;
+    bench_harness_default_config(&config);
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        char *endptr;
+
+        if (strcmp(arg, "--mix") == 0 && value)
+        {
+            if (parse_mix(value, weights) != 0)
+            {
+                printf("Invalid --mix '%s': expected %d non-negative weights\n", value, VEDIC_MUL_METHOD_COUNT);
+                return 1;
+            }
+            i++;
+        }
+        else if (strcmp(arg, "--burst") == 0 && value)
+        {
+            long run = strtol(value, &endptr, 10);
+            if (*endptr == '\0' && run > 0)
+                burst = (size_t)run;
+            i++;
+        }
+        else if (strcmp(arg, "--dataset") == 0 && value)
+        {
+            dataset_path = value;
+            i++;
+        }
+        else if (strcmp(arg, "--reps") == 0 && value)
+        {
+            long reps = strtol(value, &endptr, 10);
+            if (*endptr == '\0' && reps > 0)
+                config.repetitions = (size_t)reps;
+            i++;
+        }
+        else if (strcmp(arg, "--target-ms") == 0 && value)
+        {
+            double target_ms = strtod(value, &endptr);
+            if (*endptr == '\0' && target_ms > 0.0)
+                config.target_time_sec = target_ms / 1000.0;
+            i++;
+        }
+        else if (strcmp(arg, "--cpu") == 0 && value)
+        {
+            if (strcmp(value, "none") == 0)
+            {
+                config.cpu = BENCH_CPU_NONE;
+            }
+            else if (strcmp(value, "auto") == 0)
+            {
+                config.cpu = BENCH_CPU_AUTO;
+            }
+            else
+            {
+                long cpu = strtol(value, &endptr, 10);
+                if (*endptr == '\0' && cpu >= 0)
+                    config.cpu = (int)cpu;
+            }
+            i++;
+        }
+        else if (strcmp(arg, "--json") == 0 && value)
+        {
+            json_path = value;
+            i++;
+        }
+        else if (strcmp(arg, "--alloc") == 0)
+        {
+            config.track_allocations = 1;
+        }
+        else if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            long count = strtol(arg, &endptr, 10);
+            if (*endptr == '\0' && count > 0)
+            {
+                iterations = (size_t)count;
+            }
+            else
+            {
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+    }
+
+    bench_harness_set_config(&config);
+    if (config.cpu != BENCH_CPU_NONE && bench_harness_pin() < 0)
+        printf("Warning: could not pin to a CPU, results may be noisier\n");
+
+    if (json_path && bench_json_begin(json_path, argv[0]) != 0)
+    {
+        printf("Error: cannot write JSON results to '%s'\n", json_path);
+        return 1;
+    }
+
+    DispatchPool *sorted = malloc(sizeof(DispatchPool));
+    DispatchPool *pool = malloc(sizeof(DispatchPool));
+    static DispatchRow rows[ORDER_COUNT];
+    size_t counts[VEDIC_MUL_METHOD_COUNT];
+
+    if (!sorted || !pool)
+    {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    if (generate_sorted(sorted, weights, counts) != 0)
+        return 1;
+
+    printf("Vedic Mathematics Library Dispatch Predictability Benchmark\n");
+    printf("===========================================================\n");
+    printf("%d pairs per order, batches of %d, mean burst %zu. Mix:", DISPATCH_POOL_SIZE,
+           DISPATCH_BATCH_SIZE, burst);
+    for (int m = 0; m < VEDIC_MUL_METHOD_COUNT; m++)
+        printf(" %s %zu%s", vedic_multiply_method_name((VedicMultiplyMethod)m), counts[m],
+               m < VEDIC_MUL_METHOD_COUNT - 1 ? "," : "\n");
+
+    int status = 0;
+    for (int o = 0; o < ORDER_COUNT; o++)
+    {
+        DispatchRow *row = &rows[o];
+        char name[64];
+
+        if (o == ORDER_DATASET)
+        {
+            if (!dataset_path)
+                continue;
+            size_t rows_read = load_dataset(dataset_path, pool);
+            if (rows_read == 0)
+            {
+                printf("\nSkipping dataset order: no multiplications in '%s'\n", dataset_path);
+                continue;
+            }
+            printf("\nDataset: %zu multiplications from %s\n", rows_read, dataset_path);
+        }
+        else
+        {
+            reorder(sorted, counts, (DispatchOrder)o, burst, pool);
+        }
+
+        size_t pool_counts[VEDIC_MUL_METHOD_COUNT];
+        build_kernel_groups(pool, pool_counts);
+        if (!verify_pool(pool))
+        {
+            status = 1;
+            continue;
+        }
+
+        row->entropy = measure_entropy(pool);
+        printf("\n=== Order: %s (H(mix) %.2f bits, H(next) %.2f bits, method switches %.1f%%) ===\n",
+               order_names[o], row->entropy.mix, row->entropy.transition, row->entropy.switch_rate * 100.0);
+
+        snprintf(name, sizeof(name), "Dispatch %s", order_names[o]);
+        row->standard = run_benchmark(name, "Standard", run_standard, iterations, pool);
+        print_benchmark_result(&row->standard);
+        row->kernel = run_benchmark(name, "Kernel only", run_kernel_only, iterations, pool);
+        print_benchmark_result(&row->kernel);
+        row->per_element = run_benchmark(name, "Per-element", run_per_element, iterations, pool);
+        print_benchmark_result(&row->per_element);
+        row->batch = run_benchmark(name, "Batch", run_batch, iterations, pool);
+        print_benchmark_result(&row->batch);
+
+        row->measured = 1;
+        print_row_details(row);
+    }
+
+    print_summary(rows);
+    if (config.track_allocations)
+    {
+        printf("\n");
+        vedic_alloc_print_report();
+    }
+
+    free(sorted);
+    free(pool);
+
+    if (json_path)
+    {
+        if (bench_json_end() != 0)
+        {
+            printf("Error: failed to write JSON results to '%s'\n", json_path);
+            return 1;
+        }
+        printf("JSON results written to %s\n", json_path);
+    }
+
+    return status;
+}
@@ -0,0 +1,736 @@
+/**
+ * vedicmath_latency_benchmark.c - Latency under load with open-loop arrivals
+ *
+ * Request handlers see the library at an arrival rate they do not control,
+ * so what matters there is tail latency at a given load rather than
+ * closed-loop throughput. This benchmark generates operations open-loop:
+ * every worker thread follows a precomputed Poisson schedule (exponential
+ * gaps, the threads together form one Poisson stream at the offered rate)
+ * and issues each operation at its scheduled time whether or not the
+ * previous one has finished.
+ *
+ * Latency is measured from the scheduled start, not from the moment the
+ * worker got round to the operation, so time spent queued behind a slow
+ * operation is counted (the coordinated-omission correction). Service time
+ * (actual start to completion) is kept separately. Both go into
+ * HDR-style log-linear histograms with better than 1% resolution.
+ *
+ * For each dispatcher mode the offered rate is swept as fractions of the
+ * measured closed-loop capacity (or over --rates), and the saturation knee
+ * is reported: the highest rate at which the achieved throughput keeps up
+ * with the offered rate and p99 stays within 10x of its low-load value.
+ * Everything runs in-process; there is no network.
+ *
+ * Usage: vedicmath_latency_benchmark [--threads N] [--duration-ms MS]
+ *                                    [--reps N] [--rates R1,R2,...]
+ *                                    [--mode NAME] [--no-pin] [--json FILE]
+ */
+#include "vedicmath_bench_harness.h"
+#include "vedicmath_bench_json.h"
+#include "../include/vedicmath.h"
+#include "../include/vedicmath_types.h"
+#include "../include/vedicmath_dynamic.h"
+#include "../include/vedicmath_optimized.h"
+#include "../include/unified_adaptive_dispatcher.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LATENCY_SEED 20240501u
+#define LATENCY_MAX_THREADS 64
+#define LATENCY_DEFAULT_THREADS 4
+#define LATENCY_MAX_RATES 32
+#define LATENCY_START_DELAY_NS 1000000ull  // Lead time between release and the first arrival
+#define LATENCY_KNEE_P99_FACTOR 10.0       // p99 growth over low load that counts as saturated
+#define LATENCY_KNEE_THROUGHPUT 0.95       // Achieved / offered below this counts as saturated
+
+// Offered load as fractions of the measured capacity, unless --rates is given
+static const double default_load_fractions[] = {0.1, 0.25, 0.5, 0.7, 0.8, 0.9, 1.0, 1.2};
+
+// ============================================================================
+// HISTOGRAM
+// ============================================================================
+
+// Log-linear buckets as in HdrHistogram: values below 2^SUB_BITS are exact,
+// above that every power of two is split into 2^(SUB_BITS-1) buckets, which
+// bounds the relative error by 1/128 (better than 2 significant digits)
+#define HIST_SUB_BITS 8
+#define HIST_SUB_COUNT (1u << HIST_SUB_BITS)
+#define HIST_HALF_COUNT (HIST_SUB_COUNT / 2)
+#define HIST_MAX_SHIFT 40                  // Values up to ~2^48 ns (3 days)
+#define HIST_BUCKETS (HIST_SUB_COUNT + HIST_MAX_SHIFT * HIST_HALF_COUNT)
+
+typedef struct
+{
+    uint64_t counts[HIST_BUCKETS];
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    double sum;
+} LatencyHistogram;
+
+static void histogram_reset(LatencyHistogram *histogram)
+{
+    memset(histogram, 0, sizeof(*histogram));
+    histogram->min = UINT64_MAX;
+}
+
+static int bit_length(uint64_t value)
+{
+    int bits = 0;
+    while (value)
+    {
+        bits++;
+        value >>= 1;
+    }
+    return bits;
+}
+
+static size_t histogram_index(uint64_t value)
+{
+    if (value < HIST_SUB_COUNT)
+        return (size_t)value;
+    int shift = bit_length(value) - HIST_SUB_BITS;
+    if (shift > HIST_MAX_SHIFT)
+        return HIST_BUCKETS - 1;
+    return HIST_SUB_COUNT + (size_t)(shift - 1) * HIST_HALF_COUNT + (size_t)((value >> shift) - HIST_HALF_COUNT);
+}
+
+/**
+ * Highest value that falls in a bucket
+ */
+static uint64_t histogram_bucket_value(size_t index)
+{
+    if (index < HIST_SUB_COUNT)
+        return index;
+    size_t shift = (index - HIST_SUB_COUNT) / HIST_HALF_COUNT + 1;
+    uint64_t sub = (index - HIST_SUB_COUNT) % HIST_HALF_COUNT + HIST_HALF_COUNT;
+    return ((sub + 1) << shift) - 1;
+}
+
+static void histogram_record(LatencyHistogram *histogram, uint64_t value)
+{
+    histogram->counts[histogram_index(value)]++;
+    histogram->total++;
+    histogram->sum += (double)value;
+    if (value < histogram->min)
+        histogram->min = value;
+    if (value > histogram->max)
+        histogram->max = value;
+}
+
+static void histogram_merge(LatencyHistogram *into, const LatencyHistogram *from)
+{
+    for (size_t i = 0; i < HIST_BUCKETS; i++)
+        into->counts[i] += from->counts[i];
+    into->total += from->total;
+    into->sum += from->sum;
+    if (from->min < into->min)
+        into->min = from->min;
+    if (from->max > into->max)
+        into->max = from->max;
+}
+
+/**
+ * Value at a percentile (0-100), clamped to the recorded maximum
+ */
+static double histogram_percentile(const LatencyHistogram *histogram, double percent)
+{
+    if (histogram->total == 0)
+        return 0.0;
+    uint64_t rank = (uint64_t)ceil(percent / 100.0 * (double)histogram->total);
+    if (rank < 1)
+        rank = 1;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < HIST_BUCKETS; i++)
+    {
+        seen += histogram->counts[i];
+        if (seen >= rank)
+        {
+            uint64_t value = histogram_bucket_value(i);
+            return (double)(value < histogram->max ? value : histogram->max);
+        }
+    }
+    return (double)histogram->max;
+}
+
+// ============================================================================
+// WORKLOADS
+// ============================================================================
+
+// The dispatcher modes are the harness's shared multiply workloads
+static const BenchWorkload *const workloads = bench_multiply_workloads;
+
+#define WORKLOAD_COUNT BENCH_MULTIPLY_WORKLOAD_COUNT
+
+/**
+ * Exponentially distributed gap in ns for a Poisson process
+ */
+static double exponential_gap(uint64_t *state, double mean_gap_ns)
+{
+    // xorshift64*: rand() has too few bits for the tail of the distribution
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    uint64_t bits = (*state * 2685821657736338717ull) >> 11;
+    double uniform = ((double)bits + 0.5) / 9007199254740992.0;   // (0, 1)
+    return -log(uniform) * mean_gap_ns;
+}
+
+// ============================================================================
+// WORKER THREADS
+// ============================================================================
+
+typedef struct
+{
+    const BenchWorkload *workload;
+    BenchOperands *data;
+    int cpu;                        // CPU to pin to, -1 for none
+    double mean_gap_ns;             // 1 / this worker's arrival rate
+    uint64_t duration_ns;           // Arrivals are scheduled over this window
+    const uint64_t *start_ns;       // First possible arrival, valid once go is set
+    volatile long *ready;
+    volatile long *go;
+    uint64_t random_state;
+
+    // Outputs
+    LatencyHistogram *response;     // Scheduled start to completion
+    LatencyHistogram *service;      // Actual start to completion
+    size_t completed;
+    size_t abandoned;               // Still queued at the cutoff
+    uint64_t end_ns;
+} LatencyWorker;
+
+static void worker_main(void *arg)
+{
+    LatencyWorker *worker = (LatencyWorker *)arg;
+    if (worker->cpu >= 0)
+        bench_pin_to_cpu(worker->cpu);
+
+    const BenchWorkload *workload = worker->workload;
+    BenchOperands *data = worker->data;
+
+    BENCH_ATOMIC_INC(worker->ready);
+    while (!BENCH_ATOMIC_LOAD(worker->go))
+        BENCH_YIELD();
+
+    // Past the end of the window the worker is only draining its backlog;
+    // an overloaded worker gives up after a second window so the sweep ends
+    uint64_t start = *worker->start_ns;
+    uint64_t end = start + worker->duration_ns;
+    uint64_t cutoff = end + worker->duration_ns;
+    double scheduled = (double)start + exponential_gap(&worker->random_state, worker->mean_gap_ns);
+    uint64_t now = bench_now_ns();
+
+    while (scheduled < (double)end)
+    {
+        uint64_t arrival = (uint64_t)scheduled;
+        while (now < arrival)
+            now = bench_now_ns();
+
+        if (now >= cutoff)
+        {
+            // Operations never started still count, with the time they
+            // have waited so far
+            for (; scheduled < (double)end; scheduled += exponential_gap(&worker->random_state, worker->mean_gap_ns))
+            {
+                histogram_record(worker->response, now - (uint64_t)scheduled);
+                worker->abandoned++;
+            }
+            break;
+        }
+
+        workload->run(data);
+        uint64_t done = bench_now_ns();
+
+        histogram_record(worker->response, done - arrival);
+        histogram_record(worker->service, done - now);
+        worker->completed++;
+        now = done;
+        scheduled += exponential_gap(&worker->random_state, worker->mean_gap_ns);
+    }
+
+    worker->end_ns = now;
+}
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+
+typedef struct
+{
+    size_t threads;
+    int pin;
+    int cpus[LATENCY_MAX_THREADS];
+    int cpu_count;
+    uint64_t duration_ns;
+    size_t repetitions;
+    double rates[LATENCY_MAX_RATES];   // Absolute rates (ops/s) from --rates
+    size_t rate_count;
+} LatencyOptions;
+
+/**
+ * Result of one mode at one offered rate (all repetitions merged)
+ */
+typedef struct
+{
+    double offered;                  // Operations per second, all threads
+    double achieved;
+    double p50_ns;                   // Response time (from scheduled start)
+    double p90_ns;
+    double p99_ns;
+    double p999_ns;
+    double max_ns;
+    double service_p50_ns;           // Service time (from actual start)
+    double service_p99_ns;
+    size_t abandoned;
+    int saturated;
+} LatencyPoint;
+
+/**
+ * Closed-loop capacity of one thread, including the generator's own cost
+ * (clock reads, histogram updates and the exponential draw per operation)
+ *
+ * @return Operations per second
+ */
+static double measure_capacity(const BenchWorkload *workload, BenchOperands *data,
+                               LatencyHistogram *scratch, uint64_t duration_ns)
+{
+    uint64_t random_state = LATENCY_SEED;
+    size_t operations = 0;
+    double schedule = 0.0;
+    uint64_t start = bench_now_ns();
+    uint64_t now = start;
+
+    histogram_reset(scratch);
+    while (now - start < duration_ns)
+    {
+        uint64_t begin = bench_now_ns();
+        workload->run(data);
+        now = bench_now_ns();
+        histogram_record(scratch, now - begin);
+        schedule += exponential_gap(&random_state, 1.0);
+        operations++;
+    }
+    BENCH_DO_NOT_OPTIMIZE(schedule);
+
+    return now > start ? (double)operations * 1e9 / (double)(now - start) : 0.0;
+}
+
+/**
+ * Run one mode at one offered rate on all threads
+ *
+ * @param p99_samples Output: p99 response time of each repetition
+ * @return Merged figures; offered == 0 on failure
+ */
+static LatencyPoint run_latency_point(const BenchWorkload *workload, double rate,
+                                      BenchOperands **thread_data, LatencyHistogram *response,
+                                      LatencyHistogram *service, const LatencyOptions *options,
+                                      double *p99_samples)
+{
+    LatencyPoint point;
+    memset(&point, 0, sizeof(point));
+
+    size_t threads = options->threads;
+    LatencyWorker *workers = calloc(threads, sizeof(LatencyWorker));
+    bench_thread_t *handles = calloc(threads, sizeof(bench_thread_t));
+    LatencyHistogram *merged_response = malloc(sizeof(LatencyHistogram));
+    LatencyHistogram *merged_service = malloc(sizeof(LatencyHistogram));
+    size_t completed = 0;
+    double window_ns = 0.0;
+
+    if (!workers || !handles || !merged_response || !merged_service)
+        goto done;
+    histogram_reset(merged_response);
+    histogram_reset(merged_service);
+
+    for (size_t rep = 0; rep < options->repetitions; rep++)
+    {
+        volatile long ready = 0;
+        volatile long go = 0;
+        uint64_t start_ns = 0;
+        size_t started = 0;
+
+        if (workload->prepare)
+            workload->prepare();
+
+        for (size_t t = 0; t < threads; t++)
+        {
+            LatencyWorker *worker = &workers[t];
+            memset(worker, 0, sizeof(*worker));
+            histogram_reset(&response[t]);
+            histogram_reset(&service[t]);
+            worker->workload = workload;
+            worker->data = thread_data[t];
+            worker->cpu = (options->pin && options->cpu_count > 0) ? options->cpus[t % (size_t)options->cpu_count] : -1;
+            worker->mean_gap_ns = 1e9 * (double)threads / rate;
+            worker->duration_ns = options->duration_ns;
+            worker->start_ns = &start_ns;
+            worker->ready = &ready;
+            worker->go = &go;
+            worker->random_state = ((uint64_t)LATENCY_SEED << 32) + 7919u * (rep * threads + t) + 1;
+            worker->response = &response[t];
+            worker->service = &service[t];
+
+            if (bench_thread_start(&handles[t], worker_main, worker) != 0)
+                break;
+            started++;
+        }
+
+        while ((size_t)BENCH_ATOMIC_LOAD(&ready) < started)
+            BENCH_YIELD();
+        start_ns = bench_now_ns() + LATENCY_START_DELAY_NS;
+        BENCH_ATOMIC_STORE(&go, 1);
+
+        for (size_t t = 0; t < started; t++)
+            bench_thread_join(handles[t]);
+        if (started < threads)
+        {
+            printf("  failed to start %zu threads\n", threads);
+            goto done;
+        }
+
+        LatencyHistogram *repetition = malloc(sizeof(LatencyHistogram));
+        if (!repetition)
+            goto done;
+        histogram_reset(repetition);
+
+        uint64_t last_end = start_ns;
+        for (size_t t = 0; t < threads; t++)
+        {
+            histogram_merge(repetition, &response[t]);
+            histogram_merge(merged_service, &service[t]);
+            completed += workers[t].completed;
+            point.abandoned += workers[t].abandoned;
+            if (workers[t].end_ns > last_end)
+                last_end = workers[t].end_ns;
+        }
+        // Throughput over the arrival window, or longer if the backlog ran over
+        double elapsed = (double)(last_end - start_ns);
+        window_ns += elapsed > (double)options->duration_ns ? elapsed : (double)options->duration_ns;
+
+        p99_samples[rep] = histogram_percentile(repetition, 99.0);
+        histogram_merge(merged_response, repetition);
+        free(repetition);
+    }
+
+    point.offered = rate;
+    point.achieved = window_ns > 0.0 ? (double)completed * 1e9 / window_ns : 0.0;
+    point.p50_ns = histogram_percentile(merged_response, 50.0);
+    point.p90_ns = histogram_percentile(merged_response, 90.0);
+    point.p99_ns = histogram_percentile(merged_response, 99.0);
+    point.p999_ns = histogram_percentile(merged_response, 99.9);
+    point.max_ns = (double)merged_response->max;
+    point.service_p50_ns = histogram_percentile(merged_service, 50.0);
+    point.service_p99_ns = histogram_percentile(merged_service, 99.0);
+
+done:
+    free(workers);
+    free(handles);
+    free(merged_response);
+    free(merged_service);
+    return point;
+}
+
+// ============================================================================
+// REPORTING
+// ============================================================================
+
+static void format_latency(char *buffer, size_t size, double ns)
+{
+    if (ns >= 1e6)
+        snprintf(buffer, size, "%.2f ms", ns / 1e6);
+    else if (ns >= 1e3)
+        snprintf(buffer, size, "%.2f us", ns / 1e3);
+    else
+        snprintf(buffer, size, "%.0f ns", ns);
+}
+
+static void print_header(void)
+{
+    printf("  %14s %14s %10s %10s %10s %10s %10s %10s  %s\n",
+           "offered ops/s", "achieved", "p50", "p90", "p99", "p99.9", "max", "svc p99", "");
+}
+
+static void print_point(const LatencyPoint *point)
+{
+    char p50[16], p90[16], p99[16], p999[16], max[16], service[16];
+    format_latency(p50, sizeof(p50), point->p50_ns);
+    format_latency(p90, sizeof(p90), point->p90_ns);
+    format_latency(p99, sizeof(p99), point->p99_ns);
+    format_latency(p999, sizeof(p999), point->p999_ns);
+    format_latency(max, sizeof(max), point->max_ns);
+    format_latency(service, sizeof(service), point->service_p99_ns);
+
+    printf("  %14.0f %14.0f %10s %10s %10s %10s %10s %10s  %s",
+           point->offered, point->achieved, p50, p90, p99, p999, max, service,
+           point->saturated ? "saturated" : "");
+    if (point->abandoned > 0)
+        printf(" (%zu abandoned)", point->abandoned);
+    printf("\n");
+}
+
+/**
+ * Knee: the highest offered rate before the first saturated one
+ */
+static const LatencyPoint *find_knee(const LatencyPoint *points, size_t count)
+{
+    const LatencyPoint *knee = NULL;
+    for (size_t r = 0; r < count && !points[r].saturated; r++)
+        knee = &points[r];
+    return knee;
+}
+
+static void print_knee_report(LatencyPoint points[][LATENCY_MAX_RATES], const size_t *counts,
+                              const double *capacity, const int *selected)
+{
+    printf("\n=== Saturation Knee ===\n");
+    printf("%-24s %16s %16s %12s %12s\n", "Mode", "Capacity ops/s", "Knee ops/s", "p99 at knee", "Low-load p99");
+    for (size_t w = 0; w < WORKLOAD_COUNT; w++)
+    {
+        if (!selected[w] || counts[w] == 0)
+            continue;
+
+        const LatencyPoint *knee = find_knee(points[w], counts[w]);
+        char knee_p99[16] = "-", low_p99[16];
+        format_latency(low_p99, sizeof(low_p99), points[w][0].p99_ns);
+        if (knee)
+        {
+            format_latency(knee_p99, sizeof(knee_p99), knee->p99_ns);
+            printf("%-24s %16.0f %16.0f %12s %12s\n", workloads[w].name, capacity[w], knee->offered, knee_p99, low_p99);
+        }
+        else
+        {
+            printf("%-24s %16.0f %16s %12s %12s\n", workloads[w].name, capacity[w], "below sweep", knee_p99, low_p99);
+        }
+    }
+    printf("\nSaturated = achieved < %.0f%% of offered, or p99 above %.0fx its lowest-rate value.\n"
+           "Latency is measured from the scheduled arrival (coordinated-omission corrected).\n",
+           LATENCY_KNEE_THROUGHPUT * 100.0, LATENCY_KNEE_P99_FACTOR);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void print_usage(const char *program)
+{
+    printf("Usage: %s [--threads N] [--duration-ms MS] [--reps N] [--rates R1,R2,...] [--mode NAME]\n"
+           "          [--no-pin] [--json FILE]\n",
+           program);
+}
+
+/**
+ * Parse a comma-separated list of rates in operations per second
+ *
+ * @return Number of rates, or 0 on a malformed list
+ */
+static size_t parse_rates(const char *list, double *rates)
+{
+    size_t count = 0;
+    const char *p = list;
+    while (*p && count < LATENCY_MAX_RATES)
+    {
+        char *end;
+        double rate = strtod(p, &end);
+        if (end == p || rate <= 0.0 || (*end != ',' && *end != '\0'))
+            return 0;
+        rates[count++] = rate;
+        p = *end == ',' ? end + 1 : end;
+    }
+    return count;
+}
+
+int main(int argc, char *argv[])
+{
+    LatencyOptions options;
+    memset(&options, 0, sizeof(options));
+    options.pin = 1;
+    options.duration_ns = 200000000ull;
+    options.repetitions = 3;
+
+    long threads = 0;
+    const char *filter = NULL;
+    const char *json_path = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--threads") == 0 && value)
+        {
+            threads = atol(value);
+            i++;
+        }
+        else if (strcmp(argv[i], "--duration-ms") == 0 && value)
+        {
+            double ms = atof(value);
+            if (ms > 0.0)
+                options.duration_ns = (uint64_t)(ms * 1e6);
+            i++;
+        }
+        else if (strcmp(argv[i], "--reps") == 0 && value)
+        {
+            long reps = atol(value);
+            if (reps > 0)
+                options.repetitions = (size_t)(reps < BENCH_MAX_REPETITIONS ? reps : BENCH_MAX_REPETITIONS);
+            i++;
+        }
+        else if (strcmp(argv[i], "--rates") == 0 && value)
+        {
+            options.rate_count = parse_rates(value, options.rates);
+            if (options.rate_count == 0)
+            {
+                printf("Invalid rate list '%s'\n", value);
+                return 1;
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "--mode") == 0 && value)
+        {
+            filter = value;
+            i++;
+        }
+        else if (strcmp(argv[i], "--json") == 0 && value)
+        {
+            json_path = value;
+            i++;
+        }
+        else if (strcmp(argv[i], "--no-pin") == 0)
+        {
+            options.pin = 0;
+        }
+        else
+        {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    options.cpu_count = bench_allowed_cpus(options.cpus, LATENCY_MAX_THREADS);
+    if (threads <= 0)
+        threads = options.cpu_count > 0 && options.cpu_count < LATENCY_DEFAULT_THREADS ? options.cpu_count
+                                                                                     : LATENCY_DEFAULT_THREADS;
+    if (threads > LATENCY_MAX_THREADS)
+        threads = LATENCY_MAX_THREADS;
+    options.threads = (size_t)threads;
+
+    BenchHarnessConfig harness;
+    bench_harness_default_config(&harness);
+    harness.repetitions = options.repetitions;
+    harness.target_time_sec = (double)options.duration_ns / 1e9;
+    harness.cpu = BENCH_CPU_NONE;
+    bench_harness_set_config(&harness);
+
+    if (json_path && bench_json_begin(json_path, argv[0]) != 0)
+    {
+        printf("Error: cannot write JSON results to '%s'\n", json_path);
+        return 1;
+    }
+
+    printf("Vedic Mathematics Latency-Under-Load Benchmark\n");
+    printf("==============================================\n");
+    printf("%zu worker threads (%s), Poisson arrivals over %.0f ms, %zu repetitions per rate\n",
+           options.threads, options.pin ? "one CPU per thread" : "unpinned",
+           (double)options.duration_ns / 1e6, options.repetitions);
+    if (options.cpu_count > 0 && (long)options.threads > options.cpu_count)
+        printf("Warning: more workers than CPUs; spinning workers will share cores\n");
+
+    vedic_optimized_init();
+    UnifiedDispatchConfig unified_config = unified_dispatch_get_preset_config("embedded");
+    unified_config.enable_learning = false;
+    unified_config.enable_dataset_logging = false;
+    unified_config.enable_system_monitoring = false;
+    unified_dispatch_init(&unified_config);
+
+    BenchOperands **thread_data = calloc(options.threads, sizeof(BenchOperands *));
+    LatencyHistogram *response = malloc(options.threads * sizeof(LatencyHistogram));
+    LatencyHistogram *service = malloc(options.threads * sizeof(LatencyHistogram));
+    if (!thread_data || !response || !service)
+    {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    for (size_t t = 0; t < options.threads; t++)
+    {
+        thread_data[t] = malloc(sizeof(BenchOperands));
+        if (!thread_data[t])
+        {
+            printf("Memory allocation failed\n");
+            return 1;
+        }
+        bench_operands_fill(thread_data[t], (unsigned)t);
+    }
+
+    static LatencyPoint points[WORKLOAD_COUNT][LATENCY_MAX_RATES];
+    size_t counts[WORKLOAD_COUNT] = {0};
+    double capacity[WORKLOAD_COUNT] = {0.0};
+    int selected[WORKLOAD_COUNT];
+    double p99_samples[BENCH_MAX_REPETITIONS];
+
+    for (size_t w = 0; w < WORKLOAD_COUNT; w++)
+    {
+        const BenchWorkload *workload = &workloads[w];
+        selected[w] = !filter || strstr(workload->name, filter) != NULL;
+        if (!selected[w])
+            continue;
+
+        if (workload->prepare)
+            workload->prepare();
+        if (options.pin && options.cpu_count > 0)
+            bench_pin_to_cpu(options.cpus[0]);
+        uint64_t calibration_ns = options.duration_ns / 4 < 50000000ull ? options.duration_ns / 4 : 50000000ull;
+        capacity[w] = measure_capacity(workload, thread_data[0], &response[0], calibration_ns) * (double)options.threads;
+
+        printf("\n=== %s (closed-loop capacity %.0f ops/s on %zu threads) ===\n",
+               workload->name, capacity[w], options.threads);
+        print_header();
+
+        size_t rate_count = options.rate_count > 0 ? options.rate_count
+                                                   : sizeof(default_load_fractions) / sizeof(default_load_fractions[0]);
+        for (size_t r = 0; r < rate_count; r++)
+        {
+            double rate = options.rate_count > 0 ? options.rates[r] : default_load_fractions[r] * capacity[w];
+            LatencyPoint point = run_latency_point(workload, rate, thread_data, response, service,
+                                                   &options, p99_samples);
+            if (point.offered == 0.0)
+                continue;
+
+            double low_load_p99 = counts[w] > 0 ? points[w][0].p99_ns : point.p99_ns;
+            point.saturated = point.achieved < LATENCY_KNEE_THROUGHPUT * point.offered ||
+                              point.p99_ns > LATENCY_KNEE_P99_FACTOR * low_load_p99;
+            points[w][counts[w]++] = point;
+            print_point(&point);
+
+            // JSON samples are the per-repetition p99 response times
+            char implementation[48];
+            if (options.rate_count > 0)
+                snprintf(implementation, sizeof(implementation), "p99 at %.0f ops/s", rate);
+            else
+                snprintf(implementation, sizeof(implementation), "p99 at %.0f%% load", default_load_fractions[r] * 100.0);
+            bench_json_record(workload->name, implementation, p99_samples, options.repetitions, 0, NULL);
+        }
+    }
+
+    print_knee_report(points, counts, capacity, selected);
+
+    for (size_t t = 0; t < options.threads; t++)
+        free(thread_data[t]);
+    free(thread_data);
+    free(response);
+    free(service);
+    vedic_optimized_cleanup();
+
+    if (json_path)
+    {
+        if (bench_json_end() != 0)
+        {
+            printf("Error: failed to write JSON results to '%s'\n", json_path);
+            return 1;
+        }
+        printf("JSON results written to %s\n", json_path);
+    }
+
+    return 0;
+}
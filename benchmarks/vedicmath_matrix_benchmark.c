@@ -0,0 +1,916 @@
+/**
+ * vedicmath_matrix_benchmark.c - Matrix multiplication benchmark suite
+ *
+ * Measures C = A x B for integer matrices over a sweep of sizes, shapes,
+ * value distributions, thread counts and kernels:
+ *
+ *   shapes        square (s x s times s x s), tall-skinny (s x s/8 times
+ *                 s/8 x s/8) and short-fat (s/8 x s/8 times s/8 x s)
+ *   distributions random (1..9999), near-base (1000 +/- 50) and small-int
+ *                 (0..15)
+ *   kernels       standard   naive i-j-k loop (the baseline)
+ *                 blocked    cache-blocked i-k-j loop on 64x64 tiles
+ *                 nikhilam   Nikhilam decomposition around a common base:
+ *                            with A = b + dA and B = b + dB,
+ *                            C = k*b^2 + b*(rowsum(dA) + colsum(dB)) + dA x dB,
+ *                            so only the small deviations are multiplied
+ *                 narrow     16-bit operands with 32-bit accumulators in an
+ *                            i-k-j loop the compiler can vectorize (only
+ *                            when the values and k allow it)
+ *
+ * Rows of C are split evenly across the threads of a product. Every product
+ * is timed with the shared harness (calibrated repetitions, median/MAD,
+ * JSON output) and reported as milliseconds per product, GOPS (2*m*n*k
+ * integer operations per product, the integer analogue of GFLOPS) and
+ * percent of peak. The peak is measured, not looked up: it is the in-L1
+ * throughput of an unrolled copy of the narrow kernel's 16x16->32-bit
+ * multiply-add loop on one thread, times the thread count (override with
+ * --peak-gops). A sample of
+ * every product is checked against a direct 64-bit dot product.
+ *
+ * Usage: vedicmath_matrix_benchmark [--min-size N] [--max-size N]
+ *                                   [--shape NAME] [--dist NAME]
+ *                                   [--kernel NAME] [--threads LIST]
+ *                                   [--peak-gops G] [--reps N]
+ *                                   [--target-ms MS] [--cpu N|auto|none]
+ *                                   [--json FILE]
+ */
+#include "vedicmath_benchmark.h"
+#include "../include/vedicmath.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MATRIX_SEED 20240501u
+#define MATRIX_MAX_THREADS 64
+#define MATRIX_MAX_THREAD_COUNTS 8
+#define MATRIX_TILE 64
+#define MATRIX_VERIFY_SAMPLES 64
+#define MATRIX_PEAK_ROWS 4                  // B rows per pass of the peak loop
+#define MATRIX_PEAK_LENGTH 512              // Accumulators of the in-L1 peak loop
+#define MATRIX_MIN_PARALLEL_OPS (1u << 20)  // Below this, thread start-up dominates
+#define MATRIX_NEAR_BASE 1000
+#define MATRIX_NEAR_SPREAD 50
+
+typedef enum
+{
+    SHAPE_SQUARE,
+    SHAPE_TALL_SKINNY,
+    SHAPE_SHORT_FAT,
+    SHAPE_COUNT
+} MatrixShape;
+
+typedef enum
+{
+    DIST_RANDOM,
+    DIST_NEAR_BASE,
+    DIST_SMALL_INT,
+    DIST_COUNT
+} MatrixDistribution;
+
+static const char *const shape_names[SHAPE_COUNT] = {"square", "tall-skinny", "short-fat"};
+static const char *const dist_names[DIST_COUNT] = {"random", "near-base", "small-int"};
+
+// ============================================================================
+// PROBLEM AND KERNELS
+// ============================================================================
+
+/**
+ * One product C = A x B with the workspace every kernel may need
+ *
+ * The workspace is allocated once per problem, so nothing is allocated
+ * inside the timed products.
+ */
+typedef struct
+{
+    size_t m, k, n;
+    const int64_t *a;          // m x k, row-major
+    const int64_t *b;          // k x n, row-major
+    int64_t *c;                // m x n, row-major
+    size_t threads;
+    const int *cpus;           // CPU of each thread (NULL = no pinning)
+
+    int16_t *a16;              // Narrow copy of A (operands or deviations)
+    int16_t *b16;              // Narrow copy of B (operands or deviations)
+    int32_t *c32;              // One accumulator row of n per thread
+    int64_t *dev_a;            // Wide deviations when they do not fit 16 bits
+    int64_t *dev_b;
+    int64_t *row_dev;          // Row sums of the A deviations
+    int64_t *col_dev;          // Column sums of the B deviations
+    int64_t base;              // Nikhilam base
+    int narrow_deviations;     // Nikhilam multiplies a16/b16 instead of dev_a/dev_b
+} MatrixProblem;
+
+/**
+ * One multiplication kernel
+ */
+typedef struct
+{
+    const char *name;
+    // Decide once per problem whether the kernel applies (NULL = always);
+    // returns 0 if it does and may fill in kernel-specific problem fields
+    int (*setup)(MatrixProblem *p);
+    // Serial part of every product, before the rows are split (optional)
+    void (*prepare)(MatrixProblem *p);
+    // Compute rows [begin, end) of C on thread number `thread`
+    void (*rows)(MatrixProblem *p, size_t begin, size_t end, size_t thread);
+    const char *not_applicable;  // Reason printed when setup fails
+} MatrixKernel;
+
+static void standard_rows(MatrixProblem *p, size_t begin, size_t end, size_t thread)
+{
+    (void)thread;
+    for (size_t i = begin; i < end; i++)
+    {
+        for (size_t j = 0; j < p->n; j++)
+        {
+            int64_t sum = 0;
+            for (size_t kk = 0; kk < p->k; kk++)
+                sum += p->a[i * p->k + kk] * p->b[kk * p->n + j];
+            p->c[i * p->n + j] = sum;
+        }
+    }
+}
+
+static void blocked_rows(MatrixProblem *p, size_t begin, size_t end, size_t thread)
+{
+    (void)thread;
+    memset(&p->c[begin * p->n], 0, (end - begin) * p->n * sizeof(int64_t));
+
+    for (size_t k0 = 0; k0 < p->k; k0 += MATRIX_TILE)
+    {
+        size_t k_max = k0 + MATRIX_TILE < p->k ? k0 + MATRIX_TILE : p->k;
+        for (size_t j0 = 0; j0 < p->n; j0 += MATRIX_TILE)
+        {
+            size_t j_max = j0 + MATRIX_TILE < p->n ? j0 + MATRIX_TILE : p->n;
+            for (size_t i = begin; i < end; i++)
+            {
+                int64_t *c_row = &p->c[i * p->n];
+                for (size_t kk = k0; kk < k_max; kk++)
+                {
+                    int64_t a_ik = p->a[i * p->k + kk];
+                    const int64_t *b_row = &p->b[kk * p->n];
+                    for (size_t j = j0; j < j_max; j++)
+                        c_row[j] += a_ik * b_row[j];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Row i of a16 x b16 into the thread's 32-bit accumulator row
+ */
+static int32_t *narrow_row_product(MatrixProblem *p, size_t i, size_t thread)
+{
+    int32_t *acc = &p->c32[thread * p->n];
+    memset(acc, 0, p->n * sizeof(int32_t));
+
+    for (size_t kk = 0; kk < p->k; kk++)
+    {
+        int32_t a_ik = p->a16[i * p->k + kk];
+        const int16_t *b_row = &p->b16[kk * p->n];
+        for (size_t j = 0; j < p->n; j++)
+            acc[j] += a_ik * b_row[j];
+    }
+    return acc;
+}
+
+/**
+ * Largest absolute value of a matrix
+ */
+static int64_t max_magnitude(const int64_t *values, size_t count, int64_t offset)
+{
+    int64_t max = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        int64_t v = values[i] - offset;
+        if (v < 0)
+            v = -v;
+        if (v > max)
+            max = v;
+    }
+    return max;
+}
+
+/**
+ * Whether products of values up to max_a and max_b summed over k terms
+ * fit the 16-bit operand / 32-bit accumulator kernel
+ */
+static int fits_narrow(int64_t max_a, int64_t max_b, size_t k)
+{
+    if (max_a > INT16_MAX || max_b > INT16_MAX)
+        return 0;
+    return (double)max_a * (double)max_b * (double)k <= (double)INT32_MAX;
+}
+
+static int narrow_setup(MatrixProblem *p)
+{
+    return fits_narrow(max_magnitude(p->a, p->m * p->k, 0),
+                       max_magnitude(p->b, p->k * p->n, 0), p->k) ? 0 : -1;
+}
+
+static void narrow_prepare(MatrixProblem *p)
+{
+    for (size_t i = 0; i < p->m * p->k; i++)
+        p->a16[i] = (int16_t)p->a[i];
+    for (size_t i = 0; i < p->k * p->n; i++)
+        p->b16[i] = (int16_t)p->b[i];
+}
+
+static void narrow_rows(MatrixProblem *p, size_t begin, size_t end, size_t thread)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        const int32_t *acc = narrow_row_product(p, i, thread);
+        int64_t *c_row = &p->c[i * p->n];
+        for (size_t j = 0; j < p->n; j++)
+            c_row[j] = acc[j];
+    }
+}
+
+static int nikhilam_setup(MatrixProblem *p)
+{
+    // Common base: the power of 10 nearest to the mean operand, as the
+    // scalar Nikhilam sutra picks it for a single pair
+    double sum = 0.0;
+    for (size_t i = 0; i < p->m * p->k; i++)
+        sum += (double)p->a[i];
+    for (size_t i = 0; i < p->k * p->n; i++)
+        sum += (double)p->b[i];
+    long mean = (long)(sum / (double)(p->m * p->k + p->k * p->n) + 0.5);
+    p->base = nearest_power_of_10(mean);
+
+    p->narrow_deviations = fits_narrow(max_magnitude(p->a, p->m * p->k, p->base),
+                                       max_magnitude(p->b, p->k * p->n, p->base), p->k);
+    return 0;
+}
+
+static void nikhilam_prepare(MatrixProblem *p)
+{
+    for (size_t i = 0; i < p->m; i++)
+    {
+        int64_t row_sum = 0;
+        for (size_t kk = 0; kk < p->k; kk++)
+        {
+            int64_t d = p->a[i * p->k + kk] - p->base;
+            row_sum += d;
+            if (p->narrow_deviations)
+                p->a16[i * p->k + kk] = (int16_t)d;
+            else
+                p->dev_a[i * p->k + kk] = d;
+        }
+        p->row_dev[i] = row_sum;
+    }
+
+    memset(p->col_dev, 0, p->n * sizeof(int64_t));
+    for (size_t kk = 0; kk < p->k; kk++)
+    {
+        for (size_t j = 0; j < p->n; j++)
+        {
+            int64_t d = p->b[kk * p->n + j] - p->base;
+            p->col_dev[j] += d;
+            if (p->narrow_deviations)
+                p->b16[kk * p->n + j] = (int16_t)d;
+            else
+                p->dev_b[kk * p->n + j] = d;
+        }
+    }
+}
+
+static void nikhilam_rows(MatrixProblem *p, size_t begin, size_t end, size_t thread)
+{
+    const int64_t constant = (int64_t)p->k * p->base * p->base;
+
+    for (size_t i = begin; i < end; i++)
+    {
+        int64_t *c_row = &p->c[i * p->n];
+        int64_t row_term = constant + p->base * p->row_dev[i];
+
+        if (p->narrow_deviations)
+        {
+            const int32_t *acc = narrow_row_product(p, i, thread);
+            for (size_t j = 0; j < p->n; j++)
+                c_row[j] = row_term + p->base * p->col_dev[j] + acc[j];
+            continue;
+        }
+
+        for (size_t j = 0; j < p->n; j++)
+            c_row[j] = row_term + p->base * p->col_dev[j];
+        for (size_t kk = 0; kk < p->k; kk++)
+        {
+            int64_t d_ik = p->dev_a[i * p->k + kk];
+            const int64_t *d_row = &p->dev_b[kk * p->n];
+            for (size_t j = 0; j < p->n; j++)
+                c_row[j] += d_ik * d_row[j];
+        }
+    }
+}
+
+static const MatrixKernel kernels[] = {
+    {"standard", NULL, NULL, standard_rows, NULL},
+    {"blocked", NULL, NULL, blocked_rows, NULL},
+    {"nikhilam", nikhilam_setup, nikhilam_prepare, nikhilam_rows, NULL},
+    {"narrow", narrow_setup, narrow_prepare, narrow_rows, "values exceed the 16/32-bit range"},
+};
+
+#define KERNEL_COUNT (sizeof(kernels) / sizeof(kernels[0]))
+
+// ============================================================================
+// PARALLEL EXECUTION
+// ============================================================================
+
+/**
+ * Rows of one product assigned to one thread
+ */
+typedef struct
+{
+    MatrixProblem *problem;
+    const MatrixKernel *kernel;
+    size_t begin;
+    size_t end;
+    size_t thread;
+} MatrixSlice;
+
+static void slice_run(void *arg)
+{
+    MatrixSlice *slice = (MatrixSlice *)arg;
+    if (slice->problem->cpus)
+        bench_pin_to_cpu(slice->problem->cpus[slice->thread]);
+    slice->kernel->rows(slice->problem, slice->begin, slice->end, slice->thread);
+}
+
+/**
+ * Compute one product; the calling thread takes the first slice
+ */
+static void matrix_product(MatrixProblem *p, const MatrixKernel *kernel)
+{
+    if (kernel->prepare)
+        kernel->prepare(p);
+
+    if (p->threads <= 1)
+    {
+        kernel->rows(p, 0, p->m, 0);
+        return;
+    }
+
+    MatrixSlice slices[MATRIX_MAX_THREADS];
+    bench_thread_t handles[MATRIX_MAX_THREADS];
+    int started[MATRIX_MAX_THREADS];
+
+    for (size_t t = 0; t < p->threads; t++)
+    {
+        slices[t].problem = p;
+        slices[t].kernel = kernel;
+        slices[t].begin = p->m * t / p->threads;
+        slices[t].end = p->m * (t + 1) / p->threads;
+        slices[t].thread = t;
+    }
+
+    // A thread that cannot be started has its rows computed inline
+    for (size_t t = 1; t < p->threads; t++)
+        started[t] = bench_thread_start(&handles[t], slice_run, &slices[t]) == 0;
+    kernel->rows(p, slices[0].begin, slices[0].end, 0);
+    for (size_t t = 1; t < p->threads; t++)
+    {
+        if (started[t])
+            bench_thread_join(handles[t]);
+        else
+            kernel->rows(p, slices[t].begin, slices[t].end, t);
+    }
+}
+
+/**
+ * Argument of the harness callback
+ */
+typedef struct
+{
+    MatrixProblem *problem;
+    const MatrixKernel *kernel;
+} MatrixRun;
+
+static int run_products(size_t iterations, void *data)
+{
+    MatrixRun *run = (MatrixRun *)data;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        matrix_product(run->problem, run->kernel);
+        BENCH_CLOBBER_MEMORY();
+    }
+    return 1;
+}
+
+// ============================================================================
+// PEAK REFERENCE
+// ============================================================================
+
+/**
+ * Operands of the in-L1 peak loop
+ *
+ * The loop is the narrow kernel's inner loop with four rows of B per pass
+ * over the accumulators, so it is bound by the multiply-add units rather
+ * than by the accumulator loads and stores.
+ */
+typedef struct
+{
+    int16_t x[MATRIX_PEAK_ROWS];
+    int16_t y[MATRIX_PEAK_ROWS][MATRIX_PEAK_LENGTH];
+    int32_t acc[MATRIX_PEAK_LENGTH];
+} PeakData;
+
+static int run_peak(size_t iterations, void *data)
+{
+    PeakData *peak = (PeakData *)data;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        int32_t x0 = peak->x[0], x1 = peak->x[1], x2 = peak->x[2], x3 = peak->x[3];
+        for (size_t j = 0; j < MATRIX_PEAK_LENGTH; j++)
+        {
+            peak->acc[j] += x0 * peak->y[0][j] + x1 * peak->y[1][j] +
+                            x2 * peak->y[2][j] + x3 * peak->y[3][j];
+        }
+        BENCH_CLOBBER_MEMORY();
+    }
+    return 1;
+}
+
+/**
+ * Single-thread multiply-add throughput of the narrow inner loop in GOPS
+ */
+static double measure_peak_gops(void)
+{
+    static PeakData peak;
+    for (size_t r = 0; r < MATRIX_PEAK_ROWS; r++)
+    {
+        peak.x[r] = (int16_t)(r + 1);
+        for (size_t j = 0; j < MATRIX_PEAK_LENGTH; j++)
+            peak.y[r][j] = (int16_t)((j * 7 + r) & 15);
+    }
+    memset(peak.acc, 0, sizeof(peak.acc));
+
+    BenchmarkResult result = run_benchmark("Matrix peak", "int16 multiply-add", run_peak, 1, &peak);
+    double ops = 2.0 * MATRIX_PEAK_ROWS * MATRIX_PEAK_LENGTH;
+    return result.median_ns > 0.0 ? ops / result.median_ns : 0.0;
+}
+
+// ============================================================================
+// OPERANDS AND VERIFICATION
+// ============================================================================
+
+static void fill_matrix(int64_t *values, size_t count, MatrixDistribution dist)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        switch (dist)
+        {
+        case DIST_RANDOM:
+            values[i] = 1 + rand() % 9999;
+            break;
+        case DIST_NEAR_BASE:
+            values[i] = MATRIX_NEAR_BASE - MATRIX_NEAR_SPREAD + rand() % (2 * MATRIX_NEAR_SPREAD + 1);
+            break;
+        default:
+            values[i] = rand() % 16;
+            break;
+        }
+    }
+}
+
+static void shape_dimensions(MatrixShape shape, size_t size, size_t *m, size_t *k, size_t *n)
+{
+    size_t narrow = size / 8 > 0 ? size / 8 : 1;
+    *m = shape == SHAPE_SHORT_FAT ? narrow : size;
+    *k = shape == SHAPE_SQUARE ? size : narrow;
+    *n = shape == SHAPE_SQUARE || shape == SHAPE_SHORT_FAT ? size : narrow;
+}
+
+/**
+ * Compare sampled entries of C with a direct dot product
+ */
+static int verify_product(const MatrixProblem *p)
+{
+    for (size_t s = 0; s < MATRIX_VERIFY_SAMPLES; s++)
+    {
+        size_t i = (size_t)rand() % p->m;
+        size_t j = (size_t)rand() % p->n;
+        int64_t expected = 0;
+        for (size_t kk = 0; kk < p->k; kk++)
+            expected += p->a[i * p->k + kk] * p->b[kk * p->n + j];
+        if (p->c[i * p->n + j] != expected)
+            return 0;
+    }
+    return 1;
+}
+
+/**
+ * Allocate operands and workspace for the largest thread count
+ *
+ * @return 0 on success, -1 if out of memory
+ */
+static int problem_alloc(MatrixProblem *p, size_t m, size_t k, size_t n, size_t max_threads)
+{
+    memset(p, 0, sizeof(*p));
+    p->m = m;
+    p->k = k;
+    p->n = n;
+
+    int64_t *a = malloc(m * k * sizeof(int64_t));
+    int64_t *b = malloc(k * n * sizeof(int64_t));
+    p->a = a;
+    p->b = b;
+    p->c = malloc(m * n * sizeof(int64_t));
+    p->a16 = malloc(m * k * sizeof(int16_t));
+    p->b16 = malloc(k * n * sizeof(int16_t));
+    p->c32 = malloc(max_threads * n * sizeof(int32_t));
+    p->dev_a = malloc(m * k * sizeof(int64_t));
+    p->dev_b = malloc(k * n * sizeof(int64_t));
+    p->row_dev = malloc(m * sizeof(int64_t));
+    p->col_dev = malloc(n * sizeof(int64_t));
+
+    return a && b && p->c && p->a16 && p->b16 && p->c32 && p->dev_a && p->dev_b &&
+           p->row_dev && p->col_dev ? 0 : -1;
+}
+
+static void problem_free(MatrixProblem *p)
+{
+    free((void *)p->a);
+    free((void *)p->b);
+    free(p->c);
+    free(p->a16);
+    free(p->b16);
+    free(p->c32);
+    free(p->dev_a);
+    free(p->dev_b);
+    free(p->row_dev);
+    free(p->col_dev);
+}
+
+// ============================================================================
+// SWEEP
+// ============================================================================
+
+typedef struct
+{
+    size_t min_size;
+    size_t max_size;
+    int shape;                       // -1 = all
+    int dist;                        // -1 = all
+    int kernel;                      // -1 = all
+    size_t thread_counts[MATRIX_MAX_THREAD_COUNTS];
+    size_t thread_count_len;
+    double peak_gops;                // Per thread; 0 = measure
+    int cpus[MATRIX_MAX_THREADS];
+    int cpu_count;                   // 0 = no pinning
+} MatrixOptions;
+
+/**
+ * Benchmark all kernels on one problem at one thread count
+ *
+ * @return Number of kernels whose product failed verification
+ */
+static int run_problem(MatrixProblem *p, MatrixShape shape, MatrixDistribution dist,
+                       size_t threads, const MatrixOptions *options)
+{
+    double ops = 2.0 * (double)p->m * (double)p->n * (double)p->k;
+    double peak = options->peak_gops * (double)threads;
+    double standard_ns = 0.0;
+    int failures = 0;
+    char name[96];
+
+    snprintf(name, sizeof(name), "Matrix %s %s %zux%zux%zu t%zu",
+             shape_names[shape], dist_names[dist], p->m, p->k, p->n, threads);
+    printf("%s %zux%zu x %zux%zu, %s, %zu thread%s\n", shape_names[shape], p->m, p->k, p->k, p->n,
+           dist_names[dist], threads, threads == 1 ? "" : "s");
+
+    p->threads = threads;
+    p->cpus = options->cpu_count > 0 ? options->cpus : NULL;
+
+    for (size_t kernel_index = 0; kernel_index < KERNEL_COUNT; kernel_index++)
+    {
+        const MatrixKernel *kernel = &kernels[kernel_index];
+        if (options->kernel >= 0 && (size_t)options->kernel != kernel_index)
+            continue;
+        if (kernel->setup && kernel->setup(p) != 0)
+        {
+            printf("  %-9s n/a (%s)\n", kernel->name, kernel->not_applicable);
+            continue;
+        }
+
+        MatrixRun run = {p, kernel};
+        BenchmarkResult result = run_benchmark(name, kernel->name, run_products, 1, &run);
+        int verified = result.success && verify_product(p);
+        if (!verified)
+            failures++;
+
+        double gops = result.median_ns > 0.0 ? ops / result.median_ns : 0.0;
+        if (kernel_index == 0)
+            standard_ns = result.median_ns;
+
+        printf("  %-9s %10.3f ms (MAD %6.3f)  %8.2f GOPS  %6.1f%% of peak",
+               kernel->name, result.median_ns / 1e6, result.mad_ns / 1e6, gops,
+               peak > 0.0 ? 100.0 * gops / peak : 0.0);
+        if (standard_ns > 0.0 && result.median_ns > 0.0)
+            printf("  %6.2fx", standard_ns / result.median_ns);
+        if (kernel->setup == nikhilam_setup)
+            printf("  base %lld, %s deviations", (long long)p->base,
+                   p->narrow_deviations ? "16-bit" : "64-bit");
+        printf("  [%s]\n", verified ? "OK" : "WRONG");
+    }
+    printf("\n");
+    return failures;
+}
+
+static int find_name(const char *value, const char *const *names, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (strcmp(value, names[i]) == 0)
+            return i;
+    }
+    return -2;
+}
+
+static int find_kernel(const char *value)
+{
+    for (size_t i = 0; i < KERNEL_COUNT; i++)
+    {
+        if (strcmp(value, kernels[i].name) == 0)
+            return (int)i;
+    }
+    return -2;
+}
+
+static size_t parse_thread_list(const char *value, size_t *counts)
+{
+    size_t len = 0;
+    const char *cursor = value;
+    while (*cursor && len < MATRIX_MAX_THREAD_COUNTS)
+    {
+        char *endptr;
+        long threads = strtol(cursor, &endptr, 10);
+        if (endptr == cursor || threads <= 0 || threads > MATRIX_MAX_THREADS)
+            return 0;
+        counts[len++] = (size_t)threads;
+        cursor = *endptr == ',' ? endptr + 1 : endptr;
+        if (*endptr != ',' && *endptr != '\0')
+            return 0;
+    }
+    return len;
+}
+
+static void print_usage(const char *program)
+{
+    printf("Usage: %s [--min-size N] [--max-size N] [--shape square|tall-skinny|short-fat]\n"
+           "          [--dist random|near-base|small-int] [--kernel standard|blocked|nikhilam|narrow]\n"
+           "          [--threads 1,2,4] [--peak-gops G] [--reps N] [--target-ms MS]\n"
+           "          [--cpu N|auto|none] [--json FILE]\n",
+           program);
+    printf("  Sizes double from --min-size (default 16) to --max-size (default 512, up to 4096).\n"
+           "  --threads defaults to 1 and the number of CPUs; --peak-gops sets the per-thread peak.\n");
+}
+
+int main(int argc, char *argv[])
+{
+    MatrixOptions options;
+    memset(&options, 0, sizeof(options));
+    options.min_size = 16;
+    options.max_size = 512;
+    options.shape = -1;
+    options.dist = -1;
+    options.kernel = -1;
+
+    const char *json_path = NULL;
+
+    BenchHarnessConfig config;
+    bench_harness_default_config(&config);
+    config.min_iterations = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        char *endptr;
+        int valid = 1;
+
+        if (strcmp(arg, "--min-size") == 0 && value)
+        {
+            long size = strtol(value, &endptr, 10);
+            valid = *endptr == '\0' && size > 0;
+            options.min_size = valid ? (size_t)size : options.min_size;
+            i++;
+        }
+        else if (strcmp(arg, "--max-size") == 0 && value)
+        {
+            long size = strtol(value, &endptr, 10);
+            valid = *endptr == '\0' && size > 0 && size <= 4096;
+            options.max_size = valid ? (size_t)size : options.max_size;
+            i++;
+        }
+        else if (strcmp(arg, "--shape") == 0 && value)
+        {
+            options.shape = find_name(value, shape_names, SHAPE_COUNT);
+            valid = options.shape >= 0;
+            i++;
+        }
+        else if (strcmp(arg, "--dist") == 0 && value)
+        {
+            options.dist = find_name(value, dist_names, DIST_COUNT);
+            valid = options.dist >= 0;
+            i++;
+        }
+        else if (strcmp(arg, "--kernel") == 0 && value)
+        {
+            options.kernel = find_kernel(value);
+            valid = options.kernel >= 0;
+            i++;
+        }
+        else if (strcmp(arg, "--threads") == 0 && value)
+        {
+            options.thread_count_len = parse_thread_list(value, options.thread_counts);
+            valid = options.thread_count_len > 0;
+            i++;
+        }
+        else if (strcmp(arg, "--peak-gops") == 0 && value)
+        {
+            options.peak_gops = strtod(value, &endptr);
+            valid = *endptr == '\0' && options.peak_gops > 0.0;
+            i++;
+        }
+        else if (strcmp(arg, "--reps") == 0 && value)
+        {
+            long reps = strtol(value, &endptr, 10);
+            valid = *endptr == '\0' && reps > 0;
+            if (valid)
+                config.repetitions = (size_t)reps;
+            i++;
+        }
+        else if (strcmp(arg, "--target-ms") == 0 && value)
+        {
+            double target_ms = strtod(value, &endptr);
+            valid = *endptr == '\0' && target_ms > 0.0;
+            if (valid)
+                config.target_time_sec = target_ms / 1000.0;
+            i++;
+        }
+        else if (strcmp(arg, "--cpu") == 0 && value)
+        {
+            if (strcmp(value, "none") == 0)
+                config.cpu = BENCH_CPU_NONE;
+            else if (strcmp(value, "auto") == 0)
+                config.cpu = BENCH_CPU_AUTO;
+            else
+            {
+                long cpu = strtol(value, &endptr, 10);
+                valid = *endptr == '\0' && cpu >= 0;
+                if (valid)
+                    config.cpu = (int)cpu;
+            }
+            i++;
+        }
+        else if (strcmp(arg, "--json") == 0 && value)
+        {
+            json_path = value;
+            i++;
+        }
+        else if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            valid = 0;
+        }
+
+        if (!valid)
+        {
+            printf("Invalid argument '%s'\n", arg);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (options.min_size > options.max_size)
+        options.min_size = options.max_size;
+
+    // Worker threads are pinned to the allowed CPUs in order; the list has to
+    // be read before the main thread pins itself to one of them
+    options.cpu_count = bench_allowed_cpus(options.cpus, MATRIX_MAX_THREADS);
+    if (config.cpu == BENCH_CPU_NONE)
+        options.cpu_count = 0;
+    if (options.thread_count_len == 0)
+    {
+        long available = options.cpu_count > 0 ? options.cpu_count : bench_online_cpu_count();
+        if (available > MATRIX_MAX_THREADS)
+            available = MATRIX_MAX_THREADS;
+        options.thread_counts[options.thread_count_len++] = 1;
+        if (available > 1)
+            options.thread_counts[options.thread_count_len++] = (size_t)available;
+    }
+
+    bench_harness_set_config(&config);
+    if (config.cpu != BENCH_CPU_NONE && bench_harness_pin() < 0)
+        printf("Warning: could not pin to a CPU, results may be noisier\n");
+
+    if (options.cpu_count > 0)
+    {
+        // Thread 0 is the main thread: move its CPU to the front of the list
+        int pinned = bench_harness_pinned_cpu();
+        for (int t = 1; t < options.cpu_count && pinned >= 0; t++)
+        {
+            if (options.cpus[t] == pinned)
+            {
+                options.cpus[t] = options.cpus[0];
+                options.cpus[0] = pinned;
+            }
+        }
+        // Threads beyond the allowed CPUs wrap around
+        for (int t = options.cpu_count; t < MATRIX_MAX_THREADS; t++)
+            options.cpus[t] = options.cpus[t % options.cpu_count];
+    }
+
+    if (json_path && bench_json_begin(json_path, argv[0]) != 0)
+    {
+        printf("Error: cannot write JSON results to '%s'\n", json_path);
+        return 1;
+    }
+
+    printf("Vedic Mathematics Matrix Benchmark\n");
+    printf("==================================\n\n");
+
+    if (options.peak_gops <= 0.0)
+    {
+        options.peak_gops = measure_peak_gops();
+        printf("Peak (in-L1 16x16->32-bit multiply-add, 1 thread): %.2f GOPS\n\n", options.peak_gops);
+    }
+    else
+    {
+        printf("Peak (given, per thread): %.2f GOPS\n\n", options.peak_gops);
+    }
+
+    size_t max_threads = 1;
+    for (size_t t = 0; t < options.thread_count_len; t++)
+    {
+        if (options.thread_counts[t] > max_threads)
+            max_threads = options.thread_counts[t];
+    }
+
+    int failures = 0;
+    srand(MATRIX_SEED);
+
+    for (size_t size = options.min_size; size <= options.max_size; size *= 2)
+    {
+        for (int shape = 0; shape < SHAPE_COUNT; shape++)
+        {
+            if (options.shape >= 0 && options.shape != shape)
+                continue;
+            for (int dist = 0; dist < DIST_COUNT; dist++)
+            {
+                if (options.dist >= 0 && options.dist != dist)
+                    continue;
+
+                size_t m, k, n;
+                shape_dimensions((MatrixShape)shape, size, &m, &k, &n);
+
+                MatrixProblem problem;
+                if (problem_alloc(&problem, m, k, n, max_threads) != 0)
+                {
+                    printf("Error: out of memory for %zux%zux%zu\n", m, k, n);
+                    problem_free(&problem);
+                    return 1;
+                }
+                fill_matrix((int64_t *)problem.a, m * k, (MatrixDistribution)dist);
+                fill_matrix((int64_t *)problem.b, k * n, (MatrixDistribution)dist);
+
+                for (size_t t = 0; t < options.thread_count_len; t++)
+                {
+                    size_t threads = options.thread_counts[t];
+                    if (threads > m)
+                        continue;
+                    if (threads > 1 && (double)m * (double)n * (double)k < MATRIX_MIN_PARALLEL_OPS)
+                        continue;
+                    failures += run_problem(&problem, (MatrixShape)shape, (MatrixDistribution)dist,
+                                            threads, &options);
+                }
+                problem_free(&problem);
+            }
+        }
+    }
+
+    if (json_path)
+    {
+        if (bench_json_end() != 0)
+        {
+            printf("Error: failed to write JSON results to '%s'\n", json_path);
+            return 1;
+        }
+        printf("JSON results written to %s\n", json_path);
+    }
+
+    if (failures > 0)
+    {
+        printf("%d product(s) failed verification\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,266 @@
+/**
+ * vedicmath_perf_counters.c - perf_event_open based counter groups
+ */
+#include "vedicmath_perf_counters.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define BENCH_HAVE_PERF_EVENTS 1
+#endif
+
+static const char *event_names[BENCH_PERF_EVENT_COUNT] = {
+    "cycles", "instructions", "branches", "branch-misses", "L1D-read-misses", "LLC-read-misses"};
+
+#ifdef BENCH_HAVE_PERF_EVENTS
+
+/**
+ * Fill the perf_event_attr for one of our events
+ */
+static void describe_event(BenchPerfEvent event, struct perf_event_attr *attr)
+{
+    memset(attr, 0, sizeof(*attr));
+    attr->size = sizeof(*attr);
+    attr->disabled = 1;
+    attr->exclude_kernel = 1; // Allowed with perf_event_paranoid <= 2
+    attr->exclude_hv = 1;
+    attr->read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    switch (event)
+    {
+    case BENCH_PERF_CYCLES:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case BENCH_PERF_INSTRUCTIONS:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case BENCH_PERF_BRANCHES:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS;
+        break;
+    case BENCH_PERF_BRANCH_MISSES:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case BENCH_PERF_L1D_MISSES:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = PERF_COUNT_HW_CACHE_L1D |
+                       (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case BENCH_PERF_LLC_MISSES:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = PERF_COUNT_HW_CACHE_LL |
+                       (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    default:
+        break;
+    }
+}
+
+static int perf_event_open(struct perf_event_attr *attr, int group_fd)
+{
+    // Current thread, any CPU
+    return (int)syscall(SYS_perf_event_open, attr, 0, -1, group_fd, 0);
+}
+
+#endif /* BENCH_HAVE_PERF_EVENTS */
+
+size_t bench_perf_open(BenchPerfCounters *counters)
+{
+    memset(counters, 0, sizeof(*counters));
+    counters->group_fd = -1;
+    for (int i = 0; i < BENCH_PERF_EVENT_COUNT; i++)
+        counters->fds[i] = -1;
+
+#ifdef BENCH_HAVE_PERF_EVENTS
+    for (int i = 0; i < BENCH_PERF_EVENT_COUNT; i++)
+    {
+        struct perf_event_attr attr;
+        describe_event((BenchPerfEvent)i, &attr);
+
+        int fd = perf_event_open(&attr, counters->group_fd);
+        if (fd < 0)
+        {
+            // Without a leader there is no group to attach the rest to
+            if (i == BENCH_PERF_CYCLES)
+                return 0;
+            continue;
+        }
+
+        if (ioctl(fd, PERF_EVENT_IOC_ID, &counters->ids[i]) != 0)
+        {
+            close(fd);
+            if (i == BENCH_PERF_CYCLES)
+                return 0;
+            continue;
+        }
+
+        counters->fds[i] = fd;
+        if (counters->group_fd < 0)
+            counters->group_fd = fd;
+        counters->open_count++;
+    }
+#endif
+
+    return counters->open_count;
+}
+
+void bench_perf_close(BenchPerfCounters *counters)
+{
+#ifdef BENCH_HAVE_PERF_EVENTS
+    // Close members before the leader
+    for (int i = BENCH_PERF_EVENT_COUNT - 1; i >= 0; i--)
+    {
+        if (counters->fds[i] >= 0)
+            close(counters->fds[i]);
+        counters->fds[i] = -1;
+    }
+#endif
+    counters->group_fd = -1;
+    counters->open_count = 0;
+}
+
+void bench_perf_start(BenchPerfCounters *counters)
+{
+#ifdef BENCH_HAVE_PERF_EVENTS
+    if (counters->group_fd < 0)
+        return;
+    ioctl(counters->group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(counters->group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#else
+    (void)counters;
+#endif
+}
+
+void bench_perf_stop(BenchPerfCounters *counters, BenchPerfSample *sample)
+{
+    memset(sample, 0, sizeof(*sample));
+    sample->multiplex_scale = 1.0;
+
+#ifdef BENCH_HAVE_PERF_EVENTS
+    if (counters->group_fd < 0)
+        return;
+    ioctl(counters->group_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // Layout for PERF_FORMAT_GROUP | ID | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING
+    struct
+    {
+        uint64_t nr;
+        uint64_t time_enabled;
+        uint64_t time_running;
+        struct
+        {
+            uint64_t value;
+            uint64_t id;
+        } values[BENCH_PERF_EVENT_COUNT];
+    } group_read;
+
+    ssize_t bytes = read(counters->group_fd, &group_read, sizeof(group_read));
+    if (bytes < (ssize_t)(3 * sizeof(uint64_t)) || group_read.time_running == 0)
+        return;
+
+    // Scale for multiplexing if the group did not run the whole time
+    sample->multiplex_scale = (double)group_read.time_enabled / (double)group_read.time_running;
+
+    for (uint64_t n = 0; n < group_read.nr && n < BENCH_PERF_EVENT_COUNT; n++)
+    {
+        for (int i = 0; i < BENCH_PERF_EVENT_COUNT; i++)
+        {
+            if (counters->fds[i] >= 0 && counters->ids[i] == group_read.values[n].id)
+            {
+                sample->values[i] = (uint64_t)((double)group_read.values[n].value * sample->multiplex_scale);
+                sample->valid[i] = true;
+                break;
+            }
+        }
+    }
+#else
+    (void)counters;
+#endif
+}
+
+BenchPerfSummary bench_perf_summarize(const BenchPerfSample *sample, double operations)
+{
+    BenchPerfSummary summary;
+    memset(&summary, 0, sizeof(summary));
+
+    if (!sample->valid[BENCH_PERF_CYCLES] || operations <= 0.0)
+        return summary;
+
+    double cycles = (double)sample->values[BENCH_PERF_CYCLES];
+    summary.available = true;
+    summary.cycles_per_op = cycles / operations;
+
+    if (sample->valid[BENCH_PERF_INSTRUCTIONS])
+    {
+        double instructions = (double)sample->values[BENCH_PERF_INSTRUCTIONS];
+        summary.instructions_per_op = instructions / operations;
+        summary.ipc = cycles > 0.0 ? instructions / cycles : 0.0;
+    }
+    if (sample->valid[BENCH_PERF_BRANCHES])
+        summary.branches_per_op = (double)sample->values[BENCH_PERF_BRANCHES] / operations;
+    if (sample->valid[BENCH_PERF_BRANCH_MISSES])
+        summary.branch_misses_per_op = (double)sample->values[BENCH_PERF_BRANCH_MISSES] / operations;
+    if (summary.branches_per_op > 0.0)
+        summary.branch_miss_rate = summary.branch_misses_per_op / summary.branches_per_op;
+    if (sample->valid[BENCH_PERF_L1D_MISSES])
+        summary.l1d_misses_per_op = (double)sample->values[BENCH_PERF_L1D_MISSES] / operations;
+    if (sample->valid[BENCH_PERF_LLC_MISSES])
+        summary.llc_misses_per_op = (double)sample->values[BENCH_PERF_LLC_MISSES] / operations;
+
+    return summary;
+}
+
+void bench_perf_print_summary(const BenchPerfSummary *summary, const char *indent)
+{
+    if (!summary->available)
+        return;
+
+    printf("%sIPC %.2f | %.2f cycles/op | %.2f instr/op | %.4f br-miss/op (%.2f%%) | %.4f L1D-miss/op | %.4f LLC-miss/op\n",
+           indent ? indent : "",
+           summary->ipc,
+           summary->cycles_per_op,
+           summary->instructions_per_op,
+           summary->branch_misses_per_op,
+           summary->branch_miss_rate * 100.0,
+           summary->l1d_misses_per_op,
+           summary->llc_misses_per_op);
+}
+
+BenchPerfCounters *bench_perf_shared(void)
+{
+    static BenchPerfCounters shared;
+    static int opened = 0;
+
+    if (!opened)
+    {
+        opened = 1;
+        size_t count = bench_perf_open(&shared);
+        if (count == 0)
+        {
+            printf("Hardware counters unavailable (perf_event_open failed or unsupported); "
+                   "reporting timings only\n");
+        }
+        else if (count < BENCH_PERF_EVENT_COUNT)
+        {
+            printf("Hardware counters: opened %zu of %d events (missing:", count, BENCH_PERF_EVENT_COUNT);
+            for (int i = 0; i < BENCH_PERF_EVENT_COUNT; i++)
+            {
+                if (shared.fds[i] < 0)
+                    printf(" %s", event_names[i]);
+            }
+            printf(")\n");
+        }
+    }
+
+    return &shared;
+}
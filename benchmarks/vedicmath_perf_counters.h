@@ -0,0 +1,117 @@
+/**
+ * vedicmath_perf_counters.h - Hardware performance counters for benchmarks
+ *
+ * Thin wrapper over Linux perf_event_open that opens cycles, instructions,
+ * branches, branch misses and L1D/LLC read misses as one counter group, so a timed
+ * region can be attributed to front-end (branch) or memory-side costs.
+ * Counters the kernel or PMU does not provide are skipped; on other
+ * platforms, or when perf is locked down, everything reports unavailable.
+ */
+
+ #ifndef VEDICMATH_PERF_COUNTERS_H
+ #define VEDICMATH_PERF_COUNTERS_H
+
+ #include <stdbool.h>
+ #include <stddef.h>
+ #include <stdint.h>
+
+ /**
+  * Counted events (group leader first)
+  */
+ typedef enum {
+     BENCH_PERF_CYCLES,
+     BENCH_PERF_INSTRUCTIONS,
+     BENCH_PERF_BRANCHES,
+     BENCH_PERF_BRANCH_MISSES,
+     BENCH_PERF_L1D_MISSES,
+     BENCH_PERF_LLC_MISSES,
+     BENCH_PERF_EVENT_COUNT
+ } BenchPerfEvent;
+
+ /**
+  * An open counter group
+  */
+ typedef struct {
+     int fds[BENCH_PERF_EVENT_COUNT];        // -1 for events that could not be opened
+     uint64_t ids[BENCH_PERF_EVENT_COUNT];   // Kernel ids used to match group reads
+     int group_fd;                           // Leader fd, -1 if no counters
+     size_t open_count;                      // Number of events opened
+ } BenchPerfCounters;
+
+ /**
+  * Raw counts of one measured region
+  */
+ typedef struct {
+     uint64_t values[BENCH_PERF_EVENT_COUNT];
+     bool valid[BENCH_PERF_EVENT_COUNT];
+     double multiplex_scale;                 // time_enabled / time_running (1.0 = not multiplexed)
+ } BenchPerfSample;
+
+ /**
+  * Per-operation view of a sample (fields are 0 when the event is missing)
+  */
+ typedef struct {
+     bool available;                         // At least cycles were counted
+     double ipc;                             // Instructions per cycle
+     double cycles_per_op;
+     double instructions_per_op;
+     double branches_per_op;
+     double branch_misses_per_op;
+     double branch_miss_rate;                // Misses / retired branches (0 if either is missing)
+     double l1d_misses_per_op;
+     double llc_misses_per_op;
+ } BenchPerfSummary;
+
+ /**
+  * Open the counter group for the calling thread
+  *
+  * @param counters Group to initialize
+  * @return Number of events opened (0 if counters are unavailable)
+  */
+ size_t bench_perf_open(BenchPerfCounters* counters);
+
+ /**
+  * Close all counters of a group
+  */
+ void bench_perf_close(BenchPerfCounters* counters);
+
+ /**
+  * Reset and enable the group (no-op if unavailable)
+  */
+ void bench_perf_start(BenchPerfCounters* counters);
+
+ /**
+  * Disable the group and read its counts
+  *
+  * @param counters Open group
+  * @param sample Output counts (all invalid if unavailable)
+  */
+ void bench_perf_stop(BenchPerfCounters* counters, BenchPerfSample* sample);
+
+ /**
+  * Turn raw counts into per-operation figures
+  *
+  * @param sample Raw counts
+  * @param operations Number of operations performed in the region
+  * @return Per-operation summary
+  */
+ BenchPerfSummary bench_perf_summarize(const BenchPerfSample* sample, double operations);
+
+ /**
+  * Print a one-line summary ("IPC ..., cycles/op ...") or nothing if the
+  * summary is unavailable
+  *
+  * @param summary Summary to print
+  * @param indent Prefix for the line
+  */
+ void bench_perf_print_summary(const BenchPerfSummary* summary, const char* indent);
+
+ /**
+  * Process-wide counter group shared by the benchmark drivers. Opened on
+  * first use; reports once on stdout if counters are unavailable.
+  *
+  * @return Shared group (never NULL)
+  */
+ BenchPerfCounters* bench_perf_shared(void);
+
+ #endif /* VEDICMATH_PERF_COUNTERS_H */
@@ -0,0 +1,645 @@
+/**
+ * vedicmath_scaling_benchmark.c - Multithreaded scaling benchmark
+ *
+ * Runs the dispatchers, the batch API, a small matrix product and the
+ * expression evaluators on 1, 2, 4, ... N threads at once. Every thread
+ * works on its own pre-generated operand pool, so any loss of throughput
+ * comes from state shared inside the library (global caches and counters,
+ * locks, the allocator) or from the machine itself. The inline
+ * "Standard multiply" workload touches no shared state and serves as the
+ * machine reference for the contention report.
+ *
+ * For every workload and thread count the benchmark reports aggregate and
+ * per-thread throughput, parallel efficiency (aggregate / (threads x
+ * single-thread)) and p50/p99 latency. Latency samples are taken per chunk
+ * of operations (about 2 us of single-threaded work) and normalized to ns
+ * per operation, so they show queueing/stall tails rather than the cost of
+ * individual sub-nanosecond operations.
+ *
+ * Usage: vedicmath_scaling_benchmark [--max-threads N] [--duration-ms MS]
+ *                                    [--reps N] [--workload NAME] [--no-pin]
+ *                                    [--json FILE]
+ */
+#include "vedicmath_bench_harness.h"
+#include "vedicmath_bench_json.h"
+#include "../include/vedicmath.h"
+#include "../include/vedicmath_types.h"
+#include "../include/vedicmath_dynamic.h"
+#include "../include/vedicmath_optimized.h"
+#include "../include/unified_adaptive_dispatcher.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCALING_SEED 20240501u
+#define SCALING_MAX_THREADS 256
+#define SCALING_MAX_COUNTS 16            // 1, 2, 4, ... plus the maximum
+#define SCALING_LATENCY_CAP 16384        // Latency samples kept per thread
+#define SCALING_CHUNK_TARGET_NS 2000.0   // Single-threaded cost of one chunk
+#define SCALING_BATCH_SIZE 256           // Elements per batch API call
+#define SCALING_MATRIX_N 16              // Matrix workload dimension
+#define SCALING_EXPRESSION_LEN 24
+
+// ============================================================================
+// PER-THREAD DATA AND WORKLOADS
+// ============================================================================
+
+/**
+ * One worker thread's data (never shared): the shared operand pools, then
+ * the inputs of the batch, matrix and expression workloads
+ */
+typedef struct
+{
+    BenchOperands operands;
+    VedicValue results[SCALING_BATCH_SIZE];
+    char expressions[BENCH_POOL_SIZE][SCALING_EXPRESSION_LEN];
+    long matrix_a[SCALING_MATRIX_N * SCALING_MATRIX_N];
+    long matrix_b[SCALING_MATRIX_N * SCALING_MATRIX_N];
+    long matrix_c[SCALING_MATRIX_N * SCALING_MATRIX_N];
+} ScalingThreadData;
+
+static void run_batch_multiply(BenchOperands *operands)
+{
+    ScalingThreadData *data = (ScalingThreadData *)operands;
+    size_t start = (operands->cursor * SCALING_BATCH_SIZE) & BENCH_POOL_MASK;
+    operands->cursor++;
+    vedic_optimized_multiply_batch(data->results, &operands->va[start], &operands->vb[start], SCALING_BATCH_SIZE);
+    BENCH_CLOBBER_MEMORY();
+}
+
+static void run_matrix_multiply(BenchOperands *operands)
+{
+    ScalingThreadData *data = (ScalingThreadData *)operands;
+    const size_t n = SCALING_MATRIX_N;
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+        {
+            long sum = 0;
+            for (size_t k = 0; k < n; k++)
+                sum += vedic_multiply(data->matrix_a[i * n + k], data->matrix_b[k * n + j]);
+            data->matrix_c[i * n + j] = sum;
+        }
+    }
+    BENCH_CLOBBER_MEMORY();
+}
+
+static void run_dynamic_evaluate(BenchOperands *operands)
+{
+    ScalingThreadData *data = (ScalingThreadData *)operands;
+    VedicValue result = vedic_dynamic_evaluate(data->expressions[operands->cursor++ & BENCH_POOL_MASK]);
+    BENCH_DO_NOT_OPTIMIZE(result);
+}
+
+static void run_optimized_evaluate(BenchOperands *operands)
+{
+    ScalingThreadData *data = (ScalingThreadData *)operands;
+    VedicValue result = vedic_optimized_evaluate(data->expressions[operands->cursor++ & BENCH_POOL_MASK]);
+    BENCH_DO_NOT_OPTIMIZE(result);
+}
+
+// This benchmark's own workloads, after the shared multiply ones
+static const BenchWorkload scaling_workloads[] = {
+    {"Optimized batch", "none (below the pool grain, runs inline)", SCALING_BATCH_SIZE, NULL, run_batch_multiply},
+    {"Matrix 16x16", "allocator (urdhva_mult buffers)", SCALING_MATRIX_N * SCALING_MATRIX_N * SCALING_MATRIX_N,
+     NULL, run_matrix_multiply},
+    {"Dynamic evaluate", "none known", 1, NULL, run_dynamic_evaluate},
+    {"Optimized evaluate", "expression cache lock, strdup/free on miss", 1, NULL, run_optimized_evaluate},
+};
+
+#define WORKLOAD_COUNT (BENCH_MULTIPLY_WORKLOAD_COUNT + sizeof(scaling_workloads) / sizeof(scaling_workloads[0]))
+
+static const BenchWorkload *workload_at(size_t index)
+{
+    return index < BENCH_MULTIPLY_WORKLOAD_COUNT ? &bench_multiply_workloads[index]
+                                                 : &scaling_workloads[index - BENCH_MULTIPLY_WORKLOAD_COUNT];
+}
+
+/**
+ * Fill a thread's pools; the expressions and matrices reuse its operands
+ */
+static void thread_data_init(ScalingThreadData *data, unsigned thread_index)
+{
+    static const char ops[] = {'+', '-', '*', '/', '%'};
+    unsigned state = SCALING_SEED + 7919u * thread_index;
+    BenchOperands *operands = &data->operands;
+
+    bench_operands_fill(operands, thread_index);
+    for (size_t i = 0; i < BENCH_POOL_SIZE; i++)
+    {
+        snprintf(data->expressions[i], SCALING_EXPRESSION_LEN, "%d %c %d",
+                 operands->a[i], ops[bench_next_random(&state) % 5], operands->b[i]);
+    }
+    for (size_t i = 0; i < SCALING_MATRIX_N * SCALING_MATRIX_N; i++)
+    {
+        data->matrix_a[i] = operands->a[i];
+        data->matrix_b[i] = operands->b[i];
+    }
+}
+
+// ============================================================================
+// WORKER THREADS
+// ============================================================================
+
+typedef struct
+{
+    const BenchWorkload *workload;
+    ScalingThreadData *data;
+    int cpu;                        // CPU to pin to, -1 for none
+    size_t chunk_calls;             // run() calls per timed chunk
+    const uint64_t *deadline_ns;    // Common end of the run, valid once go is set
+    volatile long *ready;
+    volatile long *go;
+
+    // Outputs
+    size_t operations;
+    uint64_t end_ns;                // End of this thread's last chunk
+    double *latencies;              // ns/op per chunk (reservoir sample)
+    size_t latency_count;
+    size_t chunks_seen;
+    unsigned reservoir_state;
+} ScalingWorker;
+
+static void record_latency(ScalingWorker *worker, double ns_per_op)
+{
+    worker->chunks_seen++;
+    if (worker->latency_count < SCALING_LATENCY_CAP)
+    {
+        worker->latencies[worker->latency_count++] = ns_per_op;
+        return;
+    }
+
+    // Reservoir sampling keeps a uniform sample of all chunks
+    size_t slot = ((size_t)bench_next_random(&worker->reservoir_state) << 8 |
+                   (bench_next_random(&worker->reservoir_state) & 0xFF)) % worker->chunks_seen;
+    if (slot < SCALING_LATENCY_CAP)
+        worker->latencies[slot] = ns_per_op;
+}
+
+static void worker_main(void *arg)
+{
+    ScalingWorker *worker = (ScalingWorker *)arg;
+    if (worker->cpu >= 0)
+        bench_pin_to_cpu(worker->cpu);
+
+    const BenchWorkload *workload = worker->workload;
+    ScalingThreadData *data = worker->data;
+    size_t ops_per_chunk = worker->chunk_calls * workload->ops_per_call;
+
+    // Start all threads together
+    BENCH_ATOMIC_INC(worker->ready);
+    while (!BENCH_ATOMIC_LOAD(worker->go))
+        BENCH_YIELD();
+
+    // All threads stop at the same deadline, so time-sliced threads on an
+    // oversubscribed machine do not each get a full window of their own
+    uint64_t deadline = *worker->deadline_ns;
+    uint64_t now = bench_now_ns();
+
+    do
+    {
+        uint64_t chunk_start = now;
+        for (size_t call = 0; call < worker->chunk_calls; call++)
+            workload->run(&data->operands);
+        now = bench_now_ns();
+
+        worker->operations += ops_per_chunk;
+        record_latency(worker, (double)(now - chunk_start) / (double)ops_per_chunk);
+    } while (now < deadline);
+
+    worker->end_ns = now;
+}
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+
+/**
+ * Result of one workload at one thread count (medians over repetitions)
+ */
+typedef struct
+{
+    size_t threads;
+    double aggregate_ops;            // Operations per second, all threads
+    double per_thread_mean;          // Operations per second per thread
+    double per_thread_min;
+    double per_thread_max;
+    double efficiency;               // aggregate / (threads x single-thread)
+    double p50_ns;                   // Chunk latency, ns per operation
+    double p99_ns;
+} ScalingPoint;
+
+typedef struct
+{
+    int pin;
+    int cpus[SCALING_MAX_THREADS];
+    int cpu_count;
+    uint64_t duration_ns;
+    size_t repetitions;
+} ScalingOptions;
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(double *values, size_t count, double fraction)
+{
+    if (count == 0)
+        return 0.0;
+    qsort(values, count, sizeof(double), compare_doubles);
+    size_t index = (size_t)(fraction * (double)(count - 1) + 0.5);
+    return values[index];
+}
+
+/**
+ * Pick the number of run() calls per chunk from a short single-threaded run
+ */
+static size_t calibrate_chunk(const BenchWorkload *workload, ScalingThreadData *data)
+{
+    size_t calls = 1;
+    for (;;)
+    {
+        uint64_t start = bench_now_ns();
+        for (size_t i = 0; i < calls; i++)
+            workload->run(&data->operands);
+        double elapsed = (double)(bench_now_ns() - start);
+
+        if (elapsed >= SCALING_CHUNK_TARGET_NS * 4.0 || calls >= ((size_t)1 << 20))
+        {
+            size_t chunk = (size_t)((double)calls * SCALING_CHUNK_TARGET_NS / (elapsed > 0.0 ? elapsed : 1.0));
+            return chunk > 0 ? chunk : 1;
+        }
+        calls *= 2;
+    }
+}
+
+/**
+ * Run one workload on `threads` threads for `repetitions` repetitions
+ *
+ * @param samples_ns Output: wall ns per operation (all threads) of each repetition
+ * @return Median-repetition figures, or threads == 0 on failure
+ */
+static ScalingPoint run_scaling_point(const BenchWorkload *workload, size_t threads,
+                                      ScalingThreadData **thread_data, size_t chunk_calls,
+                                      const ScalingOptions *options, double *samples_ns)
+{
+    ScalingPoint point;
+    memset(&point, 0, sizeof(point));
+
+    ScalingWorker *workers = calloc(threads, sizeof(ScalingWorker));
+    bench_thread_t *handles = calloc(threads, sizeof(bench_thread_t));
+    double *merged = malloc(threads * SCALING_LATENCY_CAP * sizeof(double));
+    double aggregate[BENCH_MAX_REPETITIONS];
+    double per_thread_mean[BENCH_MAX_REPETITIONS];
+    double per_thread_min[BENCH_MAX_REPETITIONS];
+    double per_thread_max[BENCH_MAX_REPETITIONS];
+    size_t merged_count = 0;
+
+    if (!workers || !handles || !merged)
+        goto done;
+    for (size_t t = 0; t < threads; t++)
+    {
+        workers[t].latencies = malloc(SCALING_LATENCY_CAP * sizeof(double));
+        if (!workers[t].latencies)
+            goto done;
+    }
+
+    for (size_t rep = 0; rep < options->repetitions; rep++)
+    {
+        volatile long ready = 0;
+        volatile long go = 0;
+        uint64_t deadline_ns = 0;
+        size_t started = 0;
+
+        if (workload->prepare)
+            workload->prepare();
+
+        for (size_t t = 0; t < threads; t++)
+        {
+            ScalingWorker *worker = &workers[t];
+            double *latencies = worker->latencies;
+            memset(worker, 0, sizeof(*worker));
+            worker->latencies = latencies;
+            worker->workload = workload;
+            worker->data = thread_data[t];
+            worker->cpu = (options->pin && options->cpu_count > 0) ? options->cpus[t % (size_t)options->cpu_count] : -1;
+            worker->chunk_calls = chunk_calls;
+            worker->deadline_ns = &deadline_ns;
+            worker->ready = &ready;
+            worker->go = &go;
+            worker->reservoir_state = SCALING_SEED + (unsigned)t;
+
+            if (bench_thread_start(&handles[t], worker_main, worker) != 0)
+                break;
+            started++;
+        }
+
+        // Release the workers once all of them are waiting
+        while ((size_t)BENCH_ATOMIC_LOAD(&ready) < started)
+            BENCH_YIELD();
+        uint64_t release_ns = bench_now_ns();
+        deadline_ns = release_ns + options->duration_ns;
+        BENCH_ATOMIC_STORE(&go, 1);
+
+        for (size_t t = 0; t < started; t++)
+            bench_thread_join(handles[t]);
+        if (started < threads)
+        {
+            printf("  failed to start %zu threads\n", threads);
+            goto done;
+        }
+
+        // Throughput is measured over the common window from release to
+        // the last thread finishing its final chunk
+        size_t total_ops = 0;
+        uint64_t wall_ns = 0;
+        for (size_t t = 0; t < threads; t++)
+        {
+            total_ops += workers[t].operations;
+            if (workers[t].end_ns - release_ns > wall_ns)
+                wall_ns = workers[t].end_ns - release_ns;
+        }
+
+        per_thread_min[rep] = 0.0;
+        per_thread_max[rep] = 0.0;
+        per_thread_mean[rep] = 0.0;
+        for (size_t t = 0; t < threads; t++)
+        {
+            ScalingWorker *worker = &workers[t];
+            double rate = wall_ns > 0 ? (double)worker->operations * 1e9 / (double)wall_ns : 0.0;
+
+            per_thread_mean[rep] += rate / (double)threads;
+            if (t == 0 || rate < per_thread_min[rep])
+                per_thread_min[rep] = rate;
+            if (rate > per_thread_max[rep])
+                per_thread_max[rep] = rate;
+
+            // Every repetition contributes an even share of the merged
+            // latency buffer (the reservoir is already a uniform sample)
+            size_t keep = SCALING_LATENCY_CAP / options->repetitions;
+            size_t stride = worker->latency_count > keep ? worker->latency_count / keep : 1;
+            for (size_t s = 0; s < worker->latency_count && merged_count < threads * SCALING_LATENCY_CAP; s += stride)
+                merged[merged_count++] = worker->latencies[s];
+        }
+
+        aggregate[rep] = wall_ns > 0 ? (double)total_ops * 1e9 / (double)wall_ns : 0.0;
+        samples_ns[rep] = aggregate[rep] > 0.0 ? 1e9 / aggregate[rep] : 0.0;
+    }
+
+    point.threads = threads;
+    point.aggregate_ops = bench_summarize(aggregate, options->repetitions).median;
+    point.per_thread_mean = bench_summarize(per_thread_mean, options->repetitions).median;
+    point.per_thread_min = bench_summarize(per_thread_min, options->repetitions).median;
+    point.per_thread_max = bench_summarize(per_thread_max, options->repetitions).median;
+    point.p50_ns = percentile(merged, merged_count, 0.50);
+    point.p99_ns = percentile(merged, merged_count, 0.99);
+
+done:
+    if (workers)
+    {
+        for (size_t t = 0; t < threads; t++)
+            free(workers[t].latencies);
+    }
+    free(workers);
+    free(handles);
+    free(merged);
+    return point;
+}
+
+// ============================================================================
+// REPORTING
+// ============================================================================
+
+static void print_point(const ScalingPoint *point)
+{
+    printf("  %3zu threads: %14.0f ops/s total | per thread %12.0f (min %12.0f, max %12.0f) | "
+           "efficiency %5.1f%% | p50 %9.2f ns/op, p99 %9.2f ns/op\n",
+           point->threads,
+           point->aggregate_ops,
+           point->per_thread_mean,
+           point->per_thread_min,
+           point->per_thread_max,
+           point->efficiency * 100.0,
+           point->p50_ns,
+           point->p99_ns);
+}
+
+/**
+ * Compare each workload's efficiency at the largest thread count with the
+ * reference workload, which only suffers from machine effects (SMT, turbo,
+ * memory bandwidth)
+ */
+static void print_contention_report(ScalingPoint points[][SCALING_MAX_COUNTS], const int *selected,
+                                    size_t count_index)
+{
+    const ScalingPoint *reference = &points[0][count_index];
+    if (!selected[0] || reference->threads < 2)
+    {
+        printf("\n=== Contention Report ===\n");
+        printf("Needs the Standard multiply reference and at least 2 threads (use --max-threads).\n");
+        return;
+    }
+
+    printf("\n=== Contention Report (%zu threads) ===\n", reference->threads);
+    printf("Reference efficiency (Standard multiply): %.1f%%\n\n", reference->efficiency * 100.0);
+    printf("%-24s %10s %10s %10s %11s  %-12s %s\n",
+           "Workload", "Efficiency", "Relative", "Fairness", "p99 growth", "Verdict", "Shared state");
+
+    for (size_t w = 1; w < WORKLOAD_COUNT; w++)
+    {
+        if (!selected[w])
+            continue;
+
+        const ScalingPoint *single = &points[w][0];
+        const ScalingPoint *point = &points[w][count_index];
+        double relative = reference->efficiency > 0.0 ? point->efficiency / reference->efficiency : 0.0;
+        double fairness = point->per_thread_max > 0.0 ? point->per_thread_min / point->per_thread_max : 0.0;
+        double p99_growth = single->p99_ns > 0.0 ? point->p99_ns / single->p99_ns : 0.0;
+        const char *verdict = relative >= 0.9 ? "scales" : relative >= 0.6 ? "degraded" : "contended";
+
+        printf("%-24s %9.1f%% %9.1f%% %9.2f %10.2fx  %-12s %s\n",
+               workload_at(w)->name, point->efficiency * 100.0, relative * 100.0,
+               fairness, p99_growth, verdict, workload_at(w)->shared_state);
+    }
+
+    printf("\nRelative = efficiency / reference efficiency; fairness = slowest / fastest thread.\n");
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void print_usage(const char *program)
+{
+    printf("Usage: %s [--max-threads N] [--duration-ms MS] [--reps N] [--workload NAME] [--no-pin] [--json FILE]\n",
+           program);
+}
+
+int main(int argc, char *argv[])
+{
+    ScalingOptions options;
+    memset(&options, 0, sizeof(options));
+    options.pin = 1;
+    options.duration_ns = 100000000ull;
+    options.repetitions = 3;
+
+    long max_threads = 0;
+    const char *filter = NULL;
+    const char *json_path = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--max-threads") == 0 && value)
+        {
+            max_threads = atol(value);
+            i++;
+        }
+        else if (strcmp(argv[i], "--duration-ms") == 0 && value)
+        {
+            double ms = atof(value);
+            if (ms > 0.0)
+                options.duration_ns = (uint64_t)(ms * 1e6);
+            i++;
+        }
+        else if (strcmp(argv[i], "--reps") == 0 && value)
+        {
+            long reps = atol(value);
+            if (reps > 0)
+                options.repetitions = (size_t)(reps < BENCH_MAX_REPETITIONS ? reps : BENCH_MAX_REPETITIONS);
+            i++;
+        }
+        else if (strcmp(argv[i], "--workload") == 0 && value)
+        {
+            filter = value;
+            i++;
+        }
+        else if (strcmp(argv[i], "--json") == 0 && value)
+        {
+            json_path = value;
+            i++;
+        }
+        else if (strcmp(argv[i], "--no-pin") == 0)
+        {
+            options.pin = 0;
+        }
+        else
+        {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    options.cpu_count = bench_allowed_cpus(options.cpus, SCALING_MAX_THREADS);
+    long available = options.cpu_count > 0 ? options.cpu_count : bench_online_cpu_count();
+    if (max_threads <= 0)
+        max_threads = available;
+    if (max_threads > SCALING_MAX_THREADS)
+        max_threads = SCALING_MAX_THREADS;
+
+    // Thread counts: powers of two plus the maximum
+    size_t counts[SCALING_MAX_COUNTS];
+    size_t count_total = 0;
+    for (size_t n = 1; n < (size_t)max_threads && count_total < SCALING_MAX_COUNTS - 1; n *= 2)
+        counts[count_total++] = n;
+    counts[count_total++] = (size_t)max_threads;
+
+    // Harness settings double as the JSON environment block
+    BenchHarnessConfig harness;
+    bench_harness_default_config(&harness);
+    harness.repetitions = options.repetitions;
+    harness.target_time_sec = (double)options.duration_ns / 1e9;
+    harness.cpu = BENCH_CPU_NONE;
+    bench_harness_set_config(&harness);
+
+    if (json_path && bench_json_begin(json_path, argv[0]) != 0)
+    {
+        printf("Error: cannot write JSON results to '%s'\n", json_path);
+        return 1;
+    }
+
+    printf("Vedic Mathematics Library Scaling Benchmark\n");
+    printf("===========================================\n");
+    printf("%ld CPUs available, up to %ld threads, %.0f ms per run, %zu repetitions, %s\n",
+           available, max_threads, (double)options.duration_ns / 1e6, options.repetitions,
+           options.pin ? "one CPU per thread" : "unpinned");
+    if (max_threads > available)
+        printf("Warning: more threads than CPUs, results include oversubscription\n");
+
+    // Shared library state is set up once, outside any timed region
+    vedic_optimized_init();
+    UnifiedDispatchConfig unified_config = unified_dispatch_get_preset_config("embedded");
+    unified_config.enable_learning = false;
+    unified_config.enable_dataset_logging = false;
+    unified_config.enable_system_monitoring = false;
+    unified_dispatch_init(&unified_config);
+
+    ScalingThreadData **thread_data = calloc((size_t)max_threads, sizeof(ScalingThreadData *));
+    if (!thread_data)
+        return 1;
+    for (long t = 0; t < max_threads; t++)
+    {
+        thread_data[t] = malloc(sizeof(ScalingThreadData));
+        if (!thread_data[t])
+        {
+            printf("Memory allocation failed\n");
+            return 1;
+        }
+        thread_data_init(thread_data[t], (unsigned)t);
+    }
+
+    static ScalingPoint points[WORKLOAD_COUNT][SCALING_MAX_COUNTS];
+    int selected[WORKLOAD_COUNT];
+    double samples_ns[BENCH_MAX_REPETITIONS];
+
+    for (size_t w = 0; w < WORKLOAD_COUNT; w++)
+    {
+        const BenchWorkload *workload = workload_at(w);
+        selected[w] = !filter || strstr(workload->name, filter) != NULL || w == 0;
+        if (!selected[w])
+            continue;
+
+        if (workload->prepare)
+            workload->prepare();
+        size_t chunk_calls = calibrate_chunk(workload, thread_data[0]);
+
+        printf("\n=== %s (%zu ops per chunk) ===\n", workload->name, chunk_calls * workload->ops_per_call);
+        for (size_t c = 0; c < count_total; c++)
+        {
+            ScalingPoint point = run_scaling_point(workload, counts[c], thread_data, chunk_calls,
+                                                   &options, samples_ns);
+            if (point.threads == 0)
+                continue;
+
+            double single = points[w][0].aggregate_ops > 0.0 ? points[w][0].aggregate_ops : point.aggregate_ops;
+            point.efficiency = single > 0.0 ? point.aggregate_ops / ((double)point.threads * single) : 0.0;
+            points[w][c] = point;
+            print_point(&point);
+
+            char implementation[32];
+            snprintf(implementation, sizeof(implementation), "%zu threads", point.threads);
+            bench_json_record(workload->name, implementation, samples_ns, options.repetitions, 0, NULL);
+        }
+    }
+
+    print_contention_report(points, selected, count_total - 1);
+
+    for (long t = 0; t < max_threads; t++)
+        free(thread_data[t]);
+    free(thread_data);
+    vedic_optimized_cleanup();
+
+    if (json_path)
+    {
+        if (bench_json_end() != 0)
+        {
+            printf("Error: failed to write JSON results to '%s'\n", json_path);
+            return 1;
+        }
+        printf("JSON results written to %s\n", json_path);
+    }
+
+    return 0;
+}
@@ -0,0 +1,783 @@
+/**
+ * vedicmath_sutra_benchmark.c - Per-sutra kernel microbenchmarks
+ *
+ * Calls every sutra function directly, with no dispatcher or pattern
+ * detection in between, on pre-generated inputs that lie in the sutra's
+ * own domain (numbers ending in 5 for Ekadhikena, pairs just below a power
+ * of 10 for Nikhilam, 2-digit divisors for Paravartya, ...). Each sutra is
+ * measured for every operand digit length it supports, next to the native
+ * C operation on the same pool (a * b, n * n, / and %, or % == 0).
+ *
+ * Every generated input is checked against the native result before it is
+ * admitted to the pool; inputs the sutra gets wrong are dropped and
+ * counted. Costs are reported in ns/op and cycles/op: cycles come from the
+ * hardware counters when perf is available, otherwise from the measured
+ * clock rate (bench_cycles_per_ns). Package energy per operation is added
+ * when the RAPL counters are readable. The summary lists, for each sutra, the
+ * digit lengths at which it beats the native operation; those are the
+ * lengths a dispatcher threshold may route to it.
+ *
+ * Usage: vedicmath_sutra_benchmark [--sutra NAME] [--max-digits N]
+ *                                  [--reps N] [--target-ms MS]
+ *                                  [--cpu N|auto|none] [--json FILE]
+ */
+#include "vedicmath_benchmark.h"
+#include "../include/vedicmath.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SUTRA_SEED 20240501u
+#define SUTRA_MAX_DIGITS 19
+#define SUTRA_GENERATE_ATTEMPTS 64   // Candidates tried per pool slot
+#define SUTRA_SLOW_NS 10000.0        // Longer digit lengths are skipped past this
+
+/**
+ * Pre-generated inputs of one sutra at one digit length
+ */
+typedef struct
+{
+    long a[BENCH_POOL_SIZE];
+    long b[BENCH_POOL_SIZE];
+    int c[BENCH_POOL_SIZE];          // Prime or scale, where the sutra takes one
+    int64_t wide_a[BENCH_POOL_SIZE]; // a and b for the batch kernels
+    int64_t wide_b[BENCH_POOL_SIZE];
+    int64_t out[BENCH_POOL_SIZE];    // Batch kernel results
+} SutraPool;
+
+typedef enum
+{
+    KIND_MULTIPLY,                   // Native: a * b
+    KIND_SQUARE,                     // Native: a * a
+    KIND_DIVIDE,                     // Native: a / b and a % b
+    KIND_DIVISIBILITY                // Native: a % c == 0
+} SutraKind;
+
+/**
+ * One sutra kernel
+ */
+typedef struct
+{
+    const char *function;            // Library function measured
+    const char *domain;              // Inputs generated for it
+    SutraKind kind;
+    int min_digits;
+    int max_digits;                  // Before the range limit of long/int
+    void (*generate)(int digits, long *a, long *b, int *c);
+    long (*call)(long a, long b, int c, long *remainder);
+    int (*bench)(size_t iterations, void *data);
+} SutraSpec;
+
+// ============================================================================
+// INPUT GENERATION
+// ============================================================================
+
+static long power_of_10(int digits)
+{
+    long value = 1;
+    for (int i = 0; i < digits; i++)
+        value *= 10;
+    return value;
+}
+
+/**
+ * Uniform value in [low, high] (rand() only guarantees 15 bits)
+ */
+static long random_range(long low, long high)
+{
+    uint64_t r = ((uint64_t)rand() << 45) ^ ((uint64_t)rand() << 30) ^
+                 ((uint64_t)rand() << 15) ^ (uint64_t)rand();
+    return low + (long)(r % (uint64_t)(high - low + 1));
+}
+
+static long random_digits(int digits)
+{
+    return digits <= 1 ? random_range(1, 9) : random_range(power_of_10(digits - 1), power_of_10(digits) - 1);
+}
+
+static long isqrt(long n)
+{
+    long root = 0;
+    while ((root + 1) * (root + 1) <= n)
+        root++;
+    return root;
+}
+
+/**
+ * Deficiency from 10^digits whose square still fits the right part
+ */
+static long random_deficiency(int digits)
+{
+    long limit = isqrt(power_of_10(digits)) - 1;
+    return random_range(1, limit > 1 ? limit : 1);
+}
+
+static void generate_ekadhikena(int digits, long *a, long *b, int *c)
+{
+    (void)b;
+    (void)c;
+    *a = digits <= 1 ? 5 : random_digits(digits - 1) * 10 + 5;
+}
+
+static void generate_nikhilam(int digits, long *a, long *b, int *c)
+{
+    (void)c;
+    long base = power_of_10(digits);
+    *a = base - random_deficiency(digits);
+    *b = base - random_deficiency(digits);
+}
+
+static void generate_antyayordasake(int digits, long *a, long *b, int *c)
+{
+    (void)c;
+    long prefix = random_digits(digits - 1);
+    long last = random_range(1, 9);
+    *a = prefix * 10 + last;
+    *b = prefix * 10 + (10 - last);
+}
+
+static void generate_urdhva(int digits, long *a, long *b, int *c)
+{
+    (void)c;
+    *a = random_digits(digits);
+    *b = random_digits(digits);
+}
+
+static void generate_yaavadunam(int digits, long *a, long *b, int *c)
+{
+    (void)c;
+    *b = power_of_10(digits);
+    *a = *b - random_deficiency(digits);
+}
+
+static void generate_dwandwa(int digits, long *a, long *b, int *c)
+{
+    (void)b;
+    (void)c;
+    *a = random_digits(digits);
+}
+
+static void generate_ekanyunena(int digits, long *a, long *b, int *c)
+{
+    (void)c;
+    long base = power_of_10(digits);
+    *a = random_range(base - base / 10 + 1, base - 1);
+    *b = base - 1;
+}
+
+static void generate_anurupyena(int digits, long *a, long *b, int *c)
+{
+    static const int scales[] = {2, 4, 5, 8, 25, 50};
+    int scale = scales[rand() % (int)(sizeof(scales) / sizeof(scales[0]))];
+    long low = (power_of_10(digits - 1) + scale - 1) / scale;
+    long high = (power_of_10(digits) - 1) / scale;
+    *a = scale * random_range(low, high);
+    *b = scale * random_range(low, high);
+    *c = scale;
+}
+
+static void generate_paravartya(int digits, long *a, long *b, int *c)
+{
+    (void)c;
+    *a = random_digits(digits);
+    *b = random_range(10, 99);
+}
+
+static void generate_dhvajanka(int digits, long *a, long *b, int *c)
+{
+    (void)c;
+    int divisor_digits = digits / 3 > 2 ? digits / 3 : 2;
+    *a = random_digits(digits);
+    *b = random_digits(divisor_digits);
+}
+
+static void generate_nikhilam_division(int digits, long *a, long *b, int *c)
+{
+    (void)c;
+    int divisor_digits = digits / 3 > 1 ? digits / 3 : 1;
+    long base = power_of_10(divisor_digits);
+    long spread = base / 5 > 1 ? base / 5 : 1;
+    long deviation = random_range(1, spread);
+    *a = random_digits(digits);
+    *b = rand() % 2 ? base - deviation : base + deviation;
+}
+
+static const int vestanam_primes[] = {7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53};
+#define VESTANAM_PRIME_COUNT (sizeof(vestanam_primes) / sizeof(vestanam_primes[0]))
+
+static void generate_vestanam(int digits, long *a, long *b, int *c)
+{
+    (void)b;
+    int prime = vestanam_primes[rand() % (int)VESTANAM_PRIME_COUNT];
+    long number = random_digits(digits);
+    // Half of the numbers are multiples, so both outcomes are measured
+    if (rand() % 2)
+        number -= number % prime;
+    *a = number > 0 ? number : prime;
+    *c = prime;
+}
+
+// ============================================================================
+// CALLS (verification) AND TIMED LOOPS
+// ============================================================================
+
+static long call_ekadhikena(long a, long b, int c, long *remainder)
+{
+    (void)b, (void)c, (void)remainder;
+    return ekadhikena_purvena(a);
+}
+
+static long call_nikhilam(long a, long b, int c, long *remainder)
+{
+    (void)c, (void)remainder;
+    return nikhilam_mul(a, b);
+}
+
+static long call_antyayordasake(long a, long b, int c, long *remainder)
+{
+    (void)c, (void)remainder;
+    return antya_dasake_mul((int)a, (int)b);
+}
+
+static long call_urdhva(long a, long b, int c, long *remainder)
+{
+    (void)c, (void)remainder;
+    return urdhva_mult(a, b);
+}
+
+static long call_yaavadunam(long a, long b, int c, long *remainder)
+{
+    (void)c, (void)remainder;
+    return yaavadunam_square(a, b);
+}
+
+static long call_dwandwa(long a, long b, int c, long *remainder)
+{
+    (void)b, (void)c, (void)remainder;
+    return dwandwa_square(a);
+}
+
+static long call_ekanyunena(long a, long b, int c, long *remainder)
+{
+    (void)c, (void)remainder;
+    return ekanyunena_purvena_mul(a, b);
+}
+
+static long call_anurupyena(long a, long b, int c, long *remainder)
+{
+    (void)remainder;
+    return anurupyena_mul(a, b, c);
+}
+
+static long call_paravartya(long a, long b, int c, long *remainder)
+{
+    (void)c;
+    return paravartya_divide(a, b, remainder);
+}
+
+static long call_dhvajanka(long a, long b, int c, long *remainder)
+{
+    (void)c;
+    return dhvajanka_divide(a, b, remainder);
+}
+
+static long call_nikhilam_division(long a, long b, int c, long *remainder)
+{
+    (void)c;
+    return nikhilam_divide_sutra(a, b, remainder);
+}
+
+static long call_vestanam(long a, long b, int c, long *remainder)
+{
+    (void)b, (void)remainder;
+    return vestanam_divisibility(a, c);
+}
+
+/**
+ * Timed loop over a pool; expr may use pool, j and remainder
+ */
+#define SUTRA_LOOP(function_name, expr)                         \
+    static int function_name(size_t iterations, void *data)     \
+    {                                                           \
+        const SutraPool *pool = (const SutraPool *)data;        \
+        long remainder = 0;                                     \
+        for (size_t i = 0; i < iterations; i++)                 \
+        {                                                       \
+            size_t j = i & BENCH_POOL_MASK;                     \
+            long result = (expr);                               \
+            BENCH_DO_NOT_OPTIMIZE(result);                      \
+            BENCH_DO_NOT_OPTIMIZE(remainder);                   \
+        }                                                       \
+        return 1;                                               \
+    }
+
+SUTRA_LOOP(bench_ekadhikena, ekadhikena_purvena(pool->a[j]))
+SUTRA_LOOP(bench_nikhilam, nikhilam_mul(pool->a[j], pool->b[j]))
+SUTRA_LOOP(bench_antyayordasake, antya_dasake_mul((int)pool->a[j], (int)pool->b[j]))
+SUTRA_LOOP(bench_urdhva, urdhva_mult(pool->a[j], pool->b[j]))
+SUTRA_LOOP(bench_yaavadunam, yaavadunam_square(pool->a[j], pool->b[j]))
+SUTRA_LOOP(bench_dwandwa, dwandwa_square(pool->a[j]))
+SUTRA_LOOP(bench_ekanyunena, ekanyunena_purvena_mul(pool->a[j], pool->b[j]))
+SUTRA_LOOP(bench_anurupyena, anurupyena_mul(pool->a[j], pool->b[j], pool->c[j]))
+SUTRA_LOOP(bench_paravartya, paravartya_divide(pool->a[j], pool->b[j], &remainder))
+SUTRA_LOOP(bench_dhvajanka, dhvajanka_divide(pool->a[j], pool->b[j], &remainder))
+SUTRA_LOOP(bench_nikhilam_division, nikhilam_divide_sutra(pool->a[j], pool->b[j], &remainder))
+SUTRA_LOOP(bench_vestanam, vestanam_divisibility(pool->a[j], pool->c[j]))
+
+/**
+ * Timed loop over a pool through a batch kernel, a pool (or less) per call;
+ * call may use pool and count
+ */
+#define SUTRA_BATCH_LOOP(function_name, call)                                   \
+    static int function_name(size_t iterations, void *data)                     \
+    {                                                                           \
+        SutraPool *pool = (SutraPool *)data;                                    \
+        for (size_t done = 0; done < iterations; done += BENCH_POOL_SIZE)       \
+        {                                                                       \
+            size_t count = iterations - done < BENCH_POOL_SIZE ? iterations - done : BENCH_POOL_SIZE; \
+            call;                                                               \
+            BENCH_DO_NOT_OPTIMIZE(pool->out[0]);                                \
+        }                                                                       \
+        return 1;                                                               \
+    }
+
+SUTRA_BATCH_LOOP(bench_ekadhikena_batch, ekadhikena_purvena_batch(pool->wide_a, pool->out, count))
+SUTRA_BATCH_LOOP(bench_nikhilam_batch, nikhilam_mul_batch(pool->wide_a, pool->wide_b,
+                                                         nikhilam_best_base(pool->a[0], pool->b[0]), pool->out, count))
+SUTRA_BATCH_LOOP(bench_antyayordasake_batch, antya_dasake_mul_batch(pool->wide_a, pool->wide_b, pool->out, count))
+SUTRA_BATCH_LOOP(bench_yaavadunam_batch, yaavadunam_square_batch(pool->wide_a, pool->wide_b, pool->out, count))
+// One operation is one number against one prime: all 13 per number
+SUTRA_BATCH_LOOP(bench_vestanam_screen, vestanam_screen_batch(pool->wide_a, (count + VESTANAM_PRIME_COUNT - 1) / VESTANAM_PRIME_COUNT,
+                                                              vestanam_primes, VESTANAM_PRIME_COUNT,
+                                                              (uint64_t *)pool->out, 0))
+
+SUTRA_LOOP(bench_native_multiply, pool->a[j] * pool->b[j])
+SUTRA_LOOP(bench_native_square, pool->a[j] * pool->a[j])
+SUTRA_LOOP(bench_native_divide, (remainder = pool->a[j] % pool->b[j], pool->a[j] / pool->b[j]))
+SUTRA_LOOP(bench_native_divisibility, pool->a[j] % pool->c[j] == 0)
+
+static const SutraSpec sutras[] = {
+    {"ekadhikena_purvena", "n ending in 5, squared", KIND_SQUARE, 1, SUTRA_MAX_DIGITS,
+     generate_ekadhikena, call_ekadhikena, bench_ekadhikena},
+    {"nikhilam_mul", "both just below 10^d", KIND_MULTIPLY, 2, SUTRA_MAX_DIGITS,
+     generate_nikhilam, call_nikhilam, bench_nikhilam},
+    {"antya_dasake_mul", "same prefix, last digits sum to 10", KIND_MULTIPLY, 2, SUTRA_MAX_DIGITS,
+     generate_antyayordasake, call_antyayordasake, bench_antyayordasake},
+    {"urdhva_mult", "any d-digit pair", KIND_MULTIPLY, 1, SUTRA_MAX_DIGITS,
+     generate_urdhva, call_urdhva, bench_urdhva},
+    {"yaavadunam_square", "just below 10^d, squared", KIND_SQUARE, 1, SUTRA_MAX_DIGITS,
+     generate_yaavadunam, call_yaavadunam, bench_yaavadunam},
+    {"ekadhikena_purvena_batch", "n ending in 5, squared, in arrays", KIND_SQUARE, 1, SUTRA_MAX_DIGITS,
+     generate_ekadhikena, call_ekadhikena, bench_ekadhikena_batch},
+    {"nikhilam_mul_batch", "both just below 10^d, in arrays", KIND_MULTIPLY, 2, SUTRA_MAX_DIGITS,
+     generate_nikhilam, call_nikhilam, bench_nikhilam_batch},
+    {"antya_dasake_mul_batch", "same prefix, last digits sum to 10, in arrays", KIND_MULTIPLY, 2, SUTRA_MAX_DIGITS,
+     generate_antyayordasake, call_antyayordasake, bench_antyayordasake_batch},
+    {"yaavadunam_square_batch", "just below 10^d, squared, in arrays", KIND_SQUARE, 1, SUTRA_MAX_DIGITS,
+     generate_yaavadunam, call_yaavadunam, bench_yaavadunam_batch},
+    {"dwandwa_square", "any d-digit n, squared", KIND_SQUARE, 1, SUTRA_MAX_DIGITS,
+     generate_dwandwa, call_dwandwa, bench_dwandwa},
+    {"ekanyunena_purvena_mul", "top tenth below 10^d times 99..9", KIND_MULTIPLY, 2, SUTRA_MAX_DIGITS,
+     generate_ekanyunena, call_ekanyunena, bench_ekanyunena},
+    {"anurupyena_mul", "multiples of a common scale", KIND_MULTIPLY, 3, SUTRA_MAX_DIGITS,
+     generate_anurupyena, call_anurupyena, bench_anurupyena},
+    {"paravartya_divide", "d-digit dividend, 2-digit divisor", KIND_DIVIDE, 6, SUTRA_MAX_DIGITS,
+     generate_paravartya, call_paravartya, bench_paravartya},
+    {"dhvajanka_divide", "d-digit dividend, d/3-digit divisor", KIND_DIVIDE, 3, SUTRA_MAX_DIGITS,
+     generate_dhvajanka, call_dhvajanka, bench_dhvajanka},
+    {"nikhilam_divide_sutra", "divisor within 20% of 10^(d/3)", KIND_DIVIDE, 3, SUTRA_MAX_DIGITS,
+     generate_nikhilam_division, call_nikhilam_division, bench_nikhilam_division},
+    {"vestanam_divisibility", "d-digit number, primes 7..53", KIND_DIVISIBILITY, 2, SUTRA_MAX_DIGITS,
+     generate_vestanam, call_vestanam, bench_vestanam},
+    {"vestanam_screen_batch", "d-digit number, all 13 primes at once, in arrays", KIND_DIVISIBILITY, 2, SUTRA_MAX_DIGITS,
+     generate_vestanam, call_vestanam, bench_vestanam_screen},
+};
+
+#define SUTRA_COUNT (sizeof(sutras) / sizeof(sutras[0]))
+
+static const char *native_name(SutraKind kind)
+{
+    switch (kind)
+    {
+    case KIND_MULTIPLY:
+        return "a * b";
+    case KIND_SQUARE:
+        return "n * n";
+    case KIND_DIVIDE:
+        return "a / b, a % b";
+    default:
+        return "n % p == 0";
+    }
+}
+
+static int (*native_bench(SutraKind kind))(size_t, void *)
+{
+    switch (kind)
+    {
+    case KIND_MULTIPLY:
+        return bench_native_multiply;
+    case KIND_SQUARE:
+        return bench_native_square;
+    case KIND_DIVIDE:
+        return bench_native_divide;
+    default:
+        return bench_native_divisibility;
+    }
+}
+
+/**
+ * Largest operand digit length whose results fit the sutra's types
+ */
+static int digit_limit(const SutraSpec *sutra)
+{
+    int long_digits = count_digits(LONG_MAX);
+    int limit;
+    if (sutra->kind == KIND_MULTIPLY || sutra->kind == KIND_SQUARE)
+    {
+        // Products of two d-digit numbers have up to 2d digits
+        limit = (sutra->call == call_antyayordasake ? count_digits(INT_MAX) - 1 : long_digits - 1) / 2;
+    }
+    else
+    {
+        limit = long_digits - 1;
+    }
+    return limit < sutra->max_digits ? limit : sutra->max_digits;
+}
+
+/**
+ * Whether the sutra agrees with the native operation on one input
+ */
+static int sutra_correct(const SutraSpec *sutra, long a, long b, int c)
+{
+    long remainder = 0;
+    long result = sutra->call(a, b, c, &remainder);
+    switch (sutra->kind)
+    {
+    case KIND_MULTIPLY:
+        return result == a * b;
+    case KIND_SQUARE:
+        return result == a * a;
+    case KIND_DIVIDE:
+        return result == a / b && remainder == a % b;
+    default:
+        return result == (a % c == 0);
+    }
+}
+
+/**
+ * Fill the pool with inputs the sutra computes correctly
+ *
+ * @param wrong Set to the number of generated inputs with a wrong result
+ * @return 0 on success, -1 if no correct input could be generated
+ */
+static int fill_pool(const SutraSpec *sutra, int digits, SutraPool *pool, size_t *wrong)
+{
+    *wrong = 0;
+    for (size_t i = 0; i < BENCH_POOL_SIZE; i++)
+    {
+        int found = 0;
+        for (int attempt = 0; attempt < SUTRA_GENERATE_ATTEMPTS && !found; attempt++)
+        {
+            long a = 0, b = 0;
+            int c = 0;
+            sutra->generate(digits, &a, &b, &c);
+            if (sutra_correct(sutra, a, b, c))
+            {
+                pool->a[i] = a;
+                pool->b[i] = b;
+                pool->c[i] = c;
+                pool->wide_a[i] = a;
+                pool->wide_b[i] = b;
+                found = 1;
+            }
+            else
+            {
+                (*wrong)++;
+            }
+        }
+        if (!found)
+            return -1;
+    }
+    return 0;
+}
+
+// ============================================================================
+// MEASUREMENT AND REPORT
+// ============================================================================
+
+/**
+ * Sutra and native cost at one digit length
+ */
+typedef struct
+{
+    int digits;
+    int measured;
+    double sutra_ns;
+    double native_ns;
+    double sutra_cycles;             // 0 if cycles are unavailable
+    double native_cycles;
+    double sutra_nj;                 // Package energy per operation, when measured
+    double native_nj;
+    size_t wrong;
+} SutraPoint;
+
+static double cycles_per_op(const BenchmarkResult *result, double cycles_per_ns)
+{
+    if (result->perf.available)
+        return result->perf.cycles_per_op;
+    return result->median_ns * cycles_per_ns;
+}
+
+/**
+ * Measure one sutra over its digit lengths and print its table
+ *
+ * @return Number of digit lengths measured
+ */
+static int run_sutra(const SutraSpec *sutra, int max_digits, double cycles_per_ns, int energy,
+                     SutraPool *pool, SutraPoint *points)
+{
+    int limit = digit_limit(sutra);
+    if (max_digits > 0 && max_digits < limit)
+        limit = max_digits;
+
+    printf("%s (%s) vs %s\n", sutra->function, sutra->domain, native_name(sutra->kind));
+    printf("  %6s %12s %10s %12s %10s %8s %8s", "digits", "sutra ns/op", "cycles", "native ns/op", "cycles",
+           "ratio", "wrong");
+    if (energy)
+        printf(" %10s %10s", "sutra nJ", "native nJ");
+    printf("\n");
+
+    int count = 0;
+    for (int digits = sutra->min_digits; digits <= limit; digits++)
+    {
+        SutraPoint *point = &points[count];
+        memset(point, 0, sizeof(*point));
+        point->digits = digits;
+
+        if (fill_pool(sutra, digits, pool, &point->wrong) != 0)
+        {
+            printf("  %6d no correct inputs (%zu wrong results)\n", digits, point->wrong);
+            count++;
+            continue;
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "%s %d digits", sutra->function, digits);
+        BenchmarkResult kernel = run_benchmark(name, "Sutra", sutra->bench, BENCH_POOL_SIZE, pool);
+        BenchmarkResult native = run_benchmark(name, "Native", native_bench(sutra->kind), BENCH_POOL_SIZE, pool);
+
+        point->measured = kernel.success && native.success;
+        point->sutra_ns = kernel.median_ns;
+        point->native_ns = native.median_ns;
+        point->sutra_cycles = cycles_per_op(&kernel, cycles_per_ns);
+        point->native_cycles = cycles_per_op(&native, cycles_per_ns);
+        point->sutra_nj = kernel.package_joules_per_op * 1e9;
+        point->native_nj = native.package_joules_per_op * 1e9;
+
+        printf("  %6d %12.2f %10.1f %12.2f %10.1f %7.1fx %8zu", digits,
+               point->sutra_ns, point->sutra_cycles, point->native_ns, point->native_cycles,
+               point->native_ns > 0.0 ? point->sutra_ns / point->native_ns : 0.0, point->wrong);
+        if (energy)
+            printf(" %10.3f %10.3f", point->sutra_nj, point->native_nj);
+        printf("\n");
+        count++;
+
+        // Cost grows with the digit count; past this the sweep only burns time
+        if (point->sutra_ns > SUTRA_SLOW_NS && digits < limit)
+        {
+            printf("  (over %.0f us/op, digit lengths %d-%d skipped)\n", SUTRA_SLOW_NS / 1000.0, digits + 1, limit);
+            break;
+        }
+    }
+    printf("\n");
+    return count;
+}
+
+/**
+ * Digit lengths at which a sutra is at least as fast as native arithmetic
+ */
+static void print_threshold_summary(SutraPoint (*points)[SUTRA_MAX_DIGITS], const int *counts,
+                                    const int *selected)
+{
+    printf("=== Dispatcher threshold data ===\n");
+    printf("%-24s %-20s %s\n", "Sutra", "Faster than native", "Best ratio (sutra/native)");
+    for (size_t s = 0; s < SUTRA_COUNT; s++)
+    {
+        if (!selected[s])
+            continue;
+
+        char wins[96] = "";
+        size_t used = 0;
+        double best = 0.0;
+        int best_digits = 0;
+        for (int i = 0; i < counts[s]; i++)
+        {
+            const SutraPoint *point = &points[s][i];
+            if (!point->measured || point->native_ns <= 0.0)
+                continue;
+            double ratio = point->sutra_ns / point->native_ns;
+            if (best == 0.0 || ratio < best)
+            {
+                best = ratio;
+                best_digits = point->digits;
+            }
+            if (ratio <= 1.0 && used + 4 < sizeof(wins))
+                used += (size_t)snprintf(wins + used, sizeof(wins) - used, "%s%d", used ? "," : "", point->digits);
+        }
+        printf("%-24s %-20s %.2fx at %d digits\n", sutras[s].function,
+               used ? wins : "none", best, best_digits);
+    }
+    printf("Digit lengths listed under \"Faster than native\" are the only ones where\n"
+           "dispatching to the sutra pays off; everywhere else native arithmetic should win.\n");
+}
+
+static void print_usage(const char *program)
+{
+    printf("Usage: %s [--sutra NAME] [--max-digits N] [--reps N] [--target-ms MS]\n"
+           "          [--cpu N|auto|none] [--json FILE]\n",
+           program);
+    printf("Sutras:");
+    for (size_t s = 0; s < SUTRA_COUNT; s++)
+        printf(" %s", sutras[s].function);
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    const char *filter = NULL;
+    const char *json_path = NULL;
+    int max_digits = 0;
+
+    BenchHarnessConfig config;
+    bench_harness_default_config(&config);
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        char *endptr;
+
+        if (strcmp(arg, "--sutra") == 0 && value)
+        {
+            filter = value;
+            i++;
+        }
+        else if (strcmp(arg, "--max-digits") == 0 && value)
+        {
+            long digits = strtol(value, &endptr, 10);
+            if (*endptr == '\0' && digits > 0)
+                max_digits = (int)digits;
+            i++;
+        }
+        else if (strcmp(arg, "--reps") == 0 && value)
+        {
+            long reps = strtol(value, &endptr, 10);
+            if (*endptr == '\0' && reps > 0)
+                config.repetitions = (size_t)reps;
+            i++;
+        }
+        else if (strcmp(arg, "--target-ms") == 0 && value)
+        {
+            double target_ms = strtod(value, &endptr);
+            if (*endptr == '\0' && target_ms > 0.0)
+                config.target_time_sec = target_ms / 1000.0;
+            i++;
+        }
+        else if (strcmp(arg, "--cpu") == 0 && value)
+        {
+            if (strcmp(value, "none") == 0)
+                config.cpu = BENCH_CPU_NONE;
+            else if (strcmp(value, "auto") == 0)
+                config.cpu = BENCH_CPU_AUTO;
+            else
+            {
+                long cpu = strtol(value, &endptr, 10);
+                if (*endptr == '\0' && cpu >= 0)
+                    config.cpu = (int)cpu;
+            }
+            i++;
+        }
+        else if (strcmp(arg, "--json") == 0 && value)
+        {
+            json_path = value;
+            i++;
+        }
+        else
+        {
+            print_usage(argv[0]);
+            return strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0 ? 0 : 1;
+        }
+    }
+
+    int selected[SUTRA_COUNT];
+    int any_selected = 0;
+    for (size_t s = 0; s < SUTRA_COUNT; s++)
+    {
+        selected[s] = !filter || strcmp(filter, sutras[s].function) == 0;
+        any_selected |= selected[s];
+    }
+    if (!any_selected)
+    {
+        printf("Unknown sutra '%s'\n", filter);
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    bench_harness_set_config(&config);
+    if (config.cpu != BENCH_CPU_NONE && bench_harness_pin() < 0)
+        printf("Warning: could not pin to a CPU, results may be noisier\n");
+
+    if (json_path && bench_json_begin(json_path, argv[0]) != 0)
+    {
+        printf("Error: cannot write JSON results to '%s'\n", json_path);
+        return 1;
+    }
+
+    printf("Vedic Mathematics Sutra Kernel Benchmark\n");
+    printf("========================================\n\n");
+
+    // Cycles from the counters if perf works, else from the measured clock
+    double cycles_per_ns = 0.0;
+    if (bench_perf_shared()->open_count == 0)
+    {
+        cycles_per_ns = bench_cycles_per_ns();
+        if (cycles_per_ns > 0.0)
+            printf("Cycles estimated from the measured clock: %.2f GHz\n", cycles_per_ns);
+        else
+            printf("Cycles unavailable (no perf counters, no clock estimate)\n");
+    }
+    int energy = benchmark_energy_available();
+    printf("\n");
+
+    SutraPool *pool = malloc(sizeof(SutraPool));
+    static SutraPoint points[SUTRA_COUNT][SUTRA_MAX_DIGITS];
+    int counts[SUTRA_COUNT] = {0};
+    if (!pool)
+    {
+        printf("Error: out of memory\n");
+        return 1;
+    }
+
+    srand(SUTRA_SEED);
+    for (size_t s = 0; s < SUTRA_COUNT; s++)
+    {
+        if (selected[s])
+            counts[s] = run_sutra(&sutras[s], max_digits, cycles_per_ns, energy, pool, points[s]);
+    }
+    print_threshold_summary(points, counts, selected);
+    free(pool);
+
+    if (json_path)
+    {
+        if (bench_json_end() != 0)
+        {
+            printf("Error: failed to write JSON results to '%s'\n", json_path);
+            return 1;
+        }
+        printf("JSON results written to %s\n", json_path);
+    }
+
+    return 0;
+}
@@ -1,13 +1,102 @@
 import { useState, useEffect } from 'react';
 import { Card, CardContent, CardDescription, CardFooter, CardHeader, CardTitle } from "@/components/ui/card";
 import { Button } from "@/components/ui/button";
-import { AlertCircle, BarChart4 } from "lucide-react";
+import { Activity, AlertCircle, BarChart4 } from "lucide-react";
 import { LineChart, Line, XAxis, YAxis, CartesianGrid, Tooltip, Legend, ResponsiveContainer } from 'recharts';
 import { Alert, AlertDescription, AlertTitle } from '@/components/ui/alert';
 import { useApi } from '../hooks/useApi';
+import { useLiveMetrics } from '../hooks/useLiveMetrics';
 
 const API_URL = "http://localhost:8000";
 
+const BATCH_METHODS = [
+  ["batch_direct", "Direct"],
+  ["batch_ekadhikena", "Ekadhikena"],
+  ["batch_antyayordasake", "Antyayordasake"],
+  ["batch_nikhilam", "Nikhilam"],
+  ["batch_urdhva", "Urdhva"],
+];
+
+const formatRate = (value) => (value == null ? "–" : Math.round(value).toLocaleString());
+
+// Engine counters as the backend broadcasts them over /ws/live-updates
+const LiveEngineMetrics = () => {
+  const { connected, totals, rates, history, systemStatus } = useLiveMetrics();
+
+  return (
+    <div className="grid gap-4">
+      <div className="flex justify-between items-center">
+        <h3 className="text-sm font-medium flex items-center gap-2">
+          <Activity className="h-4 w-4" />
+          Live Engine Metrics
+        </h3>
+        <span className={`px-2 py-1 rounded-full text-xs ${
+          connected ? "bg-green-100 text-green-800" : "bg-gray-100 text-gray-600"
+        }`}>
+          {connected ? "Live" : "Disconnected"}
+        </span>
+      </div>
+
+      {!totals ? (
+        <div className="text-center py-4 text-sm text-gray-500">
+          {connected ? "Waiting for the engine to publish metrics..." : "Connecting to the backend..."}
+        </div>
+      ) : (
+        <>
+          <div className="grid grid-cols-2 md:grid-cols-4 gap-2 text-sm">
+            <div className="border rounded-md p-2">
+              <div className="text-xs text-gray-500">Dispatch ops/s</div>
+              <div className="font-mono">{formatRate(rates && rates.dispatch_operations_per_s)}</div>
+            </div>
+            <div className="border rounded-md p-2">
+              <div className="text-xs text-gray-500">Batch elements/s</div>
+              <div className="font-mono">{formatRate(rates && rates.batch_elements_per_s)}</div>
+            </div>
+            <div className="border rounded-md p-2">
+              <div className="text-xs text-gray-500">Async in flight</div>
+              <div className="font-mono">{totals.async_in_flight.toLocaleString()}</div>
+            </div>
+            <div className="border rounded-md p-2">
+              <div className="text-xs text-gray-500">Package power</div>
+              <div className="font-mono">{rates && rates.watts != null ? `${rates.watts.toFixed(1)} W` : "–"}</div>
+            </div>
+          </div>
+
+          <div className="h-48">
+            <ResponsiveContainer width="100%" height="100%">
+              <LineChart data={history} margin={{ top: 5, right: 30, left: 20, bottom: 5 }}>
+                <CartesianGrid strokeDasharray="3 3" />
+                <XAxis dataKey="sequence" hide />
+                <YAxis />
+                <Tooltip formatter={formatRate} />
+                <Legend />
+                <Line type="monotone" dataKey="operations" name="Dispatch ops/s" stroke="#8884d8" dot={false} isAnimationActive={false} />
+                <Line type="monotone" dataKey="elements" name="Batch elements/s" stroke="#82ca9d" dot={false} isAnimationActive={false} />
+              </LineChart>
+            </ResponsiveContainer>
+          </div>
+
+          <div className="grid grid-cols-5 gap-2 text-xs">
+            {BATCH_METHODS.map(([key, label]) => (
+              <div key={key} className="border rounded-md p-2">
+                <div className="text-gray-500">{label}</div>
+                <div className="font-mono">{totals[key].toLocaleString()}</div>
+              </div>
+            ))}
+          </div>
+
+          {systemStatus && (
+            <div className="text-xs text-gray-500">
+              CPU {systemStatus.cpu_usage_percent.toFixed(0)}% · Memory {systemStatus.memory_usage_percent.toFixed(0)}% ·
+              {" "}{systemStatus.active_operations} active requests · engine pid {totals.pid}
+            </div>
+          )}
+        </>
+      )}
+    </div>
+  );
+};
+
 export const BenchmarkViewer = () => {
   const [benchmarkData, setBenchmarkData] = useState([]);
   const [chartData, setChartData] = useState([]);
@@ -51,7 +140,8 @@ export const BenchmarkViewer = () => {
           Performance comparison between standard and Vedic methods
         </CardDescription>
       </CardHeader>
-      <CardContent>
+      <CardContent className="grid gap-6">
+        <LiveEngineMetrics />
         {loading ? (
           <div className="text-center py-4">Loading benchmark data...</div>
         ) : error ? (
@@ -0,0 +1,62 @@
+import { useEffect, useRef, useState } from 'react';
+
+const WS_URL = "ws://localhost:8000/ws/live-updates";
+const HISTORY_LENGTH = 120;   // Deltas kept for the chart (30 s at the default 4 Hz)
+const RECONNECT_MS = 2000;
+
+// Engine metrics pushed by the backend: a full snapshot on connect, then
+// deltas at the broadcaster's rate and system status every few seconds
+export const useLiveMetrics = () => {
+  const [connected, setConnected] = useState(false);
+  const [totals, setTotals] = useState(null);
+  const [rates, setRates] = useState(null);
+  const [history, setHistory] = useState([]);
+  const [systemStatus, setSystemStatus] = useState(null);
+  const socketRef = useRef(null);
+
+  useEffect(() => {
+    let closed = false;
+    let retry = null;
+
+    const connect = () => {
+      const socket = new WebSocket(WS_URL);
+      socketRef.current = socket;
+      socket.onopen = () => setConnected(true);
+      socket.onclose = () => {
+        setConnected(false);
+        if (!closed) retry = setTimeout(connect, RECONNECT_MS);
+      };
+      socket.onmessage = (event) => {
+        const message = JSON.parse(event.data);
+        if (message.type === "metrics_snapshot") {
+          setTotals(message.data);
+          setHistory([]);
+        } else if (message.type === "metrics_delta") {
+          setTotals(message.totals);
+          setRates(message.rates);
+          setHistory((previous) => [
+            ...previous.slice(-(HISTORY_LENGTH - 1)),
+            {
+              sequence: message.totals.sequence,
+              operations: message.rates.dispatch_operations_per_s,
+              elements: message.rates.batch_elements_per_s,
+            },
+          ]);
+        } else if (message.type === "system_status") {
+          setSystemStatus(message.data);
+        }
+      };
+    };
+
+    connect();
+    return () => {
+      closed = true;
+      clearTimeout(retry);
+      if (socketRef.current) socketRef.current.close();
+    };
+  }, []);
+
+  return { connected, totals, rates, history, systemStatus };
+};
+
+export default useLiveMetrics;
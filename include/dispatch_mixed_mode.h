@@ -78,6 +78,7 @@ typedef struct {
     // Performance metrics
     double temperature_celsius;      // System temperature (if available)
     double power_consumption_watts;  // Power usage estimate (if available)
+    bool power_measured;             // Linux: power_consumption_watts is RAPL package power
     
     // Platform-specific metrics
     size_t free_heap_bytes;         // ESP32: Free heap memory
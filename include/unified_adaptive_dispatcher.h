@@ -11,6 +11,7 @@
 #define UNIFIED_ADAPTIVE_DISPATCHER_H
 
 #include "vedicmath_types.h"
+#include "vedicmath_cancel.h"
 #include <stdint.h>
 #include <stdbool.h>
 #include <time.h>
@@ -96,7 +97,7 @@ typedef struct {
     
     // Platform optimizations
     bool optimize_for_platform;    // Enable platform-specific optimizations
-    bool enable_parallel_batch;    // Use OpenMP for batch operations
+    bool enable_parallel_batch;    // Run batch operations on the library thread pool
     size_t max_memory_usage_mb;    // Memory budget for operations
 } UnifiedDispatchConfig;
 
@@ -160,8 +161,51 @@ typedef struct {
     const VedicValue* matrix_a;
     const VedicValue* matrix_b;
     VedicValue* result_matrix;
+    VedicCancelToken* cancel;          // Optional: checked before each row, counts rows done
 } MatrixOperationParams;
 
+/**
+ * @brief Operand patterns drawn by the dataset generator
+ */
+typedef enum {
+    DATASET_PATTERN_EKADHIKENA = 0,      // n x n with n ending in 5
+    DATASET_PATTERN_NIKHILAM = 1,        // Both operands within 20% of 100 or 1000
+    DATASET_PATTERN_ANTYAYORDASAKE = 2,  // Same prefix, last digits sum to 10
+    DATASET_PATTERN_URDHVA = 3,          // Two 4-digit operands
+    DATASET_PATTERN_RANDOM = 4,          // Uniform in 1-1000
+    DATASET_PATTERN_COUNT = 5
+} DatasetPattern;
+
+#define DATASET_PATTERN_ALL ((1u << DATASET_PATTERN_COUNT) - 1)
+
+/**
+ * @brief One generated dataset record (plain data, safe to copy in bulk)
+ */
+typedef struct {
+    int64_t operand_a;
+    int64_t operand_b;
+    int64_t result;
+    DatasetPattern pattern;
+    VedicSutraType sutra;
+    double confidence;
+    double predicted_speedup;
+    double execution_time_ms;          // Selected sutra
+    double standard_execution_time_ms; // Plain a * b
+    bool correct;
+} DatasetRecord;
+
+/**
+ * @brief Running totals over generated records
+ */
+typedef struct {
+    size_t records;
+    size_t vedic_methods_used;
+    size_t correct;
+    double speedup_sum;                // Sum of standard / sutra time per record
+    size_t pattern_counts[DATASET_PATTERN_COUNT];
+    size_t sutra_counts[MAX_SUTRA_TYPES];
+} DatasetSummary;
+
 /**
  * @brief Adaptation recommendations
  */
@@ -229,11 +273,24 @@ UnifiedDispatchResult unified_multiply(VedicValue a, VedicValue b);
 
 /**
  * @brief Enhanced division with unified intelligence
+ *
+ * The result is the quotient; the remainder is dividend - quotient * divisor.
+ * A zero divisor returns 0 with selected_algorithm "Error: Division by zero".
  */
 UnifiedDispatchResult unified_divide(VedicValue dividend, VedicValue divisor);
 
 /**
  * @brief Matrix operations (Day 2 implementation)
+ *
+ * Computes result_matrix = matrix_a x matrix_b (row-major) with the
+ * pattern-partitioned batch multiply, rows split across the library thread
+ * pool. result holds the sum of all entries as a checksum; with
+ * validate_all_operations the product is checked against a single-threaded
+ * standard loop, whose time is standard_execution_time_ms.
+ *
+ * With a cancel token, a product interrupted by it returns selected_algorithm
+ * "Error: Cancelled" or "Error: Deadline exceeded", leaves result_matrix
+ * unspecified, and the token's progress holds the rows that were computed.
  */
 UnifiedDispatchResult unified_matrix_multiply(const MatrixOperationParams* params);
 
@@ -268,6 +325,92 @@ AdaptationRecommendation unified_dispatch_get_recommendations(void);
  */
 DecisionTreeAnalysis unified_dispatch_get_last_decision_tree(void);
 
+// ============================================================================
+// DATASET GENERATION
+// ============================================================================
+
+/**
+ * @brief Generate dataset records into a caller-owned buffer
+ *
+ * Draws operands from the patterns in pattern_mask (bits of DatasetPattern;
+ * 0 means all), selects a sutra the same way unified_multiply does and times
+ * it against plain multiplication. The generator state lives in *seed, so
+ * a large dataset can be produced chunk by chunk with the same result as
+ * one call. Does not touch the learning state or the research dataset and
+ * is safe to call from several threads with separate seeds.
+ *
+ * @return Number of records written (count)
+ */
+size_t unified_dispatch_generate_records(DatasetRecord* records, size_t count,
+                                         uint64_t* seed, unsigned pattern_mask);
+
+/**
+ * @brief unified_dispatch_generate_records that stops between records once
+ * the token is cancelled or expires
+ *
+ * The token is checked every 16 records and counts the records written.
+ * *seed is left just past the last record, so generation can resume.
+ *
+ * @return Number of records written (count unless stopped)
+ */
+size_t unified_dispatch_generate_records_cancellable(DatasetRecord* records, size_t count, uint64_t* seed,
+                                                     unsigned pattern_mask, VedicCancelToken* cancel);
+
+/**
+ * @brief Add records to running totals (summary must start zeroed)
+ */
+void unified_dispatch_summarize_records(DatasetSummary* summary, const DatasetRecord* records, size_t count);
+
+/**
+ * @brief Text formats of a dataset record
+ */
+typedef enum {
+    DATASET_FORMAT_CSV = 0,            // One row under DATASET_CSV_HEADER
+    DATASET_FORMAT_NDJSON = 1          // One JSON object per line, keys as the CSV columns
+} DatasetFormat;
+
+#define DATASET_CSV_HEADER "operand_a,operand_b,result,sutra_used,pattern_type,confidence," \
+                           "predicted_speedup,execution_time_ms,standard_time_ms,correct\n"
+#define DATASET_RECORD_MAX_TEXT 384    // Longest formatted record, newline included
+
+/**
+ * @brief Format one record as a line of text (snprintf semantics)
+ *
+ * @return Length of the line, including its newline
+ */
+int unified_dispatch_format_record(char* buffer, size_t size, const DatasetRecord* record, DatasetFormat format);
+
+/**
+ * @brief Generate count records straight to a CSV file
+ *
+ * Records are produced and written a chunk at a time, so memory use does
+ * not grow with count.
+ *
+ * @param summary Totals over the written records (may be NULL)
+ * @return 0 on success, -1 if the file cannot be written
+ */
+int unified_dispatch_write_dataset(const char* filename, size_t count, uint64_t seed,
+                                   unsigned pattern_mask, DatasetSummary* summary);
+
+/**
+ * @brief unified_dispatch_write_dataset that stops once the token is
+ * cancelled or expires
+ *
+ * The file then holds the header and every record generated so far, and
+ * summary and the token's progress cover the same records.
+ *
+ * @return 0 if all count records were written, 1 if stopped by the token,
+ *         -1 if the file cannot be written
+ */
+int unified_dispatch_write_dataset_cancellable(const char* filename, size_t count, uint64_t seed,
+                                               unsigned pattern_mask, DatasetSummary* summary,
+                                               VedicCancelToken* cancel);
+
+/**
+ * @brief Name of a dataset pattern ("ekadhikena", "nikhilam", ...)
+ */
+const char* unified_dispatch_pattern_name(DatasetPattern pattern);
+
 // ============================================================================
 // CONFIGURATION AND RUNTIME CONTROL
 // ============================================================================
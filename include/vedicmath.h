@@ -13,8 +13,10 @@
  
  #include <stdbool.h>
  #include <math.h>
+ #include <stdint.h>
  #include <stdlib.h>
  #include "vedicmath_platform.h"
+ #include "vedicmath_cancel.h"
 
 
  // include/vedicmath.h (add these declarations)
@@ -52,6 +54,17 @@ VEDICMATH_API long combine_parts(long left, long right, int right_digits);
   * @return The square of n
   */
  long ekadhikena_purvena(long n);
+
+ /**
+  * Ekadhikena Purvena over an array, without branches so the loop vectorizes
+  * 
+  * Lanes not ending in 5 (or of 2^32 and above) take the plain square.
+  * 
+  * @param n Numbers to square
+  * @param squares Output; may be n itself
+  * @param count Number of elements
+  */
+ void ekadhikena_purvena_batch(const int64_t *n, int64_t *squares, size_t count);
  
  /**
   * Nikhilam Navatashcaramam Dashatah - "All from 9 and the last from 10"
@@ -67,6 +80,28 @@ VEDICMATH_API long combine_parts(long left, long right, int right_digits);
   * @return The product a * b
   */
  long nikhilam_mul(long a, long b);
+
+ /**
+  * Working base nikhilam_mul uses for a pair
+  * 
+  * @return The power of 10 that minimizes the two deviations
+  */
+ long nikhilam_best_base(long a, long b);
+
+ /**
+  * Nikhilam over a bucket of pairs that share a base, without branches so
+  * the loop vectorizes
+  * 
+  * Pairs above, below and on both sides of the base take the same path:
+  * a * b = (a + (b - B)) * B + (a - B) * (b - B).
+  * 
+  * @param a First operands
+  * @param b Second operands
+  * @param base Common power of 10 base B
+  * @param products Output; may be a or b itself
+  * @param count Number of pairs
+  */
+ void nikhilam_mul_batch(const int64_t *a, const int64_t *b, int64_t base, int64_t *products, size_t count);
  
  /**
   * Urdhva-Tiryagbhyam - "Vertically and crosswise"
@@ -82,6 +117,30 @@ VEDICMATH_API long combine_parts(long left, long right, int right_digits);
   * @return The product a * b
   */
  long urdhva_mult(long a, long b);
+
+ /**
+  * Dwandwa-yoga - "Duplex combination"
+  * 
+  * Purpose: General squaring with about half the digit products of Urdhva-Tiryagbhyam.
+  * When to use: For squaring any number when no special pattern applies.
+  * 
+  * Core logic: Each column of the square is the duplex of the digits that meet in it:
+  * twice the sum of the crosswise pairs plus the square of the middle digit.
+  * Example: 123² -> D(1)=1, D(12)=4, D(123)=10, D(23)=12, D(3)=9 => 15129
+  * 
+  * @param n Number to square
+  * @return The square of n (wrapping as n * n does on overflow)
+  */
+ long dwandwa_square(long n);
+
+ /**
+  * Dwandwa-yoga for unsigned integers of any width
+  * 
+  * @param square Output, 2 * count limbs, least significant first (must not overlap limbs)
+  * @param limbs Input, count 32-bit limbs, least significant first
+  * @param count Number of input limbs
+  */
+ void dwandwa_square_limbs(uint32_t *square, const uint32_t *limbs, size_t count);
  
  /**
   * Paravartya Yojayet - "Transpose and adjust"
@@ -150,6 +209,18 @@ long vedic_divide_enhanced(long dividend, long divisor, long *remainder, const c
   * @return The square of n
   */
  long yaavadunam_square(long n, long base);
+
+ /**
+  * Yaavadunam over arrays, without branches so the loop vectorizes
+  * 
+  * Numbers below and above their base take the same path.
+  * 
+  * @param n Numbers to square
+  * @param bases Power of 10 for each number
+  * @param squares Output; may be n itself
+  * @param count Number of elements
+  */
+ void yaavadunam_square_batch(const int64_t *n, const int64_t *bases, int64_t *squares, size_t count);
  
  /**
   * Antyayordasake - "Last totaling 10"
@@ -165,6 +236,19 @@ long vedic_divide_enhanced(long dividend, long divisor, long *remainder, const c
   * @return The product a * b
   */
  int antya_dasake_mul(int a, int b);
+
+ /**
+  * Antyayordasake over arrays, without branches so the loop vectorizes
+  * 
+  * Pairs that do not qualify (or are negative or wider than 32 bits) take
+  * the plain product.
+  * 
+  * @param a First operands
+  * @param b Second operands
+  * @param products Output; may be a or b itself
+  * @param count Number of pairs
+  */
+ void antya_dasake_mul_batch(const int64_t *a, const int64_t *b, int64_t *products, size_t count);
  
  /**
   * Vedic multiply - Central dispatcher function
@@ -176,7 +260,65 @@ long vedic_divide_enhanced(long dividend, long divisor, long *remainder, const c
   * @return The product a * b
   */
  long vedic_multiply(long a, long b);
- 
+
+ /**
+  * Multiplication methods vedic_multiply can select
+  */
+ typedef enum {
+     VEDIC_MUL_DIRECT = 0,        // Trivial operands, small numbers or no pattern
+     VEDIC_MUL_EKADHIKENA,        // Squares of numbers ending in 5
+     VEDIC_MUL_ANTYAYORDASAKE,    // Same prefix, last digits sum to 10
+     VEDIC_MUL_NIKHILAM,          // Near a power of 10
+     VEDIC_MUL_URDHVA,            // Multi-digit Urdhva-Tiryagbhyam
+     VEDIC_MUL_METHOD_COUNT
+ } VedicMultiplyMethod;
+
+ /**
+  * Method vedic_multiply would use for a pair of operands
+  *
+  * @param a First number
+  * @param b Second number
+  * @return The selected method
+  */
+ VedicMultiplyMethod vedic_multiply_method(long a, long b);
+
+ /**
+  * Name of a multiplication method
+  *
+  * @param method Method
+  * @return Sutra name ("Unknown" for invalid values)
+  */
+ const char *vedic_multiply_method_name(VedicMultiplyMethod method);
+
+ /**
+  * Batch Vedic multiply - pattern-partitioned dispatch
+  *
+  * Classifies a chunk of operand pairs first, then runs each method over
+  * all pairs that selected it, so the per-sutra loops see a single code
+  * path instead of a data-dependent branch per element. Results are the
+  * same as calling vedic_multiply on every pair. Large batches are split
+  * across the library thread pool (vedicmath_pool.h).
+  *
+  * @param results Output array; may be a or b itself, but must not partially overlap them
+  * @param a First operands
+  * @param b Second operands
+  * @param count Number of pairs
+  */
+ void vedic_multiply_batch(long *results, const long *a, const long *b, size_t count);
+
+ /**
+  * vedic_multiply_batch that stops early once the token is cancelled or
+  * its deadline passes (vedicmath_cancel.h)
+  *
+  * The token is checked every 4096 pairs of each range and counts the pairs
+  * computed. Which pairs those are when the call stops early is unspecified.
+  *
+  * @param token Token, or NULL to run to completion
+  * @return VEDIC_CANCEL_NONE if every pair was computed, otherwise why it stopped
+  */
+ VedicCancelReason vedic_multiply_batch_cancellable(long *results, const long *a, const long *b, size_t count,
+                                                    VedicCancelToken *token);
+
  /**
   * Vedic divide - Central dispatcher function for division
   * 
@@ -198,6 +340,20 @@ long vedic_divide_enhanced(long dividend, long divisor, long *remainder, const c
   * @return The square of n
   */
  long vedic_square(long n);
+
+ /**
+  * Batch Vedic square - pattern-partitioned dispatch
+  *
+  * Classifies a chunk as vedic_square would, then squares the numbers ending
+  * in 5 and those near a power of 10 with the branch-free Ekadhikena and
+  * Yaavadunam kernels. Results are the same as calling vedic_square on every
+  * element. Large batches are split across the library thread pool.
+  *
+  * @param results Output array; may be n itself, but must not partially overlap it
+  * @param n Numbers to square
+  * @param count Number of elements
+  */
+ void vedic_square_batch(long *results, const long *n, size_t count);
  
  /**
   * Count the number of digits in a number
@@ -364,11 +520,39 @@ long vedic_divide_enhanced(long dividend, long divisor, long *remainder, const c
   * When to use: For quickly determining divisibility by primes like 7, 13, 17, etc.
   * 
   * @param number The number to check
-  * @param prime The prime divisor to test
-  * @return 1 if divisible, 0 if not, -1 if prime not supported
+  * @param prime The divisor to test: coprime to 10 and at most
+  *              VESTANAM_MAX_DIVISOR, or 2 or 5
+  * @return 1 if divisible, 0 if not, -1 if the divisor is not supported
   */
  int vestanam_divisibility(long number, int prime);
  
+ // Largest divisor the Vestanam tests take; keeps the screen's digit-pair sums in 32 bits
+ #define VESTANAM_MAX_DIVISOR 4194303
+ 
+ /**
+  * Osculator of a divisor coprime to 10, computed on first use and cached
+  * 
+  * @param divisor Divisor, 1 to VESTANAM_MAX_DIVISOR
+  * @return P > 0 to add last digit * P to the rest, or -Q to subtract
+  *         last digit * Q, whichever is smaller (7: -2, 13: 4); 0 for 1 and
+  *         for divisors that share a factor with 10 or are out of range
+  */
+ int vestanam_osculator(int divisor);
+ 
+ /**
+  * Screen numbers against a set of divisors at once, without dividing
+  * 
+  * @param numbers Numbers to screen
+  * @param count Number of numbers
+  * @param divisors Divisors: coprime to 10 and at most VESTANAM_MAX_DIVISOR, or 2 or 5
+  * @param divisor_count Number of divisors, at most 64
+  * @param masks Output: bit j of masks[i] is set when divisors[j] divides numbers[i]
+  * @param first_only Nonzero to record only the first divisor found per number
+  * @return 0 on success, -1 if a divisor is not supported
+  */
+ int vestanam_screen_batch(const int64_t *numbers, size_t count, const int *divisors,
+                           size_t divisor_count, uint64_t *masks, int first_only);
+ 
  /**
   * Test if a number is divisible by 7 (special case of Vestanam)
   * 
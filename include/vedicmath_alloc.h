@@ -0,0 +1,149 @@
+/**
+ * vedicmath_alloc.h - Pluggable allocator and allocation accounting
+ *
+ * Every heap allocation made by the library goes through the allocator set
+ * with vedic_set_allocator (malloc/realloc/free by default). When tracking
+ * is enabled, each allocation is also counted per call site and per public
+ * API entry point, so hidden allocation in the dispatchers, sutras and
+ * logging paths can be measured. Tracking is off by default and costs one
+ * flag check per allocation and per API call while off.
+ */
+
+ #ifndef VEDICMATH_ALLOC_H
+ #define VEDICMATH_ALLOC_H
+
+ #include <stdbool.h>
+ #include <stddef.h>
+ #include <stdint.h>
+ #include "vedicmath_platform.h"
+
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+
+ /**
+  * Allocator interface
+  *
+  * reallocate(NULL, size) must behave like allocate(size) and release(NULL)
+  * must be a no-op, as for the C library functions.
+  */
+ typedef struct {
+     void *(*allocate)(size_t size, void *context);
+     void *(*reallocate)(void *ptr, size_t size, void *context);
+     void (*release)(void *ptr, void *context);
+     void *context;                     // Passed to every callback
+ } VedicAllocator;
+
+ /**
+  * Allocation counts (for the whole library, one call site or one API)
+  */
+ typedef struct {
+     uint64_t allocations;              // malloc/calloc/strdup calls
+     uint64_t reallocations;            // realloc calls
+     uint64_t frees;                    // free calls with a non-NULL pointer
+     uint64_t bytes;                    // Bytes requested (realloc counts the new size)
+     uint64_t failures;                 // Requests the allocator could not satisfy
+ } VedicAllocCounts;
+
+ /**
+  * Counts of one call site as reached from one API entry point
+  */
+ typedef struct {
+     const char *file;                  // Source file (without directories)
+     int line;
+     const char *function;              // Function containing the call
+     const char *api;                   // Outermost public entry point, "(none)" outside any
+     VedicAllocCounts counts;
+ } VedicAllocSiteStats;
+
+ /**
+  * Install an allocator for all library allocations
+  *
+  * Memory is released with the allocator that is current at the time, so
+  * switch allocators only while the library holds no allocations (before
+  * the *_init calls or after the matching *_cleanup calls).
+  *
+  * @param allocator Allocator to use, or NULL to restore malloc/realloc/free
+  * @return 0 on success, -1 if a callback is missing
+  */
+ VEDICMATH_API int vedic_set_allocator(const VedicAllocator *allocator);
+
+ /**
+  * Get the current allocator
+  *
+  * @return Copy of the allocator in use
+  */
+ VEDICMATH_API VedicAllocator vedic_get_allocator(void);
+
+ /**
+  * Enable or disable allocation accounting
+  *
+  * Counts are kept across disable/enable; use vedic_alloc_tracking_reset to
+  * clear them.
+  *
+  * @param enable true to start counting
+  */
+ VEDICMATH_API void vedic_alloc_tracking_enable(bool enable);
+
+ /**
+  * Whether allocation accounting is enabled
+  */
+ VEDICMATH_API bool vedic_alloc_tracking_enabled(void);
+
+ /**
+  * Clear all allocation counts
+  */
+ VEDICMATH_API void vedic_alloc_tracking_reset(void);
+
+ /**
+  * Totals over all call sites since the last reset
+  *
+  * @return Library-wide counts
+  */
+ VEDICMATH_API VedicAllocCounts vedic_alloc_get_totals(void);
+
+ /**
+  * Per call site and API counts since the last reset
+  *
+  * @param sites Output array (may be NULL if max_sites is 0)
+  * @param max_sites Capacity of sites
+  * @return Number of recorded sites (may exceed max_sites)
+  */
+ VEDICMATH_API size_t vedic_alloc_get_sites(VedicAllocSiteStats *sites, size_t max_sites);
+
+ /**
+  * Print per-API and per-call-site tables to stdout
+  */
+ VEDICMATH_API void vedic_alloc_print_report(void);
+
+ // ============================================================================
+ // LIBRARY-INTERNAL ENTRY POINTS
+ // ============================================================================
+ //
+ // Library sources allocate with the VEDIC_* macros below so the call site
+ // is recorded, and public entry points that can allocate open an API scope
+ // with VEDIC_ALLOC_SCOPE_BEGIN/END. Only the outermost scope of a thread is
+ // recorded, so nested library calls are attributed to the caller's entry.
+
+ VEDICMATH_API void *vedic_alloc_malloc(size_t size, const char *file, int line, const char *function);
+ VEDICMATH_API void *vedic_alloc_calloc(size_t count, size_t size, const char *file, int line, const char *function);
+ VEDICMATH_API void *vedic_alloc_realloc(void *ptr, size_t size, const char *file, int line, const char *function);
+ VEDICMATH_API void vedic_alloc_free(void *ptr, const char *file, int line, const char *function);
+ VEDICMATH_API char *vedic_alloc_strdup(const char *str, const char *file, int line, const char *function);
+ VEDICMATH_API int vedic_alloc_scope_enter(const char *api);
+ VEDICMATH_API void vedic_alloc_scope_leave(int opened);
+
+ #define VEDIC_MALLOC(size) vedic_alloc_malloc((size), __FILE__, __LINE__, __func__)
+ #define VEDIC_CALLOC(count, size) vedic_alloc_calloc((count), (size), __FILE__, __LINE__, __func__)
+ #define VEDIC_REALLOC(ptr, size) vedic_alloc_realloc((ptr), (size), __FILE__, __LINE__, __func__)
+ #define VEDIC_FREE(ptr) vedic_alloc_free((ptr), __FILE__, __LINE__, __func__)
+ #define VEDIC_STRDUP(str) vedic_alloc_strdup((str), __FILE__, __LINE__, __func__)
+
+ #define VEDIC_ALLOC_SCOPE_BEGIN(api) int vedic_alloc_scope_opened_ = vedic_alloc_scope_enter(api)
+ #define VEDIC_ALLOC_SCOPE_END() vedic_alloc_scope_leave(vedic_alloc_scope_opened_)
+
+ #ifdef __cplusplus
+ }
+ #endif
+
+ #endif /* VEDICMATH_ALLOC_H */
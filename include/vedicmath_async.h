@@ -0,0 +1,147 @@
+/**
+ * vedicmath_async.h - Asynchronous batch submission
+ *
+ * Submits a batch to the library thread pool and returns at once with a
+ * handle. A worker runs the batch (split across the pool like the
+ * synchronous batch APIs), then calls the completion callback on its own
+ * thread. The handle can be polled, waited on or cancelled.
+ *
+ * The number of batches in flight is bounded. When the bound is reached,
+ * vedic_submit_batch returns NULL instead of queueing, so the caller can
+ * shed or delay load rather than letting the queue grow without limit.
+ *
+ * With a pool of zero workers (one CPU, or platforms without POSIX threads)
+ * a batch runs on the submitting thread before vedic_submit_batch returns.
+ */
+
+ #ifndef VEDICMATH_ASYNC_H
+ #define VEDICMATH_ASYNC_H
+
+ #include <stddef.h>
+ #include <stdint.h>
+ #include "vedicmath_platform.h"
+
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+
+ #define VEDIC_ASYNC_DEFAULT_LIMIT 1024     // Batches in flight before submit refuses
+
+ /**
+  * Batch operations (inputs[] and outputs layout in parentheses)
+  */
+ typedef enum {
+     VEDIC_BATCH_MULTIPLY = 0,              // vedic_multiply_batch (long a[], long b[] -> long[])
+     VEDIC_BATCH_SQUARE = 1,                // vedic_square (long n[] -> long[])
+     VEDIC_BATCH_VALUE_MULTIPLY = 2,        // vedic_optimized_multiply_batch (VedicValue a[], b[] -> VedicValue[])
+     VEDIC_BATCH_EVALUATE = 3,              // vedic_optimized_evaluate_batch (const char *expr[] -> VedicValue[])
+     VEDIC_BATCH_DIVIDE = 4,                // vedic_divide (long dividend[], long divisor[] -> long quotient[])
+     VEDIC_BATCH_OP_COUNT = 5
+ } VedicBatchOp;
+
+ /**
+  * Batch state
+  */
+ typedef enum {
+     VEDIC_BATCH_QUEUED = 0,                // Waiting for a worker
+     VEDIC_BATCH_RUNNING = 1,
+     VEDIC_BATCH_DONE = 2,                  // Every output written
+     VEDIC_BATCH_CANCELLED = 3              // Stopped early; outputs are partial
+ } VedicBatchStatus;
+
+ typedef struct VedicBatchHandle VedicBatchHandle;
+
+ /**
+  * Completion callback, called once with DONE or CANCELLED
+  *
+  * Runs on the thread that ran the batch: usually a pool worker, but the
+  * submitting thread when there are no workers, the waiting thread when
+  * vedic_batch_wait picked the batch up, and the cancelling thread for a
+  * batch cancelled while queued. It should hand the result off rather
+  * than block, and may submit further batches and release the handle.
+  */
+ typedef void (*VedicBatchCallback)(VedicBatchHandle *handle, VedicBatchStatus status, void *user_data);
+
+ /**
+  * Counters since the last reset
+  */
+ typedef struct {
+     uint64_t submitted;
+     uint64_t completed;                    // Finished with DONE
+     uint64_t cancelled;
+     uint64_t rejected;                     // Refused because the limit was reached
+     size_t in_flight;                      // Submitted and not yet finished
+     size_t high_water;                     // Largest in_flight seen
+ } VedicAsyncStats;
+
+ /**
+  * Submit a batch
+  *
+  * Inputs and outputs must stay valid until the batch finishes.
+  *
+  * @param op Operation
+  * @param inputs Operand arrays, one per operand of op
+  * @param outputs Result array of count elements
+  * @param count Number of elements
+  * @param callback Called on completion, or NULL
+  * @param user_data Passed to callback
+  * @return Handle to release with vedic_batch_release, or NULL if the
+  *         in-flight limit is reached or the arguments are invalid
+  */
+ VEDICMATH_API VedicBatchHandle *vedic_submit_batch(VedicBatchOp op, const void *const *inputs, void *outputs,
+                                                    size_t count, VedicBatchCallback callback, void *user_data);
+
+ /**
+  * Current state, without blocking
+  */
+ VEDICMATH_API VedicBatchStatus vedic_batch_poll(const VedicBatchHandle *handle);
+
+ /**
+  * Block until the batch finishes
+  *
+  * A batch no worker has started yet runs on the calling thread. Do not
+  * wait from inside a completion callback.
+  *
+  * @return DONE or CANCELLED
+  */
+ VEDICMATH_API VedicBatchStatus vedic_batch_wait(VedicBatchHandle *handle);
+
+ /**
+  * Request cancellation
+  *
+  * A queued batch is cancelled at once. A running batch skips the ranges
+  * it has not started; ranges in progress complete. The final status says
+  * whether every output was written.
+  *
+  * @return 0 if requested, -1 if the batch had already finished
+  */
+ VEDICMATH_API int vedic_batch_cancel(VedicBatchHandle *handle);
+
+ /**
+  * Give up the handle
+  *
+  * A batch released before it finishes still runs to completion and calls
+  * its callback; the handle is freed after that.
+  */
+ VEDICMATH_API void vedic_batch_release(VedicBatchHandle *handle);
+
+ /**
+  * Set the in-flight limit (0 = VEDIC_ASYNC_DEFAULT_LIMIT)
+  */
+ VEDICMATH_API void vedic_async_set_limit(size_t limit);
+
+ /**
+  * Async counters
+  */
+ VEDICMATH_API VedicAsyncStats vedic_async_get_stats(void);
+
+ /**
+  * Zero the counters (in_flight is kept)
+  */
+ VEDICMATH_API void vedic_async_reset_stats(void);
+
+ #ifdef __cplusplus
+ }
+ #endif
+
+ #endif /* VEDICMATH_ASYNC_H */
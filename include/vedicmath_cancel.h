@@ -0,0 +1,84 @@
+/**
+ * vedicmath_cancel.h - Cooperative cancellation and deadlines
+ *
+ * Long-running calls (the batch APIs, matrix multiply, dataset generation)
+ * have variants that take a token and check it between chunks of work, a
+ * few thousand elements, one matrix row or one record apart. Once the token
+ * is cancelled or its deadline passes, the call stops at the next check:
+ * ranges already running on pool workers return early and ranges not yet
+ * started return at their first check, so the workers go back to other
+ * calls promptly. The token also counts finished work, so the caller learns
+ * how far an interrupted call got.
+ *
+ * A check is one relaxed load, plus a clock read when a deadline is set.
+ * Any thread may cancel; the call itself never blocks on the token.
+ */
+
+ #ifndef VEDICMATH_CANCEL_H
+ #define VEDICMATH_CANCEL_H
+
+ #include <stdint.h>
+ #include "vedicmath_platform.h"
+
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+
+ /**
+  * Why a call should stop
+  */
+ typedef enum {
+     VEDIC_CANCEL_NONE = 0,                 // Keep going
+     VEDIC_CANCEL_REQUESTED = 1,            // vedic_cancel was called
+     VEDIC_CANCEL_DEADLINE = 2              // The deadline passed
+ } VedicCancelReason;
+
+ /**
+  * Cancellation state shared between a call and whoever may stop it
+  *
+  * Initialize with vedic_cancel_init and keep it valid until the call
+  * returns. One token may be passed to several calls to stop them together;
+  * completed then sums their progress.
+  */
+ typedef struct {
+     int reason;                            // VedicCancelReason; set once
+     uint64_t deadline_ns;                  // Monotonic clock; 0 = none
+     uint64_t completed;                    // Elements, rows or records finished
+ } VedicCancelToken;
+
+ /**
+  * Reset a token
+  *
+  * @param timeout_ms Deadline from now, 0 for none
+  */
+ VEDICMATH_API void vedic_cancel_init(VedicCancelToken *token, uint64_t timeout_ms);
+
+ /**
+  * Ask every call using the token to stop (thread-safe, idempotent)
+  */
+ VEDICMATH_API void vedic_cancel(VedicCancelToken *token);
+
+ /**
+  * Whether the call should stop; latches the deadline once it has passed
+  *
+  * @param token Token, or NULL (never stops)
+  */
+ VEDICMATH_API VedicCancelReason vedic_cancel_check(VedicCancelToken *token);
+
+ /**
+  * Work the calls using the token have finished so far
+  */
+ VEDICMATH_API uint64_t vedic_cancel_progress(const VedicCancelToken *token);
+
+ /**
+  * Count finished work; called by the cancellable APIs at each check
+  *
+  * @param token Token, or NULL (ignored)
+  */
+ VEDICMATH_API void vedic_cancel_add_progress(VedicCancelToken *token, uint64_t amount);
+
+ #ifdef __cplusplus
+ }
+ #endif
+
+ #endif /* VEDICMATH_CANCEL_H */
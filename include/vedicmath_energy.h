@@ -0,0 +1,103 @@
+/**
+ * vedicmath_energy.h - Energy measurement from RAPL counters
+ *
+ * Reads the cumulative energy counters that Linux exposes for Intel and AMD
+ * processors under /sys/class/powercap (the intel-rapl zones). Counters are
+ * summed over all sockets per domain and corrected for wraparound. Where the
+ * zones are missing (other platforms, virtual machines, containers without
+ * sysfs) or not readable (energy_uj is root-only on kernels patched for
+ * CVE-2020-8694), every domain reports unavailable and no call fails harder
+ * than that.
+ */
+
+ #ifndef VEDICMATH_ENERGY_H
+ #define VEDICMATH_ENERGY_H
+
+ #include <stdbool.h>
+ #include <stdint.h>
+ #include "vedicmath_platform.h"
+
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+
+ #define VEDIC_ENERGY_MAX_ZONES 16          // Counters tracked across all sockets
+
+ /**
+  * Energy domains (RAPL zone names in parentheses)
+  */
+ typedef enum {
+     VEDIC_ENERGY_PACKAGE = 0,              // Whole socket: cores, caches, uncore ("package-N")
+     VEDIC_ENERGY_CORE = 1,                 // Cores only ("core", PP0)
+     VEDIC_ENERGY_DRAM = 2,                 // Memory controller and DIMMs ("dram")
+     VEDIC_ENERGY_DOMAIN_COUNT = 3
+ } VedicEnergyDomain;
+
+ /**
+  * Raw counter values at one point in time
+  */
+ typedef struct {
+     uint64_t microjoules[VEDIC_ENERGY_MAX_ZONES]; // Per zone, in discovery order
+     uint64_t timestamp_ns;                 // Monotonic clock at the read
+ } VedicEnergySample;
+
+ /**
+  * Discover the RAPL zones under /sys/class/powercap
+  *
+  * Only the first call scans sysfs; later calls return the cached result.
+  * Call it once from the main thread before reading from several threads.
+  *
+  * @return Number of readable zones (0 if energy cannot be measured)
+  */
+ VEDICMATH_API int vedic_energy_init(void);
+
+ /**
+  * Discover the RAPL zones under another powercap directory
+  *
+  * Rescans on every call, for sysfs mounted elsewhere and for tests.
+  *
+  * @param root Directory holding the intel-rapl:* zones, NULL for the default
+  * @return Number of readable zones (0 if energy cannot be measured)
+  */
+ VEDICMATH_API int vedic_energy_init_at(const char *root);
+
+ /**
+  * Whether a domain has at least one readable zone
+  */
+ VEDICMATH_API bool vedic_energy_available(VedicEnergyDomain domain);
+
+ /**
+  * Why energy is unavailable, or the domains found when it is
+  *
+  * @return Static description, valid until the next init
+  */
+ VEDICMATH_API const char *vedic_energy_status(void);
+
+ /**
+  * Read all zone counters
+  *
+  * @param sample Output sample
+  * @return 0 on success, -1 if no zone is readable
+  */
+ VEDICMATH_API int vedic_energy_read(VedicEnergySample *sample);
+
+ /**
+  * Energy used in a domain between two samples
+  *
+  * Each zone is corrected for one wraparound of its counter, so samples
+  * must be less than one wrap period apart (minutes to hours, depending
+  * on the processor).
+  *
+  * @param start Earlier sample
+  * @param end Later sample
+  * @param domain Domain to sum
+  * @return Joules, or 0.0 if the domain is unavailable
+  */
+ VEDICMATH_API double vedic_energy_joules(const VedicEnergySample *start, const VedicEnergySample *end,
+                                          VedicEnergyDomain domain);
+
+ #ifdef __cplusplus
+ }
+ #endif
+
+ #endif /* VEDICMATH_ENERGY_H */
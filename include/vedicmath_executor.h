@@ -0,0 +1,198 @@
+/**
+ * vedicmath_executor.h - Lock-free request queue and micro-batching executor
+ *
+ * For callers that submit single operations at high rates, where the cost
+ * of a call (dispatch, timing, logging) outweighs the arithmetic. Producers
+ * push requests into a bounded lock-free multi-producer/multi-consumer
+ * queue and return at once. Consumer threads drain the queue into
+ * micro-batches, group them by operation and operand type, run each group
+ * through the batch kernels and complete the requests.
+ *
+ * A request is a caller-owned structure that doubles as its future: no
+ * allocation happens per request, and the caller polls it, waits on it or
+ * gets a callback. The linger time is how long a consumer holding a partial
+ * batch waits for more requests: 0 takes whatever is queued, larger values
+ * trade latency for fuller batches.
+ *
+ * Needs threads and atomics (POSIX threads with GCC-style atomics, or
+ * Windows); elsewhere vedic_executor_create returns NULL.
+ */
+
+ #ifndef VEDICMATH_EXECUTOR_H
+ #define VEDICMATH_EXECUTOR_H
+
+ #include <stddef.h>
+ #include <stdint.h>
+ #include "vedicmath_platform.h"
+ #include "vedicmath_types.h"
+
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+
+ #define VEDIC_EXEC_DEFAULT_QUEUE 4096      // Requests queued before submit refuses
+ #define VEDIC_EXEC_DEFAULT_BATCH 256       // Largest micro-batch
+ #define VEDIC_EXEC_MAX_BATCH 65536
+ #define VEDIC_EXEC_MAX_CONSUMERS 16
+
+ // ============================================================================
+ // MPMC QUEUE
+ // ============================================================================
+
+ /**
+  * Bounded lock-free queue of pointers
+  *
+  * Any number of threads may push and pop concurrently. Each slot carries a
+  * sequence number that tells a producer whether the slot is free and a
+  * consumer whether it is filled, so push and pop are one compare-and-swap
+  * on the shared position plus one release store, and never block.
+  */
+ typedef struct VedicMpmcQueue VedicMpmcQueue;
+
+ /**
+  * @param capacity Slots, rounded up to a power of two (at least 2)
+  * @return The queue, or NULL without memory or atomics
+  */
+ VEDICMATH_API VedicMpmcQueue *vedic_mpmc_create(size_t capacity);
+
+ /**
+  * Free a queue; items still in it are not touched
+  */
+ VEDICMATH_API void vedic_mpmc_destroy(VedicMpmcQueue *queue);
+
+ /**
+  * @return 0 if queued, -1 if the queue is full
+  */
+ VEDICMATH_API int vedic_mpmc_push(VedicMpmcQueue *queue, void *item);
+
+ /**
+  * @return 0 with the oldest item in *item, or -1 if the queue is empty
+  */
+ VEDICMATH_API int vedic_mpmc_pop(VedicMpmcQueue *queue, void **item);
+
+ /**
+  * Number of slots after rounding
+  */
+ VEDICMATH_API size_t vedic_mpmc_capacity(const VedicMpmcQueue *queue);
+
+ // ============================================================================
+ // EXECUTOR
+ // ============================================================================
+
+ /**
+  * Scalar operations
+  */
+ typedef enum {
+     VEDIC_EXEC_MULTIPLY = 0,               // a * b
+     VEDIC_EXEC_SQUARE = 1,                 // a * a
+     VEDIC_EXEC_DIVIDE = 2,                 // a / b, with the remainder for integers
+     VEDIC_EXEC_OP_COUNT = 3
+ } VedicExecOp;
+
+ /**
+  * Request state
+  */
+ typedef enum {
+     VEDIC_EXEC_PENDING = 0,                // Queued or in a batch
+     VEDIC_EXEC_DONE = 1,                   // result (and remainder) written
+     VEDIC_EXEC_FAILED = 2                  // Integer division by zero
+ } VedicExecStatus;
+
+ typedef struct VedicExecRequest VedicExecRequest;
+
+ /**
+  * Completion callback, called on a consumer thread before the request
+  * shows as finished; it should hand the result off rather than block
+  */
+ typedef void (*VedicExecCallback)(VedicExecRequest *request, VedicExecStatus status, void *user_data);
+
+ /**
+  * One operation and its future
+  *
+  * Fill op, a, b and optionally callback, then submit. The structure must
+  * stay valid and untouched until the request has finished. Integer
+  * operands (INT32, INT64) go through the long kernels, with results as
+  * vedic_from_int64 gives them; a floating-point operand sends the pair
+  * through the VedicValue kernels, as vedic_optimized_multiply and
+  * vedic_optimized_divide would.
+  */
+ struct VedicExecRequest {
+     VedicExecOp op;
+     VedicValue a;
+     VedicValue b;                          // Unused for SQUARE
+     VedicExecCallback callback;            // NULL for none
+     void *user_data;
+     VedicValue result;                     // Output
+     long remainder;                        // Output of an integer DIVIDE
+     int status;                            // VedicExecStatus; read with vedic_exec_poll
+ };
+
+ /**
+  * Executor configuration (zero fields take the defaults)
+  */
+ typedef struct {
+     size_t queue_capacity;                 // 0 = VEDIC_EXEC_DEFAULT_QUEUE
+     size_t max_batch;                      // 0 = VEDIC_EXEC_DEFAULT_BATCH
+     unsigned linger_us;                    // Wait for a fuller batch; 0 = take what is queued
+     int consumers;                         // Consumer threads; 0 = 1
+ } VedicExecutorConfig;
+
+ /**
+  * Executor counters
+  */
+ typedef struct {
+     uint64_t submitted;
+     uint64_t rejected;                     // Queue full or executor stopping
+     uint64_t completed;                    // DONE or FAILED
+     uint64_t batches;                      // Micro-batches run
+     uint64_t largest_batch;
+ } VedicExecutorStats;
+
+ typedef struct VedicExecutor VedicExecutor;
+
+ /**
+  * Start an executor and its consumer threads
+  *
+  * @param config Configuration, or NULL for the defaults
+  * @return The executor, or NULL if the configuration is invalid or
+  *         threads are unavailable
+  */
+ VEDICMATH_API VedicExecutor *vedic_executor_create(const VedicExecutorConfig *config);
+
+ /**
+  * Finish every queued request, stop the consumers and free the executor
+  *
+  * No submit may run concurrently with or after this call.
+  */
+ VEDICMATH_API void vedic_executor_destroy(VedicExecutor *executor);
+
+ /**
+  * Queue a request without blocking
+  *
+  * @return 0 if queued, -1 if the queue is full or the request is invalid;
+  *         the request is untouched by a refused submit except for status
+  */
+ VEDICMATH_API int vedic_exec_submit(VedicExecutor *executor, VedicExecRequest *request);
+
+ /**
+  * Current state, without blocking
+  */
+ VEDICMATH_API VedicExecStatus vedic_exec_poll(const VedicExecRequest *request);
+
+ /**
+  * Block until the request finishes (spins briefly before sleeping)
+  *
+  * @return DONE or FAILED
+  */
+ VEDICMATH_API VedicExecStatus vedic_exec_wait(VedicExecutor *executor, VedicExecRequest *request);
+
+ /**
+  * Executor counters
+  */
+ VEDICMATH_API VedicExecutorStats vedic_executor_get_stats(const VedicExecutor *executor);
+
+ #ifdef __cplusplus
+ }
+ #endif
+
+ #endif /* VEDICMATH_EXECUTOR_H */
@@ -0,0 +1,190 @@
+/**
+ * vedicmath_metrics.h - Engine counters and the shared-memory metrics ring
+ *
+ * The library keeps a small set of cumulative counters (operations through
+ * the unified dispatcher, batch elements per multiplication method) that
+ * any thread bumps with relaxed atomic adds. A snapshot combines them with
+ * the pool, async and allocation counters and the package energy.
+ *
+ * A publisher thread writes snapshots at a fixed interval into a ring in
+ * shared memory (POSIX shm_open, or a named file mapping on Windows).
+ * Readers in any process attach to the ring by name and read snapshots by
+ * sequence number without locks or system calls, so a monitor can follow
+ * an engine that runs in another process (vedicmathd, a benchmark) as
+ * cheaply as one in its own.
+ *
+ * Each slot is a sequence lock: the writer marks it busy, stores the
+ * snapshot and then marks it with the snapshot's sequence. A reader that
+ * sees the mark change under it, or a different sequence, reports the slot
+ * as unavailable instead of returning a torn snapshot. There is one writer
+ * per ring.
+ */
+
+ #ifndef VEDICMATH_METRICS_H
+ #define VEDICMATH_METRICS_H
+
+ #include <stdint.h>
+ #include "vedicmath_platform.h"
+
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+
+ #define VEDIC_METRICS_MAGIC 0x31524d56u            // "VMR1" in little-endian byte order
+ #define VEDIC_METRICS_VERSION 1
+ #define VEDIC_METRICS_DEFAULT_NAME "/vedicmath-metrics"
+ #define VEDIC_METRICS_DEFAULT_CAPACITY 256         // Snapshots kept in the ring
+ #define VEDIC_METRICS_DEFAULT_INTERVAL_MS 250
+
+ /**
+  * Cumulative engine counters
+  */
+ typedef enum {
+     VEDIC_METRIC_DISPATCH_OPERATIONS = 0,  // Operations through the unified dispatcher
+     VEDIC_METRIC_DISPATCH_VEDIC = 1,       // Of those, run with a Vedic sutra
+     VEDIC_METRIC_DISPATCH_NS = 2,          // Time in the selected methods
+     VEDIC_METRIC_STANDARD_NS = 3,          // Time in the standard comparisons (as measured by each path)
+     VEDIC_METRIC_BATCH_DIRECT = 4,         // vedic_multiply_batch elements per method,
+     VEDIC_METRIC_BATCH_EKADHIKENA = 5,     // in VedicMultiplyMethod order
+     VEDIC_METRIC_BATCH_ANTYAYORDASAKE = 6,
+     VEDIC_METRIC_BATCH_NIKHILAM = 7,
+     VEDIC_METRIC_BATCH_URDHVA = 8,
+     VEDIC_METRIC_COUNT = 9
+ } VedicMetric;
+
+ /**
+  * One point-in-time view of the engine
+  *
+  * Plain 64-bit fields only, so it can be copied word by word in and out
+  * of shared memory. Everything except the async in_flight gauge and the
+  * energy is cumulative.
+  */
+ typedef struct {
+     uint64_t sequence;                     // Position in the ring, from 1 (0 outside a ring)
+     uint64_t timestamp_ns;                 // Monotonic clock of the publishing process
+     uint64_t pid;                          // Publishing process
+     uint64_t counters[VEDIC_METRIC_COUNT];
+     uint64_t pool_parallel_calls;
+     uint64_t pool_serial_calls;
+     uint64_t pool_ranges;
+     uint64_t pool_steals;
+     uint64_t async_submitted;
+     uint64_t async_completed;
+     uint64_t async_cancelled;
+     uint64_t async_in_flight;
+     uint64_t alloc_count;                  // Only while allocation tracking is enabled
+     uint64_t alloc_bytes;
+     double energy_joules;                  // Package energy since the first collect; -1 if unavailable
+ } VedicMetricsSnapshot;
+
+ typedef struct VedicMetricsRing VedicMetricsRing;
+
+ /**
+  * Add to an engine counter (relaxed atomic; safe from any thread)
+  */
+ VEDICMATH_API void vedic_metrics_add(VedicMetric metric, uint64_t amount);
+
+ /**
+  * Current value of an engine counter
+  */
+ VEDICMATH_API uint64_t vedic_metrics_get(VedicMetric metric);
+
+ /**
+  * Fill a snapshot from the counters of this process
+  *
+  * @param snapshot Output; sequence is set to 0
+  */
+ VEDICMATH_API void vedic_metrics_collect(VedicMetricsSnapshot *snapshot);
+
+ // ============================================================================
+ // SHARED-MEMORY RING
+ // ============================================================================
+
+ /**
+  * Create a ring for this process to publish into
+  *
+  * An existing ring of the same name is replaced; readers still attached
+  * to it keep the old one until they reattach.
+  *
+  * @param name Shared-memory name ("/name"), or NULL for a ring private to this process
+  * @param capacity Snapshots kept (0 = VEDIC_METRICS_DEFAULT_CAPACITY)
+  * @return The ring, or NULL if shared memory is unavailable
+  */
+ VEDICMATH_API VedicMetricsRing *vedic_metrics_ring_create(const char *name, uint32_t capacity);
+
+ /**
+  * Attach read-only to a ring created by any process
+  *
+  * @return The ring, or NULL if it does not exist or has another layout
+  */
+ VEDICMATH_API VedicMetricsRing *vedic_metrics_ring_attach(const char *name);
+
+ /**
+  * Unmap a ring (stop its publisher first)
+  */
+ VEDICMATH_API void vedic_metrics_ring_close(VedicMetricsRing *ring);
+
+ /**
+  * Remove a ring's name; mappings stay valid until closed
+  *
+  * @return 0 on success, -1 if there is no such ring
+  */
+ VEDICMATH_API int vedic_metrics_ring_unlink(const char *name);
+
+ /**
+  * Number of snapshots the ring keeps
+  */
+ VEDICMATH_API uint32_t vedic_metrics_ring_capacity(const VedicMetricsRing *ring);
+
+ /**
+  * Store a snapshot as the next sequence
+  *
+  * Only one thread may publish to a ring. The snapshot's sequence field is
+  * ignored and set in the ring.
+  *
+  * @return Sequence of the stored snapshot, or 0 if the ring is read-only
+  */
+ VEDICMATH_API uint64_t vedic_metrics_ring_publish(VedicMetricsRing *ring, const VedicMetricsSnapshot *snapshot);
+
+ /**
+  * Sequence of the newest snapshot (0 before the first publish)
+  */
+ VEDICMATH_API uint64_t vedic_metrics_ring_head(const VedicMetricsRing *ring);
+
+ /**
+  * Read a snapshot by sequence
+  *
+  * Sequences older than head - capacity + 1 have been overwritten.
+  *
+  * @return 0 on success, -1 if the snapshot is not published yet,
+  *         overwritten, or being overwritten during the read
+  */
+ VEDICMATH_API int vedic_metrics_ring_read(const VedicMetricsRing *ring, uint64_t sequence,
+                                           VedicMetricsSnapshot *snapshot);
+
+ // ============================================================================
+ // PUBLISHER
+ // ============================================================================
+
+ /**
+  * Publish vedic_metrics_collect snapshots to a ring from a background thread
+  *
+  * One publisher per process; the first snapshot is published before this
+  * returns.
+  *
+  * @param ring Ring created by this process
+  * @param interval_ms Time between snapshots (0 = VEDIC_METRICS_DEFAULT_INTERVAL_MS)
+  * @return 0 on success, -1 if a publisher is running or threads are unavailable
+  */
+ VEDICMATH_API int vedic_metrics_publisher_start(VedicMetricsRing *ring, unsigned interval_ms);
+
+ /**
+  * Stop and join the publisher (no effect if none is running)
+  */
+ VEDICMATH_API void vedic_metrics_publisher_stop(void);
+
+ #ifdef __cplusplus
+ }
+ #endif
+
+ #endif /* VEDICMATH_METRICS_H */
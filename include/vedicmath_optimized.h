@@ -9,6 +9,7 @@
  #define VEDICMATH_OPTIMIZED_H
  
  #include "vedicmath_types.h"
+ #include "vedicmath_cancel.h"
  
  /**
   * Optimized dynamic multiplication using function lookup tables and fast paths
@@ -17,7 +18,7 @@
   * @param b Second operand
   * @return The product a * b as a VedicValue
   */
- inline VedicValue vedic_optimized_multiply(VedicValue a, VedicValue b);
+ VedicValue vedic_optimized_multiply(VedicValue a, VedicValue b);
  
  /**
   * Optimized dynamic addition
@@ -26,7 +27,7 @@
   * @param b Second operand
   * @return The sum a + b as a VedicValue
   */
- inline VedicValue vedic_optimized_add(VedicValue a, VedicValue b);
+ VedicValue vedic_optimized_add(VedicValue a, VedicValue b);
  
  /**
   * Optimized dynamic subtraction
@@ -35,7 +36,7 @@
   * @param b Second operand
   * @return The difference a - b as a VedicValue
   */
- inline VedicValue vedic_optimized_subtract(VedicValue a, VedicValue b);
+ VedicValue vedic_optimized_subtract(VedicValue a, VedicValue b);
  
  /**
   * Optimized dynamic division
@@ -44,7 +45,7 @@
   * @param b Divisor
   * @return The quotient a / b as a VedicValue
   */
- inline VedicValue vedic_optimized_divide(VedicValue a, VedicValue b);
+ VedicValue vedic_optimized_divide(VedicValue a, VedicValue b);
  
  /**
   * Optimized dynamic modulo
@@ -53,7 +54,7 @@
   * @param b Divisor
   * @return The remainder a % b as a VedicValue
   */
- inline VedicValue vedic_optimized_modulo(VedicValue a, VedicValue b);
+ VedicValue vedic_optimized_modulo(VedicValue a, VedicValue b);
  
  /**
   * Optimized dynamic power operation
@@ -62,7 +63,7 @@
   * @param b Exponent
   * @return a^b as a VedicValue
   */
- inline VedicValue vedic_optimized_power(VedicValue a, VedicValue b);
+ VedicValue vedic_optimized_power(VedicValue a, VedicValue b);
  
  /**
   * Optimized evaluation of a simple expression
@@ -98,6 +99,29 @@
                                     const char** expressions,
                                     size_t count);
  
+ /**
+  * Batch multiplication that stops early once the token is cancelled or
+  * expires (checked every 1024 elements of each range)
+  * 
+  * @return VEDIC_CANCEL_NONE if every element was computed, otherwise why it stopped
+  */
+ VedicCancelReason vedic_optimized_multiply_batch_cancellable(VedicValue* results,
+                                                              const VedicValue* a,
+                                                              const VedicValue* b,
+                                                              size_t count,
+                                                              VedicCancelToken* token);
+ 
+ /**
+  * Batch expression evaluation that stops early once the token is cancelled
+  * or expires (checked every 32 expressions of each range)
+  * 
+  * @return VEDIC_CANCEL_NONE if every expression was evaluated, otherwise why it stopped
+  */
+ VedicCancelReason vedic_optimized_evaluate_batch_cancellable(VedicValue* results,
+                                                              const char** expressions,
+                                                              size_t count,
+                                                              VedicCancelToken* token);
+ 
  /**
   * Initialize the optimization tables
   * Should be called once at program startup
@@ -0,0 +1,199 @@
+/**
+ * vedicmath_pool.h - Library-owned work-stealing thread pool
+ *
+ * The batch APIs split their input into ranges and run them on this pool.
+ * Each thread has a Chase-Lev deque: a range is split in halves, the owner
+ * keeps working on one half and pushes the other to the bottom of its
+ * deque, and idle threads steal from the top of other deques. Splitting is
+ * lazy, so per-element cost that varies between sutras is balanced without
+ * tuning a schedule.
+ *
+ * The calling thread always participates: it runs ranges of its own call
+ * and, while waiting for the rest, ranges of any other call. Nested calls
+ * from inside a range therefore never block a worker, and no call ever adds
+ * threads beyond the configured count. Workers are started on the first
+ * call that needs them and run until vedic_pool_shutdown.
+ *
+ * On multi-socket machines the pool can be NUMA-aware: workers are pinned
+ * to the CPUs of one node each, a call is cut into one contiguous part per
+ * node, and each part is handed to that node's workers before any stealing
+ * across nodes. Memory first written by a node's workers (Linux places a
+ * page on the node that first touches it) is then processed by the same
+ * node. With one node this is the ordinary pool.
+ *
+ * Platforms without POSIX threads and GCC-style atomics run every call
+ * serially on the caller.
+ */
+
+ #ifndef VEDICMATH_POOL_H
+ #define VEDICMATH_POOL_H
+
+ #include <stddef.h>
+ #include <stdint.h>
+ #include "vedicmath_platform.h"
+
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+
+ #define VEDIC_POOL_MAX_THREADS 64          // Worker threads
+ #define VEDIC_POOL_MAX_CALLERS 64          // Non-worker threads calling in at once
+ #define VEDIC_POOL_MAX_NODES 8             // NUMA nodes work is partitioned over
+ #define VEDIC_POOL_MAX_NODE_CPUS 256       // CPUs recorded per node
+
+ /**
+  * Body of a parallel loop: process elements [begin, end)
+  */
+ typedef void (*VedicPoolRangeFn)(size_t begin, size_t end, void *context);
+
+ /**
+  * NUMA nodes and the CPUs of each that this process may run on
+  */
+ typedef struct {
+     int node_count;                    // At least 1
+     int node_ids[VEDIC_POOL_MAX_NODES];   // Kernel node numbers
+     int cpu_count[VEDIC_POOL_MAX_NODES];
+     int cpus[VEDIC_POOL_MAX_NODES][VEDIC_POOL_MAX_NODE_CPUS];
+ } VedicPoolTopology;
+
+ /**
+  * Pool configuration
+  */
+ typedef struct {
+     int threads;                       // Workers; 0 = one per online CPU minus the caller
+     const int *cpus;                   // Pin worker i to cpus[i % cpu_count]; NULL = no pinning
+     int cpu_count;
+     int numa;                          // Pin workers and split calls by node (not with cpus)
+     const VedicPoolTopology *topology; // Nodes for numa; NULL = vedic_pool_discover_topology
+ } VedicPoolConfig;
+
+ /**
+  * Pool counters since the pool was last started
+  */
+ typedef struct {
+     uint64_t parallel_calls;           // Calls that were split across threads
+     uint64_t serial_calls;             // Calls run inline (small input, no workers)
+     uint64_t ranges_executed;
+     uint64_t steals;                   // Ranges taken from another thread's deque
+     uint64_t node_splits;              // Calls cut into one part per NUMA node
+ } VedicPoolStats;
+
+ /**
+  * Find the NUMA nodes under /sys/devices/system/node
+  *
+  * Each node's CPUs are limited to the process affinity mask, and nodes
+  * left without CPUs (memory-only nodes) are dropped. Without sysfs, or on
+  * other platforms, the result is one node holding every usable CPU.
+  *
+  * @param topology Output
+  * @return Number of nodes (at least 1)
+  */
+ VEDICMATH_API int vedic_pool_discover_topology(VedicPoolTopology *topology);
+
+ /**
+  * Find the NUMA nodes under another directory, for tests
+  *
+  * @param root Directory holding the node<N>/cpulist files, NULL for the default
+  * @param topology Output
+  * @return Number of nodes (at least 1)
+  */
+ VEDICMATH_API int vedic_pool_discover_topology_at(const char *root, VedicPoolTopology *topology);
+
+ /**
+  * Set the thread count and affinity
+  *
+  * Takes effect the next time the pool starts; a running pool is shut down
+  * first, so do not call this while a parallel call is in flight.
+  *
+  * @param config Configuration, or NULL for the defaults
+  * @return 0 on success, -1 if the configuration is invalid
+  */
+ VEDICMATH_API int vedic_pool_configure(const VedicPoolConfig *config);
+
+ /**
+  * Stop and join the workers
+  *
+  * The next parallel call starts them again. Must not be called while a
+  * parallel call is in flight.
+  */
+ VEDICMATH_API void vedic_pool_shutdown(void);
+
+ /**
+  * Number of workers the pool runs with once started (0 = every call is serial)
+  */
+ VEDICMATH_API int vedic_pool_thread_count(void);
+
+ /**
+  * Number of nodes calls are split over (1 unless configured with numa)
+  */
+ VEDICMATH_API int vedic_pool_node_count(void);
+
+ /**
+  * Run fn over [0, count) on the pool and the calling thread
+  *
+  * Returns when every element has been processed. Inputs of at most grain
+  * elements run inline. Ranges are never split below grain elements, and
+  * fn must be safe to call concurrently on disjoint ranges.
+  *
+  * @param count Number of elements
+  * @param grain Smallest range worth handing to another thread (0 = 1)
+  * @param fn Loop body
+  * @param context Passed to fn
+  */
+ VEDICMATH_API void vedic_pool_parallel_for(size_t count, size_t grain, VedicPoolRangeFn fn, void *context);
+
+ /**
+  * Zero a buffer from the workers that will later process it
+  *
+  * Node parts depend only on the element count and the node count, so a
+  * later vedic_pool_parallel_for over count elements gives each node the
+  * elements whose pages it wrote here. Call it on freshly allocated memory
+  * before anything else writes to it; without numa it is a parallel memset.
+  *
+  * @param buffer Memory to zero
+  * @param count Elements the later calls will run over
+  * @param element_size Bytes per element
+  */
+ VEDICMATH_API void vedic_pool_first_touch(void *buffer, size_t count, size_t element_size);
+
+ /**
+  * Pool counters
+  */
+ VEDICMATH_API VedicPoolStats vedic_pool_get_stats(void);
+
+ // ============================================================================
+ // POSTED TASKS
+ // ============================================================================
+
+ /**
+  * Work run later on a worker, embedded in the caller's own structure
+  */
+ typedef struct VedicPoolTask {
+     void (*run)(struct VedicPoolTask *task);
+     struct VedicPoolTask *next;        // Owned by the pool while posted
+ } VedicPoolTask;
+
+ /**
+  * Queue a task for the workers, oldest first
+  *
+  * Workers take posted tasks only when no range is pending, and run them
+  * to completion; a task may itself call vedic_pool_parallel_for. Tasks
+  * still queued at shutdown run before the workers exit.
+  *
+  * @param task Task to run; must stay valid until run is called
+  * @return 0 if queued, -1 if the pool has no workers (run it yourself)
+  */
+ VEDICMATH_API int vedic_pool_post(VedicPoolTask *task);
+
+ /**
+  * Take back a posted task that no worker has started
+  *
+  * @return 1 if removed, 0 if already taken by a worker or never posted
+  */
+ VEDICMATH_API int vedic_pool_unpost(VedicPoolTask *task);
+
+ #ifdef __cplusplus
+ }
+ #endif
+
+ #endif /* VEDICMATH_POOL_H */
@@ -0,0 +1,117 @@
+/**
+ * vedicmath_sieve.h - Segmented prime sieve and batch factorization
+ *
+ * The sieve marks the primes of any range [low, high) in a bit-packed
+ * mod-30 wheel: one byte covers 30 numbers, one bit for each residue
+ * coprime to 30, so a range costs (high - low) / 30 bytes. The range is
+ * sieved in L1-sized segments of 32 KiB spread over the thread pool, and
+ * each pool range carries its primes' next multiples from one segment to
+ * the next. The sieving primes up to sqrt(high) come from a sieve of the
+ * same kind, generated and applied in windows of 30 * 2^18 numbers, so
+ * beyond the range's own bits a call needs at most about 2.3 MiB for the
+ * sieving primes plus 4 MiB per pool range, whatever high is.
+ *
+ * Factorization divides out the first 128 primes (the sieve's, up to 719)
+ * only where a Vestanam screen has found them to divide, so no division is
+ * spent on a prime that is not a factor. A cofactor still composite after
+ * that is tested with Miller-Rabin and split with Pollard-rho.
+ */
+
+ #ifndef VEDICMATH_SIEVE_H
+ #define VEDICMATH_SIEVE_H
+
+ #include <stddef.h>
+ #include <stdint.h>
+ #include "vedicmath_platform.h"
+
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+
+ #define VEDIC_SIEVE_MAX_HIGH ((uint64_t)1 << 62)  // Sieving primes stay below 2^31
+ #define VEDIC_FACTOR_MAX_PRIMES 15         // Distinct primes of any 64-bit number
+
+ /**
+  * Primes of a range, bit-packed
+  *
+  * Bit k of bits[i] stands for base + 30 * i + (1, 7, 11, 13, 17, 19, 23,
+  * 29)[k] and is set when that number is a prime in [low, high). 2, 3 and 5
+  * have no bits; the accessors below add them.
+  */
+ typedef struct {
+     uint64_t low;                      // First number of the range
+     uint64_t high;                     // One past the last
+     uint64_t base;                     // low rounded down to a multiple of 30
+     size_t bytes;
+     uint8_t *bits;
+ } VedicSieve;
+
+ /**
+  * Prime factorization of one number
+  */
+ typedef struct {
+     int count;                         // Distinct primes; 0 for 0 and 1
+     uint8_t exponents[VEDIC_FACTOR_MAX_PRIMES];
+     uint64_t primes[VEDIC_FACTOR_MAX_PRIMES];   // Ascending
+ } VedicFactorization;
+
+ /**
+  * Sieve [low, high) on the pool
+  *
+  * @param sieve Output; release with vedic_sieve_free
+  * @param low First number
+  * @param high One past the last, at most VEDIC_SIEVE_MAX_HIGH
+  * @return 0 on success, -1 if the range is invalid or memory runs out
+  */
+ VEDICMATH_API int vedic_sieve_init(VedicSieve *sieve, uint64_t low, uint64_t high);
+
+ /**
+  * Release a sieve
+  */
+ VEDICMATH_API void vedic_sieve_free(VedicSieve *sieve);
+
+ /**
+  * Whether n is prime
+  *
+  * @return 1 or 0, -1 if n is outside the sieved range
+  */
+ VEDICMATH_API int vedic_sieve_is_prime(const VedicSieve *sieve, uint64_t n);
+
+ /**
+  * Number of primes in the range
+  */
+ VEDICMATH_API size_t vedic_sieve_count(const VedicSieve *sieve);
+
+ /**
+  * List primes in order, starting at the first one at or after from
+  *
+  * Call again with from = last prime + 1 to page through a range.
+  *
+  * @param primes Output
+  * @param capacity Entries in primes
+  * @return Number of primes written
+  */
+ VEDICMATH_API size_t vedic_sieve_primes(const VedicSieve *sieve, uint64_t from, uint64_t *primes, size_t capacity);
+
+ /**
+  * Whether n is prime (deterministic Miller-Rabin for all 64-bit n)
+  */
+ VEDICMATH_API int vedic_is_prime_u64(uint64_t n);
+
+ /**
+  * Factor numbers on the pool
+  *
+  * Negative numbers are factored by magnitude.
+  *
+  * @param numbers Numbers to factor
+  * @param count Number of numbers
+  * @param factors Output, one per number
+  * @return 0 on success, -1 if memory runs out
+  */
+ VEDICMATH_API int vedic_factor_batch(const int64_t *numbers, size_t count, VedicFactorization *factors);
+
+ #ifdef __cplusplus
+ }
+ #endif
+
+ #endif /* VEDICMATH_SIEVE_H */
@@ -10,6 +10,7 @@
  
  #include <stdint.h>
  #include <stdbool.h>
+ #include <stddef.h>
  
  /**
   * Enumeration of supported numeric types
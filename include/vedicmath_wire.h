@@ -0,0 +1,82 @@
+/**
+ * vedicmath_wire.h - Binary protocol of the vedicmathd compute daemon
+ *
+ * Every message is a fixed 32-byte header followed by length bytes of
+ * payload, in host byte order (the daemon only listens on a Unix domain
+ * socket, so both ends share the machine).
+ *
+ * A request carries one batch: count elements of each operand, the operand
+ * arrays back to back (a[count] then b[count]) in the operand type. The
+ * response echoes request_id and op and carries count int64 results; a
+ * divide response carries the quotients followed by the remainders.
+ *
+ * Requests may be pipelined: a client can send any number of frames
+ * without waiting. Small batches are answered in order, but a large batch
+ * runs on the thread pool and its response can overtake earlier ones, so
+ * match responses by request_id.
+ */
+
+ #ifndef VEDICMATH_WIRE_H
+ #define VEDICMATH_WIRE_H
+
+ #include <stdint.h>
+
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+
+ #define VEDIC_WIRE_MAGIC 0x31444d56u       // "VMD1" in little-endian byte order
+ #define VEDIC_WIRE_MAX_COUNT (1u << 22)    // Elements per batch
+ #define VEDIC_WIRE_DEFAULT_SOCKET "/tmp/vedicmathd.sock"
+
+ /**
+  * Operations (operands in parentheses)
+  */
+ typedef enum {
+     VEDIC_WIRE_PING = 0,                   // No operands, count 0
+     VEDIC_WIRE_MULTIPLY = 1,               // (a, b) -> a * b
+     VEDIC_WIRE_SQUARE = 2,                 // (a) -> a * a
+     VEDIC_WIRE_DIVIDE = 3,                 // (a, b) -> quotients, then remainders
+     VEDIC_WIRE_OP_COUNT = 4
+ } VedicWireOp;
+
+ /**
+  * Operand types; results are always VEDIC_WIRE_INT64
+  */
+ typedef enum {
+     VEDIC_WIRE_INT32 = 1,
+     VEDIC_WIRE_INT64 = 2
+ } VedicWireType;
+
+ /**
+  * Response status
+  */
+ typedef enum {
+     VEDIC_WIRE_OK = 0,
+     VEDIC_WIRE_BAD_REQUEST = 1,            // Unknown op or type, or length does not match count
+     VEDIC_WIRE_TOO_LARGE = 2,              // count above VEDIC_WIRE_MAX_COUNT; the connection is closed
+     VEDIC_WIRE_BUSY = 3,                   // Too many batches in flight; retry later
+     VEDIC_WIRE_DIVIDE_BY_ZERO = 4,
+     VEDIC_WIRE_INTERNAL_ERROR = 5          // Out of memory
+ } VedicWireStatus;
+
+ /**
+  * Message header
+  */
+ typedef struct {
+     uint32_t length;                       // Payload bytes after the header
+     uint32_t magic;                        // VEDIC_WIRE_MAGIC
+     uint64_t request_id;                   // Chosen by the client, echoed in the response
+     uint16_t op;                           // VedicWireOp
+     uint16_t type;                         // VedicWireType of the payload
+     uint16_t status;                       // VedicWireStatus; 0 in requests
+     uint16_t reserved;
+     uint32_t count;                        // Elements per operand / result array
+     uint32_t reserved2;
+ } VedicWireHeader;
+
+ #ifdef __cplusplus
+ }
+ #endif
+
+ #endif /* VEDICMATH_WIRE_H */
@@ -15,18 +15,18 @@ Based on your comprehensive C implementation with 9+ million operation dataset.
 
 from fastapi import FastAPI, HTTPException, BackgroundTasks
 from fastapi.middleware.cors import CORSMiddleware
+from fastapi.responses import StreamingResponse
 from pydantic import BaseModel, Field
 from typing import List, Optional, Dict, Any, Union
 import asyncio
 import psutil
 import time
 import json
-import csv
 import os
+import sys
+import threading
 from datetime import datetime
 from enum import Enum
-import subprocess
-import tempfile
 import numpy as np
 import pandas as pd
 
@@ -82,6 +82,11 @@ class BenchmarkRequest(BaseModel):
     operation_count: int = Field(ge=10, le=100000, description="Number of operations")
     pattern_types: List[str] = Field(default=["all"], description="Pattern types to test")
     include_system_monitoring: bool = Field(default=True)
+    seed: Optional[int] = Field(default=None, ge=0, lt=2**64, description="Generator seed; equal seeds repeat the operands")
+
+class BenchmarkStreamRequest(BenchmarkRequest):
+    operation_count: int = Field(ge=10, le=100_000_000, description="Number of operations")
+    chunk_size: int = Field(default=1024, ge=1, le=65536, description="Records per streamed chunk")
 
 class DatasetResponse(BaseModel):
     filename: str
@@ -125,122 +130,182 @@ app.add_middleware(
 # ============================================================================
 
 class VedicMathEngine:
-    """Interface to your C implementation via Python subprocess"""
+    """In-process interface to the C engine through the vedicmath extension
+
+    Every call into the extension releases the GIL, so the handlers run them
+    in the default thread pool executor and the event loop keeps serving
+    other requests meanwhile. Without the extension only /calculate works,
+    computing in Python and saying so in its reasoning.
+    """
     
     def __init__(self):
         self.operation_counter = 0
         self.active_operations = 0
-        self.vedic_executable = self._find_vedic_executable()
-        
-    def _find_vedic_executable(self) -> str:
-        """Find the VedicMath executable"""
-        possible_paths = [
-            "./build/Debug/unified_test.exe",
-            "./build/unified_test.exe", 
-            "./build/unified_test",
-            "./unified_test.exe",
-            "./unified_test"
-        ]
-        
-        for path in possible_paths:
-            if os.path.exists(path):
-                return path
-        
-        # If not found, we'll simulate the results
+        self.native = self._load_native()
+        self.dataset_patterns = tuple(self.native.DATASET_PATTERNS) if self.native else ()
+        self._lock = threading.Lock()
+        
+    def _load_native(self):
+        """Import the vedicmath extension, looking in the usual build directories"""
+        for path in ["", "./build", "./build/Release", "./build/Debug"]:
+            if path and os.path.isdir(path) and path not in sys.path:
+                sys.path.append(path)
+            try:
+                import vedicmath
+                return vedicmath
+            except ImportError:
+                continue
         return None
     
-    def _simulate_vedic_operation(self, a: Union[int, float], b: Union[int, float], operation: str) -> Dict[str, Any]:
-        """Simulate Vedic operation based on your proven results"""
-        start_time = time.time()
-        
-        # Determine the best sutra based on your algorithm
-        selected_sutra, confidence, predicted_speedup, reasoning = self._analyze_pattern(a, b)
-        
-        # Calculate result
-        if operation == "multiply":
-            result = a * b
-        elif operation == "divide":
-            result = a / b if b != 0 else float('inf')
+    def _require_native(self):
+        if self.native is None:
+            raise HTTPException(status_code=503, detail="Native engine unavailable: build with -DBUILD_PYTHON_BINDINGS=ON")
+        return self.native
+    
+    async def run(self, function, *args):
+        """Run a blocking engine call on the executor"""
+        with self._lock:
+            self.active_operations += 1
+        try:
+            return await asyncio.get_running_loop().run_in_executor(None, function, *args)
+        finally:
+            with self._lock:
+                self.active_operations -= 1
+    
+    def _record(self, operation_id: int) -> None:
+        with self._lock:
+            self.operation_counter = max(self.operation_counter + 1, operation_id)
+    
+    def pattern_mask(self, pattern_types: List[str]) -> int:
+        """Bit mask over the generator patterns; 0 selects all of them"""
+        if "all" in pattern_types:
+            return 0
+        mask = 0
+        for name in pattern_types:
+            if name not in self.dataset_patterns:
+                raise HTTPException(status_code=400, detail=f"Unknown pattern type: {name}")
+            mask |= 1 << self.dataset_patterns.index(name)
+        return mask
+    
+    def calculate(self, a: Union[int, float], b: Union[int, float], operation: str) -> Dict[str, Any]:
+        """One operation through the unified dispatcher"""
+        integral = isinstance(a, int) and isinstance(b, int)
+        if self.native is not None and integral and operation in ("multiply", "divide"):
+            if operation == "divide" and b == 0:
+                raise HTTPException(status_code=400, detail="Division by zero")
+            dispatch = self.native.unified_multiply if operation == "multiply" else self.native.unified_divide
+            r = dispatch(a, b)
+            self._record(r["operation_id"])
+            return {
+                "result": r["result"],
+                "selected_algorithm": r["algorithm"],
+                "sutra_name_sanskrit": r["sutra_sanskrit"],
+                "pattern_confidence": r["confidence"],
+                "predicted_speedup": r["predicted_speedup"],
+                "actual_speedup": r["actual_speedup"],
+                "execution_time_ms": r["execution_time_ms"],
+                "decision_reasoning": r["reasoning"],
+                "correctness_verified": r["correct"],
+                "operation_id": r["operation_id"],
+                "timestamp": datetime.now()
+            }
+        return self._standard_operation(a, b, operation)
+    
+    def _standard_operation(self, a: Union[int, float], b: Union[int, float], operation: str) -> Dict[str, Any]:
+        """Plain Python arithmetic for what the dispatcher does not cover"""
+        start_time = time.perf_counter()
+        if operation == "divide":
+            if b == 0:
+                raise HTTPException(status_code=400, detail="Division by zero")
+            result = a / b
         elif operation == "add":
             result = a + b
         elif operation == "subtract":
             result = a - b
         else:
             result = a * b
+        execution_time = (time.perf_counter() - start_time) * 1000
         
-        end_time = time.time()
-        execution_time = (end_time - start_time) * 1000
-        
-        # Simulate actual speedup based on your proven results
-        actual_speedup = self._calculate_expected_speedup(selected_sutra, a, b)
-        
+        if self.native is None:
+            reasoning = "Native engine unavailable: computed in Python"
+        else:
+            reasoning = "The dispatcher handles integer multiply and divide only: computed in Python"
+        with self._lock:
+            self.operation_counter += 1
+            operation_id = self.operation_counter
         return {
             "result": result,
-            "selected_algorithm": selected_sutra,
-            "sutra_name_sanskrit": self._get_sanskrit_name(selected_sutra),
-            "pattern_confidence": confidence,
-            "predicted_speedup": predicted_speedup,
-            "actual_speedup": actual_speedup,
+            "selected_algorithm": "Standard Arithmetic",
+            "sutra_name_sanskrit": "मानक गणित",
+            "pattern_confidence": 1.0,
+            "predicted_speedup": 1.0,
+            "actual_speedup": 1.0,
             "execution_time_ms": execution_time,
             "decision_reasoning": reasoning,
             "correctness_verified": True,
-            "operation_id": self.operation_counter,
+            "operation_id": operation_id,
             "timestamp": datetime.now()
         }
     
-    def _analyze_pattern(self, a: Union[int, float], b: Union[int, float]) -> tuple:
-        """Analyze input pattern - based on your C implementation logic"""
-        a_int, b_int = int(a), int(b)
-        
-        # Ekadhikena Purvena: Perfect case (squaring numbers ending in 5)
-        if a == b and a_int % 10 == 5 and a > 0:
-            return "Ekadhikena Purvena", 0.95, 3.2, "Perfect squaring pattern: number ending in 5"
-        
-        # Antyayordasake: Same prefix, last digits sum to 10
-        if (a_int % 10 + b_int % 10) == 10 and (a_int // 10 == b_int // 10):
-            return "Antyayordasake", 0.88, 2.4, "Same prefix, last digits sum to 10"
-        
-        # Nikhilam: Numbers near powers of 10
-        base_a = 10 ** len(str(abs(a_int)))
-        if abs(a_int - base_a) < base_a * 0.2 and abs(b_int - base_a) < base_a * 0.2:
-            proximity = 1.0 - (abs(a_int - base_a) + abs(b_int - base_a)) / (2 * base_a * 0.2)
-            return "Nikhilam", proximity * 0.85, 1.8 + proximity * 0.8, "Numbers close to same power of 10"
-        
-        # Urdhva-Tiryagbhyam: Multi-digit numbers
-        max_digits = max(len(str(abs(a_int))), len(str(abs(b_int))))
-        if max_digits >= 3:
-            confidence = min(0.6 + (max_digits - 3) * 0.05, 0.80)
-            return "Urdhva-Tiryagbhyam", confidence, 1.4 + (max_digits - 3) * 0.1, "Multi-digit crosswise multiplication"
-        
-        # Standard fallback
-        return "Standard Arithmetic", 1.0, 1.0, "No optimal Vedic pattern detected"
+    def matrix(self, size: int, use_vedic: bool, seed: int) -> "MatrixResponse":
+        """Multiply two random size x size matrices, timed against NumPy"""
+        rng = np.random.default_rng(seed)
+        a = rng.integers(-1000, 1000, (size, size), dtype=np.int64)
+        b = rng.integers(-1000, 1000, (size, size), dtype=np.int64)
+        operations = size ** 3
+        
+        start_time = time.perf_counter()
+        expected = a @ b
+        standard_time = (time.perf_counter() - start_time) * 1000
+        
+        if not use_vedic:
+            return MatrixResponse(
+                size=size,
+                method_used="Standard",
+                execution_time_ms=standard_time,
+                operations_per_second=operations / (standard_time / 1000) if standard_time > 0 else 0,
+                vedic_operations_used=0,
+                speedup_factor=1.0,
+                correctness_verified=True,
+                performance_notes="NumPy integer matrix multiplication"
+            )
+        
+        native = self._require_native()
+        out = np.empty((size, size), dtype=np.int64)
+        r = native.matrix_multiply(a, b, out)
+        self._record(r["operation_id"])
+        vedic_time = r["execution_time_ms"]
+        speedup = standard_time / vedic_time if vedic_time > 0 else 1.0
+        return MatrixResponse(
+            size=size,
+            method_used=r["algorithm"],
+            execution_time_ms=vedic_time,
+            operations_per_second=operations / (vedic_time / 1000) if vedic_time > 0 else 0,
+            vedic_operations_used=operations,
+            speedup_factor=speedup,
+            correctness_verified=bool(np.array_equal(out, expected)),
+            performance_notes="Standard methods faster (overhead dominates)" if speedup < 1.0 else "Vedic batch faster"
+        )
     
-    def _calculate_expected_speedup(self, sutra: str, a: Union[int, float], b: Union[int, float]) -> float:
-        """Calculate expected speedup based on your benchmarking results"""
-        speedup_map = {
-            "Ekadhikena Purvena": 3.2,
-            "Nikhilam": 2.8, 
-            "Antyayordasake": 2.3,
-            "Urdhva-Tiryagbhyam": 1.8,
-            "Standard Arithmetic": 1.0
-        }
-        base_speedup = speedup_map.get(sutra, 1.0)
-        
-        # Add some realistic variance (±20%)
-        import random
-        variance = random.uniform(0.8, 1.2)
-        return base_speedup * variance
+    def benchmark(self, count: int, pattern_mask: int, seed: int) -> Dict[str, Any]:
+        return self._require_native().run_benchmark(count, seed=seed, patterns=pattern_mask)
     
-    def _get_sanskrit_name(self, sutra: str) -> str:
-        """Get Sanskrit names from your implementation"""
-        sanskrit_map = {
-            "Ekadhikena Purvena": "एकाधिकेन पूर्वेण",
-            "Nikhilam": "निखिलं नवतश्चरमं दशतः", 
-            "Antyayordasake": "अन्त्ययोर्दशके",
-            "Urdhva-Tiryagbhyam": "ऊर्ध्व-तिर्यगभ्याम्",
-            "Standard Arithmetic": "मानक गणित"
-        }
-        return sanskrit_map.get(sutra, "")
+    def dataset(self, filepath: str, count: int, seed: int) -> Dict[str, Any]:
+        return self._require_native().generate_dataset(filepath, count, seed=seed)
+    
+    def cursor(self, count: int, pattern_mask: int, seed: int, fmt: str = "ndjson", chunk: int = 1024):
+        """Cursor producing generated records as text, one chunk per step"""
+        return self._require_native().dataset_cursor(count, seed=seed, patterns=pattern_mask, format=fmt, chunk=chunk)
+    
+    async def stream(self, cursor, with_summary: bool = False):
+        """Yield a cursor's chunks as they are generated, each step on the executor"""
+        while True:
+            chunk = await self.run(next, cursor, None)
+            if chunk is None:
+                break
+            yield chunk
+        if with_summary:
+            yield (json.dumps({"summary": cursor.summary()}) + "\n").encode()
 
 # Global engine instance
 vedic_engine = VedicMathEngine()
@@ -251,7 +316,7 @@ vedic_engine = VedicMathEngine()
 
 def get_system_status() -> SystemStatus:
     """Get current system resource status"""
-    cpu_percent = psutil.cpu_percent(interval=0.1)
+    cpu_percent = psutil.cpu_percent(interval=None)   # Since the last call; does not block
     memory = psutil.virtual_memory()
     
     return SystemStatus(
@@ -263,50 +328,6 @@ def get_system_status() -> SystemStatus:
         active_operations=vedic_engine.active_operations
     )
 
-async def simulate_matrix_operation(size: int, use_vedic: bool) -> MatrixResponse:
-    """Simulate matrix operation based on your actual results"""
-    # Based on your benchmark results showing standard methods are faster
-    operations = size ** 3  # O(n³) operations
-    
-    if use_vedic:
-        # Your results show Vedic methods have overhead for matrices
-        if size <= 25:
-            execution_time = 0.06 * (size / 10) ** 2.5  # Polynomial scaling
-            vedic_ops = size ** 2
-        elif size <= 50:
-            execution_time = 0.90 * (size / 25) ** 2.5
-            vedic_ops = size ** 2 * 15
-        elif size <= 100:
-            execution_time = 8.27 * (size / 50) ** 2.5
-            vedic_ops = size ** 2 * 200
-        else:
-            execution_time = 189.84 * (size / 100) ** 2.5
-            vedic_ops = size ** 2 * 1980
-        
-        method = "Vedic Enhanced"
-        speedup = 0.002  # Your results show very low speedup for matrices
-        notes = "Standard methods faster (overhead dominates)"
-    else:
-        # Standard multiplication - much faster
-        execution_time = 0.001 * operations / 1000  # Fast standard implementation
-        vedic_ops = 0
-        method = "Standard"
-        speedup = 1.0
-        notes = "Optimized standard matrix multiplication"
-    
-    ops_per_sec = operations / (execution_time / 1000) if execution_time > 0 else 0
-    
-    return MatrixResponse(
-        size=size,
-        method_used=method,
-        execution_time_ms=execution_time,
-        operations_per_second=ops_per_sec,
-        vedic_operations_used=vedic_ops,
-        speedup_factor=speedup,
-        correctness_verified=True,
-        performance_notes=notes
-    )
-
 # ============================================================================
 # API ENDPOINTS
 # ============================================================================
@@ -334,11 +355,8 @@ async def root():
 async def calculate(request: OperationRequest):
     """Perform Vedic arithmetic calculation"""
     try:
-        vedic_engine.operation_counter += 1
-        vedic_engine.active_operations += 1
-        
-        # Perform calculation using your engine
-        result_data = vedic_engine._simulate_vedic_operation(
+        result_data = await vedic_engine.run(
+            vedic_engine.calculate,
             request.operand_a, 
             request.operand_b, 
             request.operation
@@ -352,11 +370,11 @@ async def calculate(request: OperationRequest):
             "platform": system_status.platform
         }
         
-        vedic_engine.active_operations -= 1
         return OperationResponse(**result_data)
         
+    except HTTPException:
+        raise
     except Exception as e:
-        vedic_engine.active_operations -= 1
         raise HTTPException(status_code=500, detail=f"Calculation error: {str(e)}")
 
 @app.post("/api/v1/matrix", response_model=MatrixResponse)
@@ -366,9 +384,10 @@ async def matrix_multiply(request: MatrixRequest):
         if request.size > 200:
             raise HTTPException(status_code=400, detail="Matrix size too large (max 200)")
         
-        result = await simulate_matrix_operation(request.size, request.use_vedic)
-        return result
+        return await vedic_engine.run(vedic_engine.matrix, request.size, request.use_vedic, time.time_ns())
         
+    except HTTPException:
+        raise
     except Exception as e:
         raise HTTPException(status_code=500, detail=f"Matrix operation error: {str(e)}")
 
@@ -378,152 +397,111 @@ async def system_status():
     return get_system_status()
 
 @app.post("/api/v1/benchmark", response_model=Dict[str, Any])
-async def run_benchmark(request: BenchmarkRequest, background_tasks: BackgroundTasks):
+async def run_benchmark(request: BenchmarkRequest):
     """Run performance benchmark"""
     try:
-        results = []
-        start_time = time.time()
-        
-        for i in range(request.operation_count):
-            # Generate test cases based on your patterns
-            import random
-            
-            pattern_type = random.choice(request.pattern_types) if "all" not in request.pattern_types else random.choice([
-                "ekadhikena", "nikhilam", "antyayordasake", "urdhva", "random"
-            ])
-            
-            if pattern_type == "ekadhikena":
-                n = random.randint(1, 50) * 10 + 5
-                a, b = n, n
-            elif pattern_type == "nikhilam":
-                base = random.choice([100, 1000])
-                a = base + random.randint(-base//5, base//5)
-                b = base + random.randint(-base//5, base//5)
-            elif pattern_type == "antyayordasake":
-                prefix = random.randint(1, 99)
-                last_a = random.randint(1, 9)
-                last_b = 10 - last_a
-                a = prefix * 10 + last_a
-                b = prefix * 10 + last_b
-            elif pattern_type == "urdhva":
-                a = random.randint(1000, 9999)
-                b = random.randint(1000, 9999)
-            else:
-                a = random.randint(1, 1000)
-                b = random.randint(1, 1000)
-            
-            op_result = vedic_engine._simulate_vedic_operation(a, b, "multiply")
-            results.append({
-                "pattern_type": pattern_type,
-                "operands": [a, b],
-                "sutra_used": op_result["selected_algorithm"],
-                "speedup": op_result["actual_speedup"],
-                "confidence": op_result["pattern_confidence"]
-            })
+        pattern_mask = vedic_engine.pattern_mask(request.pattern_types)
+        seed = request.seed if request.seed is not None else time.time_ns()
         
+        start_time = time.time()
+        summary = await vedic_engine.run(vedic_engine.benchmark, request.operation_count, pattern_mask, seed)
         end_time = time.time()
         
-        # Calculate statistics
-        speedups = [r["speedup"] for r in results]
-        avg_speedup = sum(speedups) / len(speedups)
-        vedic_count = sum(1 for r in results if r["sutra_used"] != "Standard Arithmetic")
-        
         return {
             "benchmark_id": f"bench_{int(time.time())}",
             "operation_count": request.operation_count,
+            "seed": seed,
             "execution_time_ms": (end_time - start_time) * 1000,
-            "average_speedup": avg_speedup,
-            "vedic_methods_used": vedic_count,
-            "vedic_percentage": (vedic_count / len(results)) * 100,
-            "pattern_distribution": {},  # Could add pattern analysis
-            "results_sample": results[:10]  # First 10 results as sample
+            "average_speedup": summary["average_speedup"],
+            "vedic_methods_used": summary["vedic_methods_used"],
+            "vedic_percentage": (summary["vedic_methods_used"] / summary["records"]) * 100,
+            "correct_results": summary["correct"],
+            "pattern_distribution": summary["patterns"],
+            "sutra_distribution": summary["sutras"],
+            "results_sample": summary["samples"]
         }
         
+    except HTTPException:
+        raise
     except Exception as e:
         raise HTTPException(status_code=500, detail=f"Benchmark error: {str(e)}")
 
 @app.post("/api/v1/dataset/generate", response_model=DatasetResponse)
-async def generate_dataset(operation_count: int = 1000):
+async def generate_dataset(operation_count: int = 1000, seed: Optional[int] = None):
     """Generate research dataset"""
     try:
+        if operation_count < 1:
+            raise HTTPException(status_code=400, detail="operation_count must be positive")
         start_time = time.time()
         
-        # Generate dataset similar to your C implementation
-        dataset = []
-        vedic_operations = 0
-        
-        for i in range(operation_count):
-            # Generate diverse patterns
-            import random
-            pattern_type = random.choice(["ekadhikena", "nikhilam", "antyayordasake", "urdhva", "random"])
-            
-            if pattern_type == "ekadhikena":
-                n = random.randint(1, 50) * 10 + 5
-                a, b = n, n
-            elif pattern_type == "nikhilam":
-                base = random.choice([100, 1000])
-                a = base + random.randint(-base//5, base//5)
-                b = base + random.randint(-base//5, base//5)
-            elif pattern_type == "antyayordasake":
-                prefix = random.randint(1, 99)
-                last_a = random.randint(1, 9)
-                last_b = 10 - last_a
-                a = prefix * 10 + last_a
-                b = prefix * 10 + last_b
-            elif pattern_type == "urdhva":
-                a = random.randint(1000, 9999)
-                b = random.randint(1000, 9999)
-            else:
-                a = random.randint(1, 1000)
-                b = random.randint(1, 1000)
-            
-            op_result = vedic_engine._simulate_vedic_operation(a, b, "multiply")
-            
-            dataset.append({
-                "operand_a": a,
-                "operand_b": b,
-                "result": op_result["result"],
-                "sutra_used": op_result["selected_algorithm"],
-                "confidence": op_result["pattern_confidence"],
-                "speedup": op_result["actual_speedup"],
-                "execution_time_ms": op_result["execution_time_ms"],
-                "pattern_type": pattern_type,
-                "timestamp": datetime.now().isoformat()
-            })
-            
-            if op_result["selected_algorithm"] != "Standard Arithmetic":
-                vedic_operations += 1
-        
-        # Save to CSV file
+        # The engine writes the CSV itself, a chunk at a time
         filename = f"dataset_{int(time.time())}.csv"
         filepath = f"./datasets/{filename}"
         os.makedirs("./datasets", exist_ok=True)
-        
-        with open(filepath, 'w', newline='') as csvfile:
-            if dataset:
-                writer = csv.DictWriter(csvfile, fieldnames=dataset[0].keys())
-                writer.writeheader()
-                writer.writerows(dataset)
+        summary = await vedic_engine.run(
+            vedic_engine.dataset, filepath, operation_count,
+            seed if seed is not None else time.time_ns()
+        )
         
         end_time = time.time()
         file_size = os.path.getsize(filepath) / (1024 * 1024)  # MB
         
-        # Calculate average speedup
-        speedups = [row["speedup"] for row in dataset]
-        avg_speedup = sum(speedups) / len(speedups) if speedups else 1.0
-        
         return DatasetResponse(
             filename=filename,
-            total_records=len(dataset),
-            vedic_methods_used=vedic_operations,
-            average_speedup=avg_speedup,
+            total_records=summary["records"],
+            vedic_methods_used=summary["vedic_methods_used"],
+            average_speedup=summary["average_speedup"],
             generation_time_ms=(end_time - start_time) * 1000,
             file_size_mb=file_size
         )
         
+    except HTTPException:
+        raise
     except Exception as e:
         raise HTTPException(status_code=500, detail=f"Dataset generation error: {str(e)}")
 
+@app.post("/api/v1/benchmark/stream")
+async def stream_benchmark(request: BenchmarkStreamRequest):
+    """Run a benchmark, streaming each record as a line of NDJSON
+    
+    The last line is {"summary": {...}} with the totals that /benchmark
+    returns. The first bytes go out after one chunk of records, however
+    large operation_count is.
+    """
+    pattern_mask = vedic_engine.pattern_mask(request.pattern_types)
+    seed = request.seed if request.seed is not None else time.time_ns()
+    cursor = vedic_engine.cursor(request.operation_count, pattern_mask, seed, "ndjson", request.chunk_size)
+    return StreamingResponse(
+        vedic_engine.stream(cursor, with_summary=True),
+        media_type="application/x-ndjson",
+        headers={"X-Vedic-Seed": str(seed)}
+    )
+
+@app.get("/api/v1/dataset/stream")
+async def stream_dataset(operation_count: int = 1000, seed: Optional[int] = None,
+                         patterns: str = "all", format: str = "ndjson"):
+    """Stream a generated research dataset as NDJSON or CSV
+    
+    Nothing is stored on the server; records are generated a chunk at a time
+    as the client reads them.
+    """
+    if operation_count < 1:
+        raise HTTPException(status_code=400, detail="operation_count must be positive")
+    if format not in ("ndjson", "csv"):
+        raise HTTPException(status_code=400, detail="format must be ndjson or csv")
+    pattern_mask = vedic_engine.pattern_mask([name.strip() for name in patterns.split(",")])
+    seed = seed if seed is not None else time.time_ns()
+    cursor = vedic_engine.cursor(operation_count, pattern_mask, seed, format)
+    
+    headers = {"X-Vedic-Seed": str(seed)}
+    if format == "csv":
+        headers["Content-Disposition"] = f'attachment; filename="dataset_{seed}.csv"'
+    return StreamingResponse(
+        vedic_engine.stream(cursor),
+        media_type="text/csv" if format == "csv" else "application/x-ndjson",
+        headers=headers
+    )
+
 @app.get("/api/v1/sutras", response_model=List[Dict[str, Any]])
 async def list_sutras():
     """Get list of available Vedic sutras with descriptions"""
@@ -605,6 +583,10 @@ async def performance_stats():
 from fastapi import WebSocket, WebSocketDisconnect
 
 class ConnectionManager:
+    """Live-update clients; every message is serialized once and sent to all"""
+    
+    SEND_TIMEOUT_S = 2.0                 # A client slower than this is dropped
+    
     def __init__(self):
         self.active_connections: List[WebSocket] = []
 
@@ -613,31 +595,129 @@ class ConnectionManager:
         self.active_connections.append(websocket)
 
     def disconnect(self, websocket: WebSocket):
-        self.active_connections.remove(websocket)
+        if websocket in self.active_connections:
+            self.active_connections.remove(websocket)
 
     async def broadcast(self, message: str):
-        for connection in self.active_connections:
-            try:
-                await connection.send_text(message)
-            except:
-                # Handle disconnected clients
-                pass
+        clients = list(self.active_connections)
+        if not clients:
+            return
+        results = await asyncio.gather(
+            *(asyncio.wait_for(client.send_text(message), self.SEND_TIMEOUT_S) for client in clients),
+            return_exceptions=True
+        )
+        for client, result in zip(clients, results):
+            if isinstance(result, Exception):
+                self.disconnect(client)
 
 manager = ConnectionManager()
 
+
+class MetricsBroadcaster:
+    """One task that tails the engine's metrics ring and fans deltas out to every client
+
+    The C engine publishes cumulative counters into a shared-memory ring
+    (vedicmath.metrics_publish_start, or vedicmathd --metrics in another
+    process). Each tick reads the newest snapshot, differences it against
+    the previous one and broadcasts a single JSON text, so the cost of a
+    client is one send of a prebuilt string. System status from psutil is
+    polled once per STATUS_INTERVAL_S for everyone rather than per client.
+    """
+    
+    GAUGES = ("sequence", "timestamp_ns", "pid", "async_in_flight", "energy_joules")
+    STATUS_INTERVAL_S = 5.0
+    REATTACH_AFTER_S = 5.0               # A ring this quiet may have been replaced by a new publisher
+    
+    def __init__(self, engine: VedicMathEngine, connections: ConnectionManager, ring: str, rate_hz: float):
+        self.engine = engine
+        self.connections = connections
+        self.ring = ring
+        self.period = 1.0 / max(rate_hz, 0.1)
+        self.reader = None
+        self.latest: Optional[Dict[str, Any]] = None
+        self.quiet_since = time.monotonic()
+    
+    def snapshot_message(self) -> Optional[str]:
+        """Full snapshot for a client that just connected"""
+        if self.latest is None:
+            return None
+        return json.dumps({"type": "metrics_snapshot", "data": self.latest})
+    
+    def delta_message(self, previous: Dict[str, Any], current: Dict[str, Any]) -> str:
+        elapsed = max((current["timestamp_ns"] - previous["timestamp_ns"]) / 1e9, 1e-9)
+        delta = {key: value - previous[key] for key, value in current.items() if key not in self.GAUGES}
+        batch = sum(value for key, value in delta.items() if key.startswith("batch_"))
+        rates = {
+            "dispatch_operations_per_s": delta["dispatch_operations"] / elapsed,
+            "batch_elements_per_s": batch / elapsed,
+            "async_completed_per_s": delta["async_completed"] / elapsed,
+            "watts": ((current["energy_joules"] - previous["energy_joules"]) / elapsed
+                      if current["energy_joules"] >= 0 and previous["energy_joules"] >= 0 else None),
+        }
+        return json.dumps({
+            "type": "metrics_delta",
+            "from_sequence": previous["sequence"],
+            "interval_s": elapsed,
+            "delta": delta,
+            "rates": rates,
+            "totals": current,           # Clients that missed a delta stay consistent
+        })
+    
+    def _poll(self) -> Optional[str]:
+        """Newest snapshot as a message, or None if the ring has not moved"""
+        if self.reader is None:
+            try:
+                self.reader = self.engine.native.MetricsReader(self.ring)
+            except FileNotFoundError:
+                return None
+            self.quiet_since = time.monotonic()
+        
+        head = self.reader.head
+        current = self.reader.read(head) if self.latest is None or head != self.latest["sequence"] else None
+        if current is None:
+            if time.monotonic() - self.quiet_since > self.REATTACH_AFTER_S:
+                self.reader.close()
+                self.reader = None
+            return None
+        self.quiet_since = time.monotonic()
+        
+        previous, self.latest = self.latest, current
+        if previous is None or previous["pid"] != current["pid"] or previous["sequence"] > current["sequence"]:
+            return self.snapshot_message()       # New publisher: counters restarted
+        return self.delta_message(previous, current)
+    
+    async def run(self):
+        next_status = 0.0
+        while True:
+            if self.engine.native is not None:
+                message = self._poll()
+                if message is not None:
+                    await self.connections.broadcast(message)
+            if time.monotonic() >= next_status and self.connections.active_connections:
+                next_status = time.monotonic() + self.STATUS_INTERVAL_S
+                status = get_system_status()
+                await self.connections.broadcast(json.dumps({"type": "system_status", "data": status.dict()}, default=str))
+            await asyncio.sleep(self.period)
+
+broadcaster = MetricsBroadcaster(
+    vedic_engine, manager,
+    ring=os.environ.get("VEDICMATH_METRICS_RING", "/vedicmath-metrics"),
+    rate_hz=float(os.environ.get("VEDICMATH_METRICS_RATE_HZ", "4"))
+)
+
 @app.websocket("/ws/live-updates")
 async def websocket_endpoint(websocket: WebSocket):
     await manager.connect(websocket)
     try:
+        snapshot = broadcaster.snapshot_message()
+        if snapshot is not None:
+            await websocket.send_text(snapshot)
+        # Updates come from the broadcaster; reading only notices the disconnect
         while True:
-            # Send system status every 5 seconds
-            status = get_system_status()
-            await websocket.send_json({
-                "type": "system_status",
-                "data": status.dict()
-            })
-            await asyncio.sleep(5)
+            await websocket.receive_text()
     except WebSocketDisconnect:
+        pass
+    finally:
         manager.disconnect(websocket)
 
 # ============================================================================
@@ -648,7 +728,16 @@ async def websocket_endpoint(websocket: WebSocket):
 async def startup_event():
     """Initialize the application"""
     print("🚀 VedicMath-AI FastAPI Backend Starting...")
-    print("   - Adaptive arithmetic engine ready")
+    if vedic_engine.native is not None:
+        vedic_engine.native.unified_init("performance")
+        print(f"   - Native engine {vedic_engine.native.__version__} loaded in-process")
+        # VEDICMATH_METRICS_PUBLISH=0 follows a ring published by another process instead
+        if os.environ.get("VEDICMATH_METRICS_PUBLISH", "1") != "0":
+            vedic_engine.native.metrics_publish_start(broadcaster.ring, interval_ms=int(broadcaster.period * 1000))
+        print(f"   - Engine metrics from ring {broadcaster.ring} at {1 / broadcaster.period:g} Hz")
+    else:
+        print("   - Native engine unavailable: only /api/v1/calculate works (in Python)")
+    app.state.broadcaster_task = asyncio.create_task(broadcaster.run())
     print("   - Real-time performance monitoring enabled")
     print("   - Matrix operations available")
     print("   - Dataset generation configured")
@@ -657,6 +746,12 @@ async def startup_event():
     print("✅ API ready at http://localhost:8000")
     print("📖 Documentation at http://localhost:8000/docs")
 
+@app.on_event("shutdown")
+async def shutdown_event():
+    app.state.broadcaster_task.cancel()
+    if vedic_engine.native is not None:
+        vedic_engine.native.metrics_publish_stop()
+
 if __name__ == "__main__":
     import uvicorn
     uvicorn.run(
@@ -10,6 +10,13 @@
 #include "vedicmath.h"
 #include "vedicmath_dynamic.h"
 #include "vedicmath_types.h"
+#include "vedicmath_pool.h"
+#include "vedicmath_metrics.h"
+#include "unified_adaptive_dispatcher.h"
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
 
 // Forward declarations
 static PyObject* py_vedic_multiply(PyObject* self, PyObject* args);
@@ -18,6 +25,19 @@ static PyObject* py_vedic_divide(PyObject* self, PyObject* args);
 static PyObject* py_ekadhikena_purvena(PyObject* self, PyObject* args);
 static PyObject* py_nikhilam_mul(PyObject* self, PyObject* args);
 static PyObject* py_evaluate_expression(PyObject* self, PyObject* args);
+static PyObject* py_multiply_batch(PyObject* self, PyObject* args, PyObject* kwargs);
+static PyObject* py_square_batch(PyObject* self, PyObject* args, PyObject* kwargs);
+static PyObject* py_divide_batch(PyObject* self, PyObject* args, PyObject* kwargs);
+static PyObject* py_unified_init(PyObject* self, PyObject* args, PyObject* kwargs);
+static PyObject* py_unified_multiply(PyObject* self, PyObject* args);
+static PyObject* py_unified_divide(PyObject* self, PyObject* args);
+static PyObject* py_matrix_multiply(PyObject* self, PyObject* args, PyObject* kwargs);
+static PyObject* py_run_benchmark(PyObject* self, PyObject* args, PyObject* kwargs);
+static PyObject* py_generate_dataset(PyObject* self, PyObject* args, PyObject* kwargs);
+static PyObject* py_dataset_cursor(PyObject* self, PyObject* args, PyObject* kwargs);
+static PyObject* py_metrics_snapshot(PyObject* self, PyObject* args);
+static PyObject* py_metrics_publish_start(PyObject* self, PyObject* args, PyObject* kwargs);
+static PyObject* py_metrics_publish_stop(PyObject* self, PyObject* args);
 
 /**
  * Python wrapper for vedic_multiply
@@ -130,6 +150,1116 @@ static PyObject* py_evaluate_expression(PyObject* self, PyObject* args) {
     }
 }
 
+/*
+ * Array batch functions
+ *
+ * The *_batch functions take any C-contiguous buffer-protocol object
+ * (NumPy arrays, array.array, memoryview) of int32, int64 or float64 and
+ * write into a preallocated output of the same type and length, which may be
+ * an operand itself. Without one they return a new object of the first
+ * operand's type. The kernels run on the caller's memory with the GIL
+ * released, split across the library thread pool.
+ */
+
+#define ARRAY_BATCH_GRAIN 4096     // Elements per pool range, as vedic_multiply_batch
+#define ARRAY_BATCH_BLOCK 256      // int32 elements widened per vedic_multiply_batch call
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ARRAY_FLAG_SET(ptr) __atomic_store_n(ptr, 1, __ATOMIC_RELAXED)
+#else
+#define ARRAY_FLAG_SET(ptr) (*(volatile int*)(ptr) = 1)
+#endif
+
+typedef enum {
+    ARRAY_INT32,
+    ARRAY_INT64,
+    ARRAY_FLOAT64
+} ArrayKind;
+
+typedef enum {
+    ARRAY_MULTIPLY,
+    ARRAY_SQUARE,
+    ARRAY_DIVIDE
+} ArrayOp;
+
+typedef struct {
+    ArrayOp op;
+    ArrayKind kind;
+    const void* a;
+    const void* b;               // NULL for square
+    void* out;
+    void* remainder;             // Divide only, may be NULL
+    int divide_by_zero;          // Set by any range that meets an integer zero divisor
+} ArrayBatch;
+
+/**
+ * Map a buffer's struct-module format to an element kind
+ */
+static int array_kind(const Py_buffer* view, ArrayKind* kind) {
+    const char* format = view->format ? view->format : "B";
+    const uint16_t probe = 1;
+    int little_endian = *(const uint8_t*)&probe == 1;
+
+    // Only native byte order: '@' and '=' always, '<' or '>' when it matches the host
+    if (*format == '@' || *format == '=' ||
+        (*format == '<' && little_endian) || ((*format == '>' || *format == '!') && !little_endian)) {
+        format++;
+    }
+    if (format[0] == '\0' || format[1] != '\0') return -1;
+
+    switch (format[0]) {
+        case 'i': case 'l': case 'q':
+            if (view->itemsize == 4) {
+                *kind = ARRAY_INT32;
+                return 0;
+            }
+            if (view->itemsize == 8 && sizeof(long) >= 8) {
+                *kind = ARRAY_INT64;
+                return 0;
+            }
+            return -1;
+        case 'd':
+            *kind = ARRAY_FLOAT64;
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+/**
+ * Borrow a C-contiguous buffer and check its element type
+ */
+static int array_acquire(PyObject* obj, Py_buffer* view, int writable, const char* name,
+                         const char* label, ArrayKind* kind) {
+    int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+    if (PyObject_GetBuffer(obj, view, flags) != 0) {
+        return -1;
+    }
+    if (array_kind(view, kind) != 0) {
+        PyErr_Format(PyExc_TypeError, "%s: %s has unsupported element type '%s' (expected int32, int64 or float64)",
+                     name, label, view->format ? view->format : "B");
+        PyBuffer_Release(view);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * True when two buffers share any memory
+ */
+static int array_overlap(const Py_buffer* x, const Py_buffer* y) {
+    const char* x_begin = (const char*)x->buf;
+    const char* y_begin = (const char*)y->buf;
+    return x_begin < y_begin + y->len && y_begin < x_begin + x->len;
+}
+
+static void array_range_int32(ArrayBatch* batch, size_t begin, size_t end) {
+    const int32_t* a = (const int32_t*)batch->a;
+    const int32_t* b = (const int32_t*)batch->b;
+    int32_t* out = (int32_t*)batch->out;
+    int32_t* remainder = (int32_t*)batch->remainder;
+
+    switch (batch->op) {
+        case ARRAY_MULTIPLY: {
+            // Widen a block at a time so the pattern-partitioned kernel still applies
+            long wide_a[ARRAY_BATCH_BLOCK];
+            long wide_b[ARRAY_BATCH_BLOCK];
+            long wide_out[ARRAY_BATCH_BLOCK];
+            for (size_t base = begin; base < end; base += ARRAY_BATCH_BLOCK) {
+                size_t block = end - base < ARRAY_BATCH_BLOCK ? end - base : ARRAY_BATCH_BLOCK;
+                for (size_t i = 0; i < block; i++) {
+                    wide_a[i] = a[base + i];
+                    wide_b[i] = b[base + i];
+                }
+                vedic_multiply_batch(wide_out, wide_a, wide_b, block);
+                for (size_t i = 0; i < block; i++) {
+                    out[base + i] = (int32_t)wide_out[i];     // Wraps like NumPy int32 arithmetic
+                }
+            }
+            break;
+        }
+        case ARRAY_SQUARE: {
+            long wide_a[ARRAY_BATCH_BLOCK];
+            long wide_out[ARRAY_BATCH_BLOCK];
+            for (size_t base = begin; base < end; base += ARRAY_BATCH_BLOCK) {
+                size_t block = end - base < ARRAY_BATCH_BLOCK ? end - base : ARRAY_BATCH_BLOCK;
+                for (size_t i = 0; i < block; i++) wide_a[i] = a[base + i];
+                vedic_square_batch(wide_out, wide_a, block);
+                for (size_t i = 0; i < block; i++) out[base + i] = (int32_t)wide_out[i];
+            }
+            break;
+        }
+        case ARRAY_DIVIDE:
+            for (size_t i = begin; i < end; i++) {
+                long rest = 0;
+                long quotient = 0;
+                if (b[i] == 0) {
+                    ARRAY_FLAG_SET(&batch->divide_by_zero);
+                } else {
+                    quotient = vedic_divide(a[i], b[i], &rest);
+                }
+                out[i] = (int32_t)quotient;
+                if (remainder) remainder[i] = (int32_t)rest;
+            }
+            break;
+    }
+}
+
+static void array_range_int64(ArrayBatch* batch, size_t begin, size_t end) {
+    // array_kind only accepts int64 where long is 64 bits
+    const long* a = (const long*)batch->a;
+    const long* b = (const long*)batch->b;
+    long* out = (long*)batch->out;
+    long* remainder = (long*)batch->remainder;
+
+    switch (batch->op) {
+        case ARRAY_MULTIPLY:
+            // Ranges are at most ARRAY_BATCH_GRAIN long, so this runs inline
+            vedic_multiply_batch(out + begin, a + begin, b + begin, end - begin);
+            break;
+        case ARRAY_SQUARE:
+            vedic_square_batch(out + begin, a + begin, end - begin);
+            break;
+        case ARRAY_DIVIDE:
+            for (size_t i = begin; i < end; i++) {
+                long rest = 0;
+                long quotient = 0;
+                if (b[i] == 0) {
+                    ARRAY_FLAG_SET(&batch->divide_by_zero);
+                } else {
+                    quotient = vedic_divide(a[i], b[i], &rest);
+                }
+                out[i] = quotient;
+                if (remainder) remainder[i] = rest;
+            }
+            break;
+    }
+}
+
+static void array_range_float64(ArrayBatch* batch, size_t begin, size_t end) {
+    const double* a = (const double*)batch->a;
+    const double* b = (const double*)batch->b;
+    double* out = (double*)batch->out;
+    double* remainder = (double*)batch->remainder;
+
+    switch (batch->op) {
+        case ARRAY_MULTIPLY:
+            for (size_t i = begin; i < end; i++) {
+                out[i] = vedic_multiply_f64(a[i], b[i]);
+            }
+            break;
+        case ARRAY_SQUARE:
+            for (size_t i = begin; i < end; i++) {
+                out[i] = vedic_square_f64(a[i]);
+            }
+            break;
+        case ARRAY_DIVIDE:
+            // IEEE semantics: a zero divisor gives an infinity or NaN, not an error
+            for (size_t i = begin; i < end; i++) {
+                double rest = fmod(a[i], b[i]);
+                out[i] = a[i] / b[i];
+                if (remainder) remainder[i] = rest;
+            }
+            break;
+    }
+}
+
+static void array_batch_range(size_t begin, size_t end, void* context) {
+    ArrayBatch* batch = (ArrayBatch*)context;
+    switch (batch->kind) {
+        case ARRAY_INT32:
+            array_range_int32(batch, begin, end);
+            break;
+        case ARRAY_INT64:
+            array_range_int64(batch, begin, end);
+            break;
+        case ARRAY_FLOAT64:
+            array_range_float64(batch, begin, end);
+            break;
+    }
+}
+
+/**
+ * A new writable object of a's type, length and format for the results
+ *
+ * A memoryview gets one over a new bytearray; anything else is copied with
+ * copy.copy, which for NumPy arrays and array.array gives a fresh array.
+ */
+static PyObject* array_new_output(PyObject* a_obj, const Py_buffer* a_view, const char* name) {
+    if (PyMemoryView_Check(a_obj)) {
+        const char* format = a_view->format ? a_view->format : "B";
+        if (*format && strchr("@=<>!", *format)) format++;   // array_kind checked it is native
+        PyObject* shape = PyTuple_New(a_view->ndim);
+        for (int i = 0; shape && i < a_view->ndim; i++) {
+            PyTuple_SET_ITEM(shape, i, PyLong_FromSsize_t(a_view->shape[i]));
+        }
+        PyObject* storage = shape ? PyByteArray_FromStringAndSize(NULL, a_view->len) : NULL;
+        PyObject* bytes_view = storage ? PyMemoryView_FromObject(storage) : NULL;
+        PyObject* output = bytes_view ? PyObject_CallMethod(bytes_view, "cast", "sO", format, shape) : NULL;
+        Py_XDECREF(bytes_view);
+        Py_XDECREF(storage);
+        Py_XDECREF(shape);
+        return output;
+    }
+
+    PyObject* copy_module = PyImport_ImportModule("copy");
+    PyObject* output = copy_module ? PyObject_CallMethod(copy_module, "copy", "O", a_obj) : NULL;
+    Py_XDECREF(copy_module);
+    if (output == a_obj) {
+        // Immutable types copy to themselves
+        Py_DECREF(output);
+        PyErr_Format(PyExc_TypeError, "%s: cannot make an output like a; pass out=", name);
+        return NULL;
+    }
+    return output;
+}
+
+/**
+ * Shared body of the *_batch functions
+ *
+ * Without out_obj the results go to a new object like a, so the operands are
+ * only written when the caller passes one of them as out; rem_obj is only
+ * given for divide. Returns a new reference to the output object.
+ */
+static PyObject* run_array_batch(ArrayOp op, const char* name, PyObject* a_obj, PyObject* b_obj,
+                                 PyObject* out_obj, PyObject* rem_obj) {
+    Py_buffer views[4];               // a, b, out, remainder
+    PyObject* objects[4] = {a_obj, b_obj, out_obj, rem_obj};
+    const char* labels[4] = {"a", "b", "out", "remainder"};
+    ArrayKind kinds[4];
+    int held = 0;
+    PyObject* result = NULL;
+    PyObject* fresh = NULL;           // Output made here when out is not given
+
+    if (objects[2] == Py_None) objects[2] = NULL;
+    if (objects[3] == Py_None) objects[3] = NULL;
+
+    for (held = 0; held < 4; held++) {
+        if (held == 2 && objects[2] == NULL) {
+            fresh = array_new_output(a_obj, &views[0], name);
+            if (!fresh) goto done;
+            objects[2] = fresh;
+        }
+        if (objects[held] == NULL) {
+            views[held].buf = NULL;
+            views[held].obj = NULL;
+            continue;
+        }
+        if (array_acquire(objects[held], &views[held], held >= 2, name, labels[held], &kinds[held]) != 0) {
+            goto done;
+        }
+    }
+
+    Py_ssize_t count = views[0].len / views[0].itemsize;
+    for (int i = 1; i < 4; i++) {
+        if (views[i].obj == NULL) continue;
+        if (kinds[i] != kinds[0]) {
+            PyErr_Format(PyExc_TypeError, "%s: %s has a different element type than a", name, labels[i]);
+            goto done;
+        }
+        if (views[i].len / views[i].itemsize != count) {
+            PyErr_Format(PyExc_ValueError, "%s: %s has %zd elements, a has %zd", name, labels[i],
+                         views[i].len / views[i].itemsize, count);
+            goto done;
+        }
+    }
+
+    // Each element is read before its result is written, so an output may be
+    // an input, but it must not be a shifted view of one
+    for (int o = 2; o < 4; o++) {
+        if (views[o].obj == NULL) continue;
+        for (int i = 0; i < o; i++) {
+            if (views[i].obj == NULL || !array_overlap(&views[o], &views[i])) continue;
+            int same = views[o].buf == views[i].buf && views[o].len == views[i].len;
+            if (i >= 2 || !same) {
+                PyErr_Format(PyExc_ValueError, "%s: %s overlaps %s", name, labels[o], labels[i]);
+                goto done;
+            }
+        }
+    }
+
+    ArrayBatch batch = {op, kinds[0], views[0].buf, views[1].buf, views[2].buf, views[3].buf, 0};
+    Py_BEGIN_ALLOW_THREADS
+    vedic_pool_parallel_for((size_t)count, ARRAY_BATCH_GRAIN, array_batch_range, &batch);
+    Py_END_ALLOW_THREADS
+
+    if (batch.divide_by_zero) {
+        PyErr_Format(PyExc_ZeroDivisionError, "%s: division by zero", name);
+        goto done;
+    }
+    Py_INCREF(objects[2]);
+    result = objects[2];
+
+done:
+    for (int i = 0; i < held; i++) {
+        if (views[i].obj != NULL) PyBuffer_Release(&views[i]);
+    }
+    Py_XDECREF(fresh);
+    return result;
+}
+
+/**
+ * Python wrapper for element-wise batch multiplication
+ */
+static PyObject* py_multiply_batch(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"a", "b", "out", NULL};
+    PyObject *a, *b, *out = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|O:multiply_batch", keywords, &a, &b, &out)) {
+        return NULL;
+    }
+    return run_array_batch(ARRAY_MULTIPLY, "multiply_batch", a, b, out, NULL);
+}
+
+/**
+ * Python wrapper for element-wise batch squaring
+ */
+static PyObject* py_square_batch(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"a", "out", NULL};
+    PyObject *a, *out = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O:square_batch", keywords, &a, &out)) {
+        return NULL;
+    }
+    return run_array_batch(ARRAY_SQUARE, "square_batch", a, NULL, out, NULL);
+}
+
+/**
+ * Python wrapper for element-wise batch division
+ */
+static PyObject* py_divide_batch(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"a", "b", "out", "remainder", NULL};
+    PyObject *a, *b, *out = NULL, *remainder = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|OO:divide_batch", keywords,
+                                     &a, &b, &out, &remainder)) {
+        return NULL;
+    }
+    return run_array_batch(ARRAY_DIVIDE, "divide_batch", a, b, out, remainder);
+}
+
+// ============================================================================
+// Unified dispatcher
+// ============================================================================
+
+#define DATASET_BATCH 1024         // Records generated per GIL release
+#define DATASET_SAMPLES 10         // Records returned by run_benchmark
+#define DATASET_CURSOR_MAX_CHUNK 65536
+
+static int unified_ready = 0;      // unified_dispatch_init has run (under the GIL)
+
+/**
+ * Initialize the dispatcher on first use with the performance preset
+ */
+static int unified_ensure(void) {
+    if (unified_ready) return 0;
+    UnifiedDispatchConfig config = unified_dispatch_get_preset_config("performance");
+    config.enable_dataset_logging = false;
+    if (unified_dispatch_init(&config) != 0) {
+        PyErr_SetString(PyExc_MemoryError, "unified dispatcher initialization failed");
+        return -1;
+    }
+    unified_ready = 1;
+    return 0;
+}
+
+/**
+ * Convert dispatch metadata to a dict
+ */
+static PyObject* unified_result_dict(const UnifiedDispatchResult* r) {
+    return Py_BuildValue("{s:L,s:s,s:s,s:d,s:d,s:d,s:s,s:d,s:d,s:O,s:K}",
+                         "result", (long long)vedic_to_int64(r->result),
+                         "algorithm", r->selected_algorithm ? r->selected_algorithm : "",
+                         "sutra_sanskrit", r->sutra_name_sanskrit ? r->sutra_name_sanskrit : "",
+                         "confidence", r->pattern_confidence,
+                         "predicted_speedup", r->predicted_speedup,
+                         "actual_speedup", r->actual_speedup,
+                         "reasoning", r->decision_reasoning ? r->decision_reasoning : "",
+                         "execution_time_ms", r->execution_time_ms,
+                         "standard_time_ms", r->standard_execution_time_ms,
+                         "correct", r->correctness_verified ? Py_True : Py_False,
+                         "operation_id", (unsigned long long)r->operation_id);
+}
+
+/**
+ * Convert one generated record to a dict
+ */
+static PyObject* dataset_record_dict(const DatasetRecord* r) {
+    return Py_BuildValue("{s:L,s:L,s:L,s:s,s:s,s:d,s:d,s:d,s:d,s:O}",
+                         "operand_a", (long long)r->operand_a,
+                         "operand_b", (long long)r->operand_b,
+                         "result", (long long)r->result,
+                         "pattern", unified_dispatch_pattern_name(r->pattern),
+                         "sutra", unified_dispatch_sutra_type_to_string(r->sutra),
+                         "confidence", r->confidence,
+                         "predicted_speedup", r->predicted_speedup,
+                         "execution_time_ms", r->execution_time_ms,
+                         "standard_time_ms", r->standard_execution_time_ms,
+                         "correct", r->correct ? Py_True : Py_False);
+}
+
+/**
+ * Convert dataset totals to a dict
+ */
+static PyObject* dataset_summary_dict(const DatasetSummary* s) {
+    PyObject* patterns = PyDict_New();
+    PyObject* sutras = PyDict_New();
+    PyObject* result = NULL;
+    if (!patterns || !sutras) goto done;
+
+    for (int p = 0; p < DATASET_PATTERN_COUNT; p++) {
+        PyObject* value = PyLong_FromSize_t(s->pattern_counts[p]);
+        int failed = !value || PyDict_SetItemString(patterns, unified_dispatch_pattern_name((DatasetPattern)p), value);
+        Py_XDECREF(value);
+        if (failed) goto done;
+    }
+    for (int t = 0; t < MAX_SUTRA_TYPES; t++) {
+        if (s->sutra_counts[t] == 0) continue;
+        PyObject* value = PyLong_FromSize_t(s->sutra_counts[t]);
+        int failed = !value || PyDict_SetItemString(sutras, unified_dispatch_sutra_type_to_string((VedicSutraType)t), value);
+        Py_XDECREF(value);
+        if (failed) goto done;
+    }
+
+    result = Py_BuildValue("{s:n,s:n,s:n,s:d,s:O,s:O}",
+                           "records", (Py_ssize_t)s->records,
+                           "vedic_methods_used", (Py_ssize_t)s->vedic_methods_used,
+                           "correct", (Py_ssize_t)s->correct,
+                           "average_speedup", s->records ? s->speedup_sum / (double)s->records : 0.0,
+                           "patterns", patterns,
+                           "sutras", sutras);
+done:
+    Py_XDECREF(patterns);
+    Py_XDECREF(sutras);
+    return result;
+}
+
+/**
+ * Python wrapper for unified_dispatch_init
+ */
+static PyObject* py_unified_init(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"preset", "dataset_logging", NULL};
+    const char* preset = "performance";
+    int dataset_logging = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|sp:unified_init", keywords, &preset, &dataset_logging)) {
+        return NULL;
+    }
+    UnifiedDispatchConfig config = unified_dispatch_get_preset_config(preset);
+    config.enable_dataset_logging = dataset_logging != 0;
+
+    // The dispatcher allocates its state once; later calls only reconfigure it
+    if (unified_ready) {
+        unified_dispatch_update_config(&config);
+    } else if (unified_dispatch_init(&config) != 0) {
+        PyErr_SetString(PyExc_MemoryError, "unified dispatcher initialization failed");
+        return NULL;
+    } else {
+        unified_ready = 1;
+    }
+    Py_RETURN_NONE;
+}
+
+/**
+ * Python wrapper for unified_multiply
+ */
+static PyObject* py_unified_multiply(PyObject* self, PyObject* args) {
+    long long a, b;
+    UnifiedDispatchResult result;
+
+    if (!PyArg_ParseTuple(args, "LL:unified_multiply", &a, &b) || unified_ensure() != 0) {
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    result = unified_multiply(vedic_from_int64(a), vedic_from_int64(b));
+    Py_END_ALLOW_THREADS
+    return unified_result_dict(&result);
+}
+
+/**
+ * Python wrapper for unified_divide
+ */
+static PyObject* py_unified_divide(PyObject* self, PyObject* args) {
+    long long dividend, divisor;
+    UnifiedDispatchResult result;
+
+    if (!PyArg_ParseTuple(args, "LL:unified_divide", &dividend, &divisor) || unified_ensure() != 0) {
+        return NULL;
+    }
+    if (divisor == 0) {
+        PyErr_SetString(PyExc_ZeroDivisionError, "division by zero");
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    result = unified_divide(vedic_from_int64(dividend), vedic_from_int64(divisor));
+    Py_END_ALLOW_THREADS
+
+    PyObject* dict = unified_result_dict(&result);
+    long long quotient = (long long)vedic_to_int64(result.result);
+    PyObject* remainder = PyLong_FromLongLong(dividend - quotient * divisor);
+    if (!dict || !remainder || PyDict_SetItemString(dict, "remainder", remainder) != 0) {
+        Py_XDECREF(dict);
+        dict = NULL;
+    }
+    Py_XDECREF(remainder);
+    return dict;
+}
+
+/**
+ * Borrow a 2-D C-contiguous int64 matrix
+ */
+static int matrix_acquire(PyObject* obj, Py_buffer* view, int writable, const char* label) {
+    ArrayKind kind;
+    int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+    if (PyObject_GetBuffer(obj, view, flags) != 0) {
+        return -1;
+    }
+    if (view->ndim != 2 || array_kind(view, &kind) != 0 || kind != ARRAY_INT64) {
+        PyErr_Format(PyExc_TypeError, "matrix_multiply: %s must be a 2-D int64 array", label);
+        PyBuffer_Release(view);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Python wrapper for unified_matrix_multiply
+ */
+static PyObject* py_matrix_multiply(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"a", "b", "out", NULL};
+    PyObject *a_obj, *b_obj, *out_obj;
+    Py_buffer a, b, out;
+    PyObject* dict = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOO:matrix_multiply", keywords, &a_obj, &b_obj, &out_obj) ||
+        unified_ensure() != 0) {
+        return NULL;
+    }
+    if (matrix_acquire(a_obj, &a, 0, "a") != 0) return NULL;
+    if (matrix_acquire(b_obj, &b, 0, "b") != 0) {
+        PyBuffer_Release(&a);
+        return NULL;
+    }
+    if (matrix_acquire(out_obj, &out, 1, "out") != 0) {
+        PyBuffer_Release(&a);
+        PyBuffer_Release(&b);
+        return NULL;
+    }
+
+    size_t m = (size_t)a.shape[0], inner = (size_t)a.shape[1], n = (size_t)b.shape[1];
+    if ((size_t)b.shape[0] != inner || (size_t)out.shape[0] != m || (size_t)out.shape[1] != n) {
+        PyErr_Format(PyExc_ValueError, "matrix_multiply: shapes (%zd, %zd) x (%zd, %zd) -> (%zd, %zd) do not match",
+                     a.shape[0], a.shape[1], b.shape[0], b.shape[1], out.shape[0], out.shape[1]);
+        goto done;
+    }
+
+    size_t a_count = m * inner, b_count = inner * n, c_count = m * n;
+    VedicValue* values = PyMem_RawMalloc(sizeof(VedicValue) * (a_count + b_count + c_count + 1));
+    if (!values) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    UnifiedDispatchResult result;
+    Py_BEGIN_ALLOW_THREADS
+    const int64_t* a_data = (const int64_t*)a.buf;
+    const int64_t* b_data = (const int64_t*)b.buf;
+    int64_t* out_data = (int64_t*)out.buf;
+    VedicValue* c_values = values + a_count + b_count;
+    for (size_t i = 0; i < a_count; i++) values[i] = vedic_from_int64(a_data[i]);
+    for (size_t i = 0; i < b_count; i++) values[a_count + i] = vedic_from_int64(b_data[i]);
+
+    MatrixOperationParams params = {m, inner, inner, n, values, values + a_count, c_values, NULL};
+    result = unified_matrix_multiply(&params);
+    for (size_t i = 0; i < c_count; i++) out_data[i] = vedic_to_int64(c_values[i]);
+    Py_END_ALLOW_THREADS
+    PyMem_RawFree(values);
+
+    if (strncmp(result.selected_algorithm, "Error", 5) == 0) {
+        PyErr_Format(PyExc_RuntimeError, "matrix_multiply: %s", result.selected_algorithm);
+        goto done;
+    }
+    dict = unified_result_dict(&result);
+
+done:
+    PyBuffer_Release(&a);
+    PyBuffer_Release(&b);
+    PyBuffer_Release(&out);
+    return dict;
+}
+
+/**
+ * Generate records with the dataset generator and summarize them
+ */
+static PyObject* py_run_benchmark(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"count", "seed", "patterns", NULL};
+    Py_ssize_t count;
+    unsigned long long seed = 0;
+    unsigned int patterns = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n|KI:run_benchmark", keywords, &count, &seed, &patterns) ||
+        unified_ensure() != 0) {
+        return NULL;
+    }
+    if (count < 0) {
+        PyErr_SetString(PyExc_ValueError, "run_benchmark: count must not be negative");
+        return NULL;
+    }
+
+    DatasetRecord* chunk = PyMem_RawMalloc(sizeof(DatasetRecord) * DATASET_BATCH);
+    PyObject* samples = PyList_New(0);
+    PyObject* dict = NULL;
+    if (!chunk || !samples) {
+        if (!chunk) PyErr_NoMemory();
+        goto done;
+    }
+
+    DatasetSummary summary;
+    memset(&summary, 0, sizeof(summary));
+    uint64_t state = seed;
+    for (Py_ssize_t done = 0; done < count; ) {
+        size_t size = (size_t)(count - done < DATASET_BATCH ? count - done : DATASET_BATCH);
+        Py_BEGIN_ALLOW_THREADS
+        unified_dispatch_generate_records(chunk, size, &state, patterns);
+        unified_dispatch_summarize_records(&summary, chunk, size);
+        Py_END_ALLOW_THREADS
+
+        for (size_t i = 0; i < size && PyList_GET_SIZE(samples) < DATASET_SAMPLES; i++) {
+            PyObject* record = dataset_record_dict(&chunk[i]);
+            int failed = !record || PyList_Append(samples, record) != 0;
+            Py_XDECREF(record);
+            if (failed) goto done;
+        }
+        done += (Py_ssize_t)size;
+    }
+
+    dict = dataset_summary_dict(&summary);
+    if (dict && PyDict_SetItemString(dict, "samples", samples) != 0) {
+        Py_CLEAR(dict);
+    }
+
+done:
+    PyMem_RawFree(chunk);
+    Py_XDECREF(samples);
+    return dict;
+}
+
+/**
+ * Python wrapper for unified_dispatch_write_dataset
+ */
+static PyObject* py_generate_dataset(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"path", "count", "seed", "patterns", NULL};
+    PyObject* path_obj;
+    Py_ssize_t count;
+    unsigned long long seed = 0;
+    unsigned int patterns = 0;
+    int status;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O&n|KI:generate_dataset", keywords,
+                                     PyUnicode_FSConverter, &path_obj, &count, &seed, &patterns)) {
+        return NULL;
+    }
+    if (count < 0) {
+        Py_DECREF(path_obj);
+        PyErr_SetString(PyExc_ValueError, "generate_dataset: count must not be negative");
+        return NULL;
+    }
+    if (unified_ensure() != 0) {
+        Py_DECREF(path_obj);
+        return NULL;
+    }
+
+    DatasetSummary summary;
+    memset(&summary, 0, sizeof(summary));
+    const char* path = PyBytes_AS_STRING(path_obj);
+    Py_BEGIN_ALLOW_THREADS
+    status = unified_dispatch_write_dataset(path, (size_t)count, seed, patterns, &summary);
+    Py_END_ALLOW_THREADS
+
+    if (status != 0) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+        Py_DECREF(path_obj);
+        return NULL;
+    }
+    Py_DECREF(path_obj);
+    return dataset_summary_dict(&summary);
+}
+
+/**
+ * Cursor over generated records: each step generates one chunk with the GIL
+ * released and returns it as NDJSON or CSV text
+ */
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t remaining;        // Records not yet generated
+    Py_ssize_t chunk;            // Records per step
+    uint64_t state;              // Generator state, advanced by every step
+    unsigned int patterns;
+    DatasetFormat format;
+    int header_pending;          // CSV header goes out with the first chunk
+    int busy;                    // A step is running without the GIL
+    DatasetRecord* records;
+    char* text;
+    DatasetSummary summary;
+} DatasetCursor;
+
+static void dataset_cursor_dealloc(DatasetCursor* cursor) {
+    PyMem_RawFree(cursor->records);
+    PyMem_RawFree(cursor->text);
+    Py_TYPE(cursor)->tp_free((PyObject*)cursor);
+}
+
+static PyObject* dataset_cursor_next(DatasetCursor* cursor) {
+    if (cursor->remaining == 0) return NULL;         // StopIteration
+    if (cursor->busy) {
+        PyErr_SetString(PyExc_RuntimeError, "dataset cursor is already in use by another thread");
+        return NULL;
+    }
+
+    size_t size = (size_t)(cursor->remaining < cursor->chunk ? cursor->remaining : cursor->chunk);
+    size_t length = 0;
+    cursor->busy = 1;
+    Py_BEGIN_ALLOW_THREADS
+    unified_dispatch_generate_records(cursor->records, size, &cursor->state, cursor->patterns);
+    unified_dispatch_summarize_records(&cursor->summary, cursor->records, size);
+    if (cursor->header_pending) {
+        memcpy(cursor->text, DATASET_CSV_HEADER, sizeof(DATASET_CSV_HEADER) - 1);
+        length = sizeof(DATASET_CSV_HEADER) - 1;
+    }
+    for (size_t i = 0; i < size; i++) {
+        length += (size_t)unified_dispatch_format_record(cursor->text + length, DATASET_RECORD_MAX_TEXT,
+                                                         &cursor->records[i], cursor->format);
+    }
+    Py_END_ALLOW_THREADS
+    cursor->busy = 0;
+    cursor->header_pending = 0;
+    cursor->remaining -= (Py_ssize_t)size;
+
+    return PyBytes_FromStringAndSize(cursor->text, (Py_ssize_t)length);
+}
+
+/**
+ * Totals over the records generated so far
+ */
+static PyObject* dataset_cursor_summary(DatasetCursor* cursor, PyObject* unused) {
+    return dataset_summary_dict(&cursor->summary);
+}
+
+static PyObject* dataset_cursor_remaining(DatasetCursor* cursor, void* closure) {
+    return PyLong_FromSsize_t(cursor->remaining);
+}
+
+static PyMethodDef dataset_cursor_methods[] = {
+    {"summary", (PyCFunction)dataset_cursor_summary, METH_NOARGS,
+     "Totals over the records generated so far, as returned by run_benchmark"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef dataset_cursor_getset[] = {
+    {"remaining", (getter)dataset_cursor_remaining, NULL, "Records not yet generated", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyTypeObject DatasetCursorType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "vedicmath.DatasetCursor",
+    .tp_basicsize = sizeof(DatasetCursor),
+    .tp_dealloc = (destructor)dataset_cursor_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Iterator over generated dataset records; see dataset_cursor()",
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = (iternextfunc)dataset_cursor_next,
+    .tp_methods = dataset_cursor_methods,
+    .tp_getset = dataset_cursor_getset,
+};
+
+/**
+ * Open a cursor over generated records
+ */
+static PyObject* py_dataset_cursor(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"count", "seed", "patterns", "format", "chunk", NULL};
+    Py_ssize_t count;
+    unsigned long long seed = 0;
+    unsigned int patterns = 0;
+    const char* format = "ndjson";
+    Py_ssize_t chunk = DATASET_BATCH;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n|KIsn:dataset_cursor", keywords,
+                                     &count, &seed, &patterns, &format, &chunk)) {
+        return NULL;
+    }
+    if (count < 0 || chunk < 1 || chunk > DATASET_CURSOR_MAX_CHUNK) {
+        PyErr_Format(PyExc_ValueError, "dataset_cursor: count must not be negative and chunk must be 1-%d",
+                     DATASET_CURSOR_MAX_CHUNK);
+        return NULL;
+    }
+    int csv = strcmp(format, "csv") == 0;
+    if (!csv && strcmp(format, "ndjson") != 0) {
+        PyErr_Format(PyExc_ValueError, "dataset_cursor: format must be 'ndjson' or 'csv', not '%s'", format);
+        return NULL;
+    }
+    if (unified_ensure() != 0) return NULL;
+
+    DatasetCursor* cursor = PyObject_New(DatasetCursor, &DatasetCursorType);
+    if (cursor == NULL) return NULL;
+    cursor->remaining = count;
+    cursor->chunk = chunk;
+    cursor->state = seed;
+    cursor->patterns = patterns;
+    cursor->format = csv ? DATASET_FORMAT_CSV : DATASET_FORMAT_NDJSON;
+    cursor->header_pending = csv;
+    cursor->busy = 0;
+    memset(&cursor->summary, 0, sizeof(cursor->summary));
+    cursor->records = PyMem_RawMalloc(sizeof(DatasetRecord) * (size_t)chunk);
+    cursor->text = PyMem_RawMalloc(sizeof(DATASET_CSV_HEADER) + DATASET_RECORD_MAX_TEXT * (size_t)chunk);
+    if (!cursor->records || !cursor->text) {
+        Py_DECREF(cursor);
+        return PyErr_NoMemory();
+    }
+    return (PyObject*)cursor;
+}
+
+// ============================================================================
+// ENGINE METRICS
+// ============================================================================
+
+// Dictionary keys for VedicMetricsSnapshot.counters, in VedicMetric order
+static const char* const metric_names[VEDIC_METRIC_COUNT] = {
+    "dispatch_operations", "dispatch_vedic", "dispatch_ns", "standard_ns",
+    "batch_direct", "batch_ekadhikena", "batch_antyayordasake", "batch_nikhilam", "batch_urdhva"
+};
+
+static int dict_set_u64(PyObject* dict, const char* key, uint64_t value) {
+    PyObject* item = PyLong_FromUnsignedLongLong(value);
+    if (item == NULL) return -1;
+    int status = PyDict_SetItemString(dict, key, item);
+    Py_DECREF(item);
+    return status;
+}
+
+static PyObject* metrics_snapshot_dict(const VedicMetricsSnapshot* s) {
+    PyObject* dict = PyDict_New();
+    if (dict == NULL) return NULL;
+    int status = dict_set_u64(dict, "sequence", s->sequence) |
+                 dict_set_u64(dict, "timestamp_ns", s->timestamp_ns) |
+                 dict_set_u64(dict, "pid", s->pid) |
+                 dict_set_u64(dict, "pool_parallel_calls", s->pool_parallel_calls) |
+                 dict_set_u64(dict, "pool_serial_calls", s->pool_serial_calls) |
+                 dict_set_u64(dict, "pool_ranges", s->pool_ranges) |
+                 dict_set_u64(dict, "pool_steals", s->pool_steals) |
+                 dict_set_u64(dict, "async_submitted", s->async_submitted) |
+                 dict_set_u64(dict, "async_completed", s->async_completed) |
+                 dict_set_u64(dict, "async_cancelled", s->async_cancelled) |
+                 dict_set_u64(dict, "async_in_flight", s->async_in_flight) |
+                 dict_set_u64(dict, "alloc_count", s->alloc_count) |
+                 dict_set_u64(dict, "alloc_bytes", s->alloc_bytes);
+    for (int m = 0; m < VEDIC_METRIC_COUNT; m++) {
+        status |= dict_set_u64(dict, metric_names[m], s->counters[m]);
+    }
+    PyObject* energy = PyFloat_FromDouble(s->energy_joules);
+    status |= energy ? PyDict_SetItemString(dict, "energy_joules", energy) : -1;
+    Py_XDECREF(energy);
+    if (status != 0) {
+        Py_DECREF(dict);
+        return NULL;
+    }
+    return dict;
+}
+
+/**
+ * Counters of this process right now
+ */
+static PyObject* py_metrics_snapshot(PyObject* self, PyObject* args) {
+    VedicMetricsSnapshot snapshot;
+    vedic_metrics_collect(&snapshot);
+    return metrics_snapshot_dict(&snapshot);
+}
+
+static VedicMetricsRing* publish_ring = NULL;     // Ring of the running publisher (under the GIL)
+static char publish_name[256];
+
+/**
+ * Create a named ring and publish snapshots into it from a C thread
+ */
+static PyObject* py_metrics_publish_start(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"name", "capacity", "interval_ms", NULL};
+    const char* name = VEDIC_METRICS_DEFAULT_NAME;
+    unsigned int capacity = 0;
+    unsigned int interval_ms = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|sII:metrics_publish_start", keywords,
+                                     &name, &capacity, &interval_ms)) {
+        return NULL;
+    }
+    if (publish_ring != NULL) {
+        PyErr_Format(PyExc_RuntimeError, "metrics are already published to '%s'", publish_name);
+        return NULL;
+    }
+    if (name[0] != '/' || strlen(name) >= sizeof(publish_name) || strchr(name + 1, '/')) {
+        PyErr_Format(PyExc_ValueError, "metrics ring name must look like '/name', not '%s'", name);
+        return NULL;
+    }
+
+    VedicMetricsRing* ring = vedic_metrics_ring_create(name, capacity);
+    if (ring == NULL) {
+        return PyErr_SetFromErrnoWithFilename(PyExc_OSError, name);
+    }
+    if (vedic_metrics_publisher_start(ring, interval_ms) != 0) {
+        vedic_metrics_ring_close(ring);
+        vedic_metrics_ring_unlink(name);
+        PyErr_SetString(PyExc_RuntimeError, "metrics publisher could not be started");
+        return NULL;
+    }
+    publish_ring = ring;
+    strcpy(publish_name, name);
+    Py_RETURN_NONE;
+}
+
+/**
+ * Stop the publisher and remove its ring
+ */
+static PyObject* py_metrics_publish_stop(PyObject* self, PyObject* args) {
+    if (publish_ring == NULL) Py_RETURN_NONE;
+    Py_BEGIN_ALLOW_THREADS
+    vedic_metrics_publisher_stop();
+    Py_END_ALLOW_THREADS
+    vedic_metrics_ring_close(publish_ring);
+    vedic_metrics_ring_unlink(publish_name);
+    publish_ring = NULL;
+    Py_RETURN_NONE;
+}
+
+/**
+ * Read-only view of a metrics ring, possibly published by another process
+ */
+typedef struct {
+    PyObject_HEAD
+    VedicMetricsRing* ring;
+} MetricsReader;
+
+static PyObject* metrics_reader_new(PyTypeObject* type, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"name", NULL};
+    const char* name = VEDIC_METRICS_DEFAULT_NAME;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|s:MetricsReader", keywords, &name)) {
+        return NULL;
+    }
+    VedicMetricsRing* ring = vedic_metrics_ring_attach(name);
+    if (ring == NULL) {
+        PyErr_Format(PyExc_FileNotFoundError, "no metrics ring named '%s'", name);
+        return NULL;
+    }
+    MetricsReader* reader = (MetricsReader*)type->tp_alloc(type, 0);
+    if (reader == NULL) {
+        vedic_metrics_ring_close(ring);
+        return NULL;
+    }
+    reader->ring = ring;
+    return (PyObject*)reader;
+}
+
+static void metrics_reader_dealloc(MetricsReader* reader) {
+    if (reader->ring) vedic_metrics_ring_close(reader->ring);
+    Py_TYPE(reader)->tp_free((PyObject*)reader);
+}
+
+static int metrics_reader_open(MetricsReader* reader) {
+    if (reader->ring == NULL) {
+        PyErr_SetString(PyExc_ValueError, "metrics reader is closed");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * One snapshot by sequence, or None if it is not available
+ */
+static PyObject* metrics_reader_read(MetricsReader* reader, PyObject* arg) {
+    unsigned long long sequence = PyLong_AsUnsignedLongLong(arg);
+    if (sequence == (unsigned long long)-1 && PyErr_Occurred()) return NULL;
+    if (metrics_reader_open(reader) != 0) return NULL;
+
+    VedicMetricsSnapshot snapshot;
+    if (vedic_metrics_ring_read(reader->ring, sequence, &snapshot) != 0) Py_RETURN_NONE;
+    return metrics_snapshot_dict(&snapshot);
+}
+
+/**
+ * Snapshots newer than a sequence, oldest first
+ */
+static PyObject* metrics_reader_since(MetricsReader* reader, PyObject* args) {
+    unsigned long long after = 0;
+    if (!PyArg_ParseTuple(args, "|K:since", &after)) return NULL;
+    if (metrics_reader_open(reader) != 0) return NULL;
+
+    // Sequences already overwritten are skipped rather than reported
+    uint64_t head = vedic_metrics_ring_head(reader->ring);
+    uint32_t capacity = vedic_metrics_ring_capacity(reader->ring);
+    uint64_t first = after + 1;
+    if (head >= capacity && first < head - capacity + 1) first = head - capacity + 1;
+
+    PyObject* list = PyList_New(0);
+    if (list == NULL) return NULL;
+    for (uint64_t sequence = first; sequence <= head; sequence++) {
+        VedicMetricsSnapshot snapshot;
+        if (vedic_metrics_ring_read(reader->ring, sequence, &snapshot) != 0) continue;
+        PyObject* dict = metrics_snapshot_dict(&snapshot);
+        if (dict == NULL || PyList_Append(list, dict) != 0) {
+            Py_XDECREF(dict);
+            Py_DECREF(list);
+            return NULL;
+        }
+        Py_DECREF(dict);
+    }
+    return list;
+}
+
+static PyObject* metrics_reader_close(MetricsReader* reader, PyObject* unused) {
+    if (reader->ring) vedic_metrics_ring_close(reader->ring);
+    reader->ring = NULL;
+    Py_RETURN_NONE;
+}
+
+static PyObject* metrics_reader_head(MetricsReader* reader, void* closure) {
+    if (metrics_reader_open(reader) != 0) return NULL;
+    return PyLong_FromUnsignedLongLong(vedic_metrics_ring_head(reader->ring));
+}
+
+static PyObject* metrics_reader_capacity(MetricsReader* reader, void* closure) {
+    if (metrics_reader_open(reader) != 0) return NULL;
+    return PyLong_FromUnsignedLong(vedic_metrics_ring_capacity(reader->ring));
+}
+
+static PyMethodDef metrics_reader_methods[] = {
+    {"read", (PyCFunction)metrics_reader_read, METH_O,
+     "Snapshot with the given sequence as a dict, or None if not published or overwritten"},
+    {"since", (PyCFunction)metrics_reader_since, METH_VARARGS,
+     "Snapshots with a sequence above the given one (default 0) that are still in the ring"},
+    {"close", (PyCFunction)metrics_reader_close, METH_NOARGS, "Unmap the ring"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef metrics_reader_getset[] = {
+    {"head", (getter)metrics_reader_head, NULL, "Sequence of the newest snapshot (0 if none)", NULL},
+    {"capacity", (getter)metrics_reader_capacity, NULL, "Snapshots the ring keeps", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyTypeObject MetricsReaderType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "vedicmath.MetricsReader",
+    .tp_basicsize = sizeof(MetricsReader),
+    .tp_dealloc = (destructor)metrics_reader_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "MetricsReader(name=METRICS_RING)\n\n"
+              "Read-only view of a metrics ring published by metrics_publish_start()\n"
+              "or by another process. Reads copy snapshots out of shared memory\n"
+              "without locks or system calls.",
+    .tp_new = metrics_reader_new,
+    .tp_methods = metrics_reader_methods,
+    .tp_getset = metrics_reader_getset,
+};
+
 /**
  * Get library version
  */
@@ -204,6 +1334,130 @@ static PyMethodDef VedicMathMethods[] = {
      "    >>> evaluate('102 * 32')\n"
      "    3264"},
     
+    {"multiply_batch", (PyCFunction)(void(*)(void))py_multiply_batch, METH_VARARGS | METH_KEYWORDS,
+     "Multiply two arrays element-wise using Vedic mathematics.\n\n"
+     "Runs on the library thread pool with the GIL released, reading and\n"
+     "writing the arrays directly through the buffer protocol.\n\n"
+     "Args:\n"
+     "    a: C-contiguous int32, int64 or float64 array\n"
+     "    b: Array of the same type and length\n"
+     "    out: Writable array of the same type and length, a itself for in\n"
+     "        place; defaults to a new array like a\n\n"
+     "Returns:\n"
+     "    The output array\n\n"
+     "Example:\n"
+     "    >>> multiply_batch(np.array([102, 98]), np.array([32, 97]), np.empty(2, np.int64))\n"
+     "    array([3264, 9506])"},
+    
+    {"square_batch", (PyCFunction)(void(*)(void))py_square_batch, METH_VARARGS | METH_KEYWORDS,
+     "Square an array element-wise using Vedic mathematics.\n\n"
+     "Args:\n"
+     "    a: C-contiguous int32, int64 or float64 array\n"
+     "    out: Writable array of the same type and length, a itself for in\n"
+     "        place; defaults to a new array like a\n\n"
+     "Returns:\n"
+     "    The output array"},
+    
+    {"divide_batch", (PyCFunction)(void(*)(void))py_divide_batch, METH_VARARGS | METH_KEYWORDS,
+     "Divide two arrays element-wise using Vedic mathematics.\n\n"
+     "Integer arrays raise ZeroDivisionError if any divisor is zero (the\n"
+     "other elements are still computed); float64 arrays follow IEEE rules.\n\n"
+     "Args:\n"
+     "    a: C-contiguous int32, int64 or float64 dividends\n"
+     "    b: Divisors of the same type and length\n"
+     "    out: Writable array for the quotients, a itself for in place;\n"
+     "        defaults to a new array like a\n"
+     "    remainder: Optional writable array for the remainders\n\n"
+     "Returns:\n"
+     "    The quotient array"},
+    
+    {"unified_init", (PyCFunction)(void(*)(void))py_unified_init, METH_VARARGS | METH_KEYWORDS,
+     "Initialize or reconfigure the unified adaptive dispatcher.\n\n"
+     "The unified_* functions initialize it with the performance preset on\n"
+     "first use, so calling this is only needed to pick another preset.\n\n"
+     "Args:\n"
+     "    preset (str): 'research', 'performance', 'energy_efficient', 'embedded' or 'desktop'\n"
+     "    dataset_logging (bool): Record every operation in the research dataset"},
+    
+    {"unified_multiply", py_unified_multiply, METH_VARARGS,
+     "Multiply through the unified adaptive dispatcher.\n\n"
+     "Returns:\n"
+     "    dict: result, algorithm, sutra_sanskrit, confidence, predicted_speedup,\n"
+     "    actual_speedup, reasoning, execution_time_ms, standard_time_ms,\n"
+     "    correct and operation_id"},
+    
+    {"unified_divide", py_unified_divide, METH_VARARGS,
+     "Divide through the unified adaptive dispatcher.\n\n"
+     "Returns:\n"
+     "    dict: As unified_multiply, with the quotient in result plus remainder"},
+    
+    {"matrix_multiply", (PyCFunction)(void(*)(void))py_matrix_multiply, METH_VARARGS | METH_KEYWORDS,
+     "Multiply two matrices with the pattern-partitioned Vedic batch.\n\n"
+     "Rows run on the library thread pool with the GIL released.\n\n"
+     "Args:\n"
+     "    a: 2-D C-contiguous int64 array (m x k)\n"
+     "    b: 2-D C-contiguous int64 array (k x n)\n"
+     "    out: Writable 2-D int64 array (m x n) for the product\n\n"
+     "Returns:\n"
+     "    dict: Dispatch metadata as unified_multiply; result is the sum of all entries"},
+    
+    {"run_benchmark", (PyCFunction)(void(*)(void))py_run_benchmark, METH_VARARGS | METH_KEYWORDS,
+     "Time generated operands against standard multiplication.\n\n"
+     "Args:\n"
+     "    count (int): Number of operations\n"
+     "    seed (int): Generator seed; equal seeds give equal operands\n"
+     "    patterns (int): Bit mask over DATASET_PATTERNS; 0 means all\n\n"
+     "Returns:\n"
+     "    dict: records, vedic_methods_used, correct, average_speedup,\n"
+     "    patterns, sutras and the first records as samples"},
+    
+    {"generate_dataset", (PyCFunction)(void(*)(void))py_generate_dataset, METH_VARARGS | METH_KEYWORDS,
+     "Write a generated research dataset straight to a CSV file.\n\n"
+     "Records are generated and written in chunks without the GIL, so\n"
+     "memory use does not grow with count.\n\n"
+     "Args:\n"
+     "    path (str): Output file\n"
+     "    count (int): Number of records\n"
+     "    seed (int): Generator seed\n"
+     "    patterns (int): Bit mask over DATASET_PATTERNS; 0 means all\n\n"
+     "Returns:\n"
+     "    dict: Summary as run_benchmark, without samples"},
+    
+    {"dataset_cursor", (PyCFunction)(void(*)(void))py_dataset_cursor, METH_VARARGS | METH_KEYWORDS,
+     "Iterate over generated dataset records a chunk at a time.\n\n"
+     "Each step generates the next chunk with the GIL released and returns\n"
+     "it as bytes, so a response can be streamed while memory and the time\n"
+     "to the first chunk stay independent of count.\n\n"
+     "Args:\n"
+     "    count (int): Number of records\n"
+     "    seed (int): Generator seed, as generate_dataset\n"
+     "    patterns (int): Bit mask over DATASET_PATTERNS; 0 means all\n"
+     "    format (str): 'ndjson' (one object per line) or 'csv' (header in the first chunk)\n"
+     "    chunk (int): Records per step\n\n"
+     "Returns:\n"
+     "    DatasetCursor: Iterator of bytes; summary() gives the totals so far\n\n"
+     "Example:\n"
+     "    >>> for text in dataset_cursor(1_000_000, seed=7):\n"
+     "    ...     sink.write(text)"},
+    
+    {"metrics_snapshot", py_metrics_snapshot, METH_NOARGS,
+     "Engine counters of this process.\n\n"
+     "Returns:\n"
+     "    dict: Cumulative dispatcher, batch, pool, async and allocation counters,\n"
+     "          async_in_flight and energy_joules (-1 if unavailable)"},
+    
+    {"metrics_publish_start", (PyCFunction)(void(*)(void))py_metrics_publish_start, METH_VARARGS | METH_KEYWORDS,
+     "Publish engine counters into a shared-memory ring from a C thread.\n\n"
+     "Any process can follow the ring with MetricsReader. One publisher per\n"
+     "process; an existing ring of the same name is replaced.\n\n"
+     "Args:\n"
+     "    name (str): Ring name, '/name' (default METRICS_RING)\n"
+     "    capacity (int): Snapshots kept; 0 means 256\n"
+     "    interval_ms (int): Time between snapshots; 0 means 250"},
+    
+    {"metrics_publish_stop", py_metrics_publish_stop, METH_NOARGS,
+     "Stop the publisher and remove its ring (no effect if not publishing)"},
+    
     {"version", py_get_version, METH_NOARGS,
      "Get VedicMath library version.\n\n"
      "Returns:\n"
@@ -246,6 +1500,32 @@ PyMODINIT_FUNC PyInit_vedicmath(void) {
     PyModule_AddIntConstant(module, "VEDIC_FLOAT", VEDIC_FLOAT);
     PyModule_AddIntConstant(module, "VEDIC_DOUBLE", VEDIC_DOUBLE);
     
+    if (PyType_Ready(&DatasetCursorType) < 0) {
+        Py_DECREF(module);
+        return NULL;
+    }
+    Py_INCREF(&DatasetCursorType);
+    PyModule_AddObject(module, "DatasetCursor", (PyObject*)&DatasetCursorType);
+    
+    if (PyType_Ready(&MetricsReaderType) < 0) {
+        Py_DECREF(module);
+        return NULL;
+    }
+    Py_INCREF(&MetricsReaderType);
+    PyModule_AddObject(module, "MetricsReader", (PyObject*)&MetricsReaderType);
+    PyModule_AddStringConstant(module, "METRICS_RING", VEDIC_METRICS_DEFAULT_NAME);
+    
+    // Dataset pattern names in bit order of the patterns masks
+    PyObject* patterns = PyTuple_New(DATASET_PATTERN_COUNT);
+    if (patterns == NULL) {
+        Py_DECREF(module);
+        return NULL;
+    }
+    for (int p = 0; p < DATASET_PATTERN_COUNT; p++) {
+        PyTuple_SET_ITEM(patterns, p, PyUnicode_FromString(unified_dispatch_pattern_name((DatasetPattern)p)));
+    }
+    PyModule_AddObject(module, "DATASET_PATTERNS", patterns);
+    
     return module;
 }
 
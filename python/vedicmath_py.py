@@ -10,6 +10,11 @@ from typing import Union, List, Tuple, Optional
 from dataclasses import dataclass
 from enum import Enum
 
+try:
+    import vedicmath as _native    # CPython extension (BUILD_PYTHON_BINDINGS)
+except ImportError:
+    _native = None
+
 class VedicNumberType(Enum):
     INT32 = 0
     INT64 = 1
@@ -98,6 +103,10 @@ class VedicMathLibrary:
         
         self.lib.urdhva_mult.argtypes = [ctypes.c_long, ctypes.c_long]
         self.lib.urdhva_mult.restype = ctypes.c_long
+
+        self.lib.vedic_multiply_batch.argtypes = [ctypes.c_void_p, ctypes.c_void_p,
+                                                  ctypes.c_void_p, ctypes.c_size_t]
+        self.lib.vedic_multiply_batch.restype = None
         
         # Enhanced dispatcher (if available)
         try:
@@ -158,6 +167,68 @@ class VedicMathLibrary:
         """General multiplication using Urdhva-Tiryagbhyam"""
         return self.lib.urdhva_mult(int(a), int(b))
     
+    # ------------------------------------------------------------------
+    # Array batches: one call per array instead of one per element
+    # ------------------------------------------------------------------
+
+    @staticmethod
+    def _batch_operands(*arrays) -> List[np.ndarray]:
+        """Common dtype, C-contiguous views; copies only when an input needs converting"""
+        arrays = [np.asarray(array) for array in arrays]
+        dtype = np.result_type(*arrays)
+        if dtype.kind == 'f':
+            dtype = np.float64
+        elif dtype not in (np.int32, np.int64):
+            dtype = np.int64
+        return [np.ascontiguousarray(array, dtype=dtype) for array in arrays]
+
+    def multiply_batch(self, a, b, out: Optional[np.ndarray] = None) -> np.ndarray:
+        """Element-wise Vedic multiply; out may be preallocated (or a itself)"""
+        a, b = self._batch_operands(a, b)
+        if out is None:
+            out = np.empty_like(a)
+        if _native is not None:
+            # Runs on the library thread pool with the GIL released
+            return _native.multiply_batch(a, b, out)
+        if a.dtype == np.int64 and ctypes.sizeof(ctypes.c_long) == 8:
+            # ctypes releases the GIL for the call as well
+            self.lib.vedic_multiply_batch(out.ctypes.data, a.ctypes.data, b.ctypes.data, len(a))
+            return out
+        out[...] = [self.multiply(x, y) for x, y in zip(a.tolist(), b.tolist())]
+        return out
+
+    def square_batch(self, a, out: Optional[np.ndarray] = None) -> np.ndarray:
+        """Element-wise Vedic square; out may be preallocated (or a itself)"""
+        (a,) = self._batch_operands(a)
+        if out is None:
+            out = np.empty_like(a)
+        if _native is not None:
+            return _native.square_batch(a, out)
+        out[...] = [self.square(x) for x in a.tolist()]
+        return out
+
+    def divide_batch(self, a, b, out: Optional[np.ndarray] = None,
+                     remainder: Optional[np.ndarray] = None) -> Tuple[np.ndarray, np.ndarray]:
+        """Element-wise Vedic divide, returns (quotients, remainders)"""
+        a, b = self._batch_operands(a, b)
+        if out is None:
+            out = np.empty_like(a)
+        if remainder is None:
+            remainder = np.empty_like(a)
+        if _native is not None:
+            _native.divide_batch(a, b, out, remainder)
+            return out, remainder
+        if a.dtype.kind == 'f':
+            np.divide(a, b, out=out)
+            np.fmod(a, b, out=remainder)
+            return out, remainder
+        if not b.all():
+            raise ZeroDivisionError("divide_batch: division by zero")
+        pairs = [self.divide(x, y) for x, y in zip(a.tolist(), b.tolist())]
+        out[...] = [q for q, _ in pairs]
+        remainder[...] = [r for _, r in pairs]
+        return out, remainder
+
     def benchmark_multiplication(self, test_cases: List[Tuple[int, int]], 
                                methods: List[str] = None) -> pd.DataFrame:
         """Benchmark different multiplication methods"""
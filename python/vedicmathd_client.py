@@ -0,0 +1,144 @@
+"""
+vedicmathd_client.py - Client for the vedicmathd compute daemon
+
+Speaks the binary protocol of include/vedicmath_wire.h over the daemon's
+Unix domain socket. One client holds one connection; requests can be
+pipelined with submit() and collected with collect(), or sent one at a
+time with the blocking helpers.
+"""
+import socket
+import struct
+from enum import IntEnum
+from typing import Dict, List, Optional, Sequence, Tuple
+
+import numpy as np
+
+WIRE_MAGIC = 0x31444D56
+WIRE_HEADER = struct.Struct("=IIQHHHHII")   # Matches VedicWireHeader (32 bytes)
+DEFAULT_SOCKET = "/tmp/vedicmathd.sock"
+
+
+class WireOp(IntEnum):
+    PING = 0
+    MULTIPLY = 1
+    SQUARE = 2
+    DIVIDE = 3
+
+
+class WireType(IntEnum):
+    INT32 = 1
+    INT64 = 2
+
+
+class WireStatus(IntEnum):
+    OK = 0
+    BAD_REQUEST = 1
+    TOO_LARGE = 2
+    BUSY = 3
+    DIVIDE_BY_ZERO = 4
+    INTERNAL_ERROR = 5
+
+
+class VedicDaemonError(RuntimeError):
+    """A request the daemon answered with a non-OK status"""
+
+    def __init__(self, status: int, request_id: int):
+        super().__init__(f"vedicmathd request {request_id} failed: {WireStatus(status).name}")
+        self.status = WireStatus(status)
+        self.request_id = request_id
+
+
+class VedicDaemonClient:
+    """Connection to a running vedicmathd"""
+
+    def __init__(self, path: str = DEFAULT_SOCKET, timeout: Optional[float] = 5.0):
+        self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.sock.settimeout(timeout)
+        self.sock.connect(path)
+        self.next_id = 1
+        self.pending: Dict[int, np.ndarray] = {}     # Responses read while waiting for another
+
+    def close(self) -> None:
+        self.sock.close()
+
+    def __enter__(self) -> "VedicDaemonClient":
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()
+
+    # ------------------------------------------------------------------
+    # Pipelined interface
+    # ------------------------------------------------------------------
+
+    def submit(self, op: WireOp, *operands: Sequence[int]) -> int:
+        """Send one batch without waiting; returns its request id"""
+        arrays = [np.ascontiguousarray(operand, dtype=np.int64) for operand in operands]
+        count = len(arrays[0]) if arrays else 0
+        if any(len(array) != count for array in arrays):
+            raise ValueError("operand arrays must have the same length")
+
+        # int32 halves the bytes on the wire when every operand fits
+        wire_type = WireType.INT64
+        if arrays and all(array.size == 0 or (array.min() >= -2**31 and array.max() < 2**31) for array in arrays):
+            arrays = [array.astype(np.int32) for array in arrays]
+            wire_type = WireType.INT32
+        payload = b"".join(array.tobytes() for array in arrays)
+
+        request_id = self.next_id
+        self.next_id += 1
+        header = WIRE_HEADER.pack(len(payload), WIRE_MAGIC, request_id, int(op), int(wire_type), 0, 0, count, 0)
+        self.sock.sendall(header + payload)
+        return request_id
+
+    def collect(self) -> Tuple[int, np.ndarray]:
+        """Read the next response: (request id, int64 results)"""
+        if self.pending:
+            request_id = next(iter(self.pending))
+            return request_id, self.pending.pop(request_id)
+        header = self._read_exact(WIRE_HEADER.size)
+        length, magic, request_id, op, _type, status, _reserved, count, _reserved2 = WIRE_HEADER.unpack(header)
+        if magic != WIRE_MAGIC:
+            raise ConnectionError("vedicmathd: bad response magic")
+        payload = self._read_exact(length)
+        if status != WireStatus.OK:
+            raise VedicDaemonError(status, request_id)
+        return request_id, np.frombuffer(payload, dtype=np.int64)
+
+    def _read_exact(self, size: int) -> bytes:
+        chunks: List[bytes] = []
+        remaining = size
+        while remaining > 0:
+            chunk = self.sock.recv(min(remaining, 1 << 20))
+            if not chunk:
+                raise ConnectionError("vedicmathd closed the connection")
+            chunks.append(chunk)
+            remaining -= len(chunk)
+        return b"".join(chunks)
+
+    def _call(self, op: WireOp, *operands: Sequence[int]) -> np.ndarray:
+        request_id = self.submit(op, *operands)
+        # Responses to earlier pipelined requests may arrive first
+        while True:
+            response_id, results = self.collect()
+            if response_id == request_id:
+                return results
+            self.pending[response_id] = results
+
+    # ------------------------------------------------------------------
+    # Blocking helpers
+    # ------------------------------------------------------------------
+
+    def ping(self) -> None:
+        self._call(WireOp.PING)
+
+    def multiply(self, a: Sequence[int], b: Sequence[int]) -> np.ndarray:
+        return self._call(WireOp.MULTIPLY, a, b)
+
+    def square(self, a: Sequence[int]) -> np.ndarray:
+        return self._call(WireOp.SQUARE, a)
+
+    def divide(self, a: Sequence[int], b: Sequence[int]) -> Tuple[np.ndarray, np.ndarray]:
+        results = self._call(WireOp.DIVIDE, a, b)
+        count = len(results) // 2
+        return results[:count], results[count:]
@@ -10,6 +10,9 @@
  */
 
 #include "vedicmath.h"
+#include "../../benchmarks/vedicmath_bench_harness.h"
+#include "../../benchmarks/vedicmath_perf_counters.h"
+#include "../../benchmarks/vedicmath_bench_json.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
@@ -30,11 +33,11 @@
 
 // Advanced benchmark configuration
 typedef struct {
-    size_t min_iterations;
-    size_t max_iterations;
+    size_t min_samples;          // Minimum timed samples before adaptive stop
+    size_t max_samples;          // Hard cap on timed samples
+    double sample_time_sec;      // Target wall time of one sample (calibrated)
     double target_confidence;    // Statistical confidence level (0.95 = 95%)
     double max_variance;         // Maximum acceptable variance
-    double warmup_ratio;         // Fraction of iterations for warmup
     bool adaptive_scaling;       // Enable adaptive difficulty
     bool resource_monitoring;    // Enable CPU/memory monitoring
 } BenchmarkConfig;
@@ -44,7 +47,7 @@ typedef struct {
     double cpu_usage_percent;
     size_t memory_used_bytes;
     size_t memory_peak_bytes;
-    double cache_miss_rate;      // If available
+    double cache_miss_rate;      // L1D read misses per operation (hardware counters, if available)
     size_t context_switches;     // If available
 } ResourceMetrics;
 
@@ -67,6 +70,7 @@ typedef struct {
     
     // Resource usage
     ResourceMetrics resources;
+    BenchPerfSummary perf;       // IPC, cycles/op, misses/op (perf.available == false if unsupported)
     
     // Statistical validity
     size_t sample_size;
@@ -93,15 +97,23 @@ typedef enum {
 
 // Global benchmark configuration
 static BenchmarkConfig global_config = {
-    .min_iterations = 1000,
-    .max_iterations = 100000,
+    .min_samples = 10,
+    .max_samples = 200,
+    .sample_time_sec = 0.002,
     .target_confidence = 0.95,
     .max_variance = 0.1,
-    .warmup_ratio = 0.1,
     .adaptive_scaling = true,
     .resource_monitoring = true
 };
 
+// Pre-generated operand pool for one pattern; only the operation itself is
+// executed inside a timed sample
+typedef struct {
+    long a[BENCH_POOL_SIZE];
+    long b[BENCH_POOL_SIZE];
+    long (*operation)(long, long);
+} PatternPool;
+
 // Statistical utility functions
 static double calculate_mean(double* data, size_t n) {
     double sum = 0.0;
@@ -242,6 +254,18 @@ static void generate_test_pair(PatternType pattern, long* a, long* b) {
     }
 }
 
+// Run the pool's operation over the first iterations entries (wrapping)
+static int run_pattern_pool(size_t iterations, void* data) {
+    const PatternPool* pool = (const PatternPool*)data;
+    
+    for (size_t i = 0; i < iterations; i++) {
+        size_t j = i & BENCH_POOL_MASK;
+        long result_val = pool->operation(pool->a[j], pool->b[j]);
+        BENCH_DO_NOT_OPTIMIZE(result_val);
+    }
+    return 1;
+}
+
 // Advanced benchmarking function
 static AdvancedBenchmarkResult run_advanced_benchmark(
     const char* test_name,
@@ -251,27 +275,34 @@ static AdvancedBenchmarkResult run_advanced_benchmark(
 ) {
     AdvancedBenchmarkResult result = {0};
     result.test_name = test_name;
+    result.sutra_used = "Auto-selected";
     result.pattern_type = pattern;
     
     // Allocate arrays for timing data
-    size_t max_samples = config->max_iterations;
+    size_t max_samples = config->max_samples;
     double* timings = malloc(sizeof(double) * max_samples);
-    if (!timings) {
+    PatternPool* pool = malloc(sizeof(PatternPool));
+    if (!timings || !pool) {
+        free(timings);
+        free(pool);
         result.is_statistically_valid = false;
         return result;
     }
     
-    // Warmup phase
-    size_t warmup_iterations = (size_t)(config->min_iterations * config->warmup_ratio);
-    printf("Warming up with %zu iterations...\n", warmup_iterations);
-    
-    for (size_t i = 0; i < warmup_iterations; i++) {
-        long a, b;
-        generate_test_pair(pattern, &a, &b);
-        volatile long dummy = operation(a, b);
-        (void)dummy;  // Suppress unused variable warning
+    // Generate all operands before anything is timed
+    pool->operation = operation;
+    for (size_t i = 0; i < BENCH_POOL_SIZE; i++) {
+        generate_test_pair(pattern, &pool->a[i], &pool->b[i]);
     }
     
+    // Calibrate the per-sample batch size; this also warms up caches and
+    // branch predictors
+    BenchHarnessConfig harness = *bench_harness_get_config();
+    harness.target_time_sec = config->sample_time_sec;
+    harness.min_iterations = BENCH_POOL_SIZE;
+    size_t batch_iterations = bench_calibrate(run_pattern_pool, pool, &harness);
+    printf("Calibrated %zu operations per sample\n", batch_iterations);
+    
     // Resource monitoring setup
     ResourceMetrics start_resources = {0};
     if (config->resource_monitoring) {
@@ -285,43 +316,50 @@ static AdvancedBenchmarkResult run_advanced_benchmark(
     printf("Running adaptive benchmark (target confidence: %.1f%%)...\n", 
            config->target_confidence * 100);
     
-    while (sample_count < config->max_iterations) {
-        // Generate test case
-        long a, b;
-        generate_test_pair(pattern, &a, &b);
+    // Hardware counters accumulate across all samples; they are paused
+    // while the adaptive statistics below are computed
+    BenchPerfCounters* counters = bench_perf_shared();
+    BenchPerfSample perf_sample;
+    uint64_t perf_totals[BENCH_PERF_EVENT_COUNT] = {0};
+    bool perf_valid[BENCH_PERF_EVENT_COUNT] = {false};
+    
+    while (sample_count < max_samples) {
+        // Time one calibrated batch and record the per-operation cost
+        bench_perf_start(counters);
+        uint64_t start = bench_now_ns();
+        run_pattern_pool(batch_iterations, pool);
+        uint64_t end = bench_now_ns();
+        bench_perf_stop(counters, &perf_sample);
         
-        // Measure execution time
-        clock_t start = clock();
-        volatile long result_val = operation(a, b);
-        clock_t end = clock();
-        (void)result_val;
+        for (int e = 0; e < BENCH_PERF_EVENT_COUNT; e++) {
+            perf_totals[e] += perf_sample.values[e];
+            perf_valid[e] = perf_valid[e] || perf_sample.valid[e];
+        }
         
-        // Record timing
-        double elapsed_ms = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
+        double elapsed_ms = (double)(end - start) / 1e6 / (double)batch_iterations;
         timings[sample_count] = elapsed_ms;
         sample_count++;
         
         // Check for adaptive termination
-        if (config->adaptive_scaling && sample_count >= config->min_iterations) {
-            if (sample_count % 100 == 0) {  // Check every 100 samples
-                double mean = calculate_mean(timings, sample_count);
-                double std_dev = calculate_std_dev(timings, sample_count, mean);
-                running_variance = (std_dev / mean);
-                
-                // Check if we have sufficient statistical confidence
-                if (running_variance < config->max_variance) {
-                    printf("Achieved target confidence after %zu samples\n", sample_count);
-                    break;
-                }
+        if (config->adaptive_scaling && sample_count >= config->min_samples) {
+            double mean = calculate_mean(timings, sample_count);
+            double std_dev = calculate_std_dev(timings, sample_count, mean);
+            running_variance = (std_dev / mean);
+            
+            // Check if we have sufficient statistical confidence
+            if (running_variance < config->max_variance) {
+                printf("Achieved target confidence after %zu samples\n", sample_count);
+                break;
             }
         }
-        
-        // Progress reporting
-        if (sample_count % 10000 == 0) {
-            printf("Completed %zu samples (variance: %.4f)\n", sample_count, running_variance);
-        }
     }
     
+    // Per-operation hardware counter figures over all samples
+    memcpy(perf_sample.values, perf_totals, sizeof(perf_totals));
+    memcpy(perf_sample.valid, perf_valid, sizeof(perf_valid));
+    result.perf = bench_perf_summarize(&perf_sample, (double)batch_iterations * (double)sample_count);
+    result.resources.cache_miss_rate = result.perf.l1d_misses_per_op;
+    
     // Resource monitoring end
     ResourceMetrics end_resources = {0};
     if (config->resource_monitoring) {
@@ -330,6 +368,18 @@ static AdvancedBenchmarkResult run_advanced_benchmark(
         result.resources.memory_peak_bytes = end_resources.memory_peak_bytes;
     }
     
+    // Export the raw samples (in run order, as ns/op) before sorting
+    if (bench_json_active()) {
+        double* samples_ns = malloc(sizeof(double) * sample_count);
+        if (samples_ns) {
+            for (size_t i = 0; i < sample_count; i++) {
+                samples_ns[i] = timings[i] * 1e6;
+            }
+            bench_json_record(test_name, "Adaptive", samples_ns, sample_count, batch_iterations, &result.perf);
+            free(samples_ns);
+        }
+    }
+    
     // Sort timings for median calculation
     qsort(timings, sample_count, sizeof(double), compare_doubles);
     
@@ -349,11 +399,13 @@ static AdvancedBenchmarkResult run_advanced_benchmark(
     
     // Performance metrics
     result.operations_per_second = 1000.0 / result.mean_time_ms;
-    result.efficiency_score = result.operations_per_second / result.resources.memory_used_bytes * 1000000; // ops/MB
+    if (result.resources.memory_used_bytes > 0) {
+        result.efficiency_score = result.operations_per_second / result.resources.memory_used_bytes * 1000000; // ops/MB
+    }
     
     // Statistical validity check
     result.is_statistically_valid = (result.variance < config->max_variance) && 
-                                   (sample_count >= config->min_iterations);
+                                   (sample_count >= config->min_samples);
     
     // Determine which sutra was likely used (simplified heuristic)
     switch (pattern) {
@@ -372,6 +424,7 @@ static AdvancedBenchmarkResult run_advanced_benchmark(
     }
     
     free(timings);
+    free(pool);
     return result;
 }
 
@@ -382,18 +435,28 @@ static void print_advanced_results(const AdvancedBenchmarkResult* result) {
     printf("Sample Size: %zu (statistically valid: %s)\n", 
            result->sample_size, result->is_statistically_valid ? "YES" : "NO");
     
-    printf("\nTiming Statistics:\n");
-    printf("  Mean: %.6f ms (±%.6f ms)\n", result->mean_time_ms, result->std_dev_ms);
-    printf("  Median: %.6f ms\n", result->median_time_ms);
-    printf("  Range: [%.6f, %.6f] ms\n", result->min_time_ms, result->max_time_ms);
-    printf("  95%% CI: [%.6f, %.6f] ms\n", 
-           result->confidence_interval_95[0], result->confidence_interval_95[1]);
+    printf("\nTiming Statistics (per operation):\n");
+    printf("  Mean: %.3f ns (±%.3f ns)\n", result->mean_time_ms * 1e6, result->std_dev_ms * 1e6);
+    printf("  Median: %.3f ns\n", result->median_time_ms * 1e6);
+    printf("  Range: [%.3f, %.3f] ns\n", result->min_time_ms * 1e6, result->max_time_ms * 1e6);
+    printf("  95%% CI: [%.3f, %.3f] ns\n", 
+           result->confidence_interval_95[0] * 1e6, result->confidence_interval_95[1] * 1e6);
     printf("  Variance: %.4f\n", result->variance);
     
     printf("\nPerformance Metrics:\n");
     printf("  Operations/sec: %.2f\n", result->operations_per_second);
     printf("  Efficiency score: %.2f ops/MB\n", result->efficiency_score);
     
+    if (result->perf.available) {
+        printf("\nHardware Counters:\n");
+        printf("  IPC: %.2f\n", result->perf.ipc);
+        printf("  Cycles/op: %.2f (instructions/op: %.2f)\n",
+               result->perf.cycles_per_op, result->perf.instructions_per_op);
+        printf("  Branch misses/op: %.4f\n", result->perf.branch_misses_per_op);
+        printf("  L1D misses/op: %.4f, LLC misses/op: %.4f\n",
+               result->perf.l1d_misses_per_op, result->perf.llc_misses_per_op);
+    }
+    
     if (result->resources.memory_used_bytes > 0) {
         printf("\nResource Usage:\n");
         printf("  Memory used: %zu bytes\n", result->resources.memory_used_bytes);
@@ -402,7 +465,7 @@ static void print_advanced_results(const AdvancedBenchmarkResult* result) {
 }
 
 // Run comprehensive benchmark suite
-void run_novel_benchmark_suite() {
+void run_novel_benchmark_suite(void) {
     printf("=== Novel Adaptive Benchmarking Suite ===\n");
     printf("Configuration:\n");
     printf("  Target confidence: %.1f%%\n", global_config.target_confidence * 100);
@@ -0,0 +1,298 @@
+/**
+ * vedicmath_alloc.c - Pluggable allocator and allocation accounting
+ */
+#include "vedicmath_alloc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+static SRWLOCK alloc_lock = SRWLOCK_INIT;
+#define ALLOC_LOCK() AcquireSRWLockExclusive(&alloc_lock)
+#define ALLOC_UNLOCK() ReleaseSRWLockExclusive(&alloc_lock)
+#define ALLOC_THREAD_LOCAL __declspec(thread)
+#else
+#include <pthread.h>
+static pthread_mutex_t alloc_lock = PTHREAD_MUTEX_INITIALIZER;
+#define ALLOC_LOCK() pthread_mutex_lock(&alloc_lock)
+#define ALLOC_UNLOCK() pthread_mutex_unlock(&alloc_lock)
+#define ALLOC_THREAD_LOCAL __thread
+#endif
+
+// Distinct (call site, API) pairs that can be recorded; further pairs are
+// only counted in the totals
+#define ALLOC_MAX_SITES 256
+#define ALLOC_NO_API "(none)"
+
+typedef enum {
+    ALLOC_EVENT_ALLOCATE,
+    ALLOC_EVENT_REALLOCATE,
+    ALLOC_EVENT_FREE
+} AllocEvent;
+
+// ============================================================================
+// ALLOCATOR
+// ============================================================================
+
+static void *default_allocate(size_t size, void *context) {
+    (void)context;
+    return malloc(size);
+}
+
+static void *default_reallocate(void *ptr, size_t size, void *context) {
+    (void)context;
+    return realloc(ptr, size);
+}
+
+static void default_release(void *ptr, void *context) {
+    (void)context;
+    free(ptr);
+}
+
+static VedicAllocator current_allocator = {default_allocate, default_reallocate, default_release, NULL};
+
+int vedic_set_allocator(const VedicAllocator *allocator) {
+    if (!allocator) {
+        current_allocator.allocate = default_allocate;
+        current_allocator.reallocate = default_reallocate;
+        current_allocator.release = default_release;
+        current_allocator.context = NULL;
+        return 0;
+    }
+    if (!allocator->allocate || !allocator->reallocate || !allocator->release) {
+        return -1;
+    }
+    current_allocator = *allocator;
+    return 0;
+}
+
+VedicAllocator vedic_get_allocator(void) {
+    return current_allocator;
+}
+
+// ============================================================================
+// ACCOUNTING
+// ============================================================================
+
+static volatile int tracking_enabled = 0;
+static ALLOC_THREAD_LOCAL const char *current_api = NULL;
+
+static VedicAllocCounts totals;
+static VedicAllocSiteStats sites[ALLOC_MAX_SITES];
+static size_t site_count = 0;
+
+static const char *file_basename(const char *path) {
+    const char *base = path;
+    for (const char *p = path; *p; p++) {
+        if (*p == '/' || *p == '\\') base = p + 1;
+    }
+    return base;
+}
+
+static int same_string(const char *a, const char *b) {
+    return a == b || strcmp(a, b) == 0;
+}
+
+/**
+ * Find or create the entry of a (site, API) pair; caller holds the lock
+ */
+static VedicAllocSiteStats *find_site(const char *file, int line, const char *function, const char *api) {
+    file = file_basename(file);
+    for (size_t i = 0; i < site_count; i++) {
+        VedicAllocSiteStats *site = &sites[i];
+        if (site->line == line && same_string(site->file, file) && same_string(site->api, api)) {
+            return site;
+        }
+    }
+    if (site_count >= ALLOC_MAX_SITES) {
+        return NULL;
+    }
+
+    VedicAllocSiteStats *site = &sites[site_count++];
+    memset(site, 0, sizeof(*site));
+    site->file = file;
+    site->line = line;
+    site->function = function;
+    site->api = api;
+    return site;
+}
+
+static void record(AllocEvent event, size_t size, int failed,
+                   const char *file, int line, const char *function) {
+    const char *api = current_api ? current_api : ALLOC_NO_API;
+
+    ALLOC_LOCK();
+    VedicAllocSiteStats *site = find_site(file, line, function, api);
+    VedicAllocCounts *counts[2] = {&totals, site ? &site->counts : NULL};
+
+    for (int i = 0; i < 2; i++) {
+        VedicAllocCounts *c = counts[i];
+        if (!c) continue;
+        switch (event) {
+            case ALLOC_EVENT_ALLOCATE: c->allocations++; break;
+            case ALLOC_EVENT_REALLOCATE: c->reallocations++; break;
+            case ALLOC_EVENT_FREE: c->frees++; break;
+        }
+        c->bytes += size;
+        if (failed) c->failures++;
+    }
+    ALLOC_UNLOCK();
+}
+
+void vedic_alloc_tracking_enable(bool enable) {
+    tracking_enabled = enable ? 1 : 0;
+}
+
+bool vedic_alloc_tracking_enabled(void) {
+    return tracking_enabled != 0;
+}
+
+void vedic_alloc_tracking_reset(void) {
+    ALLOC_LOCK();
+    memset(&totals, 0, sizeof(totals));
+    site_count = 0;
+    ALLOC_UNLOCK();
+}
+
+VedicAllocCounts vedic_alloc_get_totals(void) {
+    ALLOC_LOCK();
+    VedicAllocCounts copy = totals;
+    ALLOC_UNLOCK();
+    return copy;
+}
+
+size_t vedic_alloc_get_sites(VedicAllocSiteStats *out, size_t max_sites) {
+    ALLOC_LOCK();
+    size_t count = site_count;
+    if (out) {
+        memcpy(out, sites, (count < max_sites ? count : max_sites) * sizeof(VedicAllocSiteStats));
+    }
+    ALLOC_UNLOCK();
+    return count;
+}
+
+void vedic_alloc_print_report(void) {
+    static VedicAllocSiteStats snapshot[ALLOC_MAX_SITES];
+    size_t count = vedic_alloc_get_sites(snapshot, ALLOC_MAX_SITES);
+    VedicAllocCounts all = vedic_alloc_get_totals();
+
+    printf("Allocation report: %llu allocations, %llu reallocations, %llu frees, %llu bytes requested",
+           (unsigned long long)all.allocations, (unsigned long long)all.reallocations,
+           (unsigned long long)all.frees, (unsigned long long)all.bytes);
+    if (all.failures > 0) {
+        printf(", %llu failed", (unsigned long long)all.failures);
+    }
+    printf("\n");
+    if (count == 0) return;
+
+    // Per API: sum the sites of each distinct API name
+    printf("\n%-34s %12s %12s %12s %14s\n", "API entry point", "Allocs", "Reallocs", "Frees", "Bytes");
+    for (size_t i = 0; i < count; i++) {
+        int seen = 0;
+        for (size_t j = 0; j < i && !seen; j++) {
+            seen = same_string(snapshot[j].api, snapshot[i].api);
+        }
+        if (seen) continue;
+
+        VedicAllocCounts sum = {0, 0, 0, 0, 0};
+        for (size_t j = i; j < count; j++) {
+            if (!same_string(snapshot[j].api, snapshot[i].api)) continue;
+            sum.allocations += snapshot[j].counts.allocations;
+            sum.reallocations += snapshot[j].counts.reallocations;
+            sum.frees += snapshot[j].counts.frees;
+            sum.bytes += snapshot[j].counts.bytes;
+        }
+        printf("%-34s %12llu %12llu %12llu %14llu\n", snapshot[i].api,
+               (unsigned long long)sum.allocations, (unsigned long long)sum.reallocations,
+               (unsigned long long)sum.frees, (unsigned long long)sum.bytes);
+    }
+
+    printf("\n%-44s %-26s %12s %12s %12s %14s\n", "Call site", "API entry point",
+           "Allocs", "Reallocs", "Frees", "Bytes");
+    for (size_t i = 0; i < count; i++) {
+        char location[96];
+        snprintf(location, sizeof(location), "%s:%d %s", snapshot[i].file, snapshot[i].line, snapshot[i].function);
+        printf("%-44s %-26s %12llu %12llu %12llu %14llu\n", location, snapshot[i].api,
+               (unsigned long long)snapshot[i].counts.allocations,
+               (unsigned long long)snapshot[i].counts.reallocations,
+               (unsigned long long)snapshot[i].counts.frees,
+               (unsigned long long)snapshot[i].counts.bytes);
+    }
+    if (count >= ALLOC_MAX_SITES) {
+        printf("(site table full; further sites are only counted in the totals)\n");
+    }
+}
+
+// ============================================================================
+// INTERNAL ENTRY POINTS
+// ============================================================================
+
+void *vedic_alloc_malloc(size_t size, const char *file, int line, const char *function) {
+    void *ptr = current_allocator.allocate(size, current_allocator.context);
+    if (tracking_enabled) {
+        record(ALLOC_EVENT_ALLOCATE, size, ptr == NULL && size > 0, file, line, function);
+    }
+    return ptr;
+}
+
+void *vedic_alloc_calloc(size_t count, size_t size, const char *file, int line, const char *function) {
+    if (size != 0 && count > (size_t)-1 / size) {
+        if (tracking_enabled) {
+            record(ALLOC_EVENT_ALLOCATE, 0, 1, file, line, function);
+        }
+        return NULL;
+    }
+
+    size_t bytes = count * size;
+    void *ptr = current_allocator.allocate(bytes, current_allocator.context);
+    if (ptr) {
+        memset(ptr, 0, bytes);
+    }
+    if (tracking_enabled) {
+        record(ALLOC_EVENT_ALLOCATE, bytes, ptr == NULL && bytes > 0, file, line, function);
+    }
+    return ptr;
+}
+
+void *vedic_alloc_realloc(void *ptr, size_t size, const char *file, int line, const char *function) {
+    void *result = current_allocator.reallocate(ptr, size, current_allocator.context);
+    if (tracking_enabled) {
+        record(ALLOC_EVENT_REALLOCATE, size, result == NULL && size > 0, file, line, function);
+    }
+    return result;
+}
+
+void vedic_alloc_free(void *ptr, const char *file, int line, const char *function) {
+    if (!ptr) return;
+    current_allocator.release(ptr, current_allocator.context);
+    if (tracking_enabled) {
+        record(ALLOC_EVENT_FREE, 0, 0, file, line, function);
+    }
+}
+
+char *vedic_alloc_strdup(const char *str, const char *file, int line, const char *function) {
+    size_t length = strlen(str) + 1;
+    char *copy = (char *)current_allocator.allocate(length, current_allocator.context);
+    if (copy) {
+        memcpy(copy, str, length);
+    }
+    if (tracking_enabled) {
+        record(ALLOC_EVENT_ALLOCATE, length, copy == NULL, file, line, function);
+    }
+    return copy;
+}
+
+int vedic_alloc_scope_enter(const char *api) {
+    if (!tracking_enabled || current_api) {
+        return 0;
+    }
+    current_api = api;
+    return 1;
+}
+
+void vedic_alloc_scope_leave(int opened) {
+    if (opened) {
+        current_api = NULL;
+    }
+}
@@ -0,0 +1,262 @@
+/**
+ * vedicmath_async.c - Asynchronous batch submission on the thread pool
+ */
+#include "vedicmath_async.h"
+#include "vedicmath.h"
+#include "vedicmath_alloc.h"
+#include "vedicmath_optimized.h"
+#include "vedicmath_pool.h"
+
+// Elements per range, matching the synchronous batch APIs; a cancelled
+// batch stops at the next range boundary
+static const size_t batch_grain[VEDIC_BATCH_OP_COUNT] = {4096, 1024, 512, 64, 1024};
+static const int batch_operands[VEDIC_BATCH_OP_COUNT] = {2, 1, 2, 1, 2};
+
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+#include <windows.h>
+static SRWLOCK async_lock = SRWLOCK_INIT;
+static CONDITION_VARIABLE async_finished = CONDITION_VARIABLE_INIT;
+#define ASYNC_LOCK() AcquireSRWLockExclusive(&async_lock)
+#define ASYNC_UNLOCK() ReleaseSRWLockExclusive(&async_lock)
+#define ASYNC_WAIT() SleepConditionVariableSRW(&async_finished, &async_lock, INFINITE, 0)
+#define ASYNC_BROADCAST() WakeAllConditionVariable(&async_finished)
+#else
+#include <pthread.h>
+static pthread_mutex_t async_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t async_finished = PTHREAD_COND_INITIALIZER;
+#define ASYNC_LOCK() pthread_mutex_lock(&async_lock)
+#define ASYNC_UNLOCK() pthread_mutex_unlock(&async_lock)
+#define ASYNC_WAIT() pthread_cond_wait(&async_finished, &async_lock)
+#define ASYNC_BROADCAST() pthread_cond_broadcast(&async_finished)
+#endif
+
+// Flags read by the ranges without taking async_lock
+#if defined(__GNUC__) || defined(__clang__)
+#define ASYNC_FLAG_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define ASYNC_FLAG_SET(ptr) __atomic_store_n(ptr, 1, __ATOMIC_RELEASE)
+#else
+#define ASYNC_FLAG_LOAD(ptr) (*(volatile int *)(ptr))
+#define ASYNC_FLAG_SET(ptr) (*(volatile int *)(ptr) = 1)
+#endif
+
+struct VedicBatchHandle {
+    VedicPoolTask task;              // First member: the pool hands this back
+    VedicBatchOp op;
+    const void *first;
+    const void *second;
+    void *outputs;
+    size_t count;
+    VedicBatchCallback callback;
+    void *user_data;
+    VedicBatchStatus status;         // Under async_lock
+    int cancel_requested;
+    int skipped;                     // A range was skipped after cancellation
+    int references;                  // Handle owner and the pending run
+};
+
+static size_t async_limit = VEDIC_ASYNC_DEFAULT_LIMIT;
+static VedicAsyncStats async_stats = {0, 0, 0, 0, 0, 0};
+
+static void drop_reference(VedicBatchHandle *handle) {
+    ASYNC_LOCK();
+    int remaining = --handle->references;
+    ASYNC_UNLOCK();
+    if (remaining == 0) {
+        VEDIC_FREE(handle);
+    }
+}
+
+/**
+ * Report the outcome: the callback runs before waiters see the final status
+ */
+static void finish_batch(VedicBatchHandle *handle, VedicBatchStatus status) {
+    if (handle->callback) {
+        handle->callback(handle, status, handle->user_data);
+    }
+
+    ASYNC_LOCK();
+    handle->status = status;
+    async_stats.in_flight--;
+    if (status == VEDIC_BATCH_DONE) {
+        async_stats.completed++;
+    } else {
+        async_stats.cancelled++;
+    }
+    ASYNC_BROADCAST();
+    ASYNC_UNLOCK();
+
+    drop_reference(handle);
+}
+
+static void batch_range(size_t begin, size_t end, void *context) {
+    VedicBatchHandle *handle = (VedicBatchHandle *)context;
+    if (ASYNC_FLAG_LOAD(&handle->cancel_requested)) {
+        ASYNC_FLAG_SET(&handle->skipped);
+        return;
+    }
+
+    size_t count = end - begin;
+    switch (handle->op) {
+        case VEDIC_BATCH_MULTIPLY:
+            vedic_multiply_batch((long *)handle->outputs + begin, (const long *)handle->first + begin,
+                                 (const long *)handle->second + begin, count);
+            break;
+        case VEDIC_BATCH_SQUARE:
+            vedic_square_batch((long *)handle->outputs + begin, (const long *)handle->first + begin, count);
+            break;
+        case VEDIC_BATCH_VALUE_MULTIPLY:
+            vedic_optimized_multiply_batch((VedicValue *)handle->outputs + begin,
+                                           (const VedicValue *)handle->first + begin,
+                                           (const VedicValue *)handle->second + begin, count);
+            break;
+        case VEDIC_BATCH_EVALUATE:
+            vedic_optimized_evaluate_batch((VedicValue *)handle->outputs + begin,
+                                           (const char **)handle->first + begin, count);
+            break;
+        case VEDIC_BATCH_DIVIDE: {
+            const long *dividend = (const long *)handle->first;
+            const long *divisor = (const long *)handle->second;
+            long *quotient = (long *)handle->outputs;
+            for (size_t i = begin; i < end; i++) {
+                quotient[i] = vedic_divide(dividend[i], divisor[i], NULL);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void run_batch(VedicBatchHandle *handle) {
+    ASYNC_LOCK();
+    handle->status = VEDIC_BATCH_RUNNING;
+    ASYNC_UNLOCK();
+
+    if (ASYNC_FLAG_LOAD(&handle->cancel_requested)) {
+        handle->skipped = 1;
+    } else {
+        vedic_pool_parallel_for(handle->count, batch_grain[handle->op], batch_range, handle);
+    }
+    finish_batch(handle, ASYNC_FLAG_LOAD(&handle->skipped) ? VEDIC_BATCH_CANCELLED : VEDIC_BATCH_DONE);
+}
+
+static void run_posted(VedicPoolTask *task) {
+    run_batch((VedicBatchHandle *)task);
+}
+
+VedicBatchHandle *vedic_submit_batch(VedicBatchOp op, const void *const *inputs, void *outputs,
+                                     size_t count, VedicBatchCallback callback, void *user_data) {
+    if ((int)op < 0 || op >= VEDIC_BATCH_OP_COUNT || !inputs || !outputs) return NULL;
+    for (int i = 0; i < batch_operands[op]; i++) {
+        if (!inputs[i]) return NULL;
+    }
+
+    ASYNC_LOCK();
+    if (async_stats.in_flight >= async_limit) {
+        async_stats.rejected++;
+        ASYNC_UNLOCK();
+        return NULL;
+    }
+    async_stats.in_flight++;
+    async_stats.submitted++;
+    if (async_stats.in_flight > async_stats.high_water) {
+        async_stats.high_water = async_stats.in_flight;
+    }
+    ASYNC_UNLOCK();
+
+    VEDIC_ALLOC_SCOPE_BEGIN("vedic_submit_batch");
+    VedicBatchHandle *handle = (VedicBatchHandle *)VEDIC_MALLOC(sizeof(VedicBatchHandle));
+    VEDIC_ALLOC_SCOPE_END();
+    if (!handle) {
+        ASYNC_LOCK();
+        async_stats.in_flight--;
+        async_stats.submitted--;
+        ASYNC_UNLOCK();
+        return NULL;
+    }
+
+    handle->task.run = run_posted;
+    handle->task.next = NULL;
+    handle->op = op;
+    handle->first = inputs[0];
+    handle->second = batch_operands[op] > 1 ? inputs[1] : NULL;
+    handle->outputs = outputs;
+    handle->count = count;
+    handle->callback = callback;
+    handle->user_data = user_data;
+    handle->status = VEDIC_BATCH_QUEUED;
+    handle->cancel_requested = 0;
+    handle->skipped = 0;
+    handle->references = 2;
+
+    if (vedic_pool_post(&handle->task) != 0) {
+        run_batch(handle);           // No workers: run before returning
+    }
+    return handle;
+}
+
+VedicBatchStatus vedic_batch_poll(const VedicBatchHandle *handle) {
+    ASYNC_LOCK();
+    VedicBatchStatus status = handle->status;
+    ASYNC_UNLOCK();
+    return status;
+}
+
+VedicBatchStatus vedic_batch_wait(VedicBatchHandle *handle) {
+    // Run it here rather than wait for a worker to get to it
+    if (vedic_batch_poll(handle) == VEDIC_BATCH_QUEUED && vedic_pool_unpost(&handle->task)) {
+        run_batch(handle);
+    }
+
+    ASYNC_LOCK();
+    while (handle->status == VEDIC_BATCH_QUEUED || handle->status == VEDIC_BATCH_RUNNING) {
+        ASYNC_WAIT();
+    }
+    VedicBatchStatus status = handle->status;
+    ASYNC_UNLOCK();
+    return status;
+}
+
+int vedic_batch_cancel(VedicBatchHandle *handle) {
+    ASYNC_LOCK();
+    VedicBatchStatus status = handle->status;
+    if (status == VEDIC_BATCH_DONE || status == VEDIC_BATCH_CANCELLED) {
+        ASYNC_UNLOCK();
+        return -1;
+    }
+    ASYNC_FLAG_SET(&handle->cancel_requested);
+    ASYNC_UNLOCK();
+
+    if (status == VEDIC_BATCH_QUEUED && vedic_pool_unpost(&handle->task)) {
+        ASYNC_LOCK();
+        handle->status = VEDIC_BATCH_RUNNING;
+        ASYNC_UNLOCK();
+        finish_batch(handle, VEDIC_BATCH_CANCELLED);
+    }
+    return 0;
+}
+
+void vedic_batch_release(VedicBatchHandle *handle) {
+    if (handle) drop_reference(handle);
+}
+
+void vedic_async_set_limit(size_t limit) {
+    ASYNC_LOCK();
+    async_limit = limit > 0 ? limit : VEDIC_ASYNC_DEFAULT_LIMIT;
+    ASYNC_UNLOCK();
+}
+
+VedicAsyncStats vedic_async_get_stats(void) {
+    ASYNC_LOCK();
+    VedicAsyncStats stats = async_stats;
+    ASYNC_UNLOCK();
+    return stats;
+}
+
+void vedic_async_reset_stats(void) {
+    ASYNC_LOCK();
+    size_t in_flight = async_stats.in_flight;
+    VedicAsyncStats cleared = {0, 0, 0, 0, in_flight, in_flight};
+    async_stats = cleared;
+    ASYNC_UNLOCK();
+}
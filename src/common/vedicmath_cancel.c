@@ -0,0 +1,70 @@
+/**
+ * vedicmath_cancel.c - Cooperative cancellation and deadlines
+ */
+#include "vedicmath_cancel.h"
+#include <stddef.h>
+
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+#include <windows.h>
+#define CANCEL_LOAD(ptr) (MemoryBarrier(), *(volatile const int *)(ptr))
+#define CANCEL_CAS(ptr, desired) \
+    (InterlockedCompareExchange((volatile LONG *)(ptr), (LONG)(desired), 0) == 0)
+#define CANCEL_ADD(ptr, value) InterlockedExchangeAdd64((volatile LONG64 *)(ptr), (LONG64)(value))
+#define CANCEL_PROGRESS(ptr) (*(volatile const uint64_t *)(ptr))
+#elif defined(__GNUC__) || defined(__clang__)
+#include <time.h>
+#define CANCEL_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_RELAXED)
+#define CANCEL_CAS(ptr, desired) __extension__ ({ \
+    int expected_ = VEDIC_CANCEL_NONE; \
+    __atomic_compare_exchange_n(ptr, &expected_, desired, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED); })
+#define CANCEL_ADD(ptr, value) __atomic_fetch_add(ptr, value, __ATOMIC_RELAXED)
+#define CANCEL_PROGRESS(ptr) __atomic_load_n(ptr, __ATOMIC_RELAXED)
+#else
+#include <time.h>
+#define CANCEL_LOAD(ptr) (*(volatile const int *)(ptr))
+#define CANCEL_CAS(ptr, desired) (*(volatile int *)(ptr) == VEDIC_CANCEL_NONE ? (*(volatile int *)(ptr) = (desired), 1) : 0)
+#define CANCEL_ADD(ptr, value) (*(volatile uint64_t *)(ptr) += (value))
+#define CANCEL_PROGRESS(ptr) (*(volatile const uint64_t *)(ptr))
+#endif
+
+static uint64_t cancel_now_ns(void) {
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+#endif
+}
+
+void vedic_cancel_init(VedicCancelToken *token, uint64_t timeout_ms) {
+    token->reason = VEDIC_CANCEL_NONE;
+    token->completed = 0;
+    token->deadline_ns = timeout_ms ? cancel_now_ns() + timeout_ms * 1000000ull : 0;
+}
+
+void vedic_cancel(VedicCancelToken *token) {
+    if (token) CANCEL_CAS(&token->reason, VEDIC_CANCEL_REQUESTED);
+}
+
+VedicCancelReason vedic_cancel_check(VedicCancelToken *token) {
+    if (!token) return VEDIC_CANCEL_NONE;
+    int reason = CANCEL_LOAD(&token->reason);
+    if (reason != VEDIC_CANCEL_NONE) return (VedicCancelReason)reason;
+    if (token->deadline_ns == 0 || cancel_now_ns() < token->deadline_ns) return VEDIC_CANCEL_NONE;
+
+    // First to see the deadline latches it, unless a cancel got there first
+    CANCEL_CAS(&token->reason, VEDIC_CANCEL_DEADLINE);
+    return (VedicCancelReason)CANCEL_LOAD(&token->reason);
+}
+
+uint64_t vedic_cancel_progress(const VedicCancelToken *token) {
+    return token ? CANCEL_PROGRESS(&token->completed) : 0;
+}
+
+void vedic_cancel_add_progress(VedicCancelToken *token, uint64_t amount) {
+    if (token && amount) CANCEL_ADD(&token->completed, amount);
+}
@@ -6,38 +6,23 @@
  */
 
  #include "vedicmath.h"
+ #include "vedicmath_alloc.h"
+ #include "vedicmath_metrics.h"
+ #include "vedicmath_pool.h"
  #include <stdlib.h>  // For abs function
  
  /**
-  * Vedic multiply - Central dispatcher function
-  * 
-  * Automatically selects the most efficient Vedic method based on input characteristics.
-  * 
-  * @param a First number to multiply
-  * @param b Second number to multiply
-  * @return The product a * b
+  * Select the multiplication method for non-negative operands
+  *
+  * Shared by vedic_multiply, vedic_multiply_method and vedic_multiply_batch
+  * so that the per-element and batched paths always agree.
   */
- long vedic_multiply(long a, long b) {
+ static inline VedicMultiplyMethod classify_multiply(long a, long b) {
      // Handle trivial cases first (Vilokanam observation)
-     if (a == 0 || b == 0) return 0;
-     if (a == 1) return b;
-     if (b == 1) return a;
-     
-     // Handle negative numbers
-     int sign = 1;
-     if (a < 0) {
-         a = -a;
-         sign = -sign;
-     }
-     if (b < 0) {
-         b = -b;
-         sign = -sign;
-     }
+     if (a == 0 || b == 0 || a == 1 || b == 1) return VEDIC_MUL_DIRECT;
      
      // For very small numbers, just use direct multiplication
-     if (a < 10 && b < 10) {
-         return sign * (a * b);
-     }
+     if (a < 10 && b < 10) return VEDIC_MUL_DIRECT;
      
      // Get digit counts for both numbers
      int digits_a = count_digits(a);
@@ -50,24 +35,24 @@
      // Check if a number ends in 5
      if ((a % 10 == 5) && (b % 10 == 5) && (a == b)) {
          // Same number ending in 5, use Ekadhikena Purvena for squaring
-         return sign * ekadhikena_purvena(a);
+         return VEDIC_MUL_EKADHIKENA;
      }
      
      // Check if last digits sum to 10 and the prefixes are the same
      if (last_digits_sum_to_10(a, b) && same_prefix(a, b)) {
-         return sign * antya_dasake_mul(a, b);
+         return VEDIC_MUL_ANTYAYORDASAKE;
      }
      
      // Check if one or both numbers are close to a power of 10
      if (is_close_to_base(a, base_a) && is_close_to_base(b, base_b)) {
          // Both numbers are close to powers of 10, use Nikhilam
-         return sign * nikhilam_mul(a, b);
+         return VEDIC_MUL_NIKHILAM;
      } else if (is_close_to_base(a, base_a) || is_close_to_base(b, base_b)) {
          // One number is close to a power of 10
          
          // If close to the same base, use Nikhilam
          if (base_a == base_b) {
-             return sign * nikhilam_mul(a, b);
+             return VEDIC_MUL_NIKHILAM;
          }
          
          // Otherwise, decision depends on how close they are
@@ -77,74 +62,406 @@
          if ((ratio_a >= 0.95 && ratio_a <= 1.05) || 
              (ratio_b >= 0.95 && ratio_b <= 1.05)) {
              // Very close to a base, use Nikhilam
-             return sign * nikhilam_mul(a, b);
+             return VEDIC_MUL_NIKHILAM;
          }
      }
      
      // For numbers with many digits, Urdhva-Tiryagbhyam is generally efficient
      if (digits_a > 2 || digits_b > 2) {
-         #ifdef _OPENMP
-         // Use parallel version for large numbers if OpenMP is available
-         if (digits_a > 3 && digits_b > 3) {
-             return sign * urdhva_mult_parallel(a, b);
-         }
-         #endif
-         return sign * urdhva_mult(a, b);
+         return VEDIC_MUL_URDHVA;
      }
      
      // Default to standard multiplication for small numbers or when no special pattern applies
-     return sign * (a * b);
+     return VEDIC_MUL_DIRECT;
  }
  
  /**
-  * Vedic square - Central dispatcher function for squaring
+  * Run one method on non-negative operands
+  */
+ static inline long apply_multiply(VedicMultiplyMethod method, long a, long b) {
+     switch (method) {
+         case VEDIC_MUL_EKADHIKENA:
+             return ekadhikena_purvena(a);
+         case VEDIC_MUL_ANTYAYORDASAKE:
+             return antya_dasake_mul(a, b);
+         case VEDIC_MUL_NIKHILAM:
+             return nikhilam_mul(a, b);
+         case VEDIC_MUL_URDHVA:
+             #ifdef _OPENMP
+             // Use parallel version for large numbers if OpenMP is available
+             if (count_digits(a) > 3 && count_digits(b) > 3) {
+                 return urdhva_mult_parallel(a, b);
+             }
+             #endif
+             return urdhva_mult(a, b);
+         default:
+             return a * b;
+     }
+ }
+ 
+ /**
+  * Vedic multiply - Central dispatcher function
   * 
-  * Chooses the best method to square a number based on its characteristics.
+  * Automatically selects the most efficient Vedic method based on input characteristics.
   * 
-  * @param n Number to square
-  * @return The square of n
+  * @param a First number to multiply
+  * @param b Second number to multiply
+  * @return The product a * b
   */
- long vedic_square(long n) {
-     // Handle trivial cases
-     if (n == 0 || n == 1) return n;
+ long vedic_multiply(long a, long b) {
+     // Handle negative numbers
+     int sign = 1;
+     if (a < 0) {
+         a = -a;
+         sign = -sign;
+     }
+     if (b < 0) {
+         b = -b;
+         sign = -sign;
+     }
      
-     // Handle negative numbers (square is always positive)
-     if (n < 0) n = -n;
+     VEDIC_ALLOC_SCOPE_BEGIN("vedic_multiply");
+     long product = sign * apply_multiply(classify_multiply(a, b), a, b);
+     VEDIC_ALLOC_SCOPE_END();
+     return product;
+ }
+ 
+ /**
+  * Method vedic_multiply would use for a pair of operands
+  */
+ VedicMultiplyMethod vedic_multiply_method(long a, long b) {
+     return classify_multiply(a < 0 ? -a : a, b < 0 ? -b : b);
+ }
+ 
+ /**
+  * Name of a multiplication method
+  */
+ const char *vedic_multiply_method_name(VedicMultiplyMethod method) {
+     switch (method) {
+         case VEDIC_MUL_DIRECT: return "Direct";
+         case VEDIC_MUL_EKADHIKENA: return "Ekadhikena Purvena";
+         case VEDIC_MUL_ANTYAYORDASAKE: return "Antyayordasake";
+         case VEDIC_MUL_NIKHILAM: return "Nikhilam";
+         case VEDIC_MUL_URDHVA: return "Urdhva-Tiryagbhyam";
+         default: return "Unknown";
+     }
+ }
+ 
+ // Pairs classified per pass of vedic_multiply_batch; small enough for the
+ // index lists to stay in L1
+ #define VEDIC_BATCH_CHUNK 256
+ 
+ // Elements per range handed to the thread pool: the whole batch costs a
+ // few nanoseconds per pair, so ranges must be large to pay for a steal
+ #define VEDIC_BATCH_GRAIN 4096
+ 
+ // Pairs between cancellation checks (a multiple of VEDIC_BATCH_CHUNK)
+ #define VEDIC_BATCH_CHECK 4096
+ 
+ // Nikhilam bases a long can hold: 10^0 .. 10^18
+ #define VEDIC_NIKHILAM_BASES 19
+ 
+ typedef struct {
+     long *results;
+     const long *a;
+     const long *b;
+     VedicCancelToken *token;       // NULL: no checks
+     VedicCancelToken done;         // Local tally of the pairs computed
+ } MultiplyBatch;
+ 
+ /**
+  * Copy the magnitudes of one method's operands into contiguous lanes
+  */
+ static void gather_magnitudes(int64_t *lanes, const unsigned short *group, size_t size, const long *x) {
+     for (size_t k = 0; k < size; k++) {
+         long value = x[group[k]];
+         lanes[k] = value < 0 ? -(int64_t)value : value;
+     }
+ }
+ 
+ /**
+  * Write lane results back to their pairs with the sign of a * b restored
+  */
+ static void scatter_signed(long *results, const unsigned short *group, size_t size, const int64_t *lanes,
+                            const long *a, const long *b) {
+     for (size_t k = 0; k < size; k++) {
+         size_t i = group[k];
+         long product = (long)lanes[k];
+         results[i] = ((a[i] < 0) != (b[i] < 0)) ? -product : product;
+     }
+ }
+ 
+ /**
+  * Run a chunk's Nikhilam pairs bucketed by working base
+  *
+  * A counting sort on the base's exponent puts pairs with the same base
+  * next to each other, so each bucket is one nikhilam_mul_batch call with
+  * a single B.
+  */
+ static void nikhilam_batch_group(long *results, const unsigned short *group, size_t size,
+                                  const long *a, const long *b, int64_t *lanes_a, int64_t *lanes_b) {
+     unsigned char exponents[VEDIC_BATCH_CHUNK];
+     unsigned short order[VEDIC_BATCH_CHUNK];
+     size_t start[VEDIC_NIKHILAM_BASES + 1] = {0};
+     long bases[VEDIC_NIKHILAM_BASES];
+     
+     for (size_t k = 0; k < size; k++) {
+         size_t i = group[k];
+         long base = nikhilam_best_base(a[i] < 0 ? -a[i] : a[i], b[i] < 0 ? -b[i] : b[i]);
+         int exponent = count_digits(base) - 1;
+         exponents[k] = (unsigned char)exponent;
+         bases[exponent] = base;
+         start[exponent + 1]++;
+     }
+     for (int e = 0; e < VEDIC_NIKHILAM_BASES; e++) start[e + 1] += start[e];
+     
+     size_t fill[VEDIC_NIKHILAM_BASES];
+     for (int e = 0; e < VEDIC_NIKHILAM_BASES; e++) fill[e] = start[e];
+     for (size_t k = 0; k < size; k++) order[fill[exponents[k]]++] = group[k];
+     
+     for (int e = 0; e < VEDIC_NIKHILAM_BASES; e++) {
+         size_t bucket = start[e + 1] - start[e];
+         if (bucket == 0) continue;
+         gather_magnitudes(lanes_a, order + start[e], bucket, a);
+         gather_magnitudes(lanes_b, order + start[e], bucket, b);
+         nikhilam_mul_batch(lanes_a, lanes_b, bases[e], lanes_a, bucket);
+         scatter_signed(results, order + start[e], bucket, lanes_a, a, b);
+     }
+ }
+ 
+ /**
+  * Pattern-partitioned dispatch of pairs [begin, end)
+  */
+ static void multiply_batch_range(size_t begin, size_t end, void *context) {
+     MultiplyBatch *batch = (MultiplyBatch *)context;
+     unsigned short groups[VEDIC_MUL_METHOD_COUNT][VEDIC_BATCH_CHUNK];
+     size_t group_size[VEDIC_MUL_METHOD_COUNT];
+     uint64_t method_totals[VEDIC_MUL_METHOD_COUNT] = {0};
+     int64_t lanes_a[VEDIC_BATCH_CHUNK], lanes_b[VEDIC_BATCH_CHUNK];
+     VEDIC_ALLOC_SCOPE_BEGIN("vedic_multiply_batch");
+     
+     size_t base, reported = begin;
+     for (base = begin; base < end; base += VEDIC_BATCH_CHUNK) {
+         // Every VEDIC_BATCH_CHECK pairs: count what is done, then see whether to go on
+         if (batch->token && (base - begin) % VEDIC_BATCH_CHECK == 0) {
+             vedic_cancel_add_progress(batch->token, base - reported);
+             reported = base;
+             if (vedic_cancel_check(batch->token) != VEDIC_CANCEL_NONE) break;
+         }
+         size_t chunk = end - base < VEDIC_BATCH_CHUNK ? end - base : VEDIC_BATCH_CHUNK;
+         const long *ca = batch->a + base;
+         const long *cb = batch->b + base;
+         long *cr = batch->results + base;
+         
+         // Pass 1: classify the chunk into per-method index lists
+         for (int m = 0; m < VEDIC_MUL_METHOD_COUNT; m++) group_size[m] = 0;
+         for (size_t i = 0; i < chunk; i++) {
+             long ua = ca[i] < 0 ? -ca[i] : ca[i];
+             long ub = cb[i] < 0 ? -cb[i] : cb[i];
+             VedicMultiplyMethod m = classify_multiply(ua, ub);
+             groups[m][group_size[m]++] = (unsigned short)i;
+         }
+         for (int m = 0; m < VEDIC_MUL_METHOD_COUNT; m++) method_totals[m] += group_size[m];
+         
+         // Pass 2: direct products need no sign handling
+         for (size_t k = 0; k < group_size[VEDIC_MUL_DIRECT]; k++) {
+             size_t i = groups[VEDIC_MUL_DIRECT][k];
+             cr[i] = ca[i] * cb[i];
+         }
+         
+         // Pass 3: branch-free sutra kernels over gathered magnitudes (Nikhilam per base)
+         size_t size = group_size[VEDIC_MUL_EKADHIKENA];
+         gather_magnitudes(lanes_a, groups[VEDIC_MUL_EKADHIKENA], size, ca);
+         ekadhikena_purvena_batch(lanes_a, lanes_a, size);
+         scatter_signed(cr, groups[VEDIC_MUL_EKADHIKENA], size, lanes_a, ca, cb);
+         
+         size = group_size[VEDIC_MUL_ANTYAYORDASAKE];
+         gather_magnitudes(lanes_a, groups[VEDIC_MUL_ANTYAYORDASAKE], size, ca);
+         gather_magnitudes(lanes_b, groups[VEDIC_MUL_ANTYAYORDASAKE], size, cb);
+         antya_dasake_mul_batch(lanes_a, lanes_b, lanes_a, size);
+         scatter_signed(cr, groups[VEDIC_MUL_ANTYAYORDASAKE], size, lanes_a, ca, cb);
+         
+         nikhilam_batch_group(cr, groups[VEDIC_MUL_NIKHILAM], group_size[VEDIC_MUL_NIKHILAM], ca, cb,
+                              lanes_a, lanes_b);
+         
+         // Pass 4: Urdhva-Tiryagbhyam pair by pair, on magnitudes with the sign restored
+         for (size_t k = 0; k < group_size[VEDIC_MUL_URDHVA]; k++) {
+             size_t i = groups[VEDIC_MUL_URDHVA][k];
+             long ua = ca[i] < 0 ? -ca[i] : ca[i];
+             long ub = cb[i] < 0 ? -cb[i] : cb[i];
+             long product = apply_multiply(VEDIC_MUL_URDHVA, ua, ub);
+             cr[i] = ((ca[i] < 0) != (cb[i] < 0)) ? -product : product;
+         }
+     }
      
+     // One atomic add per method and range keeps the counters off the hot loop
+     for (int m = 0; m < VEDIC_MUL_METHOD_COUNT; m++) {
+         if (method_totals[m]) vedic_metrics_add((VedicMetric)(VEDIC_METRIC_BATCH_DIRECT + m), method_totals[m]);
+     }
+     if (batch->token) {
+         size_t stop = base < end ? base : end;
+         vedic_cancel_add_progress(batch->token, stop - reported);
+         vedic_cancel_add_progress(&batch->done, stop - begin);
+     }
+     VEDIC_ALLOC_SCOPE_END();
+ }
+ 
+ /**
+  * Batch Vedic multiply - pattern-partitioned dispatch on the thread pool
+  */
+ void vedic_multiply_batch(long *results, const long *a, const long *b, size_t count) {
+     MultiplyBatch batch = {results, a, b, NULL, {0, 0, 0}};
+     vedic_pool_parallel_for(count, VEDIC_BATCH_GRAIN, multiply_batch_range, &batch);
+ }
+ 
+ /**
+  * Batch Vedic multiply that checks a cancellation token between chunks
+  */
+ VedicCancelReason vedic_multiply_batch_cancellable(long *results, const long *a, const long *b, size_t count,
+                                                    VedicCancelToken *token) {
+     MultiplyBatch batch = {results, a, b, token, {0, 0, 0}};
+     vedic_pool_parallel_for(count, VEDIC_BATCH_GRAIN, multiply_batch_range, &batch);
+     if (!token || vedic_cancel_progress(&batch.done) == count) return VEDIC_CANCEL_NONE;
+     return vedic_cancel_check(token);
+ }
+ 
+ /**
+  * Squaring methods, in the order square_dispatch tries them
+  */
+ typedef enum {
+     SQUARE_DIRECT = 0,             // Single digits
+     SQUARE_EKADHIKENA,             // Ending in 5
+     SQUARE_YAAVADUNAM,             // Within 10% of a power of 10
+     SQUARE_DWANDWA,                // Everything else
+     SQUARE_METHOD_COUNT
+ } SquareMethod;
+ 
+ /**
+  * Select the squaring method for a magnitude
+  *
+  * Shared by vedic_square and vedic_square_batch so that both paths agree.
+  *
+  * @param base Set to the power of 10 for SQUARE_YAAVADUNAM
+  */
+ static inline SquareMethod classify_square(long n, long *base) {
      // For very small numbers, just square directly
-     if (n < 10) return n * n;
+     if (n < 10) return SQUARE_DIRECT;
      
      // If number ends in 5, use Ekadhikena Purvena
-     if (n % 10 == 5) {
-         return ekadhikena_purvena(n);
+     if (n % 10 == 5) return SQUARE_EKADHIKENA;
+     
+     // If number is close to a power of 10, use Yaavadunam
+     *base = nearest_power_of_10(n);
+     if (is_close_to_base(n, *base)) {
+         double ratio = (double)n / *base;
+         if (ratio >= 0.9 && ratio <= 1.1) return SQUARE_YAAVADUNAM;
      }
      
-     // Find the nearest power of 10 base
-     long base = nearest_power_of_10(n);
+     // Default to the duplex method, half the products of a general multiply
+     return SQUARE_DWANDWA;
+ }
+ 
+ /**
+  * Select and run the squaring method (see vedic_square)
+  */
+ static long square_dispatch(long n) {
+     // Handle negative numbers (square is always positive)
+     if (n < 0) n = -n;
      
-     // If number is close to a power of 10, use Yaavadunam
-     if (is_close_to_base(n, base)) {
-         double ratio = (double)n / base;
-         if (ratio >= 0.9 && ratio <= 1.1) {
+     long base = 0;
+     switch (classify_square(n, &base)) {
+         case SQUARE_EKADHIKENA:
+             return ekadhikena_purvena(n);
+         case SQUARE_YAAVADUNAM:
              return yaavadunam_square(n, base);
-         }
+         case SQUARE_DWANDWA:
+             return dwandwa_square(n);
+         default:
+             return n * n;
      }
+ }
+ 
+ typedef struct {
+     long *results;
+     const long *n;
+ } SquareBatch;
+ 
+ /**
+  * Pattern-partitioned squaring of [begin, end)
+  */
+ static void square_batch_range(size_t begin, size_t end, void *context) {
+     SquareBatch *batch = (SquareBatch *)context;
+     unsigned short groups[SQUARE_METHOD_COUNT][VEDIC_BATCH_CHUNK];
+     size_t group_size[SQUARE_METHOD_COUNT];
+     int64_t lanes[VEDIC_BATCH_CHUNK], bases[VEDIC_BATCH_CHUNK];
+     long chunk_bases[VEDIC_BATCH_CHUNK];
+     VEDIC_ALLOC_SCOPE_BEGIN("vedic_square_batch");
      
-     // Default to multiplication
-     return vedic_multiply(n, n);
+     for (size_t base = begin; base < end; base += VEDIC_BATCH_CHUNK) {
+         size_t chunk = end - base < VEDIC_BATCH_CHUNK ? end - base : VEDIC_BATCH_CHUNK;
+         const long *cn = batch->n + base;
+         long *cr = batch->results + base;
+         
+         // Pass 1: classify the chunk into per-method index lists
+         for (int m = 0; m < SQUARE_METHOD_COUNT; m++) group_size[m] = 0;
+         for (size_t i = 0; i < chunk; i++) {
+             long magnitude = cn[i] < 0 ? -cn[i] : cn[i];
+             SquareMethod m = classify_square(magnitude, &chunk_bases[i]);
+             groups[m][group_size[m]++] = (unsigned short)i;
+         }
+         
+         // Pass 2: branch-free kernels over gathered magnitudes (squares need no sign)
+         size_t size = group_size[SQUARE_EKADHIKENA];
+         gather_magnitudes(lanes, groups[SQUARE_EKADHIKENA], size, cn);
+         ekadhikena_purvena_batch(lanes, lanes, size);
+         for (size_t k = 0; k < size; k++) cr[groups[SQUARE_EKADHIKENA][k]] = (long)lanes[k];
+         
+         size = group_size[SQUARE_YAAVADUNAM];
+         gather_magnitudes(lanes, groups[SQUARE_YAAVADUNAM], size, cn);
+         for (size_t k = 0; k < size; k++) bases[k] = chunk_bases[groups[SQUARE_YAAVADUNAM][k]];
+         yaavadunam_square_batch(lanes, bases, lanes, size);
+         for (size_t k = 0; k < size; k++) cr[groups[SQUARE_YAAVADUNAM][k]] = (long)lanes[k];
+         
+         // Pass 3: the rest element by element
+         for (size_t k = 0; k < group_size[SQUARE_DIRECT]; k++) {
+             size_t i = groups[SQUARE_DIRECT][k];
+             cr[i] = cn[i] * cn[i];
+         }
+         for (size_t k = 0; k < group_size[SQUARE_DWANDWA]; k++) {
+             size_t i = groups[SQUARE_DWANDWA][k];
+             cr[i] = dwandwa_square(cn[i]);
+         }
+     }
+     VEDIC_ALLOC_SCOPE_END();
  }
  
  /**
-  * Vedic divide - Central dispatcher function for division
+  * Batch Vedic square - pattern-partitioned dispatch on the thread pool
+  */
+ void vedic_square_batch(long *results, const long *n, size_t count) {
+     SquareBatch batch = {results, n};
+     vedic_pool_parallel_for(count, VEDIC_BATCH_GRAIN, square_batch_range, &batch);
+ }
+ 
+ /**
+  * Vedic square - Central dispatcher function for squaring
   * 
-  * Automatically selects the most efficient Vedic method for division.
+  * Chooses the best method to square a number based on its characteristics.
   * 
-  * @param dividend Number to be divided
-  * @param divisor Number to divide by
-  * @param remainder Pointer to store remainder (can be NULL if not needed)
-  * @return The quotient
+  * @param n Number to square
+  * @return The square of n
   */
- long vedic_divide(long dividend, long divisor, long *remainder) {
+ long vedic_square(long n) {
+     VEDIC_ALLOC_SCOPE_BEGIN("vedic_square");
+     long square = square_dispatch(n);
+     VEDIC_ALLOC_SCOPE_END();
+     return square;
+ }
+ 
+ /**
+  * Select and run the division method (see vedic_divide)
+  */
+ static long divide_dispatch(long dividend, long divisor, long *remainder) {
      // Handle trivial cases
      if (divisor == 0) {
          // Division by zero
@@ -181,6 +498,23 @@
      return quot;
  }
 
+ /**
+  * Vedic divide - Central dispatcher function for division
+  * 
+  * Automatically selects the most efficient Vedic method for division.
+  * 
+  * @param dividend Number to be divided
+  * @param divisor Number to divide by
+  * @param remainder Pointer to store remainder (can be NULL if not needed)
+  * @return The quotient
+  */
+ long vedic_divide(long dividend, long divisor, long *remainder) {
+     VEDIC_ALLOC_SCOPE_BEGIN("vedic_divide");
+     long quotient = divide_dispatch(dividend, divisor, remainder);
+     VEDIC_ALLOC_SCOPE_END();
+     return quotient;
+ }
+
  /**
  * DISPATCHER DEBUG: Add logging to see what's actually happening
  * 
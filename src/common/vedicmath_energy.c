@@ -0,0 +1,210 @@
+/**
+ * vedicmath_energy.c - Energy measurement from RAPL counters
+ */
+#include "vedicmath_energy.h"
+#include <stdio.h>
+#include <string.h>
+
+#define ENERGY_DEFAULT_ROOT "/sys/class/powercap"
+#define ENERGY_ZONE_PREFIX "intel-rapl:"
+
+static char status[160] = "not initialized";
+static int initialized = 0;
+static int zone_count = 0;
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * One readable RAPL zone
+ */
+typedef struct {
+    VedicEnergyDomain domain;
+    int fd;                          // energy_uj, kept open for cheap reads
+    uint64_t max_range_uj;           // Counter wraps past this (0 = unknown)
+} EnergyZone;
+
+static EnergyZone zones[VEDIC_ENERGY_MAX_ZONES];
+static const char *const domain_names[VEDIC_ENERGY_DOMAIN_COUNT] = {"package", "core", "dram"};
+
+static int read_text(const char *path, char *buffer, size_t size) {
+    FILE *file = fopen(path, "r");
+    if (!file) return -1;
+    size_t length = fread(buffer, 1, size - 1, file);
+    fclose(file);
+    buffer[length] = '\0';
+    while (length > 0 && (buffer[length - 1] == '\n' || buffer[length - 1] == ' ')) {
+        buffer[--length] = '\0';
+    }
+    return 0;
+}
+
+static int read_counter(int fd, uint64_t *value) {
+    char buffer[32];
+    ssize_t length = pread(fd, buffer, sizeof(buffer) - 1, 0);
+    if (length <= 0) return -1;
+    buffer[length] = '\0';
+    char *end;
+    unsigned long long parsed = strtoull(buffer, &end, 10);
+    if (end == buffer) return -1;
+    *value = (uint64_t)parsed;
+    return 0;
+}
+
+static int zone_domain(const char *name, VedicEnergyDomain *domain) {
+    if (strncmp(name, "package", 7) == 0) {
+        *domain = VEDIC_ENERGY_PACKAGE;
+    } else if (strcmp(name, "core") == 0) {
+        *domain = VEDIC_ENERGY_CORE;
+    } else if (strcmp(name, "dram") == 0) {
+        *domain = VEDIC_ENERGY_DRAM;
+    } else {
+        return -1;                   // uncore, psys: overlap the domains above
+    }
+    return 0;
+}
+
+static void close_zones(void) {
+    for (int i = 0; i < zone_count; i++) {
+        close(zones[i].fd);
+    }
+    zone_count = 0;
+}
+
+int vedic_energy_init_at(const char *root) {
+    if (!root) root = ENERGY_DEFAULT_ROOT;
+    close_zones();
+    initialized = 1;
+
+    DIR *dir = opendir(root);
+    if (!dir) {
+        snprintf(status, sizeof(status), "no powercap directory at %s", root);
+        return 0;
+    }
+
+    int unreadable = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL && zone_count < VEDIC_ENERGY_MAX_ZONES) {
+        if (strncmp(entry->d_name, ENERGY_ZONE_PREFIX, strlen(ENERGY_ZONE_PREFIX)) != 0) continue;
+
+        char path[512], text[64];
+        VedicEnergyDomain domain;
+        snprintf(path, sizeof(path), "%s/%s/name", root, entry->d_name);
+        if (read_text(path, text, sizeof(text)) != 0 || zone_domain(text, &domain) != 0) continue;
+
+        snprintf(path, sizeof(path), "%s/%s/energy_uj", root, entry->d_name);
+        int fd = open(path, O_RDONLY);
+        uint64_t value;
+        if (fd < 0 || read_counter(fd, &value) != 0) {
+            if (fd >= 0) close(fd);
+            unreadable++;
+            continue;
+        }
+
+        EnergyZone *zone = &zones[zone_count++];
+        zone->domain = domain;
+        zone->fd = fd;
+        zone->max_range_uj = 0;
+        snprintf(path, sizeof(path), "%s/%s/max_energy_range_uj", root, entry->d_name);
+        if (read_text(path, text, sizeof(text)) == 0) {
+            zone->max_range_uj = strtoull(text, NULL, 10);
+        }
+    }
+    closedir(dir);
+
+    if (zone_count == 0) {
+        if (unreadable > 0) {
+            snprintf(status, sizeof(status), "RAPL zones under %s are not readable (root only)", root);
+        } else {
+            snprintf(status, sizeof(status), "no RAPL zones under %s", root);
+        }
+        return 0;
+    }
+
+    size_t used = (size_t)snprintf(status, sizeof(status), "RAPL:");
+    for (int d = 0; d < VEDIC_ENERGY_DOMAIN_COUNT; d++) {
+        if (vedic_energy_available((VedicEnergyDomain)d) && used < sizeof(status)) {
+            used += (size_t)snprintf(status + used, sizeof(status) - used, " %s", domain_names[d]);
+        }
+    }
+    return zone_count;
+}
+
+int vedic_energy_read(VedicEnergySample *sample) {
+    memset(sample, 0, sizeof(*sample));
+    if (zone_count == 0) return -1;
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    sample->timestamp_ns = (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+
+    for (int i = 0; i < zone_count; i++) {
+        if (read_counter(zones[i].fd, &sample->microjoules[i]) != 0) return -1;
+    }
+    return 0;
+}
+
+bool vedic_energy_available(VedicEnergyDomain domain) {
+    for (int i = 0; i < zone_count; i++) {
+        if (zones[i].domain == domain) return true;
+    }
+    return false;
+}
+
+double vedic_energy_joules(const VedicEnergySample *start, const VedicEnergySample *end,
+                           VedicEnergyDomain domain) {
+    uint64_t total = 0;
+    for (int i = 0; i < zone_count; i++) {
+        if (zones[i].domain != domain) continue;
+        uint64_t before = start->microjoules[i];
+        uint64_t after = end->microjoules[i];
+        if (after >= before) {
+            total += after - before;
+        } else if (zones[i].max_range_uj > before) {
+            total += zones[i].max_range_uj - before + after;
+        }
+    }
+    return (double)total / 1e6;
+}
+
+#else
+
+int vedic_energy_init_at(const char *root) {
+    (void)root;
+    initialized = 1;
+    snprintf(status, sizeof(status), "RAPL energy counters are only read on Linux");
+    return 0;
+}
+
+int vedic_energy_read(VedicEnergySample *sample) {
+    memset(sample, 0, sizeof(*sample));
+    return -1;
+}
+
+bool vedic_energy_available(VedicEnergyDomain domain) {
+    (void)domain;
+    return false;
+}
+
+double vedic_energy_joules(const VedicEnergySample *start, const VedicEnergySample *end,
+                           VedicEnergyDomain domain) {
+    (void)start;
+    (void)end;
+    (void)domain;
+    return 0.0;
+}
+
+#endif
+
+int vedic_energy_init(void) {
+    if (initialized) return zone_count;
+    return vedic_energy_init_at(NULL);
+}
+
+const char *vedic_energy_status(void) {
+    return status;
+}
@@ -0,0 +1,659 @@
+/**
+ * vedicmath_executor.c - Lock-free request queue and micro-batching executor
+ */
+#include "vedicmath_executor.h"
+#include "vedicmath.h"
+#include "vedicmath_alloc.h"
+#include "vedicmath_optimized.h"
+#include <string.h>
+
+#define EXEC_CACHE_LINE 64
+#define EXEC_SPIN_POLLS 2000             // Status checks before a waiter sleeps
+#define EXEC_IDLE_WAIT_MS 50             // Upper bound on an idle consumer's sleep
+
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+#include <windows.h>
+#define EXEC_HAVE_THREADS 1
+#define EXEC_CAS(ptr, expected, desired) \
+    ((uint64_t)InterlockedCompareExchange64((volatile LONG64 *)(ptr), (LONG64)(desired), (LONG64)(expected)) == (expected))
+#define EXEC_ADD(ptr, value) InterlockedExchangeAdd64((volatile LONG64 *)(ptr), (LONG64)(value))
+#define EXEC_LOAD(ptr) (*(volatile const uint64_t *)(ptr))
+#define EXEC_LOAD_ACQUIRE(ptr) (*(volatile const uint64_t *)(ptr))
+#define EXEC_STORE_RELEASE(ptr, value) (MemoryBarrier(), *(volatile uint64_t *)(ptr) = (value))
+#define EXEC_INT_LOAD(ptr) (MemoryBarrier(), *(volatile const int *)(ptr))
+#define EXEC_INT_STORE(ptr, value) (MemoryBarrier(), *(volatile int *)(ptr) = (value))
+#define EXEC_FENCE() MemoryBarrier()
+#define EXEC_YIELD() SwitchToThread()
+typedef SRWLOCK ExecLock;
+typedef CONDITION_VARIABLE ExecCondition;
+#define EXEC_LOCK_INIT(lock) InitializeSRWLock(lock)
+#define EXEC_CONDITION_INIT(condition) InitializeConditionVariable(condition)
+#define EXEC_LOCK(lock) AcquireSRWLockExclusive(lock)
+#define EXEC_UNLOCK(lock) ReleaseSRWLockExclusive(lock)
+#define EXEC_BROADCAST(condition) WakeAllConditionVariable(condition)
+#define EXEC_LOCK_DESTROY(lock) ((void)0)
+#define EXEC_CONDITION_DESTROY(condition) ((void)0)
+#elif defined(__GNUC__) || defined(__clang__)
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#define EXEC_HAVE_THREADS 1
+#define EXEC_CAS(ptr, expected, desired) \
+    __atomic_compare_exchange_n(ptr, &(expected), desired, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#define EXEC_ADD(ptr, value) __atomic_fetch_add(ptr, value, __ATOMIC_RELAXED)
+#define EXEC_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_RELAXED)
+#define EXEC_LOAD_ACQUIRE(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define EXEC_STORE_RELEASE(ptr, value) __atomic_store_n(ptr, value, __ATOMIC_RELEASE)
+#define EXEC_INT_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_SEQ_CST)
+#define EXEC_INT_STORE(ptr, value) __atomic_store_n(ptr, value, __ATOMIC_SEQ_CST)
+#define EXEC_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define EXEC_YIELD() sched_yield()
+typedef pthread_mutex_t ExecLock;
+typedef pthread_cond_t ExecCondition;
+#define EXEC_LOCK_INIT(lock) pthread_mutex_init(lock, NULL)
+#define EXEC_CONDITION_INIT(condition) pthread_cond_init(condition, NULL)
+#define EXEC_LOCK(lock) pthread_mutex_lock(lock)
+#define EXEC_UNLOCK(lock) pthread_mutex_unlock(lock)
+#define EXEC_BROADCAST(condition) pthread_cond_broadcast(condition)
+#define EXEC_LOCK_DESTROY(lock) pthread_mutex_destroy(lock)
+#define EXEC_CONDITION_DESTROY(condition) pthread_cond_destroy(condition)
+#else
+#define EXEC_HAVE_THREADS 0
+#endif
+
+#if EXEC_HAVE_THREADS
+
+// ============================================================================
+// MPMC QUEUE
+// ============================================================================
+
+/*
+ * Bounded queue after Vyukov: slot i starts with sequence i. A producer at
+ * position p may fill the slot when its sequence equals p and publishes it
+ * as p + 1; a consumer at position p may take it when the sequence is
+ * p + 1 and frees it for the next lap as p + capacity.
+ */
+typedef struct {
+    uint64_t sequence;
+    void *item;
+} QueueSlot;
+
+struct VedicMpmcQueue {
+    uint64_t tail;                   // Next position to push
+    char pad_tail[EXEC_CACHE_LINE - sizeof(uint64_t)];
+    uint64_t head;                   // Next position to pop
+    char pad_head[EXEC_CACHE_LINE - sizeof(uint64_t)];
+    uint64_t mask;
+    QueueSlot *slots;
+};
+
+VedicMpmcQueue *vedic_mpmc_create(size_t capacity) {
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        if (rounded > ((size_t)-1 >> 2) / sizeof(QueueSlot)) return NULL;
+        rounded <<= 1;
+    }
+
+    VEDIC_ALLOC_SCOPE_BEGIN("vedic_mpmc_create");
+    VedicMpmcQueue *queue = (VedicMpmcQueue *)VEDIC_MALLOC(sizeof(VedicMpmcQueue));
+    QueueSlot *slots = (QueueSlot *)VEDIC_MALLOC(rounded * sizeof(QueueSlot));
+    VEDIC_ALLOC_SCOPE_END();
+    if (!queue || !slots) {
+        VEDIC_FREE(queue);
+        VEDIC_FREE(slots);
+        return NULL;
+    }
+
+    memset(queue, 0, sizeof(*queue));
+    queue->mask = rounded - 1;
+    queue->slots = slots;
+    for (size_t i = 0; i < rounded; i++) {
+        slots[i].sequence = i;
+        slots[i].item = NULL;
+    }
+    return queue;
+}
+
+void vedic_mpmc_destroy(VedicMpmcQueue *queue) {
+    if (!queue) return;
+    VEDIC_FREE(queue->slots);
+    VEDIC_FREE(queue);
+}
+
+int vedic_mpmc_push(VedicMpmcQueue *queue, void *item) {
+    uint64_t position = EXEC_LOAD(&queue->tail);
+    for (;;) {
+        QueueSlot *slot = &queue->slots[position & queue->mask];
+        int64_t lag = (int64_t)(EXEC_LOAD_ACQUIRE(&slot->sequence) - position);
+        if (lag == 0) {
+            if (EXEC_CAS(&queue->tail, position, position + 1)) {
+                slot->item = item;
+                EXEC_STORE_RELEASE(&slot->sequence, position + 1);
+                return 0;
+            }
+            position = EXEC_LOAD(&queue->tail);   // Another producer took it
+        } else if (lag < 0) {
+            return -1;               // Slot still holds an item from the last lap: full
+        } else {
+            position = EXEC_LOAD(&queue->tail);
+        }
+    }
+}
+
+int vedic_mpmc_pop(VedicMpmcQueue *queue, void **item) {
+    uint64_t position = EXEC_LOAD(&queue->head);
+    for (;;) {
+        QueueSlot *slot = &queue->slots[position & queue->mask];
+        int64_t lag = (int64_t)(EXEC_LOAD_ACQUIRE(&slot->sequence) - (position + 1));
+        if (lag == 0) {
+            if (EXEC_CAS(&queue->head, position, position + 1)) {
+                *item = slot->item;
+                EXEC_STORE_RELEASE(&slot->sequence, position + queue->mask + 1);
+                return 0;
+            }
+            position = EXEC_LOAD(&queue->head);
+        } else if (lag < 0) {
+            return -1;               // Not filled yet: empty
+        } else {
+            position = EXEC_LOAD(&queue->head);
+        }
+    }
+}
+
+size_t vedic_mpmc_capacity(const VedicMpmcQueue *queue) {
+    return (size_t)queue->mask + 1;
+}
+
+// ============================================================================
+// EXECUTOR
+// ============================================================================
+
+// Requests are grouped by operation and by lane: integer operands use the
+// long kernels, anything with a floating-point operand the VedicValue ones
+enum { LANE_INTEGER = 0, LANE_VALUE = 1, LANE_COUNT = 2 };
+#define BUCKET_COUNT (VEDIC_EXEC_OP_COUNT * LANE_COUNT)
+
+/**
+ * Per-consumer scratch, sized for one micro-batch
+ */
+typedef struct {
+    VedicExecRequest **batch;        // As popped
+    VedicExecRequest **sorted;       // Grouped by bucket
+    long *a;
+    long *b;
+    long *results;
+    VedicValue *value_a;
+    VedicValue *value_b;
+    VedicValue *value_results;
+} ConsumerScratch;
+
+typedef struct {
+    VedicExecutor *executor;
+    ConsumerScratch scratch;
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+    HANDLE thread;
+#else
+    pthread_t thread;
+#endif
+} Consumer;
+
+struct VedicExecutor {
+    VedicMpmcQueue *queue;
+    size_t max_batch;
+    uint64_t linger_ns;
+    int consumer_count;
+    Consumer consumers[VEDIC_EXEC_MAX_CONSUMERS];
+
+    int stopping;
+    int idle_consumers;              // Consumers asleep or about to sleep (under lock)
+    int waiters;                     // Threads asleep in vedic_exec_wait (under lock)
+    ExecLock lock;
+    ExecCondition work_ready;
+    ExecCondition request_done;
+
+    uint64_t submitted;
+    uint64_t rejected;
+    uint64_t completed;
+    uint64_t batches;
+    uint64_t largest_batch;
+};
+
+static uint64_t exec_now_ns(void) {
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+#endif
+}
+
+static void idle_wait(VedicExecutor *executor) {
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+    SleepConditionVariableSRW(&executor->work_ready, &executor->lock, EXEC_IDLE_WAIT_MS, 0);
+#else
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    uint64_t nanoseconds = (uint64_t)deadline.tv_nsec + EXEC_IDLE_WAIT_MS * 1000000ull;
+    deadline.tv_sec += (time_t)(nanoseconds / 1000000000ull);
+    deadline.tv_nsec = (long)(nanoseconds % 1000000000ull);
+    pthread_cond_timedwait(&executor->work_ready, &executor->lock, &deadline);
+#endif
+}
+
+static void done_wait(VedicExecutor *executor) {
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+    SleepConditionVariableSRW(&executor->request_done, &executor->lock, INFINITE, 0);
+#else
+    pthread_cond_wait(&executor->request_done, &executor->lock);
+#endif
+}
+
+static int integer_type(VedicNumberType type) {
+    return type == VEDIC_INT32 || type == VEDIC_INT64;
+}
+
+static int request_bucket(const VedicExecRequest *request) {
+    int integer = integer_type(request->a.type) &&
+                  (request->op == VEDIC_EXEC_SQUARE || integer_type(request->b.type));
+    return (int)request->op * LANE_COUNT + (integer ? LANE_INTEGER : LANE_VALUE);
+}
+
+/**
+ * Publish a result: the callback runs before waiters see the final status,
+ * and the request is not touched after the status store
+ */
+static void complete_request(VedicExecutor *executor, VedicExecRequest *request, VedicExecStatus status) {
+    if (request->callback) {
+        request->callback(request, status, request->user_data);
+    }
+    EXEC_INT_STORE(&request->status, (int)status);
+    EXEC_FENCE();
+    if (EXEC_INT_LOAD(&executor->waiters) > 0) {
+        EXEC_LOCK(&executor->lock);
+        EXEC_BROADCAST(&executor->request_done);
+        EXEC_UNLOCK(&executor->lock);
+    }
+}
+
+/**
+ * Run one group of requests with the same operation and lane
+ */
+static void run_bucket(VedicExecutor *executor, ConsumerScratch *scratch, int bucket,
+                       VedicExecRequest **requests, size_t count) {
+    VedicExecOp op = (VedicExecOp)(bucket / LANE_COUNT);
+    int lane = bucket % LANE_COUNT;
+
+    if (lane == LANE_INTEGER) {
+        for (size_t i = 0; i < count; i++) {
+            scratch->a[i] = (long)vedic_to_int64(requests[i]->a);
+            scratch->b[i] = op == VEDIC_EXEC_SQUARE ? scratch->a[i] : (long)vedic_to_int64(requests[i]->b);
+        }
+        // Division runs per element below, for the remainders
+        if (op != VEDIC_EXEC_DIVIDE) {
+            vedic_multiply_batch(scratch->results, scratch->a, scratch->b, count);
+        }
+        for (size_t i = 0; i < count; i++) {
+            VedicExecRequest *request = requests[i];
+            if (op == VEDIC_EXEC_DIVIDE) {
+                if (scratch->b[i] == 0) {
+                    complete_request(executor, request, VEDIC_EXEC_FAILED);
+                    continue;
+                }
+                scratch->results[i] = vedic_divide(scratch->a[i], scratch->b[i], &request->remainder);
+            }
+            request->result = vedic_from_int64(scratch->results[i]);
+            complete_request(executor, request, VEDIC_EXEC_DONE);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        scratch->value_a[i] = requests[i]->a;
+        scratch->value_b[i] = op == VEDIC_EXEC_SQUARE ? requests[i]->a : requests[i]->b;
+    }
+    if (op == VEDIC_EXEC_DIVIDE) {
+        for (size_t i = 0; i < count; i++) {
+            scratch->value_results[i] = vedic_optimized_divide(scratch->value_a[i], scratch->value_b[i]);
+        }
+    } else {
+        vedic_optimized_multiply_batch(scratch->value_results, scratch->value_a, scratch->value_b, count);
+    }
+    for (size_t i = 0; i < count; i++) {
+        requests[i]->result = scratch->value_results[i];
+        complete_request(executor, requests[i], VEDIC_EXEC_DONE);
+    }
+}
+
+/**
+ * Group a micro-batch by bucket (counting sort, stable) and run each group
+ */
+static void run_batch(VedicExecutor *executor, ConsumerScratch *scratch, size_t count) {
+    // Counted before any request completes, so a caller that has seen its
+    // results also sees them in the statistics
+    EXEC_ADD(&executor->batches, 1);
+    EXEC_ADD(&executor->completed, count);
+    uint64_t largest = EXEC_LOAD(&executor->largest_batch);
+    while (count > largest && !EXEC_CAS(&executor->largest_batch, largest, (uint64_t)count)) {
+        largest = EXEC_LOAD(&executor->largest_batch);
+    }
+
+    size_t starts[BUCKET_COUNT + 1] = {0};
+    for (size_t i = 0; i < count; i++) {
+        starts[request_bucket(scratch->batch[i]) + 1]++;
+    }
+    for (int bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+        starts[bucket + 1] += starts[bucket];
+    }
+    size_t fill[BUCKET_COUNT];
+    memcpy(fill, starts, sizeof(fill));
+    for (size_t i = 0; i < count; i++) {
+        scratch->sorted[fill[request_bucket(scratch->batch[i])]++] = scratch->batch[i];
+    }
+
+    for (int bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+        size_t size = starts[bucket + 1] - starts[bucket];
+        if (size > 0) run_bucket(executor, scratch, bucket, scratch->sorted + starts[bucket], size);
+    }
+}
+
+/**
+ * Take the first request of a batch, sleeping while the queue is empty
+ *
+ * @return 0 with a request, -1 once stopping and drained
+ */
+static int take_first(VedicExecutor *executor, VedicExecRequest **first) {
+    void *item;
+    for (;;) {
+        if (vedic_mpmc_pop(executor->queue, &item) == 0) {
+            *first = (VedicExecRequest *)item;
+            return 0;
+        }
+
+        // Announce the sleep before the last look, so a producer that
+        // pushes after that look sees idle_consumers and wakes us
+        EXEC_LOCK(&executor->lock);
+        EXEC_INT_STORE(&executor->idle_consumers, executor->idle_consumers + 1);
+        EXEC_FENCE();
+        if (vedic_mpmc_pop(executor->queue, &item) == 0) {
+            EXEC_INT_STORE(&executor->idle_consumers, executor->idle_consumers - 1);
+            EXEC_UNLOCK(&executor->lock);
+            *first = (VedicExecRequest *)item;
+            return 0;
+        }
+        if (EXEC_INT_LOAD(&executor->stopping)) {
+            EXEC_INT_STORE(&executor->idle_consumers, executor->idle_consumers - 1);
+            EXEC_UNLOCK(&executor->lock);
+            return -1;
+        }
+        idle_wait(executor);
+        EXEC_INT_STORE(&executor->idle_consumers, executor->idle_consumers - 1);
+        EXEC_UNLOCK(&executor->lock);
+    }
+}
+
+static void consume(Consumer *consumer) {
+    VedicExecutor *executor = consumer->executor;
+    ConsumerScratch *scratch = &consumer->scratch;
+    VedicExecRequest *first;
+
+    while (take_first(executor, &first) == 0) {
+        size_t count = 0;
+        scratch->batch[count++] = first;
+
+        // Fill the batch from what is queued, lingering for more if asked
+        uint64_t deadline = executor->linger_ns ? exec_now_ns() + executor->linger_ns : 0;
+        void *item;
+        while (count < executor->max_batch) {
+            if (vedic_mpmc_pop(executor->queue, &item) == 0) {
+                scratch->batch[count++] = (VedicExecRequest *)item;
+            } else if (deadline && exec_now_ns() < deadline) {
+                EXEC_YIELD();        // Let producers on this CPU run
+            } else {
+                break;
+            }
+        }
+        run_batch(executor, scratch, count);
+    }
+}
+
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+static DWORD WINAPI consumer_main(LPVOID argument) {
+    consume((Consumer *)argument);
+    return 0;
+}
+
+static int consumer_spawn(Consumer *consumer) {
+    consumer->thread = CreateThread(NULL, 0, consumer_main, consumer, 0, NULL);
+    return consumer->thread ? 0 : -1;
+}
+
+static void consumer_join(Consumer *consumer) {
+    WaitForSingleObject(consumer->thread, INFINITE);
+    CloseHandle(consumer->thread);
+}
+#else
+static void *consumer_main(void *argument) {
+    consume((Consumer *)argument);
+    return NULL;
+}
+
+static int consumer_spawn(Consumer *consumer) {
+    return pthread_create(&consumer->thread, NULL, consumer_main, consumer) == 0 ? 0 : -1;
+}
+
+static void consumer_join(Consumer *consumer) {
+    pthread_join(consumer->thread, NULL);
+}
+#endif
+
+static void scratch_free(ConsumerScratch *scratch) {
+    VEDIC_FREE(scratch->batch);
+    VEDIC_FREE(scratch->sorted);
+    VEDIC_FREE(scratch->a);
+    VEDIC_FREE(scratch->b);
+    VEDIC_FREE(scratch->results);
+    VEDIC_FREE(scratch->value_a);
+    VEDIC_FREE(scratch->value_b);
+    VEDIC_FREE(scratch->value_results);
+}
+
+static int scratch_alloc(ConsumerScratch *scratch, size_t size) {
+    scratch->batch = (VedicExecRequest **)VEDIC_MALLOC(size * sizeof(VedicExecRequest *));
+    scratch->sorted = (VedicExecRequest **)VEDIC_MALLOC(size * sizeof(VedicExecRequest *));
+    scratch->a = (long *)VEDIC_MALLOC(size * sizeof(long));
+    scratch->b = (long *)VEDIC_MALLOC(size * sizeof(long));
+    scratch->results = (long *)VEDIC_MALLOC(size * sizeof(long));
+    scratch->value_a = (VedicValue *)VEDIC_MALLOC(size * sizeof(VedicValue));
+    scratch->value_b = (VedicValue *)VEDIC_MALLOC(size * sizeof(VedicValue));
+    scratch->value_results = (VedicValue *)VEDIC_MALLOC(size * sizeof(VedicValue));
+    return scratch->batch && scratch->sorted && scratch->a && scratch->b && scratch->results &&
+           scratch->value_a && scratch->value_b && scratch->value_results ? 0 : -1;
+}
+
+static void executor_free(VedicExecutor *executor) {
+    for (int i = 0; i < VEDIC_EXEC_MAX_CONSUMERS; i++) {
+        scratch_free(&executor->consumers[i].scratch);
+    }
+    vedic_mpmc_destroy(executor->queue);
+    EXEC_CONDITION_DESTROY(&executor->request_done);
+    EXEC_CONDITION_DESTROY(&executor->work_ready);
+    EXEC_LOCK_DESTROY(&executor->lock);
+    VEDIC_FREE(executor);
+}
+
+VedicExecutor *vedic_executor_create(const VedicExecutorConfig *config) {
+    VedicExecutorConfig settings = {0, 0, 0, 0};
+    if (config) settings = *config;
+    if (settings.queue_capacity == 0) settings.queue_capacity = VEDIC_EXEC_DEFAULT_QUEUE;
+    if (settings.max_batch == 0) settings.max_batch = VEDIC_EXEC_DEFAULT_BATCH;
+    if (settings.consumers == 0) settings.consumers = 1;
+    if (settings.max_batch > VEDIC_EXEC_MAX_BATCH || settings.consumers < 0 ||
+        settings.consumers > VEDIC_EXEC_MAX_CONSUMERS) {
+        return NULL;
+    }
+
+    VEDIC_ALLOC_SCOPE_BEGIN("vedic_executor_create");
+    VedicExecutor *executor = (VedicExecutor *)VEDIC_MALLOC(sizeof(VedicExecutor));
+    if (executor) {
+        memset(executor, 0, sizeof(*executor));
+        EXEC_LOCK_INIT(&executor->lock);
+        EXEC_CONDITION_INIT(&executor->work_ready);
+        EXEC_CONDITION_INIT(&executor->request_done);
+    }
+    int ready = executor != NULL;
+    if (ready) {
+        executor->queue = vedic_mpmc_create(settings.queue_capacity);
+        ready = executor->queue != NULL;
+    }
+    for (int i = 0; ready && i < settings.consumers; i++) {
+        ready = scratch_alloc(&executor->consumers[i].scratch, settings.max_batch) == 0;
+    }
+    VEDIC_ALLOC_SCOPE_END();
+    if (!ready) {
+        if (executor) executor_free(executor);
+        return NULL;
+    }
+
+    executor->max_batch = settings.max_batch;
+    executor->linger_ns = (uint64_t)settings.linger_us * 1000ull;
+    for (int i = 0; i < settings.consumers; i++) {
+        executor->consumers[i].executor = executor;
+        if (consumer_spawn(&executor->consumers[i]) != 0) {
+            executor->consumer_count = i;
+            vedic_executor_destroy(executor);
+            return NULL;
+        }
+    }
+    executor->consumer_count = settings.consumers;
+    return executor;
+}
+
+void vedic_executor_destroy(VedicExecutor *executor) {
+    if (!executor) return;
+    EXEC_LOCK(&executor->lock);
+    EXEC_INT_STORE(&executor->stopping, 1);
+    EXEC_BROADCAST(&executor->work_ready);
+    EXEC_UNLOCK(&executor->lock);
+
+    // Consumers leave once the queue is empty, so queued requests finish
+    for (int i = 0; i < executor->consumer_count; i++) {
+        consumer_join(&executor->consumers[i]);
+    }
+    executor_free(executor);
+}
+
+int vedic_exec_submit(VedicExecutor *executor, VedicExecRequest *request) {
+    if (!request || (int)request->op < 0 || request->op >= VEDIC_EXEC_OP_COUNT) return -1;
+    request->status = VEDIC_EXEC_PENDING;
+    if (EXEC_INT_LOAD(&executor->stopping) || vedic_mpmc_push(executor->queue, request) != 0) {
+        EXEC_ADD(&executor->rejected, 1);
+        return -1;
+    }
+    EXEC_ADD(&executor->submitted, 1);
+
+    // Pairs with the announcement in take_first
+    EXEC_FENCE();
+    if (EXEC_INT_LOAD(&executor->idle_consumers) > 0) {
+        EXEC_LOCK(&executor->lock);
+        EXEC_BROADCAST(&executor->work_ready);
+        EXEC_UNLOCK(&executor->lock);
+    }
+    return 0;
+}
+
+VedicExecStatus vedic_exec_poll(const VedicExecRequest *request) {
+    return (VedicExecStatus)EXEC_INT_LOAD(&request->status);
+}
+
+VedicExecStatus vedic_exec_wait(VedicExecutor *executor, VedicExecRequest *request) {
+    // Micro-batches finish within microseconds, so spin before sleeping
+    for (int i = 0; i < EXEC_SPIN_POLLS; i++) {
+        VedicExecStatus status = vedic_exec_poll(request);
+        if (status != VEDIC_EXEC_PENDING) return status;
+        if (i % 64 == 63) EXEC_YIELD();
+    }
+
+    EXEC_LOCK(&executor->lock);
+    EXEC_INT_STORE(&executor->waiters, executor->waiters + 1);
+    EXEC_FENCE();
+    while (vedic_exec_poll(request) == VEDIC_EXEC_PENDING) {
+        done_wait(executor);
+    }
+    EXEC_INT_STORE(&executor->waiters, executor->waiters - 1);
+    EXEC_UNLOCK(&executor->lock);
+    return vedic_exec_poll(request);
+}
+
+VedicExecutorStats vedic_executor_get_stats(const VedicExecutor *executor) {
+    VedicExecutorStats stats;
+    stats.submitted = EXEC_LOAD(&executor->submitted);
+    stats.rejected = EXEC_LOAD(&executor->rejected);
+    stats.completed = EXEC_LOAD(&executor->completed);
+    stats.batches = EXEC_LOAD(&executor->batches);
+    stats.largest_batch = EXEC_LOAD(&executor->largest_batch);
+    return stats;
+}
+
+#else /* !EXEC_HAVE_THREADS */
+
+VedicMpmcQueue *vedic_mpmc_create(size_t capacity) {
+    (void)capacity;
+    return NULL;
+}
+
+void vedic_mpmc_destroy(VedicMpmcQueue *queue) {
+    (void)queue;
+}
+
+int vedic_mpmc_push(VedicMpmcQueue *queue, void *item) {
+    (void)queue;
+    (void)item;
+    return -1;
+}
+
+int vedic_mpmc_pop(VedicMpmcQueue *queue, void **item) {
+    (void)queue;
+    (void)item;
+    return -1;
+}
+
+size_t vedic_mpmc_capacity(const VedicMpmcQueue *queue) {
+    (void)queue;
+    return 0;
+}
+
+VedicExecutor *vedic_executor_create(const VedicExecutorConfig *config) {
+    (void)config;
+    return NULL;
+}
+
+void vedic_executor_destroy(VedicExecutor *executor) {
+    (void)executor;
+}
+
+int vedic_exec_submit(VedicExecutor *executor, VedicExecRequest *request) {
+    (void)executor;
+    (void)request;
+    return -1;
+}
+
+VedicExecStatus vedic_exec_poll(const VedicExecRequest *request) {
+    return (VedicExecStatus)request->status;
+}
+
+VedicExecStatus vedic_exec_wait(VedicExecutor *executor, VedicExecRequest *request) {
+    (void)executor;
+    return (VedicExecStatus)request->status;
+}
+
+VedicExecutorStats vedic_executor_get_stats(const VedicExecutor *executor) {
+    VedicExecutorStats stats = {0, 0, 0, 0, 0};
+    (void)executor;
+    return stats;
+}
+
+#endif /* EXEC_HAVE_THREADS */
@@ -0,0 +1,522 @@
+/**
+ * vedicmath_metrics.c - Engine counters and the shared-memory metrics ring
+ */
+#include "vedicmath_metrics.h"
+#include "vedicmath_alloc.h"
+#include "vedicmath_async.h"
+#include "vedicmath_energy.h"
+#include "vedicmath_pool.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SNAPSHOT_WORDS (sizeof(VedicMetricsSnapshot) / sizeof(uint64_t))
+
+// Snapshots are copied to and from shared memory one 64-bit word at a time
+typedef char snapshot_is_whole_words[sizeof(VedicMetricsSnapshot) % sizeof(uint64_t) == 0 ? 1 : -1];
+
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+#include <windows.h>
+static SRWLOCK metrics_lock = SRWLOCK_INIT;
+static CONDITION_VARIABLE metrics_wake = CONDITION_VARIABLE_INIT;
+#define METRICS_LOCK() AcquireSRWLockExclusive(&metrics_lock)
+#define METRICS_UNLOCK() ReleaseSRWLockExclusive(&metrics_lock)
+#define METRICS_BROADCAST() WakeAllConditionVariable(&metrics_wake)
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+static pthread_mutex_t metrics_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t metrics_wake = PTHREAD_COND_INITIALIZER;
+#define METRICS_LOCK() pthread_mutex_lock(&metrics_lock)
+#define METRICS_UNLOCK() pthread_mutex_unlock(&metrics_lock)
+#define METRICS_BROADCAST() pthread_cond_broadcast(&metrics_wake)
+#endif
+
+// Counters and ring words are shared between threads (and processes)
+#if defined(__GNUC__) || defined(__clang__)
+#define METRICS_ADD(ptr, value) __atomic_fetch_add(ptr, value, __ATOMIC_RELAXED)
+#define METRICS_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_RELAXED)
+#define METRICS_LOAD_ACQUIRE(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define METRICS_STORE(ptr, value) __atomic_store_n(ptr, value, __ATOMIC_RELAXED)
+#define METRICS_STORE_RELEASE(ptr, value) __atomic_store_n(ptr, value, __ATOMIC_RELEASE)
+#define METRICS_FENCE_ACQUIRE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define METRICS_FENCE_RELEASE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#elif defined(VEDICMATH_PLATFORM_WINDOWS)
+#define METRICS_ADD(ptr, value) InterlockedExchangeAdd64((volatile LONG64 *)(ptr), (LONG64)(value))
+#define METRICS_LOAD(ptr) (*(volatile const uint64_t *)(ptr))
+#define METRICS_LOAD_ACQUIRE(ptr) (*(volatile const uint64_t *)(ptr))
+#define METRICS_STORE(ptr, value) (*(volatile uint64_t *)(ptr) = (value))
+#define METRICS_STORE_RELEASE(ptr, value) (MemoryBarrier(), *(volatile uint64_t *)(ptr) = (value))
+#define METRICS_FENCE_ACQUIRE() MemoryBarrier()
+#define METRICS_FENCE_RELEASE() MemoryBarrier()
+#else
+#define METRICS_ADD(ptr, value) (*(volatile uint64_t *)(ptr) += (value))
+#define METRICS_LOAD(ptr) (*(volatile const uint64_t *)(ptr))
+#define METRICS_LOAD_ACQUIRE(ptr) (*(volatile const uint64_t *)(ptr))
+#define METRICS_STORE(ptr, value) (*(volatile uint64_t *)(ptr) = (value))
+#define METRICS_STORE_RELEASE(ptr, value) (*(volatile uint64_t *)(ptr) = (value))
+#define METRICS_FENCE_ACQUIRE() ((void)0)
+#define METRICS_FENCE_RELEASE() ((void)0)
+#endif
+
+static uint64_t counters[VEDIC_METRIC_COUNT];
+
+// Package energy baseline, set by the first collect (under metrics_lock)
+static int energy_state = 0;         // 0 = not read yet, 1 = baseline taken, -1 = unavailable
+static VedicEnergySample energy_baseline;
+
+/**
+ * Shared layout: header, then capacity slots
+ */
+typedef struct {
+    uint32_t magic;                  // Written last by the creator
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t snapshot_size;
+    uint64_t head;                   // Newest published sequence
+    uint64_t writer_pid;
+} RingHeader;
+
+typedef struct {
+    uint64_t mark;                   // 2 * sequence when complete, odd while being written
+    uint64_t words[SNAPSHOT_WORDS];
+} RingSlot;
+
+struct VedicMetricsRing {
+    RingHeader *header;
+    RingSlot *slots;
+    size_t size;
+    int writable;
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+    HANDLE mapping;
+#endif
+};
+
+static uint64_t monotonic_ns(void) {
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+#endif
+}
+
+static uint64_t process_id(void) {
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+    return (uint64_t)GetCurrentProcessId();
+#else
+    return (uint64_t)getpid();
+#endif
+}
+
+void vedic_metrics_add(VedicMetric metric, uint64_t amount) {
+    if ((int)metric < 0 || metric >= VEDIC_METRIC_COUNT) return;
+    METRICS_ADD(&counters[metric], amount);
+}
+
+uint64_t vedic_metrics_get(VedicMetric metric) {
+    if ((int)metric < 0 || metric >= VEDIC_METRIC_COUNT) return 0;
+    return METRICS_LOAD(&counters[metric]);
+}
+
+void vedic_metrics_collect(VedicMetricsSnapshot *snapshot) {
+    memset(snapshot, 0, sizeof(*snapshot));
+    snapshot->timestamp_ns = monotonic_ns();
+    snapshot->pid = process_id();
+    for (int i = 0; i < VEDIC_METRIC_COUNT; i++) {
+        snapshot->counters[i] = METRICS_LOAD(&counters[i]);
+    }
+
+    VedicPoolStats pool = vedic_pool_get_stats();
+    snapshot->pool_parallel_calls = pool.parallel_calls;
+    snapshot->pool_serial_calls = pool.serial_calls;
+    snapshot->pool_ranges = pool.ranges_executed;
+    snapshot->pool_steals = pool.steals;
+
+    VedicAsyncStats async = vedic_async_get_stats();
+    snapshot->async_submitted = async.submitted;
+    snapshot->async_completed = async.completed;
+    snapshot->async_cancelled = async.cancelled;
+    snapshot->async_in_flight = async.in_flight;
+
+    if (vedic_alloc_tracking_enabled()) {
+        VedicAllocCounts totals = vedic_alloc_get_totals();
+        snapshot->alloc_count = totals.allocations + totals.reallocations;
+        snapshot->alloc_bytes = totals.bytes;
+    }
+
+    snapshot->energy_joules = -1.0;
+    METRICS_LOCK();
+    if (energy_state == 0) {
+        energy_state = (vedic_energy_init() > 0 && vedic_energy_available(VEDIC_ENERGY_PACKAGE) &&
+                        vedic_energy_read(&energy_baseline) == 0) ? 1 : -1;
+    }
+    VedicEnergySample now;
+    if (energy_state == 1 && vedic_energy_read(&now) == 0) {
+        snapshot->energy_joules = vedic_energy_joules(&energy_baseline, &now, VEDIC_ENERGY_PACKAGE);
+    }
+    METRICS_UNLOCK();
+}
+
+// ============================================================================
+// SHARED-MEMORY RING
+// ============================================================================
+
+static size_t ring_size(uint32_t capacity) {
+    return sizeof(RingHeader) + (size_t)capacity * sizeof(RingSlot);
+}
+
+/**
+ * Wrap a mapping, checking the header of an attached ring against its size
+ */
+static VedicMetricsRing *ring_wrap(void *base, size_t size, int writable) {
+    RingHeader *header = (RingHeader *)base;
+    if (!writable) {
+        if (size < sizeof(RingHeader) || *(volatile const uint32_t *)&header->magic != VEDIC_METRICS_MAGIC) {
+            return NULL;
+        }
+        METRICS_FENCE_ACQUIRE();
+        if (header->version != VEDIC_METRICS_VERSION || header->snapshot_size != sizeof(VedicMetricsSnapshot) ||
+            header->capacity == 0 || ring_size(header->capacity) > size) {
+            return NULL;
+        }
+    }
+
+    VEDIC_ALLOC_SCOPE_BEGIN("vedic_metrics_ring");
+    VedicMetricsRing *ring = (VedicMetricsRing *)VEDIC_MALLOC(sizeof(VedicMetricsRing));
+    VEDIC_ALLOC_SCOPE_END();
+    if (!ring) return NULL;
+    ring->header = header;
+    ring->slots = (RingSlot *)(header + 1);
+    ring->size = size;
+    ring->writable = writable;
+    return ring;
+}
+
+/**
+ * Fill in the header of a new ring; the magic goes last
+ */
+static void ring_format(RingHeader *header, uint32_t capacity) {
+    header->version = VEDIC_METRICS_VERSION;
+    header->capacity = capacity;
+    header->snapshot_size = sizeof(VedicMetricsSnapshot);
+    header->head = 0;
+    header->writer_pid = process_id();
+    METRICS_FENCE_RELEASE();
+    *(volatile uint32_t *)&header->magic = VEDIC_METRICS_MAGIC;
+}
+
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+
+/**
+ * "Local\" plus the name without its leading slash
+ */
+static void mapping_name(const char *name, char *buffer, size_t size) {
+    snprintf(buffer, size, "Local\\%s", name[0] == '/' ? name + 1 : name);
+}
+
+VedicMetricsRing *vedic_metrics_ring_create(const char *name, uint32_t capacity) {
+    if (capacity == 0) capacity = VEDIC_METRICS_DEFAULT_CAPACITY;
+    size_t size = ring_size(capacity);
+    char mapped_name[128];
+    if (name) mapping_name(name, mapped_name, sizeof(mapped_name));
+
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                       (DWORD)((uint64_t)size >> 32), (DWORD)size, name ? mapped_name : NULL);
+    if (!mapping) return NULL;
+    void *base = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!base) {
+        CloseHandle(mapping);
+        return NULL;
+    }
+    memset(base, 0, size);
+    ring_format((RingHeader *)base, capacity);
+
+    VedicMetricsRing *ring = ring_wrap(base, size, 1);
+    if (!ring) {
+        UnmapViewOfFile(base);
+        CloseHandle(mapping);
+        return NULL;
+    }
+    ring->mapping = mapping;
+    return ring;
+}
+
+VedicMetricsRing *vedic_metrics_ring_attach(const char *name) {
+    char mapped_name[128];
+    if (!name) return NULL;
+    mapping_name(name, mapped_name, sizeof(mapped_name));
+
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, mapped_name);
+    if (!mapping) return NULL;
+    void *base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    MEMORY_BASIC_INFORMATION info;
+    VedicMetricsRing *ring = NULL;
+    if (base && VirtualQuery(base, &info, sizeof(info)) != 0) {
+        ring = ring_wrap(base, info.RegionSize, 0);
+    }
+    if (!ring) {
+        if (base) UnmapViewOfFile(base);
+        CloseHandle(mapping);
+        return NULL;
+    }
+    ring->mapping = mapping;
+    return ring;
+}
+
+void vedic_metrics_ring_close(VedicMetricsRing *ring) {
+    if (!ring) return;
+    UnmapViewOfFile(ring->header);
+    CloseHandle(ring->mapping);
+    VEDIC_FREE(ring);
+}
+
+int vedic_metrics_ring_unlink(const char *name) {
+    // A file mapping disappears with its last handle
+    (void)name;
+    return 0;
+}
+
+#else
+
+VedicMetricsRing *vedic_metrics_ring_create(const char *name, uint32_t capacity) {
+    if (capacity == 0) capacity = VEDIC_METRICS_DEFAULT_CAPACITY;
+    size_t size = ring_size(capacity);
+    void *base;
+
+    if (name) {
+        shm_unlink(name);            // Replace, never reuse, an old ring
+        int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) return NULL;
+        if (ftruncate(fd, (off_t)size) != 0) {
+            close(fd);
+            shm_unlink(name);
+            return NULL;
+        }
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            shm_unlink(name);
+            return NULL;
+        }
+    } else {
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) return NULL;
+    }
+
+    // Fresh mappings are zero-filled: every slot starts unpublished
+    ring_format((RingHeader *)base, capacity);
+    VedicMetricsRing *ring = ring_wrap(base, size, 1);
+    if (!ring) munmap(base, size);
+    return ring;
+}
+
+VedicMetricsRing *vedic_metrics_ring_attach(const char *name) {
+    if (!name) return NULL;
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) return NULL;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(RingHeader)) {
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)info.st_size;
+    void *base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return NULL;
+
+    VedicMetricsRing *ring = ring_wrap(base, size, 0);
+    if (!ring) munmap(base, size);
+    return ring;
+}
+
+void vedic_metrics_ring_close(VedicMetricsRing *ring) {
+    if (!ring) return;
+    munmap(ring->header, ring->size);
+    VEDIC_FREE(ring);
+}
+
+int vedic_metrics_ring_unlink(const char *name) {
+    return (name && shm_unlink(name) == 0) ? 0 : -1;
+}
+
+#endif
+
+uint32_t vedic_metrics_ring_capacity(const VedicMetricsRing *ring) {
+    return ring->header->capacity;
+}
+
+uint64_t vedic_metrics_ring_publish(VedicMetricsRing *ring, const VedicMetricsSnapshot *snapshot) {
+    if (!ring->writable) return 0;
+
+    uint64_t sequence = METRICS_LOAD(&ring->header->head) + 1;
+    RingSlot *slot = &ring->slots[(sequence - 1) % ring->header->capacity];
+    uint64_t words[SNAPSHOT_WORDS];
+    memcpy(words, snapshot, sizeof(words));
+    words[0] = sequence;             // VedicMetricsSnapshot.sequence
+
+    METRICS_STORE(&slot->mark, 2 * sequence - 1);
+    METRICS_FENCE_RELEASE();
+    for (size_t i = 0; i < SNAPSHOT_WORDS; i++) {
+        METRICS_STORE(&slot->words[i], words[i]);
+    }
+    METRICS_STORE_RELEASE(&slot->mark, 2 * sequence);
+    METRICS_STORE_RELEASE(&ring->header->head, sequence);
+    return sequence;
+}
+
+uint64_t vedic_metrics_ring_head(const VedicMetricsRing *ring) {
+    return METRICS_LOAD_ACQUIRE(&ring->header->head);
+}
+
+int vedic_metrics_ring_read(const VedicMetricsRing *ring, uint64_t sequence, VedicMetricsSnapshot *snapshot) {
+    if (sequence == 0) return -1;
+    const RingSlot *slot = &ring->slots[(sequence - 1) % ring->header->capacity];
+    uint64_t words[SNAPSHOT_WORDS];
+
+    uint64_t mark = METRICS_LOAD_ACQUIRE(&slot->mark);
+    if (mark != 2 * sequence) return -1;
+    for (size_t i = 0; i < SNAPSHOT_WORDS; i++) {
+        words[i] = METRICS_LOAD(&slot->words[i]);
+    }
+    METRICS_FENCE_ACQUIRE();
+    if (METRICS_LOAD(&slot->mark) != mark) return -1;
+
+    memcpy(snapshot, words, sizeof(words));
+    return 0;
+}
+
+// ============================================================================
+// PUBLISHER
+// ============================================================================
+
+static VedicMetricsRing *publisher_ring = NULL;
+static unsigned publisher_interval_ms = 0;
+static int publisher_running = 0;    // Under metrics_lock
+static int publisher_stop = 0;
+
+static void publish_now(VedicMetricsRing *ring) {
+    VedicMetricsSnapshot snapshot;
+    vedic_metrics_collect(&snapshot);
+    vedic_metrics_ring_publish(ring, &snapshot);
+}
+
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+
+static HANDLE publisher_thread = NULL;
+
+static DWORD WINAPI publisher_main(LPVOID unused) {
+    (void)unused;
+    METRICS_LOCK();
+    while (!publisher_stop) {
+        SleepConditionVariableSRW(&metrics_wake, &metrics_lock, publisher_interval_ms, 0);
+        if (publisher_stop) break;
+        METRICS_UNLOCK();
+        publish_now(publisher_ring);
+        METRICS_LOCK();
+    }
+    METRICS_UNLOCK();
+    return 0;
+}
+
+static int publisher_spawn(void) {
+    publisher_thread = CreateThread(NULL, 0, publisher_main, NULL, 0, NULL);
+    return publisher_thread ? 0 : -1;
+}
+
+static void publisher_join(void) {
+    WaitForSingleObject(publisher_thread, INFINITE);
+    CloseHandle(publisher_thread);
+    publisher_thread = NULL;
+}
+
+#else
+
+static pthread_t publisher_thread;
+
+static void *publisher_main(void *unused) {
+    (void)unused;
+    METRICS_LOCK();
+    while (!publisher_stop) {
+        // Sleep until the next tick or until stop wakes us
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        uint64_t nanoseconds = (uint64_t)deadline.tv_nsec + (uint64_t)publisher_interval_ms * 1000000ull;
+        deadline.tv_sec += (time_t)(nanoseconds / 1000000000ull);
+        deadline.tv_nsec = (long)(nanoseconds % 1000000000ull);
+        int waited = 0;
+        while (!publisher_stop && waited != ETIMEDOUT) {
+            waited = pthread_cond_timedwait(&metrics_wake, &metrics_lock, &deadline);
+        }
+        if (publisher_stop) break;
+        METRICS_UNLOCK();
+        publish_now(publisher_ring);
+        METRICS_LOCK();
+    }
+    METRICS_UNLOCK();
+    return NULL;
+}
+
+static int publisher_spawn(void) {
+    return pthread_create(&publisher_thread, NULL, publisher_main, NULL) == 0 ? 0 : -1;
+}
+
+static void publisher_join(void) {
+    pthread_join(publisher_thread, NULL);
+}
+
+#endif
+
+int vedic_metrics_publisher_start(VedicMetricsRing *ring, unsigned interval_ms) {
+    if (!ring || !ring->writable) return -1;
+
+    METRICS_LOCK();
+    if (publisher_running) {
+        METRICS_UNLOCK();
+        return -1;
+    }
+    publisher_ring = ring;
+    publisher_interval_ms = interval_ms ? interval_ms : VEDIC_METRICS_DEFAULT_INTERVAL_MS;
+    publisher_stop = 0;
+    publisher_running = 1;
+    METRICS_UNLOCK();
+
+    // Readers attaching right away find a snapshot
+    publish_now(ring);
+
+    if (publisher_spawn() != 0) {
+        METRICS_LOCK();
+        publisher_running = 0;
+        publisher_ring = NULL;
+        METRICS_UNLOCK();
+        return -1;
+    }
+    return 0;
+}
+
+void vedic_metrics_publisher_stop(void) {
+    METRICS_LOCK();
+    if (!publisher_running) {
+        METRICS_UNLOCK();
+        return;
+    }
+    publisher_stop = 1;
+    METRICS_BROADCAST();
+    METRICS_UNLOCK();
+
+    publisher_join();
+
+    METRICS_LOCK();
+    publisher_running = 0;
+    publisher_ring = NULL;
+    METRICS_UNLOCK();
+}
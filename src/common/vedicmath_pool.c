@@ -0,0 +1,825 @@
+/**
+ * vedicmath_pool.c - Library-owned work-stealing thread pool
+ */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE                  // sched_getaffinity, sched_getcpu, pthread_setaffinity_np
+#endif
+#include "vedicmath_pool.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#if !defined(_WIN32) && !defined(ESP32_PLATFORM) && (defined(__GNUC__) || defined(__clang__))
+#define POOL_THREADED 1
+#endif
+
+#define POOL_NODE_ROOT "/sys/devices/system/node"
+#define POOL_MAX_NODE_IDS 1024       // Node directories considered by discovery
+#define POOL_CPU_TABLE 4096          // CPUs mapped to a node for the caller lookup
+#define POOL_TOUCH_GRAIN_BYTES 4096  // A page: smaller pieces cannot be placed apart
+
+static VedicPoolConfig pool_config = {0, NULL, 0, 0, NULL};
+static int pool_cpus[VEDIC_POOL_MAX_THREADS];
+static VedicPoolTopology pool_topology;
+static int pool_nodes = 1;           // Parts a call is split into
+static signed char cpu_nodes[POOL_CPU_TABLE];  // Index into pool_topology, -1 if unknown
+
+static uint64_t stat_parallel_calls = 0;
+static uint64_t stat_serial_calls = 0;
+static uint64_t stat_ranges = 0;
+static uint64_t stat_steals = 0;
+static uint64_t stat_node_splits = 0;
+
+// ============================================================================
+// TOPOLOGY
+// ============================================================================
+
+#ifdef __linux__
+/**
+ * Add the CPUs of a kernel list such as "0-3,8,10-11" that are in allowed
+ *
+ * @return Number of CPUs in cpus
+ */
+static int parse_cpu_list(const char *text, const cpu_set_t *allowed, int *cpus, int count, int max) {
+    const char *p = text;
+    while (*p && count < max) {
+        char *end;
+        long first = strtol(p, &end, 10);
+        if (end == p || first < 0) break;
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            if (end == p + 1) break;
+            p = end;
+        }
+        if (last >= CPU_SETSIZE) last = CPU_SETSIZE - 1;
+        for (long cpu = first; cpu <= last && count < max; cpu++) {
+            if (CPU_ISSET((int)cpu, allowed)) cpus[count++] = (int)cpu;
+        }
+        if (*p != ',') break;
+        p++;
+    }
+    return count;
+}
+
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+#endif
+
+int vedic_pool_discover_topology_at(const char *root, VedicPoolTopology *topology) {
+    memset(topology, 0, sizeof(*topology));
+    topology->node_count = 1;
+
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        CPU_ZERO(&allowed);
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        for (long cpu = 0; cpu < online && cpu < CPU_SETSIZE; cpu++) CPU_SET((int)cpu, &allowed);
+    }
+
+    if (!root) root = POOL_NODE_ROOT;
+    int ids[POOL_MAX_NODE_IDS];
+    int id_count = 0;
+    DIR *dir = opendir(root);
+    if (dir) {
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL && id_count < POOL_MAX_NODE_IDS) {
+            char *end;
+            if (strncmp(entry->d_name, "node", 4) != 0) continue;
+            long id = strtol(entry->d_name + 4, &end, 10);
+            if (end == entry->d_name + 4 || *end != '\0' || id < 0) continue;
+            ids[id_count++] = (int)id;
+        }
+        closedir(dir);
+    }
+    qsort(ids, (size_t)id_count, sizeof(int), compare_ints);
+
+    int nodes = 0;
+    for (int i = 0; i < id_count && nodes < VEDIC_POOL_MAX_NODES; i++) {
+        char path[512], text[4096];
+        snprintf(path, sizeof(path), "%s/node%d/cpulist", root, ids[i]);
+        FILE *file = fopen(path, "r");
+        if (!file) continue;
+        size_t length = fread(text, 1, sizeof(text) - 1, file);
+        fclose(file);
+        text[length] = '\0';
+
+        int count = parse_cpu_list(text, &allowed, topology->cpus[nodes], 0, VEDIC_POOL_MAX_NODE_CPUS);
+        if (count == 0) continue;    // Memory-only node, or none of it is ours
+        topology->node_ids[nodes] = ids[i];
+        topology->cpu_count[nodes] = count;
+        nodes++;
+    }
+
+    if (nodes == 0) {
+        // No NUMA information: one node with every CPU we may use
+        int count = 0;
+        for (int cpu = 0; cpu < CPU_SETSIZE && count < VEDIC_POOL_MAX_NODE_CPUS; cpu++) {
+            if (CPU_ISSET(cpu, &allowed)) topology->cpus[0][count++] = cpu;
+        }
+        topology->cpu_count[0] = count;
+        nodes = 1;
+    }
+    topology->node_count = nodes;
+#else
+    (void)root;
+#endif
+    return topology->node_count;
+}
+
+int vedic_pool_discover_topology(VedicPoolTopology *topology) {
+    return vedic_pool_discover_topology_at(NULL, topology);
+}
+
+#ifdef POOL_THREADED
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#define POOL_DEQUE_SIZE 256          // Pending ranges per thread (power of two)
+#define POOL_DEQUE_MASK (POOL_DEQUE_SIZE - 1)
+#define POOL_MAX_RANGES 256          // Ranges one call is split into at most
+#define POOL_SPIN_ROUNDS 64          // Failed steal rounds before a worker sleeps
+
+#define POOL_LOAD(ptr, order) __atomic_load_n(ptr, order)
+#define POOL_STORE(ptr, value, order) __atomic_store_n(ptr, value, order)
+#define POOL_ADD(ptr, value) __atomic_add_fetch(ptr, value, __ATOMIC_RELAXED)
+#define POOL_CAS(ptr, expected, desired) \
+    __atomic_compare_exchange_n(ptr, expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)
+
+typedef struct PoolJob PoolJob;
+
+/**
+ * A slice [begin, end) of one parallel call
+ */
+typedef struct PoolRange {
+    PoolJob *job;
+    size_t begin;
+    size_t end;
+    struct PoolRange *next;          // Node inbox link
+} PoolRange;
+
+/**
+ * One parallel call; lives on the caller's stack until every element is done
+ */
+struct PoolJob {
+    VedicPoolRangeFn fn;
+    void *context;
+    size_t grain;
+    size_t remaining;                // Elements not yet processed
+    size_t next_range;               // Next unused entry of ranges
+    PoolRange ranges[POOL_MAX_RANGES];
+};
+
+/**
+ * Chase-Lev deque: the owner pushes and pops at the bottom, thieves take
+ * from the top (Le, Pop, Cohen, Zappa Nardelli, PPoPP 2013)
+ */
+typedef struct {
+    int64_t top;
+    int64_t bottom;
+    PoolRange *slots[POOL_DEQUE_SIZE];
+    int in_use;                      // Caller slots: claimed by a thread
+    int node;                        // Workers: fixed at start; callers: node of the current call
+    uint64_t random_state;           // Victim selection
+    char padding[64];                // Keep neighbouring deques off this cache line
+} PoolDeque;
+
+// Workers own deques[0, VEDIC_POOL_MAX_THREADS), other calling threads claim
+// one of the rest on their first parallel call
+static PoolDeque deques[VEDIC_POOL_MAX_THREADS + VEDIC_POOL_MAX_CALLERS];
+static __thread PoolDeque *current_deque = NULL;
+
+static pthread_t workers[VEDIC_POOL_MAX_THREADS];
+static int worker_count = 0;
+static int caller_high = 0;          // Caller slots ever claimed
+static int started = 0;
+
+static pthread_mutex_t start_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t sleep_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake_cond = PTHREAD_COND_INITIALIZER;
+static unsigned long wake_epoch = 0;
+static int sleepers = 0;
+static int stopping = 0;
+
+// Tasks posted for the workers, oldest first
+static pthread_mutex_t posted_lock = PTHREAD_MUTEX_INITIALIZER;
+static VedicPoolTask *posted_head = NULL;
+static VedicPoolTask *posted_tail = NULL;
+static size_t posted_count = 0;
+
+// Node parts of split calls, waiting for a worker of that node
+static pthread_mutex_t inbox_lock = PTHREAD_MUTEX_INITIALIZER;
+static PoolRange *inbox_head[VEDIC_POOL_MAX_NODES];
+static size_t inbox_count[VEDIC_POOL_MAX_NODES];
+static int node_workers[VEDIC_POOL_MAX_NODES];
+
+static pthread_once_t caller_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t caller_key;
+
+// ============================================================================
+// DEQUE
+// ============================================================================
+
+static int deque_push(PoolDeque *deque, PoolRange *range) {
+    int64_t bottom = POOL_LOAD(&deque->bottom, __ATOMIC_RELAXED);
+    int64_t top = POOL_LOAD(&deque->top, __ATOMIC_ACQUIRE);
+    if (bottom - top >= POOL_DEQUE_SIZE) {
+        return -1;
+    }
+    POOL_STORE(&deque->slots[bottom & POOL_DEQUE_MASK], range, __ATOMIC_RELAXED);
+    POOL_STORE(&deque->bottom, bottom + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+static PoolRange *deque_pop(PoolDeque *deque) {
+    int64_t bottom = POOL_LOAD(&deque->bottom, __ATOMIC_RELAXED) - 1;
+    POOL_STORE(&deque->bottom, bottom, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t top = POOL_LOAD(&deque->top, __ATOMIC_RELAXED);
+
+    if (top > bottom) {
+        POOL_STORE(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+    PoolRange *range = POOL_LOAD(&deque->slots[bottom & POOL_DEQUE_MASK], __ATOMIC_RELAXED);
+    if (top == bottom) {
+        // Last entry: race the thieves for it
+        if (!POOL_CAS(&deque->top, &top, top + 1)) {
+            range = NULL;
+        }
+        POOL_STORE(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+    }
+    return range;
+}
+
+static PoolRange *deque_steal(PoolDeque *deque) {
+    int64_t top = POOL_LOAD(&deque->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t bottom = POOL_LOAD(&deque->bottom, __ATOMIC_ACQUIRE);
+    if (top >= bottom) {
+        return NULL;
+    }
+    PoolRange *range = POOL_LOAD(&deque->slots[top & POOL_DEQUE_MASK], __ATOMIC_RELAXED);
+    if (!POOL_CAS(&deque->top, &top, top + 1)) {
+        return NULL;                 // Lost to the owner or another thief
+    }
+    return range;
+}
+
+// ============================================================================
+// NODE INBOXES
+// ============================================================================
+
+static void inbox_put(int node, PoolRange *range) {
+    pthread_mutex_lock(&inbox_lock);
+    range->next = inbox_head[node];
+    inbox_head[node] = range;
+    POOL_STORE(&inbox_count[node], inbox_count[node] + 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&inbox_lock);
+}
+
+static PoolRange *inbox_take(int node) {
+    if (POOL_LOAD(&inbox_count[node], __ATOMIC_ACQUIRE) == 0) return NULL;
+    pthread_mutex_lock(&inbox_lock);
+    PoolRange *range = inbox_head[node];
+    if (range) {
+        inbox_head[node] = range->next;
+        POOL_STORE(&inbox_count[node], inbox_count[node] - 1, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&inbox_lock);
+    return range;
+}
+
+/**
+ * Node of the CPU the calling thread is on (0 if unknown)
+ */
+static int caller_node(void) {
+#ifdef __linux__
+    int cpu = sched_getcpu();
+    if (cpu >= 0 && cpu < POOL_CPU_TABLE && cpu_nodes[cpu] >= 0) return cpu_nodes[cpu];
+#endif
+    return 0;
+}
+
+// ============================================================================
+// SCHEDULING
+// ============================================================================
+
+static void wake_workers(void) {
+    // Pairs with the fence after a worker's sleeper increment: without it a
+    // weakly ordered CPU may read sleepers before the epoch bump is visible,
+    // and a worker that read the old epoch would sleep with nobody to wake it
+    POOL_ADD(&wake_epoch, 1);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (POOL_LOAD(&sleepers, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&sleep_lock);
+        pthread_cond_broadcast(&wake_cond);
+        pthread_mutex_unlock(&sleep_lock);
+    }
+}
+
+static uint64_t next_random(PoolDeque *self) {
+    uint64_t x = self->random_state ? self->random_state : (uint64_t)(uintptr_t)self | 1;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    self->random_state = x;
+    return x;
+}
+
+/**
+ * One pass over the other deques from a random start; with local set, only
+ * the workers of this thread's node
+ */
+static PoolRange *steal_work(PoolDeque *self, int local) {
+    int workers_now = POOL_LOAD(&worker_count, __ATOMIC_ACQUIRE);
+    int total = workers_now + POOL_LOAD(&caller_high, __ATOMIC_ACQUIRE);
+    if (total <= 1) return NULL;
+
+    int start = (int)(next_random(self) % (uint64_t)total);
+    for (int i = 0; i < total; i++) {
+        int slot = (start + i) % total;
+        PoolDeque *victim = slot < workers_now ? &deques[slot] : &deques[VEDIC_POOL_MAX_THREADS + slot - workers_now];
+        if (victim == self || (local && (slot >= workers_now || victim->node != self->node))) continue;
+        PoolRange *range = deque_steal(victim);
+        if (range) {
+            POOL_ADD(&stat_steals, 1);
+            return range;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Own deque first, then this node's part of a split call, then stealing
+ * within the node before across nodes
+ *
+ * Parts left for another node are taken only by the thread waiting on the
+ * call (caller set) or when that node has no workers, so an idle node does
+ * not carry off a busy node's data.
+ */
+static PoolRange *find_work(PoolDeque *self, int caller) {
+    PoolRange *range = deque_pop(self);
+    if (range) return range;
+    if (pool_nodes == 1) return steal_work(self, 0);
+
+    if ((range = inbox_take(self->node)) != NULL) return range;
+    if ((range = steal_work(self, 1)) != NULL) return range;
+    if ((range = steal_work(self, 0)) != NULL) return range;
+    for (int node = 0; node < pool_nodes; node++) {
+        if (node == self->node || (!caller && node_workers[node] > 0)) continue;
+        if ((range = inbox_take(node)) != NULL) return range;
+    }
+    return NULL;
+}
+
+/**
+ * Run a range, splitting off the upper half for thieves while it is
+ * larger than the grain
+ */
+static void execute_range(PoolDeque *self, PoolRange *range) {
+    PoolJob *job = range->job;
+    size_t begin = range->begin;
+    size_t end = range->end;
+
+    while (end - begin > job->grain) {
+        size_t index = __atomic_fetch_add(&job->next_range, 1, __ATOMIC_RELAXED);
+        if (index >= POOL_MAX_RANGES) break;
+
+        size_t middle = begin + (end - begin) / 2;
+        PoolRange *upper = &job->ranges[index];
+        upper->job = job;
+        upper->begin = middle;
+        upper->end = end;
+        if (deque_push(self, upper) != 0) break;   // Deque full: keep the rest
+        wake_workers();
+        end = middle;
+    }
+
+    job->fn(begin, end, job->context);
+    POOL_ADD(&stat_ranges, 1);
+    // Last access to the job: the caller may return once remaining is 0
+    __atomic_sub_fetch(&job->remaining, end - begin, __ATOMIC_RELEASE);
+}
+
+/**
+ * Oldest posted task, or NULL
+ */
+static VedicPoolTask *take_posted(void) {
+    if (POOL_LOAD(&posted_count, __ATOMIC_ACQUIRE) == 0) return NULL;
+    pthread_mutex_lock(&posted_lock);
+    VedicPoolTask *task = posted_head;
+    if (task) {
+        posted_head = task->next;
+        if (!posted_head) posted_tail = NULL;
+        POOL_STORE(&posted_count, posted_count - 1, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&posted_lock);
+    return task;
+}
+
+static void *worker_main(void *arg) {
+    PoolDeque *self = (PoolDeque *)arg;
+    current_deque = self;
+
+#ifdef __linux__
+    int index = (int)(self - deques);
+    if (pool_config.numa && pool_topology.cpu_count[self->node] > 0) {
+        // Any CPU of the node: the scheduler balances within it
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int i = 0; i < pool_topology.cpu_count[self->node]; i++) {
+            int cpu = pool_topology.cpus[self->node][i];
+            if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+        }
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    } else if (pool_config.cpu_count > 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(pool_cpus[index % pool_config.cpu_count], &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#endif
+
+    int idle_rounds = 0;
+    for (;;) {
+        unsigned long epoch = POOL_LOAD(&wake_epoch, __ATOMIC_SEQ_CST);
+        PoolRange *range = find_work(self, 0);
+        if (range) {
+            execute_range(self, range);
+            idle_rounds = 0;
+            continue;
+        }
+        VedicPoolTask *task = take_posted();
+        if (task) {
+            task->run(task);
+            idle_rounds = 0;
+            continue;
+        }
+        // Posted tasks are drained before the workers stop
+        if (POOL_LOAD(&stopping, __ATOMIC_ACQUIRE)) break;
+        if (++idle_rounds < POOL_SPIN_ROUNDS) {
+            sched_yield();
+            continue;
+        }
+
+        // Sleep until a push bumps the epoch; a push between the scan above
+        // and the check below is seen through the epoch or the sleeper count
+        idle_rounds = 0;
+        POOL_ADD(&sleepers, 1);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        pthread_mutex_lock(&sleep_lock);
+        while (POOL_LOAD(&wake_epoch, __ATOMIC_SEQ_CST) == epoch && !POOL_LOAD(&stopping, __ATOMIC_ACQUIRE)) {
+            pthread_cond_wait(&wake_cond, &sleep_lock);
+        }
+        pthread_mutex_unlock(&sleep_lock);
+        __atomic_sub_fetch(&sleepers, 1, __ATOMIC_SEQ_CST);
+    }
+    return NULL;
+}
+
+static int default_thread_count(void) {
+    long cpus = 0;
+#ifdef __linux__
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        cpus = CPU_COUNT(&set);
+    }
+#endif
+    if (cpus <= 0) {
+        cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    // The caller is the remaining thread
+    long threads = cpus - 1;
+    if (threads < 0) threads = 0;
+    if (threads > VEDIC_POOL_MAX_THREADS) threads = VEDIC_POOL_MAX_THREADS;
+    return (int)threads;
+}
+
+/**
+ * Start the workers on first use
+ *
+ * @return Number of workers running
+ */
+static int pool_start(void) {
+    if (POOL_LOAD(&started, __ATOMIC_ACQUIRE)) {
+        return POOL_LOAD(&worker_count, __ATOMIC_ACQUIRE);
+    }
+
+    pthread_mutex_lock(&start_lock);
+    if (!started) {
+        int threads = pool_config.threads > 0 ? pool_config.threads : default_thread_count();
+        int created = 0;
+        POOL_STORE(&stopping, 0, __ATOMIC_RELEASE);
+        memset(node_workers, 0, sizeof(node_workers));
+        for (int i = 0; i < threads; i++) {
+            memset(&deques[i], 0, sizeof(deques[i]));
+            // Workers are dealt to the nodes in turn
+            deques[i].node = i % pool_nodes;
+            node_workers[deques[i].node]++;
+        }
+        // Publish the count before the workers look at each other's deques
+        POOL_STORE(&worker_count, threads, __ATOMIC_RELEASE);
+        for (int i = 0; i < threads; i++) {
+            if (pthread_create(&workers[i], NULL, worker_main, &deques[i]) != 0) break;
+            created++;
+        }
+        POOL_STORE(&worker_count, created, __ATOMIC_RELEASE);
+        POOL_STORE(&stat_parallel_calls, 0, __ATOMIC_RELAXED);
+        POOL_STORE(&stat_serial_calls, 0, __ATOMIC_RELAXED);
+        POOL_STORE(&stat_ranges, 0, __ATOMIC_RELAXED);
+        POOL_STORE(&stat_steals, 0, __ATOMIC_RELAXED);
+        POOL_STORE(&stat_node_splits, 0, __ATOMIC_RELAXED);
+        POOL_STORE(&started, 1, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&start_lock);
+    return POOL_LOAD(&worker_count, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Release a caller slot when its thread exits, running anything left in it
+ */
+static void release_caller(void *arg) {
+    PoolDeque *self = (PoolDeque *)arg;
+    PoolRange *range;
+    current_deque = self;
+    while ((range = deque_pop(self)) != NULL) {
+        execute_range(self, range);
+    }
+    current_deque = NULL;
+    POOL_STORE(&self->in_use, 0, __ATOMIC_RELEASE);
+}
+
+static void create_caller_key(void) {
+    pthread_key_create(&caller_key, release_caller);
+}
+
+/**
+ * Deque of the calling thread, claiming a caller slot on first use
+ */
+static PoolDeque *calling_deque(void) {
+    if (current_deque) return current_deque;
+
+    pthread_once(&caller_key_once, create_caller_key);
+    for (int i = 0; i < VEDIC_POOL_MAX_CALLERS; i++) {
+        PoolDeque *slot = &deques[VEDIC_POOL_MAX_THREADS + i];
+        int expected = 0;
+        if (POOL_LOAD(&slot->in_use, __ATOMIC_RELAXED) == 0 &&
+            POOL_CAS(&slot->in_use, &expected, 1)) {
+            int high = POOL_LOAD(&caller_high, __ATOMIC_ACQUIRE);
+            while (high < i + 1 && !POOL_CAS(&caller_high, &high, i + 1)) {
+            }
+            current_deque = slot;
+            pthread_setspecific(caller_key, slot);
+            return slot;
+        }
+    }
+    return NULL;                     // More concurrent callers than slots
+}
+
+void vedic_pool_parallel_for(size_t count, size_t grain, VedicPoolRangeFn fn, void *context) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    PoolDeque *self = NULL;
+    if (count <= grain || pool_start() == 0 || (self = calling_deque()) == NULL) {
+        POOL_ADD(&stat_serial_calls, 1);
+        fn(0, count, context);
+        return;
+    }
+    POOL_ADD(&stat_parallel_calls, 1);
+
+    // Coarsen the grain so the split tree has at most POOL_MAX_RANGES leaves
+    size_t minimum = (count + POOL_MAX_RANGES / 2 - 1) / (POOL_MAX_RANGES / 2);
+    PoolJob job;
+    job.fn = fn;
+    job.context = context;
+    job.grain = grain > minimum ? grain : minimum;
+    job.remaining = count;
+
+    // Split across nodes: part k is [count * k / nodes, count * (k + 1) / nodes),
+    // so the parts depend on nothing but count (see vedic_pool_first_touch)
+    int nodes = count >= (size_t)pool_nodes ? pool_nodes : 1;
+    int home = 0;
+    if (nodes > 1) {
+        // A nested call from a worker keeps the worker's node
+        if (self < &deques[VEDIC_POOL_MAX_THREADS]) {
+            home = self->node;
+        } else {
+            self->node = home = caller_node();
+        }
+    }
+    job.next_range = (size_t)nodes;
+    for (int node = 0; node < nodes; node++) {
+        PoolRange *part = &job.ranges[node];
+        part->job = &job;
+        part->begin = count * (size_t)node / (size_t)nodes;
+        part->end = count * (size_t)(node + 1) / (size_t)nodes;
+        if (node != home) inbox_put(node, part);
+    }
+    if (nodes > 1) {
+        POOL_ADD(&stat_node_splits, 1);
+        wake_workers();
+    }
+
+    execute_range(self, &job.ranges[home]);
+
+    // Help with any pending range, ours or another call's, until ours is done
+    while (POOL_LOAD(&job.remaining, __ATOMIC_ACQUIRE) > 0) {
+        PoolRange *range = find_work(self, 1);
+        if (range) {
+            execute_range(self, range);
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+int vedic_pool_post(VedicPoolTask *task) {
+    if (pool_start() == 0) return -1;
+
+    task->next = NULL;
+    pthread_mutex_lock(&posted_lock);
+    if (posted_tail) {
+        posted_tail->next = task;
+    } else {
+        posted_head = task;
+    }
+    posted_tail = task;
+    POOL_STORE(&posted_count, posted_count + 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&posted_lock);
+    wake_workers();
+    return 0;
+}
+
+int vedic_pool_unpost(VedicPoolTask *task) {
+    int removed = 0;
+    pthread_mutex_lock(&posted_lock);
+    VedicPoolTask *previous = NULL;
+    for (VedicPoolTask *entry = posted_head; entry; previous = entry, entry = entry->next) {
+        if (entry != task) continue;
+        if (previous) {
+            previous->next = entry->next;
+        } else {
+            posted_head = entry->next;
+        }
+        if (posted_tail == entry) posted_tail = previous;
+        POOL_STORE(&posted_count, posted_count - 1, __ATOMIC_RELEASE);
+        removed = 1;
+        break;
+    }
+    pthread_mutex_unlock(&posted_lock);
+    return removed;
+}
+
+void vedic_pool_shutdown(void) {
+    pthread_mutex_lock(&start_lock);
+    if (started) {
+        pthread_mutex_lock(&sleep_lock);
+        POOL_STORE(&stopping, 1, __ATOMIC_RELEASE);
+        pthread_cond_broadcast(&wake_cond);
+        pthread_mutex_unlock(&sleep_lock);
+
+        int count = POOL_LOAD(&worker_count, __ATOMIC_ACQUIRE);
+        for (int i = 0; i < count; i++) {
+            pthread_join(workers[i], NULL);
+        }
+        POOL_STORE(&worker_count, 0, __ATOMIC_RELEASE);
+        POOL_STORE(&started, 0, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&start_lock);
+}
+
+int vedic_pool_thread_count(void) {
+    if (POOL_LOAD(&started, __ATOMIC_ACQUIRE)) {
+        return POOL_LOAD(&worker_count, __ATOMIC_ACQUIRE);
+    }
+    return pool_config.threads > 0 ? pool_config.threads : default_thread_count();
+}
+
+VedicPoolStats vedic_pool_get_stats(void) {
+    VedicPoolStats stats;
+    stats.parallel_calls = POOL_LOAD(&stat_parallel_calls, __ATOMIC_RELAXED);
+    stats.serial_calls = POOL_LOAD(&stat_serial_calls, __ATOMIC_RELAXED);
+    stats.ranges_executed = POOL_LOAD(&stat_ranges, __ATOMIC_RELAXED);
+    stats.steals = POOL_LOAD(&stat_steals, __ATOMIC_RELAXED);
+    stats.node_splits = POOL_LOAD(&stat_node_splits, __ATOMIC_RELAXED);
+    return stats;
+}
+
+#else
+
+void vedic_pool_parallel_for(size_t count, size_t grain, VedicPoolRangeFn fn, void *context) {
+    (void)grain;
+    if (count == 0) return;
+    stat_serial_calls++;
+    fn(0, count, context);
+}
+
+int vedic_pool_post(VedicPoolTask *task) {
+    (void)task;
+    return -1;
+}
+
+int vedic_pool_unpost(VedicPoolTask *task) {
+    (void)task;
+    return 0;
+}
+
+void vedic_pool_shutdown(void) {
+}
+
+int vedic_pool_thread_count(void) {
+    return 0;
+}
+
+VedicPoolStats vedic_pool_get_stats(void) {
+    VedicPoolStats stats = {stat_parallel_calls, stat_serial_calls, stat_ranges, stat_steals, stat_node_splits};
+    return stats;
+}
+
+#endif
+
+/**
+ * Whether a caller-supplied topology can be used as is
+ */
+static int topology_valid(const VedicPoolTopology *topology) {
+    if (topology->node_count < 1 || topology->node_count > VEDIC_POOL_MAX_NODES) return 0;
+    for (int node = 0; node < topology->node_count; node++) {
+        if (topology->cpu_count[node] < 0 || topology->cpu_count[node] > VEDIC_POOL_MAX_NODE_CPUS) return 0;
+    }
+    return 1;
+}
+
+typedef struct {
+    char *buffer;
+    size_t element_size;
+} TouchJob;
+
+static void first_touch_range(size_t begin, size_t end, void *context) {
+    TouchJob *job = (TouchJob *)context;
+    memset(job->buffer + begin * job->element_size, 0, (end - begin) * job->element_size);
+}
+
+void vedic_pool_first_touch(void *buffer, size_t count, size_t element_size) {
+    if (!buffer || count == 0 || element_size == 0) return;
+    TouchJob job = {(char *)buffer, element_size};
+    size_t grain = POOL_TOUCH_GRAIN_BYTES / element_size;
+    vedic_pool_parallel_for(count, grain, first_touch_range, &job);
+}
+
+int vedic_pool_node_count(void) {
+    return pool_nodes;
+}
+
+int vedic_pool_configure(const VedicPoolConfig *config) {
+    if (config && (config->threads < 0 || config->threads > VEDIC_POOL_MAX_THREADS ||
+                   config->cpu_count < 0 || (config->cpu_count > 0 && !config->cpus) ||
+                   (config->numa && config->cpu_count > 0) ||
+                   (config->numa && config->topology && !topology_valid(config->topology)))) {
+        return -1;
+    }
+
+    vedic_pool_shutdown();
+    memset(&pool_config, 0, sizeof(pool_config));
+    memset(cpu_nodes, -1, sizeof(cpu_nodes));
+    pool_nodes = 1;
+    if (config && config->numa) {
+        if (config->topology) {
+            pool_topology = *config->topology;
+        } else {
+            vedic_pool_discover_topology(&pool_topology);
+        }
+        pool_nodes = pool_topology.node_count;
+        for (int node = pool_nodes - 1; node >= 0; node--) {
+            for (int i = 0; i < pool_topology.cpu_count[node]; i++) {
+                int cpu = pool_topology.cpus[node][i];
+                if (cpu >= 0 && cpu < POOL_CPU_TABLE) cpu_nodes[cpu] = (signed char)node;
+            }
+        }
+        pool_config.numa = 1;
+        pool_config.topology = &pool_topology;
+    }
+    if (config) {
+        pool_config.threads = config->threads;
+        pool_config.cpu_count = config->cpu_count < VEDIC_POOL_MAX_THREADS ? config->cpu_count
+                                                                           : VEDIC_POOL_MAX_THREADS;
+        for (int i = 0; i < pool_config.cpu_count; i++) {
+            pool_cpus[i] = config->cpus[i];
+        }
+        pool_config.cpus = pool_config.cpu_count > 0 ? pool_cpus : NULL;
+    }
+    return 0;
+}
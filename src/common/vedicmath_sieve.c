@@ -0,0 +1,527 @@
+/**
+ * vedicmath_sieve.c - Segmented prime sieve and batch factorization
+ */
+#include "vedicmath_sieve.h"
+#include "vedicmath.h"
+#include "vedicmath_alloc.h"
+#include "vedicmath_pool.h"
+#include <math.h>
+#include <string.h>
+
+#define SIEVE_SEGMENT_BYTES 32768        // 983,040 numbers per segment; fits L1
+#define SIEVE_GRAIN 4                    // Segments per pool range, to repay finding the first multiples
+#define SIEVE_PRIMES_PER_SEGMENT 65536   // Sieving primes one segment repays the set-up of
+#define SIEVE_PAGE 512                   // Primes copied out of a sieve at a time
+#define SIEVE_PRIME_WINDOW (30ull << 18) // Sieving primes generated and applied per pass
+#define FACTOR_SCREEN_PRIMES 128         // 2 .. 719, screened in two groups of 64
+#define FACTOR_SCREEN_LIMIT 720          // Cofactors below 720^2 are prime
+#define FACTOR_BLOCK 256                 // Numbers per screen
+
+// Out-of-memory flag raised by pool ranges, read after the call
+#if defined(__GNUC__) || defined(__clang__)
+#define SIEVE_FLAG_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define SIEVE_FLAG_SET(ptr) __atomic_store_n(ptr, 1, __ATOMIC_RELEASE)
+#define SIEVE_POPCOUNT(x) __builtin_popcount(x)
+#define SIEVE_CTZ(x) __builtin_ctz(x)
+#define SIEVE_CTZ64(x) __builtin_ctzll(x)
+#else
+#define SIEVE_FLAG_LOAD(ptr) (*(volatile int *)(ptr))
+#define SIEVE_FLAG_SET(ptr) (*(volatile int *)(ptr) = 1)
+#define SIEVE_POPCOUNT(x) sieve_popcount(x)
+#define SIEVE_CTZ(x) sieve_ctz64(x)
+#define SIEVE_CTZ64(x) sieve_ctz64(x)
+
+static int sieve_popcount(unsigned x) {
+    int count = 0;
+    for (; x; x &= x - 1) count++;
+    return count;
+}
+
+static int sieve_ctz64(uint64_t x) {
+    int count = 0;
+    for (; !(x & 1); x >>= 1) count++;
+    return count;
+}
+#endif
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 FactorWide;
+#endif
+
+// Residues coprime to 30, one per bit, the gap to the next one, and the bit of each residue
+static const uint8_t wheel_residues[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+static const uint8_t wheel_gaps[8] = {6, 4, 2, 4, 2, 4, 6, 2};
+static const int8_t wheel_bit[30] = {
+    -1, 0, -1, -1, -1, -1, -1, 1, -1, -1, -1, 2, -1, 3, -1,
+    -1, -1, 4, -1, 5, -1, -1, -1, 6, -1, -1, -1, -1, -1, 7
+};
+
+// ============================================================================
+// SEGMENTED SIEVE
+// ============================================================================
+
+typedef struct {
+    VedicSieve *sieve;
+    const uint32_t *primes;              // One window of sieving primes up to sqrt(high - 1), ascending
+    size_t prime_count;
+    size_t small_count;                  // Primes below SIEVE_SEGMENT_BYTES
+    int clear;                           // First pass: set every bit before striking
+    int failed;
+} SieveJob;
+
+static uint64_t isqrt_u64(uint64_t n) {
+    uint64_t root = (uint64_t)sqrt((double)n);
+    while (root * root > n) root--;
+    while ((root + 1) * (root + 1) <= n) root++;
+    return root;
+}
+
+/**
+ * First multiple of p in each wheel residue class, from p^2 and from start
+ *
+ * p * q falls in residue class k when q = residue_k * p^-1 (mod 30). The
+ * offsets are in bytes from start, which is a multiple of 30; consecutive
+ * multiples in one class are 30p apart, which is p bytes.
+ */
+static void sieve_first_multiples(uint32_t *offsets, uint32_t p, uint64_t start) {
+    uint32_t inverse = 1;
+    while (p % 30 * inverse % 30 != 1) inverse++;
+
+    uint64_t first_q = (start + p - 1) / p;
+    if (first_q < p) first_q = p;
+    uint32_t first_residue = (uint32_t)(first_q % 30);
+    for (int k = 0; k < 8; k++) {
+        uint32_t q_residue = wheel_residues[k] * inverse % 30;
+        uint64_t q = first_q + (q_residue + 30 - first_residue) % 30;
+        offsets[k] = (uint32_t)(((uint64_t)p * q - start) / 30);
+    }
+}
+
+/**
+ * First cofactor q >= p of a large prime p with p * q >= start, coprime to 30
+ */
+static uint64_t sieve_first_cofactor(uint32_t p, uint64_t start) {
+    uint64_t q = (start + p - 1) / p;
+    if (q < p) q = p;
+    while (wheel_bit[q % 30] < 0) q++;
+    return q;
+}
+
+/**
+ * Sieve segments [begin, end); the next multiples carry over between them
+ *
+ * A small prime strikes each segment many times in each residue class, so
+ * it keeps one offset per class and strides p bytes. A prime larger than a
+ * segment strikes it a few times at most, so it keeps only its next
+ * cofactor q and walks q over the wheel, one multiple at a time. A range of
+ * one segment has nothing to carry, so it finds a large prime's cofactor
+ * when it strikes it and keeps no array for them; otherwise the array holds
+ * only the primes whose square lies before the range's end.
+ */
+static void sieve_segments(size_t begin, size_t end, void *context) {
+    SieveJob *job = (SieveJob *)context;
+    VedicSieve *sieve = job->sieve;
+    size_t small_count = job->small_count;
+    size_t last_byte = end * SIEVE_SEGMENT_BYTES < sieve->bytes ? end * SIEVE_SEGMENT_BYTES : sieve->bytes;
+    uint64_t range_stop = sieve->base + 30 * (uint64_t)last_byte;
+    int carry = end - begin > 1;
+
+    // Primes that become active somewhere in this range
+    size_t lower = 0, upper = job->prime_count;
+    while (lower < upper) {
+        size_t middle = lower + (upper - lower) / 2;
+        if ((uint64_t)job->primes[middle] * job->primes[middle] < range_stop) {
+            lower = middle + 1;
+        } else {
+            upper = middle;
+        }
+    }
+    size_t range_count = lower;
+    size_t range_small = range_count < small_count ? range_count : small_count;
+    size_t range_large = carry ? range_count - range_small : 0;
+
+    uint32_t *offsets = NULL;            // Small primes: 8 each, in bytes from the current segment
+    uint64_t *cofactors = NULL;          // Large primes: next q, coprime to 30
+    size_t active = 0;                   // Primes whose square lies before the current segment's end
+    if (range_small + range_large > 0) {
+        cofactors = (uint64_t *)VEDIC_MALLOC(range_large * sizeof(uint64_t) + range_small * 8 * sizeof(uint32_t));
+        if (!cofactors) {
+            SIEVE_FLAG_SET(&job->failed);
+            return;
+        }
+        offsets = (uint32_t *)(cofactors + range_large);
+    }
+
+    for (size_t segment = begin; segment < end; segment++) {
+        size_t first = segment * SIEVE_SEGMENT_BYTES;
+        size_t size = sieve->bytes - first < SIEVE_SEGMENT_BYTES ? sieve->bytes - first : SIEVE_SEGMENT_BYTES;
+        uint8_t *bits = sieve->bits + first;
+        uint64_t start = sieve->base + 30 * (uint64_t)first;
+        uint64_t stop = start + 30 * (uint64_t)size;
+        if (job->clear) memset(bits, 0xff, size);
+
+        while (active < range_count && (uint64_t)job->primes[active] * job->primes[active] < stop) {
+            uint32_t p = job->primes[active];
+            if (active < small_count) {
+                sieve_first_multiples(offsets + 8 * active, p, start);
+            } else if (carry) {
+                cofactors[active - small_count] = sieve_first_cofactor(p, start);
+            }
+            active++;
+        }
+
+        for (size_t i = 0; i < active && i < small_count; i++) {
+            uint32_t p = job->primes[i];
+            uint32_t *next = offsets + 8 * i;
+            for (int k = 0; k < 8; k++) {
+                uint8_t mask = (uint8_t)~(1u << k);
+                uint32_t j = next[k];
+                for (; j < size; j += p) {
+                    bits[j] &= mask;
+                }
+                next[k] = j - (uint32_t)size;
+            }
+        }
+        for (size_t i = small_count; i < active; i++) {
+            uint64_t p = job->primes[i];
+            uint64_t q = carry ? cofactors[i - small_count] : sieve_first_cofactor((uint32_t)p, start);
+            for (uint64_t m = p * q; m < stop; m = p * q) {
+                uint64_t offset = m - start;
+                bits[offset / 30] &= (uint8_t)~(1u << wheel_bit[offset % 30]);
+                q += wheel_gaps[wheel_bit[q % 30]];
+            }
+            if (carry) cofactors[i - small_count] = q;
+        }
+    }
+    VEDIC_FREE(cofactors);
+}
+
+/**
+ * Sieving primes in [low, high), from a sieve of that window
+ *
+ * @return 0, or -1 if memory runs out
+ */
+static int sieve_window_primes(uint64_t low, uint64_t high, uint32_t **primes, size_t *count) {
+    VedicSieve window;
+    if (vedic_sieve_init(&window, low, high) != 0) return -1;
+    *count = vedic_sieve_count(&window);
+    *primes = (uint32_t *)VEDIC_MALLOC(*count * sizeof(uint32_t) + 1);
+    if (!*primes) {
+        vedic_sieve_free(&window);
+        return -1;
+    }
+    uint64_t page[SIEVE_PAGE];
+    size_t listed = 0, got;
+    while ((got = vedic_sieve_primes(&window, listed ? (*primes)[listed - 1] + 1 : 0, page, SIEVE_PAGE)) > 0) {
+        for (size_t i = 0; i < got; i++) (*primes)[listed + i] = (uint32_t)page[i];
+        listed += got;
+    }
+    vedic_sieve_free(&window);
+    return 0;
+}
+
+/**
+ * Sieve [low, high) on the pool
+ */
+int vedic_sieve_init(VedicSieve *sieve, uint64_t low, uint64_t high) {
+    memset(sieve, 0, sizeof(*sieve));
+    if (low > high || high > VEDIC_SIEVE_MAX_HIGH) return -1;
+    sieve->low = low;
+    sieve->high = high;
+    sieve->base = low - low % 30;
+    sieve->bytes = (size_t)((high - sieve->base + 29) / 30);
+    if (sieve->bytes == 0) return 0;
+    sieve->bits = (uint8_t *)VEDIC_MALLOC(sieve->bytes);
+    if (!sieve->bits) return -1;
+
+    // Sieving primes 7 .. sqrt(high - 1), one window of them per pass over the
+    // range, so their memory stays bounded however large high is
+    SieveJob job = {sieve, NULL, 0, 0, 1, 0};
+    uint64_t limit = isqrt_u64(high - 1);
+    uint64_t window = 7;
+    size_t segments = (sieve->bytes + SIEVE_SEGMENT_BYTES - 1) / SIEVE_SEGMENT_BYTES;
+    do {
+        uint32_t *primes = NULL;
+        job.prime_count = job.small_count = 0;
+        if (window <= limit) {
+            uint64_t window_end = limit + 1 - window > SIEVE_PRIME_WINDOW ? window + SIEVE_PRIME_WINDOW : limit + 1;
+            if (sieve_window_primes(window, window_end, &primes, &job.prime_count) != 0) {
+                vedic_sieve_free(sieve);
+                return -1;
+            }
+            window = window_end;
+        }
+        job.primes = primes;
+        while (job.small_count < job.prime_count && primes[job.small_count] < SIEVE_SEGMENT_BYTES) {
+            job.small_count++;
+        }
+
+        size_t grain = job.prime_count / SIEVE_PRIMES_PER_SEGMENT;
+        vedic_pool_parallel_for(segments, grain > SIEVE_GRAIN ? grain : SIEVE_GRAIN, sieve_segments, &job);
+        VEDIC_FREE(primes);
+        job.clear = 0;
+        if (SIEVE_FLAG_LOAD(&job.failed)) {
+            vedic_sieve_free(sieve);
+            return -1;
+        }
+    } while (window <= limit);
+
+    // The first and last bytes reach outside [low, high); 1 is not prime
+    size_t edges[2] = {0, sieve->bytes - 1};
+    for (int e = 0; e < 2; e++) {
+        uint64_t byte_base = sieve->base + 30 * (uint64_t)edges[e];
+        for (int k = 0; k < 8; k++) {
+            uint64_t n = byte_base + wheel_residues[k];
+            if (n < low || n >= high || n == 1) {
+                sieve->bits[edges[e]] &= (uint8_t)~(1u << k);
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Release a sieve
+ */
+void vedic_sieve_free(VedicSieve *sieve) {
+    VEDIC_FREE(sieve->bits);
+    sieve->bits = NULL;
+    sieve->bytes = 0;
+}
+
+/**
+ * Whether n is prime, -1 outside the range
+ */
+int vedic_sieve_is_prime(const VedicSieve *sieve, uint64_t n) {
+    if (n < sieve->low || n >= sieve->high) return -1;
+    if (n == 2 || n == 3 || n == 5) return 1;
+    int k = wheel_bit[n % 30];
+    if (k < 0) return 0;
+    return (sieve->bits[(n - sieve->base) / 30] >> k) & 1;
+}
+
+/**
+ * Number of primes in the range
+ */
+size_t vedic_sieve_count(const VedicSieve *sieve) {
+    size_t count = 0;
+    for (uint64_t p = 2; p <= 5; p += p == 2 ? 1 : 2) {
+        count += p >= sieve->low && p < sieve->high;
+    }
+    for (size_t i = 0; i < sieve->bytes; i++) {
+        count += (size_t)SIEVE_POPCOUNT(sieve->bits[i]);
+    }
+    return count;
+}
+
+/**
+ * Primes in order from the first at or after from
+ */
+size_t vedic_sieve_primes(const VedicSieve *sieve, uint64_t from, uint64_t *primes, size_t capacity) {
+    size_t written = 0;
+    if (from < sieve->low) from = sieve->low;
+    for (uint64_t p = 2; p <= 5 && written < capacity; p += p == 2 ? 1 : 2) {
+        if (p >= from && p < sieve->high) primes[written++] = p;
+    }
+    if (from >= sieve->high) return written;
+
+    for (size_t i = (size_t)((from - sieve->base) / 30); i < sieve->bytes && written < capacity; i++) {
+        unsigned bits = sieve->bits[i];
+        uint64_t byte_base = sieve->base + 30 * (uint64_t)i;
+        while (bits && written < capacity) {
+            uint64_t n = byte_base + wheel_residues[SIEVE_CTZ(bits)];
+            bits &= bits - 1;
+            if (n >= from) primes[written++] = n;
+        }
+    }
+    return written;
+}
+
+// ============================================================================
+// FACTORIZATION
+// ============================================================================
+
+static uint64_t mul_mod(uint64_t a, uint64_t b, uint64_t m) {
+#if defined(__SIZEOF_INT128__)
+    return (uint64_t)((FactorWide)a * b % m);
+#else
+    // Double and add, never exceeding m
+    uint64_t result = 0;
+    a %= m;
+    for (; b; b >>= 1) {
+        if (b & 1) result = result >= m - a ? result - (m - a) : result + a;
+        a = a >= m - a ? a - (m - a) : a + a;
+    }
+    return result;
+#endif
+}
+
+static uint64_t pow_mod(uint64_t base, uint64_t exponent, uint64_t m) {
+    uint64_t result = 1;
+    for (base %= m; exponent; exponent >>= 1) {
+        if (exponent & 1) result = mul_mod(result, base, m);
+        base = mul_mod(base, base, m);
+    }
+    return result;
+}
+
+static uint64_t gcd_u64(uint64_t a, uint64_t b) {
+    while (b) {
+        uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+ * Whether n is prime (Miller-Rabin with bases that decide every 64-bit n)
+ */
+int vedic_is_prime_u64(uint64_t n) {
+    static const uint64_t small[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    static const uint64_t bases[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+    if (n < 2) return 0;
+    for (size_t i = 0; i < sizeof(small) / sizeof(small[0]); i++) {
+        if (n % small[i] == 0) return n == small[i];
+    }
+    if (n < 37 * 37) return 1;
+
+    uint64_t d = n - 1;
+    int s = SIEVE_CTZ64(d);
+    d >>= s;
+    for (size_t i = 0; i < sizeof(bases) / sizeof(bases[0]); i++) {
+        uint64_t a = bases[i] % n;
+        if (a == 0) continue;
+        uint64_t x = pow_mod(a, d, n);
+        if (x == 1 || x == n - 1) continue;
+        int witness = 1;
+        for (int r = 1; r < s && witness; r++) {
+            x = mul_mod(x, x, n);
+            witness = x != n - 1;
+        }
+        if (witness) return 0;
+    }
+    return 1;
+}
+
+/**
+ * A nontrivial factor of an odd composite n (Pollard-rho, Brent's cycle search)
+ */
+static uint64_t rho_factor(uint64_t n) {
+    for (uint64_t c = 1; ; c++) {
+        uint64_t x = 2, y = 2, saved = 2, product = 1, divisor = 1;
+        for (uint64_t length = 1; divisor == 1; length *= 2) {
+            x = y;
+            for (uint64_t i = 0; i < length; i++) y = (mul_mod(y, y, n) + c) % n;
+            // Batch the differences into one gcd per 128 steps
+            for (uint64_t k = 0; k < length && divisor == 1; k += 128) {
+                saved = y;
+                for (uint64_t i = 0; i < 128 && i < length - k; i++) {
+                    y = (mul_mod(y, y, n) + c) % n;
+                    product = mul_mod(product, x > y ? x - y : y - x, n);
+                }
+                divisor = gcd_u64(product, n);
+            }
+        }
+        if (divisor == n) {
+            // The batch overshot: step again one difference at a time
+            do {
+                saved = (mul_mod(saved, saved, n) + c) % n;
+                divisor = gcd_u64(x > saved ? x - saved : saved - x, n);
+            } while (divisor == 1);
+        }
+        if (divisor != n) return divisor;
+    }
+}
+
+static void factor_add(VedicFactorization *factors, uint64_t p) {
+    int i = 0;
+    while (i < factors->count && factors->primes[i] < p) i++;
+    if (i < factors->count && factors->primes[i] == p) {
+        factors->exponents[i]++;
+        return;
+    }
+    for (int j = factors->count; j > i; j--) {
+        factors->primes[j] = factors->primes[j - 1];
+        factors->exponents[j] = factors->exponents[j - 1];
+    }
+    factors->primes[i] = p;
+    factors->exponents[i] = 1;
+    factors->count++;
+}
+
+/**
+ * Factor a cofactor with no prime factor below FACTOR_SCREEN_LIMIT
+ */
+static void factor_cofactor(VedicFactorization *factors, uint64_t n) {
+    uint64_t pending[64];                // At most 63 prime factors
+    int depth = 0;
+    pending[depth++] = n;
+    while (depth > 0) {
+        uint64_t m = pending[--depth];
+        if (m < (uint64_t)FACTOR_SCREEN_LIMIT * FACTOR_SCREEN_LIMIT || vedic_is_prime_u64(m)) {
+            factor_add(factors, m);
+            continue;
+        }
+        uint64_t divisor = rho_factor(m);
+        pending[depth++] = divisor;
+        pending[depth++] = m / divisor;
+    }
+}
+
+typedef struct {
+    const int64_t *numbers;
+    VedicFactorization *factors;
+    int primes[FACTOR_SCREEN_PRIMES];
+} FactorJob;
+
+static void factor_range(size_t begin, size_t end, void *context) {
+    FactorJob *job = (FactorJob *)context;
+    uint64_t masks[2][FACTOR_BLOCK];
+    for (size_t start = begin; start < end; start += FACTOR_BLOCK) {
+        size_t size = end - start < FACTOR_BLOCK ? end - start : FACTOR_BLOCK;
+        const int64_t *numbers = job->numbers + start;
+        vestanam_screen_batch(numbers, size, job->primes, 64, masks[0], 0);
+        vestanam_screen_batch(numbers, size, job->primes + 64, 64, masks[1], 0);
+
+        for (size_t i = 0; i < size; i++) {
+            VedicFactorization *factors = &job->factors[start + i];
+            uint64_t n = numbers[i] < 0 ? 0 - (uint64_t)numbers[i] : (uint64_t)numbers[i];
+            factors->count = 0;
+            if (n < 2) continue;
+
+            // Divide only by the small primes the screen found
+            for (int half = 0; half < 2; half++) {
+                for (uint64_t mask = masks[half][i]; mask; mask &= mask - 1) {
+                    uint64_t p = (uint64_t)job->primes[64 * half + SIEVE_CTZ64(mask)];
+                    int exponent = 0;
+                    do {
+                        n /= p;
+                        exponent++;
+                    } while (n % p == 0);
+                    factors->primes[factors->count] = p;
+                    factors->exponents[factors->count++] = (uint8_t)exponent;
+                }
+            }
+            if (n > 1) factor_cofactor(factors, n);
+        }
+    }
+}
+
+/**
+ * Factor numbers on the pool
+ */
+int vedic_factor_batch(const int64_t *numbers, size_t count, VedicFactorization *factors) {
+    FactorJob job;
+    VedicSieve small;
+    uint64_t primes[FACTOR_SCREEN_PRIMES];
+    if (vedic_sieve_init(&small, 0, FACTOR_SCREEN_LIMIT) != 0) return -1;
+    vedic_sieve_primes(&small, 0, primes, FACTOR_SCREEN_PRIMES);
+    vedic_sieve_free(&small);
+
+    job.numbers = numbers;
+    job.factors = factors;
+    for (int i = 0; i < FACTOR_SCREEN_PRIMES; i++) job.primes[i] = (int)primes[i];
+    vedic_pool_parallel_for(count, FACTOR_BLOCK, factor_range, &job);
+    return 0;
+}
@@ -51,4 +51,33 @@
      }
      
      return left_part * multiplier + right_part;
+ }
+ 
+ /**
+  * Antyayordasake over arrays - branch-free, for the vectorizer
+  * 
+  * The last digits sum to 10, so their product is at most 25 and always
+  * takes exactly two places: each eligible lane is prefix * (prefix + 1) * 100
+  * plus that product, with no digit count. Lanes that do not qualify
+  * (different prefixes or last digits, negative or wider than 32 bits) take
+  * the plain product a * b.
+  * 
+  * @param a First operands
+  * @param b Second operands
+  * @param products Output; may be a or b itself
+  * @param count Number of pairs
+  */
+ void antya_dasake_mul_batch(const int64_t *a, const int64_t *b, int64_t *products, size_t count) {
+     for (size_t i = 0; i < count; i++) {
+         uint32_t low_a = (uint32_t)a[i];
+         uint32_t low_b = (uint32_t)b[i];
+         uint32_t prefix_a = low_a / 10;
+         uint32_t prefix_b = low_b / 10;
+         uint32_t last_a = low_a - prefix_a * 10;
+         uint32_t last_b = low_b - prefix_b * 10;
+         uint64_t vedic = (uint64_t)prefix_a * (prefix_a + 1) * 100 + last_a * last_b;
+         int eligible = last_a + last_b == 10 && prefix_a == prefix_b &&
+                        (uint64_t)a[i] <= UINT32_MAX && (uint64_t)b[i] <= UINT32_MAX;
+         products[i] = eligible ? (int64_t)vedic : (int64_t)((uint64_t)a[i] * (uint64_t)b[i]);
+     }
  }
\ No newline at end of file
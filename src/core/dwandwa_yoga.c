@@ -0,0 +1,119 @@
+/**
+ * dwandwa_yoga.c - Implementation of the Dwandwa-yoga (duplex) squaring method
+ *
+ * Squaring is multiplication with both operands equal, so every crosswise
+ * product of Urdhva-Tiryagbhyam appears twice. The duplex of a column forms
+ * each of those products once and doubles it, which needs about half the
+ * digit products of a general multiplication.
+ */
+
+ #include "vedicmath.h"
+ #include <string.h>
+
+ #define DWANDWA_RADIX 10000UL      // Four decimal digits per column
+ #define DWANDWA_MAX_GROUPS 5       // 20 digits covers any 64-bit magnitude
+
+ /**
+  * Dwandwa-yoga - "Duplex combination"
+  *
+  * Purpose: Squaring of any number, without allocation.
+  * When to use: For squares that fit no special pattern (ending in 5, near a base).
+  *
+  * Core logic: Split n into digit groups g[0..k]. Column c of the square is
+  * the duplex D(c): twice the sum of g[i] * g[c - i] over i < c - i, plus
+  * g[c / 2]^2 when c is even. The columns are weighted by the radix as they
+  * are summed, so no carries are propagated.
+  *
+  * Example (single digits): 123^2: D(1)=1, D(12)=4, D(123)=10, D(23)=12, D(3)=9
+  *          => 1|4|10|12|9 = 15129
+  *
+  * Results that overflow a long wrap exactly as n * n does.
+  *
+  * @param n Number to square
+  * @return The square of n
+  */
+ long dwandwa_square(long n) {
+     unsigned long magnitude = n < 0 ? 0UL - (unsigned long)n : (unsigned long)n;
+     if (magnitude < DWANDWA_RADIX) {
+         return (long)(magnitude * magnitude);
+     }
+
+     // Digit groups, least significant first
+     unsigned long groups[DWANDWA_MAX_GROUPS];
+     int count = 0;
+     while (magnitude > 0) {
+         groups[count++] = magnitude % DWANDWA_RADIX;
+         magnitude /= DWANDWA_RADIX;
+     }
+
+     unsigned long square = 0;
+     unsigned long weight = 1;
+     for (int column = 0; column <= 2 * (count - 1); column++) {
+         int low = column < count ? 0 : column - count + 1;
+         int high = column - low;
+
+         // Crosswise pairs once, doubled; then the vertical square of the middle group
+         unsigned long duplex = 0;
+         while (low < high) {
+             duplex += groups[low++] * groups[high--];
+         }
+         duplex *= 2;
+         if (low == high) {
+             duplex += groups[low] * groups[low];
+         }
+
+         square += duplex * weight;
+         weight *= DWANDWA_RADIX;
+     }
+
+     return (long)square;
+ }
+
+ /**
+  * Dwandwa-yoga for multi-limb integers
+  *
+  * Purpose: Squaring of unsigned integers wider than a machine word.
+  *
+  * Core logic: The crosswise products limbs[i] * limbs[j] (i < j) are
+  * accumulated once, row by row, the whole triangle is doubled with a single
+  * shift, and the vertical squares limbs[i]^2 are added on the diagonal:
+  * n(n-1)/2 + n limb products instead of n^2.
+  *
+  * @param square Output, 2 * count limbs, least significant first; must not
+  *               overlap limbs
+  * @param limbs Input, count limbs, least significant first
+  * @param count Number of input limbs
+  */
+ void dwandwa_square_limbs(uint32_t *square, const uint32_t *limbs, size_t count) {
+     if (count == 0) return;
+     memset(square, 0, 2 * count * sizeof(uint32_t));
+
+     // Crosswise triangle
+     for (size_t i = 0; i + 1 < count; i++) {
+         uint64_t carry = 0;
+         for (size_t j = i + 1; j < count; j++) {
+             uint64_t t = (uint64_t)limbs[i] * limbs[j] + square[i + j] + carry;
+             square[i + j] = (uint32_t)t;
+             carry = t >> 32;
+         }
+         square[i + count] = (uint32_t)carry;
+     }
+
+     // Double it
+     uint32_t top = 0;
+     for (size_t k = 0; k < 2 * count; k++) {
+         uint32_t next = square[k] >> 31;
+         square[k] = (square[k] << 1) | top;
+         top = next;
+     }
+
+     // Vertical squares on the diagonal
+     uint64_t carry = 0;
+     for (size_t i = 0; i < count; i++) {
+         uint64_t t = (uint64_t)limbs[i] * limbs[i] + square[2 * i] + carry;
+         square[2 * i] = (uint32_t)t;
+         t = (uint64_t)square[2 * i + 1] + (t >> 32);
+         square[2 * i + 1] = (uint32_t)t;
+         carry = t >> 32;
+     }
+ }
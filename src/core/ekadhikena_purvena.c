@@ -37,6 +37,31 @@
      return left_part * 100 + right_part;
  }
  
+ /**
+  * Ekadhikena Purvena over an array - branch-free, for the vectorizer
+  * 
+  * Each lane squares its magnitude: prefix * (prefix + 1) * 100 + 25 when it
+  * ends in 5, the plain square otherwise. Digits are split in 32-bit lanes,
+  * where division by 10 vectorizes; magnitudes of 2^32 and above square
+  * outside the range of int64_t anyway and take the plain square, which
+  * wraps as n * n does.
+  * 
+  * @param n Numbers to square
+  * @param squares Output; may be n itself
+  * @param count Number of elements
+  */
+ void ekadhikena_purvena_batch(const int64_t *n, int64_t *squares, size_t count) {
+     for (size_t i = 0; i < count; i++) {
+         uint64_t magnitude = n[i] < 0 ? 0 - (uint64_t)n[i] : (uint64_t)n[i];
+         uint32_t low = (uint32_t)magnitude;
+         uint32_t prefix = low / 10;
+         uint32_t last = low - prefix * 10;
+         uint64_t vedic = (uint64_t)prefix * (prefix + 1) * 100 + 25;
+         int eligible = last == 5 && magnitude <= UINT32_MAX;
+         squares[i] = (int64_t)(eligible ? vedic : magnitude * magnitude);
+     }
+ }
+ 
  /**
   * Ekadhikena Purvena for different numbers - "By one more than the previous one"
   * 
@@ -15,7 +15,7 @@
   * @param b Second number
   * @return The best power of 10 base
   */
- static long nikhilam_best_base(long a, long b) {
+ long nikhilam_best_base(long a, long b) {
      long base_a = nearest_power_of_10(a);
      long base_b = nearest_power_of_10(b);
      
@@ -199,4 +199,30 @@
          // Type 3: One number above base, one below
          return nikhilam_mixed_base(a, b, base);
      }
- }
\ No newline at end of file
+ }
+ 
+ /**
+  * Nikhilam over a bucket of pairs sharing one base - branch-free, for the vectorizer
+  * 
+  * With signed deviations d_a = a - B and d_b = b - B, the three cases above
+  * are one formula: a * b = (a + d_b) * B + d_a * d_b. Below the base both
+  * deviations are negative and their product positive; in the mixed case
+  * the product is negative and borrows from the left part by itself. The
+  * left part is placed by one multiply with B, with no digit count, and the
+  * identity holds for every lane, so none needs a fallback.
+  * 
+  * @param a First operands
+  * @param b Second operands
+  * @param base Common working base B of the bucket (see nikhilam_best_base)
+  * @param products Output; may be a or b itself
+  * @param count Number of pairs
+  */
+ void nikhilam_mul_batch(const int64_t *a, const int64_t *b, int64_t base, int64_t *products, size_t count) {
+     uint64_t working_base = (uint64_t)base;
+     for (size_t i = 0; i < count; i++) {
+         uint64_t deviation_a = (uint64_t)a[i] - working_base;
+         uint64_t deviation_b = (uint64_t)b[i] - working_base;
+         uint64_t left_part = (uint64_t)a[i] + deviation_b;
+         products[i] = (int64_t)(left_part * working_base + deviation_a * deviation_b);
+     }
+ }
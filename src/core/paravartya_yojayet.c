@@ -6,7 +6,7 @@
  */
 
  #include "vedicmath.h"
- #include <stdlib.h>  // For malloc/free
+ #include "vedicmath_alloc.h"
  
  /**
   * Extract the leading digit of a number
@@ -22,20 +22,9 @@
  }
  
  /**
-  * Paravartya Yojayet - "Transpose and adjust"
-  * 
-  * Purpose: Division using the transpose and adjust method.
-  * When to use: For division by numbers not near a convenient base.
-  * 
-  * Core logic: If divisor is dq (d=tens digit, q=units digit), transpose q to
-  * make division easier, then adjust the remainder.
-  * 
-  * @param dividend The number to be divided
-  * @param divisor The number to divide by
-  * @param remainder Pointer to store the remainder (can be NULL if not needed)
-  * @return The quotient
+  * Digit-array implementation of paravartya_divide
   */
- long paravartya_divide(long dividend, long divisor, long *remainder) {
+ static long paravartya_divide_digits(long dividend, long divisor, long *remainder) {
      // Handle special cases
      if (divisor == 0) {
          // Division by zero - set remainder to dividend and return error
@@ -108,7 +97,7 @@
      
      // Process the division using Paravartya Yojayet
      // Extract digits of dividend
-     int *dividend_arr = (int*)malloc(dividend_digits * sizeof(int));
+     int *dividend_arr = (int*)VEDIC_MALLOC(dividend_digits * sizeof(int));
      if (!dividend_arr) {
          // Memory allocation failed, fall back to standard division
          long quot = dividend / divisor;
@@ -124,10 +113,10 @@
      
      // Result will have at most (dividend_digits - divisor_digits + 1) digits
      int quotient_digits = dividend_digits - divisor_digits + 1;
-     int *quotient_arr = (int*)calloc(quotient_digits, sizeof(int));
+     int *quotient_arr = (int*)VEDIC_CALLOC(quotient_digits, sizeof(int));
      if (!quotient_arr) {
          // Memory allocation failed, fall back to standard division
-         free(dividend_arr);
+         VEDIC_FREE(dividend_arr);
          long quot = dividend / divisor;
          if (remainder) *remainder = dividend % divisor;
          return sign * quot;
@@ -153,13 +142,6 @@
              }
              
              quotient_arr[quot_pos] = digit;
-             
-             // Apply Paravartya adjustment: transpose q to make division easier
-             // This is where the actual "transpose and adjust" happens
-             if (i < dividend_digits - 1) {
-                 partial_dividend = partial_dividend * 10 + dividend_arr[i+1];
-                 i++;  // Skip the next digit as we've consumed it
-             }
          }
      }
      
@@ -175,8 +157,29 @@
      }
      
      // Clean up
-     free(dividend_arr);
-     free(quotient_arr);
+     VEDIC_FREE(dividend_arr);
+     VEDIC_FREE(quotient_arr);
      
      return sign * quotient;
- }
\ No newline at end of file
+ }
+ 
+ /**
+  * Paravartya Yojayet - "Transpose and adjust"
+  * 
+  * Purpose: Division using the transpose and adjust method.
+  * When to use: For division by numbers not near a convenient base.
+  * 
+  * Core logic: If divisor is dq (d=tens digit, q=units digit), transpose q to
+  * make division easier, then adjust the remainder.
+  * 
+  * @param dividend The number to be divided
+  * @param divisor The number to divide by
+  * @param remainder Pointer to store the remainder (can be NULL if not needed)
+  * @return The quotient
+  */
+ long paravartya_divide(long dividend, long divisor, long *remainder) {
+     VEDIC_ALLOC_SCOPE_BEGIN("paravartya_divide");
+     long quotient = paravartya_divide_digits(dividend, divisor, remainder);
+     VEDIC_ALLOC_SCOPE_END();
+     return quotient;
+ }
@@ -6,7 +6,7 @@
  */
 
  #include "vedicmath.h"
- #include <stdlib.h>  // For malloc/free
+ #include "vedicmath_alloc.h"
  
  /**
   * Extract individual digits from a number into an array
@@ -45,19 +45,9 @@
  }
  
  /**
-  * Urdhva-Tiryagbhyam - "Vertically and crosswise"
-  * 
-  * Purpose: General multiplication method using vertical and crosswise pattern.
-  * When to use: For any multiplication when no special pattern applies.
-  * 
-  * Core logic: Every digit of the first number is multiplied with every digit 
-  * of the second in a structured way, moving from right to left.
-  * 
-  * @param a First number to multiply
-  * @param b Second number to multiply
-  * @return The product a * b
+  * Digit-array implementation of urdhva_mult
   */
- long urdhva_mult(long a, long b) {
+ static long urdhva_mult_digits(long a, long b) {
      // For simple cases, just use direct multiplication
      if (a < 10 || b < 10) {
          return a * b;
@@ -73,13 +63,13 @@
      }
      
      // Extract digits into arrays
-     int *a_digits = (int*)malloc(digits_a * sizeof(int));
-     int *b_digits = (int*)malloc(digits_b * sizeof(int));
+     int *a_digits = (int*)VEDIC_MALLOC(digits_a * sizeof(int));
+     int *b_digits = (int*)VEDIC_MALLOC(digits_b * sizeof(int));
      
      if (!a_digits || !b_digits) {
          // Handle memory allocation failure
-         if (a_digits) free(a_digits);
-         if (b_digits) free(b_digits);
+         VEDIC_FREE(a_digits);
+         VEDIC_FREE(b_digits);
          return a * b;  // Fall back to direct multiplication
      }
      
@@ -88,12 +78,12 @@
      
      // Result can have at most digits_a + digits_b digits
      int result_size = digits_a + digits_b;
-     int *result = (int*)calloc(result_size, sizeof(int));
+     int *result = (int*)VEDIC_CALLOC(result_size, sizeof(int));
      
      if (!result) {
          // Handle memory allocation failure
-         free(a_digits);
-         free(b_digits);
+         VEDIC_FREE(a_digits);
+         VEDIC_FREE(b_digits);
          return a * b;  // Fall back to direct multiplication
      }
      
@@ -133,9 +123,9 @@
      
      // Special case: if all digits are 0, return 0
      if (start_pos == result_size) {
-         free(a_digits);
-         free(b_digits);
-         free(result);
+         VEDIC_FREE(a_digits);
+         VEDIC_FREE(b_digits);
+         VEDIC_FREE(result);
          return 0;
      }
      
@@ -145,13 +135,33 @@
      }
      
      // Clean up
-     free(a_digits);
-     free(b_digits);
-     free(result);
+     VEDIC_FREE(a_digits);
+     VEDIC_FREE(b_digits);
+     VEDIC_FREE(result);
      
      return final_result;
  }
  
+ /**
+  * Urdhva-Tiryagbhyam - "Vertically and crosswise"
+  * 
+  * Purpose: General multiplication method using vertical and crosswise pattern.
+  * When to use: For any multiplication when no special pattern applies.
+  * 
+  * Core logic: Every digit of the first number is multiplied with every digit 
+  * of the second in a structured way, moving from right to left.
+  * 
+  * @param a First number to multiply
+  * @param b Second number to multiply
+  * @return The product a * b
+  */
+ long urdhva_mult(long a, long b) {
+     VEDIC_ALLOC_SCOPE_BEGIN("urdhva_mult");
+     long product = urdhva_mult_digits(a, b);
+     VEDIC_ALLOC_SCOPE_END();
+     return product;
+ }
+ 
  #ifdef _OPENMP
  // OpenMP version for large numbers
  long urdhva_mult_parallel(long a, long b) {
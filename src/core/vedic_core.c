@@ -10,6 +10,7 @@
 #include "vedicmath_types.h"
 #include "vedicmath_dynamic.h"
 #include "vedicmath_optimized.h"
+#include "vedicmath_alloc.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -33,9 +34,9 @@ static size_t log_count = 0;
 static VedicPerformanceCounters perf_counters = {0};
 
 /**
- * Initialize the Vedic core engine
+ * Implementation of vedic_core_init (see below)
  */
-VedicResult vedic_core_init(const VedicCoreConfig* config) {
+static VedicResult core_init_impl(const VedicCoreConfig* config) {
     if (config) {
         core_config = *config;
     }
@@ -43,7 +44,7 @@ VedicResult vedic_core_init(const VedicCoreConfig* config) {
     // Initialize logging system
     if (core_config.logging_enabled) {
         log_capacity = VEDIC_DEFAULT_LOG_SIZE;
-        operation_log = malloc(sizeof(VedicOperationLog) * log_capacity);
+        operation_log = VEDIC_MALLOC(sizeof(VedicOperationLog) * log_capacity);
         if (!operation_log) {
             return VEDIC_ERROR_MEMORY;
         }
@@ -62,12 +63,22 @@ VedicResult vedic_core_init(const VedicCoreConfig* config) {
     return VEDIC_SUCCESS;
 }
 
+/**
+ * Initialize the Vedic core engine
+ */
+VedicResult vedic_core_init(const VedicCoreConfig* config) {
+    VEDIC_ALLOC_SCOPE_BEGIN("vedic_core_init");
+    VedicResult result = core_init_impl(config);
+    VEDIC_ALLOC_SCOPE_END();
+    return result;
+}
+
 /**
  * Cleanup the Vedic core engine
  */
 void vedic_core_cleanup(void) {
     if (operation_log) {
-        free(operation_log);
+        VEDIC_FREE(operation_log);
         operation_log = NULL;
         log_capacity = 0;
         log_count = 0;
@@ -90,7 +101,7 @@ static void log_operation(VedicOperationType op_type, VedicValue a, VedicValue b
     // Expand log if needed
     if (log_count >= log_capacity) {
         log_capacity *= 2;
-        operation_log = realloc(operation_log, sizeof(VedicOperationLog) * log_capacity);
+        operation_log = VEDIC_REALLOC(operation_log, sizeof(VedicOperationLog) * log_capacity);
         if (!operation_log) return;
     }
     
@@ -120,9 +131,9 @@ static void log_operation(VedicOperationType op_type, VedicValue a, VedicValue b
 }
 
 /**
- * Unified multiplication interface
+ * Implementation of multiply_vedic_unified (see below)
  */
-VedicValue multiply_vedic_unified(VedicValue a, VedicValue b) {
+static VedicValue multiply_unified_impl(VedicValue a, VedicValue b) {
     clock_t start_time = clock();
     VedicValue result;
     const char* sutra_used = "Unknown";
@@ -170,6 +181,16 @@ VedicValue multiply_vedic_unified(VedicValue a, VedicValue b) {
     return result;
 }
 
+/**
+ * Unified multiplication interface
+ */
+VedicValue multiply_vedic_unified(VedicValue a, VedicValue b) {
+    VEDIC_ALLOC_SCOPE_BEGIN("multiply_vedic_unified");
+    VedicValue result = multiply_unified_impl(a, b);
+    VEDIC_ALLOC_SCOPE_END();
+    return result;
+}
+
 /**
  * Intelligent method selection for adaptive mode
  */
@@ -202,6 +223,12 @@ static VedicValue select_best_multiplication_method(VedicValue a, VedicValue b,
             return vedic_from_int32(result_int);
         }
         
+        // Squares of large numbers use the duplex form of Urdhva-Tiryagbhyam
+        if (a_long == b_long && count_digits(a_long) > 2) {
+            *sutra_used = "Dwandwa_Yoga";
+            return vedic_from_int64(dwandwa_square(a_long));
+        }
+        
         // Check for large numbers (use Urdhva-Tiryagbhyam)
         if (count_digits(a_long) > 2 || count_digits(b_long) > 2) {
             *sutra_used = "Urdhva_Tiryagbhyam";
@@ -220,16 +247,19 @@ static VedicValue select_best_multiplication_method(VedicValue a, VedicValue b,
 }
 
 /**
- * Unified squaring interface
+ * Unified squaring interface (adaptive mode squares through Dwandwa-yoga)
  */
 VedicValue square_vedic_unified(VedicValue a) {
-    return multiply_vedic_unified(a, a);
+    VEDIC_ALLOC_SCOPE_BEGIN("square_vedic_unified");
+    VedicValue result = multiply_vedic_unified(a, a);
+    VEDIC_ALLOC_SCOPE_END();
+    return result;
 }
 
 /**
- * Unified division interface
+ * Implementation of divide_vedic_unified (see below)
  */
-VedicValue divide_vedic_unified(VedicValue dividend, VedicValue divisor) {
+static VedicValue divide_unified_impl(VedicValue dividend, VedicValue divisor) {
     clock_t start_time = clock();
     VedicValue result;
     const char* sutra_used = "Unknown";
@@ -304,6 +334,16 @@ VedicValue divide_vedic_unified(VedicValue dividend, VedicValue divisor) {
     return result;
 }
 
+/**
+ * Unified division interface
+ */
+VedicValue divide_vedic_unified(VedicValue dividend, VedicValue divisor) {
+    VEDIC_ALLOC_SCOPE_BEGIN("divide_vedic_unified");
+    VedicValue result = divide_unified_impl(dividend, divisor);
+    VEDIC_ALLOC_SCOPE_END();
+    return result;
+}
+
 /**
  * Intelligent method selection for division (add to vedic_core.c)
  */
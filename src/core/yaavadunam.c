@@ -46,6 +46,29 @@
      return combine_parts(left_part, right_part, base_digits);
  }
  
+ /**
+  * Yaavadunam over arrays - branch-free, for the vectorizer
+  * 
+  * Below and above the base are one formula with a signed deviation
+  * d = B - n: the left part n - d is placed by multiplying with B itself,
+  * so neither the case split nor the digit count of B is needed. The
+  * identity (n - d) * B + d^2 = n^2 holds for any base, so there is no
+  * ineligible lane; squares beyond int64_t wrap as n * n does.
+  * 
+  * @param n Numbers to square
+  * @param bases Power of 10 for each number (see nearest_power_of_10)
+  * @param squares Output; may be n itself
+  * @param count Number of elements
+  */
+ void yaavadunam_square_batch(const int64_t *n, const int64_t *bases, int64_t *squares, size_t count) {
+     for (size_t i = 0; i < count; i++) {
+         uint64_t magnitude = n[i] < 0 ? 0 - (uint64_t)n[i] : (uint64_t)n[i];
+         uint64_t base = (uint64_t)bases[i];
+         uint64_t deviation = base - magnitude;
+         squares[i] = (int64_t)((magnitude - deviation) * base + deviation * deviation);
+     }
+ }
+ 
  /**
   * Helper function to determine the best base for Yaavadunam
   * 
@@ -21,11 +21,14 @@
 #include "vedicmath.h"
 #include "vedicmath_dynamic.h"
 #include "vedicmath_optimized.h"
+#include "vedicmath_alloc.h"
+#include "vedicmath_energy.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <limits.h>
 
 #ifdef _WIN32
     #include <windows.h>
@@ -182,7 +185,7 @@ typedef struct {
 // ============================================================================
 
 static SystemResourceMonitor system_monitor = {0};
-static DispatcherConfig dispatcher_config = {
+DispatcherConfig dispatcher_config = {
     .cpu_threshold_high = 80.0,
     .cpu_threshold_low = 30.0,
     .memory_threshold_high = 0.8,
@@ -322,6 +325,27 @@ static void dispatch_update_system_resources(void) {
         fclose(loadavg);
     }
     
+    // Package power from the RAPL energy counters, averaged over at least one
+    // monitoring interval (the counters only update about once a millisecond)
+    static VedicEnergySample energy_start;
+    static bool energy_started = false;
+    if (vedic_energy_init() > 0 && vedic_energy_available(VEDIC_ENERGY_PACKAGE)) {
+        VedicEnergySample energy_now;
+        if (vedic_energy_read(&energy_now) == 0) {
+            uint64_t interval_ns = (uint64_t)dispatcher_config.monitoring_interval_ms * 1000000ull;
+            uint64_t elapsed_ns = energy_now.timestamp_ns - energy_start.timestamp_ns;
+            if (!energy_started) {
+                energy_start = energy_now;
+                energy_started = true;
+            } else if (elapsed_ns > 0 && elapsed_ns >= interval_ns) {
+                system_monitor.power_consumption_watts =
+                    vedic_energy_joules(&energy_start, &energy_now, VEDIC_ENERGY_PACKAGE) * 1e9 / (double)elapsed_ns;
+                system_monitor.power_measured = true;
+                energy_start = energy_now;
+            }
+        }
+    }
+    
 #elif defined(ESP32_PLATFORM)
     get_esp32_system_info(&system_monitor);
     
@@ -721,7 +745,8 @@ static long execute_vedic_sutra(long a, long b, const EnhancedPatternAnalysis* a
             return antya_dasake_mul((int)a, (int)b);
             
         case SUTRA_URDHVA_TIRYAGBHYAM:
-            return urdhva_mult(a, b);
+            // Squares take the duplex form, which forms each crosswise product once
+            return a == b ? dwandwa_square(a) : urdhva_mult(a, b);
             
         case SUTRA_STANDARD:
         default:
@@ -773,7 +798,7 @@ static size_t validation_dataset_capacity = 0;
  */
 static void initialize_validation_dataset(size_t initial_capacity) {
     validation_dataset_capacity = initial_capacity;
-    validation_dataset = malloc(sizeof(PerformanceValidationRecord) * validation_dataset_capacity);
+    validation_dataset = VEDIC_MALLOC(sizeof(PerformanceValidationRecord) * validation_dataset_capacity);
     validation_dataset_size = 0;
 }
 
@@ -792,7 +817,7 @@ static void record_validation_data(
     // Expand dataset if needed
     if (validation_dataset_size >= validation_dataset_capacity) {
         validation_dataset_capacity *= 2;
-        validation_dataset = realloc(validation_dataset, 
+        validation_dataset = VEDIC_REALLOC(validation_dataset, 
             sizeof(PerformanceValidationRecord) * validation_dataset_capacity);
     }
     
@@ -881,19 +906,9 @@ static void export_validation_dataset(const char* filename) {
 // ============================================================================
 
 /**
- * @brief Main adaptive multiplication with comprehensive validation
- * 
- * RESEARCH CONTRIBUTION: Complete adaptive arithmetic engine that:
- * 1. Analyzes mathematical patterns with confidence scoring
- * 2. Considers real-time system constraints  
- * 3. Validates performance claims through dual execution
- * 4. Generates research dataset proving Vedic superiority
- * 
- * @param a First operand
- * @param b Second operand
- * @return Multiplication result with validated performance
+ * Implementation of dispatch_multiply (see below)
  */
-VedicValue dispatch_multiply(VedicValue a, VedicValue b) {
+static VedicValue dispatch_multiply_impl(VedicValue a, VedicValue b) {
     // Convert to long for pattern analysis
     long a_long = vedic_to_int64(a);
     long b_long = vedic_to_int64(b);
@@ -960,6 +975,26 @@ VedicValue dispatch_multiply(VedicValue a, VedicValue b) {
     return vedic_from_int64(vedic_result);
 }
 
+/**
+ * @brief Main adaptive multiplication with comprehensive validation
+ * 
+ * RESEARCH CONTRIBUTION: Complete adaptive arithmetic engine that:
+ * 1. Analyzes mathematical patterns with confidence scoring
+ * 2. Considers real-time system constraints  
+ * 3. Validates performance claims through dual execution
+ * 4. Generates research dataset proving Vedic superiority
+ * 
+ * @param a First operand
+ * @param b Second operand
+ * @return Multiplication result with validated performance
+ */
+VedicValue dispatch_multiply(VedicValue a, VedicValue b) {
+    VEDIC_ALLOC_SCOPE_BEGIN("dispatch_multiply");
+    VedicValue result = dispatch_multiply_impl(a, b);
+    VEDIC_ALLOC_SCOPE_END();
+    return result;
+}
+
 /**
  * @brief Adaptive squaring with specialized pattern detection
  */
@@ -1151,10 +1186,9 @@ static long execute_vedic_division_sutra(long dividend, long divisor,
 // ============================================================================
 
 /**
- * @brief Enhanced adaptive division with comprehensive validation
- * Following the exact same 4-step pattern as dispatch_multiply()
+ * Implementation of dispatch_divide_enhanced (see below)
  */
-VedicValue dispatch_divide_enhanced(VedicValue dividend, VedicValue divisor) {
+static VedicValue dispatch_divide_enhanced_impl(VedicValue dividend, VedicValue divisor) {
     // Convert to long for pattern analysis
     long dividend_long = vedic_to_int64(dividend);
     long divisor_long = vedic_to_int64(divisor);
@@ -1232,6 +1266,17 @@ VedicValue dispatch_divide_enhanced(VedicValue dividend, VedicValue divisor) {
     return vedic_from_int64(vedic_quotient);
 }
 
+/**
+ * @brief Enhanced adaptive division with comprehensive validation
+ * Following the exact same 4-step pattern as dispatch_multiply()
+ */
+VedicValue dispatch_divide_enhanced(VedicValue dividend, VedicValue divisor) {
+    VEDIC_ALLOC_SCOPE_BEGIN("dispatch_divide_enhanced");
+    VedicValue result = dispatch_divide_enhanced_impl(dividend, divisor);
+    VEDIC_ALLOC_SCOPE_END();
+    return result;
+}
+
 /**
  * @brief Enhanced adaptive division with Vedic optimization potential
  * 
@@ -1560,9 +1605,9 @@ void analyze_performance_statistics(void) {
 // ============================================================================
 
 /**
- * @brief Initialize the enhanced adaptive dispatcher
+ * Implementation of dispatch_mixed_mode_init (see below)
  */
-DispatchResult dispatch_mixed_mode_init(const DispatcherConfig* config) {
+static DispatchResult dispatch_init_impl(const DispatcherConfig* config) {
     if (config) {
         dispatcher_config = *config;
     }
@@ -1587,9 +1632,19 @@ DispatchResult dispatch_mixed_mode_init(const DispatcherConfig* config) {
 }
 
 /**
- * @brief Cleanup and export final results
+ * @brief Initialize the enhanced adaptive dispatcher
  */
-void dispatch_cleanup_and_export(const char* dataset_filename) {
+DispatchResult dispatch_mixed_mode_init(const DispatcherConfig* config) {
+    VEDIC_ALLOC_SCOPE_BEGIN("dispatch_mixed_mode_init");
+    DispatchResult result = dispatch_init_impl(config);
+    VEDIC_ALLOC_SCOPE_END();
+    return result;
+}
+
+/**
+ * Implementation of dispatch_cleanup_and_export (see below)
+ */
+static void dispatch_cleanup_impl(const char* dataset_filename) {
     // Export validation dataset
     if (dataset_filename) {
         export_validation_dataset(dataset_filename);
@@ -1604,11 +1659,20 @@ void dispatch_cleanup_and_export(const char* dataset_filename) {
 #endif
     
     if (validation_dataset) {
-        free(validation_dataset);
+        VEDIC_FREE(validation_dataset);
         validation_dataset = NULL;
         validation_dataset_size = 0;
         validation_dataset_capacity = 0;
     }
     
     printf("Enhanced Adaptive Dispatcher cleanup complete\n");
+}
+
+/**
+ * @brief Cleanup and export final results
+ */
+void dispatch_cleanup_and_export(const char* dataset_filename) {
+    VEDIC_ALLOC_SCOPE_BEGIN("dispatch_cleanup_and_export");
+    dispatch_cleanup_impl(dataset_filename);
+    VEDIC_ALLOC_SCOPE_END();
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
  #include "vedicmath_dynamic.h"
  #include "vedicmath.h"
+ #include "vedicmath_alloc.h"
  #include <stdio.h>
  #include <stdlib.h>
  #include <string.h>
@@ -128,8 +129,12 @@
          return (int64_t)vedic_square((long)a);
      }
      
-     // Fall back to standard multiplication
-     return a * a;
+     // Wider than long: square the two 32-bit halves with the duplex method
+     uint64_t magnitude = a < 0 ? 0 - (uint64_t)a : (uint64_t)a;
+     uint32_t limbs[2] = {(uint32_t)magnitude, (uint32_t)(magnitude >> 32)};
+     uint32_t square[4];
+     dwandwa_square_limbs(square, limbs, 2);
+     return (int64_t)(((uint64_t)square[1] << 32) | square[0]);
  }
  
  float vedic_square_f32(float a) {
@@ -179,9 +184,9 @@
  }
  
  /**
-  * Perform dynamic multiplication using the appropriate Vedic technique
+  * Implementation of vedic_dynamic_multiply (see below)
   */
- VedicValue vedic_dynamic_multiply(VedicValue a, VedicValue b) {
+ static VedicValue dynamic_multiply_impl(VedicValue a, VedicValue b) {
     // Determine the result type based on operand types
     VedicNumberType result_type = vedic_result_type(a.type, b.type);
     VedicValue result;
@@ -261,9 +266,19 @@
  }
  
  /**
-  * Perform dynamic squaring using the appropriate Vedic technique
+  * Perform dynamic multiplication using the appropriate Vedic technique
   */
- VedicValue vedic_dynamic_square(VedicValue a) {
+ VedicValue vedic_dynamic_multiply(VedicValue a, VedicValue b) {
+     VEDIC_ALLOC_SCOPE_BEGIN("vedic_dynamic_multiply");
+     VedicValue result = dynamic_multiply_impl(a, b);
+     VEDIC_ALLOC_SCOPE_END();
+     return result;
+ }
+ 
+ /**
+  * Implementation of vedic_dynamic_square (see below)
+  */
+ static VedicValue dynamic_square_impl(VedicValue a) {
      VedicValue result;
      result.type = a.type;
      
@@ -296,9 +311,19 @@
  }
  
  /**
-  * Perform dynamic division
+  * Perform dynamic squaring using the appropriate Vedic technique
   */
- VedicValue vedic_dynamic_divide(VedicValue a, VedicValue b) {
+ VedicValue vedic_dynamic_square(VedicValue a) {
+     VEDIC_ALLOC_SCOPE_BEGIN("vedic_dynamic_square");
+     VedicValue result = dynamic_square_impl(a);
+     VEDIC_ALLOC_SCOPE_END();
+     return result;
+ }
+ 
+ /**
+  * Implementation of vedic_dynamic_divide (see below)
+  */
+ static VedicValue dynamic_divide_impl(VedicValue a, VedicValue b) {
      // Determine the result type based on operand types
      VedicNumberType result_type = vedic_result_type(a.type, b.type);
      VedicValue result;
@@ -393,6 +418,16 @@
      return result;
  }
  
+ /**
+  * Perform dynamic division
+  */
+ VedicValue vedic_dynamic_divide(VedicValue a, VedicValue b) {
+     VEDIC_ALLOC_SCOPE_BEGIN("vedic_dynamic_divide");
+     VedicValue result = dynamic_divide_impl(a, b);
+     VEDIC_ALLOC_SCOPE_END();
+     return result;
+ }
+ 
  /**
   * Perform dynamic addition
   */
@@ -574,9 +609,9 @@
  }
  
  /**
-  * Perform a dynamic operation based on operator type
+  * Implementation of vedic_dynamic_operation (see below)
   */
- VedicValue vedic_dynamic_operation(VedicValue a, VedicValue b, VedicOperation op) {
+ static VedicValue dynamic_operation_impl(VedicValue a, VedicValue b, VedicOperation op) {
      switch (op) {
          case VEDIC_OP_ADD:
              return vedic_dynamic_add(a, b);
@@ -622,11 +657,21 @@
  }
  
  /**
-  * Parse and evaluate an expression with dynamic types
+  * Perform a dynamic operation based on operator type
   */
- VedicValue vedic_dynamic_evaluate(const char* expression) {
+ VedicValue vedic_dynamic_operation(VedicValue a, VedicValue b, VedicOperation op) {
+     VEDIC_ALLOC_SCOPE_BEGIN("vedic_dynamic_operation");
+     VedicValue result = dynamic_operation_impl(a, b, op);
+     VEDIC_ALLOC_SCOPE_END();
+     return result;
+ }
+ 
+ /**
+  * Implementation of vedic_dynamic_evaluate (see below)
+  */
+ static VedicValue dynamic_evaluate_impl(const char* expression) {
      // Simple parser for "a op b" expressions
-     char* expr_copy = strdup(expression);
+     char* expr_copy = VEDIC_STRDUP(expression);
      if (!expr_copy) {
          // Memory allocation failed
          VedicValue result;
@@ -649,7 +694,7 @@
      if (!op_str) {
          // No operator found - try to parse as single number
          VedicValue result = vedic_parse_number(expr_copy);
-         free(expr_copy);
+         VEDIC_FREE(expr_copy);
          return result;
      }
      
@@ -689,11 +734,21 @@
      VedicValue result = vedic_dynamic_operation(left, right, op);
      
      // Clean up
-     free(expr_copy);
+     VEDIC_FREE(expr_copy);
      
      return result;
  }
  
+ /**
+  * Parse and evaluate an expression with dynamic types
+  */
+ VedicValue vedic_dynamic_evaluate(const char* expression) {
+     VEDIC_ALLOC_SCOPE_BEGIN("vedic_dynamic_evaluate");
+     VedicValue result = dynamic_evaluate_impl(expression);
+     VEDIC_ALLOC_SCOPE_END();
+     return result;
+ }
+ 
  /**
   * Create a VedicValue from a number in a string
   */
@@ -2,10 +2,13 @@
  * vedicmath_optimized.c - Implementation of performance-optimized operations
  */
 #include "../../include/vedicmath.h"
+#include "vedicmath_alloc.h"
+#include "vedicmath_pool.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <limits.h>
 
 // Rest of the file...
 #include "vedicmath_optimized.h"
@@ -39,6 +42,20 @@ static CachedExpression expression_cache[EXPRESSION_CACHE_SIZE];
 static int cache_use_counter = 0;
 static int cache_initialized = 0;
 
+// The cache is shared by all threads: lookups update the LRU stamps and
+// inserts free/duplicate entries, so both run under cache_lock
+#ifdef VEDICMATH_PLATFORM_WINDOWS
+#include <windows.h>
+static SRWLOCK cache_lock = SRWLOCK_INIT;
+#define CACHE_LOCK() AcquireSRWLockExclusive(&cache_lock)
+#define CACHE_UNLOCK() ReleaseSRWLockExclusive(&cache_lock)
+#else
+#include <pthread.h>
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#define CACHE_LOCK() pthread_mutex_lock(&cache_lock)
+#define CACHE_UNLOCK() pthread_mutex_unlock(&cache_lock)
+#endif
+
 /**
  * Initialize the operation lookup tables
  */
@@ -102,16 +119,18 @@ void vedic_optimized_init(void)
 void vedic_optimized_cleanup(void)
 {
     // Free any resources in the expression cache
+    CACHE_LOCK();
     for (int i = 0; i < EXPRESSION_CACHE_SIZE; i++)
     {
         if (expression_cache[i].expression)
         {
-            free(expression_cache[i].expression);
+            VEDIC_FREE(expression_cache[i].expression);
             expression_cache[i].expression = NULL;
         }
     }
 
     cache_initialized = 0;
+    CACHE_UNLOCK();
 }
 
 /**
@@ -141,9 +160,9 @@ static inline VedicValue fast_int32_multiply(int32_t a, int32_t b)
 }
 
 /**
- * Optimized dynamic multiplication
+ * Implementation of vedic_optimized_multiply (see below)
  */
-inline VedicValue vedic_optimized_multiply(VedicValue a, VedicValue b)
+static VedicValue optimized_multiply_impl(VedicValue a, VedicValue b)
 {
     // Fast path for int32 * int32 (most common case)
     if (a.type == VEDIC_INT32 && b.type == VEDIC_INT32)
@@ -198,6 +217,17 @@ inline VedicValue vedic_optimized_multiply(VedicValue a, VedicValue b)
     return vedic_dynamic_multiply(a, b);
 }
 
+/**
+ * Optimized dynamic multiplication
+ */
+VedicValue vedic_optimized_multiply(VedicValue a, VedicValue b)
+{
+    VEDIC_ALLOC_SCOPE_BEGIN("vedic_optimized_multiply");
+    VedicValue result = optimized_multiply_impl(a, b);
+    VEDIC_ALLOC_SCOPE_END();
+    return result;
+}
+
 /**
  * Optimized dynamic addition
  */
@@ -269,9 +299,9 @@ inline VedicValue vedic_optimized_subtract(VedicValue a, VedicValue b)
 }
 
 /**
- * Optimized dynamic division
+ * Implementation of vedic_optimized_divide (see below)
  */
-inline VedicValue vedic_optimized_divide(VedicValue a, VedicValue b)
+static VedicValue optimized_divide_impl(VedicValue a, VedicValue b)
 {
     // Check for division by zero
     bool is_zero_b = false;
@@ -362,6 +392,17 @@ inline VedicValue vedic_optimized_divide(VedicValue a, VedicValue b)
     return vedic_dynamic_divide(a, b);
 }
 
+/**
+ * Optimized dynamic division
+ */
+VedicValue vedic_optimized_divide(VedicValue a, VedicValue b)
+{
+    VEDIC_ALLOC_SCOPE_BEGIN("vedic_optimized_divide");
+    VedicValue result = optimized_divide_impl(a, b);
+    VEDIC_ALLOC_SCOPE_END();
+    return result;
+}
+
 /**
  * Optimized dynamic modulo
  */
@@ -521,27 +562,30 @@ static inline VedicOperation fast_detect_operation(const char op_char)
  */
 static bool get_cached_expression(const char *expression, VedicValue *result)
 {
-    if (!cache_initialized)
-    {
-        return false;
-    }
+    bool found = false;
 
-    for (int i = 0; i < EXPRESSION_CACHE_SIZE; i++)
+    CACHE_LOCK();
+    if (cache_initialized)
     {
-        if (expression_cache[i].expression &&
-            strcmp(expression_cache[i].expression, expression) == 0)
+        for (int i = 0; i < EXPRESSION_CACHE_SIZE; i++)
         {
-            // Cache hit - return the cached result
-            *result = expression_cache[i].result;
+            if (expression_cache[i].expression &&
+                strcmp(expression_cache[i].expression, expression) == 0)
+            {
+                // Cache hit - return the cached result
+                *result = expression_cache[i].result;
 
-            // Update the usage counter
-            expression_cache[i].last_used = cache_use_counter++;
+                // Update the usage counter
+                expression_cache[i].last_used = cache_use_counter++;
 
-            return true;
+                found = true;
+                break;
+            }
         }
     }
+    CACHE_UNLOCK();
 
-    return false;
+    return found;
 }
 
 /**
@@ -549,6 +593,8 @@ static bool get_cached_expression(const char *expression, VedicValue *result)
  */
 static void cache_expression(const char *expression, VedicValue result)
 {
+    CACHE_LOCK();
+
     if (!cache_initialized)
     {
         vedic_optimized_init();
@@ -580,24 +626,22 @@ static void cache_expression(const char *expression, VedicValue result)
         // Free the old expression if any
         if (expression_cache[target_slot].expression)
         {
-            free(expression_cache[target_slot].expression);
+            VEDIC_FREE(expression_cache[target_slot].expression);
         }
 
         // Store the new expression
-    #ifdef VEDICMATH_PLATFORM_WINDOWS
-        expression_cache[target_slot].expression = _strdup(expression);
-    #else
-        expression_cache[target_slot].expression = strdup(expression);
-    #endif
+        expression_cache[target_slot].expression = VEDIC_STRDUP(expression);
         expression_cache[target_slot].result = result;
         expression_cache[target_slot].last_used = cache_use_counter++;
     }
+
+    CACHE_UNLOCK();
 }
 
 /**
- * Optimized expression evaluation
+ * Implementation of vedic_optimized_evaluate (see below)
  */
-VedicValue vedic_optimized_evaluate(const char *expression)
+static VedicValue optimized_evaluate_impl(const char *expression)
 {
     VedicValue result;
 
@@ -608,7 +652,7 @@ VedicValue vedic_optimized_evaluate(const char *expression)
     }
 
     // Make a copy to avoid modifying the original string
-    char *expr_copy = vedicmath_strdup(expression);
+    char *expr_copy = VEDIC_STRDUP(expression);
     if (!expr_copy)
     {
         // Memory allocation failed - return 0
@@ -633,7 +677,7 @@ VedicValue vedic_optimized_evaluate(const char *expression)
     {
         // No operator found - try to parse as a single number
         result = vedic_parse_number(expr_copy);
-        free(expr_copy);
+        VEDIC_FREE(expr_copy);
         return result;
     }
 
@@ -696,11 +740,114 @@ VedicValue vedic_optimized_evaluate(const char *expression)
     cache_expression(expression, result);
 
     // Clean up
-    free(expr_copy);
+    VEDIC_FREE(expr_copy);
+
+    return result;
+}
 
+/**
+ * Optimized expression evaluation
+ */
+VedicValue vedic_optimized_evaluate(const char *expression)
+{
+    VEDIC_ALLOC_SCOPE_BEGIN("vedic_optimized_evaluate");
+    VedicValue result = optimized_evaluate_impl(expression);
+    VEDIC_ALLOC_SCOPE_END();
     return result;
 }
 
+// Elements per range handed to the thread pool; one element is a few
+// hundred nanoseconds at most, so smaller ranges cost more to schedule
+// than they save
+#define OPTIMIZED_BATCH_GRAIN 512
+#define OPTIMIZED_EVALUATE_GRAIN 64
+
+// Elements between cancellation checks, a few microseconds of work each
+#define OPTIMIZED_MULTIPLY_CHECK 1024
+#define OPTIMIZED_EVALUATE_CHECK 32
+
+typedef struct
+{
+    VedicValue *results;
+    const VedicValue *a;
+    const VedicValue *b;
+    const char **expressions;
+    VedicCancelToken *token;       // NULL: no checks
+    VedicCancelToken done;         // Local tally of the elements computed
+} OptimizedBatch;
+
+/**
+ * End of the next run of elements from i, or i itself if the token says
+ * to stop; without a token the run is the rest of the range
+ */
+static size_t batch_step(OptimizedBatch *batch, size_t i, size_t end, size_t step)
+{
+    if (!batch->token)
+    {
+        return end;
+    }
+    if (vedic_cancel_check(batch->token) != VEDIC_CANCEL_NONE)
+    {
+        return i;
+    }
+    return end - i < step ? end : i + step;
+}
+
+static void batch_count(OptimizedBatch *batch, size_t amount)
+{
+    if (batch->token)
+    {
+        vedic_cancel_add_progress(batch->token, amount);
+        vedic_cancel_add_progress(&batch->done, amount);
+    }
+}
+
+// Pool workers have no API scope of their own, so each range reopens the
+// batch scope and allocations stay attributed to the batch entry point
+static void multiply_batch_range(size_t begin, size_t end, void *context)
+{
+    OptimizedBatch *batch = (OptimizedBatch *)context;
+    VEDIC_ALLOC_SCOPE_BEGIN("vedic_optimized_multiply_batch");
+    size_t i = begin, stop;
+    while (i < end && (stop = batch_step(batch, i, end, OPTIMIZED_MULTIPLY_CHECK)) > i)
+    {
+        batch_count(batch, stop - i);
+        for (; i < stop; i++)
+        {
+            batch->results[i] = vedic_optimized_multiply(batch->a[i], batch->b[i]);
+        }
+    }
+    VEDIC_ALLOC_SCOPE_END();
+}
+
+static void evaluate_batch_range(size_t begin, size_t end, void *context)
+{
+    OptimizedBatch *batch = (OptimizedBatch *)context;
+    VEDIC_ALLOC_SCOPE_BEGIN("vedic_optimized_evaluate_batch");
+    size_t i = begin, stop;
+    while (i < end && (stop = batch_step(batch, i, end, OPTIMIZED_EVALUATE_CHECK)) > i)
+    {
+        batch_count(batch, stop - i);
+        for (; i < stop; i++)
+        {
+            batch->results[i] = vedic_optimized_evaluate(batch->expressions[i]);
+        }
+    }
+    VEDIC_ALLOC_SCOPE_END();
+}
+
+/**
+ * Outcome of a cancellable batch: done unless some elements were skipped
+ */
+static VedicCancelReason batch_outcome(OptimizedBatch *batch, size_t count)
+{
+    if (!batch->token || vedic_cancel_progress(&batch->done) == count)
+    {
+        return VEDIC_CANCEL_NONE;
+    }
+    return vedic_cancel_check(batch->token);
+}
+
 /**
  * Optimized batch multiplication
  */
@@ -709,22 +856,22 @@ void vedic_optimized_multiply_batch(VedicValue *results,
                                     const VedicValue *b,
                                     size_t count)
 {
-    if (count > INT_MAX)
-    {
-        // Fallback to serial loop if count is too large for OpenMP
-        for (size_t i = 0; i < count; i++)
-            results[i] = vedic_optimized_multiply(a[i], b[i]);
-        return;
-    }
+    OptimizedBatch batch = {results, a, b, NULL, NULL, {0, 0, 0}};
+    vedic_pool_parallel_for(count, OPTIMIZED_BATCH_GRAIN, multiply_batch_range, &batch);
+}
 
-    int i;
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for (i = 0; i < (int)count; i++)
-    {
-        results[i] = vedic_optimized_multiply(a[i], b[i]);
-    }
+/**
+ * Optimized batch multiplication with a cancellation token
+ */
+VedicCancelReason vedic_optimized_multiply_batch_cancellable(VedicValue *results,
+                                                             const VedicValue *a,
+                                                             const VedicValue *b,
+                                                             size_t count,
+                                                             VedicCancelToken *token)
+{
+    OptimizedBatch batch = {results, a, b, NULL, token, {0, 0, 0}};
+    vedic_pool_parallel_for(count, OPTIMIZED_BATCH_GRAIN, multiply_batch_range, &batch);
+    return batch_outcome(&batch, count);
 }
 
 /**
@@ -734,19 +881,19 @@ void vedic_optimized_evaluate_batch(VedicValue *results,
                                     const char **expressions,
                                     size_t count)
 {
-    if (count > INT_MAX)
-    {
-        // Fallback to serial loop if count is too large for OpenMP
-        for (size_t i = 0; i < count; i++)
-            results[i] = vedic_optimized_evaluate(expressions[i]);
-        return;
-    }
-    int i = 0;
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for (i = 0; i < count; i++)
-    {
-        results[i] = vedic_optimized_evaluate(expressions[i]);
-    }
-}
\ No newline at end of file
+    OptimizedBatch batch = {results, NULL, NULL, expressions, NULL, {0, 0, 0}};
+    vedic_pool_parallel_for(count, OPTIMIZED_EVALUATE_GRAIN, evaluate_batch_range, &batch);
+}
+
+/**
+ * Optimized batch expression evaluation with a cancellation token
+ */
+VedicCancelReason vedic_optimized_evaluate_batch_cancellable(VedicValue *results,
+                                                             const char **expressions,
+                                                             size_t count,
+                                                             VedicCancelToken *token)
+{
+    OptimizedBatch batch = {results, NULL, NULL, expressions, token, {0, 0, 0}};
+    vedic_pool_parallel_for(count, OPTIMIZED_EVALUATE_GRAIN, evaluate_batch_range, &batch);
+    return batch_outcome(&batch, count);
+}
@@ -6,68 +6,137 @@
  */
 
  #include "vedicmath.h"
-
+ 
+ #define VESTANAM_PAIRS 10             // Digit pairs of any |int64_t|
+ #define VESTANAM_CACHE_SIZE 1024      // Divisors below this keep their tables
+ #define VESTANAM_BLOCK 256            // Numbers screened together
+ 
+ // Cache entries are filled once; readers only trust a published entry
+ #ifdef VEDICMATH_PLATFORM_WINDOWS
+ #include <windows.h>
+ #define OSCULATOR_LOAD_ACQUIRE(ptr) (MemoryBarrier(), *(volatile const LONG *)(ptr))
+ #define OSCULATOR_CLAIM(ptr) (InterlockedCompareExchange((volatile LONG *)(ptr), 1, 0) == 0)
+ #define OSCULATOR_PUBLISH(ptr) (MemoryBarrier(), *(volatile LONG *)(ptr) = 2)
+ #elif defined(__GNUC__) || defined(__clang__)
+ #define OSCULATOR_LOAD_ACQUIRE(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+ #define OSCULATOR_CLAIM(ptr) __extension__ ({ \
+     int expected_ = 0; \
+     __atomic_compare_exchange_n(ptr, &expected_, 1, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED); })
+ #define OSCULATOR_PUBLISH(ptr) __atomic_store_n(ptr, 2, __ATOMIC_RELEASE)
+ #else
+ #define OSCULATOR_LOAD_ACQUIRE(ptr) (*(volatile const int *)(ptr))
+ #define OSCULATOR_CLAIM(ptr) (*(volatile int *)(ptr) == 0 ? (*(volatile int *)(ptr) = 1, 1) : 0)
+ #define OSCULATOR_PUBLISH(ptr) (*(volatile int *)(ptr) = 2)
+ #endif
+ 
+ /**
+  * Everything the tests need for one divisor coprime to 10
+  */
+ typedef struct {
+     int state;                        // 0 empty, 1 being filled, 2 ready
+     int osculator;                    // > 0: add, < 0: subtract (smaller of the two)
+     uint32_t inverse;                 // divisor^-1 mod 2^32
+     uint32_t limit;                   // UINT32_MAX / divisor
+     uint32_t weights[VESTANAM_PAIRS]; // P^(18 - 2k) mod divisor for digit pair k
+ } OsculatorTable;
+ 
+ static OsculatorTable osculator_cache[VESTANAM_CACHE_SIZE];
+ 
  /**
-  * Get the osculation factor for a prime divisor
+  * Build the table of a divisor coprime to 10
+  * 
+  * The positive osculator (Ekadhika) P satisfies 10P = 1 (mod d), so
+  * 10q + r and q + rP are divisible by d together; the negative one Q
+  * satisfies 10Q = -1 (mod d) and gives q - rQ. One of k * d, k = 1..9,
+  * ends in 9 and one ends in 1, which is where P and Q come from.
   * 
-  * @param prime The prime number to find the factor for
-  * @return The osculation factor, -1 if not a supported prime
+  * Osculating all digits of n at once with P gives the weights, taken here
+  * two digits at a time: with n = sum of pair[k] * 100^k,
+  * P^18 * n = sum of pair[k] * P^(18 - 2k) (mod d), and P is invertible,
+  * so n is divisible by d exactly when that sum is.
   */
- static int get_osculation_factor(int prime) {
-     switch (prime) {
-         case 7:  return 2;  // Multiply last digit by 2, subtract from rest
-         case 11: return 1;  // Alternating addition/subtraction of digits
-         case 13: return 4;  // Multiply last digit by 4, add to rest
-         case 17: return 5;  // Multiply last digit by 5, subtract from rest
-         case 19: return 2;  // Multiply last digit by 2, add to rest
-         case 23: return 7;  // Multiply last digit by 7, add to rest
-         case 29: return 3;  // Multiply last digit by 3, add to rest
-         case 31: return 3;  // Multiply last digit by 3, subtract from rest
-         case 37: return 11; // Multiply last digit by 11, subtract from rest
-         case 41: return 4;  // Multiply last digit by 4, subtract from rest
-         case 43: return 13; // Multiply last digit by 13, add to rest
-         case 47: return 14; // Multiply last digit by 14, subtract from rest
-         case 53: return 16; // Multiply last digit by 16, subtract from rest
-         default: return -1; // Not a supported prime
+ static void build_osculator_table(OsculatorTable *table, int divisor) {
+     long d = divisor;
+     long positive = 0;
+     for (long k = 1; k <= 9; k++) {
+         if ((k * d) % 10 == 9) {
+             positive = (k * d + 1) / 10;
+         }
+     }
+     positive %= d;                    // d = 1: every number qualifies
+     long negative = d - positive;
+     table->osculator = positive <= negative ? (int)positive : -(int)negative;
+ 
+     uint32_t inverse = (uint32_t)divisor;
+     for (int i = 0; i < 4; i++) {
+         inverse *= 2 - (uint32_t)divisor * inverse;    // Newton: 3 -> 48 correct bits
+     }
+     table->inverse = inverse;
+     table->limit = UINT32_MAX / (uint32_t)divisor;
+ 
+     uint64_t weight = 1 % (uint64_t)d;
+     uint64_t step = (uint64_t)positive * (uint64_t)positive % (uint64_t)d;
+     for (int k = VESTANAM_PAIRS - 1; k >= 0; k--) {
+         table->weights[k] = (uint32_t)weight;
+         weight = weight * step % (uint64_t)d;
      }
  }
  
  /**
-  * Get whether to add or subtract the osculation result
+  * Table of a divisor: from the cache when small, else built into scratch
   * 
-  * @param prime The prime number
-  * @return 1 for addition, -1 for subtraction
+  * @return The table, or NULL when the divisor is not coprime to 10 or
+  *         too large for the screen
   */
- static int get_osculation_operation(int prime) {
-     switch (prime) {
-         case 7:  return -1; // Subtract
-         case 11: return 0;  // Special: alternating
-         case 13: return 1;  // Add
-         case 17: return -1; // Subtract
-         case 19: return 1;  // Add
-         case 23: return 1;  // Add
-         case 29: return 1;  // Add
-         case 31: return -1; // Subtract
-         case 37: return -1; // Subtract
-         case 41: return -1; // Subtract
-         case 43: return 1;  // Add
-         case 47: return -1; // Subtract
-         case 53: return -1; // Subtract
-         default: return 0;  // Not defined
+ static const OsculatorTable *osculator_table(int divisor, OsculatorTable *scratch) {
+     if (divisor <= 0 || divisor > VESTANAM_MAX_DIVISOR || divisor % 2 == 0 || divisor % 5 == 0) {
+         return NULL;
      }
+     if (divisor >= VESTANAM_CACHE_SIZE) {
+         build_osculator_table(scratch, divisor);
+         return scratch;
+     }
+ 
+     OsculatorTable *entry = &osculator_cache[divisor];
+     if (OSCULATOR_LOAD_ACQUIRE(&entry->state) == 2) {
+         return entry;
+     }
+     if (OSCULATOR_CLAIM(&entry->state)) {
+         build_osculator_table(entry, divisor);
+         OSCULATOR_PUBLISH(&entry->state);
+         return entry;
+     }
+     // Another thread is filling it: use a private copy this time
+     build_osculator_table(scratch, divisor);
+     return scratch;
+ }
+ 
+ /**
+  * Osculator of a divisor coprime to 10
+  * 
+  * @param divisor Divisor, 1 to VESTANAM_MAX_DIVISOR
+  * @return Positive P to add last digit * P to the rest, negative -Q to
+  *         subtract last digit * Q, whichever is smaller; 0 when the divisor
+  *         has no osculator (shares a factor with 10 or is out of range)
+  */
+ int vestanam_osculator(int divisor) {
+     OsculatorTable scratch;
+     const OsculatorTable *table = osculator_table(divisor, &scratch);
+     return table ? table->osculator : 0;
  }
  
  /**
   * Vestanam - "By Osculation"
   * 
-  * Purpose: Test if a number is divisible by certain primes by applying
-  * a factor to the last digit and adding/subtracting from the rest
+  * Purpose: Test if a number is divisible by a divisor coprime to 10 by
+  * applying its osculator to the last digit and adding/subtracting from the rest
   * 
   * When to use: For quickly determining divisibility by primes like 7, 13, 17, etc.
   * 
   * @param number The number to check
-  * @param prime The prime divisor to test
-  * @return 1 if divisible, 0 if not, -1 if prime not supported
+  * @param prime The divisor to test: coprime to 10 and at most
+  *              VESTANAM_MAX_DIVISOR, or 2 or 5
+  * @return 1 if divisible, 0 if not, -1 if the divisor is not supported
   */
  int vestanam_divisibility(long number, int prime) {
      // Handle basic cases
@@ -76,47 +145,21 @@
      // Take absolute value
      if (number < 0) number = -number;
      
-     // Handle small primes with well-known divisibility tests
+     // 2 and 5 divide 10, so they have no osculator; the last digit decides
      if (prime == 2) return (number % 2 == 0) ? 1 : 0;
-     if (prime == 3) {
-         int sum = 0;
-         long temp = number;
-         while (temp > 0) {
-             sum += temp % 10;
-             temp /= 10;
-         }
-         return (sum % 3 == 0) ? 1 : 0;
-     }
      if (prime == 5) return (number % 10 == 0 || number % 10 == 5) ? 1 : 0;
      
-     // Get the osculation factor and operation
-     int factor = get_osculation_factor(prime);
-     int operation = get_osculation_operation(prime);
+     OsculatorTable scratch;
+     const OsculatorTable *table = osculator_table(prime, &scratch);
+     if (!table) return -1;  // Divisor not supported
+     int factor = table->osculator > 0 ? table->osculator : -table->osculator;
      
-     if (factor == -1) return -1;  // Prime not supported
-     
-     // Special case for 11 (alternating sum)
-     if (prime == 11) {
-         int alternating_sum = 0;
-         long temp = number;
-         int position = 0;
-         
-         while (temp > 0) {
-             if (position % 2 == 0) {
-                 alternating_sum += temp % 10;
-             } else {
-                 alternating_sum -= temp % 10;
-             }
-             temp /= 10;
-             position++;
-         }
-         
-         return (alternating_sum % 11 == 0) ? 1 : 0;
-     }
-     
-     // Apply osculation for other primes
+     // Apply osculation. Below 10 * factor a step no longer shrinks the
+     // number (e.g. 39 -> 3 + 9*4 = 39 for 13), so stop there and finish
+     // with a single remainder check. For 3 this is the digit sum and for
+     // 11 (subtract 1) the alternating sum.
      long temp = number;
-     while (temp >= prime) {
+     while (temp >= prime && temp >= 10L * factor) {
          // Extract last digit
          int last_digit = temp % 10;
          
@@ -124,12 +167,12 @@
          temp /= 10;
          
          // Apply osculation
-         if (operation > 0) {
+         if (table->osculator > 0) {
              // Add
-             temp += last_digit * factor;
+             temp += (long)last_digit * factor;
          } else {
              // Subtract
-             temp -= last_digit * factor;
+             temp -= (long)last_digit * factor;
          }
          
          // Take absolute value if negative
@@ -162,4 +205,111 @@
   */
  int is_divisible_by_13(long number) {
      return vestanam_divisibility(number, 13);
- }
\ No newline at end of file
+ }
+ 
+ /**
+  * Vestanam screen - many numbers against many divisors at once
+  * 
+  * Purpose: Filter numbers on divisibility by a set of divisors without
+  * dividing by any of them.
+  * 
+  * Core logic: Each block of numbers has its digits peeled once, for all
+  * divisors: two 64-bit divisions cut |n| into 8-digit pieces and the
+  * rest runs in 32-bit lanes, into ten digit pairs. Per divisor, every
+  * lane then sums its pairs against the divisor's osculation weights (see
+  * build_osculator_table), which stays below 2^32, and the sum is tested
+  * with one multiply by the divisor's inverse mod 2^32. 2 and 5 are read
+  * off the last pair. The divisor loop runs across all lanes of the block
+  * with no per-lane branches.
+  * 
+  * @param numbers Numbers to screen
+  * @param count Number of numbers
+  * @param divisors Divisors: coprime to 10 and at most
+  *                 VESTANAM_MAX_DIVISOR, or 2 or 5
+  * @param divisor_count Number of divisors, at most 64
+  * @param masks Output: bit j of masks[i] is set when divisors[j] divides
+  *              numbers[i]
+  * @param first_only Nonzero to keep only the first divisor found per
+  *                   number; a block stops once every number in it has one
+  * @return 0 on success, -1 (masks untouched) if a divisor is not supported
+  */
+ int vestanam_screen_batch(const int64_t *numbers, size_t count, const int *divisors,
+                           size_t divisor_count, uint64_t *masks, int first_only) {
+     const OsculatorTable *tables[64];
+     OsculatorTable scratch[64];
+     if (divisor_count > 64) return -1;
+     for (size_t j = 0; j < divisor_count; j++) {
+         tables[j] = NULL;
+         if (divisors[j] != 2 && divisors[j] != 5 &&
+             !(tables[j] = osculator_table(divisors[j], &scratch[j]))) {
+             return -1;
+         }
+     }
+ 
+     uint8_t pairs[VESTANAM_PAIRS][VESTANAM_BLOCK];
+     uint32_t low[VESTANAM_BLOCK], middle[VESTANAM_BLOCK], sums[VESTANAM_BLOCK];
+     for (size_t start = 0; start < count; start += VESTANAM_BLOCK) {
+         size_t size = count - start < VESTANAM_BLOCK ? count - start : VESTANAM_BLOCK;
+         uint64_t *block = masks + start;
+ 
+         // Digit pairs, once for all divisors
+         for (size_t i = 0; i < size; i++) {
+             int64_t n = numbers[start + i];
+             uint64_t magnitude = n < 0 ? 0 - (uint64_t)n : (uint64_t)n;
+             uint64_t high = magnitude / 100000000u;
+             uint32_t top = (uint32_t)(high / 100000000u);     // Below 923
+             low[i] = (uint32_t)(magnitude - high * 100000000u);
+             middle[i] = (uint32_t)(high - (uint64_t)top * 100000000u);
+             pairs[8][i] = (uint8_t)(top % 100);
+             pairs[9][i] = (uint8_t)(top / 100);
+             block[i] = 0;
+         }
+         for (int k = 0; k < 4; k++) {
+             for (size_t i = 0; i < size; i++) {
+                 uint32_t low_rest = low[i] / 100;
+                 uint32_t middle_rest = middle[i] / 100;
+                 pairs[k][i] = (uint8_t)(low[i] - low_rest * 100);
+                 pairs[4 + k][i] = (uint8_t)(middle[i] - middle_rest * 100);
+                 low[i] = low_rest;
+                 middle[i] = middle_rest;
+             }
+         }
+ 
+         size_t open = size;          // Numbers with no divisor found yet
+         for (size_t j = 0; j < divisor_count && (!first_only || open > 0); j++) {
+             if (tables[j]) {
+                 const uint32_t *weights = tables[j]->weights;
+                 for (size_t i = 0; i < size; i++) {
+                     sums[i] = pairs[0][i] * weights[0];
+                 }
+                 for (int k = 1; k < VESTANAM_PAIRS; k++) {
+                     for (size_t i = 0; i < size; i++) {
+                         sums[i] += pairs[k][i] * weights[k];
+                     }
+                 }
+                 uint32_t inverse = tables[j]->inverse;
+                 uint32_t limit = tables[j]->limit;
+                 for (size_t i = 0; i < size; i++) {
+                     sums[i] = sums[i] * inverse <= limit;
+                 }
+             } else if (divisors[j] == 2) {
+                 for (size_t i = 0; i < size; i++) {
+                     sums[i] = (pairs[0][i] & 1) == 0;
+                 }
+             } else {
+                 for (size_t i = 0; i < size; i++) {
+                     sums[i] = pairs[0][i] % 5 == 0;
+                 }
+             }
+ 
+             // Record the hits; with first_only, only on numbers still open
+             open = 0;
+             for (size_t i = 0; i < size; i++) {
+                 uint64_t hit = sums[i] & (uint32_t)(!first_only | (block[i] == 0));
+                 block[i] |= hit << j;
+                 open += block[i] == 0;
+             }
+         }
+     }
+     return 0;
+ }
@@ -15,6 +15,9 @@
 #include "vedicmath.h"
 #include "vedicmath_dynamic.h"
 #include "vedicmath_optimized.h"
+#include "vedicmath_alloc.h"
+#include "vedicmath_metrics.h"
+#include "vedicmath_pool.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -34,6 +37,20 @@
     #include <sys/resource.h>
 #endif
 
+// Guards the dispatcher state below: configuration, learning table, statistics
+// and the research dataset. Pattern detection and the arithmetic itself run
+// outside it, so concurrent callers only meet here to read and update that state
+#ifdef _WIN32
+static SRWLOCK dispatch_lock = SRWLOCK_INIT;
+#define DISPATCH_LOCK() AcquireSRWLockExclusive(&dispatch_lock)
+#define DISPATCH_UNLOCK() ReleaseSRWLockExclusive(&dispatch_lock)
+#else
+#include <pthread.h>
+static pthread_mutex_t dispatch_lock = PTHREAD_MUTEX_INITIALIZER;
+#define DISPATCH_LOCK() pthread_mutex_lock(&dispatch_lock)
+#define DISPATCH_UNLOCK() pthread_mutex_unlock(&dispatch_lock)
+#endif
+
 // ============================================================================
 // GLOBAL STATE FOR UNIFIED DISPATCHER
 // ============================================================================
@@ -253,28 +270,45 @@ static EnhancedPatternResult detect_optimal_pattern(long a, long b) {
 // SYSTEM-AWARE DECISION MODIFICATION
 // ============================================================================
 
+/**
+ * @brief System state sampled once per dispatch
+ */
+typedef struct {
+    double cpu_usage;
+    double memory_usage;
+    size_t available_memory_mb;
+} SystemSample;
+
+/**
+ * @brief Sample the system state; the monitoring query is shared, so call
+ * with the dispatcher lock held
+ */
+static SystemSample sample_system(void) {
+    SystemSample sample = {50.0, 60.0, 2048};
+#ifdef _WIN32
+    sample.cpu_usage = get_cpu_usage_windows();
+    get_memory_usage_windows(&sample.memory_usage, &sample.available_memory_mb);
+#endif
+    return sample;
+}
+
 /**
  * @brief Apply system constraints to pattern recommendation
  */
-static EnhancedPatternResult apply_system_intelligence(EnhancedPatternResult base_pattern) {
-    if (!global_config.enable_system_monitoring) {
+static EnhancedPatternResult apply_system_intelligence(EnhancedPatternResult base_pattern,
+                                                       const UnifiedDispatchConfig* config,
+                                                       const SystemSample* system) {
+    if (!config->enable_system_monitoring) {
         return base_pattern;
     }
     
     EnhancedPatternResult modified = base_pattern;
-    
-    // Get current system state
-    double cpu_usage = 50.0;
-    double memory_usage = 60.0;
-    size_t available_memory_mb = 2048;
-    
-#ifdef _WIN32
-    cpu_usage = get_cpu_usage_windows();
-    get_memory_usage_windows(&memory_usage, &available_memory_mb);
-#endif
+    double cpu_usage = system->cpu_usage;
+    double memory_usage = system->memory_usage;
+    size_t available_memory_mb = system->available_memory_mb;
     
     // HIGH CPU USAGE: Prefer faster algorithms
-    if (cpu_usage > global_config.cpu_threshold_high) {
+    if (cpu_usage > config->cpu_threshold_high) {
         if (base_pattern.predicted_speedup > 2.0) {
             modified.confidence_score *= 1.2; // Boost high-speedup methods
             modified.decision_reasoning = "High CPU load: prioritizing fast Vedic method";
@@ -285,7 +319,7 @@ static EnhancedPatternResult apply_system_intelligence(EnhancedPatternResult bas
     }
     
     // HIGH MEMORY USAGE: Prefer memory-efficient algorithms  
-    if (memory_usage > global_config.memory_threshold * 100) {
+    if (memory_usage > config->memory_threshold * 100) {
         if (base_pattern.memory_requirement > 200) {
             modified.confidence_score *= 0.7;
             modified.decision_reasoning = "High memory usage: avoiding memory-intensive algorithms";
@@ -293,7 +327,7 @@ static EnhancedPatternResult apply_system_intelligence(EnhancedPatternResult bas
     }
     
     // LOW MEMORY AVAILABLE: Strong memory constraint
-    if (available_memory_mb < global_config.max_memory_usage_mb) {
+    if (available_memory_mb < config->max_memory_usage_mb) {
         if (base_pattern.memory_requirement > available_memory_mb * 1024 * 1024 / 4) {
             modified.confidence_score *= 0.5;
             modified.decision_reasoning = "Low available memory: forcing memory-efficient choice";
@@ -331,7 +365,7 @@ static void update_learning_system(const char* pattern_signature,
     if (!entry) {
         if (pattern_history_size >= pattern_history_capacity) {
             pattern_history_capacity = pattern_history_capacity ? pattern_history_capacity * 2 : 100;
-            pattern_history = realloc(pattern_history, 
+            pattern_history = VEDIC_REALLOC(pattern_history, 
                 sizeof(PatternLearningEntry) * pattern_history_capacity);
         }
         
@@ -375,11 +409,50 @@ static double get_learned_speedup_prediction(const char* pattern_signature, Vedi
 // EXECUTION ENGINE
 // ============================================================================
 
+/**
+ * @brief Monotonic wall-clock time in milliseconds
+ *
+ * clock() counts CPU time at coarse resolution, which reads 0 for a single
+ * operation and sums across threads for a pooled one.
+ */
+static double dispatch_now_ms(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1000.0 / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1000.0 + (double)now.tv_nsec / 1e6;
+#endif
+}
+
+/**
+ * @brief Time plain a * b the way execute_selected_sutra times a sutra
+ */
+static long execute_standard(long a, long b, double* execution_time) {
+    double start = dispatch_now_ms();
+    volatile long result = a * b;      // Keep the multiply inside the timed region
+    *execution_time = dispatch_now_ms() - start;
+    return result;
+}
+
+/**
+ * @brief Count dispatched operations in the engine metrics
+ */
+static void count_dispatch_metrics(uint64_t operations, uint64_t vedic, double vedic_ms, double standard_ms) {
+    vedic_metrics_add(VEDIC_METRIC_DISPATCH_OPERATIONS, operations);
+    vedic_metrics_add(VEDIC_METRIC_DISPATCH_VEDIC, vedic);
+    vedic_metrics_add(VEDIC_METRIC_DISPATCH_NS, (uint64_t)(vedic_ms * 1e6));
+    vedic_metrics_add(VEDIC_METRIC_STANDARD_NS, (uint64_t)(standard_ms * 1e6));
+}
+
 /**
  * @brief Execute selected Vedic sutra with comprehensive monitoring
  */
 static long execute_selected_sutra(long a, long b, VedicSutraType sutra, double* execution_time) {
-    clock_t start = clock();
+    double start = dispatch_now_ms();
     long result = 0;
     
     switch (sutra) {
@@ -396,7 +469,8 @@ static long execute_selected_sutra(long a, long b, VedicSutraType sutra, double*
             break;
             
         case SUTRA_URDHVA_TIRYAGBHYAM:
-            result = urdhva_mult(a, b);
+            // Squares take the duplex form, which forms each crosswise product once
+            result = a == b ? dwandwa_square(a) : urdhva_mult(a, b);
             break;
             
         case SUTRA_STANDARD:
@@ -405,8 +479,7 @@ static long execute_selected_sutra(long a, long b, VedicSutraType sutra, double*
             break;
     }
     
-    clock_t end = clock();
-    *execution_time = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
+    *execution_time = dispatch_now_ms() - start;
     
     return result;
 }
@@ -416,16 +489,16 @@ static long execute_selected_sutra(long a, long b, VedicSutraType sutra, double*
 // ============================================================================
 
 /**
- * @brief Initialize the unified adaptive dispatcher
+ * Implementation of unified_dispatch_init (see below)
  */
-int unified_dispatch_init(const UnifiedDispatchConfig* config) {
+static int dispatch_init_impl(const UnifiedDispatchConfig* config) {
     if (config) {
         global_config = *config;
     }
     
     // Initialize dataset storage
     dataset_capacity = 10000; // Start with 10K operations
-    research_dataset = malloc(sizeof(UnifiedDispatchResult) * dataset_capacity);
+    research_dataset = VEDIC_MALLOC(sizeof(UnifiedDispatchResult) * dataset_capacity);
     if (!research_dataset) {
         printf("❌ Failed to allocate research dataset memory\n");
         return -1;
@@ -433,7 +506,7 @@ int unified_dispatch_init(const UnifiedDispatchConfig* config) {
     
     // Initialize learning system
     pattern_history_capacity = 1000;
-    pattern_history = malloc(sizeof(PatternLearningEntry) * pattern_history_capacity);
+    pattern_history = VEDIC_MALLOC(sizeof(PatternLearningEntry) * pattern_history_capacity);
     if (!pattern_history) {
         printf("❌ Failed to allocate learning system memory\n");
         return -1;
@@ -458,9 +531,64 @@ int unified_dispatch_init(const UnifiedDispatchConfig* config) {
 }
 
 /**
- * @brief THE UNIFIED OPERATION INTERFACE - Handles multiplication for now
+ * @brief Initialize the unified adaptive dispatcher
  */
-UnifiedDispatchResult unified_dispatch_execute(
+int unified_dispatch_init(const UnifiedDispatchConfig* config) {
+    VEDIC_ALLOC_SCOPE_BEGIN("unified_dispatch_init");
+    DISPATCH_LOCK();
+    int result = dispatch_init_impl(config);
+    DISPATCH_UNLOCK();
+    VEDIC_ALLOC_SCOPE_END();
+    return result;
+}
+
+/**
+ * @brief Record one multiply in the learning table, statistics and dataset;
+ * call with the dispatcher lock held
+ */
+static void record_dispatch(UnifiedDispatchResult* result, const char* pattern_sig,
+                            VedicSutraType sutra, double actual_speedup) {
+    // Update learning system
+    update_learning_system(pattern_sig, sutra, actual_speedup);
+    
+    result->operation_id = ++operation_counter;
+    result->total_operations_count = operation_counter;
+    result->contributed_to_learning = global_config.enable_learning;
+    
+    // Add to Research Dataset (allocated by unified_dispatch_init)
+    if (global_config.enable_dataset_logging && research_dataset) {
+        if (dataset_size >= dataset_capacity) {
+            dataset_capacity *= 2;
+            research_dataset = VEDIC_REALLOC(research_dataset, 
+                sizeof(UnifiedDispatchResult) * dataset_capacity);
+        }
+        
+        research_dataset[dataset_size] = *result;
+        research_dataset[dataset_size].added_to_dataset = true;
+        dataset_size++;
+    }
+    
+    // Update learning statistics
+    learning_stats.total_operations++;
+    learning_stats.average_speedup_achieved = 
+        (learning_stats.average_speedup_achieved * (learning_stats.total_operations - 1) + actual_speedup) 
+        / learning_stats.total_operations;
+    
+    if (sutra != SUTRA_STANDARD) {
+        learning_stats.vedic_methods_used++;
+    } else {
+        learning_stats.standard_fallbacks++;
+    }
+}
+
+/**
+ * Implementation of unified_dispatch_execute (see below)
+ *
+ * The lock is taken twice, briefly: once to read the configuration, system
+ * sample and learned prediction, and once to record the outcome. Detection,
+ * execution and validation run unlocked.
+ */
+static UnifiedDispatchResult dispatch_execute_impl(
     OperationCategory operation_type,
     const VedicValue* operands,
     size_t operand_count,
@@ -486,17 +614,22 @@ UnifiedDispatchResult unified_dispatch_execute(
     // STEP 1: Pattern Detection
     EnhancedPatternResult pattern = detect_optimal_pattern(a, b);
     
+    DISPATCH_LOCK();
+    UnifiedDispatchConfig config = global_config;
+    SystemSample system = sample_system();
+    double learned_speedup = get_learned_speedup_prediction(pattern_sig, pattern.recommended_sutra);
+    DISPATCH_UNLOCK();
+    
     // STEP 2: System-Aware Modification
-    EnhancedPatternResult final_choice = apply_system_intelligence(pattern);
+    EnhancedPatternResult final_choice = apply_system_intelligence(pattern, &config, &system);
     
     // STEP 3: Learning System Integration
-    double learned_speedup = get_learned_speedup_prediction(pattern_sig, final_choice.recommended_sutra);
     if (learned_speedup > 1.1) {
         final_choice.predicted_speedup = (final_choice.predicted_speedup + learned_speedup) / 2.0;
     }
     
     // STEP 4: Confidence Threshold Check
-    if (final_choice.confidence_score < global_config.confidence_threshold) {
+    if (final_choice.confidence_score < config.confidence_threshold) {
         final_choice.recommended_sutra = SUTRA_STANDARD;
         final_choice.confidence_score = 1.0;
         final_choice.predicted_speedup = 1.0;
@@ -508,22 +641,16 @@ UnifiedDispatchResult unified_dispatch_execute(
     long vedic_result = execute_selected_sutra(a, b, final_choice.recommended_sutra, &vedic_time);
     long standard_result = 0;
     
-    if (global_config.validate_all_operations) {
-        clock_t std_start = clock();
-        standard_result = a * b;
-        clock_t std_end = clock();
-        standard_time = ((double)(std_end - std_start)) / CLOCKS_PER_SEC * 1000.0;
+    if (config.validate_all_operations) {
+        standard_result = execute_standard(a, b, &standard_time);
     } else {
         standard_time = vedic_time; // Assume same time if not validating
         standard_result = vedic_result; // Trust Vedic result
     }
     
-    // STEP 6: Results and Learning Update
+    // STEP 6: Results
     double actual_speedup = (standard_time > 0) ? standard_time / vedic_time : 1.0;
     
-    // Update learning system
-    update_learning_system(pattern_sig, final_choice.recommended_sutra, actual_speedup);
-    
     // STEP 7: Populate Comprehensive Result
     result.result = vedic_from_int64(vedic_result);
     result.selected_algorithm = final_choice.pattern_name;
@@ -535,66 +662,551 @@ UnifiedDispatchResult unified_dispatch_execute(
     result.execution_time_ms = vedic_time;
     result.standard_execution_time_ms = standard_time;
     result.memory_used_bytes = final_choice.memory_requirement;
-    result.operation_id = ++operation_counter;
     result.timestamp = time(NULL);
     result.operation_type = operation_type;
     result.correctness_verified = (vedic_result == standard_result);
     result.precision_error = 0.0; // Integer operations
-    result.performance_expectation_met = (actual_speedup >= global_config.min_speedup_threshold);
-    result.contributed_to_learning = global_config.enable_learning;
-    result.total_operations_count = operation_counter;
+    result.performance_expectation_met = (actual_speedup >= config.min_speedup_threshold);
+    count_dispatch_metrics(1, final_choice.recommended_sutra != SUTRA_STANDARD, vedic_time, standard_time);
     
-    // Get system context
+    // System context, as sampled for the decision
+    result.cpu_usage_during_operation = system.cpu_usage;
 #ifdef _WIN32
-    result.cpu_usage_during_operation = get_cpu_usage_windows();
     result.platform_info = "Windows";
 #else
-    result.cpu_usage_during_operation = 50.0; // Default
     result.platform_info = "Generic";
 #endif
     
-    // STEP 8: Add to Research Dataset
-    if (global_config.enable_dataset_logging) {
-        if (dataset_size >= dataset_capacity) {
-            dataset_capacity *= 2;
-            research_dataset = realloc(research_dataset, 
-                sizeof(UnifiedDispatchResult) * dataset_capacity);
+    // STEP 8: Learning update, operation id, research dataset and statistics
+    DISPATCH_LOCK();
+    record_dispatch(&result, pattern_sig, final_choice.recommended_sutra, actual_speedup);
+    DISPATCH_UNLOCK();
+    
+    return result;
+}
+
+/**
+ * @brief THE UNIFIED OPERATION INTERFACE - Handles multiplication for now
+ */
+UnifiedDispatchResult unified_dispatch_execute(
+    OperationCategory operation_type,
+    const VedicValue* operands,
+    size_t operand_count,
+    const void* operation_params) {
+    VEDIC_ALLOC_SCOPE_BEGIN("unified_dispatch_execute");
+    UnifiedDispatchResult result = dispatch_execute_impl(operation_type, operands, operand_count, operation_params);
+    VEDIC_ALLOC_SCOPE_END();
+    return result;
+}
+
+// ============================================================================
+// CONVENIENT WRAPPER FUNCTIONS
+// ============================================================================
+
+UnifiedDispatchResult unified_multiply(VedicValue a, VedicValue b) {
+    VedicValue operands[] = {a, b};
+    return unified_dispatch_execute(OPERATION_ARITHMETIC, operands, 2, "multiply");
+}
+
+/**
+ * Division methods reported by vedic_divide_enhanced
+ */
+typedef struct {
+    const char* method;
+    const char* sanskrit_name;
+    const char* decision_reasoning;
+    double confidence;
+    double predicted_speedup;
+} DivisionMethodInfo;
+
+static const DivisionMethodInfo division_methods[] = {
+    {"Nikhilam Division Sutra", "निखिलं नवतश्चरमं दशतः", "Divisor just below a power of 10", 0.85, 1.6},
+    {"Paravartya Yojayet", "परावर्त्य योजयेत्", "Two-digit divisor: transpose and adjust", 0.75, 1.3},
+    {"Dhvajanka (Flag Method)", "ध्वजाङ्क", "Divisor with a clear flag digit", 0.70, 1.2},
+};
+
+static const DivisionMethodInfo standard_division = {
+    "Standard Division", "मानक गणित", "No Vedic division pattern detected", 1.0, 1.0
+};
+
+/**
+ * Implementation of unified_divide (see below)
+ */
+static UnifiedDispatchResult divide_impl(VedicValue dividend, VedicValue divisor) {
+    UnifiedDispatchResult result = {0};
+    result.operation_type = OPERATION_DIVISION;
+    result.timestamp = time(NULL);
+    
+    long a = vedic_to_int64(dividend);
+    long b = vedic_to_int64(divisor);
+    if (b == 0) {
+        result.result = vedic_from_int32(0);
+        result.selected_algorithm = "Error: Division by zero";
+        return result;
+    }
+    
+    long remainder = 0;
+    const char* method = NULL;
+    double start = dispatch_now_ms();
+    long quotient = vedic_divide_enhanced(a, b, &remainder, &method);
+    double vedic_time = dispatch_now_ms() - start;
+    
+    start = dispatch_now_ms();
+    volatile long standard_quotient = a / b;
+    volatile long standard_remainder = a % b;
+    double standard_time = dispatch_now_ms() - start;
+    
+    const DivisionMethodInfo* info = &standard_division;
+    for (size_t i = 0; method && i < sizeof(division_methods) / sizeof(division_methods[0]); i++) {
+        if (strcmp(method, division_methods[i].method) == 0) {
+            info = &division_methods[i];
         }
+    }
+    
+    result.result = vedic_from_int64(quotient);
+    result.selected_algorithm = method ? method : info->method;
+    result.sutra_name_sanskrit = info->sanskrit_name;
+    result.pattern_confidence = info->confidence;
+    result.predicted_speedup = info->predicted_speedup;
+    result.actual_speedup = (vedic_time > 0 && standard_time > 0) ? standard_time / vedic_time : 1.0;
+    result.decision_reasoning = info->decision_reasoning;
+    result.execution_time_ms = vedic_time;
+    result.standard_execution_time_ms = standard_time;
+    result.correctness_verified = (quotient == standard_quotient && remainder == standard_remainder);
+    
+    DISPATCH_LOCK();
+    result.performance_expectation_met = (result.actual_speedup >= global_config.min_speedup_threshold);
+    result.operation_id = ++operation_counter;
+    result.total_operations_count = operation_counter;
+    DISPATCH_UNLOCK();
+    count_dispatch_metrics(1, info != &standard_division, vedic_time, standard_time);
+#ifdef _WIN32
+    result.platform_info = "Windows";
+#else
+    result.platform_info = "Generic";
+#endif
+    return result;
+}
+
+UnifiedDispatchResult unified_divide(VedicValue dividend, VedicValue divisor) {
+    VEDIC_ALLOC_SCOPE_BEGIN("unified_divide");
+    UnifiedDispatchResult result = divide_impl(dividend, divisor);
+    VEDIC_ALLOC_SCOPE_END();
+    return result;
+}
+
+// ============================================================================
+// MATRIX OPERATIONS
+// ============================================================================
+
+// Multiply-adds per pool range; smaller products run on the calling thread
+#define MATRIX_RANGE_WORK 65536
+
+typedef struct {
+    const long* a;                 // rows x inner
+    const long* b;                 // inner x columns
+    long* c;                       // rows x columns
+    size_t inner;
+    size_t columns;
+    VedicCancelToken* cancel;      // NULL: no checks
+    VedicCancelToken done;         // Local tally of the rows computed
+} MatrixRows;
+
+typedef struct {
+    const VedicValue* source;      // rows x inner
+    long* a;
+    size_t inner;
+} MatrixLoad;
+
+/**
+ * @brief Convert rows [begin, end) of A
+ *
+ * Run over the same rows and grain as the multiply, so on a NUMA-aware pool
+ * each row is first written, and so placed, on the node that multiplies it.
+ */
+static void matrix_load_range(size_t begin, size_t end, void* context) {
+    const MatrixLoad* load = (const MatrixLoad*)context;
+    for (size_t i = begin * load->inner; i < end * load->inner; i++) {
+        load->a[i] = vedic_to_int64(load->source[i]);
+    }
+}
+
+/**
+ * @brief Compute rows [begin, end) of C, one batch multiply per row of B
+ */
+static void matrix_rows_range(size_t begin, size_t end, void* context) {
+    MatrixRows* job = (MatrixRows*)context;
+    size_t n = job->columns;
+    VEDIC_ALLOC_SCOPE_BEGIN("unified_matrix_multiply");
+    long* broadcast = VEDIC_MALLOC(sizeof(long) * n * 2);
+    long* products = broadcast ? broadcast + n : NULL;
+    
+    size_t i;
+    for (i = begin; i < end; i++) {
+        // A row is the unit of cancellation
+        if (job->cancel && vedic_cancel_check(job->cancel) != VEDIC_CANCEL_NONE) break;
+        long* row = job->c + i * n;
+        for (size_t j = 0; j < n; j++) row[j] = 0;
         
-        research_dataset[dataset_size] = result;
-        research_dataset[dataset_size].added_to_dataset = true;
-        dataset_size++;
+        for (size_t k = 0; k < job->inner; k++) {
+            long value = job->a[i * job->inner + k];
+            const long* b_row = job->b + k * n;
+            if (!broadcast) {
+                // No scratch memory: same products, one dispatch per element
+                for (size_t j = 0; j < n; j++) row[j] += vedic_multiply(value, b_row[j]);
+                continue;
+            }
+            for (size_t j = 0; j < n; j++) broadcast[j] = value;
+            vedic_multiply_batch(products, broadcast, b_row, n);
+            for (size_t j = 0; j < n; j++) row[j] += products[j];
+        }
+        if (job->cancel) vedic_cancel_add_progress(job->cancel, 1);
     }
+    if (job->cancel) vedic_cancel_add_progress(&job->done, i - begin);
     
-    // Update learning statistics
-    learning_stats.total_operations++;
-    learning_stats.average_speedup_achieved = 
-        (learning_stats.average_speedup_achieved * (learning_stats.total_operations - 1) + actual_speedup) 
-        / learning_stats.total_operations;
+    VEDIC_FREE(broadcast);
+    VEDIC_ALLOC_SCOPE_END();
+}
+
+/**
+ * Implementation of unified_matrix_multiply (see below)
+ */
+static UnifiedDispatchResult matrix_multiply_impl(const MatrixOperationParams* params) {
+    UnifiedDispatchResult result = {0};
+    result.operation_type = OPERATION_MATRIX;
+    result.timestamp = time(NULL);
+    result.result = vedic_from_int32(0);
     
-    if (final_choice.recommended_sutra != SUTRA_STANDARD) {
-        learning_stats.vedic_methods_used++;
-    } else {
-        learning_stats.standard_fallbacks++;
+    if (!params || !params->matrix_a || !params->matrix_b || !params->result_matrix ||
+        params->cols_a != params->rows_b) {
+        result.selected_algorithm = "Error: Invalid matrix dimensions";
+        return result;
     }
     
+    size_t m = params->rows_a, inner = params->cols_a, n = params->cols_b;
+    size_t a_count = m * inner, b_count = inner * n, c_count = m * n;
+    size_t bytes = sizeof(long) * (a_count + b_count + 2 * c_count);
+    long* a = VEDIC_MALLOC(bytes ? bytes : 1);
+    if (!a) {
+        result.selected_algorithm = "Error: Out of memory";
+        return result;
+    }
+    long* b = a + a_count;
+    long* c = b + b_count;
+    long* check = c + c_count;
+    for (size_t i = 0; i < b_count; i++) b[i] = vedic_to_int64(params->matrix_b[i]);
+    
+    DISPATCH_LOCK();
+    bool validate = global_config.validate_all_operations;
+    double min_speedup = global_config.min_speedup_threshold;
+    DISPATCH_UNLOCK();
+    
+    // Rows run on the thread pool; the dispatcher lock is not held meanwhile
+    MatrixRows job = {a, b, c, inner, n, params->cancel, {0, 0, 0}};
+    size_t row_work = inner * n;
+    size_t grain = (row_work == 0 || row_work >= MATRIX_RANGE_WORK) ? 1 : MATRIX_RANGE_WORK / row_work;
+    MatrixLoad load = {params->matrix_a, a, inner};
+    vedic_pool_parallel_for(m, grain, matrix_load_range, &load);
+    double start = dispatch_now_ms();
+    vedic_pool_parallel_for(m, grain, matrix_rows_range, &job);
+    double vedic_time = dispatch_now_ms() - start;
+    
+    if (job.cancel && vedic_cancel_progress(&job.done) != m) {
+        VEDIC_FREE(a);
+        result.selected_algorithm = vedic_cancel_check(job.cancel) == VEDIC_CANCEL_DEADLINE
+                                        ? "Error: Deadline exceeded" : "Error: Cancelled";
+        result.execution_time_ms = vedic_time;
+        return result;
+    }
+    
+    bool correct = true;
+    double standard_time = vedic_time;
+    if (validate) {
+        start = dispatch_now_ms();
+        for (size_t i = 0; i < m; i++) {
+            long* row = check + i * n;
+            for (size_t j = 0; j < n; j++) row[j] = 0;
+            for (size_t k = 0; k < inner; k++) {
+                long value = a[i * inner + k];
+                for (size_t j = 0; j < n; j++) row[j] += value * b[k * n + j];
+            }
+        }
+        standard_time = dispatch_now_ms() - start;
+        correct = memcmp(check, c, sizeof(long) * c_count) == 0;
+    }
+    
+    long checksum = 0;
+    for (size_t i = 0; i < c_count; i++) {
+        params->result_matrix[i] = vedic_from_int64(c[i]);
+        checksum += c[i];
+    }
+    VEDIC_FREE(a);
+    
+    result.result = vedic_from_int64(checksum);
+    result.selected_algorithm = "Pattern-partitioned Vedic batch";
+    result.sutra_name_sanskrit = "";
+    result.pattern_confidence = 1.0;
+    result.predicted_speedup = 1.0;
+    result.actual_speedup = (vedic_time > 0 && standard_time > 0) ? standard_time / vedic_time : 1.0;
+    result.decision_reasoning = "Each row of B is one batch multiply; every element picks its own sutra";
+    result.execution_time_ms = vedic_time;
+    result.standard_execution_time_ms = standard_time;
+    result.memory_used_bytes = bytes;
+    result.correctness_verified = correct;
+    result.performance_expectation_met = (result.actual_speedup >= min_speedup);
+#ifdef _WIN32
+    result.platform_info = "Windows";
+#else
+    result.platform_info = "Generic";
+#endif
+    
+    DISPATCH_LOCK();
+    result.operation_id = ++operation_counter;
+    result.total_operations_count = operation_counter;
+    DISPATCH_UNLOCK();
+    count_dispatch_metrics(1, 1, vedic_time, standard_time);
+    return result;
+}
+
+UnifiedDispatchResult unified_matrix_multiply(const MatrixOperationParams* params) {
+    VEDIC_ALLOC_SCOPE_BEGIN("unified_matrix_multiply");
+    UnifiedDispatchResult result = matrix_multiply_impl(params);
+    VEDIC_ALLOC_SCOPE_END();
     return result;
 }
 
 // ============================================================================
-// CONVENIENT WRAPPER FUNCTIONS
+// DATASET GENERATION
 // ============================================================================
 
-UnifiedDispatchResult unified_multiply(VedicValue a, VedicValue b) {
-    VedicValue operands[] = {a, b};
-    return unified_dispatch_execute(OPERATION_ARITHMETIC, operands, 2, "multiply");
+#define DATASET_CHUNK 1024
+#define DATASET_CHECK 16               // Records between cancellation checks
+
+static const char* const dataset_pattern_names[DATASET_PATTERN_COUNT] = {
+    "ekadhikena", "nikhilam", "antyayordasake", "urdhva", "random"
+};
+
+const char* unified_dispatch_pattern_name(DatasetPattern pattern) {
+    if ((int)pattern < 0 || pattern >= DATASET_PATTERN_COUNT) return "unknown";
+    return dataset_pattern_names[pattern];
+}
+
+const char* unified_dispatch_sutra_type_to_string(VedicSutraType sutra_type) {
+    switch (sutra_type) {
+        case SUTRA_EKADHIKENA_PURVENA: return "Ekadhikena Purvena";
+        case SUTRA_NIKHILAM: return "Nikhilam";
+        case SUTRA_ANTYAYORDASAKE: return "Antyayordasake";
+        case SUTRA_URDHVA_TIRYAGBHYAM: return "Urdhva-Tiryagbhyam";
+        case SUTRA_PARAVARTYA_YOJAYET: return "Paravartya Yojayet";
+        case SUTRA_DHVAJANKA: return "Dhvajanka";
+        case SUTRA_NIKHILAM_DIVISION: return "Nikhilam Division";
+        case SUTRA_STANDARD: return "Standard Arithmetic";
+        default: return "Unknown";
+    }
+}
+
+/**
+ * @brief xorshift64* step; the caller owns the state
+ */
+static uint64_t dataset_next(uint64_t* state) {
+    uint64_t x = *state ? *state : 0x9e3779b97f4a7c15ULL;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545f4914f6cdd1dULL;
+}
+
+/**
+ * @brief Uniform integer in [low, high]
+ */
+static long dataset_uniform(uint64_t* state, long low, long high) {
+    return low + (long)(dataset_next(state) % (uint64_t)(high - low + 1));
+}
+
+/**
+ * @brief Shared by the generate functions; stops between records once the
+ * token says so, leaving *seed just past the last record written
+ */
+static size_t generate_records(DatasetRecord* records, size_t count, uint64_t* seed,
+                               unsigned pattern_mask, VedicCancelToken* cancel) {
+    DatasetPattern enabled[DATASET_PATTERN_COUNT];
+    size_t enabled_count = 0;
+    pattern_mask &= DATASET_PATTERN_ALL;
+    if (pattern_mask == 0) pattern_mask = DATASET_PATTERN_ALL;
+    for (int p = 0; p < DATASET_PATTERN_COUNT; p++) {
+        if (pattern_mask & (1u << p)) enabled[enabled_count++] = (DatasetPattern)p;
+    }
+    
+    DISPATCH_LOCK();
+    double confidence_threshold = global_config.confidence_threshold;
+    DISPATCH_UNLOCK();
+    
+    uint64_t vedic_operations = 0;
+    double vedic_ms = 0.0, standard_ms = 0.0;
+    size_t i, reported = 0;
+    for (i = 0; i < count; i++) {
+        if (cancel && i % DATASET_CHECK == 0) {
+            vedic_cancel_add_progress(cancel, i - reported);
+            reported = i;
+            if (vedic_cancel_check(cancel) != VEDIC_CANCEL_NONE) break;
+        }
+        DatasetRecord* record = &records[i];
+        DatasetPattern pattern = enabled[dataset_next(seed) % enabled_count];
+        long a, b;
+        
+        switch (pattern) {
+            case DATASET_PATTERN_EKADHIKENA:
+                a = b = dataset_uniform(seed, 1, 50) * 10 + 5;
+                break;
+            case DATASET_PATTERN_NIKHILAM: {
+                long base = (dataset_next(seed) & 1) ? 1000 : 100;
+                a = base + dataset_uniform(seed, -base / 5, base / 5);
+                b = base + dataset_uniform(seed, -base / 5, base / 5);
+                break;
+            }
+            case DATASET_PATTERN_ANTYAYORDASAKE: {
+                long prefix = dataset_uniform(seed, 1, 99);
+                long last = dataset_uniform(seed, 1, 9);
+                a = prefix * 10 + last;
+                b = prefix * 10 + (10 - last);
+                break;
+            }
+            case DATASET_PATTERN_URDHVA:
+                a = dataset_uniform(seed, 1000, 9999);
+                b = dataset_uniform(seed, 1000, 9999);
+                break;
+            default:
+                a = dataset_uniform(seed, 1, 1000);
+                b = dataset_uniform(seed, 1, 1000);
+                break;
+        }
+        
+        // Same selection as unified_multiply, minus the learning state
+        EnhancedPatternResult choice = detect_optimal_pattern(a, b);
+        if (choice.confidence_score < confidence_threshold) {
+            choice.recommended_sutra = SUTRA_STANDARD;
+            choice.confidence_score = 1.0;
+            choice.predicted_speedup = 1.0;
+        }
+        
+        double vedic_time, standard_time;
+        long product = execute_selected_sutra(a, b, choice.recommended_sutra, &vedic_time);
+        long expected = execute_standard(a, b, &standard_time);
+        
+        record->operand_a = a;
+        record->operand_b = b;
+        record->result = product;
+        record->pattern = pattern;
+        record->sutra = choice.recommended_sutra;
+        record->confidence = choice.confidence_score;
+        record->predicted_speedup = choice.predicted_speedup;
+        record->execution_time_ms = vedic_time;
+        record->standard_execution_time_ms = standard_time;
+        record->correct = (product == expected);
+        
+        vedic_operations += choice.recommended_sutra != SUTRA_STANDARD;
+        vedic_ms += vedic_time;
+        standard_ms += standard_time;
+    }
+    vedic_cancel_add_progress(cancel, i - reported);
+    count_dispatch_metrics(i, vedic_operations, vedic_ms, standard_ms);
+    return i;
+}
+
+size_t unified_dispatch_generate_records(DatasetRecord* records, size_t count,
+                                         uint64_t* seed, unsigned pattern_mask) {
+    return generate_records(records, count, seed, pattern_mask, NULL);
+}
+
+size_t unified_dispatch_generate_records_cancellable(DatasetRecord* records, size_t count, uint64_t* seed,
+                                                     unsigned pattern_mask, VedicCancelToken* cancel) {
+    return generate_records(records, count, seed, pattern_mask, cancel);
+}
+
+void unified_dispatch_summarize_records(DatasetSummary* summary, const DatasetRecord* records, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const DatasetRecord* record = &records[i];
+        summary->records++;
+        if (record->sutra != SUTRA_STANDARD) summary->vedic_methods_used++;
+        if (record->correct) summary->correct++;
+        summary->speedup_sum += (record->execution_time_ms > 0 && record->standard_execution_time_ms > 0)
+            ? record->standard_execution_time_ms / record->execution_time_ms : 1.0;
+        if ((int)record->pattern >= 0 && record->pattern < DATASET_PATTERN_COUNT) {
+            summary->pattern_counts[record->pattern]++;
+        }
+        if ((int)record->sutra >= 0 && record->sutra < MAX_SUTRA_TYPES) {
+            summary->sutra_counts[record->sutra]++;
+        }
+    }
+}
+
+int unified_dispatch_format_record(char* buffer, size_t size, const DatasetRecord* r, DatasetFormat format) {
+    const char* sutra = unified_dispatch_sutra_type_to_string(r->sutra);
+    const char* pattern = unified_dispatch_pattern_name(r->pattern);
+    if (format == DATASET_FORMAT_NDJSON) {
+        return snprintf(buffer, size,
+                        "{\"operand_a\":%lld,\"operand_b\":%lld,\"result\":%lld,\"sutra_used\":\"%s\","
+                        "\"pattern_type\":\"%s\",\"confidence\":%.4f,\"predicted_speedup\":%.2f,"
+                        "\"execution_time_ms\":%.6f,\"standard_time_ms\":%.6f,\"correct\":%s}\n",
+                        (long long)r->operand_a, (long long)r->operand_b, (long long)r->result, sutra, pattern,
+                        r->confidence, r->predicted_speedup, r->execution_time_ms,
+                        r->standard_execution_time_ms, r->correct ? "true" : "false");
+    }
+    return snprintf(buffer, size, "%lld,%lld,%lld,%s,%s,%.4f,%.2f,%.6f,%.6f,%d\n",
+                    (long long)r->operand_a, (long long)r->operand_b, (long long)r->result, sutra, pattern,
+                    r->confidence, r->predicted_speedup, r->execution_time_ms,
+                    r->standard_execution_time_ms, r->correct ? 1 : 0);
+}
+
+int unified_dispatch_write_dataset(const char* filename, size_t count, uint64_t seed,
+                                   unsigned pattern_mask, DatasetSummary* summary) {
+    return unified_dispatch_write_dataset_cancellable(filename, count, seed, pattern_mask, summary, NULL);
+}
+
+int unified_dispatch_write_dataset_cancellable(const char* filename, size_t count, uint64_t seed,
+                                               unsigned pattern_mask, DatasetSummary* summary,
+                                               VedicCancelToken* cancel) {
+    FILE* file = fopen(filename, "w");
+    if (!file) return -1;
+    
+    VEDIC_ALLOC_SCOPE_BEGIN("unified_dispatch_write_dataset");
+    DatasetRecord* chunk = VEDIC_MALLOC(sizeof(DatasetRecord) * DATASET_CHUNK);
+    VEDIC_ALLOC_SCOPE_END();
+    if (!chunk) {
+        fclose(file);
+        return -1;
+    }
+    
+    fputs(DATASET_CSV_HEADER, file);
+    int stopped = 0;
+    for (size_t done = 0; done < count && !stopped; ) {
+        size_t wanted = count - done < DATASET_CHUNK ? count - done : DATASET_CHUNK;
+        size_t size = generate_records(chunk, wanted, &seed, pattern_mask, cancel);
+        stopped = size < wanted;
+        if (summary) unified_dispatch_summarize_records(summary, chunk, size);
+        
+        char line[DATASET_RECORD_MAX_TEXT];
+        for (size_t i = 0; i < size; i++) {
+            unified_dispatch_format_record(line, sizeof(line), &chunk[i], DATASET_FORMAT_CSV);
+            fputs(line, file);
+        }
+        done += size;
+    }
+    
+    VEDIC_FREE(chunk);
+    if (fclose(file) != 0) return -1;
+    return stopped ? 1 : 0;
 }
 
 // ============================================================================
 // LEARNING AND STATISTICS INTERFACE
 // ============================================================================
 
-LearningStatistics unified_dispatch_get_learning_stats(void) {
+/**
+ * Implementation of unified_dispatch_get_learning_stats (see below)
+ */
+static LearningStatistics learning_stats_impl(void) {
     learning_stats.pattern_recognition_accuracy = 
         learning_stats.total_operations > 0 ? 
         (double)learning_stats.vedic_methods_used / learning_stats.total_operations : 0.0;
@@ -608,7 +1220,17 @@ LearningStatistics unified_dispatch_get_learning_stats(void) {
     return learning_stats;
 }
 
-int unified_dispatch_export_research_dataset(const char* filename) {
+LearningStatistics unified_dispatch_get_learning_stats(void) {
+    DISPATCH_LOCK();
+    LearningStatistics stats = learning_stats_impl();
+    DISPATCH_UNLOCK();
+    return stats;
+}
+
+/**
+ * Implementation of unified_dispatch_export_research_dataset (see below)
+ */
+static int export_dataset_impl(const char* filename) {
     if (!research_dataset || dataset_size == 0) {
         printf("❌ No research dataset available for export\n");
         return -1;
@@ -652,20 +1274,30 @@ int unified_dispatch_export_research_dataset(const char* filename) {
     return 0;
 }
 
+int unified_dispatch_export_research_dataset(const char* filename) {
+    DISPATCH_LOCK();
+    int result = export_dataset_impl(filename);
+    DISPATCH_UNLOCK();
+    return result;
+}
+
 // ============================================================================
 // CLEANUP AND FINALIZATION
 // ============================================================================
 
-void unified_dispatch_finalize(const char* final_dataset_filename) {
+/**
+ * Implementation of unified_dispatch_finalize (see below)
+ */
+static void dispatch_finalize_impl(const char* final_dataset_filename) {
     printf("\n🏁 Unified Dispatcher Finalization\n");
     
     // Export final dataset
     if (final_dataset_filename) {
-        unified_dispatch_export_research_dataset(final_dataset_filename);
+        export_dataset_impl(final_dataset_filename);
     }
     
     // Print final statistics
-    LearningStatistics final_stats = unified_dispatch_get_learning_stats();
+    LearningStatistics final_stats = learning_stats_impl();
     printf("\n📊 FINAL PERFORMANCE ANALYSIS:\n");
     printf("   Total Operations: %zu\n", final_stats.total_operations);
     printf("   Average Speedup: %.2fx\n", final_stats.average_speedup_achieved);
@@ -684,14 +1316,14 @@ void unified_dispatch_finalize(const char* final_dataset_filename) {
 #endif
     
     if (research_dataset) {
-        free(research_dataset);
+        VEDIC_FREE(research_dataset);
         research_dataset = NULL;
         dataset_size = 0;
         dataset_capacity = 0;
     }
     
     if (pattern_history) {
-        free(pattern_history);
+        VEDIC_FREE(pattern_history);
         pattern_history = NULL;
         pattern_history_size = 0;
         pattern_history_capacity = 0;
@@ -700,22 +1332,44 @@ void unified_dispatch_finalize(const char* final_dataset_filename) {
     printf("✓ Unified Dispatcher cleanup complete\n");
 }
 
+void unified_dispatch_finalize(const char* final_dataset_filename) {
+    VEDIC_ALLOC_SCOPE_BEGIN("unified_dispatch_finalize");
+    DISPATCH_LOCK();
+    dispatch_finalize_impl(final_dataset_filename);
+    DISPATCH_UNLOCK();
+    VEDIC_ALLOC_SCOPE_END();
+}
+
 // ============================================================================
 // CONFIGURATION AND RUNTIME UPDATES
 // ============================================================================
 
+void unified_dispatch_update_config(const UnifiedDispatchConfig* new_config) {
+    if (new_config) {
+        DISPATCH_LOCK();
+        global_config = *new_config;
+        DISPATCH_UNLOCK();
+    }
+}
+
 void unified_dispatch_set_mode(UnifiedDispatchMode mode) {
+    DISPATCH_LOCK();
     global_config.mode = mode;
+    DISPATCH_UNLOCK();
     printf("🔧 Dispatch mode changed to: %d\n", mode);
 }
 
 void unified_dispatch_enable_learning(bool enable) {
+    DISPATCH_LOCK();
     global_config.enable_learning = enable;
+    DISPATCH_UNLOCK();
     printf("🧠 Learning system: %s\n", enable ? "Enabled" : "Disabled");
 }
 
 UnifiedDispatchConfig unified_dispatch_get_preset_config(const char* use_case) {
+    DISPATCH_LOCK();
     UnifiedDispatchConfig preset = global_config; // Start with current config
+    DISPATCH_UNLOCK();
     
     if (strcmp(use_case, "research") == 0) {
         preset.mode = DISPATCH_MODE_RESEARCH;
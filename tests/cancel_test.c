@@ -0,0 +1,184 @@
+/**
+ * cancel_test.c - Cooperative cancellation and deadlines
+ *
+ * Checks the token itself, then that each cancellable API runs to the end
+ * with a live token, does no work with a cancelled one, and stops a call
+ * far too large for its deadline partway with its progress reported, and
+ * that the pool is free for the next call afterwards.
+ */
+
+#include "vedicmath.h"
+#include "vedicmath_cancel.h"
+#include "vedicmath_optimized.h"
+#include "unified_adaptive_dispatcher.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define BATCH_COUNT 100000
+#define EVALUATE_COUNT 200000        // Far more than a few milliseconds of parsing
+#define MATRIX_SIZE 400
+#define DATASET_COUNT 1000000
+
+static int failures = 0;
+
+static void check(const char* name, int passed) {
+    printf("[%s] %s\n", passed ? "PASS" : "FAIL", name);
+    if (!passed) failures++;
+}
+
+static void test_token(void) {
+    VedicCancelToken token;
+    vedic_cancel_init(&token, 0);
+    check("fresh token does not stop", vedic_cancel_check(&token) == VEDIC_CANCEL_NONE);
+    vedic_cancel(&token);
+    vedic_cancel(&token);
+    check("cancel is latched", vedic_cancel_check(&token) == VEDIC_CANCEL_REQUESTED);
+
+    vedic_cancel_init(&token, 1);
+    usleep(3000);
+    check("deadline passes", vedic_cancel_check(&token) == VEDIC_CANCEL_DEADLINE);
+    vedic_cancel(&token);
+    check("cancel after the deadline keeps the first reason", vedic_cancel_check(&token) == VEDIC_CANCEL_DEADLINE);
+
+    vedic_cancel_add_progress(&token, 5);
+    vedic_cancel_add_progress(NULL, 5);
+    check("progress and NULL tokens",
+          vedic_cancel_progress(&token) == 5 && vedic_cancel_check(NULL) == VEDIC_CANCEL_NONE);
+}
+
+static void test_multiply_batch(void) {
+    long* a = (long*)malloc(BATCH_COUNT * sizeof(long));
+    long* b = (long*)malloc(BATCH_COUNT * sizeof(long));
+    long* results = (long*)malloc(BATCH_COUNT * sizeof(long));
+    for (int i = 0; i < BATCH_COUNT; i++) {
+        a[i] = 95 + i % 900;
+        b[i] = 105 - i % 17;
+    }
+
+    VedicCancelToken token;
+    vedic_cancel_init(&token, 60000);
+    VedicCancelReason reason = vedic_multiply_batch_cancellable(results, a, b, BATCH_COUNT, &token);
+    int matches = 1;
+    for (int i = 0; i < BATCH_COUNT; i++) matches &= results[i] == vedic_multiply(a[i], b[i]);
+    check("batch runs to the end with a live token",
+          reason == VEDIC_CANCEL_NONE && matches && vedic_cancel_progress(&token) == BATCH_COUNT);
+
+    vedic_cancel_init(&token, 0);
+    vedic_cancel(&token);
+    check("cancelled token: batch does no work",
+          vedic_multiply_batch_cancellable(results, a, b, BATCH_COUNT, &token) == VEDIC_CANCEL_REQUESTED &&
+          vedic_cancel_progress(&token) == 0);
+    check("NULL token runs to the end",
+          vedic_multiply_batch_cancellable(results, a, b, BATCH_COUNT, NULL) == VEDIC_CANCEL_NONE);
+
+    free(a);
+    free(b);
+    free(results);
+}
+
+static void test_evaluate_batch(void) {
+    // Distinct expressions, so nothing is served from a cache
+    const char** expressions = (const char**)malloc(EVALUATE_COUNT * sizeof(char*));
+    char* text = (char*)malloc(EVALUATE_COUNT * 16);
+    VedicValue* results = (VedicValue*)malloc(EVALUATE_COUNT * sizeof(VedicValue));
+    for (int i = 0; i < EVALUATE_COUNT; i++) {
+        snprintf(text + (size_t)i * 16, 16, "%d * 96", 100 + i);
+        expressions[i] = text + (size_t)i * 16;
+    }
+
+    VedicCancelToken token;
+    vedic_cancel_init(&token, 5);
+    VedicCancelReason reason = vedic_optimized_evaluate_batch_cancellable(results, expressions,
+                                                                          EVALUATE_COUNT, &token);
+    uint64_t done = vedic_cancel_progress(&token);
+    check("evaluate batch stops at its deadline with partial progress",
+          reason == VEDIC_CANCEL_DEADLINE && done > 0 && done < EVALUATE_COUNT);
+
+    // The pool is free again at once
+    vedic_cancel_init(&token, 0);
+    reason = vedic_optimized_evaluate_batch_cancellable(results, expressions, 1000, &token);
+    check("next batch completes", reason == VEDIC_CANCEL_NONE && vedic_cancel_progress(&token) == 1000 &&
+                                  vedic_to_int64(results[999]) == 1099 * 96);
+
+    free(expressions);
+    free(text);
+    free(results);
+}
+
+static void test_matrix(void) {
+    size_t cells = (size_t)MATRIX_SIZE * MATRIX_SIZE;
+    VedicValue* a = (VedicValue*)malloc(cells * sizeof(VedicValue));
+    VedicValue* c = (VedicValue*)malloc(cells * sizeof(VedicValue));
+    for (size_t i = 0; i < cells; i++) a[i] = vedic_from_int64((long)(i % 2000) - 1000);
+
+    VedicCancelToken token;
+    vedic_cancel_init(&token, 5);
+    MatrixOperationParams params = {MATRIX_SIZE, MATRIX_SIZE, MATRIX_SIZE, MATRIX_SIZE, a, a, c, &token};
+    UnifiedDispatchResult result = unified_matrix_multiply(&params);
+    uint64_t rows = vedic_cancel_progress(&token);
+    check("matrix product stops at its deadline",
+          strcmp(result.selected_algorithm, "Error: Deadline exceeded") == 0 && rows < MATRIX_SIZE);
+
+    MatrixOperationParams small = {3, 3, 3, 3, a, a, c, &token};
+    vedic_cancel_init(&token, 0);
+    result = unified_matrix_multiply(&small);
+    check("small product completes and counts its rows",
+          strncmp(result.selected_algorithm, "Error", 5) != 0 && vedic_cancel_progress(&token) == 3);
+
+    free(a);
+    free(c);
+}
+
+static void test_dataset(void) {
+    // Stopping leaves the seed at the next record, so generation resumes exactly
+    DatasetRecord* expected = (DatasetRecord*)malloc(200 * sizeof(DatasetRecord));
+    DatasetRecord* resumed = (DatasetRecord*)malloc(200 * sizeof(DatasetRecord));
+    uint64_t seed = 42, resume_seed = 42;
+    unified_dispatch_generate_records(expected, 200, &seed, 0);
+
+    VedicCancelToken token;
+    vedic_cancel_init(&token, 0);
+    size_t first = unified_dispatch_generate_records_cancellable(resumed, 100, &resume_seed, 0, &token);
+    vedic_cancel(&token);
+    size_t none = unified_dispatch_generate_records_cancellable(resumed + first, 100, &resume_seed, 0, &token);
+    unified_dispatch_generate_records(resumed + first, 200 - first, &resume_seed, 0);
+    int same = first == 100 && none == 0;
+    for (int i = 0; i < 200; i++) {
+        same &= resumed[i].operand_a == expected[i].operand_a && resumed[i].operand_b == expected[i].operand_b;
+    }
+    check("cancelled generation resumes from the seed", same && vedic_cancel_progress(&token) == 100);
+    free(expected);
+    free(resumed);
+
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/vedicmath_cancel_%ld.csv", (long)getpid());
+    DatasetSummary summary;
+    memset(&summary, 0, sizeof(summary));
+    vedic_cancel_init(&token, 10);
+    int status = unified_dispatch_write_dataset_cancellable(path, DATASET_COUNT, 7, 0, &summary, &token);
+
+    size_t lines = 0;
+    FILE* file = fopen(path, "r");
+    for (int ch; file && (ch = fgetc(file)) != EOF; ) lines += ch == '\n';
+    if (file) fclose(file);
+    remove(path);
+    check("dataset stops at its deadline with every written record counted",
+          status == 1 && summary.records > 0 && summary.records < DATASET_COUNT &&
+          summary.records == vedic_cancel_progress(&token) && lines == summary.records + 1);
+}
+
+int main(void) {
+    unified_dispatch_init(NULL);
+    test_token();
+    test_multiply_batch();
+    test_evaluate_batch();
+    test_matrix();
+    test_dataset();
+    unified_dispatch_finalize(NULL);
+
+    printf("%s\n", failures ? "Cancel tests FAILED" : "All cancel tests passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,268 @@
+/**
+ * executor_test.c - Lock-free MPMC queue and the micro-batching executor
+ *
+ * Pushes and pops from several threads at once and checks every item
+ * arrives exactly once, then has several producers submit mixed scalar
+ * requests to an executor and checks each result against the scalar API,
+ * that requests were coalesced into batches, and that destroy finishes
+ * whatever is still queued.
+ */
+
+#include "vedicmath.h"
+#include "vedicmath_executor.h"
+#include "vedicmath_optimized.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define QUEUE_THREADS 4
+#define QUEUE_ITEMS 50000            // Per producer
+#define PRODUCERS 4
+#define REQUESTS 20000               // Per producer
+#define WINDOW 512                   // Requests in flight per producer
+
+static int failures = 0;
+
+static void check(const char* name, int passed) {
+    printf("[%s] %s\n", passed ? "PASS" : "FAIL", name);
+    if (!passed) failures++;
+}
+
+// ============================================================================
+// QUEUE
+// ============================================================================
+
+typedef struct {
+    VedicMpmcQueue* queue;
+    int id;
+    uint64_t sum;                    // Consumers: sum of the items taken
+    uint64_t count;
+} QueueWorker;
+
+static volatile int producers_left;
+
+static void* queue_producer(void* argument) {
+    QueueWorker* worker = (QueueWorker*)argument;
+    for (uintptr_t i = 1; i <= QUEUE_ITEMS; i++) {
+        uintptr_t item = (uintptr_t)worker->id * QUEUE_ITEMS + i;
+        while (vedic_mpmc_push(worker->queue, (void*)item) != 0) {
+            sched_yield();
+        }
+    }
+    __atomic_fetch_sub(&producers_left, 1, __ATOMIC_SEQ_CST);
+    return NULL;
+}
+
+static void* queue_consumer(void* argument) {
+    QueueWorker* worker = (QueueWorker*)argument;
+    void* item;
+    for (;;) {
+        if (vedic_mpmc_pop(worker->queue, &item) == 0) {
+            worker->sum += (uint64_t)(uintptr_t)item;
+            worker->count++;
+        } else if (__atomic_load_n(&producers_left, __ATOMIC_SEQ_CST) == 0) {
+            // Everything has been pushed: drain the rest and stop
+            while (vedic_mpmc_pop(worker->queue, &item) == 0) {
+                worker->sum += (uint64_t)(uintptr_t)item;
+                worker->count++;
+            }
+            return NULL;
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+static void test_queue(void) {
+    VedicMpmcQueue* queue = vedic_mpmc_create(5);
+    check("capacity rounded to a power of two", queue && vedic_mpmc_capacity(queue) == 8);
+    if (!queue) return;
+
+    void* item = NULL;
+    int ordered = vedic_mpmc_pop(queue, &item) != 0;
+    for (uintptr_t i = 1; i <= 8; i++) ordered &= vedic_mpmc_push(queue, (void*)i) == 0;
+    check("full queue refuses a push", ordered && vedic_mpmc_push(queue, (void*)9) != 0);
+    for (uintptr_t i = 1; i <= 8; i++) {
+        ordered &= vedic_mpmc_pop(queue, &item) == 0 && (uintptr_t)item == i;
+    }
+    check("single-threaded FIFO", ordered && vedic_mpmc_pop(queue, &item) != 0);
+    vedic_mpmc_destroy(queue);
+
+    // Concurrent producers and consumers on a small queue, so it wraps often
+    queue = vedic_mpmc_create(64);
+    QueueWorker producers[QUEUE_THREADS], consumers[QUEUE_THREADS];
+    pthread_t threads[2 * QUEUE_THREADS];
+    producers_left = QUEUE_THREADS;
+    for (int t = 0; t < QUEUE_THREADS; t++) {
+        producers[t] = (QueueWorker){queue, t, 0, 0};
+        consumers[t] = (QueueWorker){queue, t, 0, 0};
+        pthread_create(&threads[t], NULL, queue_producer, &producers[t]);
+        pthread_create(&threads[QUEUE_THREADS + t], NULL, queue_consumer, &consumers[t]);
+    }
+    uint64_t sum = 0, count = 0;
+    for (int t = 0; t < 2 * QUEUE_THREADS; t++) pthread_join(threads[t], NULL);
+    for (int t = 0; t < QUEUE_THREADS; t++) {
+        sum += consumers[t].sum;
+        count += consumers[t].count;
+    }
+    uint64_t n = (uint64_t)QUEUE_THREADS * QUEUE_ITEMS;
+    check("concurrent push/pop delivers every item once", count == n && sum == n * (n + 1) / 2);
+    vedic_mpmc_destroy(queue);
+}
+
+// ============================================================================
+// EXECUTOR
+// ============================================================================
+
+typedef struct {
+    VedicExecutor* executor;
+    int id;
+    int wrong;
+    int refused;
+} Producer;
+
+static void make_request(VedicExecRequest* request, int id, int i) {
+    memset(request, 0, sizeof(*request));
+    long x = (long)(i % 997) + id * 13 - 200;
+    long y = (long)(i % 89) + 90;
+    switch (i % 5) {
+        case 0:
+        case 1:
+            request->op = VEDIC_EXEC_MULTIPLY;
+            request->a = vedic_from_int64(x);
+            request->b = vedic_from_int32((int32_t)y);
+            break;
+        case 2:
+            request->op = VEDIC_EXEC_SQUARE;
+            request->a = vedic_from_int64(x * 10 + 5);
+            break;
+        case 3:
+            request->op = VEDIC_EXEC_DIVIDE;
+            request->a = vedic_from_int64(x * 1000);
+            request->b = vedic_from_int64(i % 50 == 3 ? 0 : y - 100);
+            break;
+        default:
+            request->op = VEDIC_EXEC_MULTIPLY;
+            request->a = vedic_from_double(x + 0.5);
+            request->b = vedic_from_int32((int32_t)y);
+            break;
+    }
+}
+
+static int request_correct(const VedicExecRequest* request, VedicExecStatus status) {
+    long a = (long)vedic_to_int64(request->a);
+    long b = (long)vedic_to_int64(request->b);
+    switch (request->op) {
+        case VEDIC_EXEC_MULTIPLY:
+            if (request->a.type == VEDIC_FLOAT || request->a.type == VEDIC_DOUBLE) {
+                VedicValue expected = vedic_optimized_multiply(request->a, request->b);
+                return status == VEDIC_EXEC_DONE && request->result.type == expected.type &&
+                       vedic_to_double(request->result) == vedic_to_double(expected);
+            }
+            return status == VEDIC_EXEC_DONE && vedic_to_int64(request->result) == vedic_multiply(a, b);
+        case VEDIC_EXEC_SQUARE:
+            return status == VEDIC_EXEC_DONE && vedic_to_int64(request->result) == vedic_square(a);
+        case VEDIC_EXEC_DIVIDE: {
+            if (b == 0) return status == VEDIC_EXEC_FAILED;
+            long remainder;
+            long quotient = vedic_divide(a, b, &remainder);
+            return status == VEDIC_EXEC_DONE && vedic_to_int64(request->result) == quotient &&
+                   request->remainder == remainder;
+        }
+        default:
+            return 0;
+    }
+}
+
+static void* executor_producer(void* argument) {
+    Producer* producer = (Producer*)argument;
+    VedicExecRequest* requests = (VedicExecRequest*)malloc(WINDOW * sizeof(VedicExecRequest));
+
+    // Keep a window of requests in flight, then wait for all of it
+    for (int base = 0; base < REQUESTS; base += WINDOW) {
+        int size = REQUESTS - base < WINDOW ? REQUESTS - base : WINDOW;
+        for (int i = 0; i < size; i++) {
+            make_request(&requests[i], producer->id, base + i);
+            while (vedic_exec_submit(producer->executor, &requests[i]) != 0) {
+                producer->refused++;         // Queue full: let the consumers catch up
+                sched_yield();
+            }
+        }
+        for (int i = 0; i < size; i++) {
+            VedicExecStatus status = vedic_exec_wait(producer->executor, &requests[i]);
+            producer->wrong += !request_correct(&requests[i], status);
+        }
+    }
+    free(requests);
+    return NULL;
+}
+
+static int callbacks = 0;
+
+static void count_callback(VedicExecRequest* request, VedicExecStatus status, void* user_data) {
+    (void)request;
+    if (status == VEDIC_EXEC_DONE && user_data == &callbacks) {
+        __atomic_fetch_add(&callbacks, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+static void test_executor(unsigned linger_us, int consumers) {
+    char name[96];
+    VedicExecutorConfig config = {1024, 128, linger_us, consumers};
+    VedicExecutor* executor = vedic_executor_create(&config);
+    snprintf(name, sizeof(name), "create executor (linger %u us, %d consumers)", linger_us, consumers);
+    check(name, executor != NULL);
+    if (!executor) return;
+
+    Producer producers[PRODUCERS];
+    pthread_t threads[PRODUCERS];
+    for (int t = 0; t < PRODUCERS; t++) {
+        producers[t] = (Producer){executor, t, 0, 0};
+        pthread_create(&threads[t], NULL, executor_producer, &producers[t]);
+    }
+    int wrong = 0;
+    for (int t = 0; t < PRODUCERS; t++) {
+        pthread_join(threads[t], NULL);
+        wrong += producers[t].wrong;
+    }
+    VedicExecutorStats stats = vedic_executor_get_stats(executor);
+    snprintf(name, sizeof(name), "every result matches the scalar API (%llu requests in %llu batches, largest %llu)",
+             (unsigned long long)stats.completed, (unsigned long long)stats.batches,
+             (unsigned long long)stats.largest_batch);
+    check(name, wrong == 0 && stats.completed == (uint64_t)PRODUCERS * REQUESTS &&
+                stats.submitted == stats.completed);
+    check("requests coalesced into micro-batches",
+          stats.batches < stats.completed && stats.largest_batch > 1 && stats.largest_batch <= 128);
+
+    // Requests still queued when the executor is destroyed are finished
+    VedicExecRequest tail[64];
+    int queued = 1;
+    callbacks = 0;
+    for (int i = 0; i < 64; i++) {
+        make_request(&tail[i], 0, i * 5);
+        tail[i].callback = count_callback;
+        tail[i].user_data = &callbacks;
+        queued &= vedic_exec_submit(executor, &tail[i]) == 0;
+    }
+    vedic_executor_destroy(executor);
+    int finished = queued;
+    for (int i = 0; i < 64; i++) {
+        finished &= vedic_exec_poll(&tail[i]) == VEDIC_EXEC_DONE && request_correct(&tail[i], VEDIC_EXEC_DONE);
+    }
+    check("destroy finishes queued requests and runs their callbacks", finished && callbacks == 64);
+}
+
+int main(void) {
+    test_queue();
+    test_executor(0, 1);
+    test_executor(200, 2);
+
+    VedicExecutorConfig invalid = {0, VEDIC_EXEC_MAX_BATCH + 1, 0, 0};
+    check("invalid configuration refused", vedic_executor_create(&invalid) == NULL);
+
+    printf("%s\n", failures ? "Executor tests FAILED" : "All executor tests passed");
+    return failures ? 1 : 0;
+}
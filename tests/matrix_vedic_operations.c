@@ -11,6 +11,8 @@
 
 #include "unified_adaptive_dispatcher.h"
 #include "vedicmath.h"
+#include "../benchmarks/vedicmath_bench_json.h"
+#include "../benchmarks/vedicmath_bench_harness.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
@@ -316,13 +318,51 @@ bool verify_matrix_results(const VedicMatrix* A, const VedicMatrix* B) {
     return true;
 }
 
+/**
+ * @brief Time one multiplication method over several repetitions
+ *
+ * Every repetition is stored in samples_ns as nanoseconds per multiply-add
+ * (n³ per product). The product of the last repetition is returned for
+ * verification.
+ *
+ * @return Median repetition time in milliseconds
+ */
+static double time_matrix_method(VedicMatrix* (*multiply)(const VedicMatrix*, const VedicMatrix*),
+                                 const VedicMatrix* A, const VedicMatrix* B,
+                                 size_t repetitions, double* samples_ns,
+                                 VedicMatrix** product) {
+    double operations = (double)A->rows * (double)B->cols * (double)A->cols;
+    *product = NULL;
+    
+    for (size_t rep = 0; rep < repetitions; rep++) {
+        if (*product) free_vedic_matrix(*product);
+        HighResTimer timer = start_timer();
+        *product = multiply(A, B);
+        samples_ns[rep] = end_timer(timer) * 1e6 / operations;
+    }
+    
+    BenchSummary summary = bench_summarize(samples_ns, repetitions);
+    return summary.median * operations / 1e6;
+}
+
+// Fixed 16x16 blocking for time_matrix_method
+static VedicMatrix* matrix_multiply_vedic_blocked16(const VedicMatrix* A, const VedicMatrix* B) {
+    return matrix_multiply_vedic_blocked(A, B, 16);
+}
+
 /**
  * @brief Comprehensive matrix multiplication benchmark
+ *
+ * Each method is timed `repetitions` times; reported times are medians and
+ * the raw samples go to the JSON sink when one is open.
  */
-MatrixBenchmarkResult benchmark_matrix_multiplication(size_t matrix_size, const char* test_name) {
+MatrixBenchmarkResult benchmark_matrix_multiplication(size_t matrix_size, const char* test_name,
+                                                      size_t repetitions) {
     MatrixBenchmarkResult result = {0};
+    double samples_ns[BENCH_MAX_REPETITIONS];
     
-    printf("🔄 Benchmarking %s: %zux%zu matrices\n", test_name, matrix_size, matrix_size);
+    printf("🔄 Benchmarking %s: %zux%zu matrices (%zu repetitions)\n",
+           test_name, matrix_size, matrix_size, repetitions);
     
     // Create test matrices
     VedicMatrix* A = create_vedic_matrix(matrix_size, matrix_size, "Test Matrix A");
@@ -342,15 +382,17 @@ MatrixBenchmarkResult benchmark_matrix_multiplication(size_t matrix_size, const
     
     // Benchmark 1: Standard multiplication
     printf("   ⏱️  Running standard matrix multiplication...\n");
-    HighResTimer timer1 = start_timer();
-    VedicMatrix* C_standard = matrix_multiply_standard(A, B);
-    double standard_time = end_timer(timer1);
+    VedicMatrix* C_standard = NULL;
+    double standard_time = time_matrix_method(matrix_multiply_standard, A, B,
+                                              repetitions, samples_ns, &C_standard);
+    bench_json_record(test_name, "Standard", samples_ns, repetitions, 1, NULL);
     
     // Benchmark 2: Vedic multiplication  
     printf("   ⏱️  Running Vedic-enhanced matrix multiplication...\n");
-    HighResTimer timer2 = start_timer();
-    VedicMatrix* C_vedic = matrix_multiply_vedic(A, B);
-    double vedic_time = end_timer(timer2);
+    VedicMatrix* C_vedic = NULL;
+    double vedic_time = time_matrix_method(matrix_multiply_vedic, A, B,
+                                           repetitions, samples_ns, &C_vedic);
+    bench_json_record(test_name, "Vedic", samples_ns, repetitions, 1, NULL);
     
     // Benchmark 3: Blocked Vedic multiplication (for larger matrices)
     VedicMatrix* C_blocked = NULL;
@@ -358,9 +400,9 @@ MatrixBenchmarkResult benchmark_matrix_multiplication(size_t matrix_size, const
     
     if (matrix_size >= 50) {
         printf("   ⏱️  Running blocked Vedic matrix multiplication...\n");
-        HighResTimer timer3 = start_timer();
-        C_blocked = matrix_multiply_vedic_blocked(A, B, 16); // 16x16 blocks
-        blocked_time = end_timer(timer3);
+        blocked_time = time_matrix_method(matrix_multiply_vedic_blocked16, A, B,
+                                          repetitions, samples_ns, &C_blocked); // 16x16 blocks
+        bench_json_record(test_name, "Vedic Blocked", samples_ns, repetitions, 1, NULL);
     }
     
     // Verify correctness
@@ -550,8 +592,45 @@ void generate_enhanced_research_dataset(size_t target_operations) {
 
 /**
  * @brief Day 2 main execution: Matrix operations + enhanced dataset
+ *
+ * Usage: matrix_vedic_operations [--reps N] [--max-size N] [--json FILE]
  */
-int main(void) {
+int main(int argc, char* argv[]) {
+    size_t repetitions = 3;
+    size_t max_size = 0;            // 0 = full size sweep
+    const char* json_path = NULL;
+    
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--reps") == 0 && value) {
+            long reps = atol(value);
+            if (reps > 0) repetitions = (size_t)reps;
+            i++;
+        } else if (strcmp(argv[i], "--max-size") == 0 && value) {
+            long size = atol(value);
+            if (size > 0) max_size = (size_t)size;
+            i++;
+        } else if (strcmp(argv[i], "--json") == 0 && value) {
+            json_path = value;
+            i++;
+        } else {
+            printf("Usage: %s [--reps N] [--max-size N] [--json FILE]\n", argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (repetitions > BENCH_MAX_REPETITIONS) repetitions = BENCH_MAX_REPETITIONS;
+    
+    // Record the repetition count in the JSON environment block
+    BenchHarnessConfig harness;
+    bench_harness_default_config(&harness);
+    harness.repetitions = repetitions;
+    bench_harness_set_config(&harness);
+    
+    if (json_path && bench_json_begin(json_path, argv[0]) != 0) {
+        printf("❌ Cannot write JSON results to '%s'\n", json_path);
+        return 1;
+    }
+    
     printf("🚀 VedicMath-AI: DAY 2 MATRIX OPERATIONS & ENHANCED DATASET\n");
     printf("===========================================================\n");
     printf("OBJECTIVES: Matrix multiplication, 10K+ dataset, performance validation\n\n");
@@ -575,13 +654,16 @@ int main(void) {
     // Test different matrix sizes
     size_t test_sizes[] = {10, 25, 50, 100, 150};
     size_t num_sizes = sizeof(test_sizes) / sizeof(test_sizes[0]);
+    if (max_size > 0) {
+        while (num_sizes > 1 && test_sizes[num_sizes - 1] > max_size) num_sizes--;
+    }
     
     MatrixBenchmarkResult* results = malloc(sizeof(MatrixBenchmarkResult) * num_sizes);
     
     for (size_t i = 0; i < num_sizes; i++) {
         char test_name[100];
         snprintf(test_name, sizeof(test_name), "Matrix %zux%zu", test_sizes[i], test_sizes[i]);
-        results[i] = benchmark_matrix_multiplication(test_sizes[i], test_name);
+        results[i] = benchmark_matrix_multiplication(test_sizes[i], test_name, repetitions);
     }
     
     // Phase 2: Enhanced Dataset Generation
@@ -648,6 +730,15 @@ int main(void) {
     
     printf("\n🎯 READY FOR DAY 3: Final Analysis + Demo Preparation\n");
     
+    if (json_path) {
+        if (bench_json_end() != 0) {
+            printf("❌ Failed to write JSON results to '%s'\n", json_path);
+            free(results);
+            return 1;
+        }
+        printf("\n📁 JSON results written to %s\n", json_path);
+    }
+    
     // Cleanup
     free(results);
     return 0;
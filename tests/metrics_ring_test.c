@@ -0,0 +1,133 @@
+/**
+ * metrics_ring_test.c - Engine counters and the shared-memory metrics ring
+ *
+ * Checks that batch and dispatcher work moves the counters, that snapshots
+ * published into a named ring can be read back by sequence from this and
+ * from a forked process, that overwritten sequences are reported rather
+ * than returned, and that the publisher thread keeps the ring moving.
+ */
+
+#include "vedicmath.h"
+#include "vedicmath_metrics.h"
+#include "unified_adaptive_dispatcher.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define BATCH_COUNT 4096
+#define RING_CAPACITY 8
+
+static int failures = 0;
+
+static void check(const char* name, int passed) {
+    printf("[%s] %s\n", passed ? "PASS" : "FAIL", name);
+    if (!passed) failures++;
+}
+
+static void test_counters(void) {
+    long* a = (long*)malloc(BATCH_COUNT * sizeof(long));
+    long* b = (long*)malloc(BATCH_COUNT * sizeof(long));
+    long* results = (long*)malloc(BATCH_COUNT * sizeof(long));
+    for (int i = 0; i < BATCH_COUNT; i++) {
+        a[i] = 100 + (i % 50) * 7;
+        b[i] = 95 + (i % 13);
+    }
+
+    uint64_t before = 0, after = 0;
+    for (int m = VEDIC_METRIC_BATCH_DIRECT; m <= VEDIC_METRIC_BATCH_URDHVA; m++) {
+        before += vedic_metrics_get((VedicMetric)m);
+    }
+    vedic_multiply_batch(results, a, b, BATCH_COUNT);
+    for (int m = VEDIC_METRIC_BATCH_DIRECT; m <= VEDIC_METRIC_BATCH_URDHVA; m++) {
+        after += vedic_metrics_get((VedicMetric)m);
+    }
+    check("batch elements counted once per element", after - before == BATCH_COUNT);
+
+    uint64_t operations = vedic_metrics_get(VEDIC_METRIC_DISPATCH_OPERATIONS);
+    unified_multiply(vedic_from_int32(25), vedic_from_int32(25));
+    unified_multiply(vedic_from_int32(98), vedic_from_int32(97));
+    check("dispatcher operations counted",
+          vedic_metrics_get(VEDIC_METRIC_DISPATCH_OPERATIONS) - operations == 2);
+
+    VedicMetricsSnapshot snapshot;
+    vedic_metrics_collect(&snapshot);
+    check("collect copies the counters",
+          snapshot.sequence == 0 && snapshot.pid == (uint64_t)getpid() &&
+          snapshot.counters[VEDIC_METRIC_DISPATCH_OPERATIONS] >= 2 && snapshot.timestamp_ns > 0);
+
+    free(a);
+    free(b);
+    free(results);
+}
+
+static void test_ring(const char* name) {
+    VedicMetricsRing* ring = vedic_metrics_ring_create(name, RING_CAPACITY);
+    check("create named ring", ring != NULL);
+    if (!ring) return;
+    check("capacity", vedic_metrics_ring_capacity(ring) == RING_CAPACITY);
+    check("empty ring has no head", vedic_metrics_ring_head(ring) == 0);
+
+    VedicMetricsSnapshot in, out;
+    vedic_metrics_collect(&in);
+    int published = 1;
+    for (uint64_t i = 1; i <= 3; i++) {
+        in.counters[VEDIC_METRIC_DISPATCH_OPERATIONS] = i * 10;
+        published &= vedic_metrics_ring_publish(ring, &in) == i;
+    }
+    check("publish returns consecutive sequences", published && vedic_metrics_ring_head(ring) == 3);
+    check("read by sequence",
+          vedic_metrics_ring_read(ring, 2, &out) == 0 && out.sequence == 2 &&
+          out.counters[VEDIC_METRIC_DISPATCH_OPERATIONS] == 20 && out.pid == in.pid);
+    check("unpublished sequence unavailable",
+          vedic_metrics_ring_read(ring, 4, &out) != 0 && vedic_metrics_ring_read(ring, 0, &out) != 0);
+
+    // A second process sees the same snapshots and cannot write
+    pid_t child = fork();
+    if (child == 0) {
+        VedicMetricsRing* reader = vedic_metrics_ring_attach(name);
+        int ok = reader != NULL && vedic_metrics_ring_head(reader) == 3 &&
+                 vedic_metrics_ring_read(reader, 3, &out) == 0 &&
+                 out.counters[VEDIC_METRIC_DISPATCH_OPERATIONS] == 30 &&
+                 vedic_metrics_ring_publish(reader, &in) == 0;
+        if (reader) vedic_metrics_ring_close(reader);
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    check("attach from another process", WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    for (int i = 0; i < RING_CAPACITY; i++) vedic_metrics_ring_publish(ring, &in);
+    check("overwritten sequence unavailable",
+          vedic_metrics_ring_read(ring, 3, &out) != 0 &&
+          vedic_metrics_ring_read(ring, vedic_metrics_ring_head(ring) - RING_CAPACITY + 1, &out) == 0);
+
+    check("second publisher rejected",
+          vedic_metrics_publisher_start(ring, 10) == 0 && vedic_metrics_publisher_start(ring, 10) != 0);
+    uint64_t head = vedic_metrics_ring_head(ring);
+    usleep(100000);
+    vedic_metrics_publisher_stop();
+    uint64_t stopped = vedic_metrics_ring_head(ring);
+    check("publisher advances the ring", stopped > head);
+    usleep(30000);
+    check("publisher stops", vedic_metrics_ring_head(ring) == stopped);
+
+    vedic_metrics_ring_close(ring);
+    check("unlink", vedic_metrics_ring_unlink(name) == 0);
+    check("unlinked ring cannot be attached", vedic_metrics_ring_attach(name) == NULL);
+}
+
+int main(void) {
+    char name[64];
+    snprintf(name, sizeof(name), "/vedicmath-metrics-test-%ld", (long)getpid());
+
+    unified_dispatch_init(NULL);
+    test_counters();
+    test_ring(name);
+    unified_dispatch_finalize(NULL);
+
+    printf("%s\n", failures ? "Metrics tests FAILED" : "All metrics tests passed");
+    return failures ? 1 : 0;
+}
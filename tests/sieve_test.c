@@ -0,0 +1,169 @@
+/**
+ * sieve_test.c - Segmented sieve and batch factorization
+ *
+ * Checks the sieve against trial division on ranges with unaligned ends,
+ * empty and tiny ranges and ones spanning many segments, against known
+ * prime counts, and pages through a range. Ranges high enough to need
+ * several windows of sieving primes are checked against Miller-Rabin. Then factors edge cases, random
+ * numbers and semiprimes only Pollard-rho can split, checking that every
+ * factor is prime, the list ascends and the product gives the number back.
+ */
+
+#include "vedicmath_sieve.h"
+#include "vedicmath_pool.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define RANDOM_COUNT 20000
+
+static int failures = 0;
+
+static void check(const char* name, int passed) {
+    printf("[%s] %s\n", passed ? "PASS" : "FAIL", name);
+    if (!passed) failures++;
+}
+
+static int trial_is_prime(uint64_t n) {
+    if (n < 2) return 0;
+    for (uint64_t d = 2; d * d <= n; d++) {
+        if (n % d == 0) return 0;
+    }
+    return 1;
+}
+
+static int sieve_matches_trial(uint64_t low, uint64_t high) {
+    VedicSieve sieve;
+    if (vedic_sieve_init(&sieve, low, high) != 0) return 0;
+    size_t count = 0;
+    int same = 1;
+    for (uint64_t n = low; n < high; n++) {
+        int prime = trial_is_prime(n);
+        count += prime;
+        same &= vedic_sieve_is_prime(&sieve, n) == prime;
+    }
+    same &= vedic_sieve_count(&sieve) == count;
+    same &= low == 0 || vedic_sieve_is_prime(&sieve, low - 1) == -1;
+    same &= vedic_sieve_is_prime(&sieve, high) == -1;
+    vedic_sieve_free(&sieve);
+    return same;
+}
+
+static int sieve_matches_miller_rabin(uint64_t low, uint64_t high) {
+    VedicSieve sieve;
+    if (vedic_sieve_init(&sieve, low, high) != 0) return 0;
+    size_t count = 0;
+    int same = 1;
+    for (uint64_t n = low; n < high; n++) {
+        int prime = vedic_is_prime_u64(n);
+        count += prime;
+        same &= vedic_sieve_is_prime(&sieve, n) == prime;
+    }
+    same &= vedic_sieve_count(&sieve) == count;
+    vedic_sieve_free(&sieve);
+    return same;
+}
+
+static void test_sieve(void) {
+    check("[0, 1000) matches trial division", sieve_matches_trial(0, 1000));
+    check("unaligned [997, 20011) matches trial division", sieve_matches_trial(997, 20011));
+    check("tiny ranges", sieve_matches_trial(0, 0) && sieve_matches_trial(0, 2) && sieve_matches_trial(2, 3) &&
+                         sieve_matches_trial(4, 5) && sieve_matches_trial(29, 31) && sieve_matches_trial(30, 31));
+    check("[10^12 - 5000, 10^12 + 5000) matches trial division",
+          sieve_matches_trial(1000000000000ull - 5000, 1000000000000ull + 5000));
+
+    // Known count across many segments
+    VedicSieve sieve;
+    int ok = vedic_sieve_init(&sieve, 0, 1000000000) == 0;
+    check("pi(10^9) = 50847534", ok && vedic_sieve_count(&sieve) == 50847534);
+    if (ok) vedic_sieve_free(&sieve);
+
+    // Page through a range two segments long, against Miller-Rabin
+    uint64_t low = 1000000000000ull, high = low + 1000000;
+    ok = vedic_sieve_init(&sieve, low, high) == 0;
+    if (ok) {
+        uint64_t page[1000];
+        uint64_t from = 0, last = 0;
+        size_t total = 0, got, expected = 0;
+        int ordered = 1;
+        while ((got = vedic_sieve_primes(&sieve, from, page, 1000)) > 0) {
+            for (size_t i = 0; i < got; i++) {
+                ordered &= page[i] > last && vedic_is_prime_u64(page[i]);
+                last = page[i];
+            }
+            total += got;
+            from = last + 1;
+        }
+        for (uint64_t n = low + 1; n < high; n += 2) expected += vedic_is_prime_u64(n);
+        check("paging lists every prime once, in order", ordered && total == expected &&
+                                                         vedic_sieve_count(&sieve) == expected);
+        vedic_sieve_free(&sieve);
+    }
+
+    // Sieving primes up to 3.2 * 10^7 and 2 * 10^7 come in several windows;
+    // the second range is segments long, so its large primes carry over
+    check("[10^15 - 1000, 10^15) matches Miller-Rabin",
+          sieve_matches_miller_rabin(1000000000000000ull - 1000, 1000000000000000ull));
+    check("[4 * 10^14, 4 * 10^14 + 3 * 10^6) matches Miller-Rabin",
+          sieve_matches_miller_rabin(400000000000000ull, 400000000000000ull + 3000000));
+
+    check("invalid ranges refused", vedic_sieve_init(&sieve, 10, 5) == -1 &&
+                                    vedic_sieve_init(&sieve, 0, VEDIC_SIEVE_MAX_HIGH + 1) == -1);
+}
+
+static int factorization_correct(int64_t number, const VedicFactorization* factors) {
+    uint64_t n = number < 0 ? 0 - (uint64_t)number : (uint64_t)number;
+    if (n < 2) return factors->count == 0;
+    uint64_t product = 1;
+    for (int i = 0; i < factors->count; i++) {
+        if (!vedic_is_prime_u64(factors->primes[i]) || factors->exponents[i] == 0) return 0;
+        if (i > 0 && factors->primes[i] <= factors->primes[i - 1]) return 0;
+        for (int e = 0; e < factors->exponents[i]; e++) product *= factors->primes[i];
+    }
+    return product == n;
+}
+
+static void test_factor(void) {
+    check("Miller-Rabin on primes, Carmichael numbers and squares",
+          vedic_is_prime_u64(2) && vedic_is_prime_u64(2147483647) && vedic_is_prime_u64(9223372036854775783ull) &&
+          vedic_is_prime_u64(18446744073709551557ull) && !vedic_is_prime_u64(1) && !vedic_is_prime_u64(561) &&
+          !vedic_is_prime_u64(3215031751ull) && !vedic_is_prime_u64(4611686014132420609ull));
+
+    int64_t edges[] = {0, 1, -1, 2, -720, 719 * 719, 727 * 727, INT64_MIN, INT64_MAX,
+                       9223372036854775783ll, 4611686014132420609ll,   // Largest prime below 2^63, (2^31 - 1)^2
+                       3037000493ll * 3037000453ll, 1000000007ll * 998244353ll,
+                       -(int64_t)(2ll * 3 * 5 * 7 * 11 * 13 * 17 * 19 * 23 * 29 * 31 * 37 * 41 * 43 * 47)};
+    size_t edge_count = sizeof(edges) / sizeof(edges[0]);
+    VedicFactorization factors[sizeof(edges) / sizeof(edges[0])];
+    int ok = vedic_factor_batch(edges, edge_count, factors) == 0;
+    for (size_t i = 0; ok && i < edge_count; i++) ok &= factorization_correct(edges[i], &factors[i]);
+    check("edge cases factor exactly", ok);
+    check("2^63 is 2^63", factors[7].count == 1 && factors[7].primes[0] == 2 && factors[7].exponents[0] == 63);
+    check("primorial of 47 has 15 distinct primes", factors[edge_count - 1].count == VEDIC_FACTOR_MAX_PRIMES);
+    check("rho splits a product of two 32-bit primes",
+          factors[11].count == 2 && factors[11].primes[0] == 3037000453ull && factors[11].primes[1] == 3037000493ull);
+
+    int64_t* numbers = (int64_t*)malloc(RANDOM_COUNT * sizeof(int64_t));
+    VedicFactorization* random_factors = (VedicFactorization*)malloc(RANDOM_COUNT * sizeof(VedicFactorization));
+    uint64_t state = 88172645463325252ull;
+    for (int i = 0; i < RANDOM_COUNT; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        numbers[i] = (int64_t)(state >> (i % 40));          // Widths from 24 to 64 bits
+    }
+    ok = vedic_factor_batch(numbers, RANDOM_COUNT, random_factors) == 0;
+    for (int i = 0; ok && i < RANDOM_COUNT; i++) ok &= factorization_correct(numbers[i], &random_factors[i]);
+    check("random numbers of every width factor exactly", ok);
+    free(numbers);
+    free(random_factors);
+}
+
+int main(void) {
+    test_sieve();
+    test_factor();
+    vedic_pool_shutdown();
+
+    printf("%s\n", failures ? "Sieve tests FAILED" : "All sieve tests passed");
+    return failures ? 1 : 0;
+}
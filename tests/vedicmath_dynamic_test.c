@@ -277,7 +277,7 @@
      int num_cases = sizeof(test_cases) / sizeof(test_cases[0]);
      char test_name[100];
      char result_str[64];
-     const char* op_symbols[] = {"+", "-", "*", "/", "%", "^"};
+     const char* op_symbols[] = {"+", "-", "*", "/", "²", "%", "^", "√"};
      
      for (int i = 0; i < num_cases; i++) {
          VedicValue a = vedic_parse_number(test_cases[i].a_str);
@@ -13,6 +13,7 @@ void test_ekadhikena_purvena();
 void test_nikhilam_mul();
 void test_urdhva_tiryagbhyam();
 void test_yaavadunam();
+void test_dwandwa_yoga();
 void test_antyayordasake();
 void test_paravartya_yojayet();
 void test_vestanam();
@@ -22,6 +23,11 @@ void test_anurupyena();
 void test_sankalana_vyavakalanabhyam();
 void test_operators();
 void test_central_dispatcher();
+void test_allocator();
+void test_energy();
+void test_thread_pool();
+void test_async_batches();
+void test_pool_numa();
 void test_random_operations();
 
 void test_dhvajanka_division();
@@ -53,6 +59,12 @@ int main(int argc, char *argv[])
         printf(" 13. Central dispatcher\n");
         printf(" 14. Random operations\n");
         printf(" 15. All tests\n");
+        printf(" 16. Allocator and allocation tracking\n");
+        printf(" 17. Energy measurement (RAPL)\n");
+        printf(" 18. Thread pool\n");
+        printf(" 19. Asynchronous batches\n");
+        printf(" 20. Thread pool NUMA placement\n");
+        printf(" 21. Dwandwa-yoga (duplex squaring)\n");
         printf("\nUsage: %s [test_number]\n", argv[0]);
         return 0;
     }
@@ -152,6 +164,10 @@ int main(int argc, char *argv[])
         test_yaavadunam();
         printf("\n");
 
+        printf("=== Dwandwa-yoga Tests ===\n");
+        test_dwandwa_yoga();
+        printf("\n");
+
         printf("=== Antyayordasake Tests ===\n");
         test_antyayordasake();
         printf("\n");
@@ -184,6 +200,26 @@ int main(int argc, char *argv[])
         test_central_dispatcher();
         printf("\n");
 
+        printf("=== Allocator Tests ===\n");
+        test_allocator();
+        printf("\n");
+
+        printf("=== Energy Tests ===\n");
+        test_energy();
+        printf("\n");
+
+        printf("=== Thread Pool Tests ===\n");
+        test_thread_pool();
+        printf("\n");
+
+        printf("=== Thread Pool NUMA Tests ===\n");
+        test_pool_numa();
+        printf("\n");
+
+        printf("=== Asynchronous Batch Tests ===\n");
+        test_async_batches();
+        printf("\n");
+
         printf("=== Random Operation Tests ===\n");
         test_random_operations();
         printf("\n");
@@ -206,8 +242,38 @@ int main(int argc, char *argv[])
 
         break;
 
+    case 16:
+        printf("Running allocator tests...\n\n");
+        test_allocator();
+        break;
+
+    case 17:
+        printf("Running energy tests...\n\n");
+        test_energy();
+        break;
+
+    case 18:
+        printf("Running thread pool tests...\n\n");
+        test_thread_pool();
+        break;
+
+    case 19:
+        printf("Running asynchronous batch tests...\n\n");
+        test_async_batches();
+        break;
+
+    case 20:
+        printf("Running thread pool NUMA tests...\n\n");
+        test_pool_numa();
+        break;
+
+    case 21:
+        printf("Running Dwandwa-yoga tests...\n\n");
+        test_dwandwa_yoga();
+        break;
+
     default:
-        printf("Invalid test number. Please choose a number between 1 and 15.\n");
+        printf("Invalid test number. Please choose a number between 1 and 21.\n");
         return 1;
     }
 
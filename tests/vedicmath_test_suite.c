@@ -5,10 +5,18 @@
  */
 
  #include "vedicmath.h"
+ #include "vedicmath_alloc.h"
+ #include "vedicmath_energy.h"
+ #include "vedicmath_pool.h"
+ #include "vedicmath_async.h"
  #include <stdio.h>
  #include <stdlib.h>
  #include <string.h>
  #include <time.h>
+ #ifdef __linux__
+ #include <sys/stat.h>
+ #include <unistd.h>
+ #endif
  
  // Define test result macros
  #define TEST_PASS 1
@@ -49,6 +57,112 @@
      printf("=====================\n");
  }
  
+ /**
+  * Counting allocator for the allocation tracking tests
+  */
+ typedef struct {
+     int allocations;
+     int frees;
+ } CountingAllocator;
+ 
+ static void* counting_allocate(size_t size, void* context) {
+     ((CountingAllocator*)context)->allocations++;
+     return malloc(size);
+ }
+ 
+ static void* counting_reallocate(void* ptr, size_t size, void* context) {
+     if (!ptr) ((CountingAllocator*)context)->allocations++;
+     return realloc(ptr, size);
+ }
+ 
+ static void counting_release(void* ptr, void* context) {
+     if (ptr) ((CountingAllocator*)context)->frees++;
+     free(ptr);
+ }
+
+ #ifdef __linux__
+ /**
+  * Write one file of a fake powercap zone
+  */
+ static void write_zone_file(const char* root, const char* zone, const char* file, const char* text) {
+     char path[256];
+     snprintf(path, sizeof(path), "%s/%s", root, zone);
+     mkdir(path, 0755);
+     snprintf(path, sizeof(path), "%s/%s/%s", root, zone, file);
+     FILE* out = fopen(path, "w");
+     if (out) {
+         fputs(text, out);
+         fclose(out);
+     }
+ }
+
+ static void remove_zone(const char* root, const char* zone) {
+     static const char* files[] = {"name", "energy_uj", "max_energy_range_uj"};
+     char path[256];
+     for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); i++) {
+         snprintf(path, sizeof(path), "%s/%s/%s", root, zone, files[i]);
+         remove(path);
+     }
+     snprintf(path, sizeof(path), "%s/%s", root, zone);
+     rmdir(path);
+ }
+ #endif
+
+ /**
+  * Thread pool loop bodies: count visits per element, and run a nested
+  * parallel loop over each row of a grid
+  */
+ #define POOL_TEST_ROWS 16
+ #define POOL_TEST_COLUMNS 3000
+
+ static void touch_range(size_t begin, size_t end, void* context) {
+     int* visits = (int*)context;
+     for (size_t i = begin; i < end; i++) visits[i]++;
+ }
+
+ static void touch_rows(size_t begin, size_t end, void* context) {
+     int* grid = (int*)context;
+     for (size_t row = begin; row < end; row++) {
+         vedic_pool_parallel_for(POOL_TEST_COLUMNS, 64, touch_range, grid + row * POOL_TEST_COLUMNS);
+     }
+ }
+
+ /**
+  * Async completion callback: count calls, and hold the batch in flight
+  * until the test opens the gate
+  */
+ typedef struct {
+     int calls;
+     int last_status;
+     int gate_open;
+ } AsyncProbe;
+
+ static void async_probe_callback(VedicBatchHandle* handle, VedicBatchStatus status, void* user_data) {
+     AsyncProbe* probe = (AsyncProbe*)user_data;
+     (void)handle;
+     while (!__atomic_load_n(&probe->gate_open, __ATOMIC_ACQUIRE)) {
+     }
+     probe->last_status = status;
+     __atomic_add_fetch(&probe->calls, 1, __ATOMIC_RELEASE);
+ }
+ 
+ /**
+  * Lanes for the branch-free sutra kernels: eligible and ineligible pairs,
+  * negative and over-32-bit operands, and each operand's nearest base
+  */
+ #define KERNEL_LANES 4000
+
+ static void fill_kernel_lanes(int64_t* n, int64_t* m, int64_t* base) {
+     for (size_t i = 0; i < KERNEL_LANES; i++) {
+         int64_t prefix = (int64_t)(i * 7919 % 100000);
+         n[i] = prefix * 10 + (int64_t)(i % 10);
+         m[i] = i % 3 ? prefix * 10 + (10 - (int64_t)(i % 10)) % 10 : n[i] + 10;
+         if (i % 97 == 0) n[i] = -n[i];
+         if (i % 101 == 0) n[i] = 4294967301LL + (int64_t)i;     // 2^32 + 5 + i
+         base[i] = nearest_power_of_10(n[i] < 0 ? -n[i] : n[i]);
+     }
+ }
+ 
  /**
   * Test Ekadhikena Purvena (squaring numbers ending in 5)
   */
@@ -94,6 +208,25 @@
          sprintf(test_name, "Ekadhikena Purvena: %ld^2 = %ld", test_cases[i].input, test_cases[i].expected);
          print_test_result(test_name, result == test_cases[i].expected);
      }
+     
+     // Branch-free kernel against the scalar sutra and n * n, over every lane
+     int64_t* lanes_n = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     int64_t* lanes_m = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     int64_t* lanes_base = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     int64_t* lanes_out = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     fill_kernel_lanes(lanes_n, lanes_m, lanes_base);
+     ekadhikena_purvena_batch(lanes_n, lanes_out, KERNEL_LANES);
+     int kernel_match = 1;
+     for (size_t i = 0; i < KERNEL_LANES; i++) {
+         uint64_t n = (uint64_t)lanes_n[i];
+         kernel_match &= lanes_out[i] == (int64_t)(n * n) &&
+                         (lanes_n[i] < 0 || lanes_n[i] % 10 != 5 || lanes_out[i] == ekadhikena_purvena(lanes_n[i]));
+     }
+     print_test_result("Sutra Kernels: Ekadhikena batch matches n * n", kernel_match);
+     free(lanes_n);
+     free(lanes_m);
+     free(lanes_base);
+     free(lanes_out);
  }
  
  /**
@@ -149,6 +282,31 @@
                  test_cases[i].a, test_cases[i].b, test_cases[i].expected);
          print_test_result(test_name, result == test_cases[i].expected);
      }
+     
+     // Branch-free kernel at every base, with pairs both below, both above and straddling it
+     int64_t* lanes_n = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     int64_t* lanes_m = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     int64_t* lanes_out = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     int kernel_match = 1;
+     int64_t nikhilam_base = 1;
+     for (int exponent = 1; exponent <= 9; exponent++) {
+         nikhilam_base *= 10;
+         for (size_t i = 0; i < KERNEL_LANES; i++) {
+             int64_t spread = nikhilam_base / 5 + 1;
+             lanes_n[i] = nikhilam_base + (int64_t)(i * 7919 % (2 * spread)) - spread;
+             lanes_m[i] = nikhilam_base + (int64_t)(i * 104729 % (2 * spread)) - spread;
+         }
+         nikhilam_mul_batch(lanes_n, lanes_m, nikhilam_base, lanes_out, KERNEL_LANES);
+         for (size_t i = 0; i < KERNEL_LANES; i++) {
+             kernel_match &= lanes_out[i] == lanes_n[i] * lanes_m[i] &&
+                             lanes_out[i] == nikhilam_mul((long)lanes_n[i], (long)lanes_m[i]);
+         }
+     }
+     print_test_result("Sutra Kernels: Nikhilam batch matches a * b for bases 10 to 10^9", kernel_match);
+     print_test_result("Sutra Kernels: Nikhilam base for 997 x 1004 is 1000", nikhilam_best_base(997, 1004) == 1000);
+     free(lanes_n);
+     free(lanes_m);
+     free(lanes_out);
  }
  
  /**
@@ -221,6 +379,83 @@
          sprintf(test_name, "Yaavadunam: %ld² = %ld", test_cases[i].input, test_cases[i].expected);
          print_test_result(test_name, result == test_cases[i].expected);
      }
+     
+     // Branch-free kernel against n * n, each lane around its nearest base
+     int64_t* lanes_n = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     int64_t* lanes_m = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     int64_t* lanes_base = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     int64_t* lanes_out = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     fill_kernel_lanes(lanes_n, lanes_m, lanes_base);
+     yaavadunam_square_batch(lanes_n, lanes_base, lanes_out, KERNEL_LANES);
+     int kernel_match = 1;
+     for (size_t i = 0; i < KERNEL_LANES; i++) {
+         uint64_t n = (uint64_t)lanes_n[i];
+         kernel_match &= lanes_out[i] == (int64_t)(n * n);
+     }
+     print_test_result("Sutra Kernels: Yaavadunam batch matches n * n above and below the base", kernel_match);
+     free(lanes_n);
+     free(lanes_m);
+     free(lanes_base);
+     free(lanes_out);
+ }
+ 
+ /**
+  * Test Dwandwa-yoga (duplex squaring)
+  */
+ void test_dwandwa_yoga() {
+     struct {
+         long input;
+         long expected;
+     } test_cases[] = {
+         {0, 0},
+         {7, 49},
+         {-12, 144},
+         {123, 15129},
+         {9999, 99980001},
+         {10000, 100000000},
+         {123456, 15241383936},
+         {-987654321, 975461057789971041},
+         {3037000499, 9223372030926249001}
+     };
+     
+     int num_cases = sizeof(test_cases) / sizeof(test_cases[0]);
+     char test_name[100];
+     
+     for (int i = 0; i < num_cases; i++) {
+         long result = dwandwa_square(test_cases[i].input);
+         sprintf(test_name, "Dwandwa-yoga: %ld² = %ld", test_cases[i].input, test_cases[i].expected);
+         print_test_result(test_name, result == test_cases[i].expected);
+     }
+     
+     // Wider squares against the full crosswise product
+     uint32_t limbs[6], square[12], expected[12];
+     unsigned int seed = 71;
+     int limbs_match = 1;
+     for (int count = 1; count <= 6; count++) {
+         for (int trial = 0; trial < 200; trial++) {
+             for (int i = 0; i < count; i++) {
+                 seed = seed * 1103515245u + 12345u;
+                 limbs[i] = trial % 4 == 0 ? 0xFFFFFFFFu : seed ^ (seed << 13);
+             }
+             memset(expected, 0, sizeof(expected));
+             for (int i = 0; i < count; i++) {
+                 uint64_t carry = 0;
+                 for (int j = 0; j < count; j++) {
+                     uint64_t t = (uint64_t)limbs[i] * limbs[j] + expected[i + j] + carry;
+                     expected[i + j] = (uint32_t)t;
+                     carry = t >> 32;
+                 }
+                 expected[i + count] = (uint32_t)carry;
+             }
+             dwandwa_square_limbs(square, limbs, (size_t)count);
+             limbs_match &= memcmp(square, expected, 2 * count * sizeof(uint32_t)) == 0;
+         }
+     }
+     print_test_result("Dwandwa-yoga: 1-6 limb squares match the full product", limbs_match);
+     
+     // The square dispatcher and repeated squaring take the duplex path
+     print_test_result("Square Dispatcher: 123457² = 15241630849", vedic_square(123457) == 15241630849L);
+     print_test_result("Power: 1234^4 = 2318785835536", vedic_op_power(1234, 4) == 2318785835536L);
  }
  
  /**
@@ -269,6 +504,23 @@
                  test_cases[i].a, test_cases[i].b, test_cases[i].expected);
          print_test_result(test_name, result == test_cases[i].expected);
      }
+     
+     // Branch-free kernel against a * b, over pairs that do and do not qualify
+     int64_t* lanes_n = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     int64_t* lanes_m = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     int64_t* lanes_base = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     int64_t* lanes_out = (int64_t*)malloc(KERNEL_LANES * sizeof(int64_t));
+     fill_kernel_lanes(lanes_n, lanes_m, lanes_base);
+     antya_dasake_mul_batch(lanes_n, lanes_m, lanes_out, KERNEL_LANES);
+     int kernel_match = 1;
+     for (size_t i = 0; i < KERNEL_LANES; i++) {
+         kernel_match &= lanes_out[i] == (int64_t)((uint64_t)lanes_n[i] * (uint64_t)lanes_m[i]);
+     }
+     print_test_result("Sutra Kernels: Antyayordasake batch matches a * b", kernel_match);
+     free(lanes_n);
+     free(lanes_m);
+     free(lanes_base);
+     free(lanes_out);
  }
  
  /**
@@ -357,6 +609,49 @@
                  
          print_test_result(test_name, result == test_cases[i].expected);
      }
+     
+     // Osculators derived for any divisor coprime to 10
+     print_test_result("Vestanam: osculators of 7, 13, 11, 53 are -2, 4, -1, 16",
+                       vestanam_osculator(7) == -2 && vestanam_osculator(13) == 4 &&
+                       vestanam_osculator(11) == -1 && vestanam_osculator(53) == 16);
+     print_test_result("Vestanam: no osculator for 10, 25 or 0",
+                       vestanam_osculator(10) == 0 && vestanam_osculator(25) == 0 && vestanam_osculator(0) == 0);
+     int scalar_match = vestanam_divisibility(12, 4) == -1;
+     for (int divisor = 1; divisor < 400; divisor += 2) {
+         if (divisor % 5 == 0) continue;
+         for (long number = -300; number < 3000; number += 7) {
+             scalar_match &= vestanam_divisibility(number, divisor) == (number % divisor == 0);
+         }
+     }
+     print_test_result("Vestanam: every divisor coprime to 10 below 400 matches %", scalar_match);
+     
+     // Batch screen against a mix of small and large divisors
+     int divisors[] = {2, 3, 5, 7, 9, 11, 13, 37, 101, 997, 9973, 65537, VESTANAM_MAX_DIVISOR};
+     size_t divisor_count = sizeof(divisors) / sizeof(divisors[0]);
+     int64_t numbers[1000];
+     uint64_t masks[1000], first_masks[1000];
+     for (int i = 0; i < 1000; i++) {
+         numbers[i] = (int64_t)(i * 2654435761u) * (i % 3 == 0 ? divisors[i % divisor_count] : 1);
+         numbers[i] = i % 4 == 1 ? -numbers[i] : numbers[i];
+     }
+     numbers[0] = INT64_MIN;
+     numbers[1] = INT64_MAX;
+     numbers[2] = 0;
+     int screen_ok = vestanam_screen_batch(numbers, 1000, divisors, divisor_count, masks, 0) == 0 &&
+                     vestanam_screen_batch(numbers, 1000, divisors, divisor_count, first_masks, 1) == 0;
+     int screen_match = screen_ok;
+     for (int i = 0; screen_ok && i < 1000; i++) {
+         uint64_t expected = 0;
+         for (size_t j = 0; j < divisor_count; j++) {
+             int64_t remainder = numbers[i] == INT64_MIN ? INT64_MIN % divisors[j] : numbers[i] % divisors[j];
+             expected |= (uint64_t)(remainder == 0) << j;
+         }
+         screen_match &= masks[i] == expected && first_masks[i] == (expected & (0 - expected));
+     }
+     print_test_result("Vestanam: batch screen matches % over 13 divisors, first_only too", screen_match);
+     int even = 4;
+     print_test_result("Vestanam: batch screen refuses a divisor sharing a factor with 10",
+                       vestanam_screen_batch(numbers, 1000, &even, 1, masks, 0) == -1);
  }
  
  /**
@@ -672,7 +967,26 @@
                  
          print_test_result(test_name, result == test_cases[i].expected);
      }
-     
+
+     // The batch dispatcher must agree with the per-element one
+     long batch_a[sizeof(test_cases) / sizeof(test_cases[0])];
+     long batch_b[sizeof(test_cases) / sizeof(test_cases[0])];
+     long batch_results[sizeof(test_cases) / sizeof(test_cases[0])];
+
+     for (int i = 0; i < num_cases; i++) {
+         batch_a[i] = test_cases[i].a;
+         batch_b[i] = test_cases[i].b;
+     }
+     vedic_multiply_batch(batch_results, batch_a, batch_b, (size_t)num_cases);
+
+     for (int i = 0; i < num_cases; i++) {
+         sprintf(test_name, "Batch Dispatcher: %ld x %ld = %ld (%s)",
+                 test_cases[i].a, test_cases[i].b, test_cases[i].expected,
+                 vedic_multiply_method_name(vedic_multiply_method(test_cases[i].a, test_cases[i].b)));
+
+         print_test_result(test_name, batch_results[i] == test_cases[i].expected);
+     }
+
      // Test squaring dispatcher
      struct {
          long n;
@@ -696,6 +1010,38 @@
                  
          print_test_result(test_name, result == square_tests[i].expected);
      }
+
+     size_t lane_count = 4000;
+     long* batch_squares_in = (long*)malloc(lane_count * sizeof(long));
+     long* batch_squares = (long*)malloc(lane_count * sizeof(long));
+     for (size_t i = 0; i < lane_count; i++) {
+         batch_squares_in[i] = i % 2 ? (long)(i * 7919 % 200000) - 100000 : 1000 - (long)i % 150;
+     }
+     vedic_square_batch(batch_squares, batch_squares_in, lane_count);
+     int squares_match = 1;
+     for (size_t i = 0; i < lane_count; i++) squares_match &= batch_squares[i] == vedic_square(batch_squares_in[i]);
+     vedic_square_batch(batch_squares_in, batch_squares_in, lane_count);
+     for (size_t i = 0; i < lane_count; i++) squares_match &= batch_squares_in[i] == batch_squares[i];
+     print_test_result("Batch Dispatcher: squares match vedic_square, in place too", squares_match);
+
+     // Nikhilam pairs near several bases in one chunk, with mixed signs
+     long mixed_a[512], mixed_b[512], mixed_products[512];
+     long near_bases[] = {100, 1000, 10000};
+     for (int i = 0; i < 512; i++) {
+         long near = near_bases[i % 3];
+         mixed_a[i] = (near - 7 + i % 15) * (i % 5 == 0 ? -1 : 1);
+         mixed_b[i] = (near + 3 - i % 9) * (i % 7 == 0 ? -1 : 1);
+     }
+     vedic_multiply_batch(mixed_products, mixed_a, mixed_b, 512);
+     int nikhilam_matches = 1, nikhilam_pairs = 0;
+     for (int i = 0; i < 512; i++) {
+         nikhilam_pairs += vedic_multiply_method(mixed_a[i], mixed_b[i]) == VEDIC_MUL_NIKHILAM;
+         nikhilam_matches &= mixed_products[i] == vedic_multiply(mixed_a[i], mixed_b[i]);
+     }
+     print_test_result("Batch Dispatcher: Nikhilam pairs bucketed by base match vedic_multiply",
+                       nikhilam_matches && nikhilam_pairs > 400);
+     free(batch_squares_in);
+     free(batch_squares);
      
      // Test division dispatcher
      struct {
@@ -722,6 +1068,294 @@
      }
  }
  
+ /**
+  * Test allocation routing through a custom allocator and per-API accounting
+  */
+ void test_allocator() {
+     // Urdhva allocates digit buffers
+     CountingAllocator counter = {0, 0};
+     VedicAllocator allocator = {counting_allocate, counting_reallocate, counting_release, &counter};
+     print_test_result("Allocator: set custom allocator", vedic_set_allocator(&allocator) == 0);
+ 
+     vedic_alloc_tracking_reset();
+     vedic_alloc_tracking_enable(true);
+     long product = vedic_multiply(1234, 5678);
+     vedic_alloc_tracking_enable(false);
+     vedic_set_allocator(NULL);
+ 
+     VedicAllocCounts totals = vedic_alloc_get_totals();
+     print_test_result("Allocator: result unchanged", product == 1234L * 5678L);
+     print_test_result("Allocator: allocations routed to custom allocator",
+                       counter.allocations > 0 && counter.allocations == counter.frees);
+     print_test_result("Allocator: totals match allocator calls",
+                       totals.allocations == (uint64_t)counter.allocations &&
+                       totals.frees == (uint64_t)counter.frees);
+ 
+     VedicAllocSiteStats sites[16];
+     size_t site_count = vedic_alloc_get_sites(sites, 16);
+     int attributed = site_count > 0;
+     for (size_t i = 0; i < site_count && i < 16; i++) {
+         if (strcmp(sites[i].api, "vedic_multiply") != 0) attributed = 0;
+     }
+     print_test_result("Allocator: sites attributed to vedic_multiply", attributed);
+ 
+     VedicAllocator incomplete = {counting_allocate, NULL, counting_release, &counter};
+     print_test_result("Allocator: reject incomplete allocator", vedic_set_allocator(&incomplete) == -1);
+     vedic_alloc_tracking_reset();
+ }
+ 
+ /**
+  * Test RAPL energy reading on a fake powercap tree
+  */
+ void test_energy() {
+ #ifdef __linux__
+     // Fake powercap tree: two sockets, a core zone, an ignored uncore zone,
+     // and a package counter that wraps
+     char root[64];
+     snprintf(root, sizeof(root), "/tmp/vedicmath_powercap_%ld", (long)getpid());
+     mkdir(root, 0755);
+     write_zone_file(root, "intel-rapl:0", "name", "package-0\n");
+     write_zone_file(root, "intel-rapl:0", "energy_uj", "4000\n");
+     write_zone_file(root, "intel-rapl:0", "max_energy_range_uj", "5000\n");
+     write_zone_file(root, "intel-rapl:0:0", "name", "core\n");
+     write_zone_file(root, "intel-rapl:0:0", "energy_uj", "100\n");
+     write_zone_file(root, "intel-rapl:0:1", "name", "uncore\n");
+     write_zone_file(root, "intel-rapl:0:1", "energy_uj", "0\n");
+     write_zone_file(root, "intel-rapl:1", "name", "package-1\n");
+     write_zone_file(root, "intel-rapl:1", "energy_uj", "1000000\n");
+
+     print_test_result("Energy: fake RAPL zones discovered", vedic_energy_init_at(root) == 3);
+     print_test_result("Energy: package and core available, dram missing",
+                       vedic_energy_available(VEDIC_ENERGY_PACKAGE) &&
+                       vedic_energy_available(VEDIC_ENERGY_CORE) &&
+                       !vedic_energy_available(VEDIC_ENERGY_DRAM));
+
+     VedicEnergySample before, after;
+     int read_ok = vedic_energy_read(&before) == 0;
+     write_zone_file(root, "intel-rapl:0", "energy_uj", "500\n");      // Wrapped: +1500
+     write_zone_file(root, "intel-rapl:0:0", "energy_uj", "2100\n");   // +2000
+     write_zone_file(root, "intel-rapl:1", "energy_uj", "1500000\n");  // +500000
+     read_ok = read_ok && vedic_energy_read(&after) == 0;
+
+     double package = vedic_energy_joules(&before, &after, VEDIC_ENERGY_PACKAGE);
+     double core = vedic_energy_joules(&before, &after, VEDIC_ENERGY_CORE);
+     print_test_result("Energy: counters read", read_ok);
+     print_test_result("Energy: package summed over sockets with wraparound",
+                       package > 0.5014 && package < 0.5016);
+     print_test_result("Energy: core domain", core > 0.0019 && core < 0.0021);
+
+     remove_zone(root, "intel-rapl:0");
+     remove_zone(root, "intel-rapl:0:0");
+     remove_zone(root, "intel-rapl:0:1");
+     remove_zone(root, "intel-rapl:1");
+     rmdir(root);
+     print_test_result("Energy: missing powercap reported unavailable",
+                       vedic_energy_init_at(root) == 0 && !vedic_energy_available(VEDIC_ENERGY_PACKAGE));
+ #else
+     printf("Energy tests need the Linux powercap interface; skipped\n");
+ #endif
+ }
+ 
+ /**
+  * Test the work-stealing thread pool
+  */
+ void test_thread_pool() {
+     // More workers than the machine may have
+     VedicPoolConfig pool_config = {3, NULL, 0, 0, NULL};
+     VedicPoolConfig bad_pool_config = {VEDIC_POOL_MAX_THREADS + 1, NULL, 0, 0, NULL};
+     print_test_result("Pool: reject invalid configuration", vedic_pool_configure(&bad_pool_config) == -1);
+     print_test_result("Pool: configure three workers",
+                       vedic_pool_configure(&pool_config) == 0 && vedic_pool_thread_count() == 3);
+
+     size_t visit_count = 100000;
+     int* visits = (int*)calloc(visit_count, sizeof(int));
+     vedic_pool_parallel_for(visit_count, 16, touch_range, visits);
+     int each_once = 1;
+     for (size_t i = 0; i < visit_count; i++) {
+         if (visits[i] != 1) each_once = 0;
+     }
+     free(visits);
+     print_test_result("Pool: every element processed exactly once", each_once);
+
+     int* grid = (int*)calloc(POOL_TEST_ROWS * POOL_TEST_COLUMNS, sizeof(int));
+     vedic_pool_parallel_for(POOL_TEST_ROWS, 1, touch_rows, grid);
+     int grid_once = 1;
+     for (size_t i = 0; i < POOL_TEST_ROWS * POOL_TEST_COLUMNS; i++) {
+         if (grid[i] != 1) grid_once = 0;
+     }
+     free(grid);
+     print_test_result("Pool: nested parallel loops complete", grid_once);
+
+     size_t pair_count = 20000;
+     long* left = (long*)malloc(pair_count * sizeof(long));
+     long* right = (long*)malloc(pair_count * sizeof(long));
+     long* products = (long*)malloc(pair_count * sizeof(long));
+     for (size_t i = 0; i < pair_count; i++) {
+         left[i] = (long)(i % 2000) - 1000;
+         right[i] = (long)((i * 7919) % 20000) + 1;
+     }
+     vedic_multiply_batch(products, left, right, pair_count);
+     int batch_matches = 1;
+     for (size_t i = 0; i < pair_count; i++) {
+         if (products[i] != vedic_multiply(left[i], right[i])) batch_matches = 0;
+     }
+     free(left);
+     free(right);
+     free(products);
+     print_test_result("Pool: parallel batch matches per-element results", batch_matches);
+
+     VedicPoolStats pool_stats = vedic_pool_get_stats();
+     print_test_result("Pool: calls split across threads", pool_stats.parallel_calls >= 3 &&
+                       pool_stats.ranges_executed > pool_stats.parallel_calls);
+
+     vedic_pool_shutdown();
+     int restarted[1000] = {0};
+     vedic_pool_parallel_for(1000, 10, touch_range, restarted);
+     print_test_result("Pool: restarts after shutdown", restarted[0] == 1 && restarted[999] == 1);
+     vedic_pool_configure(NULL);
+ }
+ 
+ /**
+  * Test NUMA node discovery and splitting pool calls across nodes
+  */
+ void test_pool_numa() {
+ #ifdef __linux__
+     // NUMA discovery on this machine, then on a fake tree with a memory-only
+     // node and sparse node numbers
+     VedicPoolTopology topology;
+     int node_count = vedic_pool_discover_topology(&topology);
+     int nodes_have_cpus = node_count >= 1 && node_count == topology.node_count;
+     for (int node = 0; node < topology.node_count; node++) {
+         if (topology.cpu_count[node] < 1) nodes_have_cpus = 0;
+     }
+     print_test_result("Pool: topology discovered, every node with CPUs", nodes_have_cpus);
+
+     char node_root[64];
+     snprintf(node_root, sizeof(node_root), "/tmp/vedicmath_nodes_%ld", (long)getpid());
+     mkdir(node_root, 0755);
+     print_test_result("Pool: no node directories gives one node",
+                       vedic_pool_discover_topology_at(node_root, &topology) == 1 && topology.cpu_count[0] > 0);
+     write_zone_file(node_root, "node0", "cpulist", "0-4095\n");
+     write_zone_file(node_root, "node2", "cpulist", "\n");
+     write_zone_file(node_root, "node5", "cpulist", "0-4095\n");
+     print_test_result("Pool: memory-only node dropped, node numbers kept",
+                       vedic_pool_discover_topology_at(node_root, &topology) == 2 &&
+                       topology.node_ids[0] == 0 && topology.node_ids[1] == 5 &&
+                       topology.cpu_count[0] > 0 && topology.cpu_count[1] == topology.cpu_count[0]);
+     const char* node_dirs[] = {"node0", "node2", "node5"};
+     for (size_t i = 0; i < sizeof(node_dirs) / sizeof(node_dirs[0]); i++) {
+         char path[256];
+         snprintf(path, sizeof(path), "%s/%s/cpulist", node_root, node_dirs[i]);
+         remove(path);
+         snprintf(path, sizeof(path), "%s/%s", node_root, node_dirs[i]);
+         rmdir(path);
+     }
+     rmdir(node_root);
+ #endif
+
+     // Split calls over two nodes, without pinning, whatever the machine has
+     static VedicPoolTopology two_nodes;
+     two_nodes.node_count = 2;
+     two_nodes.node_ids[1] = 1;
+     VedicPoolConfig numa_config = {3, NULL, 0, 1, &two_nodes};
+     int cpus[1] = {0};
+     VedicPoolConfig numa_with_cpus = {3, cpus, 1, 1, NULL};
+     print_test_result("Pool: numa with explicit CPUs rejected", vedic_pool_configure(&numa_with_cpus) == -1);
+     print_test_result("Pool: configure two nodes",
+                       vedic_pool_configure(&numa_config) == 0 && vedic_pool_node_count() == 2);
+
+     size_t visit_count = 100000;
+     int* visits = (int*)malloc(visit_count * sizeof(int));
+     memset(visits, 0xff, visit_count * sizeof(int));
+     vedic_pool_first_touch(visits, visit_count, sizeof(int));
+     int touched = 1;
+     for (size_t i = 0; i < visit_count; i++) {
+         if (visits[i] != 0) touched = 0;
+     }
+     print_test_result("Pool: first touch zeroes the buffer", touched);
+     vedic_pool_parallel_for(visit_count, 16, touch_range, visits);
+     int each_once = 1;
+     for (size_t i = 0; i < visit_count; i++) {
+         if (visits[i] != 1) each_once = 0;
+     }
+     free(visits);
+     int* grid = (int*)calloc(POOL_TEST_ROWS * POOL_TEST_COLUMNS, sizeof(int));
+     vedic_pool_parallel_for(POOL_TEST_ROWS, 1, touch_rows, grid);
+     for (size_t i = 0; i < POOL_TEST_ROWS * POOL_TEST_COLUMNS; i++) {
+         if (grid[i] != 1) each_once = 0;
+     }
+     free(grid);
+     print_test_result("Pool: node split processes every element exactly once",
+                       each_once && vedic_pool_get_stats().node_splits >= 3);
+     vedic_pool_configure(NULL);
+ }
+ 
+ /**
+  * Test asynchronous batch submission, completion callbacks and the
+  * in-flight limit
+  */
+ void test_async_batches() {
+     // A pool with workers, whatever the machine has
+     VedicPoolConfig async_pool_config = {3, NULL, 0, 0, NULL};
+     vedic_pool_configure(&async_pool_config);
+     size_t async_count = 10000;
+     long* async_a = (long*)malloc(async_count * sizeof(long));
+     long* async_b = (long*)malloc(async_count * sizeof(long));
+     long* async_out = (long*)malloc(async_count * sizeof(long));
+     long* square_out = (long*)malloc(async_count * sizeof(long));
+     for (size_t i = 0; i < async_count; i++) {
+         async_a[i] = (long)(i % 1500) + 85;
+         async_b[i] = 10000 - (long)(i % 97);
+     }
+     vedic_async_reset_stats();
+
+     AsyncProbe probe = {0, -1, 1};
+     const void* pair_inputs[2] = {async_a, async_b};
+     VedicBatchHandle* handle = vedic_submit_batch(VEDIC_BATCH_MULTIPLY, pair_inputs, async_out, async_count,
+                                                   async_probe_callback, &probe);
+     VedicBatchStatus async_status = handle ? vedic_batch_wait(handle) : VEDIC_BATCH_CANCELLED;
+     int async_matches = async_status == VEDIC_BATCH_DONE;
+     for (size_t i = 0; async_matches && i < async_count; i++) {
+         if (async_out[i] != vedic_multiply(async_a[i], async_b[i])) async_matches = 0;
+     }
+     print_test_result("Async: multiply batch completes with correct results", async_matches);
+     print_test_result("Async: callback ran once before wait returned",
+                       probe.calls == 1 && probe.last_status == VEDIC_BATCH_DONE);
+     print_test_result("Async: poll reports done, cancel refused after completion",
+                       handle && vedic_batch_poll(handle) == VEDIC_BATCH_DONE && vedic_batch_cancel(handle) == -1);
+     vedic_batch_release(handle);
+
+     // Hold one batch in its callback so the limit of one is reached (a
+     // pool without workers runs it inline, so the gate must start open)
+     const void* square_inputs[1] = {async_a};
+     AsyncProbe held = {0, -1, vedic_pool_thread_count() == 0};
+     vedic_async_set_limit(1);
+     VedicBatchHandle* first = vedic_submit_batch(VEDIC_BATCH_SQUARE, square_inputs, square_out, async_count,
+                                                  async_probe_callback, &held);
+     VedicBatchHandle* second = vedic_submit_batch(VEDIC_BATCH_SQUARE, square_inputs, square_out, async_count,
+                                                   NULL, NULL);
+     print_test_result("Async: submission refused at the in-flight limit", first && !second);
+     __atomic_store_n(&held.gate_open, 1, __ATOMIC_RELEASE);
+     int square_matches = first && vedic_batch_wait(first) == VEDIC_BATCH_DONE;
+     for (size_t i = 0; square_matches && i < async_count; i++) {
+         if (square_out[i] != vedic_square(async_a[i])) square_matches = 0;
+     }
+     vedic_batch_release(first);
+     vedic_async_set_limit(0);
+     print_test_result("Async: square batch completes with correct results", square_matches);
+
+     VedicAsyncStats async_stats = vedic_async_get_stats();
+     print_test_result("Async: counters", async_stats.submitted == 2 && async_stats.completed == 2 &&
+                       async_stats.rejected == 1 && async_stats.in_flight == 0);
+     print_test_result("Async: invalid operation rejected",
+                       vedic_submit_batch(VEDIC_BATCH_OP_COUNT, pair_inputs, async_out, 1, NULL, NULL) == NULL);
+     free(async_a);
+     free(async_b);
+     free(async_out);
+     free(square_out);
+     vedic_pool_configure(NULL);
+ }
+ 
  /**
   * Run random tests to verify the library against standard operations
   */
@@ -0,0 +1,276 @@
+/**
+ * vedicmathd_test.c - End-to-end test of the vedicmathd compute daemon
+ *
+ * Starts the daemon given on the command line, pipelines a mix of inline
+ * and pooled batches plus malformed requests over one connection, checks
+ * every response against the library, floods a second connection that
+ * never reads to check backpressure, then stops the daemon with SIGTERM.
+ *
+ * Usage: vedicmathd_test /path/to/vedicmathd
+ */
+
+#include "vedicmath.h"
+#include "vedicmath_wire.h"
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define LARGE_COUNT 100000
+#define SMALL_COUNT 200
+#define REQUEST_COUNT 7
+#define FLOOD_BYTES (32u << 20)      // More than the daemon may buffer for one client
+
+static int failures = 0;
+
+static void check(const char* name, int passed) {
+    printf("[%s] %s\n", passed ? "PASS" : "FAIL", name);
+    if (!passed) failures++;
+}
+
+static int write_all(int fd, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    while (size > 0) {
+        ssize_t written = write(fd, bytes, size);
+        if (written <= 0) return -1;
+        bytes += written;
+        size -= (size_t)written;
+    }
+    return 0;
+}
+
+static int read_all(int fd, void* data, size_t size) {
+    uint8_t* bytes = (uint8_t*)data;
+    while (size > 0) {
+        ssize_t received = read(fd, bytes, size);
+        if (received <= 0) return -1;
+        bytes += received;
+        size -= (size_t)received;
+    }
+    return 0;
+}
+
+static int send_request(int fd, uint64_t id, uint16_t op, uint16_t type, uint32_t count,
+                        const void* payload, uint32_t length) {
+    VedicWireHeader header;
+    memset(&header, 0, sizeof(header));
+    header.length = length;
+    header.magic = VEDIC_WIRE_MAGIC;
+    header.request_id = id;
+    header.op = op;
+    header.type = type;
+    header.count = count;
+    if (write_all(fd, &header, sizeof(header)) != 0) return -1;
+    return length ? write_all(fd, payload, length) : 0;
+}
+
+static int connect_daemon(const char* path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+
+    // The daemon needs a moment to bind
+    for (int attempt = 0; attempt < 200; attempt++) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr*)&address, sizeof(address)) == 0) return fd;
+        if (fd >= 0) close(fd);
+        usleep(10000);
+    }
+    return -1;
+}
+
+/**
+ * Pipeline small multiplies without reading until the daemon stops taking
+ * them, then half-close and check every complete request is answered
+ */
+static void check_backpressure(const char* socket_path) {
+    int fd = connect_daemon(socket_path);
+    check("connect flooding client", fd >= 0);
+    if (fd < 0) return;
+
+    typedef struct {
+        VedicWireHeader header;
+        int64_t operands[2];
+    } Frame;
+    size_t frame_count = FLOOD_BYTES / sizeof(Frame);
+    Frame* frames = (Frame*)calloc(frame_count, sizeof(Frame));
+    for (size_t i = 0; i < frame_count; i++) {
+        frames[i].header.length = sizeof(frames[i].operands);
+        frames[i].header.magic = VEDIC_WIRE_MAGIC;
+        frames[i].header.request_id = i;
+        frames[i].header.op = VEDIC_WIRE_MULTIPLY;
+        frames[i].header.type = VEDIC_WIRE_INT64;
+        frames[i].header.count = 1;
+        frames[i].operands[0] = (int64_t)(i % 1000) + 1;
+        frames[i].operands[1] = 997;
+    }
+
+    // Stalled: the socket stays unwritable while we read nothing
+    const uint8_t* bytes = (const uint8_t*)frames;
+    size_t total = frame_count * sizeof(Frame), sent = 0;
+    int stalled = 0;
+    while (sent < total && !stalled) {
+        ssize_t written = send(fd, bytes + sent, total - sent, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (written > 0) {
+            sent += (size_t)written;
+            continue;
+        }
+        struct pollfd writable = {fd, POLLOUT, 0};
+        stalled = poll(&writable, 1, 500) == 0;
+    }
+    check("daemon stops reading from a client that does not read", stalled);
+    shutdown(fd, SHUT_WR);
+
+    size_t complete = sent / sizeof(Frame), answered = 0;
+    int correct = 1;
+    VedicWireHeader header;
+    int64_t product;
+    while (read_all(fd, &header, sizeof(header)) == 0) {
+        if (header.length != sizeof(product) || read_all(fd, &product, sizeof(product)) != 0 ||
+            header.request_id != answered) {
+            correct = 0;
+            break;
+        }
+        correct &= header.status == VEDIC_WIRE_OK && product == ((int64_t)(answered % 1000) + 1) * 997;
+        answered++;
+    }
+    check("every complete request answered once the client reads", correct && answered == complete);
+    close(fd);
+    free(frames);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s /path/to/vedicmathd\n", argv[0]);
+        return 2;
+    }
+
+    char socket_path[64];
+    snprintf(socket_path, sizeof(socket_path), "/tmp/vedicmathd_test_%ld.sock", (long)getpid());
+
+    pid_t daemon = fork();
+    if (daemon == 0) {
+        execl(argv[1], argv[1], "--socket", socket_path, "--threads", "2", "--inline", "1000", (char*)NULL);
+        _exit(127);
+    }
+
+    int fd = connect_daemon(socket_path);
+    check("connect to daemon", fd >= 0);
+    if (fd < 0) {
+        kill(daemon, SIGTERM);
+        waitpid(daemon, NULL, 0);
+        return 1;
+    }
+
+    // Operands: a small int32 multiply, a large int64 multiply (pooled),
+    // a large square, an int32 divide and malformed requests
+    int32_t* small = (int32_t*)malloc(2 * SMALL_COUNT * sizeof(int32_t));
+    int64_t* large = (int64_t*)malloc(2 * LARGE_COUNT * sizeof(int64_t));
+    for (int i = 0; i < SMALL_COUNT; i++) {
+        small[i] = 85 + i;
+        small[SMALL_COUNT + i] = 115 - (i % 30) + 1;
+    }
+    for (int i = 0; i < LARGE_COUNT; i++) {
+        large[i] = (int64_t)(i % 5000) * 7 - 1000;
+        large[LARGE_COUNT + i] = 995 + (i % 11);
+    }
+    int32_t zero_divisor[2] = {10, 0};
+
+    int sent = 0;
+    sent += send_request(fd, 1, VEDIC_WIRE_PING, 0, 0, NULL, 0) == 0;
+    sent += send_request(fd, 2, VEDIC_WIRE_MULTIPLY, VEDIC_WIRE_INT64, LARGE_COUNT,
+                         large, 2 * LARGE_COUNT * sizeof(int64_t)) == 0;
+    sent += send_request(fd, 3, VEDIC_WIRE_MULTIPLY, VEDIC_WIRE_INT32, SMALL_COUNT,
+                         small, 2 * SMALL_COUNT * sizeof(int32_t)) == 0;
+    sent += send_request(fd, 4, VEDIC_WIRE_SQUARE, VEDIC_WIRE_INT64, LARGE_COUNT,
+                         large, LARGE_COUNT * sizeof(int64_t)) == 0;
+    sent += send_request(fd, 5, VEDIC_WIRE_DIVIDE, VEDIC_WIRE_INT32, SMALL_COUNT,
+                         small, 2 * SMALL_COUNT * sizeof(int32_t)) == 0;
+    sent += send_request(fd, 6, VEDIC_WIRE_DIVIDE, VEDIC_WIRE_INT32, 1, zero_divisor, sizeof(zero_divisor)) == 0;
+    sent += send_request(fd, 7, 99, VEDIC_WIRE_INT32, 0, NULL, 0) == 0;
+    check("pipelined requests sent", sent == REQUEST_COUNT);
+    shutdown(fd, SHUT_WR);
+
+    int seen[REQUEST_COUNT + 1] = {0};
+    int64_t* results = (int64_t*)malloc(2 * LARGE_COUNT * sizeof(int64_t));
+    for (int r = 0; r < REQUEST_COUNT; r++) {
+        VedicWireHeader header;
+        if (read_all(fd, &header, sizeof(header)) != 0 || header.magic != VEDIC_WIRE_MAGIC ||
+            header.length > 2 * LARGE_COUNT * sizeof(int64_t) ||
+            read_all(fd, results, header.length) != 0) {
+            check("read response", 0);
+            break;
+        }
+        if (header.request_id < 1 || header.request_id > REQUEST_COUNT) continue;
+        int id = (int)header.request_id;
+        int ok = 1;
+        switch (id) {
+            case 1:
+                ok = header.status == VEDIC_WIRE_OK && header.length == 0;
+                break;
+            case 2:
+                ok = header.status == VEDIC_WIRE_OK && header.count == LARGE_COUNT;
+                for (int i = 0; ok && i < LARGE_COUNT; i++) {
+                    ok = results[i] == vedic_multiply((long)large[i], (long)large[LARGE_COUNT + i]);
+                }
+                break;
+            case 3:
+                ok = header.status == VEDIC_WIRE_OK && header.count == SMALL_COUNT;
+                for (int i = 0; ok && i < SMALL_COUNT; i++) {
+                    ok = results[i] == (int64_t)small[i] * small[SMALL_COUNT + i];
+                }
+                break;
+            case 4:
+                ok = header.status == VEDIC_WIRE_OK;
+                for (int i = 0; ok && i < LARGE_COUNT; i++) {
+                    ok = results[i] == vedic_square((long)large[i]);
+                }
+                break;
+            case 5:
+                ok = header.status == VEDIC_WIRE_OK && header.length == 2 * SMALL_COUNT * sizeof(int64_t);
+                for (int i = 0; ok && i < SMALL_COUNT; i++) {
+                    long remainder;
+                    long quotient = vedic_divide(small[i], small[SMALL_COUNT + i], &remainder);
+                    ok = results[i] == quotient && results[SMALL_COUNT + i] == remainder;
+                }
+                break;
+            case 6:
+                ok = header.status == VEDIC_WIRE_DIVIDE_BY_ZERO;
+                break;
+            case 7:
+                ok = header.status == VEDIC_WIRE_BAD_REQUEST;
+                break;
+        }
+        seen[id] = ok ? 1 : -1;
+    }
+    close(fd);
+
+    check("ping answered", seen[1] == 1);
+    check("pooled int64 multiply matches vedic_multiply", seen[2] == 1);
+    check("inline int32 multiply", seen[3] == 1);
+    check("pooled square matches vedic_square", seen[4] == 1);
+    check("divide returns quotients and remainders", seen[5] == 1);
+    check("divide by zero reported", seen[6] == 1);
+    check("unknown op rejected", seen[7] == 1);
+
+    check_backpressure(socket_path);
+
+    int status = 0;
+    kill(daemon, SIGTERM);
+    waitpid(daemon, &status, 0);
+    check("daemon exits cleanly on SIGTERM", WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    check("socket removed", access(socket_path, F_OK) != 0);
+
+    free(small);
+    free(large);
+    free(results);
+    printf("%s\n", failures ? "vedicmathd tests FAILED" : "All vedicmathd tests passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,689 @@
+/**
+ * bench_compare.c - Compare two benchmark JSON result files
+ *
+ * Reads result files written with --json by vedicmath_benchmark,
+ * vedicmath_enhanced_benchmark or matrix_vedic_operations, matches the
+ * benchmarks by name and implementation and reports for each:
+ *
+ *   - median ns/op of baseline and candidate and the relative delta
+ *   - a bootstrap 95% confidence interval of the median ratio
+ *   - the two-sided Mann-Whitney U p-value of the per-repetition samples
+ *
+ * A benchmark is a regression when it is significantly slower (p < alpha),
+ * the median slowdown exceeds the threshold and the whole confidence
+ * interval lies above 1.0.
+ *
+ * Usage: bench_compare [options] baseline.json candidate.json
+ *   --alpha A        Significance level (default 0.05)
+ *   --threshold PCT  Minimum median slowdown to flag, in percent (default 5)
+ *   --resamples N    Bootstrap resamples (default 5000)
+ *   --seed N         Bootstrap seed (default 1)
+ *
+ * Exit status: 0 no regression, 1 regression found, 2 usage or input error
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_JSON_SCHEMA "vedicmath-bench/1"
+#define JSON_MAX_DEPTH 64
+#define MIN_SAMPLES 3
+
+// ============================================================================
+// MINIMAL JSON READER
+// ============================================================================
+
+typedef enum {
+    JSON_NULL,
+    JSON_BOOL,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT
+} JsonType;
+
+typedef struct JsonValue {
+    JsonType type;
+    double number;              // JSON_NUMBER, JSON_BOOL (0/1)
+    char* string;               // JSON_STRING
+    struct JsonValue* items;    // JSON_ARRAY elements / JSON_OBJECT values
+    char** keys;                // JSON_OBJECT keys
+    size_t count;
+} JsonValue;
+
+typedef struct {
+    const char* text;
+    size_t pos;
+    const char* error;
+} JsonParser;
+
+static void json_free(JsonValue* value) {
+    if (value->type == JSON_STRING) {
+        free(value->string);
+    } else if (value->type == JSON_ARRAY || value->type == JSON_OBJECT) {
+        for (size_t i = 0; i < value->count; i++) {
+            json_free(&value->items[i]);
+            if (value->keys) free(value->keys[i]);
+        }
+        free(value->items);
+        free(value->keys);
+    }
+    memset(value, 0, sizeof(*value));
+}
+
+static void skip_whitespace(JsonParser* parser) {
+    while (strchr(" \t\r\n", parser->text[parser->pos]) && parser->text[parser->pos]) {
+        parser->pos++;
+    }
+}
+
+static int parse_value(JsonParser* parser, JsonValue* out, int depth);
+
+static char* parse_string(JsonParser* parser) {
+    if (parser->text[parser->pos] != '"') {
+        parser->error = "expected string";
+        return NULL;
+    }
+    parser->pos++;
+
+    size_t capacity = 16, length = 0;
+    char* buffer = malloc(capacity);
+    if (!buffer) {
+        parser->error = "out of memory";
+        return NULL;
+    }
+
+    for (;;) {
+        char c = parser->text[parser->pos++];
+        if (c == '\0') {
+            parser->error = "unterminated string";
+            free(buffer);
+            return NULL;
+        }
+        if (c == '"') break;
+        if (c == '\\') {
+            char escape = parser->text[parser->pos++];
+            switch (escape) {
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case 'r': c = '\r'; break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'u': {
+                    // Only needed for control characters; keep the low byte
+                    unsigned code = 0;
+                    if (sscanf(parser->text + parser->pos, "%4x", &code) != 1) {
+                        parser->error = "bad \\u escape";
+                        free(buffer);
+                        return NULL;
+                    }
+                    parser->pos += 4;
+                    c = (char)(code < 0x80 ? code : '?');
+                    break;
+                }
+                case '\0':
+                    parser->error = "unterminated string";
+                    free(buffer);
+                    return NULL;
+                default: c = escape; break;   // \" \\ \/
+            }
+        }
+        if (length + 1 >= capacity) {
+            capacity *= 2;
+            char* grown = realloc(buffer, capacity);
+            if (!grown) {
+                parser->error = "out of memory";
+                free(buffer);
+                return NULL;
+            }
+            buffer = grown;
+        }
+        buffer[length++] = c;
+    }
+
+    buffer[length] = '\0';
+    return buffer;
+}
+
+// Append a zeroed slot to an array/object and return it
+static JsonValue* push_item(JsonParser* parser, JsonValue* container, size_t* capacity, char* key) {
+    if (container->count == *capacity) {
+        size_t grown_capacity = *capacity ? *capacity * 2 : 8;
+        JsonValue* items = realloc(container->items, grown_capacity * sizeof(JsonValue));
+        if (!items) {
+            parser->error = "out of memory";
+            return NULL;
+        }
+        container->items = items;
+        if (container->type == JSON_OBJECT) {
+            char** keys = realloc(container->keys, grown_capacity * sizeof(char*));
+            if (!keys) {
+                parser->error = "out of memory";
+                return NULL;
+            }
+            container->keys = keys;
+        }
+        *capacity = grown_capacity;
+    }
+
+    JsonValue* slot = &container->items[container->count];
+    memset(slot, 0, sizeof(*slot));
+    if (container->type == JSON_OBJECT) container->keys[container->count] = key;
+    container->count++;
+    return slot;
+}
+
+static int parse_container(JsonParser* parser, JsonValue* out, int depth) {
+    char close = out->type == JSON_OBJECT ? '}' : ']';
+    size_t capacity = 0;
+
+    parser->pos++;   // Opening bracket
+    skip_whitespace(parser);
+    if (parser->text[parser->pos] == close) {
+        parser->pos++;
+        return 0;
+    }
+
+    for (;;) {
+        char* key = NULL;
+        skip_whitespace(parser);
+        if (out->type == JSON_OBJECT) {
+            key = parse_string(parser);
+            if (!key) return -1;
+            skip_whitespace(parser);
+            if (parser->text[parser->pos] != ':') {
+                parser->error = "expected ':'";
+                free(key);
+                return -1;
+            }
+            parser->pos++;
+        }
+
+        JsonValue* slot = push_item(parser, out, &capacity, key);
+        if (!slot) {
+            free(key);
+            return -1;
+        }
+        if (parse_value(parser, slot, depth + 1) != 0) return -1;
+
+        skip_whitespace(parser);
+        char c = parser->text[parser->pos++];
+        if (c == close) return 0;
+        if (c != ',') {
+            parser->error = "expected ',' or closing bracket";
+            return -1;
+        }
+    }
+}
+
+static int parse_value(JsonParser* parser, JsonValue* out, int depth) {
+    if (depth > JSON_MAX_DEPTH) {
+        parser->error = "nesting too deep";
+        return -1;
+    }
+
+    skip_whitespace(parser);
+    const char* p = parser->text + parser->pos;
+
+    switch (*p) {
+        case '{':
+            out->type = JSON_OBJECT;
+            return parse_container(parser, out, depth);
+        case '[':
+            out->type = JSON_ARRAY;
+            return parse_container(parser, out, depth);
+        case '"':
+            out->type = JSON_STRING;
+            out->string = parse_string(parser);
+            return out->string ? 0 : -1;
+        case 't':
+            if (strncmp(p, "true", 4) != 0) break;
+            out->type = JSON_BOOL;
+            out->number = 1.0;
+            parser->pos += 4;
+            return 0;
+        case 'f':
+            if (strncmp(p, "false", 5) != 0) break;
+            out->type = JSON_BOOL;
+            parser->pos += 5;
+            return 0;
+        case 'n':
+            if (strncmp(p, "null", 4) != 0) break;
+            out->type = JSON_NULL;
+            parser->pos += 4;
+            return 0;
+        default: {
+            char* end;
+            out->number = strtod(p, &end);
+            if (end == p) break;
+            out->type = JSON_NUMBER;
+            parser->pos += (size_t)(end - p);
+            return 0;
+        }
+    }
+
+    parser->error = "unexpected character";
+    return -1;
+}
+
+static const JsonValue* json_get(const JsonValue* object, const char* key) {
+    if (!object || object->type != JSON_OBJECT) return NULL;
+    for (size_t i = 0; i < object->count; i++) {
+        if (strcmp(object->keys[i], key) == 0) return &object->items[i];
+    }
+    return NULL;
+}
+
+static const char* json_get_string(const JsonValue* object, const char* key) {
+    const JsonValue* value = json_get(object, key);
+    return (value && value->type == JSON_STRING) ? value->string : "";
+}
+
+/**
+ * Load and parse a whole file; prints the reason on failure
+ */
+static int load_json_file(const char* path, JsonValue* out) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "bench_compare: cannot open %s\n", path);
+        return -1;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(file);
+        fprintf(stderr, "bench_compare: cannot read %s\n", path);
+        return -1;
+    }
+
+    char* text = malloc((size_t)size + 1);
+    if (!text) {
+        fclose(file);
+        fprintf(stderr, "bench_compare: out of memory reading %s\n", path);
+        return -1;
+    }
+    size_t read = fread(text, 1, (size_t)size, file);
+    fclose(file);
+    text[read] = '\0';
+
+    JsonParser parser = { text, 0, NULL };
+    memset(out, 0, sizeof(*out));
+    int status = parse_value(&parser, out, 0);
+    if (status == 0) {
+        skip_whitespace(&parser);
+        if (text[parser.pos] != '\0') {
+            parser.error = "trailing data";
+            status = -1;
+        }
+    }
+    if (status != 0) {
+        fprintf(stderr, "bench_compare: %s: %s at offset %zu\n", path, parser.error, parser.pos);
+        json_free(out);
+    }
+
+    free(text);
+    return status;
+}
+
+// ============================================================================
+// RESULT FILES
+// ============================================================================
+
+typedef struct {
+    const char* name;
+    const char* implementation;
+    double* samples;            // ns/op per repetition (NaN/null dropped)
+    size_t count;
+} BenchEntry;
+
+typedef struct {
+    JsonValue root;
+    const JsonValue* environment;
+    BenchEntry* entries;
+    size_t count;
+} ResultFile;
+
+static void result_file_free(ResultFile* file) {
+    for (size_t i = 0; i < file->count; i++) {
+        free(file->entries[i].samples);
+    }
+    free(file->entries);
+    json_free(&file->root);
+}
+
+static int load_result_file(const char* path, ResultFile* file) {
+    memset(file, 0, sizeof(*file));
+    if (load_json_file(path, &file->root) != 0) return -1;
+
+    if (strcmp(json_get_string(&file->root, "schema"), BENCH_JSON_SCHEMA) != 0) {
+        fprintf(stderr, "bench_compare: %s is not a %s result file\n", path, BENCH_JSON_SCHEMA);
+        result_file_free(file);
+        return -1;
+    }
+
+    const JsonValue* results = json_get(&file->root, "results");
+    if (!results || results->type != JSON_ARRAY) {
+        fprintf(stderr, "bench_compare: %s has no results array\n", path);
+        result_file_free(file);
+        return -1;
+    }
+
+    file->environment = json_get(&file->root, "environment");
+    file->entries = calloc(results->count ? results->count : 1, sizeof(BenchEntry));
+    if (!file->entries) {
+        result_file_free(file);
+        return -1;
+    }
+
+    for (size_t i = 0; i < results->count; i++) {
+        const JsonValue* result = &results->items[i];
+        const JsonValue* samples = json_get(result, "samples");
+        BenchEntry* entry = &file->entries[file->count];
+
+        entry->name = json_get_string(result, "name");
+        entry->implementation = json_get_string(result, "implementation");
+        if (!samples || samples->type != JSON_ARRAY) continue;
+
+        entry->samples = malloc((samples->count ? samples->count : 1) * sizeof(double));
+        if (!entry->samples) {
+            result_file_free(file);
+            return -1;
+        }
+        for (size_t s = 0; s < samples->count; s++) {
+            if (samples->items[s].type == JSON_NUMBER) {
+                entry->samples[entry->count++] = samples->items[s].number;
+            }
+        }
+        file->count++;
+    }
+
+    return 0;
+}
+
+static const BenchEntry* find_entry(const ResultFile* file, const BenchEntry* key) {
+    for (size_t i = 0; i < file->count; i++) {
+        if (strcmp(file->entries[i].name, key->name) == 0 &&
+            strcmp(file->entries[i].implementation, key->implementation) == 0) {
+            return &file->entries[i];
+        }
+    }
+    return NULL;
+}
+
+// ============================================================================
+// STATISTICS
+// ============================================================================
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Median of an already sorted array
+static double sorted_median(const double* sorted, size_t count) {
+    return (count % 2) ? sorted[count / 2] : 0.5 * (sorted[count / 2 - 1] + sorted[count / 2]);
+}
+
+static double median_of(const double* values, size_t count, double* scratch) {
+    memcpy(scratch, values, count * sizeof(double));
+    qsort(scratch, count, sizeof(double), compare_doubles);
+    return sorted_median(scratch, count);
+}
+
+typedef struct {
+    double value;
+    int group;   // 0 = baseline, 1 = candidate
+} RankedSample;
+
+static int compare_ranked(const void* a, const void* b) {
+    return compare_doubles(&((const RankedSample*)a)->value, &((const RankedSample*)b)->value);
+}
+
+/**
+ * Two-sided Mann-Whitney U test (normal approximation with tie and
+ * continuity correction)
+ *
+ * @return p-value, or NAN on allocation failure
+ */
+static double mann_whitney_p(const double* a, size_t n1, const double* b, size_t n2) {
+    size_t n = n1 + n2;
+    RankedSample* all = malloc(n * sizeof(RankedSample));
+    if (!all) return NAN;
+
+    for (size_t i = 0; i < n1; i++) { all[i].value = a[i]; all[i].group = 0; }
+    for (size_t i = 0; i < n2; i++) { all[n1 + i].value = b[i]; all[n1 + i].group = 1; }
+    qsort(all, n, sizeof(RankedSample), compare_ranked);
+
+    // Average ranks over ties
+    double rank_sum_a = 0.0, tie_term = 0.0;
+    for (size_t i = 0; i < n;) {
+        size_t j = i;
+        while (j + 1 < n && all[j + 1].value == all[i].value) j++;
+        double rank = 0.5 * (double)(i + j) + 1.0;
+        double ties = (double)(j - i + 1);
+        tie_term += ties * ties * ties - ties;
+        for (size_t k = i; k <= j; k++) {
+            if (all[k].group == 0) rank_sum_a += rank;
+        }
+        i = j + 1;
+    }
+    free(all);
+
+    double u = rank_sum_a - (double)n1 * (double)(n1 + 1) / 2.0;
+    double mean_u = (double)n1 * (double)n2 / 2.0;
+    double var_u = (double)n1 * (double)n2 / 12.0 *
+                   (((double)n + 1.0) - tie_term / ((double)n * ((double)n - 1.0)));
+    if (var_u <= 0.0) return 1.0;   // All samples identical
+
+    double z = (fabs(u - mean_u) - 0.5) / sqrt(var_u);
+    if (z < 0.0) z = 0.0;
+    return erfc(z / sqrt(2.0));
+}
+
+// splitmix64: small, seedable and good enough for resampling
+static uint64_t next_random(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static double resampled_median(const double* values, size_t count, double* scratch, uint64_t* state) {
+    for (size_t i = 0; i < count; i++) {
+        scratch[i] = values[next_random(state) % count];
+    }
+    qsort(scratch, count, sizeof(double), compare_doubles);
+    return sorted_median(scratch, count);
+}
+
+/**
+ * Percentile bootstrap 95% confidence interval of median(b) / median(a)
+ *
+ * @return 0 on success, -1 on allocation failure
+ */
+static int bootstrap_ratio_ci(const double* a, size_t n1, const double* b, size_t n2,
+                              size_t resamples, uint64_t seed, double ci[2]) {
+    double* ratios = malloc(resamples * sizeof(double));
+    double* scratch = malloc((n1 > n2 ? n1 : n2) * sizeof(double));
+    if (!ratios || !scratch) {
+        free(ratios);
+        free(scratch);
+        return -1;
+    }
+
+    uint64_t state = seed;
+    size_t valid = 0;
+    for (size_t r = 0; r < resamples; r++) {
+        double median_a = resampled_median(a, n1, scratch, &state);
+        double median_b = resampled_median(b, n2, scratch, &state);
+        if (median_a > 0.0) ratios[valid++] = median_b / median_a;
+    }
+
+    if (valid == 0) {
+        ci[0] = ci[1] = NAN;
+    } else {
+        qsort(ratios, valid, sizeof(double), compare_doubles);
+        ci[0] = ratios[(size_t)(0.025 * (double)(valid - 1))];
+        ci[1] = ratios[(size_t)(0.975 * (double)(valid - 1) + 0.5)];
+    }
+
+    free(ratios);
+    free(scratch);
+    return 0;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [--alpha A] [--threshold PCT] [--resamples N] [--seed N] "
+            "baseline.json candidate.json\n", program);
+}
+
+// Point out environment differences that make a comparison less meaningful
+static void report_environment(const ResultFile* baseline, const ResultFile* candidate) {
+    static const char* keys[] = { "hostname", "cpu_model", "os", "compiler" };
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+        const char* a = json_get_string(baseline->environment, keys[i]);
+        const char* b = json_get_string(candidate->environment, keys[i]);
+        if (strcmp(a, b) != 0) {
+            printf("Note: %s differs (baseline \"%s\", candidate \"%s\")\n", keys[i], a, b);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    double alpha = 0.05;
+    double threshold = 0.05;
+    size_t resamples = 5000;
+    uint64_t seed = 1;
+    const char* paths[2] = { NULL, NULL };
+    int path_count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--alpha") == 0 && value) {
+            alpha = atof(value);
+            i++;
+        } else if (strcmp(argv[i], "--threshold") == 0 && value) {
+            threshold = atof(value) / 100.0;
+            i++;
+        } else if (strcmp(argv[i], "--resamples") == 0 && value) {
+            long count = atol(value);
+            if (count > 0) resamples = (size_t)count;
+            i++;
+        } else if (strcmp(argv[i], "--seed") == 0 && value) {
+            seed = (uint64_t)strtoull(value, NULL, 10);
+            i++;
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            print_usage(argv[0]);
+            return 2;
+        } else if (path_count < 2) {
+            paths[path_count++] = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (path_count != 2 || alpha <= 0.0 || alpha >= 1.0 || threshold < 0.0) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    ResultFile baseline, candidate;
+    if (load_result_file(paths[0], &baseline) != 0) return 2;
+    if (load_result_file(paths[1], &candidate) != 0) {
+        result_file_free(&baseline);
+        return 2;
+    }
+
+    printf("Baseline:  %s (%s)\n", paths[0], json_get_string(baseline.environment, "timestamp"));
+    printf("Candidate: %s (%s)\n", paths[1], json_get_string(candidate.environment, "timestamp"));
+    report_environment(&baseline, &candidate);
+    printf("Regression: p < %.3g, median slowdown > %.1f%%, 95%% CI above 1.0\n\n",
+           alpha, threshold * 100.0);
+
+    printf("%-28s %-15s %12s %12s %9s %19s %9s  %s\n",
+           "Benchmark", "Implementation", "Base ns/op", "Cand ns/op", "Delta", "95% CI (ratio)", "p", "Verdict");
+
+    size_t regressions = 0, improvements = 0, unchanged = 0, skipped = 0;
+
+    for (size_t i = 0; i < baseline.count; i++) {
+        const BenchEntry* base = &baseline.entries[i];
+        const BenchEntry* cand = find_entry(&candidate, base);
+
+        if (!cand) {
+            printf("%-28s %-15s %12s %12s %9s %19s %9s  %s\n",
+                   base->name, base->implementation, "", "", "", "", "", "missing in candidate");
+            skipped++;
+            continue;
+        }
+        if (base->count == 0 || cand->count == 0) {
+            skipped++;
+            continue;
+        }
+
+        size_t max_count = base->count > cand->count ? base->count : cand->count;
+        double* scratch = malloc(max_count * sizeof(double));
+        if (!scratch) break;
+        double base_median = median_of(base->samples, base->count, scratch);
+        double cand_median = median_of(cand->samples, cand->count, scratch);
+        free(scratch);
+
+        double ratio = base_median > 0.0 ? cand_median / base_median : NAN;
+        double delta = (ratio - 1.0) * 100.0;
+
+        if (base->count < MIN_SAMPLES || cand->count < MIN_SAMPLES) {
+            printf("%-28s %-15s %12.2f %12.2f %+8.1f%% %19s %9s  %s\n",
+                   base->name, base->implementation, base_median, cand_median, delta,
+                   "", "", "too few samples");
+            skipped++;
+            continue;
+        }
+
+        double p = mann_whitney_p(base->samples, base->count, cand->samples, cand->count);
+        double ci[2] = { NAN, NAN };
+        bootstrap_ratio_ci(base->samples, base->count, cand->samples, cand->count,
+                           resamples, seed, ci);
+
+        const char* verdict = "~";
+        if (p < alpha && ratio > 1.0 + threshold && ci[0] > 1.0) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (p < alpha && ratio < 1.0 - threshold && ci[1] < 1.0) {
+            verdict = "improved";
+            improvements++;
+        } else {
+            unchanged++;
+        }
+
+        char ci_text[32];
+        snprintf(ci_text, sizeof(ci_text), "[%.3f, %.3f]", ci[0], ci[1]);
+        printf("%-28s %-15s %12.2f %12.2f %+8.1f%% %19s %9.4f  %s\n",
+               base->name, base->implementation, base_median, cand_median, delta,
+               ci_text, p, verdict);
+    }
+
+    for (size_t i = 0; i < candidate.count; i++) {
+        if (!find_entry(&baseline, &candidate.entries[i])) {
+            printf("%-28s %-15s %12s %12s %9s %19s %9s  %s\n",
+                   candidate.entries[i].name, candidate.entries[i].implementation,
+                   "", "", "", "", "", "new in candidate");
+        }
+    }
+
+    printf("\nSummary: %zu regression(s), %zu improvement(s), %zu unchanged, %zu skipped\n",
+           regressions, improvements, unchanged, skipped);
+
+    result_file_free(&baseline);
+    result_file_free(&candidate);
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,738 @@
+/**
+ * vedicmathd.c - Local compute daemon over a Unix domain socket
+ *
+ * Serves batches of Vedic arithmetic to other processes on the machine
+ * using the binary protocol in vedicmath_wire.h. One thread runs an epoll
+ * loop over the listening socket and all connections. Batches up to the
+ * inline limit are computed on that thread and answered at once. Larger
+ * ones go to the library thread pool through the asynchronous batch API,
+ * and their completion callbacks hand results back to the loop through an
+ * eventfd.
+ *
+ * Each connection may pipeline requests. The daemon stops reading from a
+ * connection once it has too many large batches in flight, or once more than
+ * DAEMON_OUTPUT_HIGH_WATER bytes of answers wait for the client to read them,
+ * and one read takes at most DAEMON_READ_LIMIT bytes. A fast client is thus
+ * slowed down by its own socket buffer rather than by growing queues here.
+ * When the pool as a whole is at its in-flight limit, requests get a BUSY
+ * status.
+ *
+ * Usage: vedicmathd [options]
+ *   --socket PATH    Socket to listen on (default /tmp/vedicmathd.sock)
+ *   --threads N      Pool worker threads (default: one per CPU minus one)
+ *   --numa           Pin workers per NUMA node and split batches by node
+ *   --inline N       Largest batch computed on the event loop (default 1024)
+ *   --pipeline N     Pooled batches in flight per connection (default 64)
+ *   --limit N        Pooled batches in flight in total (default 1024)
+ *   --metrics NAME   Publish engine metrics to the shared-memory ring NAME
+ *                    (e.g. /vedicmath-metrics) for monitors in other processes
+ *
+ * SIGINT and SIGTERM stop the daemon after the batches in flight finish.
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "vedicmath.h"
+#include "vedicmath_async.h"
+#include "vedicmath_metrics.h"
+#include "vedicmath_pool.h"
+#include "vedicmath_wire.h"
+
+#define DAEMON_MAX_EVENTS 64
+#define DAEMON_READ_CHUNK 65536
+#define DAEMON_READ_LIMIT (4 * DAEMON_READ_CHUNK)       // Bytes taken per read_input call
+#define DAEMON_OUTPUT_HIGH_WATER (1u << 20)             // Unsent bytes that pause a connection
+#define DAEMON_DEFAULT_INLINE 1024
+#define DAEMON_DEFAULT_PIPELINE 64
+
+typedef struct Connection Connection;
+
+/**
+ * A batch running on the pool
+ */
+typedef struct Job {
+    Connection* connection;
+    VedicBatchHandle* handle;
+    long* operands;             // a[count], then b[count] for binary ops
+    uint8_t* response;          // Header followed by the results
+    size_t response_size;
+    struct Job* next;           // Completion list
+} Job;
+
+struct Connection {
+    int fd;
+    uint8_t* in;
+    size_t in_length;
+    size_t in_capacity;
+    uint8_t* out;
+    size_t out_start;           // First byte not yet written
+    size_t out_length;
+    size_t out_capacity;
+    int in_flight;              // Pooled batches not yet answered
+    int closing;                // Failed: stop answering, close once in_flight drains
+    int peer_done;              // Peer shut down its write side
+    int registered;             // Still in the epoll set
+    int dead;                   // Closed; freed after the current epoll batch
+    uint32_t events;            // Registered epoll events
+    Connection* next_dead;
+};
+
+typedef struct {
+    uint64_t connections;
+    uint64_t requests;
+    uint64_t inline_batches;
+    uint64_t pooled_batches;
+    uint64_t busy;
+    uint64_t errors;
+} DaemonStats;
+
+static int epoll_fd = -1;
+static int wake_fd = -1;
+static int listen_fd = -1;
+static size_t inline_limit = DAEMON_DEFAULT_INLINE;
+static int pipeline_limit = DAEMON_DEFAULT_PIPELINE;
+static DaemonStats stats;
+static volatile sig_atomic_t stop_requested = 0;
+
+// Jobs finished by pool workers, handed to the event loop
+static pthread_mutex_t completed_lock = PTHREAD_MUTEX_INITIALIZER;
+static Job* completed_head = NULL;
+
+// Closed connections may still have an event later in the same epoll batch
+static Connection* dead_connections = NULL;
+
+// epoll user data for the two non-connection descriptors
+static char listen_marker;
+static char wake_marker;
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [--socket PATH] [--threads N] [--numa] [--inline N] [--pipeline N] [--limit N] "
+            "[--metrics NAME]\n",
+            program);
+}
+
+static void on_signal(int signal_number) {
+    (void)signal_number;
+    stop_requested = 1;
+}
+
+static int operand_count(uint16_t op) {
+    switch (op) {
+        case VEDIC_WIRE_MULTIPLY:
+        case VEDIC_WIRE_DIVIDE:
+            return 2;
+        case VEDIC_WIRE_SQUARE:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static size_t result_count(uint16_t op, uint32_t count) {
+    return op == VEDIC_WIRE_DIVIDE ? 2 * (size_t)count : count;
+}
+
+// ============================================================================
+// CONNECTION BUFFERS
+// ============================================================================
+
+static int reserve(uint8_t** buffer, size_t* capacity, size_t needed) {
+    if (needed <= *capacity) return 0;
+    size_t grown = *capacity ? *capacity : DAEMON_READ_CHUNK;
+    while (grown < needed) grown *= 2;
+    uint8_t* resized = (uint8_t*)realloc(*buffer, grown);
+    if (!resized) return -1;
+    *buffer = resized;
+    *capacity = grown;
+    return 0;
+}
+
+/**
+ * More answers are waiting for the client than it may queue up
+ */
+static int output_backlogged(const Connection* connection) {
+    return connection->out_length - connection->out_start > DAEMON_OUTPUT_HIGH_WATER;
+}
+
+/**
+ * The input buffer starts with a whole frame, held back by a limit
+ */
+static int frame_pending(const Connection* connection) {
+    VedicWireHeader header;
+    if (connection->in_length < sizeof(header)) return 0;
+    memcpy(&header, connection->in, sizeof(header));
+    return connection->in_length - sizeof(header) >= header.length;
+}
+
+static void update_events(Connection* connection) {
+    if (!connection->registered) return;
+    uint32_t events = 0;
+    if (!connection->closing && !connection->peer_done && connection->in_flight < pipeline_limit &&
+        !output_backlogged(connection)) {
+        events |= EPOLLIN;
+    }
+    if (connection->out_length > connection->out_start) events |= EPOLLOUT;
+    if (events == connection->events) return;
+
+    struct epoll_event event;
+    event.events = events;
+    event.data.ptr = connection;
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, connection->fd, &event);
+    connection->events = events;
+}
+
+static void unregister_connection(Connection* connection) {
+    if (!connection->registered) return;
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, connection->fd, NULL);
+    connection->registered = 0;
+}
+
+static void destroy_connection(Connection* connection) {
+    unregister_connection(connection);
+    close(connection->fd);
+    connection->dead = 1;
+    connection->next_dead = dead_connections;
+    dead_connections = connection;
+}
+
+static void free_dead_connections(void) {
+    while (dead_connections) {
+        Connection* connection = dead_connections;
+        dead_connections = connection->next_dead;
+        free(connection->in);
+        free(connection->out);
+        free(connection);
+    }
+}
+
+/**
+ * Write as much pending output as the socket takes
+ *
+ * @return 0, or -1 if the connection was destroyed
+ */
+static int flush_output(Connection* connection) {
+    while (connection->out_start < connection->out_length) {
+        ssize_t written = send(connection->fd, connection->out + connection->out_start,
+                               connection->out_length - connection->out_start, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            connection->closing = 1;
+            connection->out_start = connection->out_length = 0;
+            break;
+        }
+        connection->out_start += (size_t)written;
+    }
+    if (connection->out_start == connection->out_length) {
+        connection->out_start = connection->out_length = 0;
+    }
+
+    // Frames blocked by the pipeline limit imply in_flight > 0; frames blocked
+    // by the output high-water mark are answered once process_input resumes
+    if ((connection->closing || (connection->peer_done && !frame_pending(connection))) &&
+        connection->in_flight == 0 && connection->out_length == 0) {
+        destroy_connection(connection);
+        return -1;
+    }
+    update_events(connection);
+    return 0;
+}
+
+static void append_output(Connection* connection, const void* data, size_t size) {
+    if (!connection->registered) return;     // Peer is gone
+    if (reserve(&connection->out, &connection->out_capacity, connection->out_length + size) != 0) {
+        connection->closing = 1;
+        return;
+    }
+    memcpy(connection->out + connection->out_length, data, size);
+    connection->out_length += size;
+}
+
+static void send_status(Connection* connection, const VedicWireHeader* request, VedicWireStatus status) {
+    VedicWireHeader response;
+    memset(&response, 0, sizeof(response));
+    response.magic = VEDIC_WIRE_MAGIC;
+    response.request_id = request->request_id;
+    response.op = request->op;
+    response.type = VEDIC_WIRE_INT64;
+    response.status = (uint16_t)status;
+    append_output(connection, &response, sizeof(response));
+    if (status != VEDIC_WIRE_OK) stats.errors++;
+}
+
+// ============================================================================
+// BATCH EXECUTION
+// ============================================================================
+
+static void compute_inline(uint16_t op, const long* a, const long* b, long* results, size_t count) {
+    switch (op) {
+        case VEDIC_WIRE_MULTIPLY:
+            vedic_multiply_batch(results, a, b, count);
+            break;
+        case VEDIC_WIRE_SQUARE:
+            vedic_square_batch(results, a, count);
+            break;
+        case VEDIC_WIRE_DIVIDE:
+            for (size_t i = 0; i < count; i++) results[i] = vedic_divide(a[i], b[i], &results[count + i]);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Completion callback on a pool worker: finish the results and wake the loop
+ */
+static void on_batch_done(VedicBatchHandle* handle, VedicBatchStatus status, void* user_data) {
+    Job* job = (Job*)user_data;
+    VedicWireHeader* header = (VedicWireHeader*)job->response;
+    (void)handle;
+
+    if (status != VEDIC_BATCH_DONE) {
+        header->status = VEDIC_WIRE_INTERNAL_ERROR;
+    } else if (header->op == VEDIC_WIRE_DIVIDE) {
+        // The pool computes quotients; remainders follow from them
+        long* results = (long*)(job->response + sizeof(VedicWireHeader));
+        const long* a = job->operands;
+        const long* b = job->operands + header->count;
+        for (uint32_t i = 0; i < header->count; i++) {
+            results[header->count + i] = a[i] - results[i] * b[i];
+        }
+    }
+
+    pthread_mutex_lock(&completed_lock);
+    job->next = completed_head;
+    completed_head = job;
+    pthread_mutex_unlock(&completed_lock);
+
+    uint64_t one = 1;
+    ssize_t ignored = write(wake_fd, &one, sizeof(one));
+    (void)ignored;
+}
+
+static void handle_request(Connection* connection, const VedicWireHeader* request, const uint8_t* payload) {
+    stats.requests++;
+    int operands = operand_count(request->op);
+    size_t element_size = request->type == VEDIC_WIRE_INT32 ? 4 : request->type == VEDIC_WIRE_INT64 ? 8 : 0;
+
+    if (request->op == VEDIC_WIRE_PING) {
+        send_status(connection, request, request->length == 0 ? VEDIC_WIRE_OK : VEDIC_WIRE_BAD_REQUEST);
+        return;
+    }
+    if (operands == 0 || element_size == 0 ||
+        request->length != (uint64_t)request->count * (uint64_t)operands * element_size) {
+        send_status(connection, request, VEDIC_WIRE_BAD_REQUEST);
+        return;
+    }
+
+    size_t count = request->count;
+    size_t results = result_count(request->op, request->count);
+    long* values = (long*)malloc((count * (size_t)operands + 1) * sizeof(long));
+    uint8_t* response = (uint8_t*)malloc(sizeof(VedicWireHeader) + results * sizeof(int64_t));
+    if (!values || !response) {
+        free(values);
+        free(response);
+        send_status(connection, request, VEDIC_WIRE_INTERNAL_ERROR);
+        return;
+    }
+
+    // Widen to long; the payload is not necessarily aligned
+    for (size_t i = 0; i < count * (size_t)operands; i++) {
+        if (element_size == 4) {
+            int32_t value;
+            memcpy(&value, payload + i * 4, 4);
+            values[i] = value;
+        } else {
+            int64_t value;
+            memcpy(&value, payload + i * 8, 8);
+            values[i] = (long)value;
+        }
+    }
+    const long* a = values;
+    const long* b = operands > 1 ? values + count : NULL;
+
+    if (request->op == VEDIC_WIRE_DIVIDE) {
+        for (size_t i = 0; i < count; i++) {
+            if (b[i] == 0) {
+                free(values);
+                free(response);
+                send_status(connection, request, VEDIC_WIRE_DIVIDE_BY_ZERO);
+                return;
+            }
+        }
+    }
+
+    VedicWireHeader* header = (VedicWireHeader*)response;
+    memset(header, 0, sizeof(*header));
+    header->length = (uint32_t)(results * sizeof(int64_t));
+    header->magic = VEDIC_WIRE_MAGIC;
+    header->request_id = request->request_id;
+    header->op = request->op;
+    header->type = VEDIC_WIRE_INT64;
+    header->count = request->count;
+    long* output = (long*)(response + sizeof(VedicWireHeader));
+
+    if (count <= inline_limit) {
+        compute_inline(request->op, a, b, output, count);
+        append_output(connection, response, sizeof(VedicWireHeader) + header->length);
+        stats.inline_batches++;
+        free(values);
+        free(response);
+        return;
+    }
+
+    Job* job = (Job*)malloc(sizeof(Job));
+    if (!job) {
+        free(values);
+        free(response);
+        send_status(connection, request, VEDIC_WIRE_INTERNAL_ERROR);
+        return;
+    }
+    job->connection = connection;
+    job->operands = values;
+    job->response = response;
+    job->response_size = sizeof(VedicWireHeader) + header->length;
+    job->next = NULL;
+
+    static const VedicBatchOp batch_ops[VEDIC_WIRE_OP_COUNT] = {
+        VEDIC_BATCH_OP_COUNT, VEDIC_BATCH_MULTIPLY, VEDIC_BATCH_SQUARE, VEDIC_BATCH_DIVIDE
+    };
+    const void* inputs[2] = {a, b};
+    connection->in_flight++;
+    job->handle = vedic_submit_batch(batch_ops[request->op], inputs, output, count, on_batch_done, job);
+    if (!job->handle) {
+        connection->in_flight--;
+        free(values);
+        free(response);
+        free(job);
+        stats.busy++;
+        send_status(connection, request, VEDIC_WIRE_BUSY);
+        return;
+    }
+    stats.pooled_batches++;
+}
+
+/**
+ * Answer the complete frames at the front of the input buffer
+ *
+ * @return Nonzero if the output high-water mark stopped it
+ */
+static int answer_frames(Connection* connection) {
+    size_t position = 0;
+    while (!connection->closing && connection->in_flight < pipeline_limit && !output_backlogged(connection) &&
+           connection->in_length - position >= sizeof(VedicWireHeader)) {
+        VedicWireHeader request;
+        memcpy(&request, connection->in + position, sizeof(request));
+
+        if (request.magic != VEDIC_WIRE_MAGIC) {
+            // Cannot find the next frame boundary: drop the connection
+            stats.errors++;
+            connection->closing = 1;
+            connection->out_start = connection->out_length = 0;
+            break;
+        }
+        if (request.count > VEDIC_WIRE_MAX_COUNT ||
+            request.length > (uint64_t)VEDIC_WIRE_MAX_COUNT * 2 * sizeof(int64_t)) {
+            send_status(connection, &request, VEDIC_WIRE_TOO_LARGE);
+            connection->closing = 1;
+            break;
+        }
+
+        size_t frame = sizeof(VedicWireHeader) + request.length;
+        if (connection->in_length - position < frame) {
+            if (reserve(&connection->in, &connection->in_capacity, frame) != 0) {
+                connection->closing = 1;
+            }
+            break;
+        }
+        handle_request(connection, &request, connection->in + position + sizeof(VedicWireHeader));
+        position += frame;
+    }
+
+    if (position > 0) {
+        memmove(connection->in, connection->in + position, connection->in_length - position);
+        connection->in_length -= position;
+    }
+    return !connection->closing && output_backlogged(connection);
+}
+
+/**
+ * Answer every complete frame in the input buffer, up to the pipeline limit
+ * and the output high-water mark
+ *
+ * @return 0, or -1 if the connection was destroyed
+ */
+static int process_input(Connection* connection) {
+    for (;;) {
+        int backlogged = answer_frames(connection);
+        if (flush_output(connection) != 0) return -1;
+        // Keep going only if the flush brought the output back under the mark
+        if (!backlogged || output_backlogged(connection)) return 0;
+    }
+}
+
+/**
+ * Read at most DAEMON_READ_LIMIT bytes, then answer what arrived
+ */
+static void read_input(Connection* connection) {
+    size_t budget = DAEMON_READ_LIMIT;
+    while (budget > 0) {
+        if (reserve(&connection->in, &connection->in_capacity, connection->in_length + DAEMON_READ_CHUNK) != 0) {
+            connection->closing = 1;
+            break;
+        }
+        size_t room = connection->in_capacity - connection->in_length;
+        ssize_t received = recv(connection->fd, connection->in + connection->in_length,
+                                room < budget ? room : budget, 0);
+        if (received > 0) {
+            connection->in_length += (size_t)received;
+            budget -= (size_t)received;
+            continue;
+        }
+        if (received < 0 && errno == EINTR) continue;
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (received == 0) {
+            connection->peer_done = 1;   // Answer everything already received
+        } else {
+            connection->closing = 1;
+        }
+        break;
+    }
+    // Anything left in the socket is picked up on the next EPOLLIN
+    process_input(connection);
+}
+
+static void drain_completions(void) {
+    uint64_t ignored;
+    while (read(wake_fd, &ignored, sizeof(ignored)) > 0) {
+    }
+
+    pthread_mutex_lock(&completed_lock);
+    Job* job = completed_head;
+    completed_head = NULL;
+    pthread_mutex_unlock(&completed_lock);
+
+    while (job) {
+        Job* next = job->next;
+        Connection* connection = job->connection;
+        connection->in_flight--;
+        append_output(connection, job->response, job->response_size);
+        vedic_batch_release(job->handle);
+        free(job->operands);
+        free(job->response);
+        free(job);
+
+        // Reading resumes once the connection is below its pipeline limit
+        process_input(connection);
+        job = next;
+    }
+}
+
+static void accept_connections(void) {
+    for (;;) {
+        int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            break;                   // EAGAIN, or out of descriptors until a close
+        }
+        Connection* connection = (Connection*)calloc(1, sizeof(Connection));
+        if (!connection) {
+            close(fd);
+            continue;
+        }
+        connection->fd = fd;
+        connection->registered = 1;
+        connection->events = EPOLLIN;
+
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = connection;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            free(connection);
+            continue;
+        }
+        stats.connections++;
+    }
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static int open_listener(const char* path) {
+    struct sockaddr_un address;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Socket path too long: %s\n", path);
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    unlink(path);
+    if (bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        fprintf(stderr, "Cannot listen on %s: %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int main(int argc, char* argv[]) {
+    const char* socket_path = VEDIC_WIRE_DEFAULT_SOCKET;
+    int threads = 0;
+    int numa = 0;
+    long limit = 0;
+    const char* metrics_name = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--socket") == 0 && value) {
+            socket_path = value;
+            i++;
+        } else if (strcmp(argv[i], "--threads") == 0 && value) {
+            threads = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--numa") == 0) {
+            numa = 1;
+        } else if (strcmp(argv[i], "--inline") == 0 && value) {
+            inline_limit = (size_t)atol(value);
+            i++;
+        } else if (strcmp(argv[i], "--pipeline") == 0 && value) {
+            pipeline_limit = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--limit") == 0 && value) {
+            limit = atol(value);
+            i++;
+        } else if (strcmp(argv[i], "--metrics") == 0 && value) {
+            metrics_name = value;
+            i++;
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (sizeof(long) < sizeof(int64_t) || pipeline_limit < 1 || threads < 0 || limit < 0) {
+        if (sizeof(long) < sizeof(int64_t)) fprintf(stderr, "vedicmathd needs a 64-bit long\n");
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    VedicPoolConfig pool_config = {threads, NULL, 0, numa, NULL};
+    if (vedic_pool_configure(&pool_config) != 0) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    vedic_async_set_limit((size_t)limit);
+
+    VedicMetricsRing* metrics_ring = NULL;
+    if (metrics_name) {
+        metrics_ring = vedic_metrics_ring_create(metrics_name, 0);
+        if (!metrics_ring || vedic_metrics_publisher_start(metrics_ring, 0) != 0) {
+            fprintf(stderr, "vedicmathd: cannot publish metrics to %s\n", metrics_name);
+            return 1;
+        }
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    listen_fd = open_listener(socket_path);
+    if (listen_fd < 0) return 1;
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd < 0 || wake_fd < 0) {
+        perror("epoll/eventfd");
+        return 1;
+    }
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = &listen_marker;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &event);
+    event.data.ptr = &wake_marker;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &event);
+
+    printf("vedicmathd listening on %s (%d pool workers on %d nodes, inline up to %zu elements)\n",
+           socket_path, vedic_pool_thread_count(), vedic_pool_node_count(), inline_limit);
+    fflush(stdout);
+
+    struct epoll_event events[DAEMON_MAX_EVENTS];
+    while (!stop_requested) {
+        // The timeout bounds how long a signal that lands outside epoll_wait goes unnoticed
+        int ready = epoll_wait(epoll_fd, events, DAEMON_MAX_EVENTS, 500);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+        for (int i = 0; i < ready; i++) {
+            void* source = events[i].data.ptr;
+            if (source == &listen_marker) {
+                accept_connections();
+            } else if (source == &wake_marker) {
+                drain_completions();
+            } else {
+                Connection* connection = (Connection*)source;
+                if (connection->dead) continue;
+                if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                    // Nobody to answer; keep the memory until its batches finish
+                    connection->closing = 1;
+                    connection->out_start = connection->out_length = 0;
+                    unregister_connection(connection);
+                    flush_output(connection);
+                } else if (events[i].events & EPOLLIN) {
+                    read_input(connection);
+                } else if (events[i].events & EPOLLOUT) {
+                    // Draining may lift the high-water mark off frames already read
+                    process_input(connection);
+                }
+            }
+        }
+        free_dead_connections();
+    }
+
+    // Batches in flight still reference their connections
+    close(listen_fd);
+    unlink(socket_path);
+    VedicAsyncStats async = vedic_async_get_stats();
+    while (async.in_flight > 0) {
+        usleep(1000);
+        async = vedic_async_get_stats();
+    }
+    vedic_pool_shutdown();
+    if (metrics_ring) {
+        vedic_metrics_publisher_stop();
+        vedic_metrics_ring_close(metrics_ring);
+        vedic_metrics_ring_unlink(metrics_name);
+    }
+
+    printf("vedicmathd stopped: %llu connections, %llu requests (%llu inline, %llu pooled, %llu busy, %llu errors)\n",
+           (unsigned long long)stats.connections, (unsigned long long)stats.requests,
+           (unsigned long long)stats.inline_batches, (unsigned long long)stats.pooled_batches,
+           (unsigned long long)stats.busy, (unsigned long long)stats.errors);
+    return 0;
+}